@@ -87,6 +87,13 @@
 #!        the module does not need to provide a files.cmake file or FILES_CMAKE argument.
 #! \param H_FILES List of public header files for this module. It is recommended to use
 #!        a files.cmake file instead.
+#! \param AUTOLOAD_SERVICES List of service interface ids (e.g. org.mitk.IFileReader) an
+#!        auto-loaded module registers. Requires AUTOLOAD_WITH. Declaring what a module
+#!        provides defers its loading until one of the services or mime types is requested,
+#!        if lazy auto-loading is enabled (see us::ModuleSettings::SetLazyAutoLoadingEnabled()).
+#! \param AUTOLOAD_MIME_TYPES List of mime types an auto-loaded module provides readers
+#!        or writers for, each of the form <mimeTypeName>[:<extension1>[,<extension2>]...].
+#!        Requires AUTOLOAD_WITH, see AUTOLOAD_SERVICES.
 #!
 #! Options (optional)
 #!
@@ -122,6 +129,8 @@ function(mitk_create_module)
       ADDITIONAL_LIBS        # list of addidtional private libraries linked to this module.
       CPP_FILES              # list of cpp files
       H_FILES                # list of header files: [PUBLIC|PRIVATE] <list>
+      AUTOLOAD_SERVICES      # list of service interface ids registered by an auto-loaded module
+      AUTOLOAD_MIME_TYPES    # list of mime types provided by an auto-loaded module: <name>[:<ext1>,<ext2>...]
      )
 
   set(_macro_options
@@ -394,7 +403,7 @@ function(mitk_create_module)
     endif(MODULE_FORCE_STATIC)
 
     if(NOT MODULE_HEADERS_ONLY)
-      if(NOT MODULE_NO_INIT OR RESOURCE_FILES)
+      if(NOT MODULE_NO_INIT OR RESOURCE_FILES OR MODULE_AUTOLOAD_SERVICES OR MODULE_AUTOLOAD_MIME_TYPES)
         find_package(CppMicroServices QUIET NO_MODULE REQUIRED)
       endif()
       if(NOT MODULE_NO_INIT)
@@ -422,6 +431,60 @@ function(mitk_create_module)
         # Add a source level dependencies on resource files
         usFunctionGetResourceSource(TARGET ${MODULE_TARGET} OUT CPP_FILES)
       endif()
+
+      # Generate a manifest declaring what an auto-loaded module provides,
+      # its loading is then deferred until one of these is requested
+      set(autoload_manifest_dir )
+      if(MODULE_AUTOLOAD_SERVICES OR MODULE_AUTOLOAD_MIME_TYPES)
+        if(NOT MODULE_AUTOLOAD_WITH)
+          message(SEND_ERROR "AUTOLOAD_SERVICES and AUTOLOAD_MIME_TYPES require AUTOLOAD_WITH for module \"${MODULE_NAME}\"")
+        endif()
+        if(";${RESOURCE_FILES};" MATCHES ";manifest.json;")
+          message(SEND_ERROR "AUTOLOAD_SERVICES and AUTOLOAD_MIME_TYPES cannot be used with a manifest.json resource file in module \"${MODULE_NAME}\"")
+        endif()
+
+        set(_autoload_mime_type_names )
+        set(_autoload_mime_type_extensions )
+        foreach(_autoload_mime_type ${MODULE_AUTOLOAD_MIME_TYPES})
+          string(FIND "${_autoload_mime_type}" ":" _separator_pos)
+          if(_separator_pos EQUAL -1)
+            list(APPEND _autoload_mime_type_names "${_autoload_mime_type}")
+          else()
+            string(SUBSTRING "${_autoload_mime_type}" 0 ${_separator_pos} _autoload_mime_type_name)
+            math(EXPR _separator_pos "${_separator_pos} + 1")
+            string(SUBSTRING "${_autoload_mime_type}" ${_separator_pos} -1 _extensions)
+            string(TOLOWER "${_extensions}" _extensions)
+            string(REPLACE "," ";" _extensions "${_extensions}")
+            list(APPEND _autoload_mime_type_names "${_autoload_mime_type_name}")
+            list(APPEND _autoload_mime_type_extensions ${_extensions})
+          endif()
+        endforeach()
+
+        set(_autoload_provides )
+        foreach(_key_values "objectclass:MODULE_AUTOLOAD_SERVICES"
+                            "org.mitk.IFileIO.mimetype:_autoload_mime_type_names"
+                            "org.mitk.mimetype.extension:_autoload_mime_type_extensions")
+          string(REPLACE ":" ";" _key_values "${_key_values}")
+          list(GET _key_values 0 _key)
+          list(GET _key_values 1 _values)
+          if(${_values})
+            list(REMOVE_DUPLICATES ${_values})
+            string(REPLACE ";" "\", \"" _values "${${_values}}")
+            list(APPEND _autoload_provides "    \"${_key}\" : [ \"${_values}\" ]")
+          endif()
+        endforeach()
+        string(REPLACE ";" ",\n" _autoload_provides "${_autoload_provides}")
+
+        set(autoload_manifest_dir ${CMAKE_CURRENT_BINARY_DIR}/autoload_manifest)
+        file(WRITE ${autoload_manifest_dir}/manifest.json.tmp
+             "{\n  \"module.autoload_provides\" : {\n${_autoload_provides}\n  }\n}\n")
+        # only touch the manifest if its content changed
+        configure_file(${autoload_manifest_dir}/manifest.json.tmp ${autoload_manifest_dir}/manifest.json COPYONLY)
+
+        if(NOT RESOURCE_FILES)
+          usFunctionGetResourceSource(TARGET ${MODULE_TARGET} OUT CPP_FILES)
+        endif()
+      endif()
     endif()
 
     if(MITK_USE_Qt5)
@@ -568,7 +631,12 @@ function(mitk_create_module)
                                WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}/${res_dir}
                                FILES ${source_res_files})
       endif()
-      if(binary_res_files OR source_res_files)
+      if(autoload_manifest_dir)
+        usFunctionAddResources(TARGET ${MODULE_TARGET}
+                               WORKING_DIRECTORY ${autoload_manifest_dir}
+                               FILES manifest.json)
+      endif()
+      if(binary_res_files OR source_res_files OR autoload_manifest_dir)
         usFunctionEmbedResources(TARGET ${MODULE_TARGET})
       endif()
 
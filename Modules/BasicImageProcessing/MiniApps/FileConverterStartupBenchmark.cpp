@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+#include "mitkLogMacros.h"
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+  // Runs the converter repeatedly and returns the wall times in milliseconds,
+  // or an empty list if a run failed.
+  std::vector<double> RunConverter(const std::string &command, unsigned int repetitions)
+  {
+    std::vector<double> times;
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+      auto start = std::chrono::steady_clock::now();
+      int result = std::system(command.c_str());
+      auto end = std::chrono::steady_clock::now();
+      if (result != 0)
+      {
+        MITK_ERROR << "Command failed with exit code " << result << ": " << command;
+        return std::vector<double>();
+      }
+      times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return times;
+  }
+
+  void PrintTimes(const std::string &mode, const std::vector<double> &times)
+  {
+    double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    double min = *std::min_element(times.begin(), times.end());
+    std::cout << mode << ": mean " << mean << " ms, min " << min << " ms (" << times.size() << " runs)" << std::endl;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("File Converter Startup Benchmark");
+  parser.setCategory("Basic Image Processing");
+  parser.setDescription("Measures the run time of the file converter with lazy and with eager auto-loading of modules");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  // Add command line argument names
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("input", "i", mitkCommandLineParser::File, "Input file:", "Input File", us::Any(), false, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("output", "o", mitkCommandLineParser::File, "Output file:", "Output file", us::Any(), false, false, false, mitkCommandLineParser::Output);
+  parser.addArgument("converter", "c", mitkCommandLineParser::File, "Converter:", "File converter executable, defaults to MitkFileConverter next to this executable", us::Any());
+  parser.addArgument("repetitions", "n", mitkCommandLineParser::Int, "Repetitions:", "Number of runs per auto-loading mode (default: 5)", us::Any());
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  if (parsedArgs.size() == 0)
+    return EXIT_FAILURE;
+
+  // Show a help message
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  std::string inputFilename = us::any_cast<std::string>(parsedArgs["input"]);
+  std::string outputFilename = us::any_cast<std::string>(parsedArgs["output"]);
+
+  std::string converter;
+  if (parsedArgs.count("converter"))
+  {
+    converter = us::any_cast<std::string>(parsedArgs["converter"]);
+  }
+  else
+  {
+    std::string path = itksys::SystemTools::GetFilenamePath(itksys::SystemTools::CollapseFullPath(argv[0]));
+    converter = path + "/MitkFileConverter" + itksys::SystemTools::GetExecutableExtension();
+  }
+
+  int repetitions = 5;
+  if (parsedArgs.count("repetitions"))
+  {
+    repetitions = us::any_cast<int>(parsedArgs["repetitions"]);
+  }
+  if (repetitions < 1)
+  {
+    MITK_ERROR << "The number of repetitions must be positive";
+    return EXIT_FAILURE;
+  }
+
+  const std::string command = "\"" + converter + "\" -i \"" + inputFilename + "\" -o \"" + outputFilename + "\"";
+
+  // The converter processes inherit the environment; lazy auto-loading is opt-in
+  itksys::SystemTools::PutEnv("US_ENABLE_LAZY_AUTOLOADING=1");
+  std::vector<double> lazyTimes = RunConverter(command, repetitions);
+
+  itksys::SystemTools::UnPutEnv("US_ENABLE_LAZY_AUTOLOADING");
+  std::vector<double> eagerTimes = RunConverter(command, repetitions);
+
+  if (lazyTimes.empty() || eagerTimes.empty())
+    return EXIT_FAILURE;
+
+  PrintTimes("Lazy auto-loading", lazyTimes);
+  PrintTimes("Eager auto-loading", eagerTimes);
+
+  return EXIT_SUCCESS;
+}
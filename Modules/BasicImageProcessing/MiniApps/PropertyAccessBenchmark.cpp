@@ -0,0 +1,114 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCommandLineParser.h"
+#include "mitkLogMacros.h"
+
+#include <mitkDataNode.h>
+#include <mitkPointSet.h>
+#include <mitkPropertyKey.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+  // Queries the properties a mapper typically reads per frame and returns the wall time in milliseconds.
+  template <typename TKey>
+  double QueryProperties(const mitk::DataNode *node,
+                         unsigned int numberOfQueries,
+                         const TKey &visibleKey,
+                         const TKey &opacityKey,
+                         const TKey &colorKey,
+                         const TKey &layerKey)
+  {
+    bool visible = true;
+    float opacity = 1.0f;
+    float color[3];
+    int layer = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < numberOfQueries; ++i)
+    {
+      node->GetVisibility(visible, nullptr, visibleKey);
+      node->GetOpacity(opacity, nullptr, opacityKey);
+      node->GetColor(color, nullptr, colorKey);
+      node->GetIntProperty(layerKey, layer);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  mitkCommandLineParser parser;
+
+  parser.setTitle("Property Access Benchmark");
+  parser.setCategory("Basic Image Processing");
+  parser.setDescription("Measures the property lookups of the mappers with string keys and with interned property keys");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  parser.setArgumentPrefix("--", "-");
+  // Add command line argument names
+  parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+  parser.addArgument("nodes", "n", mitkCommandLineParser::Int, "Nodes:", "Number of rendered nodes per frame (default: 1000)", us::Any());
+  parser.addArgument("frames", "f", mitkCommandLineParser::Int, "Frames:", "Number of rendered frames (default: 100)", us::Any());
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+
+  // Show a help message
+  if (parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    std::cout << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  int numberOfNodes = 1000;
+  if (parsedArgs.count("nodes"))
+  {
+    numberOfNodes = us::any_cast<int>(parsedArgs["nodes"]);
+  }
+  int numberOfFrames = 100;
+  if (parsedArgs.count("frames"))
+  {
+    numberOfFrames = us::any_cast<int>(parsedArgs["frames"]);
+  }
+  if (numberOfNodes < 1 || numberOfFrames < 1)
+  {
+    MITK_ERROR << "The number of nodes and frames must be positive";
+    return EXIT_FAILURE;
+  }
+
+  auto node = mitk::DataNode::New();
+  node->SetData(mitk::PointSet::New());
+  node->SetVisibility(false);
+  node->SetOpacity(0.25f);
+  node->SetColor(0.1f, 0.2f, 0.3f);
+  node->SetIntProperty("layer", 7);
+
+  const unsigned int numberOfQueries = static_cast<unsigned int>(numberOfNodes) * numberOfFrames;
+
+  double stringTime = QueryProperties<const char *>(node, numberOfQueries, "visible", "opacity", "color", "layer");
+  double keyTime = QueryProperties(node,
+                                   numberOfQueries,
+                                   mitk::PropertyKey("visible"),
+                                   mitk::PropertyKey("opacity"),
+                                   mitk::PropertyKey("color"),
+                                   mitk::PropertyKey("layer"));
+
+  std::cout << "Property access per frame (" << numberOfNodes << " nodes): string keys " << stringTime / numberOfFrames
+            << " ms, interned keys " << keyTime / numberOfFrames << " ms" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -29,6 +29,7 @@ found in the LICENSE file.
 
 #include "mitkGeometry3D.h"
 #include "mitkLevelWindow.h"
+#include <functional>
 #include <map>
 #include <set>
 
@@ -59,7 +60,7 @@ namespace mitk
   public:
     typedef mitk::Geometry3D::Pointer Geometry3DPointer;
     typedef std::vector<itk::SmartPointer<Mapper>> MapperVector;
-    typedef std::map<std::string, mitk::PropertyList::Pointer> MapOfPropertyLists;
+    typedef std::map<std::string, mitk::PropertyList::Pointer, std::less<>> MapOfPropertyLists;
     typedef std::vector<MapOfPropertyLists::key_type> PropertyListKeyNames;
     typedef std::set<std::string> GroupTagList;
 
@@ -68,6 +69,20 @@ namespace mitk
      * a DataInteractor is set on this DataNode.
      */
     itkEventMacro(InteractorChangedEvent, itk::AnyEvent)
+
+    /**
+     * \brief Definition of an itk::Event that is invoked when
+     * a Mapper is set on this DataNode. Setting a mapper does not
+     * modify the DataNode.
+     */
+    itkEventMacro(MapperChangedEvent, itk::AnyEvent)
+
+    /**
+     * \brief Definition of an itk::Event that is invoked when
+     * a renderer-specific PropertyList is created for this DataNode.
+     */
+    itkEventMacro(PropertyListAddedEvent, itk::AnyEvent)
+
     mitkClassMacroItkParent(DataNode, itk::DataObject);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -231,6 +246,14 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
 
+    /**
+     * \brief Get the property with the interned key \a propertyKey. Lookup order and fallbacks are the same as
+     * for GetProperty(const char *, const mitk::BaseRenderer *, bool), but the lookups in the property lists
+     * are cached (see PropertyList::GetProperty(const PropertyKey &)). Use this for properties that are
+     * queried frequently, e.g. by mappers for every frame.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
+
     /**
      * \brief Get the property of type T with key \a propertyKey from the PropertyList
      * of the \a renderer, if available there, otherwise use the BaseRenderer-independent PropertyList.
@@ -295,6 +318,7 @@ namespace mitk
      * \return \a true property was found
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
+    bool GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
     /**
      * \brief Convenience access method for int properties (instances of
@@ -302,6 +326,7 @@ namespace mitk
      * \return \a true property was found
      */
     bool GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
+    bool GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
     /**
      * \brief Convenience access method for float properties (instances of
@@ -311,6 +336,9 @@ namespace mitk
     bool GetFloatProperty(const char *propertyKey,
                           float &floatValue,
                           const mitk::BaseRenderer *renderer = nullptr) const;
+    bool GetFloatProperty(const PropertyKey &propertyKey,
+                          float &floatValue,
+                          const mitk::BaseRenderer *renderer = nullptr) const;
 
     /**
      * \brief Convenience access method for double properties (instances of
@@ -324,6 +352,9 @@ namespace mitk
     bool GetDoubleProperty(const char *propertyKey,
                            double &doubleValue,
                            const mitk::BaseRenderer *renderer = nullptr) const;
+    bool GetDoubleProperty(const PropertyKey &propertyKey,
+                           double &doubleValue,
+                           const mitk::BaseRenderer *renderer = nullptr) const;
 
     /**
      * \brief Convenience access method for string properties (instances of
@@ -340,6 +371,7 @@ namespace mitk
      * \return \a true property was found
      */
     bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer = nullptr, const char *propertyKey = "color") const;
+    bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
 
     /**
      * \brief Convenience access method for level-window properties (instances of
@@ -349,6 +381,9 @@ namespace mitk
     bool GetLevelWindow(mitk::LevelWindow &levelWindow,
                         const mitk::BaseRenderer *renderer = nullptr,
                         const char *propertyKey = "levelwindow") const;
+    bool GetLevelWindow(mitk::LevelWindow &levelWindow,
+                        const mitk::BaseRenderer *renderer,
+                        const PropertyKey &propertyKey) const;
 
     /**
      * \brief set the node as selected
@@ -423,6 +458,10 @@ namespace mitk
     {
       return GetBoolProperty(propertyKey, visible, renderer);
     }
+    bool GetVisibility(bool &visible, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+    {
+      return GetBoolProperty(propertyKey, visible, renderer);
+    }
 
     /**
      * \brief Convenience access method for opacity properties (instances of
@@ -430,6 +469,7 @@ namespace mitk
      * \return \a true property was found
      */
     bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey = "opacity") const;
+    bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const;
 
     /**
      * \brief Convenience access method for boolean properties (instances
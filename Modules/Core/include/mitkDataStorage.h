@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include "mitkDataNode.h"
 #include "mitkGeometry3D.h"
 #include "mitkMessage.h"
+#include "mitkNodePredicateBase.h"
 #include <MitkCoreExports.h>
 #include <map>
 
@@ -98,6 +99,8 @@ namespace mitk
     //## (see definition of NodePredicateBase for details).
     //## The method returns a set of SmartPointers to the DataNodes that fulfill the
     //## conditions. A set of all objects can be retrieved with the GetAll() method;
+    //## If the condition declares an index (see NodePredicateBase::GetIndexType()) that is
+    //## maintained by the DataStorage, only the nodes of the index are checked.
     SetOfObjects::ConstPointer GetSubset(const NodePredicateBase *condition) const;
 
     //##Documentation
@@ -393,6 +396,15 @@ namespace mitk
     //## If the cast succeeds the ChangedNodeEvent is emitted with this node.
     void OnNodeModifiedOrDeleted(const itk::Object *caller, const itk::EventObject &event);
 
+    //##Documentation
+    //## @brief Returns the nodes that are stored under key in the given secondary index.
+    //##
+    //## Returns nullptr if the DataStorage does not maintain the index; callers then have to
+    //## check all nodes. The returned nodes are candidates and still have to be checked with
+    //## the predicate. Nodes are returned in the same order as by GetAll().
+    //## The default implementation maintains no index.
+    virtual SetOfObjects::ConstPointer GetIndexedNodes(NodePredicateBase::IndexType index, const std::string &key) const;
+
     //##Documentation
     //## @brief  Adds a Modified-Listener to the given Node.
     void AddListeners(const DataNode *_Node);
@@ -108,6 +108,16 @@ namespace mitk
       this->m_ZMax = zMax;
     }
 
+    /** \brief Set the number of slices that are projected onto the 2D output slice (default 1).
+    * The slices are centered around the world geometry and their distance is given by
+    * SetOutputSpacingZDirection(). Other than reslicing a 3D slab and projecting it afterwards,
+    * the projection is computed while resampling, row by row and multithreaded.
+    * Requires an output dimension of 2.
+    */
+    void SetSlabNumberOfSlices(int numberOfSlices) { this->m_SlabNumberOfSlices = numberOfSlices; }
+    /** \brief Set the projection of the slab: VTK_IMAGE_SLAB_MIN, VTK_IMAGE_SLAB_MAX, VTK_IMAGE_SLAB_MEAN or VTK_IMAGE_SLAB_SUM.*/
+    void SetSlabMode(int slabMode) { this->m_SlabMode = slabMode; }
+
     /** \brief Get the bounding box of the slice [xMin, xMax, yMin, yMax, zMin, zMax]
     * The method uses the input of the filter to calculate the bounds.
     * It is recommended to use
@@ -180,6 +190,10 @@ namespace mitk
 
     int m_ZMax;
 
+    int m_SlabNumberOfSlices;
+
+    int m_SlabMode;
+
     ResliceInterpolation m_InterpolationMode;
 
     bool m_InPlaneResampleExtentByGeometry; // Resampling grid corresponds to:  false->image    true->worldgeometry
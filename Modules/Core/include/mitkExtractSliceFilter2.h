@@ -32,10 +32,15 @@ namespace mitk
    * faster by several orders of magnitude as long as the input image was
    * neither changed nor modified.
    *
+   * Nearest neighbor and linear interpolation of scalar pixel types are done
+   * by specialized kernels that step through the index space of the input
+   * image row by row instead of transforming and interpolating each output
+   * pixel separately. Cubic interpolation and composite pixel types are based
+   * on the ITK interpolators.
+   *
    * This filter is completely based on ITK compared to the VTK-based
    * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
-   * an mitk::Image with valid geometry. Generally it is not as fast as
-   * mitk::ExtractSliceFilter, though.
+   * an mitk::Image with valid geometry.
    */
   class MITKCORE_EXPORT ExtractSliceFilter2 final : public ImageToImageFilter
   {
@@ -32,6 +32,15 @@ namespace mitk
     GetStatistics() method in mitk::Image class.
 
     Minimum or maximum might by infinite values. 2nd minimum and maximum are guaranteed to be finite values.
+
+    For scalar images the extrema are kept per brick of BrickSize^3 voxels and time step. The bricks are computed in
+    parallel when the statistics are requested for the first time. Afterwards, a modification of the image only leads to
+    a recomputation of the bricks that have been written to via an mitk::ImageWriteAccessor (see SetDataModified()). The
+    first Modified() of the image after reported writes is regarded as the announcement of these writes. Any other
+    Modified() of the image since the last recomputation (e.g. after a write through the raw buffer of GetData(), a
+    vtkImageData or ImageToItk) leads to a recomputation of all bricks. The extrema of
+    the whole time step as well as of arbitrary sub regions (see GetScalarValueExtremaInRegion()) are merged from the
+    bricks.
     */
   class MITKCORE_EXPORT ImageStatisticsHolder
   {
@@ -44,6 +53,20 @@ namespace mitk
 
     typedef itk::Statistics::Histogram<double> HistogramType;
 
+    /** Edge length of the bricks the extrema are summarized for */
+    static const unsigned int BrickSize = 32;
+
+    /** Extrema of a single brick */
+    struct BrickExtrema
+    {
+      ScalarType Min;
+      ScalarType SecondMin;
+      ScalarType Max;
+      ScalarType SecondMax;
+      unsigned int CountOfMin;
+      unsigned int CountOfMax;
+    };
+
     virtual const HistogramType *GetScalarHistogram(int t = 0, unsigned int = 0);
 
     //##Documentation
@@ -135,6 +158,21 @@ namespace mitk
         return 0;
     }
 
+    //##Documentation
+    //## \brief Get the minimum and maximum of a scalar image within @a region (index coordinates of a single time step).
+    //## Only the voxels of bricks partially covered by @a region are visited, all other bricks use their summary.
+    virtual void GetScalarValueExtremaInRegion(const itk::ImageRegion<3> &region, ScalarType &min, ScalarType &max, int t = 0);
+
+    //##Documentation
+    //## \brief Marks all bricks containing the image memory [begin, end) as modified, so that only these are
+    //## recomputed by the next request. Called by mitk::ImageWriteAccessor when the access ends. Does not call Modified()
+    //## of the image; this is still up to the writer, but the next request recomputes the dirty bricks either way.
+    void SetDataModified(const void *begin, const void *end);
+
+    //##Documentation
+    //## \brief Drops the extrema of all bricks, e.g. because the memory of the image has been reinitialized.
+    void ResetBrickExtrema();
+
     bool IsValidTimeStep(int t) const;
 
     template <typename ItkImageType>
@@ -157,6 +195,18 @@ namespace mitk
 
     ImageTimeSelector::Pointer GetTimeSelector();
 
+    /** Resizes the brick grid to the dimensions of the image; drops all bricks if the dimensions have changed. */
+    void UpdateBrickGrid();
+
+    /** Merges the extrema of all bricks of time step @a t into the extrema of the time step. */
+    void MergeBrickExtrema(int t);
+
+    /** Returns the region of brick @a brickIndex */
+    itk::ImageRegion<3> GetBrickRegion(std::size_t brickIndex) const;
+
+    /** Distinguishes the Modified() announcing reported writes from unreported modifications of the image. */
+    void OnImageModified();
+
     mitk::Image *m_Image;
 
     mutable itk::Object::Pointer m_HistogramGeneratorObject;
@@ -170,6 +220,22 @@ namespace mitk
     mutable std::vector<ScalarType> m_Scalar2ndMax;
 
     itk::TimeStamp m_LastRecomputeTimeStamp;
+
+    /** number of bricks per dimension and the image size they have been created for */
+    itk::Size<3> m_BrickGridSize;
+    itk::Size<3> m_BrickGridImageSize;
+    /** extrema of all bricks per time step, empty if the bricks of the time step have not been computed yet */
+    std::vector<std::vector<BrickExtrema>> m_BrickExtrema;
+    /** bricks written to since they have been computed, per time step */
+    std::vector<std::vector<bool>> m_DirtyBricks;
+    /** true if write accesses have been reported since the last recomputation */
+    bool m_HasReportedModifications;
+    /** true if write accesses have been reported that have not been followed by a Modified() of the image yet */
+    bool m_HasPendingReport;
+    /** true if the image has been modified without a report since the last recomputation */
+    bool m_HasUnreportedModifications;
+    unsigned long m_ImageModifiedObserverTag;
+    itk::SimpleFastMutexLock m_DirtyBricksLock;
   };
 
 } // end namespace
@@ -181,6 +181,9 @@ namespace mitk
       /** \brief Timestamp of last update of stored data. */
       itk::TimeStamp m_LastUpdateTime;
 
+      /** \brief Whether the slice was resliced with reduced quality because the renderer exceeded its frame time budget. */
+      bool m_ReducedQuality;
+
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
 
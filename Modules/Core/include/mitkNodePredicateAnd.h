@@ -44,6 +44,11 @@ namespace mitk
     //## @brief Checks, if the node fulfills all of the subpredicates conditions
     bool CheckNode(const DataNode *node) const override;
 
+    //##Documentation
+    //## @brief Returns the index of the first child predicate that declares one.
+    IndexType GetIndexType() const override;
+    std::string GetIndexKey() const override;
+
   protected:
     //##Documentation
     //## @brief Protected constructor, use static instantiation functions instead
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "itkObject.h"
 #include <MitkCoreExports.h>
 #include <mitkCommon.h>
+#include <string>
 
 namespace mitk
 {
@@ -44,6 +45,29 @@ namespace mitk
     //##Documentation
     //## @brief This method will be used to evaluate the node. Has to be overwritten in subclasses
     virtual bool CheckNode(const mitk::DataNode *node) const = 0;
+
+    //##Documentation
+    //## @brief Secondary indices a DataStorage may maintain to answer predicates without checking every node.
+    enum class IndexType
+    {
+      None,     ///< predicate cannot be answered from an index
+      Name,     ///< index over the value of the StringProperty "name" of the nodes
+      DataType, ///< index over GetNameOfClass() of the node data
+      DataUID   ///< index over the UID of the node data
+    };
+
+    //##Documentation
+    //## @brief Returns the index this predicate can be answered from.
+    //##
+    //## If an index other than IndexType::None is returned, every node that fulfills the predicate
+    //## is stored under GetIndexKey() in this index. DataStorages that maintain the index only check
+    //## these candidates with CheckNode() instead of all nodes. The default implementation returns
+    //## IndexType::None.
+    virtual IndexType GetIndexType() const;
+
+    //##Documentation
+    //## @brief Returns the key of the index returned by GetIndexType(). See GetIndexType() for details.
+    virtual std::string GetIndexKey() const;
   };
 
 } // namespace mitk
@@ -40,6 +40,11 @@ namespace mitk
     //## @brief Checks, if the nodes data object is of a specific data type
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    //##Documentation
+    //## @brief The predicate can be answered from the data type index.
+    IndexType GetIndexType() const override;
+    std::string GetIndexKey() const override;
+
   protected:
     //##Documentation
     //## @brief Protected constructor, use static instantiation functions instead
@@ -34,6 +34,10 @@ namespace mitk
 
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    /** The predicate can be answered from the data UID index.*/
+    IndexType GetIndexType() const override;
+    std::string GetIndexKey() const override;
+
   protected:
     explicit NodePredicateDataUID(const Identifiable::UIDType &uid);
 
@@ -44,6 +44,12 @@ namespace mitk
     //## @brief Checks, if the nodes contains a property that is equal to m_ValidProperty
     bool CheckNode(const mitk::DataNode *node) const override;
 
+    //##Documentation
+    //## @brief The predicate can be answered from the name index, if it checks the non-renderer-specific
+    //## property "name" for a given StringProperty.
+    IndexType GetIndexType() const override;
+    std::string GetIndexKey() const override;
+
   protected:
     //##Documentation
     //## @brief Constructor to check for a named property
@@ -0,0 +1,64 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <cstddef>
+#include <string>
+
+#include <MitkCoreExports.h>
+
+namespace mitk
+{
+  /** @brief Interned property key that allows fast repeated property lookups.
+   *
+   * Constructing a PropertyKey registers the key name once in a process wide registry and assigns
+   * a unique index to it. PropertyList uses this index to cache the result of the lookup until
+   * properties are added to or removed from the list. Thus a PropertyKey is meant to be created once
+   * (e.g. as static constant) and used for many lookups, e.g. by mappers that query the same properties
+   * for every node and every frame:
+   *
+   * \code
+   * static const mitk::PropertyKey opacityKey("opacity");
+   * node->GetOpacity(opacity, renderer, opacityKey);
+   * \endcode
+   *
+   * The constructors are explicit, so that lookups with plain strings keep using the regular
+   * (uncached) methods.
+   *
+   * Creating keys and looking them up is thread-safe: the registry and the lookup caches of the
+   * property lists are guarded by mutexes. As for lookups by name, modifying a property list while
+   * another thread reads it is not.
+   */
+  class MITKCORE_EXPORT PropertyKey final
+  {
+  public:
+    explicit PropertyKey(const std::string &name);
+    explicit PropertyKey(const char *name);
+
+    /** Name of the key. The returned reference stays valid for the lifetime of the process.*/
+    const std::string &GetName() const { return *m_Name; }
+
+    /** Unique index of the key. Indices are assigned consecutively starting with 0.*/
+    std::size_t GetIndex() const { return m_Index; }
+
+    bool operator==(const PropertyKey &other) const { return m_Index == other.m_Index; }
+    bool operator!=(const PropertyKey &other) const { return m_Index != other.m_Index; }
+
+  private:
+    const std::string *m_Name;
+    std::size_t m_Index;
+  };
+} // namespace mitk
+
+#endif
@@ -17,12 +17,16 @@ found in the LICENSE file.
 #include "mitkGenericProperty.h"
 #include "mitkUIDGenerator.h"
 #include "mitkIPropertyOwner.h"
+#include "mitkPropertyKey.h"
 #include <MitkCoreExports.h>
 
 #include <itkObjectFactory.h>
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace mitk
 {
@@ -94,6 +98,16 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     *
+     * The result of the lookup is cached for the key until a property is added to,
+     * replaced in or removed from the list. Repeated lookups of the same key are
+     * therefore cheap. The cache is guarded by a mutex, so concurrent lookups are as
+     * safe as concurrent lookups by name.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -247,6 +261,15 @@ namespace mitk
 
   private:
     itk::LightObject::Pointer InternalClone() const override;
+
+    /** Has to be called whenever the keys of m_Properties or the property objects change.*/
+    void InvalidatePropertyKeyCache();
+
+    /** Results of lookups by PropertyKey, indexed by PropertyKey::GetIndex(). The first element of
+        a pair indicates whether the entry is valid.*/
+    mutable std::vector<std::pair<bool, BaseProperty *>> m_PropertyKeyCache;
+    /** Guards m_PropertyKeyCache, which is written by the const lookups.*/
+    mutable std::mutex m_PropertyKeyCacheMutex;
   };
 
 } // namespace mitk
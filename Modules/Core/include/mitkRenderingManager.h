@@ -19,6 +19,7 @@ found in the LICENSE file.
 
 #include <itkObject.h>
 #include <itkObjectFactory.h>
+#include <chrono>
 #include <string>
 
 #include "mitkProperties.h"
@@ -69,6 +70,18 @@ namespace mitk
    * appropriate event issueing for controlling the update execution process.
    * See method documentation for a description of how this can be done.
    *
+   * Optionally, the execution of pending requests can be scheduled within a
+   * frame time budget (see #SetFrameSchedulingEnabled()). Each call of
+   * #ExecutePendingRequests() then renders the focused RenderWindow first,
+   * followed by the other requested RenderWindows as long as their expected
+   * frame time fits into the remaining budget. RenderWindows that do not fit
+   * stay requested for the next call (at most a few times in a row, so that no
+   * RenderWindow starves). RenderWindows exceeding their share of the budget
+   * are rendered with reduced quality (see #IsReducedQualityRendering()) until
+   * the interaction stops and the high resolution timer restores the full
+   * quality. Frame time statistics are collected for all registered
+   * RenderWindows (see #GetRenderWindowStatistics()).
+   *
    * \sa TestingRenderingManager An "empty" RenderingManager implementation which
    * can be used in tests etc.
    *
@@ -203,6 +216,55 @@ namespace mitk
     bool IsRendering() const;
     void AbortRendering();
 
+    /** \brief Frame time statistics of a RenderWindow. All times are given in milliseconds.
+     *
+     * averageFrameTime is an exponential moving average that follows changes of the
+     * rendered scene within a few frames.
+     */
+    struct RenderWindowStatistics
+    {
+      unsigned long numberOfFrames = 0;
+      unsigned long numberOfReducedQualityFrames = 0;
+      unsigned long numberOfDeferredRequests = 0;
+      double lastFrameTime = 0.0;
+      double averageFrameTime = 0.0;
+      double maximumFrameTime = 0.0;
+    };
+
+    /** En-/Disable scheduling of pending requests within the frame time budget. */
+    itkSetMacro(FrameSchedulingEnabled, bool);
+
+    /** En-/Disable scheduling of pending requests within the frame time budget. */
+    itkGetMacro(FrameSchedulingEnabled, bool);
+
+    /** En-/Disable scheduling of pending requests within the frame time budget. */
+    itkBooleanMacro(FrameSchedulingEnabled);
+
+    /** Time in milliseconds available for executing all pending requests at once (default: 1000 / 30). */
+    itkSetMacro(FrameTimeBudget, double);
+
+    /** Time in milliseconds available for executing all pending requests at once (default: 1000 / 30). */
+    itkGetMacro(FrameTimeBudget, double);
+
+    /** Sets the frame time budget in milliseconds of a single RenderWindow. If it is exceeded
+     * while frame scheduling is enabled, the RenderWindow is rendered with reduced quality.
+     * A budget of 0 (default) means an equal share of the global frame time budget. */
+    void SetRenderWindowFrameTimeBudget(vtkRenderWindow *renderWindow, double budget);
+
+    /** Returns the effective frame time budget in milliseconds of a RenderWindow. */
+    double GetRenderWindowFrameTimeBudget(vtkRenderWindow *renderWindow) const;
+
+    /** Returns the frame time statistics of a registered RenderWindow (empty statistics otherwise). */
+    RenderWindowStatistics GetRenderWindowStatistics(vtkRenderWindow *renderWindow) const;
+
+    /** Resets the frame time statistics of all registered RenderWindows. */
+    void ResetRenderWindowStatistics();
+
+    /** Returns true, if the renderer exceeded its frame time budget during the current interaction.
+     * Mappers should then fall back on cheaper rendering, e.g. nearest neighbour reslicing or
+     * a lower sample distance. */
+    bool IsReducedQualityRendering(const BaseRenderer *renderer) const;
+
     /** En-/Disable LOD increase globally. */
     itkSetMacro(LODIncreaseBlocked, bool);
 
@@ -309,6 +371,12 @@ namespace mitk
 
     virtual void InitializePropertyList();
 
+    /** Renders the requested RenderWindows by priority within the frame time budget. */
+    void ExecuteScheduledRequests();
+
+    /** Updates the frame time statistics and the quality state of a RenderWindow after rendering. */
+    void UpdateRenderWindowStatistics(vtkRenderWindow *renderWindow);
+
     bool m_UpdatePending;
 
     typedef std::map<BaseRenderer *, unsigned int> RendererIntMap;
@@ -348,6 +416,24 @@ namespace mitk
 
     RenderWindowCallbacksList m_RenderWindowCallbacksList;
 
+    struct RenderWindowSchedulingState
+    {
+      RenderWindowStatistics statistics;
+      std::chrono::steady_clock::time_point renderingStartTime;
+      double frameTimeBudget = 0.0;
+      unsigned int numberOfConsecutiveDeferrals = 0;
+      bool reducedQuality = false;
+      bool restoringQuality = false;
+    };
+
+    typedef std::map<vtkRenderWindow *, RenderWindowSchedulingState> RenderWindowSchedulingStates;
+
+    RenderWindowSchedulingStates m_RenderWindowSchedulingStates;
+
+    bool m_FrameSchedulingEnabled;
+
+    double m_FrameTimeBudget;
+
     itk::SmartPointer<SliceNavigationController> m_TimeNavigationController;
 
     static RenderingManager::Pointer s_Instance;
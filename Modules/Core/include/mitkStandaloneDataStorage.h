@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkMessage.h"
 #include <map>
+#include <set>
 
 namespace mitk
 {
@@ -32,6 +33,10 @@ namespace mitk
   //## Thus, nodes are stored in a noncyclical directed graph data structure.
   //## It is derived from mitk::DataStorage and implements its interface,
   //## including AddNodeEvent and RemoveNodeEvent.
+  //## Additionally it maintains secondary indices over the node names, the data types and the data UIDs
+  //## (see NodePredicateBase::IndexType), so GetSubset() queries with predicates declaring one of these
+  //## indices and GetNamedNode() do not have to check every node. The indices are kept up to date by
+  //## observing the nodes and their "name" properties.
   //## @ingroup StandaloneDataStorage
   class MITKCORE_EXPORT StandaloneDataStorage : public mitk::DataStorage
   {
@@ -122,12 +127,61 @@ namespace mitk
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
 
+    //##Documentation
+    //## @brief Returns the nodes stored under key in the given secondary index
+    SetOfObjects::ConstPointer GetIndexedNodes(NodePredicateBase::IndexType index, const std::string &key) const override;
+
+    //##Documentation
+    //## @brief Adds the node to the secondary indices and registers the observers that keep them up to date.
+    //## Has to be called with locked m_Mutex.
+    void AddToIndices(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief Removes the node from the secondary indices and removes its observers.
+    //## Has to be called with locked m_Mutex.
+    void RemoveFromIndices(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief Recomputes the index keys of the node and moves it within the secondary indices if needed.
+    //## Has to be called with locked m_Mutex.
+    void UpdateIndices(const mitk::DataNode *node);
+
+    //##Documentation
+    //## @brief Called if an indexed node is modified (e.g. new data or a replaced name property).
+    void OnIndexedNodeModified(const itk::Object *caller, const itk::EventObject &event);
+
+    //##Documentation
+    //## @brief Called if the observed "name" property of an indexed node is modified.
+    void OnNamePropertyModified(const itk::Object *caller, const itk::EventObject &event);
+
+    //##Documentation
+    //## @brief Nodes of a secondary index sorted like the nodes of the adjacency lists (and thus of GetAll())
+    typedef std::set<mitk::DataNode::ConstPointer> IndexedNodeSet;
+    typedef std::map<std::string, IndexedNodeSet> NodeIndex;
+
+    //##Documentation
+    //## @brief Keys and observers of an indexed node
+    struct IndexedNodeInfo
+    {
+      std::map<NodePredicateBase::IndexType, std::string> keys;
+      unsigned long nodeModifiedTag = 0;
+      BaseProperty::ConstPointer nameProperty;
+      unsigned long namePropertyModifiedTag = 0;
+    };
+
     //##Documentation
     //## @brief Nodes and their relation are stored in m_SourceNodes
     AdjacencyList m_SourceNodes;
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+
+    //##Documentation
+    //## @brief Secondary indices (index type -> key -> nodes)
+    std::map<NodePredicateBase::IndexType, NodeIndex> m_Indices;
+    //##Documentation
+    //## @brief Index keys and observer tags of every node in the StandaloneDataStorage
+    std::map<const mitk::DataNode *, IndexedNodeInfo> m_IndexedNodes;
   };
 } // namespace mitk
 #endif /* MITKSTANDALONEDATASTORAGE_H_HEADER_INCLUDED_ */
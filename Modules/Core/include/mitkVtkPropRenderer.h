@@ -20,7 +20,10 @@ found in the LICENSE file.
 #include <mitkRenderingManager.h>
 
 #include <map>
+#include <mutex>
+#include <set>
 #include <utility>
+#include <vector>
 
 class vtkRenderWindow;
 class vtkLight;
@@ -49,6 +52,12 @@ namespace mitk
   It redirects render() calls to the VtkPropRenderer, which is responsible for rendering of the datatreenodes.
   VtkPropRenderer replaces the old OpenGLRenderer.
 
+  The layer-sorted mapper queue is kept between frames. It is updated from the add and remove events of the
+  DataStorage and from modified events of the nodes and of their renderer-specific property lists (e.g. changes of
+  the "layer" or "visible" properties). Thus preparing a frame only re-evaluates the nodes that changed since the
+  last frame. Mappers of the same layer are ordered by the time their nodes were added to the DataStorage. Nodes that
+  were already in the DataStorage when it was set to the renderer are ordered before all later added nodes.
+
   \sa rendering
   \ingroup rendering
   */
@@ -202,6 +211,45 @@ namespace mitk
     // prepare all mitk::mappers for rendering
     void PrepareMapperQueue();
 
+    /** \brief Entry of a data node in the persistent mapper queue */
+    struct MapperQueueEntry
+    {
+      /** mapper of the node in m_MappersMap (null, if the node has no mapper for the current mapper ID) */
+      itk::SmartPointer<Mapper> mapper;
+      /** key of the mapper in m_MappersMap */
+      int key = 0;
+      /** orders the mappers of the same layer in the order the nodes were added (compact rank of the insertion
+          number of the node, see m_MapperQueueInsertionNumbers) */
+      unsigned int sequenceNumber = 0;
+      /** true, if the mapper is counted in m_NumberOfVisibleLODEnabledMappers */
+      bool visibleLODEnabled = false;
+      /** objects whose modification outdates the entry (node, renderer-specific property list, "layer" and
+          "visible" properties) and the tags of the observers; the node is observed for several events */
+      std::vector<std::pair<itk::Object::ConstPointer, unsigned long>> observedObjects;
+    };
+
+    /** \brief Applies the nodes added to and removed from the data storage and re-evaluates the outdated entries
+        of the mapper queue. Rebuilds the queue, if the data storage or the mapper ID changed. */
+    void UpdateMapperQueue();
+
+    /** \brief Removes all entries and observers of the mapper queue. */
+    void ClearMapperQueue();
+
+    void AddToMapperQueue(const DataNode *node);
+    void RemoveFromMapperQueue(const DataNode *node);
+
+    /** \brief Reads mapper, layer and visibility of the node, (re)sorts its mapper into m_MappersMap and observes
+        the objects the entry depends on. */
+    void UpdateMapperQueueEntry(const DataNode *node, MapperQueueEntry &entry);
+    void RemoveMapperQueueObservers(const DataNode *node, MapperQueueEntry &entry);
+
+    void AddDataStorageListeners();
+    void RemoveDataStorageListeners();
+
+    void OnMapperQueueNodeAdded(const DataNode *node);
+    void OnMapperQueueNodeRemoved(const DataNode *node);
+    void OnMapperQueueObjectModified(const itk::Object *caller, const itk::EventObject &event);
+
     /** \brief Propagate vtkInformation object to all VTK-based mappers */
     void PropagateRenderInfoToMappers();
 
@@ -227,6 +275,28 @@ namespace mitk
     // sorted list of mappers
     MappersMapType m_MappersMap;
 
+    // entries of all nodes of the data storage in the mapper queue
+    std::map<const DataNode *, MapperQueueEntry> m_MapperQueueEntries;
+    // guards the members that are accessed by the observers of the mapper queue, which may be notified by other
+    // threads than the rendering thread: m_MapperQueueNodeEvents, m_OutdatedMapperQueueNodes and
+    // m_MapperQueueObservedObjects
+    std::mutex m_MapperQueueMutex;
+    // nodes added to (true) or removed from (false) the data storage since the last frame, in the order of the
+    // events; they are applied to the queue by the rendering thread
+    std::vector<std::pair<const DataNode *, bool>> m_MapperQueueNodeEvents;
+    // nodes whose entry has to be re-evaluated before the next frame
+    std::set<const DataNode *> m_OutdatedMapperQueueNodes;
+    // observed objects and the nodes whose entries depend on them
+    std::multimap<const itk::Object *, const DataNode *> m_MapperQueueObservedObjects;
+    unsigned int m_NextMapperQueueSequenceNumber;
+    // numbers the nodes in the order they were added to the data storage; kept when the queue is rebuilt, so that
+    // nodes of the same layer keep their order
+    std::map<const DataNode *, unsigned long> m_MapperQueueInsertionNumbers;
+    unsigned long m_NextMapperQueueInsertionNumber;
+    // true, if the whole queue has to be rebuilt
+    bool m_MapperQueueOutdated;
+    MapperSlotId m_MapperQueueMapperID;
+
     // rendering of text
     vtkRenderer *m_TextRenderer;
     typedef std::map<unsigned int, vtkTextActor *> TextMapType;
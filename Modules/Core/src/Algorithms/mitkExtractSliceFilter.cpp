@@ -42,6 +42,8 @@ mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(
   m_ZSpacing = 1.0;
   m_ZMin = 0;
   m_ZMax = 0;
+  m_SlabNumberOfSlices = 1;
+  m_SlabMode = VTK_IMAGE_SLAB_MEAN;
   m_VtkOutputRequested = false;
   m_BackgroundLevel = -32768.0;
   m_Component = 0;
@@ -397,6 +399,10 @@ void mitk::ExtractSliceFilter::GenerateData()
   // we only have one slice, not a volume
   m_Reslicer->SetOutputDimensionality(m_OutputDimension);
 
+  // project multiple slices while reslicing (thick slices)
+  m_Reslicer->SetSlabNumberOfSlices(2 == m_OutputDimension ? std::max(1, m_SlabNumberOfSlices) : 1);
+  m_Reslicer->SetSlabMode(m_SlabMode);
+
   // set the interpolation mode for slicing
   switch (this->m_InterpolationMode)
   {
@@ -19,7 +19,10 @@ found in the LICENSE file.
 #include <itkLinearInterpolateImageFunction.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <type_traits>
 
 struct mitk::ExtractSliceFilter2::Impl
 {
@@ -75,7 +78,7 @@ namespace
   }
 
   template <typename TPixel, unsigned int VImageDimension>
-  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
+  void GenerateDataByInterpolateImageFunction(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
   {
     typedef itk::Image<TPixel, VImageDimension> TInputImage;
     typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
@@ -132,6 +135,250 @@ namespace
     }
   }
 
+  /** \brief Sampling positions of the output plane in the continuous index space of the input image.
+   *
+   * The transformation from the output plane into the index space is affine. Thus the continuous
+   * index of output pixel (x, y) is Origin + x * XStep + y * YStep, which is evaluated without
+   * any matrix multiplication or virtual call per pixel.
+   */
+  struct IndexSpaceStepping
+  {
+    double Origin[3];
+    double XStep[3];
+    double YStep[3];
+    double Size[3];
+
+    /** A continuous index is inside of the image, if -0.5 <= index < size - 0.5 for each dimension, like in ITK. */
+    bool IsInside(std::size_t x, const double* rowOrigin) const
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        const double index = rowOrigin[i] + x * XStep[i];
+
+        if (!(index >= -0.5 && index < Size[i] - 0.5))
+          return false;
+      }
+
+      return true;
+    }
+
+    /** Returns the range [first, last) of a row within [begin, end) whose pixels are inside of the image. */
+    void ComputeInsideRange(const double* rowOrigin, std::size_t begin, std::size_t end, std::size_t& first, std::size_t& last) const
+    {
+      double lower = static_cast<double>(begin);
+      double upper = static_cast<double>(end);
+
+      for (int i = 0; i < 3; ++i)
+      {
+        if (0.0 == XStep[i])
+        {
+          if (!(rowOrigin[i] >= -0.5 && rowOrigin[i] < Size[i] - 0.5))
+            upper = lower;
+
+          continue;
+        }
+
+        double a = (-0.5 - rowOrigin[i]) / XStep[i];
+        double b = (Size[i] - 0.5 - rowOrigin[i]) / XStep[i];
+
+        if (a > b)
+          std::swap(a, b);
+
+        lower = std::max(lower, std::ceil(a));
+        upper = std::min(upper, std::floor(b) + 1.0);
+      }
+
+      if (!(lower < upper))
+      {
+        first = last = begin;
+        return;
+      }
+
+      first = static_cast<std::size_t>(lower);
+      last = static_cast<std::size_t>(upper);
+
+      // The inside pixels of a row are contiguous, so rounding errors of the analytic solution
+      // only have to be corrected at both ends of the range.
+      while (first < last && !this->IsInside(first, rowOrigin))
+        ++first;
+
+      while (first > begin && this->IsInside(first - 1, rowOrigin))
+        --first;
+
+      while (last > first && !this->IsInside(last - 1, rowOrigin))
+        --last;
+
+      while (last < end && last > first && this->IsInside(last, rowOrigin))
+        ++last;
+    }
+  };
+
+  template <typename TPixel>
+  struct NearestNeighborKernel
+  {
+    static void ResliceRow(const TPixel* input, const itk::OffsetValueType* offsets, const IndexSpaceStepping&, const double* rowOrigin, const double* xStep, std::size_t first, std::size_t last, TPixel* output)
+    {
+      // Indices are >= -0.5 inside of the image, so truncating index + 0.5 is rounding half up
+      for (std::size_t x = first; x < last; ++x)
+      {
+        const auto i = static_cast<itk::OffsetValueType>(rowOrigin[0] + x * xStep[0] + 0.5);
+        const auto j = static_cast<itk::OffsetValueType>(rowOrigin[1] + x * xStep[1] + 0.5);
+        const auto k = static_cast<itk::OffsetValueType>(rowOrigin[2] + x * xStep[2] + 0.5);
+
+        output[x] = input[i * offsets[0] + j * offsets[1] + k * offsets[2]];
+      }
+    }
+  };
+
+  template <typename TPixel>
+  struct LinearKernel
+  {
+    static void ResliceRow(const TPixel* input, const itk::OffsetValueType* offsets, const IndexSpaceStepping& stepping, const double* rowOrigin, const double* xStep, std::size_t first, std::size_t last, TPixel* output)
+    {
+      // Indices are clamped to the image, so that the border pixels are extended by half a pixel.
+      // Dimensions of size 1 use the same pixel as neighbor.
+      double maxIndex[3];
+      double maxBase[3];
+      itk::OffsetValueType neighborOffsets[3];
+
+      for (int d = 0; d < 3; ++d)
+      {
+        maxIndex[d] = stepping.Size[d] - 1.0;
+        maxBase[d] = std::max(0.0, stepping.Size[d] - 2.0);
+        neighborOffsets[d] = stepping.Size[d] > 1.0 ? offsets[d] : 0;
+      }
+
+      for (std::size_t x = first; x < last; ++x)
+      {
+        itk::OffsetValueType offset = 0;
+        double t[3];
+
+        for (int d = 0; d < 3; ++d)
+        {
+          const double index = std::min(std::max(rowOrigin[d] + x * xStep[d], 0.0), maxIndex[d]);
+          const double base = std::min(std::floor(index), maxBase[d]);
+
+          t[d] = index - base;
+          offset += static_cast<itk::OffsetValueType>(base) * offsets[d];
+        }
+
+        const TPixel* p = input + offset;
+
+        const double v00 = p[0] + t[0] * (static_cast<double>(p[neighborOffsets[0]]) - p[0]);
+        const double v10 = p[neighborOffsets[1]] + t[0] * (static_cast<double>(p[neighborOffsets[1] + neighborOffsets[0]]) - p[neighborOffsets[1]]);
+        const double v01 = p[neighborOffsets[2]] + t[0] * (static_cast<double>(p[neighborOffsets[2] + neighborOffsets[0]]) - p[neighborOffsets[2]]);
+        const double v11 = p[neighborOffsets[2] + neighborOffsets[1]] + t[0] * (static_cast<double>(p[neighborOffsets[2] + neighborOffsets[1] + neighborOffsets[0]]) - p[neighborOffsets[2] + neighborOffsets[1]]);
+
+        const double v0 = v00 + t[1] * (v10 - v00);
+        const double v1 = v01 + t[1] * (v11 - v01);
+
+        output[x] = static_cast<TPixel>(v0 + t[2] * (v1 - v0));
+      }
+    }
+  };
+
+  template <template <typename> class TKernel, typename TPixel, unsigned int VImageDimension>
+  void ResliceWithKernel(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion)
+  {
+    auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
+
+    auto origin = outputGeometry->GetOrigin();
+    auto spacing = outputGeometry->GetSpacing();
+    auto xDirection = outputGeometry->GetAxisVector(0);
+    auto yDirection = outputGeometry->GetAxisVector(1);
+
+    xDirection.Normalize();
+    yDirection.Normalize();
+
+    // Transform the origin and one step along each axis of the output plane into the index space of
+    // the input image once. Indices are relative to the buffered region of the input image.
+    itk::ContinuousIndex<double, 3> originIndex;
+    itk::ContinuousIndex<double, 3> xIndex;
+    itk::ContinuousIndex<double, 3> yIndex;
+
+    inputImage->TransformPhysicalPointToContinuousIndex(origin, originIndex);
+    inputImage->TransformPhysicalPointToContinuousIndex(origin + xDirection * spacing[0], xIndex);
+    inputImage->TransformPhysicalPointToContinuousIndex(origin + yDirection * spacing[1], yIndex);
+
+    const auto bufferedRegion = inputImage->GetBufferedRegion();
+    const auto* offsetTable = inputImage->GetOffsetTable();
+
+    IndexSpaceStepping stepping;
+    itk::OffsetValueType offsets[3];
+
+    for (int i = 0; i < 3; ++i)
+    {
+      stepping.Origin[i] = originIndex[i] - bufferedRegion.GetIndex(i);
+      stepping.XStep[i] = xIndex[i] - originIndex[i];
+      stepping.YStep[i] = yIndex[i] - originIndex[i];
+      stepping.Size[i] = static_cast<double>(bufferedRegion.GetSize(i));
+      offsets[i] = offsetTable[i];
+    }
+
+    const std::size_t width = outputGeometry->GetExtent(0);
+    const std::size_t xBegin = outputRegion.GetIndex(0);
+    const std::size_t yBegin = outputRegion.GetIndex(1);
+    const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
+    const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
+
+    mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
+    auto data = static_cast<TPixel*>(writeAccess.GetData());
+
+    const TPixel* input = inputImage->GetBufferPointer();
+    const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
+
+    double rowOrigin[3];
+    std::size_t first;
+    std::size_t last;
+
+    for (std::size_t y = yBegin; y < yEnd; ++y)
+    {
+      for (int i = 0; i < 3; ++i)
+        rowOrigin[i] = stepping.Origin[i] + y * stepping.YStep[i];
+
+      stepping.ComputeInsideRange(rowOrigin, xBegin, xEnd, first, last);
+
+      auto row = data + width * y;
+
+      std::fill(row + xBegin, row + first, backgroundPixel);
+      TKernel<TPixel>::ResliceRow(input, offsets, stepping, rowOrigin, stepping.XStep, first, last, row);
+      std::fill(row + last, row + xEnd, backgroundPixel);
+    }
+  }
+
+  /** Reslices images of scalar pixel types with the specialized nearest neighbor and linear kernels. */
+  template <typename TPixel, unsigned int VImageDimension>
+  bool Reslice(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, mitk::ExtractSliceFilter2::Interpolator interpolator, std::true_type)
+  {
+    switch (interpolator)
+    {
+      case mitk::ExtractSliceFilter2::NearestNeighbor:
+        ResliceWithKernel<NearestNeighborKernel>(inputImage, outputImage, outputRegion);
+        return true;
+
+      case mitk::ExtractSliceFilter2::Linear:
+        ResliceWithKernel<LinearKernel>(inputImage, outputImage, outputRegion);
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  bool Reslice(const itk::Image<TPixel, VImageDimension>*, mitk::Image*, const mitk::ExtractSliceFilter2::OutputImageRegionType&, mitk::ExtractSliceFilter2::Interpolator, std::false_type)
+  {
+    return false;
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object* interpolateImageFunction)
+  {
+    // Cubic interpolation and composite pixel types fall back on the ITK interpolators
+    if (!Reslice(inputImage, outputImage, outputRegion, interpolator, typename std::is_arithmetic<TPixel>::type()))
+      GenerateDataByInterpolateImageFunction(inputImage, outputImage, outputRegion, interpolateImageFunction);
+  }
+
   void VerifyInputImage(const mitk::Image* inputImage)
   {
     auto dimension = inputImage->GetDimension();
@@ -223,7 +470,7 @@ void mitk::ExtractSliceFilter2::GenerateData()
   this->AllocateOutputs();
   auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
 
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
+  AccessFixedDimensionByItk_n(inputImage, ::GenerateData, 3, (this->GetOutput(), outputRegion, this->GetInterpolator(), m_Impl->InterpolateImageFunction.GetPointer()));
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
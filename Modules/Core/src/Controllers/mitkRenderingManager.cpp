@@ -29,6 +29,20 @@ found in the LICENSE file.
 
 #include <algorithm>
 
+namespace
+{
+  // weight of the most recent frame time in the average frame time of a render window
+  constexpr double FrameTimeSmoothingFactor = 0.2;
+
+  // number of passes a render window may be deferred in a row before it is rendered regardless of the budget
+  constexpr unsigned int MaximumNumberOfConsecutiveDeferrals = 2;
+
+  double GetMillisecondsSince(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
 namespace mitk
 {
   itkEventMacroDefinition(FocusChangedEvent, itk::AnyEvent);
@@ -42,6 +56,8 @@ namespace mitk
       m_LODIncreaseBlocked(false),
       m_LODAbortMechanismEnabled(false),
       m_ClippingPlaneEnabled(false),
+      m_FrameSchedulingEnabled(false),
+      m_FrameTimeBudget(1000.0 / 30.0),
       m_TimeNavigationController(SliceNavigationController::New()),
       m_DataStorage(nullptr),
       m_ConstrainedPanningZooming(true),
@@ -122,6 +138,7 @@ namespace mitk
     if (renderWindow && (m_RenderWindowList.find(renderWindow) == m_RenderWindowList.end()))
     {
       m_RenderWindowList[renderWindow] = RENDERING_INACTIVE;
+      m_RenderWindowSchedulingStates[renderWindow] = RenderWindowSchedulingState();
       m_AllRenderWindows.push_back(renderWindow);
 
       if (m_DataStorage.IsNotNull())
@@ -162,6 +179,8 @@ namespace mitk
   {
     if (m_RenderWindowList.erase(renderWindow))
     {
+      m_RenderWindowSchedulingStates.erase(renderWindow);
+
       auto callbacks_it = this->m_RenderWindowCallbacksList.find(renderWindow);
       if (callbacks_it != this->m_RenderWindowCallbacksList.end())
       {
@@ -520,6 +539,12 @@ namespace mitk
   {
     m_UpdatePending = false;
 
+    if (m_FrameSchedulingEnabled)
+    {
+      this->ExecuteScheduledRequests();
+      return;
+    }
+
     // Satisfy all pending update requests
     RenderWindowList::const_iterator it;
     int i = 0;
@@ -532,14 +557,125 @@ namespace mitk
     }
   }
 
+  void RenderingManager::ExecuteScheduledRequests()
+  {
+    // Requests are coalesced per window, thus each requested window is rendered at most once per pass
+    RenderWindowVector requestedRenderWindows;
+    for (const auto &renderWindow : m_RenderWindowList)
+    {
+      if (renderWindow.second == RENDERING_REQUESTED)
+        requestedRenderWindows.push_back(renderWindow.first);
+    }
+
+    if (requestedRenderWindows.empty())
+      return;
+
+    // The focused window comes first, followed by the most often deferred windows. Cheap windows
+    // are preferred over expensive ones, so that as many windows as possible fit into the budget.
+    std::stable_sort(requestedRenderWindows.begin(),
+                     requestedRenderWindows.end(),
+                     [this](vtkRenderWindow *left, vtkRenderWindow *right) {
+                       if ((left == m_FocusedRenderWindow) != (right == m_FocusedRenderWindow))
+                         return left == m_FocusedRenderWindow;
+
+                       const auto &leftState = m_RenderWindowSchedulingStates[left];
+                       const auto &rightState = m_RenderWindowSchedulingStates[right];
+
+                       if (leftState.numberOfConsecutiveDeferrals != rightState.numberOfConsecutiveDeferrals)
+                         return leftState.numberOfConsecutiveDeferrals > rightState.numberOfConsecutiveDeferrals;
+
+                       return leftState.statistics.averageFrameTime < rightState.statistics.averageFrameTime;
+                     });
+
+    const auto passStartTime = std::chrono::steady_clock::now();
+    bool requestsDeferred = false;
+
+    for (auto renderWindow : requestedRenderWindows)
+    {
+      // Observers of a previously rendered window may have rendered or removed this window meanwhile
+      auto it = m_RenderWindowList.find(renderWindow);
+      if (it == m_RenderWindowList.end() || it->second != RENDERING_REQUESTED)
+        continue;
+
+      auto &state = m_RenderWindowSchedulingStates[renderWindow];
+
+      bool mustRender = renderWindow == requestedRenderWindows.front() || renderWindow == m_FocusedRenderWindow ||
+                        state.numberOfConsecutiveDeferrals >= MaximumNumberOfConsecutiveDeferrals;
+
+      if (!mustRender &&
+          GetMillisecondsSince(passStartTime) + state.statistics.averageFrameTime > m_FrameTimeBudget)
+      {
+        ++state.numberOfConsecutiveDeferrals;
+        ++state.statistics.numberOfDeferredRequests;
+        requestsDeferred = true;
+        continue;
+      }
+
+      state.numberOfConsecutiveDeferrals = 0;
+      this->ForceImmediateUpdate(renderWindow);
+    }
+
+    if (requestsDeferred && !m_UpdatePending)
+    {
+      m_UpdatePending = true;
+      this->GenerateRenderingRequestEvent();
+    }
+  }
+
+  void RenderingManager::UpdateRenderWindowStatistics(vtkRenderWindow *renderWindow)
+  {
+    auto it = m_RenderWindowSchedulingStates.find(renderWindow);
+    if (it == m_RenderWindowSchedulingStates.end())
+      return;
+
+    auto &state = it->second;
+    auto &statistics = state.statistics;
+    double frameTime = GetMillisecondsSince(state.renderingStartTime);
+
+    statistics.lastFrameTime = frameTime;
+    statistics.averageFrameTime = 0 == statistics.numberOfFrames
+                                    ? frameTime
+                                    : (1.0 - FrameTimeSmoothingFactor) * statistics.averageFrameTime +
+                                        FrameTimeSmoothingFactor * frameTime;
+    statistics.maximumFrameTime = std::max(statistics.maximumFrameTime, frameTime);
+    ++statistics.numberOfFrames;
+
+    if (!m_FrameSchedulingEnabled)
+      return;
+
+    if (state.reducedQuality)
+      ++statistics.numberOfReducedQualityFrames;
+
+    // The frame that restores the full quality is expected to be expensive and must not
+    // switch back to reduced quality
+    if (state.restoringQuality)
+    {
+      state.restoringQuality = false;
+      return;
+    }
+
+    if (frameTime > this->GetRenderWindowFrameTimeBudget(renderWindow))
+      state.reducedQuality = true;
+
+    // The timer is reset with every frame and thus fires as soon as the interaction stopped
+    if (state.reducedQuality)
+      this->StartOrResetTimer();
+  }
+
   void RenderingManager::RenderingStartCallback(vtkObject *caller, unsigned long, void *, void *)
   {
     auto renderingManager = RenderingManager::GetInstance();
     auto renderWindow = dynamic_cast<vtkRenderWindow*>(caller);
 
     if (nullptr != renderWindow)
+    {
       renderingManager->m_RenderWindowList[renderWindow] = RENDERING_INPROGRESS;
 
+      auto it = renderingManager->m_RenderWindowSchedulingStates.find(renderWindow);
+      if (it != renderingManager->m_RenderWindowSchedulingStates.end())
+        it->second.renderingStartTime = std::chrono::steady_clock::now();
+    }
+
     renderingManager->m_UpdatePending = false;
   }
 
@@ -573,6 +709,7 @@ namespace mitk
       {
         auto renderingManager = RenderingManager::GetInstance();
         renderingManager->m_RenderWindowList[renderer->GetRenderWindow()] = RENDERING_INACTIVE;
+        renderingManager->UpdateRenderWindowStatistics(renderWindow);
 
         if (0 < renderer->GetNumberOfVisibleLODEnabledMappers())
         {
@@ -643,6 +780,54 @@ namespace mitk
         }
       }
     }
+
+    for (auto &state : m_RenderWindowSchedulingStates)
+    {
+      if (state.second.reducedQuality)
+      {
+        state.second.reducedQuality = false;
+        state.second.restoringQuality = true;
+        this->RequestUpdate(state.first);
+      }
+    }
+  }
+
+  void RenderingManager::SetRenderWindowFrameTimeBudget(vtkRenderWindow *renderWindow, double budget)
+  {
+    auto it = m_RenderWindowSchedulingStates.find(renderWindow);
+    if (it != m_RenderWindowSchedulingStates.end())
+      it->second.frameTimeBudget = std::max(0.0, budget);
+  }
+
+  double RenderingManager::GetRenderWindowFrameTimeBudget(vtkRenderWindow *renderWindow) const
+  {
+    auto it = m_RenderWindowSchedulingStates.find(renderWindow);
+    if (it != m_RenderWindowSchedulingStates.end() && it->second.frameTimeBudget > 0.0)
+      return it->second.frameTimeBudget;
+
+    return m_FrameTimeBudget / std::max<std::size_t>(1, m_RenderWindowSchedulingStates.size());
+  }
+
+  RenderingManager::RenderWindowStatistics RenderingManager::GetRenderWindowStatistics(
+    vtkRenderWindow *renderWindow) const
+  {
+    auto it = m_RenderWindowSchedulingStates.find(renderWindow);
+    return it != m_RenderWindowSchedulingStates.end() ? it->second.statistics : RenderWindowStatistics();
+  }
+
+  void RenderingManager::ResetRenderWindowStatistics()
+  {
+    for (auto &state : m_RenderWindowSchedulingStates)
+      state.second.statistics = RenderWindowStatistics();
+  }
+
+  bool RenderingManager::IsReducedQualityRendering(const BaseRenderer *renderer) const
+  {
+    if (!m_FrameSchedulingEnabled || nullptr == renderer)
+      return false;
+
+    auto it = m_RenderWindowSchedulingStates.find(renderer->GetRenderWindow());
+    return it != m_RenderWindowSchedulingStates.end() && it->second.reducedQuality;
   }
 
   void RenderingManager::SetMaximumLOD(unsigned int max) { m_MaxLOD = max; }
@@ -143,10 +143,16 @@ std::ostream &mitk::operator<<(std::ostream &o, mitk::DataNode::Pointer &dtn)
 
 void mitk::DataNode::SetMapper(MapperSlotId id, mitk::Mapper *mapper)
 {
+  if (id < m_Mappers.size() && m_Mappers[id] == mapper)
+    return;
+
   m_Mappers[id] = mapper;
 
   if (mapper != nullptr)
     mapper->SetDataNode(this);
+
+  // renderers keep the mappers of the nodes in their queues, thus the replacement is reported
+  this->InvokeEvent(MapperChangedEvent());
 }
 
 void mitk::DataNode::UpdateOutputInformation()
@@ -204,7 +210,10 @@ mitk::PropertyList *mitk::DataNode::GetPropertyList(const std::string &rendererN
   mitk::PropertyList::Pointer &propertyList = m_MapOfPropertyLists[rendererName];
 
   if (propertyList.IsNull())
+  {
     propertyList = mitk::PropertyList::New();
+    this->InvokeEvent(PropertyListAddedEvent());
+  }
 
   assert(m_MapOfPropertyLists[rendererName].IsNotNull());
 
@@ -242,6 +251,29 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   return property;
 }
 
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  if (nullptr != renderer)
+  {
+    auto it = m_MapOfPropertyLists.find(renderer->GetName());
+
+    if (m_MapOfPropertyLists.end() != it)
+    {
+      auto property = it->second->GetProperty(propertyKey);
+
+      if (nullptr != property)
+        return property;
+    }
+  }
+
+  auto property = m_PropertyList->GetProperty(propertyKey);
+
+  if (nullptr == property && fallBackOnDataProperties && m_Data.IsNotNull())
+    property = m_Data->GetPropertyList()->GetProperty(propertyKey);
+
+  return property;
+}
+
 mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 {
   GroupTagList groups;
@@ -272,6 +304,16 @@ bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, c
   return true;
 }
 
+bool mitk::DataNode::GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer) const
+{
+  auto boolprop = dynamic_cast<mitk::BoolProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == boolprop)
+    return false;
+
+  boolValue = boolprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
 {
   mitk::IntProperty::Pointer intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
@@ -282,6 +324,16 @@ bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, cons
   return true;
 }
 
+bool mitk::DataNode::GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
+{
+  auto intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == intprop)
+    return false;
+
+  intValue = intprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
                                       float &floatValue,
                                       const mitk::BaseRenderer *renderer) const
@@ -294,6 +346,18 @@ bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
   return true;
 }
 
+bool mitk::DataNode::GetFloatProperty(const PropertyKey &propertyKey,
+                                      float &floatValue,
+                                      const mitk::BaseRenderer *renderer) const
+{
+  auto floatprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == floatprop)
+    return false;
+
+  floatValue = floatprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetDoubleProperty(const char *propertyKey,
                                        double &doubleValue,
                                        const mitk::BaseRenderer *renderer) const
@@ -315,6 +379,27 @@ bool mitk::DataNode::GetDoubleProperty(const char *propertyKey,
   return true;
 }
 
+bool mitk::DataNode::GetDoubleProperty(const PropertyKey &propertyKey,
+                                       double &doubleValue,
+                                       const mitk::BaseRenderer *renderer) const
+{
+  auto doubleprop = dynamic_cast<mitk::DoubleProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == doubleprop)
+  {
+    // try float instead
+    float floatValue = 0;
+    if (this->GetFloatProperty(propertyKey, floatValue, renderer))
+    {
+      doubleValue = floatValue;
+      return true;
+    }
+    return false;
+  }
+
+  doubleValue = doubleprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetStringProperty(const char *propertyKey,
                                        std::string &string,
                                        const mitk::BaseRenderer *renderer) const
@@ -342,6 +427,16 @@ bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer,
   return true;
 }
 
+bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  auto colorprop = dynamic_cast<mitk::ColorProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == colorprop)
+    return false;
+
+  memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
+  return true;
+}
+
 bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey) const
 {
   mitk::FloatProperty::Pointer opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
@@ -352,6 +447,16 @@ bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *render
   return true;
 }
 
+bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKey &propertyKey) const
+{
+  auto opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == opacityprop)
+    return false;
+
+  opacity = opacityprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
                                     const mitk::BaseRenderer *renderer,
                                     const char *propertyKey) const
@@ -365,6 +470,18 @@ bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
   return true;
 }
 
+bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
+                                    const mitk::BaseRenderer *renderer,
+                                    const PropertyKey &propertyKey) const
+{
+  auto levWinProp = dynamic_cast<mitk::LevelWindowProperty *>(GetProperty(propertyKey, renderer));
+  if (nullptr == levWinProp)
+    return false;
+
+  levelWindow = levWinProp->GetLevelWindow();
+  return true;
+}
+
 void mitk::DataNode::SetColor(const mitk::Color &color, const mitk::BaseRenderer *renderer, const char *propertyKey)
 {
   mitk::ColorProperty::Pointer prop;
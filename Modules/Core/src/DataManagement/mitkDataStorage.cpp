@@ -22,6 +22,8 @@ found in the LICENSE file.
 #include "mitkProperties.h"
 #include "mitkArbitraryTimeGeometry.h"
 
+#include <typeinfo>
+
 mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false)
 {
 }
@@ -54,16 +56,52 @@ void mitk::DataStorage::Remove(const DataStorage::SetOfObjects *nodes)
 
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::DataStorage::GetSubset(const NodePredicateBase *condition) const
 {
+  if (condition != nullptr)
+  {
+    const NodePredicateBase::IndexType index = condition->GetIndexType();
+    if (index != NodePredicateBase::IndexType::None)
+    {
+      DataStorage::SetOfObjects::ConstPointer candidates = this->GetIndexedNodes(index, condition->GetIndexKey());
+      if (candidates.IsNotNull())
+      {
+        DataStorage::SetOfObjects::ConstPointer result = this->FilterSetOfObjects(candidates, condition);
+        // a data UID can be changed without notification, thus a miss in the UID index is verified by a full scan
+        if (result->Size() > 0 || index != NodePredicateBase::IndexType::DataUID)
+          return result;
+      }
+    }
+  }
+
   DataStorage::SetOfObjects::ConstPointer result = this->FilterSetOfObjects(this->GetAll(), condition);
   return result;
 }
 
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::DataStorage::GetIndexedNodes(NodePredicateBase::IndexType,
+                                                                                  const std::string &) const
+{
+  return nullptr;
+}
+
 mitk::DataNode *mitk::DataStorage::GetNamedNode(const char *name) const
 
 {
   if (name == nullptr)
     return nullptr;
 
+  // answer from the name index without creating a predicate, if the storage maintains one
+  DataStorage::SetOfObjects::ConstPointer candidates = this->GetIndexedNodes(NodePredicateBase::IndexType::Name, name);
+  if (candidates.IsNotNull())
+  {
+    for (DataStorage::SetOfObjects::ConstIterator it = candidates->Begin(); it != candidates->End(); ++it)
+    {
+      const BaseProperty *nameProperty = it.Value()->GetProperty("name");
+      if (nameProperty != nullptr && typeid(*nameProperty) == typeid(StringProperty) &&
+          static_cast<const StringProperty *>(nameProperty)->GetValue() == name)
+        return it.Value();
+    }
+    return nullptr;
+  }
+
   StringProperty::Pointer s(StringProperty::New(name));
   NodePredicateProperty::Pointer p = NodePredicateProperty::New("name", s);
   DataStorage::SetOfObjects::ConstPointer rs = this->GetSubset(p);
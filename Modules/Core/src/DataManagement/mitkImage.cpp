@@ -697,7 +697,9 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
     if (sl->GetData() != data)
       std::memcpy(sl->GetData(), data, m_OffsetTable[2] * (ptypeSize));
     sl->Modified();
-    // we have changed the data: call Modified()!
+    // we have changed the data: report the written memory to the statistics and call Modified()!
+    if (m_ImageStatistics != nullptr)
+      m_ImageStatistics->SetDataModified(sl->GetData(), sl->GetData() + m_OffsetTable[2] * (ptypeSize));
     Modified();
   }
   else
@@ -733,7 +735,9 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
       std::memcpy(vol->GetData(), data, m_OffsetTable[3] * (ptypeSize));
     vol->Modified();
     vol->SetComplete(true);
-    // we have changed the data: call Modified()!
+    // we have changed the data: report the written memory to the statistics and call Modified()!
+    if (m_ImageStatistics != nullptr)
+      m_ImageStatistics->SetDataModified(vol->GetData(), vol->GetData() + m_OffsetTable[3] * (ptypeSize));
     Modified();
   }
   else
@@ -781,7 +785,9 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
       std::memcpy(ch->GetData(), data, m_OffsetTable[4] * (ptypeSize));
     ch->Modified();
     ch->SetComplete(true);
-    // we have changed the data: call Modified()!
+    // we have changed the data: report the written memory to the statistics and call Modified()!
+    if (m_ImageStatistics != nullptr)
+      m_ImageStatistics->SetDataModified(ch->GetData(), ch->GetData() + m_OffsetTable[4] * (ptypeSize));
     Modified();
   }
   else
@@ -821,6 +827,11 @@ void mitk::Image::Initialize()
   {
     m_ImageStatistics = new mitk::ImageStatisticsHolder(this);
   }
+  else
+  {
+    // the memory has been released, the summaries of the previous content are meaningless
+    m_ImageStatistics->ResetBrickExtrema();
+  }
 
   SetRequestedRegionToLargestPossibleRegion();
 }
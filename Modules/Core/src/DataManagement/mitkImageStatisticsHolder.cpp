@@ -12,11 +12,145 @@ found in the LICENSE file.
 #include "mitkImageStatisticsHolder.h"
 
 #include "mitkHistogramGenerator.h"
+#include "mitkImageAccessByItk.h"
 #include <mitkProperties.h>
 
+#include <itkCommand.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkMultiThreader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+namespace
+{
+  ITK_THREAD_RETURN_TYPE ComputeBricksCallback(void *arg)
+  {
+    auto *info = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+    (*static_cast<std::function<void()> *>(info->UserData))();
+    return ITK_THREAD_RETURN_VALUE;
+  }
+
+  void InitializeExtrema(mitk::ImageStatisticsHolder::BrickExtrema &extrema)
+  {
+    extrema.Min = extrema.SecondMin = itk::NumericTraits<mitk::ScalarType>::max();
+    extrema.Max = extrema.SecondMax = itk::NumericTraits<mitk::ScalarType>::NonpositiveMin();
+    extrema.CountOfMin = 0;
+    extrema.CountOfMax = 0;
+  }
+
+  template <typename TValue>
+  inline void AddToExtrema(TValue value, mitk::ImageStatisticsHolder::BrickExtrema &extrema)
+  {
+    // update min
+    if (value < extrema.Min)
+    {
+      extrema.SecondMin = extrema.Min;
+      extrema.Min = value;
+      extrema.CountOfMin = 1;
+    }
+    else if (value == extrema.Min)
+    {
+      ++extrema.CountOfMin;
+    }
+    else if (value < extrema.SecondMin)
+    {
+      extrema.SecondMin = value;
+    }
+
+    // update max
+    if (value > extrema.Max)
+    {
+      extrema.SecondMax = extrema.Max;
+      extrema.Max = value;
+      extrema.CountOfMax = 1;
+    }
+    else if (value == extrema.Max)
+    {
+      ++extrema.CountOfMax;
+    }
+    else if (value > extrema.SecondMax)
+    {
+      extrema.SecondMax = value;
+    }
+  }
+
+  /** Merges the extrema of disjoint voxel sets, the result is the same as if all voxels were added to @a extrema */
+  void MergeExtrema(mitk::ImageStatisticsHolder::BrickExtrema &extrema, const mitk::ImageStatisticsHolder::BrickExtrema &other)
+  {
+    if (other.Min < extrema.Min)
+    {
+      extrema.SecondMin = std::min(extrema.Min, other.SecondMin);
+      extrema.Min = other.Min;
+      extrema.CountOfMin = other.CountOfMin;
+    }
+    else if (other.Min == extrema.Min)
+    {
+      extrema.SecondMin = std::min(extrema.SecondMin, other.SecondMin);
+      extrema.CountOfMin += other.CountOfMin;
+    }
+    else
+    {
+      extrema.SecondMin = std::min(extrema.SecondMin, other.Min);
+    }
+
+    if (other.Max > extrema.Max)
+    {
+      extrema.SecondMax = std::max(extrema.Max, other.SecondMax);
+      extrema.Max = other.Max;
+      extrema.CountOfMax = other.CountOfMax;
+    }
+    else if (other.Max == extrema.Max)
+    {
+      extrema.SecondMax = std::max(extrema.SecondMax, other.SecondMax);
+      extrema.CountOfMax += other.CountOfMax;
+    }
+    else
+    {
+      extrema.SecondMax = std::max(extrema.SecondMax, other.Max);
+    }
+  }
+
+  template <typename ItkImageType>
+  void ComputeExtremaInRegion(const ItkImageType *itkImage,
+                              const itk::ImageRegion<3> &region,
+                              mitk::ImageStatisticsHolder::BrickExtrema &extrema)
+  {
+    typename ItkImageType::RegionType itkRegion;
+    for (unsigned int i = 0; i < ItkImageType::ImageDimension; ++i)
+    {
+      itkRegion.SetIndex(i, region.GetIndex(i));
+      itkRegion.SetSize(i, region.GetSize(i));
+    }
+
+    for (itk::ImageRegionConstIterator<ItkImageType> it(itkImage, itkRegion); !it.IsAtEnd(); ++it)
+    {
+      AddToExtrema(it.Get(), extrema);
+    }
+  }
+
+  template <typename ItkImageType>
+  void _ComputeExtremaInItkImageRegions(const ItkImageType *itkImage,
+                                        const std::vector<itk::ImageRegion<3>> *regions,
+                                        mitk::ImageStatisticsHolder::BrickExtrema *extrema)
+  {
+    for (const auto &region : *regions)
+    {
+      mitk::ImageStatisticsHolder::BrickExtrema regionExtrema;
+      InitializeExtrema(regionExtrema);
+      ComputeExtremaInRegion(itkImage, region, regionExtrema);
+      MergeExtrema(*extrema, regionExtrema);
+    }
+  }
+}
+
 mitk::ImageStatisticsHolder::ImageStatisticsHolder(mitk::Image *image)
-  : m_Image(image)
+  : m_Image(image), m_HasReportedModifications(false), m_HasPendingReport(false), m_HasUnreportedModifications(false)
 {
+  m_BrickGridSize.Fill(0);
+  m_BrickGridImageSize.Fill(0);
+
   m_CountOfMinValuedVoxels.resize(1, 0);
   m_CountOfMaxValuedVoxels.resize(1, 0);
   m_ScalarMin.resize(1, itk::NumericTraits<ScalarType>::max());
@@ -26,13 +160,28 @@ mitk::ImageStatisticsHolder::ImageStatisticsHolder(mitk::Image *image)
 
   mitk::HistogramGenerator::Pointer generator = mitk::HistogramGenerator::New();
   m_HistogramGeneratorObject = generator;
+
+  auto command = itk::SimpleMemberCommand<ImageStatisticsHolder>::New();
+  command->SetCallbackFunction(this, &ImageStatisticsHolder::OnImageModified);
+  m_ImageModifiedObserverTag = m_Image->AddObserver(itk::ModifiedEvent(), command);
 }
 
 mitk::ImageStatisticsHolder::~ImageStatisticsHolder()
 {
+  m_Image->RemoveObserver(m_ImageModifiedObserverTag);
   m_HistogramGeneratorObject = nullptr;
 }
 
+void mitk::ImageStatisticsHolder::OnImageModified()
+{
+  m_DirtyBricksLock.Lock();
+  if (m_HasPendingReport)
+    m_HasPendingReport = false;
+  else
+    m_HasUnreportedModifications = true;
+  m_DirtyBricksLock.Unlock();
+}
+
 const mitk::ImageStatisticsHolder::HistogramType *mitk::ImageStatisticsHolder::GetScalarHistogram(
   int t, unsigned int /*component*/)
 {
@@ -84,6 +233,217 @@ void mitk::ImageStatisticsHolder::Expand(unsigned int timeSteps)
   }
 }
 
+void mitk::ImageStatisticsHolder::UpdateBrickGrid()
+{
+  itk::Size<3> imageSize;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    imageSize[i] = i < m_Image->GetDimension() ? m_Image->GetDimension(i) : 1;
+  }
+
+  const unsigned int timeSteps = m_Image->GetTimeSteps();
+
+  m_DirtyBricksLock.Lock();
+  if (imageSize != m_BrickGridImageSize)
+  {
+    m_BrickGridImageSize = imageSize;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      m_BrickGridSize[i] = (imageSize[i] + BrickSize - 1) / BrickSize;
+    }
+    m_BrickExtrema.clear();
+    m_DirtyBricks.clear();
+  }
+  if (m_BrickExtrema.size() < timeSteps)
+  {
+    m_BrickExtrema.resize(timeSteps);
+    m_DirtyBricks.resize(timeSteps);
+  }
+  m_DirtyBricksLock.Unlock();
+}
+
+itk::ImageRegion<3> mitk::ImageStatisticsHolder::GetBrickRegion(std::size_t brickIndex) const
+{
+  itk::Index<3> brick;
+  brick[0] = brickIndex % m_BrickGridSize[0];
+  brick[1] = (brickIndex / m_BrickGridSize[0]) % m_BrickGridSize[1];
+  brick[2] = brickIndex / (m_BrickGridSize[0] * m_BrickGridSize[1]);
+
+  itk::ImageRegion<3> region;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    region.SetIndex(i, brick[i] * BrickSize);
+    region.SetSize(i, std::min<itk::SizeValueType>(BrickSize, m_BrickGridImageSize[i] - brick[i] * BrickSize));
+  }
+  return region;
+}
+
+void mitk::ImageStatisticsHolder::MergeBrickExtrema(int t)
+{
+  BrickExtrema extrema;
+  InitializeExtrema(extrema);
+  for (const auto &brick : m_BrickExtrema[t])
+  {
+    MergeExtrema(extrema, brick);
+  }
+
+  //// guard for wrong 2dMin/Max on single constant value images
+  if (extrema.Max == extrema.Min)
+  {
+    extrema.SecondMax = extrema.SecondMin = extrema.Max;
+  }
+
+  m_ScalarMin[t] = extrema.Min;
+  m_ScalarMax[t] = extrema.Max;
+  m_Scalar2ndMin[t] = extrema.SecondMin;
+  m_Scalar2ndMax[t] = extrema.SecondMax;
+  m_CountOfMinValuedVoxels[t] = extrema.CountOfMin;
+  m_CountOfMaxValuedVoxels[t] = extrema.CountOfMax;
+}
+
+void mitk::ImageStatisticsHolder::SetDataModified(const void *begin, const void *end)
+{
+  if (m_Image == nullptr || !m_Image->IsInitialized())
+    return;
+
+  const auto *first = static_cast<const unsigned char *>(begin);
+  const auto *last = static_cast<const unsigned char *>(end);
+  const std::size_t bytesPerPixel = m_Image->GetPixelType(0).GetSize();
+
+  m_DirtyBricksLock.Lock();
+  const std::size_t sliceSize = m_BrickGridImageSize[0] * m_BrickGridImageSize[1] * bytesPerPixel;
+  const std::size_t volumeSize = sliceSize * m_BrickGridImageSize[2];
+
+  bool located = false;
+  for (unsigned int t = 0; t < m_DirtyBricks.size() && volumeSize > 0; ++t)
+  {
+    if (m_DirtyBricks[t].empty())
+      continue;
+
+    // find the memory of the volume of time step t
+    const unsigned char *volumeBegin = nullptr;
+    m_Image->m_ImageDataArraysLock.Lock();
+    const int volumeIndex = m_Image->GetVolumeIndex(t, 0);
+    if (static_cast<std::size_t>(volumeIndex) < m_Image->m_Volumes.size() && m_Image->m_Volumes[volumeIndex].IsNotNull())
+    {
+      volumeBegin = m_Image->m_Volumes[volumeIndex]->GetData();
+    }
+    else if (!m_Image->m_Channels.empty() && m_Image->m_Channels[0].IsNotNull())
+    {
+      volumeBegin = m_Image->m_Channels[0]->GetData() + t * volumeSize;
+    }
+    m_Image->m_ImageDataArraysLock.Unlock();
+
+    if (volumeBegin == nullptr || last <= volumeBegin || first >= volumeBegin + volumeSize)
+      continue;
+
+    located = true;
+    const std::size_t firstByte = first > volumeBegin ? first - volumeBegin : 0;
+    const std::size_t lastByte = std::min<std::size_t>(last - volumeBegin, volumeSize) - 1;
+    const std::size_t firstBrickZ = (firstByte / sliceSize) / BrickSize;
+    const std::size_t lastBrickZ = (lastByte / sliceSize) / BrickSize;
+    const std::size_t bricksPerLayer = m_BrickGridSize[0] * m_BrickGridSize[1];
+    std::fill(m_DirtyBricks[t].begin() + firstBrickZ * bricksPerLayer,
+              m_DirtyBricks[t].begin() + (lastBrickZ + 1) * bricksPerLayer,
+              true);
+  }
+
+  if (!located)
+  {
+    // memory not known as a volume of this image (e.g. separately allocated slices), mark everything
+    for (auto &dirtyBricks : m_DirtyBricks)
+    {
+      std::fill(dirtyBricks.begin(), dirtyBricks.end(), true);
+    }
+  }
+  m_HasReportedModifications = true;
+  m_HasPendingReport = true;
+  m_DirtyBricksLock.Unlock();
+}
+
+void mitk::ImageStatisticsHolder::ResetBrickExtrema()
+{
+  m_DirtyBricksLock.Lock();
+  for (auto &bricks : m_BrickExtrema)
+  {
+    bricks.clear();
+  }
+  m_HasReportedModifications = false;
+  m_HasPendingReport = false;
+  m_HasUnreportedModifications = false;
+  m_DirtyBricksLock.Unlock();
+}
+
+void mitk::ImageStatisticsHolder::GetScalarValueExtremaInRegion(const itk::ImageRegion<3> &region,
+                                                                ScalarType &min,
+                                                                ScalarType &max,
+                                                                int t)
+{
+  ComputeImageStatistics(t);
+
+  min = itk::NumericTraits<ScalarType>::max();
+  max = itk::NumericTraits<ScalarType>::NonpositiveMin();
+
+  if (!m_Image->IsValidTimeStep(t))
+    return;
+
+  if (static_cast<std::size_t>(t) >= m_BrickExtrema.size() || m_BrickExtrema[t].empty())
+  {
+    // no bricks for non-scalar images, only the extrema of the whole time step are known
+    min = m_ScalarMin[t];
+    max = m_ScalarMax[t];
+    return;
+  }
+
+  itk::ImageRegion<3> croppedRegion = region;
+  if (!croppedRegion.Crop(itk::ImageRegion<3>(m_BrickGridImageSize)))
+    return;
+
+  BrickExtrema extrema;
+  InitializeExtrema(extrema);
+  std::vector<itk::ImageRegion<3>> partialRegions;
+
+  itk::Index<3> firstBrick, lastBrick;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    firstBrick[i] = croppedRegion.GetIndex(i) / BrickSize;
+    lastBrick[i] = (croppedRegion.GetIndex(i) + croppedRegion.GetSize(i) - 1) / BrickSize;
+  }
+
+  for (auto z = firstBrick[2]; z <= lastBrick[2]; ++z)
+  {
+    for (auto y = firstBrick[1]; y <= lastBrick[1]; ++y)
+    {
+      for (auto x = firstBrick[0]; x <= lastBrick[0]; ++x)
+      {
+        const std::size_t brickIndex = x + m_BrickGridSize[0] * (y + m_BrickGridSize[1] * z);
+        itk::ImageRegion<3> brickRegion = this->GetBrickRegion(brickIndex);
+        if (croppedRegion.IsInside(brickRegion))
+        {
+          MergeExtrema(extrema, m_BrickExtrema[t][brickIndex]);
+        }
+        else
+        {
+          brickRegion.Crop(croppedRegion);
+          partialRegions.push_back(brickRegion);
+        }
+      }
+    }
+  }
+
+  if (!partialRegions.empty())
+  {
+    mitk::ImageTimeSelector::Pointer timeSelector = this->GetTimeSelector();
+    timeSelector->SetTimeNr(t);
+    timeSelector->UpdateLargestPossibleRegion();
+    const mitk::Image *image = timeSelector->GetOutput();
+    AccessByItk_2(image, _ComputeExtremaInItkImageRegions, &partialRegions, &extrema);
+  }
+
+  min = extrema.Min;
+  max = extrema.Max;
+}
+
 void mitk::ImageStatisticsHolder::ResetImageStatistics()
 {
   m_ScalarMin.assign(1, itk::NumericTraits<ScalarType>::max());
@@ -94,8 +454,6 @@ void mitk::ImageStatisticsHolder::ResetImageStatistics()
   m_CountOfMaxValuedVoxels.assign(1, 0);
 }
 
-#include "mitkImageAccessByItk.h"
-
 //#define BOUNDINGOBJECT_IGNORE
 
 template <typename ItkImageType>
@@ -108,70 +466,67 @@ void mitk::_ComputeExtremaInItkImage(const ItkImageType *itkImage, mitk::ImageSt
   if (region != itkImage->GetRequestedRegion())
     return;
 
-  itk::ImageRegionConstIterator<ItkImageType> it(itkImage, region);
-  typedef typename ItkImageType::PixelType TPixel;
-  TPixel value = 0;
-
   if (statisticsHolder == nullptr || !statisticsHolder->IsValidTimeStep(t))
     return;
   statisticsHolder->Expand(t + 1); // make sure we have initialized all arrays
-  statisticsHolder->m_CountOfMinValuedVoxels[t] = 0;
-  statisticsHolder->m_CountOfMaxValuedVoxels[t] = 0;
+  statisticsHolder->UpdateBrickGrid();
 
-  statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t] = itk::NumericTraits<ScalarType>::max();
-  statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t] =
-    itk::NumericTraits<ScalarType>::NonpositiveMin();
+  const std::size_t numberOfBricks =
+    statisticsHolder->m_BrickGridSize[0] * statisticsHolder->m_BrickGridSize[1] * statisticsHolder->m_BrickGridSize[2];
 
-  while (!it.IsAtEnd())
+  // collect the bricks to (re)compute: all of them on first use, afterwards only those written to
+  std::vector<std::size_t> bricksToCompute;
+  statisticsHolder->m_DirtyBricksLock.Lock();
+  auto &bricks = statisticsHolder->m_BrickExtrema[t];
+  auto &dirtyBricks = statisticsHolder->m_DirtyBricks[t];
+  if (bricks.size() != numberOfBricks)
   {
-    value = it.Get();
-#ifdef BOUNDINGOBJECT_IGNORE
-    if (value > -32765)
+    bricks.resize(numberOfBricks);
+    dirtyBricks.assign(numberOfBricks, true);
+  }
+  for (std::size_t i = 0; i < numberOfBricks; ++i)
+  {
+    if (dirtyBricks[i])
     {
-#endif
-      // update min
-      if (value < statisticsHolder->m_ScalarMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMin[t];
-        statisticsHolder->m_ScalarMin[t] = value;
-        statisticsHolder->m_CountOfMinValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMin[t])
-      {
-        ++statisticsHolder->m_CountOfMinValuedVoxels[t];
-      }
-      else if (value < statisticsHolder->m_Scalar2ndMin[t])
-      {
-        statisticsHolder->m_Scalar2ndMin[t] = value;
-      }
-
-      // update max
-      if (value > statisticsHolder->m_ScalarMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_ScalarMax[t];
-        statisticsHolder->m_ScalarMax[t] = value;
-        statisticsHolder->m_CountOfMaxValuedVoxels[t] = 1;
-      }
-      else if (value == statisticsHolder->m_ScalarMax[t])
-      {
-        ++statisticsHolder->m_CountOfMaxValuedVoxels[t];
-      }
-      else if (value > statisticsHolder->m_Scalar2ndMax[t])
-      {
-        statisticsHolder->m_Scalar2ndMax[t] = value;
-      }
-#ifdef BOUNDINGOBJECT_IGNORE
+      bricksToCompute.push_back(i);
+      dirtyBricks[i] = false;
     }
-#endif
+  }
+  statisticsHolder->m_DirtyBricksLock.Unlock();
 
-    ++it;
+  std::vector<itk::ImageRegion<3>> brickRegions;
+  brickRegions.reserve(bricksToCompute.size());
+  for (auto brickIndex : bricksToCompute)
+  {
+    brickRegions.push_back(statisticsHolder->GetBrickRegion(brickIndex));
   }
 
-  //// guard for wrong 2dMin/Max on single constant value images
-  if (statisticsHolder->m_ScalarMax[t] == statisticsHolder->m_ScalarMin[t])
+  // the bricks are handed out one by one, so threads finishing early take over the remaining bricks
+  std::atomic<std::size_t> nextBrick(0);
+  std::function<void()> computeBricks = [&]() {
+    for (std::size_t i = nextBrick++; i < bricksToCompute.size(); i = nextBrick++)
+    {
+      auto &brick = bricks[bricksToCompute[i]];
+      InitializeExtrema(brick);
+      ComputeExtremaInRegion(itkImage, brickRegions[i], brick);
+    }
+  };
+
+  const std::size_t numberOfThreads =
+    std::min<std::size_t>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(), bricksToCompute.size());
+  if (numberOfThreads <= 1)
   {
-    statisticsHolder->m_Scalar2ndMax[t] = statisticsHolder->m_Scalar2ndMin[t] = statisticsHolder->m_ScalarMax[t];
+    computeBricks();
   }
+  else
+  {
+    auto multiThreader = itk::MultiThreader::New();
+    multiThreader->SetNumberOfThreads(static_cast<itk::ThreadIdType>(numberOfThreads));
+    multiThreader->SetSingleMethod(ComputeBricksCallback, &computeBricks);
+    multiThreader->SingleMethodExecute();
+  }
+
+  statisticsHolder->MergeBrickExtrema(t);
   statisticsHolder->m_LastRecomputeTimeStamp.Modified();
 }
 
@@ -259,10 +614,30 @@ void mitk::ImageStatisticsHolder::ComputeImageStatistics(int t, unsigned int com
   if (!m_Image->IsValidTimeStep(t))
     return;
 
-  // image modified?
-  if (this->m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
+  // image modified? Reported writes need a recomputation even if the writer has not called Modified() (yet)
+  m_DirtyBricksLock.Lock();
+  const bool hasReportedModifications = m_HasReportedModifications;
+  m_DirtyBricksLock.Unlock();
+  if (hasReportedModifications || this->m_Image->GetMTime() > m_LastRecomputeTimeStamp.GetMTime())
+  {
     this->ResetImageStatistics();
 
+    // the dirty bricks only describe the image if all modifications since the last recomputation have been reported
+    // by write accesses; otherwise no brick can be trusted anymore
+    m_DirtyBricksLock.Lock();
+    if (!m_HasReportedModifications || m_HasUnreportedModifications)
+    {
+      for (auto &bricks : m_BrickExtrema)
+      {
+        bricks.clear();
+      }
+    }
+    m_HasReportedModifications = false;
+    m_HasPendingReport = false;
+    m_HasUnreportedModifications = false;
+    m_DirtyBricksLock.Unlock();
+  }
+
   Expand(t + 1);
 
   // do we have valid information already?
@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageWriteAccessor.h"
+#include "mitkImageStatisticsHolder.h"
 
 mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
@@ -21,6 +22,10 @@ mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::Ima
 
 mitk::ImageWriteAccessor::~ImageWriteAccessor()
 {
+  // report the written memory, so that only the affected parts of the statistics are recomputed
+  if (m_Image->GetStatistics() != nullptr)
+    m_Image->GetStatistics()->SetDataModified(m_AddressBegin, m_AddressEnd);
+
   // In case of non-coherent memory, copied area needs to be written back
   // TODO
 
@@ -51,3 +51,21 @@ bool mitk::NodePredicateAnd::CheckNode(const mitk::DataNode *node) const
       return false; // if one element of the conjunction is false, the whole conjunction gets false
   return true;      // none of the childs was false, so return true
 }
+
+mitk::NodePredicateBase::IndexType mitk::NodePredicateAnd::GetIndexType() const
+{
+  // every node that fulfills the conjunction fulfills each child predicate, thus the index
+  // of any child can be used. The first child that declares an index is taken.
+  for (auto it = m_ChildPredicates.cbegin(); it != m_ChildPredicates.cend(); ++it)
+    if ((*it)->GetIndexType() != IndexType::None)
+      return (*it)->GetIndexType();
+  return IndexType::None;
+}
+
+std::string mitk::NodePredicateAnd::GetIndexKey() const
+{
+  for (auto it = m_ChildPredicates.cbegin(); it != m_ChildPredicates.cend(); ++it)
+    if ((*it)->GetIndexType() != IndexType::None)
+      return (*it)->GetIndexKey();
+  return std::string();
+}
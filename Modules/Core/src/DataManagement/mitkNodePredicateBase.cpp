@@ -15,3 +15,13 @@ found in the LICENSE file.
 mitk::NodePredicateBase::~NodePredicateBase()
 {
 }
+
+mitk::NodePredicateBase::IndexType mitk::NodePredicateBase::GetIndexType() const
+{
+  return IndexType::None;
+}
+
+std::string mitk::NodePredicateBase::GetIndexKey() const
+{
+  return std::string();
+}
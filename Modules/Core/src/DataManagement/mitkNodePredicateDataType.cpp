@@ -39,3 +39,13 @@ bool mitk::NodePredicateDataType::CheckNode(const mitk::DataNode *node) const
 
   return (m_ValidDataType.compare(data->GetNameOfClass()) == 0); // return true if data type matches
 }
+
+mitk::NodePredicateBase::IndexType mitk::NodePredicateDataType::GetIndexType() const
+{
+  return IndexType::DataType;
+}
+
+std::string mitk::NodePredicateDataType::GetIndexKey() const
+{
+  return m_ValidDataType;
+}
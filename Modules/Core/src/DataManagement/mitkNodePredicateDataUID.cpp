@@ -37,3 +37,13 @@ bool mitk::NodePredicateDataUID::CheckNode(const mitk::DataNode *node) const
 
   return false;
 }
+
+mitk::NodePredicateBase::IndexType mitk::NodePredicateDataUID::GetIndexType() const
+{
+  return IndexType::DataUID;
+}
+
+std::string mitk::NodePredicateDataUID::GetIndexKey() const
+{
+  return m_UID;
+}
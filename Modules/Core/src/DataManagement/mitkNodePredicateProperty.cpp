@@ -12,6 +12,9 @@ found in the LICENSE file.
 
 #include "mitkNodePredicateProperty.h"
 #include "mitkDataNode.h"
+#include "mitkStringProperty.h"
+
+#include <typeinfo>
 
 mitk::NodePredicateProperty::NodePredicateProperty(const char *propertyName,
                                                    mitk::BaseProperty *p,
@@ -46,3 +49,20 @@ bool mitk::NodePredicateProperty::CheckNode(const mitk::DataNode *node) const
     return (*p == *m_ValidProperty); // search for name and property
   }
 }
+
+mitk::NodePredicateBase::IndexType mitk::NodePredicateProperty::GetIndexType() const
+{
+  if (m_Renderer == nullptr && m_ValidProperty.IsNotNull() && m_ValidPropertyName == "name" &&
+      typeid(*m_ValidProperty) == typeid(StringProperty))
+    return IndexType::Name;
+
+  return IndexType::None;
+}
+
+std::string mitk::NodePredicateProperty::GetIndexKey() const
+{
+  if (this->GetIndexType() == IndexType::Name)
+    return static_cast<const StringProperty *>(m_ValidProperty.GetPointer())->GetValue();
+
+  return std::string();
+}
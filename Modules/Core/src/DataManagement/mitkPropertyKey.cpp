@@ -0,0 +1,47 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyKey.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  struct PropertyKeyRegistry
+  {
+    std::mutex mutex;
+    // elements of an unordered_map are not moved on rehashing, thus pointers to the keys stay valid
+    std::unordered_map<std::string, std::size_t> indices;
+  };
+
+  PropertyKeyRegistry &GetRegistry()
+  {
+    // keys may be created during static initialization of other translation units
+    static PropertyKeyRegistry registry;
+    return registry;
+  }
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &name)
+{
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto entry = registry.indices.emplace(name, registry.indices.size()).first;
+  m_Name = &entry->first;
+  m_Index = entry->second;
+}
+
+mitk::PropertyKey::PropertyKey(const char *name) : PropertyKey(std::string(nullptr != name ? name : ""))
+{
+}
@@ -56,6 +56,30 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  const auto index = propertyKey.GetIndex();
+
+  std::lock_guard<std::mutex> lock(m_PropertyKeyCacheMutex);
+
+  if (index < m_PropertyKeyCache.size() && m_PropertyKeyCache[index].first)
+    return m_PropertyKeyCache[index].second;
+
+  if (index >= m_PropertyKeyCache.size())
+    m_PropertyKeyCache.resize(index + 1, std::make_pair(false, nullptr));
+
+  auto property = this->GetProperty(propertyKey.GetName());
+  m_PropertyKeyCache[index] = std::make_pair(true, property);
+
+  return property;
+}
+
+void mitk::PropertyList::InvalidatePropertyKeyCache()
+{
+  std::lock_guard<std::mutex> lock(m_PropertyKeyCacheMutex);
+  m_PropertyKeyCache.clear();
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -104,6 +128,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
 
   // no? add it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InvalidatePropertyKeyCache();
   this->Modified();
 }
 
@@ -123,6 +148,7 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
 
   // no? add/replace it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->InvalidatePropertyKeyCache();
   Modified();
 }
 
@@ -135,6 +161,7 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->InvalidatePropertyKeyCache();
     Modified();
   }
 }
@@ -186,6 +213,7 @@ bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->InvalidatePropertyKeyCache();
     Modified();
     return true;
   }
@@ -201,6 +229,7 @@ void mitk::PropertyList::Clear()
     ++it;
   }
   m_Properties.clear();
+  this->InvalidatePropertyKeyCache();
 }
 
 itk::LightObject::Pointer mitk::PropertyList::InternalClone() const
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkStandaloneDataStorage.h"
 
+#include "itkCommand.h"
 #include "itkMutexLockHolder.h"
 #include "itkSimpleFastMutexLock.h"
 #include "mitkDataNode.h"
@@ -20,6 +21,8 @@ found in the LICENSE file.
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
 
+#include <typeinfo>
+
 mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
 {
 }
@@ -29,6 +32,7 @@ mitk::StandaloneDataStorage::~StandaloneDataStorage()
   for (auto it = m_SourceNodes.begin(); it != m_SourceNodes.end(); ++it)
   {
     this->RemoveListeners(it->first);
+    this->RemoveFromIndices(it->first);
   }
 }
 
@@ -81,6 +85,8 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
 
     // register for ITK changed events
     this->AddListeners(node);
+
+    this->AddToIndices(node);
   }
 
   /* Notify observers */
@@ -109,9 +115,10 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
   EmitRemoveNodeEvent(node);
   {
     itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
-    /* remove node from both relation adjacency lists */
+    /* remove node from both relation adjacency lists and the secondary indices */
     this->RemoveFromRelation(node, m_SourceNodes);
     this->RemoveFromRelation(node, m_DerivedNodes);
+    this->RemoveFromIndices(node);
   }
 }
 
@@ -183,10 +190,13 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRe
   /* Or traverse adjacency list to collect all related nodes */
   std::vector<mitk::DataNode::ConstPointer> resultset;
   std::vector<mitk::DataNode::ConstPointer> openlist;
+  /* nodes that are already in resultset or openlist */
+  std::set<const mitk::DataNode *> visited;
 
   /* Initialize openlist with node. this will add node to resultset,
      but that is necessary to detect circular relations that would lead to endless recursion */
   openlist.push_back(node);
+  visited.insert(node);
 
   while (openlist.size() > 0)
   {
@@ -205,10 +215,7 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRe
            ++parentIt) // for each parent of current node
       {
         mitk::DataNode::ConstPointer p = parentIt.Value().GetPointer();
-        if (!(std::find(resultset.cbegin(), resultset.cend(), p) !=
-              resultset.end()) // if it is not already in resultset
-            &&
-            !(std::find(openlist.cbegin(), openlist.cend(), p) != openlist.cend())) // and not already in openlist
+        if (visited.insert(p.GetPointer()).second) // if it is not already in resultset or openlist
           openlist.push_back(p); // then add it to openlist, so that it can be processed
       }
   }
@@ -256,3 +263,155 @@ void mitk::StandaloneDataStorage::PrintSelf(std::ostream &os, itk::Indent indent
   os << indent << "StandaloneDataStorage:\n";
   Superclass::PrintSelf(os, indent);
 }
+
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetIndexedNodes(
+  NodePredicateBase::IndexType index, const std::string &key) const
+{
+  if (index == NodePredicateBase::IndexType::None)
+    return nullptr;
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+
+  mitk::DataStorage::SetOfObjects::Pointer resultset = mitk::DataStorage::SetOfObjects::New();
+
+  auto indexIter = m_Indices.find(index);
+  if (indexIter != m_Indices.cend())
+  {
+    auto keyIter = indexIter->second.find(key);
+    if (keyIter != indexIter->second.cend())
+    {
+      unsigned int position = 0;
+      for (const auto &indexedNode : keyIter->second)
+        resultset->InsertElement(position++, const_cast<mitk::DataNode *>(indexedNode.GetPointer()));
+    }
+  }
+
+  return SetOfObjects::ConstPointer(resultset);
+}
+
+void mitk::StandaloneDataStorage::AddToIndices(const mitk::DataNode *node)
+{
+  if (node == nullptr || m_IndexedNodes.find(node) != m_IndexedNodes.end())
+    return;
+
+  itk::MemberCommand<StandaloneDataStorage>::Pointer nodeModifiedCommand =
+    itk::MemberCommand<StandaloneDataStorage>::New();
+  nodeModifiedCommand->SetCallbackFunction(this, &StandaloneDataStorage::OnIndexedNodeModified);
+
+  IndexedNodeInfo &info = m_IndexedNodes[node];
+  info.nodeModifiedTag = node->AddObserver(itk::ModifiedEvent(), nodeModifiedCommand);
+
+  this->UpdateIndices(node);
+}
+
+void mitk::StandaloneDataStorage::RemoveFromIndices(const mitk::DataNode *node)
+{
+  auto infoIter = m_IndexedNodes.find(node);
+  if (infoIter == m_IndexedNodes.end())
+    return;
+
+  IndexedNodeInfo &info = infoIter->second;
+
+  // removing an observer does not really touch the internal state of the observed objects
+  const_cast<mitk::DataNode *>(node)->RemoveObserver(info.nodeModifiedTag);
+  if (info.nameProperty.IsNotNull())
+    const_cast<mitk::BaseProperty *>(info.nameProperty.GetPointer())->RemoveObserver(info.namePropertyModifiedTag);
+
+  for (const auto &key : info.keys)
+  {
+    NodeIndex &index = m_Indices[key.first];
+    auto keyIter = index.find(key.second);
+    if (keyIter != index.end())
+    {
+      keyIter->second.erase(node);
+      if (keyIter->second.empty())
+        index.erase(keyIter);
+    }
+  }
+
+  m_IndexedNodes.erase(infoIter);
+}
+
+void mitk::StandaloneDataStorage::UpdateIndices(const mitk::DataNode *node)
+{
+  auto infoIter = m_IndexedNodes.find(node);
+  if (infoIter == m_IndexedNodes.end())
+    return;
+
+  IndexedNodeInfo &info = infoIter->second;
+
+  /* observe the current name property, the old one may have been replaced */
+  const mitk::BaseProperty *nameProperty = node->GetProperty("name");
+  if (nameProperty != info.nameProperty.GetPointer())
+  {
+    if (info.nameProperty.IsNotNull())
+      const_cast<mitk::BaseProperty *>(info.nameProperty.GetPointer())->RemoveObserver(info.namePropertyModifiedTag);
+
+    info.nameProperty = nameProperty;
+    info.namePropertyModifiedTag = 0;
+
+    if (nameProperty != nullptr)
+    {
+      itk::MemberCommand<StandaloneDataStorage>::Pointer namePropertyModifiedCommand =
+        itk::MemberCommand<StandaloneDataStorage>::New();
+      namePropertyModifiedCommand->SetCallbackFunction(this, &StandaloneDataStorage::OnNamePropertyModified);
+      info.namePropertyModifiedTag = nameProperty->AddObserver(itk::ModifiedEvent(), namePropertyModifiedCommand);
+    }
+  }
+
+  /* compute the keys the same way the predicates check the nodes */
+  std::map<NodePredicateBase::IndexType, std::string> keys;
+  if (nameProperty != nullptr && typeid(*nameProperty) == typeid(mitk::StringProperty))
+    keys[NodePredicateBase::IndexType::Name] = static_cast<const mitk::StringProperty *>(nameProperty)->GetValue();
+
+  const mitk::BaseData *data = node->GetData();
+  if (data != nullptr)
+  {
+    keys[NodePredicateBase::IndexType::DataType] = data->GetNameOfClass();
+    keys[NodePredicateBase::IndexType::DataUID] = data->GetUID();
+  }
+
+  if (keys == info.keys)
+    return;
+
+  for (const auto &key : info.keys)
+  {
+    NodeIndex &index = m_Indices[key.first];
+    auto keyIter = index.find(key.second);
+    if (keyIter != index.end())
+    {
+      keyIter->second.erase(node);
+      if (keyIter->second.empty())
+        index.erase(keyIter);
+    }
+  }
+
+  for (const auto &key : keys)
+    m_Indices[key.first][key.second].insert(node);
+
+  info.keys = keys;
+}
+
+void mitk::StandaloneDataStorage::OnIndexedNodeModified(const itk::Object *caller, const itk::EventObject &)
+{
+  const auto *node = dynamic_cast<const mitk::DataNode *>(caller);
+  if (node == nullptr)
+    return;
+
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+  this->UpdateIndices(node);
+}
+
+void mitk::StandaloneDataStorage::OnNamePropertyModified(const itk::Object *caller, const itk::EventObject &)
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> locked(m_Mutex);
+
+  /* renames are rare, so the nodes using the property are searched instead of maintaining a reverse map */
+  std::vector<const mitk::DataNode *> nodes;
+  for (const auto &info : m_IndexedNodes)
+    if (info.second.nameProperty.GetPointer() == caller)
+      nodes.push_back(info.first);
+
+  for (const auto *node : nodes)
+    this->UpdateIndices(node);
+}
@@ -12,10 +12,12 @@ found in the LICENSE file.
 
 #include "mitkMimeTypeProvider.h"
 
+#include "mitkIFileIO.h"
 #include "mitkLogMacros.h"
 
 #include <usGetModuleContext.h>
 #include <usModuleContext.h>
+#include <usModuleRegistry.h>
 
 #include <itksys/SystemTools.hxx>
 
@@ -24,6 +26,30 @@ found in the LICENSE file.
 #pragma warning(disable : 4355)
 #endif
 
+namespace
+{
+  // Auto-loaded modules may defer their loading until one of their mime types
+  // is requested (see AUTOLOAD_MIME_TYPES in mitk_create_module). Their mime
+  // types are tracked as soon as they are loaded.
+  void LoadDeferredMimeTypeModules(const std::string &name = std::string())
+  {
+    us::ModuleRegistry::LoadDeferredModules(mitk::IFileIO::PROP_MIMETYPE(), name);
+  }
+
+  void LoadDeferredMimeTypeModulesForFile(const std::string &filePath)
+  {
+    if (us::ModuleRegistry::GetDeferredModules().empty())
+      return;
+
+    // try all extensions, e.g. "gz" and "nii.gz" for "image.nii.gz"
+    const std::string fileName = itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameName(filePath));
+    for (auto pos = fileName.find('.'); pos != std::string::npos; pos = fileName.find('.', pos + 1))
+    {
+      us::ModuleRegistry::LoadDeferredModules("org.mitk.mimetype.extension", fileName.substr(pos + 1));
+    }
+  }
+}
+
 namespace mitk
 {
   MimeTypeProvider::MimeTypeProvider() : m_Tracker(nullptr) {}
@@ -40,6 +66,8 @@ namespace mitk
   void MimeTypeProvider::Stop() { m_Tracker->Close(); }
   std::vector<MimeType> MimeTypeProvider::GetMimeTypes() const
   {
+    LoadDeferredMimeTypeModules();
+
     std::vector<MimeType> result;
     for (const auto &elem : m_NameToMimeType)
     {
@@ -50,6 +78,8 @@ namespace mitk
 
   std::vector<MimeType> MimeTypeProvider::GetMimeTypesForFile(const std::string &filePath) const
   {
+    LoadDeferredMimeTypeModulesForFile(filePath);
+
     std::vector<MimeType> result;
     for (const auto &elem : m_NameToMimeType)
     {
@@ -65,6 +95,8 @@ namespace mitk
 
   std::vector<MimeType> MimeTypeProvider::GetMimeTypesForCategory(const std::string &category) const
   {
+    LoadDeferredMimeTypeModules();
+
     std::vector<MimeType> result;
     for (const auto &elem : m_NameToMimeType)
     {
@@ -78,6 +110,11 @@ namespace mitk
 
   MimeType MimeTypeProvider::GetMimeTypeForName(const std::string &name) const
   {
+    if (m_NameToMimeType.find(name) == m_NameToMimeType.end())
+    {
+      LoadDeferredMimeTypeModules(name);
+    }
+
     auto iter = m_NameToMimeType.find(name);
     if (iter != m_NameToMimeType.end())
       return iter->second;
@@ -86,6 +123,8 @@ namespace mitk
 
   std::vector<std::string> MimeTypeProvider::GetCategories() const
   {
+    LoadDeferredMimeTypeModules();
+
     std::vector<std::string> result;
     for (const auto &elem : m_NameToMimeType)
     {
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkRenderingManager.h>
 #include <mitkResliceMethodProperty.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 
@@ -55,6 +56,19 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+namespace
+{
+  // interned keys of the properties that are queried for every update
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey ColorKey("color");
+  const mitk::PropertyKey OpacityKey("opacity");
+  const mitk::PropertyKey LayerKey("layer");
+  const mitk::PropertyKey LevelWindowKey("levelwindow");
+  const mitk::PropertyKey OpacLevelWindowKey("opaclevelwindow");
+  const mitk::PropertyKey BinaryKey("binary");
+  const mitk::PropertyKey OutlineBinaryKey("outline binary");
+}
+
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
 {
 }
@@ -90,7 +104,7 @@ float mitk::ImageVtkMapper2D::CalculateLayerDepth(mitk::BaseRenderer *renderer)
   // Due to a VTK bug, we cannot use the whole clipping range. /100 is empirically determined
   float depth = -maxRange * 0.01; // divide by 100
   int layer = 0;
-  GetDataNode()->GetIntProperty("layer", layer, renderer);
+  GetDataNode()->GetIntProperty(LayerKey, layer, renderer);
   // add the layer property for each image to render images with a higher layer on top of the others
   depth += layer * 10; //*10: keep some room for each image (e.g. for ODFs in between)
   if (depth > 0.0f)
@@ -159,8 +173,11 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   localStorage->m_Reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
 
   // Initialize the interpolation mode for resampling; switch to nearest
-  // neighbor if the input image is too small.
-  if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
+  // neighbor if the input image is too small or if the renderer exceeded its
+  // frame time budget during interaction.
+  localStorage->m_ReducedQuality = RenderingManager::GetInstance()->IsReducedQualityRendering(renderer);
+
+  if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1) && !localStorage->m_ReducedQuality)
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
     datanode->GetProperty(resliceInterpolationProperty, "reslice interpolation", renderer);
@@ -248,23 +265,61 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     dataZSpacing = 1.0 / normInIndex.GetNorm();
 
-    localStorage->m_Reslicer->SetOutputDimensionality(3);
-    localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+    // MIP, MinIP and the average ("sum") are projected by the reslicer itself while resampling the
+    // slab. Thus the slab is never stored as 3D image and the projection runs multithreaded per row.
+    // vtkImageReslice rounds the average of integer pixels, while the thick slice filter truncates it.
+    // Thus the average is only projected by the reslicer for floating point images.
+    const int componentType = image->GetPixelType().GetComponentType();
+    const bool isFloatingPoint = itk::ImageIOBase::FLOAT == componentType || itk::ImageIOBase::DOUBLE == componentType;
 
-    // Do the reslicing. Modified() is called to make sure that the reslicer is
-    // executed even though the input geometry information did not change; this
-    // is necessary when the input /em data, but not the /em geometry changes.
-    localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
-    localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
-
-    // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
-    localStorage->m_Reslicer->Modified();
-    localStorage->m_Reslicer->Update();
+    int slabMode = -1;
+    switch (thickSlicesMode - 1)
+    {
+      case vtkMitkThickSlicesFilter::MIP:
+        slabMode = VTK_IMAGE_SLAB_MAX;
+        break;
+      case vtkMitkThickSlicesFilter::SUM:
+        if (isFloatingPoint)
+          slabMode = VTK_IMAGE_SLAB_MEAN;
+        break;
+      case vtkMitkThickSlicesFilter::MINIP:
+        slabMode = VTK_IMAGE_SLAB_MIN;
+        break;
+    }
 
-    localStorage->m_TSFilter->Modified();
-    localStorage->m_TSFilter->Update();
-    localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
+    if (-1 != slabMode)
+    {
+      localStorage->m_Reslicer->SetOutputDimensionality(2);
+      localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
+      localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+      localStorage->m_Reslicer->SetSlabMode(slabMode);
+      localStorage->m_Reslicer->SetSlabNumberOfSlices(2 * thickSlicesNum + 1);
+
+      localStorage->m_Reslicer->Modified();
+      localStorage->m_Reslicer->UpdateLargestPossibleRegion();
+      localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+    }
+    else
+    {
+      localStorage->m_Reslicer->SetOutputDimensionality(3);
+      localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
+      localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+      localStorage->m_Reslicer->SetSlabNumberOfSlices(1);
+
+      // Do the reslicing. Modified() is called to make sure that the reslicer is
+      // executed even though the input geometry information did not change; this
+      // is necessary when the input /em data, but not the /em geometry changes.
+      localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
+      localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
+
+      // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
+      localStorage->m_Reslicer->Modified();
+      localStorage->m_Reslicer->Update();
+
+      localStorage->m_TSFilter->Modified();
+      localStorage->m_TSFilter->Update();
+      localStorage->m_ReslicedImage = localStorage->m_TSFilter->GetOutput();
+    }
   }
   else
   {
@@ -272,6 +327,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_Reslicer->SetOutputDimensionality(2);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
     localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+    localStorage->m_Reslicer->SetSlabNumberOfSlices(1);
 
     localStorage->m_Reslicer->Modified();
     // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
@@ -318,10 +374,10 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   // get the binary property
   bool binary = false;
   bool binaryOutline = false;
-  datanode->GetBoolProperty("binary", binary, renderer);
+  datanode->GetBoolProperty(BinaryKey, binary, renderer);
   if (binary) // binary image
   {
-    datanode->GetBoolProperty("outline binary", binaryOutline, renderer);
+    datanode->GetBoolProperty(OutlineBinaryKey, binaryOutline, renderer);
     if (binaryOutline) // contour rendering
     {
       // get pixel type of vtk image
@@ -441,12 +497,12 @@ void mitk::ImageVtkMapper2D::ApplyLevelWindow(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
 
   LevelWindow levelWindow;
-  this->GetDataNode()->GetLevelWindow(levelWindow, renderer, "levelwindow");
+  this->GetDataNode()->GetLevelWindow(levelWindow, renderer, LevelWindowKey);
   localStorage->m_LevelWindowFilter->GetLookupTable()->SetRange(levelWindow.GetLowerWindowBound(),
                                                                 levelWindow.GetUpperWindowBound());
 
   mitk::LevelWindow opacLevelWindow;
-  if (this->GetDataNode()->GetLevelWindow(opacLevelWindow, renderer, "opaclevelwindow"))
+  if (this->GetDataNode()->GetLevelWindow(opacLevelWindow, renderer, OpacLevelWindowKey))
   {
     // pass the opaque level window to the filter
     localStorage->m_LevelWindowFilter->SetMinOpacity(opacLevelWindow.GetLowerWindowBound());
@@ -473,7 +529,7 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
   bool binary = false;
   GetDataNode()->GetBoolProperty("binaryimage.ishovering", hover, renderer);
   GetDataNode()->GetBoolProperty("selected", selected, renderer);
-  GetDataNode()->GetBoolProperty("binary", binary, renderer);
+  GetDataNode()->GetBoolProperty(BinaryKey, binary, renderer);
   if (binary && hover && !selected)
   {
     mitk::ColorProperty::Pointer colorprop =
@@ -484,7 +540,7 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
     }
     else
     {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      GetDataNode()->GetColor(rgb, renderer, ColorKey);
     }
   }
   if (binary && selected)
@@ -497,12 +553,12 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
     }
     else
     {
-      GetDataNode()->GetColor(rgb, renderer, "color");
+      GetDataNode()->GetColor(rgb, renderer, ColorKey);
     }
   }
   if (!binary || (!hover && !selected))
   {
-    GetDataNode()->GetColor(rgb, renderer, "color");
+    GetDataNode()->GetColor(rgb, renderer, ColorKey);
   }
 
   double rgbConv[3] = {(double)rgb[0], (double)rgb[1], (double)rgb[2]}; // conversion to double for VTK
@@ -528,7 +584,7 @@ void mitk::ImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
   float opacity = 1.0f;
   // check for opacity prop and use it for rendering if it exists
-  GetDataNode()->GetOpacity(opacity, renderer, "opacity");
+  GetDataNode()->GetOpacity(opacity, renderer, OpacityKey);
   // set the opacity according to the properties
   localStorage->m_Actor->GetProperty()->SetOpacity(opacity);
   if (localStorage->m_Actors->GetParts()->GetNumberOfItems() > 1)
@@ -544,7 +600,7 @@ void mitk::ImageVtkMapper2D::ApplyRenderingMode(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
 
   bool binary = false;
-  this->GetDataNode()->GetBoolProperty("binary", binary, renderer);
+  this->GetDataNode()->GetBoolProperty(BinaryKey, binary, renderer);
   if (binary) // is it a binary image?
   {
     // for binary images, we always use our default LuT and map every value to (0,1)
@@ -636,7 +692,7 @@ void mitk::ImageVtkMapper2D::ApplyColorTransferFunction(mitk::BaseRenderer *rend
 void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
 
   if (!visible)
   {
@@ -671,7 +727,8 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()))
+      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()) ||
+      (localStorage->m_ReducedQuality != RenderingManager::GetInstance()->IsReducedQualityRendering(renderer)))
   {
     this->GenerateDataForRenderer(renderer);
   }
@@ -726,7 +783,7 @@ void mitk::ImageVtkMapper2D::SetDefaultProperties(mitk::DataNode *node, mitk::Ba
   }
 
   bool isBinaryImage(false);
-  if (!node->GetBoolProperty("binary", isBinaryImage) && image->GetPixelType().GetNumberOfComponents() == 1)
+  if (!node->GetBoolProperty(BinaryKey, isBinaryImage) && image->GetPixelType().GetNumberOfComponents() == 1)
   {
     // ok, property is not set, use heuristic to determine if this
     // is a binary image
@@ -1077,7 +1134,7 @@ mitk::ImageVtkMapper2D::LocalStorage::~LocalStorage()
 }
 
 mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
-  : m_VectorComponentExtractor(vtkSmartPointer<vtkImageExtractComponents>::New())
+  : m_VectorComponentExtractor(vtkSmartPointer<vtkImageExtractComponents>::New()), m_ReducedQuality(false)
 {
   m_LevelWindowFilter = vtkSmartPointer<vtkMitkLevelWindowFilter>::New();
 
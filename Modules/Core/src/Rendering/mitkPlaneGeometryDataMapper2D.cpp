@@ -44,6 +44,11 @@ found in the LICENSE file.
 
 namespace
 {
+  // interned keys of the properties that are queried for every update
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey ColorKey("color");
+  const mitk::PropertyKey OpacityKey("opacity");
+
   /// Some simple interval arithmetic
   template <typename T>
   class SimpleInterval
@@ -231,7 +236,7 @@ void mitk::PlaneGeometryDataMapper2D::CreateVtkCrosshair(mitk::BaseRenderer *ren
   ls->m_ArrowActor->SetVisibility(0);
   ls->m_CrosshairHelperLineActor->SetVisibility(0);
 
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
 
   if (!visible)
   {
@@ -638,9 +643,9 @@ void mitk::PlaneGeometryDataMapper2D::ApplyColorAndOpacityProperties2D(BaseRende
   DataNode *node = GetDataNode();
 
   // check for color prop and use it for rendering if it exists
-  node->GetColor(rgba, renderer, "color");
+  node->GetColor(rgba, renderer, ColorKey);
   // check for opacity prop and use it for rendering if it exists
-  node->GetOpacity(rgba[3], renderer, "opacity");
+  node->GetOpacity(rgba[3], renderer, OpacityKey);
 
   double drgba[4] = {rgba[0], rgba[1], rgba[2], rgba[3]};
   actor->GetProperty()->SetColor(drgba);
@@ -36,6 +36,14 @@ found in the LICENSE file.
 
 #include <cstdlib>
 
+namespace
+{
+  // interned keys of the properties that are queried for every update
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey OpacityKey("opacity");
+  const mitk::PropertyKey LineWidthKey("line width");
+}
+
 // constructor LocalStorage
 mitk::PointSetVtkMapper2D::LocalStorage::LocalStorage()
 {
@@ -576,7 +584,7 @@ void mitk::PointSetVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rend
 
   // toggle visibility
   bool visible = true;
-  node->GetVisibility(visible, renderer, "visible");
+  node->GetVisibility(visible, renderer, VisibleKey);
   if (!visible)
   {
     ls->m_UnselectedActor->VisibilityOff();
@@ -597,7 +605,7 @@ void mitk::PointSetVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rend
   node->GetIntProperty("distance decimal digits", m_DistancesDecimalDigits, renderer);
   node->GetBoolProperty("show angles", m_ShowAngles, renderer);
   node->GetBoolProperty("show distant lines", m_ShowDistantLines, renderer);
-  node->GetIntProperty("line width", m_LineWidth, renderer);
+  node->GetIntProperty(LineWidthKey, m_LineWidth, renderer);
   node->GetIntProperty("point line width", m_PointLineWidth, renderer);
   if (!node->GetFloatProperty(
         "point 2D size", m_Point2DSize, renderer)) // re-defined to float 2015-08-13, keep a fallback
@@ -623,7 +631,7 @@ void mitk::PointSetVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rend
 
   float opacity = 1.0;
 
-  GetDataNode()->GetOpacity(opacity, renderer);
+  GetDataNode()->GetOpacity(opacity, renderer, OpacityKey);
 
   // apply color and opacity
   if (m_ShowPoints)
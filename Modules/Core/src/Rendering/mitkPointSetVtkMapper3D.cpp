@@ -39,6 +39,12 @@ found in the LICENSE file.
 #include <mitkPropertyObserver.h>
 #include <vtk_glew.h>
 
+namespace
+{
+  // interned keys of the properties that are queried for every update
+  const mitk::PropertyKey VisibleKey("visible");
+}
+
 const mitk::PointSet *mitk::PointSetVtkMapper3D::GetInput()
 {
   return static_cast<const mitk::PointSet *>(GetDataNode()->GetData());
@@ -370,7 +376,7 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects()
 void mitk::PointSetVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
   if (!visible)
   {
     m_UnselectedActor->VisibilityOff();
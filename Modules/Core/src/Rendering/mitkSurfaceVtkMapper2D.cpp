@@ -37,6 +37,17 @@ found in the LICENSE file.
 #include <vtkReverseSense.h>
 #include <vtkTransformPolyDataFilter.h>
 
+namespace
+{
+  // interned keys of the properties that are queried for every update
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey ColorKey("color");
+  const mitk::PropertyKey OpacityKey("opacity");
+  const mitk::PropertyKey LevelWindowKey("levelwindow");
+  const mitk::PropertyKey SurfaceLevelWindowKey("levelWindow");
+  const mitk::PropertyKey LineWidthKey("line width");
+}
+
 // constructor LocalStorage
 mitk::SurfaceVtkMapper2D::LocalStorage::LocalStorage()
 {
@@ -126,7 +137,7 @@ void mitk::SurfaceVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   if (node == nullptr)
     return;
   bool visible = true;
-  node->GetVisibility(visible, renderer, "visible");
+  node->GetVisibility(visible, renderer, VisibleKey);
   if (!visible)
     return;
 
@@ -285,15 +296,15 @@ void mitk::SurfaceVtkMapper2D::ApplyAllProperties(mitk::BaseRenderer *renderer)
   FixupLegacyProperties(node->GetPropertyList());
 
   float lineWidth = 1.0f;
-  node->GetFloatProperty("line width", lineWidth, renderer);
+  node->GetFloatProperty(LineWidthKey, lineWidth, renderer);
 
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
 
   // check for color and opacity properties, use it for rendering if they exists
   float color[3] = {1.0f, 1.0f, 1.0f};
-  node->GetColor(color, renderer, "color");
+  node->GetColor(color, renderer, ColorKey);
   float opacity = 1.0f;
-  node->GetOpacity(opacity, renderer, "opacity");
+  node->GetOpacity(opacity, renderer, OpacityKey);
 
   // Pass properties to VTK
   localStorage->m_Actor->GetProperty()->SetColor(color[0], color[1], color[2]);
@@ -323,11 +334,11 @@ void mitk::SurfaceVtkMapper2D::ApplyAllProperties(mitk::BaseRenderer *renderer)
   }
 
   mitk::LevelWindow levelWindow;
-  if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer, "levelWindow"))
+  if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer, SurfaceLevelWindowKey))
   {
     localStorage->m_Mapper->SetScalarRange(levelWindow.GetLowerWindowBound(), levelWindow.GetUpperWindowBound());
   }
-  else if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer))
+  else if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer, LevelWindowKey))
   {
     localStorage->m_Mapper->SetScalarRange(levelWindow.GetLowerWindowBound(), levelWindow.GetUpperWindowBound());
   }
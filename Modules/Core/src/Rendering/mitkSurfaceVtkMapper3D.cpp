@@ -37,6 +37,15 @@ found in the LICENSE file.
 #include <vtkProperty.h>
 #include <vtkSmartPointer.h>
 
+namespace
+{
+  // interned keys of the properties that are queried for every update
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey OpacityKey("opacity");
+  const mitk::PropertyKey LevelWindowKey("levelwindow");
+  const mitk::PropertyKey SurfaceLevelWindowKey("levelWindow");
+}
+
 const mitk::Surface *mitk::SurfaceVtkMapper3D::GetInput()
 {
   return static_cast<const mitk::Surface *>(GetDataNode()->GetData());
@@ -56,7 +65,7 @@ void mitk::SurfaceVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rende
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
 
   if (!visible)
   {
@@ -233,7 +242,7 @@ void mitk::SurfaceVtkMapper3D::ApplyMitkPropertiesToVtkProperty(mitk::DataNode *
     // Opacity
     {
       float opacity = 1.0f;
-      if (node->GetOpacity(opacity, renderer))
+      if (node->GetOpacity(opacity, renderer, OpacityKey))
         property->SetOpacity(opacity);
     }
 
@@ -292,11 +301,11 @@ void mitk::SurfaceVtkMapper3D::ApplyAllProperties(mitk::BaseRenderer *renderer,
   }
 
   mitk::LevelWindow levelWindow;
-  if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer, "levelWindow"))
+  if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer, SurfaceLevelWindowKey))
   {
     ls->m_VtkPolyDataMapper->SetScalarRange(levelWindow.GetLowerWindowBound(), levelWindow.GetUpperWindowBound());
   }
-  else if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer))
+  else if (this->GetDataNode()->GetLevelWindow(levelWindow, renderer, LevelWindowKey))
   {
     ls->m_VtkPolyDataMapper->SetScalarRange(levelWindow.GetLowerWindowBound(), levelWindow.GetUpperWindowBound());
   }
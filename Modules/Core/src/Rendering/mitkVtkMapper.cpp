@@ -12,6 +12,14 @@ found in the LICENSE file.
 
 #include "mitkVtkMapper.h"
 
+namespace
+{
+  // queried for every mapper in every render pass
+  const mitk::PropertyKey VisibleKey("visible");
+  const mitk::PropertyKey ColorKey("color");
+  const mitk::PropertyKey OpacityKey("opacity");
+}
+
 mitk::VtkMapper::VtkMapper()
 {
 }
@@ -47,7 +55,7 @@ bool mitk::VtkMapper::IsVtkBased() const
 void mitk::VtkMapper::MitkRenderOverlay(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
   if (!visible)
     return;
 
@@ -61,7 +69,7 @@ void mitk::VtkMapper::MitkRenderOpaqueGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
 
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
   if (!visible)
     return;
 
@@ -74,7 +82,7 @@ void mitk::VtkMapper::MitkRenderOpaqueGeometry(BaseRenderer *renderer)
 void mitk::VtkMapper::MitkRenderTranslucentGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
   if (!visible)
     return;
 
@@ -87,7 +95,7 @@ void mitk::VtkMapper::MitkRenderTranslucentGeometry(BaseRenderer *renderer)
 void mitk::VtkMapper::MitkRenderVolumetricGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, VisibleKey);
   if (!visible)
     return;
 
@@ -120,9 +128,9 @@ void mitk::VtkMapper::ApplyColorAndOpacityProperties(BaseRenderer *renderer, vtk
   DataNode *node = GetDataNode();
 
   // check for color prop and use it for rendering if it exists
-  node->GetColor(rgba, renderer, "color");
+  node->GetColor(rgba, renderer, ColorKey);
   // check for opacity prop and use it for rendering if it exists
-  node->GetOpacity(rgba[3], renderer, "opacity");
+  node->GetOpacity(rgba[3], renderer, OpacityKey);
 
   double drgba[4] = {rgba[0], rgba[1], rgba[2], rgba[3]};
   actor->GetProperty()->SetColor(drgba);
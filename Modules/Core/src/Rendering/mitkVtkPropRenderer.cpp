@@ -53,9 +53,22 @@ found in the LICENSE file.
 #include <vtkTransform.h>
 #include <vtkWorldPointPicker.h>
 
+#include <algorithm>
+
+namespace
+{
+  // interned keys of the properties that determine the mapper queue
+  const mitk::PropertyKey LayerKey("layer");
+  const mitk::PropertyKey VisibleKey("visible");
+}
+
 mitk::VtkPropRenderer::VtkPropRenderer(const char *name, vtkRenderWindow *renWin)
   : BaseRenderer(name, renWin),
-    m_CameraInitializedForMapperID(0)
+    m_CameraInitializedForMapperID(0),
+    m_NextMapperQueueSequenceNumber(0),
+    m_NextMapperQueueInsertionNumber(0),
+    m_MapperQueueOutdated(true),
+    m_MapperQueueMapperID(0)
 {
   didCount = false;
 
@@ -92,6 +105,9 @@ mitk::VtkPropRenderer::~VtkPropRenderer()
     checkState();
   }
 
+  this->RemoveDataStorageListeners();
+  this->ClearMapperQueue();
+
   if (m_LightKit != nullptr)
     m_LightKit->Delete();
 
@@ -121,8 +137,19 @@ void mitk::VtkPropRenderer::SetDataStorage(mitk::DataStorage *storage)
   if (storage == nullptr || storage == m_DataStorage)
     return;
 
+  this->RemoveDataStorageListeners();
+  this->ClearMapperQueue();
+  m_MapperQueueInsertionNumbers.clear();
+  m_NextMapperQueueInsertionNumber = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+    m_MapperQueueNodeEvents.clear();
+  }
+
   BaseRenderer::SetDataStorage(storage);
 
+  this->AddDataStorageListeners();
+
   static_cast<mitk::PlaneGeometryDataVtkMapper3D *>(m_CurrentWorldPlaneGeometryMapper.GetPointer())
     ->SetDataStorageForTexture(m_DataStorage.GetPointer());
 
@@ -195,13 +222,11 @@ int mitk::VtkPropRenderer::Render(mitk::VtkPropRenderer::RenderType type)
 \brief PrepareMapperQueue iterates the datatree
 
 PrepareMapperQueue iterates the datatree in order to find mappers which shall be rendered. Also, it sortes the mappers
-wrt to their layer.
+wrt to their layer. The sorted mappers are kept between frames; only the entries of nodes that were added or modified
+since the last frame are re-evaluated.
 */
 void mitk::VtkPropRenderer::PrepareMapperQueue()
 {
-  // variable for counting LOD-enabled mappers
-  m_NumberOfVisibleLODEnabledMappers = 0;
-
   // Do we have to update the mappers ?
   if (m_LastUpdateTime < GetMTime() || m_LastUpdateTime < this->GetCurrentWorldPlaneGeometry()->GetMTime())
   {
@@ -219,44 +244,272 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
   }
   m_TextCollection.clear();
 
-  // clear priority_queue
+  this->UpdateMapperQueue();
+}
+
+void mitk::VtkPropRenderer::UpdateMapperQueue()
+{
+  std::vector<std::pair<const DataNode *, bool>> nodeEvents;
+  {
+    std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+    nodeEvents.swap(m_MapperQueueNodeEvents);
+  }
+
+  for (const auto &nodeEvent : nodeEvents)
+  {
+    const DataNode *node = nodeEvent.first;
+    if (!nodeEvent.second)
+    {
+      // a removed node may already be deleted, it is only used as key
+      this->RemoveFromMapperQueue(node);
+      m_MapperQueueInsertionNumbers.erase(node);
+      continue;
+    }
+
+    m_MapperQueueInsertionNumbers[node] = m_NextMapperQueueInsertionNumber++;
+
+    // an outdated queue is rebuilt in the order of the insertion numbers anyway
+    if (m_MapperQueueOutdated)
+      continue;
+
+    // sequence numbers must not overflow into the layer part of the key; renumber all entries instead
+    if (m_NextMapperQueueSequenceNumber >= (1u << 16))
+    {
+      m_MapperQueueOutdated = true;
+      continue;
+    }
+
+    this->AddToMapperQueue(node);
+  }
+
+  if (m_MapperQueueOutdated || m_MapperQueueMapperID != m_MapperID)
+  {
+    this->ClearMapperQueue();
+    m_MapperQueueOutdated = false;
+    m_MapperQueueMapperID = m_MapperID;
+
+    if (m_DataStorage.IsNull())
+      return;
+
+    // GetAll() does not return the nodes in the order they were added, thus the nodes are sorted by their
+    // insertion numbers. Nodes without one were in the data storage before it was set.
+    std::vector<std::pair<unsigned long, const DataNode *>> nodes;
+    DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
+    for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
+    {
+      if (it->Value().IsNull())
+        continue;
+
+      auto insertionNumber = m_MapperQueueInsertionNumbers.find(it->Value());
+      if (insertionNumber == m_MapperQueueInsertionNumbers.end())
+        insertionNumber = m_MapperQueueInsertionNumbers.emplace(it->Value(), m_NextMapperQueueInsertionNumber++).first;
+      nodes.emplace_back(insertionNumber->second, it->Value());
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    for (const auto &node : nodes)
+      this->AddToMapperQueue(node.second);
+  }
+
+  // observers may mark further nodes as outdated while the entries are updated, thus the set is swapped first
+  std::set<const DataNode *> outdatedNodes;
+  {
+    std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+    outdatedNodes.swap(m_OutdatedMapperQueueNodes);
+  }
+
+  for (auto node : outdatedNodes)
+  {
+    auto entryIter = m_MapperQueueEntries.find(node);
+    if (entryIter != m_MapperQueueEntries.end())
+      this->UpdateMapperQueueEntry(node, entryIter->second);
+  }
+}
+
+void mitk::VtkPropRenderer::ClearMapperQueue()
+{
+  for (auto &entry : m_MapperQueueEntries)
+    this->RemoveMapperQueueObservers(entry.first, entry.second);
+
+  m_MapperQueueEntries.clear();
+  {
+    std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+    m_OutdatedMapperQueueNodes.clear();
+    m_MapperQueueObservedObjects.clear();
+  }
   m_MappersMap.clear();
+  m_NumberOfVisibleLODEnabledMappers = 0;
+  m_NextMapperQueueSequenceNumber = 0;
+  m_MapperQueueOutdated = true;
+}
+
+void mitk::VtkPropRenderer::AddToMapperQueue(const DataNode *node)
+{
+  auto &entry = m_MapperQueueEntries[node];
+  entry.sequenceNumber = m_NextMapperQueueSequenceNumber++;
 
-  int mapperNo = 0;
+  std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+  m_OutdatedMapperQueueNodes.insert(node);
+}
 
-  // DataStorage
-  if (m_DataStorage.IsNull())
+void mitk::VtkPropRenderer::RemoveFromMapperQueue(const DataNode *node)
+{
+  auto entryIter = m_MapperQueueEntries.find(node);
+  if (entryIter == m_MapperQueueEntries.end())
     return;
 
-  DataStorage::SetOfObjects::ConstPointer allObjects = m_DataStorage->GetAll();
+  auto &entry = entryIter->second;
+  if (entry.mapper.IsNotNull())
+    m_MappersMap.erase(entry.key);
+  if (entry.visibleLODEnabled)
+    --m_NumberOfVisibleLODEnabledMappers;
 
-  for (DataStorage::SetOfObjects::ConstIterator it = allObjects->Begin(); it != allObjects->End(); ++it)
+  this->RemoveMapperQueueObservers(node, entry);
+  m_MapperQueueEntries.erase(entryIter);
+
+  std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+  m_OutdatedMapperQueueNodes.erase(node);
+}
+
+void mitk::VtkPropRenderer::UpdateMapperQueueEntry(const DataNode *node, MapperQueueEntry &entry)
+{
+  // The observers are added before mapper, layer and visibility are read, so that no modification gets lost.
+  // Changing the value of a property does not modify the node, thus the "layer" and "visible" properties are
+  // observed directly. They are looked up again whenever the entry is updated, because they may be replaced.
+  this->RemoveMapperQueueObservers(node, entry);
+
+  auto command = itk::MemberCommand<VtkPropRenderer>::New();
+  command->SetCallbackFunction(this, &VtkPropRenderer::OnMapperQueueObjectModified);
+
+  auto observe = [this, node, &entry, &command](const itk::Object *object, const itk::EventObject &event) {
+    {
+      std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+      m_MapperQueueObservedObjects.emplace(object, node);
+    }
+    entry.observedObjects.emplace_back(object, object->AddObserver(event, command));
+  };
+
+  observe(node, itk::ModifiedEvent());
+  observe(node, DataNode::MapperChangedEvent());
+  observe(node, DataNode::PropertyListAddedEvent());
+
+  // GetPropertyList(this) would create the renderer-specific property list, thus it is only used if it exists.
+  // The node reports the creation of the list.
+  std::vector<const PropertyList *> propertyLists = {node->GetPropertyList()};
+  const auto propertyListNames = node->GetPropertyListNames();
+  if (std::find(propertyListNames.cbegin(), propertyListNames.cend(), this->GetName()) != propertyListNames.cend())
   {
-    const DataNode::Pointer node = it->Value();
-    if (node.IsNull())
-      continue;
-    const mitk::Mapper::Pointer mapper = node->GetMapper(m_MapperID);
+    // the node only observes its default property list
+    propertyLists.push_back(node->GetPropertyList(this));
+    observe(propertyLists.back(), itk::ModifiedEvent());
+  }
 
-    if (mapper.IsNull())
-      continue;
+  for (auto propertyList : propertyLists)
+  {
+    for (const auto &propertyKey : {LayerKey, VisibleKey})
+    {
+      const itk::Object *property = propertyList->GetProperty(propertyKey);
+      if (property != nullptr)
+        observe(property, itk::ModifiedEvent());
+    }
+  }
 
+  if (entry.mapper.IsNotNull())
+    m_MappersMap.erase(entry.key);
+  if (entry.visibleLODEnabled)
+    --m_NumberOfVisibleLODEnabledMappers;
+
+  entry.mapper = node->GetMapper(m_MapperID);
+  entry.visibleLODEnabled = false;
+
+  if (entry.mapper.IsNotNull())
+  {
     bool visible = true;
-    node->GetVisibility(visible, this, "visible");
+    node->GetVisibility(visible, this, VisibleKey);
 
     // The information about LOD-enabled mappers is required by RenderingManager
-    if (mapper->IsLODEnabled(this) && visible)
+    if (entry.mapper->IsLODEnabled(this) && visible)
     {
+      entry.visibleLODEnabled = true;
       ++m_NumberOfVisibleLODEnabledMappers;
     }
     // mapper without a layer property get layer number 1
     int layer = 1;
-    node->GetIntProperty("layer", layer, this);
-    int nr = (layer << 16) + mapperNo;
-    m_MappersMap.insert(std::pair<int, Mapper *>(nr, mapper));
-    mapperNo++;
+    node->GetIntProperty(LayerKey, layer, this);
+    entry.key = (layer << 16) + entry.sequenceNumber;
+    m_MappersMap.insert(std::pair<int, Mapper *>(entry.key, entry.mapper));
   }
 }
 
+void mitk::VtkPropRenderer::RemoveMapperQueueObservers(const DataNode *node, MapperQueueEntry &entry)
+{
+  for (const auto &observedObject : entry.observedObjects)
+  {
+    const_cast<itk::Object *>(observedObject.first.GetPointer())->RemoveObserver(observedObject.second);
+
+    std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+    auto range = m_MapperQueueObservedObjects.equal_range(observedObject.first.GetPointer());
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      if (iter->second == node)
+      {
+        m_MapperQueueObservedObjects.erase(iter);
+        break;
+      }
+    }
+  }
+  entry.observedObjects.clear();
+}
+
+void mitk::VtkPropRenderer::AddDataStorageListeners()
+{
+  if (m_DataStorage.IsNull())
+    return;
+
+  m_DataStorage->AddNodeEvent.AddListener(
+    mitk::MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnMapperQueueNodeAdded));
+  m_DataStorage->RemoveNodeEvent.AddListener(
+    mitk::MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnMapperQueueNodeRemoved));
+}
+
+void mitk::VtkPropRenderer::RemoveDataStorageListeners()
+{
+  if (m_DataStorage.IsNull())
+    return;
+
+  m_DataStorage->AddNodeEvent.RemoveListener(
+    mitk::MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnMapperQueueNodeAdded));
+  m_DataStorage->RemoveNodeEvent.RemoveListener(
+    mitk::MessageDelegate1<VtkPropRenderer, const DataNode *>(this, &VtkPropRenderer::OnMapperQueueNodeRemoved));
+}
+
+void mitk::VtkPropRenderer::OnMapperQueueNodeAdded(const DataNode *node)
+{
+  if (node == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+  m_MapperQueueNodeEvents.emplace_back(node, true);
+}
+
+void mitk::VtkPropRenderer::OnMapperQueueNodeRemoved(const DataNode *node)
+{
+  if (node == nullptr)
+    return;
+
+  // the node is kept alive by the observers of its entry until the removal is applied, if it has been rendered
+  std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+  m_MapperQueueNodeEvents.emplace_back(node, false);
+}
+
+void mitk::VtkPropRenderer::OnMapperQueueObjectModified(const itk::Object *caller, const itk::EventObject &)
+{
+  std::lock_guard<std::mutex> lock(m_MapperQueueMutex);
+  auto range = m_MapperQueueObservedObjects.equal_range(caller);
+  for (auto iter = range.first; iter != range.second; ++iter)
+    m_OutdatedMapperQueueNodes.insert(iter->second);
+}
+
 void mitk::VtkPropRenderer::SetPropertyKeys(vtkInformation *info)
 {
   if (info == m_VtkRenderInfo)
@@ -312,9 +565,20 @@ void mitk::VtkPropRenderer::Update()
   if (m_DataStorage.IsNull())
     return;
 
-  mitk::DataStorage::SetOfObjects::ConstPointer all = m_DataStorage->GetAll();
-  for (mitk::DataStorage::SetOfObjects::ConstIterator it = all->Begin(); it != all->End(); ++it)
-    Update(it->Value());
+  this->UpdateMapperQueue();
+
+  // nodes without a mapper have nothing to update, thus only the mappers of the queue are visited
+  if (GetCurrentWorldPlaneGeometry()->IsValid())
+  {
+    for (const auto &mapEntry : m_MappersMap)
+    {
+      mapEntry.second->Update(this);
+
+      auto *vtkmapper = dynamic_cast<VtkMapper *>(mapEntry.second);
+      if (vtkmapper != nullptr)
+        vtkmapper->UpdateVtkTransform(this);
+    }
+  }
 
   Modified();
   m_LastUpdateTime = GetMTime();
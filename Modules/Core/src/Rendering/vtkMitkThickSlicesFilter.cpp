@@ -20,8 +20,10 @@ found in the LICENSE file.
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkMitkThickSlicesFilter);
 
@@ -105,9 +107,11 @@ int vtkMitkThickSlicesFilter::RequestUpdateExtent(vtkInformation *,
 }
 
 //----------------------------------------------------------------------------
-// This execute method handles boundaries.
-// it handles boundaries. Pixels are just replicated to get values
-// out of extent.
+// Projects the slices of the input onto the output extent. The output is
+// processed row by row: each input slice contributes a contiguous row to a
+// row of maxima, minima or weighted sums. Thus the input is read in memory
+// order and the inner loops over x can be vectorized by the compiler. The
+// threads of vtkThreadedImageAlgorithm process different output rows.
 template <class T>
 void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      vtkImageData *inData,
@@ -117,223 +121,121 @@ void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      int outExt[6],
                                      int /*id*/)
 {
-  int idxX, idxY;
-  int maxX, maxY;
-  vtkIdType inIncX, inIncY, inIncZ;
-  vtkIdType outIncX, outIncY, outIncZ;
-  // int axesNum;
   int *inExt = inData->GetExtent();
-  int *wholeExtent;
-  vtkIdType *inIncs;
-  // int useYMin, useYMax, useXMin, useXMax;
+  vtkIdType *inIncs = inData->GetIncrements();
+  vtkIdType outIncX, outIncY, outIncZ;
 
-  // find the region to loop over
-  maxX = outExt[1] - outExt[0];
-  maxY = outExt[3] - outExt[2];
+  const int width = outExt[1] - outExt[0] + 1;
+  const int height = outExt[3] - outExt[2] + 1;
 
-  //  maxZ = outExt[5] - outExt[4];
+  // all slices of the input are projected
+  const int numberOfSlices = inExt[5] - inExt[4] + 1;
 
-  // Get the dimensionality of the gradient.
-  // axesNum = self->GetDimensionality();
+  if (width <= 0 || height <= 0 || numberOfSlices <= 0)
+    return;
 
-  // Get increments to march through data
-  inData->GetContinuousIncrements(outExt, inIncX, inIncY, inIncZ);
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
-  /*
-// The data spacing is important for computing the gradient.
-// central differences (2 * ratio).
-// Negative because below we have (min - max) for dx ...
-inData->GetSpacing(r);
-r[0] = -0.5 / r[0];
-r[1] = -0.5 / r[1];
-r[2] = -0.5 / r[2];
-    */
-  // get some other info we need
-  inIncs = inData->GetIncrements();
-  wholeExtent = inData->GetExtent();
-
-  // Move the pointer to the correct starting position.
-  inPtr += (outExt[0] - inExt[0]) * inIncs[0] + (outExt[2] - inExt[2]) * inIncs[1] + (outExt[4] - inExt[4]) * inIncs[2];
-
-  // Loop through ouput pixels
 
-  int _minZ = /*-5 + outExt[4];  if( _minZ  < wholeExtent[4]) _minZ=*/wholeExtent[4];
-  int _maxZ = /* 5 + outExt[4];  if( _maxZ  > wholeExtent[5]) _maxZ=*/wholeExtent[5];
+  // Move the pointer to the first pixel of the output extent in the first slice.
+  inPtr += (outExt[0] - inExt[0]) * inIncs[0] + (outExt[2] - inExt[2]) * inIncs[1];
 
-  if (_maxZ < _minZ)
-    return;
-
-  double invNum = 1.0 / (_maxZ - _minZ + 1);
+  const int mode = self->GetThickSliceMode();
 
-  switch (self->GetThickSliceMode())
+  // MIP is the default for unknown modes
+  if (vtkMitkThickSlicesFilter::SUM != mode && vtkMitkThickSlicesFilter::WEIGHTED != mode &&
+      vtkMitkThickSlicesFilter::MEAN != mode)
   {
-    default:
-    case vtkMitkThickSlicesFilter::MIP:
+    const bool minimum = vtkMitkThickSlicesFilter::MINIP == mode;
+
+    for (int y = 0; y < height; ++y, outPtr += width + outIncY)
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
+      const T *row = inPtr + y * inIncs[1];
+      std::copy(row, row + width, outPtr);
+
+      for (int z = 1; z < numberOfSlices; ++z)
       {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
+        const T *slice = row + z * inIncs[2];
+
+        if (minimum)
         {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value > mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
+          for (int x = 0; x < width; ++x)
+            outPtr[x] = slice[x] < outPtr[x] ? slice[x] : outPtr[x];
+        }
+        else
+        {
+          for (int x = 0; x < width; ++x)
+            outPtr[x] = slice[x] > outPtr[x] ? slice[x] : outPtr[x];
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
       }
     }
-    break;
-
-    case vtkMitkThickSlicesFilter::SUM:
-    {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
 
-          double sum = 0;
+    return;
+  }
 
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
+  // Weights of the slices, and factor and divisor that are applied to the weighted sum
+  std::vector<double> weights(numberOfSlices, 1.0);
+  double factor = 1.0;
+  double divisor = 1.0;
 
-          // do X axis
-          *outPtr = static_cast<T>(invNum * sum);
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
-    }
-    break;
+  switch (mode)
+  {
+    case vtkMitkThickSlicesFilter::SUM:
+      // SUM is the average of all slices
+      factor = 1.0 / numberOfSlices;
+      break;
 
     case vtkMitkThickSlicesFilter::WEIGHTED:
     {
-      const int size = _maxZ - _minZ;
-      std::vector<double> weights(size);
-      double mean = 0.5 * double(_minZ + _maxZ);
+      // the first slice is not taken into account
+      const int size = numberOfSlices - 1;
+      double mean = 0.5 * double(inExt[4] + inExt[5]);
       double sigma_sq = double(size) / 6.0;
       sigma_sq *= sigma_sq;
       double sum = 0;
-      int i = 0;
-      for (int z = _minZ + 1; z <= _maxZ; z++)
-      {
-        double val = exp(-(((double)z - mean) / sigma_sq));
-        weights[i++] = val;
-        sum += val;
-      }
-      for (i = 0; i < size; i++)
-      {
-        weights[i] /= sum;
-      }
 
-      for (idxY = 0; idxY <= maxY; idxY++)
+      weights[0] = 0.0;
+
+      for (int z = 1; z < numberOfSlices; z++)
       {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-          i = 0;
-          double mymip = 0;
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            double value = inPtr[z * inIncs[2]];
-            mymip += value * weights[i++];
-          }
-          mip = static_cast<T>(mymip);
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        weights[z] = exp(-(((double)(inExt[4] + z) - mean) / sigma_sq));
+        sum += weights[z];
       }
-    }
-    break;
 
-    case vtkMitkThickSlicesFilter::MINIP:
-    {
-      for (idxY = 0; idxY <= maxY; idxY++)
+      for (int z = 1; z < numberOfSlices; z++)
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          T mip = inPtr[_minZ * inIncs[2]];
-
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value < mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        weights[z] /= sum;
       }
     }
     break;
 
     case vtkMitkThickSlicesFilter::MEAN:
+      // MEAN divides by the number of slices minus one
+      divisor = std::max(1, numberOfSlices - 1);
+      break;
+  }
+
+  std::vector<double> sums(width);
+
+  for (int y = 0; y < height; ++y, outPtr += width + outIncY)
+  {
+    const T *row = inPtr + y * inIncs[1];
+    std::fill(sums.begin(), sums.end(), 0.0);
+
+    for (int z = 0; z < numberOfSlices; ++z)
     {
-      const int size = _maxZ - _minZ;
+      const double weight = weights[z];
 
-      // MEAN
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          long double sum = 0;
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
-
-          T mip = static_cast<T>(sum / size);
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
+      if (0.0 == weight)
+        continue;
+
+      const T *slice = row + z * inIncs[2];
+
+      for (int x = 0; x < width; ++x)
+        sums[x] += weight * slice[x];
     }
-    break;
+
+    for (int x = 0; x < width; ++x)
+      outPtr[x] = static_cast<T>(factor * sums[x] / divisor);
   }
 }
 
@@ -0,0 +1,220 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceFilter2.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <cmath>
+#include <limits>
+
+class mitkExtractSliceFilter2TestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2TestSuite);
+  MITK_TEST(AxialSliceNearestNeighbor);
+  MITK_TEST(AxialSliceLinear);
+  MITK_TEST(ObliqueSliceNearestNeighbor);
+  MITK_TEST(ObliqueSliceLinear);
+  MITK_TEST(AxialSliceCubic);
+  CPPUNIT_TEST_SUITE_END();
+
+  typedef itk::Image<float, 3> ImageType;
+
+  static const unsigned int SizeX = 10;
+  static const unsigned int SizeY = 12;
+  static const unsigned int SizeZ = 8;
+
+  mitk::Image::Pointer m_Image;
+
+  /** Pixel values are a linear function of the index, thus linear interpolation reproduces the function exactly.*/
+  static double Evaluate(double x, double y, double z) { return x + 100.0 * y + 10000.0 * z; }
+
+  static bool IsInside(const mitk::Point3D &point)
+  {
+    return point[0] >= -0.5 && point[0] < SizeX - 0.5 && point[1] >= -0.5 && point[1] < SizeY - 0.5 &&
+           point[2] >= -0.5 && point[2] < SizeZ - 0.5;
+  }
+
+  static mitk::Image::Pointer CreateImage(unsigned int sizeX, unsigned int sizeY, unsigned int sizeZ)
+  {
+    ImageType::RegionType region;
+    region.SetSize(0, sizeX);
+    region.SetSize(1, sizeY);
+    region.SetSize(2, sizeZ);
+
+    auto image = ImageType::New();
+    image->SetRegions(region);
+    image->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      auto index = it.GetIndex();
+      it.Set(static_cast<float>(Evaluate(index[0], index[1], index[2])));
+    }
+
+    return mitk::GrabItkImageMemory(image);
+  }
+
+  static mitk::PlaneGeometry::Pointer CreatePlane(const mitk::Point3D &origin,
+                                                  const mitk::Vector3D &right,
+                                                  const mitk::Vector3D &down,
+                                                  unsigned int width,
+                                                  unsigned int height,
+                                                  mitk::ScalarType spacingX,
+                                                  mitk::ScalarType spacingY)
+  {
+    mitk::Vector3D spacing;
+    spacing[0] = spacingX;
+    spacing[1] = spacingY;
+    spacing[2] = 1.0;
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(width, height, right, down, &spacing);
+    plane->SetOrigin(origin);
+    plane->SetImageGeometry(true);
+    return plane;
+  }
+
+  static mitk::Image::Pointer ExtractSlice(mitk::Image *image,
+                                           mitk::PlaneGeometry *plane,
+                                           mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(image);
+    filter->SetOutputGeometry(plane);
+    filter->SetInterpolator(interpolator);
+    filter->Update();
+    return filter->GetOutput();
+  }
+
+  /** Compares the slice with the function sampled at origin + x * xStep + y * yStep in index space.*/
+  void CheckSlice(mitk::Image *slice,
+                  const mitk::Point3D &origin,
+                  const mitk::Vector3D &xStep,
+                  const mitk::Vector3D &yStep,
+                  unsigned int width,
+                  unsigned int height,
+                  bool nearestNeighbor)
+  {
+    mitk::ImageReadAccessor readAccess(slice);
+    auto data = static_cast<const float *>(readAccess.GetData());
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        auto point = origin + xStep * static_cast<double>(x) + yStep * static_cast<double>(y);
+        auto value = data[y * width + x];
+
+        if (!IsInside(point))
+        {
+          CPPUNIT_ASSERT_EQUAL(std::numeric_limits<float>::lowest(), value);
+          continue;
+        }
+
+        if (nearestNeighbor)
+        {
+          auto expected = Evaluate(std::floor(point[0] + 0.5), std::floor(point[1] + 0.5), std::floor(point[2] + 0.5));
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, value, 1e-3);
+        }
+        else if (point[0] >= 0.0 && point[0] <= SizeX - 1 && point[1] >= 0.0 && point[1] <= SizeY - 1 &&
+                 point[2] >= 0.0 && point[2] <= SizeZ - 1)
+        {
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(Evaluate(point[0], point[1], point[2]), value, 0.05);
+        }
+      }
+    }
+  }
+
+  void CheckAxialSlice(mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, 0.0, 0.0, 3.0);
+    mitk::Vector3D right;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::Vector3D down;
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+
+    auto plane = CreatePlane(origin, right, down, SizeX, SizeY, 1.0, 1.0);
+    auto slice = ExtractSlice(m_Image, plane, interpolator);
+
+    this->CheckSlice(slice, origin, right, down, SizeX, SizeY, mitk::ExtractSliceFilter2::NearestNeighbor == interpolator);
+  }
+
+  void CheckObliqueSlice(mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    // the plane leaves the image along both axes, so that the rows have background pixels at both ends
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, -1.3, 1.1, -0.7);
+    mitk::Vector3D right;
+    mitk::FillVector3D(right, 1.0, 0.4, 0.0);
+    mitk::Vector3D down;
+    mitk::FillVector3D(down, -0.12, 0.3, 1.0);
+
+    const unsigned int width = 40;
+    const unsigned int height = 30;
+    const double spacingX = 0.37;
+    const double spacingY = 0.41;
+
+    auto plane = CreatePlane(origin, right, down, width, height, spacingX, spacingY);
+    auto slice = ExtractSlice(m_Image, plane, interpolator);
+
+    right.Normalize();
+    down.Normalize();
+
+    this->CheckSlice(slice,
+                     origin,
+                     right * spacingX,
+                     down * spacingY,
+                     width,
+                     height,
+                     mitk::ExtractSliceFilter2::NearestNeighbor == interpolator);
+  }
+
+public:
+  void setUp() override { m_Image = CreateImage(SizeX, SizeY, SizeZ); }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void AxialSliceNearestNeighbor() { this->CheckAxialSlice(mitk::ExtractSliceFilter2::NearestNeighbor); }
+
+  void AxialSliceLinear() { this->CheckAxialSlice(mitk::ExtractSliceFilter2::Linear); }
+
+  void ObliqueSliceNearestNeighbor() { this->CheckObliqueSlice(mitk::ExtractSliceFilter2::NearestNeighbor); }
+
+  void ObliqueSliceLinear() { this->CheckObliqueSlice(mitk::ExtractSliceFilter2::Linear); }
+
+  void AxialSliceCubic()
+  {
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, 0.0, 0.0, 3.0);
+    mitk::Vector3D right;
+    mitk::FillVector3D(right, 1.0, 0.0, 0.0);
+    mitk::Vector3D down;
+    mitk::FillVector3D(down, 0.0, 1.0, 0.0);
+
+    auto plane = CreatePlane(origin, right, down, SizeX, SizeY, 1.0, 1.0);
+    auto slice = ExtractSlice(m_Image, plane, mitk::ExtractSliceFilter2::Cubic);
+
+    // cubic interpolation still uses the ITK interpolator; it reproduces the samples at the pixel centers
+    mitk::ImageReadAccessor readAccess(slice);
+    auto data = static_cast<const float *>(readAccess.GetData());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(Evaluate(5.0, 6.0, 3.0), data[6 * SizeX + 5], 0.5);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2)
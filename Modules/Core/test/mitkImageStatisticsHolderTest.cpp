@@ -0,0 +1,223 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageStatisticsHolder.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <limits>
+
+class mitkImageStatisticsHolderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageStatisticsHolderTestSuite);
+  MITK_TEST(TestExtremaMatchBruteForce);
+  MITK_TEST(TestExtremaAfterSliceWrite);
+  MITK_TEST(TestExtremaAfterUnreportedWrite);
+  MITK_TEST(TestExtremaAfterRawWriteBetweenReportedWrites);
+  MITK_TEST(TestExtremaInRegion);
+  MITK_TEST(TestConstantImage);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  // dimensions are no multiples of the brick size on purpose
+  static const unsigned int DimX = 70;
+  static const unsigned int DimY = 50;
+  static const unsigned int DimZ = 40;
+
+  mitk::Image::Pointer m_Image;
+
+  struct Extrema
+  {
+    double Min = std::numeric_limits<double>::max();
+    double SecondMin = std::numeric_limits<double>::max();
+    double Max = std::numeric_limits<double>::lowest();
+    double SecondMax = std::numeric_limits<double>::lowest();
+    unsigned int CountOfMin = 0;
+    unsigned int CountOfMax = 0;
+  };
+
+  Extrema ComputeBruteForce(const itk::ImageRegion<3> &region)
+  {
+    Extrema extrema;
+    mitk::ImageReadAccessor accessor(m_Image);
+    auto data = static_cast<const short *>(accessor.GetData());
+    for (auto z = region.GetIndex(2); z < region.GetUpperIndex()[2] + 1; ++z)
+      for (auto y = region.GetIndex(1); y < region.GetUpperIndex()[1] + 1; ++y)
+        for (auto x = region.GetIndex(0); x < region.GetUpperIndex()[0] + 1; ++x)
+        {
+          double value = data[x + DimX * (y + DimY * z)];
+          extrema.Min = std::min(extrema.Min, value);
+          extrema.Max = std::max(extrema.Max, value);
+        }
+    for (auto z = region.GetIndex(2); z < region.GetUpperIndex()[2] + 1; ++z)
+      for (auto y = region.GetIndex(1); y < region.GetUpperIndex()[1] + 1; ++y)
+        for (auto x = region.GetIndex(0); x < region.GetUpperIndex()[0] + 1; ++x)
+        {
+          double value = data[x + DimX * (y + DimY * z)];
+          if (value == extrema.Min)
+            ++extrema.CountOfMin;
+          else
+            extrema.SecondMin = std::min(extrema.SecondMin, value);
+          if (value == extrema.Max)
+            ++extrema.CountOfMax;
+          else
+            extrema.SecondMax = std::max(extrema.SecondMax, value);
+        }
+    return extrema;
+  }
+
+  itk::ImageRegion<3> GetLargestPossibleRegion() const
+  {
+    itk::Size<3> size = {{DimX, DimY, DimZ}};
+    return itk::ImageRegion<3>(size);
+  }
+
+  void AssertExtrema(const Extrema &expected)
+  {
+    auto statistics = m_Image->GetStatistics();
+    CPPUNIT_ASSERT_EQUAL(expected.Min, statistics->GetScalarValueMin());
+    CPPUNIT_ASSERT_EQUAL(expected.Max, statistics->GetScalarValueMax());
+    CPPUNIT_ASSERT_EQUAL(expected.SecondMin, statistics->GetScalarValue2ndMin());
+    CPPUNIT_ASSERT_EQUAL(expected.SecondMax, statistics->GetScalarValue2ndMax());
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(expected.CountOfMin), statistics->GetCountOfMinValuedVoxels());
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(expected.CountOfMax), statistics->GetCountOfMaxValuedVoxels());
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateRandomImage<short>(DimX, DimY, DimZ, 1, 1, 1, 1, 1000, -1000);
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void TestExtremaMatchBruteForce() { AssertExtrema(ComputeBruteForce(GetLargestPossibleRegion())); }
+
+  void TestExtremaAfterSliceWrite()
+  {
+    AssertExtrema(ComputeBruteForce(GetLargestPossibleRegion()));
+
+    // write a new minimum and maximum into a single slice through a write accessor
+    {
+      mitk::ImageWriteAccessor accessor(m_Image, m_Image->GetSliceData(33));
+      auto data = static_cast<short *>(accessor.GetData());
+      data[5] = -2000;
+      data[6] = -2000;
+      data[100] = 3000;
+    }
+    m_Image->Modified();
+
+    Extrema expected = ComputeBruteForce(GetLargestPossibleRegion());
+    CPPUNIT_ASSERT_EQUAL(-2000., expected.Min);
+    AssertExtrema(expected);
+
+    // remove the new minimum again; the reported write is recomputed even if the writer does not call Modified()
+    {
+      mitk::ImageWriteAccessor accessor(m_Image, m_Image->GetSliceData(33));
+      auto data = static_cast<short *>(accessor.GetData());
+      data[5] = 0;
+      data[6] = 0;
+    }
+    AssertExtrema(ComputeBruteForce(GetLargestPossibleRegion()));
+  }
+
+  void TestExtremaAfterUnreportedWrite()
+  {
+    AssertExtrema(ComputeBruteForce(GetLargestPossibleRegion()));
+
+    // writing through the raw pointer is not reported, the modification must lead to a complete recomputation
+    mitk::ImageReadAccessor accessor(m_Image);
+    const_cast<short *>(static_cast<const short *>(accessor.GetData()))[12345] = 5000;
+    m_Image->Modified();
+
+    AssertExtrema(ComputeBruteForce(GetLargestPossibleRegion()));
+  }
+
+  void TestExtremaAfterRawWriteBetweenReportedWrites()
+  {
+    short *rawData = nullptr;
+    {
+      mitk::ImageWriteAccessor accessor(m_Image);
+      rawData = static_cast<short *>(accessor.GetData());
+      rawData[100] = 2000;
+    }
+    CPPUNIT_ASSERT_EQUAL(2000., m_Image->GetStatistics()->GetScalarValueMax());
+
+    // a reported write followed by a write through the raw buffer into another brick
+    {
+      mitk::ImageWriteAccessor accessor(m_Image, m_Image->GetSliceData(33));
+      static_cast<short *>(accessor.GetData())[5] = -2000;
+    }
+    m_Image->Modified();
+    rawData[DimX * DimY * DimZ - 1] = 4000;
+    m_Image->Modified();
+    CPPUNIT_ASSERT_EQUAL(4000., m_Image->GetStatistics()->GetScalarValueMax());
+    AssertExtrema(ComputeBruteForce(GetLargestPossibleRegion()));
+
+    // a write through the raw buffer followed by a reported write into another brick
+    rawData[DimX * DimY * DimZ - 1] = 0;
+    rawData[DimX * DimY] = 5000;
+    m_Image->Modified();
+    {
+      mitk::ImageWriteAccessor accessor(m_Image, m_Image->GetSliceData(33));
+      static_cast<short *>(accessor.GetData())[5] = 0;
+    }
+    m_Image->Modified();
+    CPPUNIT_ASSERT_EQUAL(5000., m_Image->GetStatistics()->GetScalarValueMax());
+    AssertExtrema(ComputeBruteForce(GetLargestPossibleRegion()));
+  }
+
+  void TestExtremaInRegion()
+  {
+    itk::ImageRegion<3> region({{7, 30, 3}}, {{45, 20, 36}});
+    Extrema expected = ComputeBruteForce(region);
+
+    mitk::ScalarType min, max;
+    m_Image->GetStatistics()->GetScalarValueExtremaInRegion(region, min, max);
+    CPPUNIT_ASSERT_EQUAL(expected.Min, min);
+    CPPUNIT_ASSERT_EQUAL(expected.Max, max);
+
+    // regions partially outside of the image are cropped
+    itk::ImageRegion<3> outside({{60, -10, 20}}, {{100, 30, 5}});
+    itk::ImageRegion<3> cropped = outside;
+    cropped.Crop(GetLargestPossibleRegion());
+    expected = ComputeBruteForce(cropped);
+    m_Image->GetStatistics()->GetScalarValueExtremaInRegion(outside, min, max);
+    CPPUNIT_ASSERT_EQUAL(expected.Min, min);
+    CPPUNIT_ASSERT_EQUAL(expected.Max, max);
+  }
+
+  void TestConstantImage()
+  {
+    {
+      mitk::ImageWriteAccessor accessor(m_Image);
+      auto data = static_cast<short *>(accessor.GetData());
+      std::fill(data, data + DimX * DimY * DimZ, 7);
+    }
+    m_Image->Modified();
+
+    auto statistics = m_Image->GetStatistics();
+    CPPUNIT_ASSERT_EQUAL(7., statistics->GetScalarValueMin());
+    CPPUNIT_ASSERT_EQUAL(7., statistics->GetScalarValue2ndMin());
+    CPPUNIT_ASSERT_EQUAL(7., statistics->GetScalarValue2ndMax());
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(DimX * DimY * DimZ), statistics->GetCountOfMinValuedVoxels());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageStatisticsHolder)
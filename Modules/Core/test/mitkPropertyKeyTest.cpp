@@ -0,0 +1,187 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkDataNode.h>
+#include <mitkPointSet.h>
+#include <mitkProperties.h>
+#include <mitkPropertyKey.h>
+#include <mitkPropertyList.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class mitkPropertyKeyTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyKeyTestSuite);
+  MITK_TEST(Interning);
+  MITK_TEST(PropertyListLookup);
+  MITK_TEST(PropertyListCacheInvalidation);
+  MITK_TEST(ConcurrentPropertyListLookup);
+  MITK_TEST(DataNodeLookup);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::PropertyList::Pointer m_PropertyList;
+  mitk::DataNode::Pointer m_Node;
+
+public:
+  void setUp() override
+  {
+    m_PropertyList = mitk::PropertyList::New();
+    m_PropertyList->SetBoolProperty("visible", true);
+    m_PropertyList->SetFloatProperty("opacity", 0.5f);
+
+    m_Node = mitk::DataNode::New();
+    m_Node->SetData(mitk::PointSet::New());
+    m_Node->SetVisibility(false);
+    m_Node->SetOpacity(0.25f);
+    m_Node->SetColor(0.1f, 0.2f, 0.3f);
+    m_Node->SetIntProperty("layer", 7);
+  }
+
+  void tearDown() override
+  {
+    m_PropertyList = nullptr;
+    m_Node = nullptr;
+  }
+
+  void Interning()
+  {
+    mitk::PropertyKey visible("visible");
+    mitk::PropertyKey visibleAgain(std::string("visible"));
+    mitk::PropertyKey opacity("opacity");
+
+    CPPUNIT_ASSERT(visible == visibleAgain);
+    CPPUNIT_ASSERT_EQUAL(visible.GetIndex(), visibleAgain.GetIndex());
+    CPPUNIT_ASSERT(&visible.GetName() == &visibleAgain.GetName());
+    CPPUNIT_ASSERT(visible != opacity);
+    CPPUNIT_ASSERT_EQUAL(std::string("opacity"), opacity.GetName());
+  }
+
+  void PropertyListLookup()
+  {
+    const mitk::PropertyKey visible("visible");
+    const mitk::PropertyKey unknown("unknown key of the property key test");
+
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(visible) == m_PropertyList->GetProperty("visible"));
+    // second lookup is served from the cache
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(visible) == m_PropertyList->GetProperty("visible"));
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(unknown) == nullptr);
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(unknown) == nullptr);
+  }
+
+  void PropertyListCacheInvalidation()
+  {
+    const mitk::PropertyKey visible("visible");
+    const mitk::PropertyKey added("added");
+
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(added) == nullptr);
+    m_PropertyList->SetBoolProperty("added", true);
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(added) != nullptr);
+
+    // assigning a value keeps the property object
+    auto visibleProperty = m_PropertyList->GetProperty(visible);
+    m_PropertyList->SetBoolProperty("visible", false);
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(visible) == visibleProperty);
+
+    auto replacement = mitk::BoolProperty::New(true);
+    m_PropertyList->ReplaceProperty("visible", replacement);
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(visible) == replacement.GetPointer());
+
+    m_PropertyList->DeleteProperty("visible");
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(visible) == nullptr);
+
+    m_PropertyList->SetBoolProperty("visible", true);
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(visible) != nullptr);
+
+    m_PropertyList->RemoveProperty("visible");
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(visible) == nullptr);
+
+    m_PropertyList->Clear();
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(added) == nullptr);
+  }
+
+  void ConcurrentPropertyListLookup()
+  {
+    std::vector<mitk::PropertyKey> keys;
+    for (unsigned int i = 0; i < 64; ++i)
+      keys.emplace_back("concurrent key " + std::to_string(i) + " of the property key test");
+    keys.emplace_back("visible");
+
+    // the lookups of all threads fill the cache of the same list
+    std::atomic<unsigned int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([this, &keys, &mismatches]() {
+        for (unsigned int i = 0; i < 1000; ++i)
+        {
+          for (auto iter = keys.crbegin(); iter != keys.crend(); ++iter)
+          {
+            if (m_PropertyList->GetProperty(*iter) != m_PropertyList->GetProperty(iter->GetName()))
+              ++mismatches;
+          }
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+
+    CPPUNIT_ASSERT_EQUAL(0u, mismatches.load());
+  }
+
+  void DataNodeLookup()
+  {
+    const mitk::PropertyKey visibleKey("visible");
+    const mitk::PropertyKey opacityKey("opacity");
+    const mitk::PropertyKey colorKey("color");
+    const mitk::PropertyKey layerKey("layer");
+    const mitk::PropertyKey dataKey("data property of the property key test");
+
+    bool visible = true;
+    CPPUNIT_ASSERT(m_Node->GetVisibility(visible, nullptr, visibleKey));
+    CPPUNIT_ASSERT(!visible);
+
+    float opacity = 1.0f;
+    CPPUNIT_ASSERT(m_Node->GetOpacity(opacity, nullptr, opacityKey));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, opacity, 1e-6);
+
+    float color[3] = {1.0f, 1.0f, 1.0f};
+    CPPUNIT_ASSERT(m_Node->GetColor(color, nullptr, colorKey));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, color[1], 1e-6);
+
+    int layer = 0;
+    CPPUNIT_ASSERT(m_Node->GetIntProperty(layerKey, layer));
+    CPPUNIT_ASSERT_EQUAL(7, layer);
+
+    // wrong property type
+    CPPUNIT_ASSERT(!m_Node->GetBoolProperty(layerKey, visible));
+
+    // fall back on the properties of the data
+    CPPUNIT_ASSERT(m_Node->GetProperty(dataKey) == nullptr);
+    m_Node->GetData()->SetProperty("data property of the property key test", mitk::DoubleProperty::New(2.5));
+    double value = 0.0;
+    CPPUNIT_ASSERT(m_Node->GetDoubleProperty(dataKey, value));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, value, 1e-6);
+    CPPUNIT_ASSERT(m_Node->GetProperty(dataKey, nullptr, false) == nullptr);
+
+    // replaced node properties are found
+    m_Node->SetProperty("opacity", mitk::FloatProperty::New(0.75f));
+    CPPUNIT_ASSERT(m_Node->GetOpacity(opacity, nullptr, opacityKey));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, opacity, 1e-6);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyKey)
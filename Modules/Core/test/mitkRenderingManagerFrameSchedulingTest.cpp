@@ -0,0 +1,185 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// MITK
+#include <mitkBaseRenderer.h>
+#include <mitkRenderingManager.h>
+#include <mitkRenderingTestHelper.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <memory>
+
+class mitkRenderingManagerFrameSchedulingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRenderingManagerFrameSchedulingTestSuite);
+  MITK_TEST(StatisticsAreCollected);
+  MITK_TEST(RequestsAreCoalesced);
+  MITK_TEST(FocusedWindowIsPrioritized);
+  MITK_TEST(DeferredWindowsDoNotStarve);
+  MITK_TEST(ReducedQualityWhileOverBudget);
+  MITK_TEST(DisabledSchedulingRendersAllWindows);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::unique_ptr<mitk::RenderingTestHelper> m_FirstHelper;
+  std::unique_ptr<mitk::RenderingTestHelper> m_SecondHelper;
+  vtkRenderWindow *m_FirstWindow;
+  vtkRenderWindow *m_SecondWindow;
+  mitk::RenderingManager *m_RenderingManager;
+
+  unsigned long GetNumberOfFrames(vtkRenderWindow *renderWindow) const
+  {
+    return m_RenderingManager->GetRenderWindowStatistics(renderWindow).numberOfFrames;
+  }
+
+  void RequestAndExecute(vtkRenderWindow *renderWindow)
+  {
+    m_RenderingManager->RequestUpdate(renderWindow);
+    m_RenderingManager->ExecutePendingRequests();
+  }
+
+public:
+  void setUp() override
+  {
+    m_FirstHelper.reset(new mitk::RenderingTestHelper(300, 300));
+    m_SecondHelper.reset(new mitk::RenderingTestHelper(300, 300));
+    m_FirstWindow = m_FirstHelper->GetVtkRenderWindow();
+    m_SecondWindow = m_SecondHelper->GetVtkRenderWindow();
+
+    m_RenderingManager = mitk::RenderingManager::GetInstance();
+    m_RenderingManager->ExecutePendingRequests();
+    m_RenderingManager->ResetRenderWindowStatistics();
+  }
+
+  void tearDown() override
+  {
+    m_RenderingManager->SetFrameSchedulingEnabled(false);
+    m_RenderingManager->SetFrameTimeBudget(1000.0 / 30.0);
+    m_RenderingManager->SetRenderWindowFocus(nullptr);
+
+    m_FirstHelper.reset();
+    m_SecondHelper.reset();
+  }
+
+  void StatisticsAreCollected()
+  {
+    for (int i = 0; i < 3; ++i)
+      m_RenderingManager->ForceImmediateUpdate(m_FirstWindow);
+
+    auto statistics = m_RenderingManager->GetRenderWindowStatistics(m_FirstWindow);
+    CPPUNIT_ASSERT_EQUAL(3ul, statistics.numberOfFrames);
+    CPPUNIT_ASSERT(statistics.maximumFrameTime >= statistics.lastFrameTime);
+    CPPUNIT_ASSERT(statistics.maximumFrameTime >= statistics.averageFrameTime);
+    CPPUNIT_ASSERT_EQUAL(0ul, this->GetNumberOfFrames(m_SecondWindow));
+
+    m_RenderingManager->ResetRenderWindowStatistics();
+    CPPUNIT_ASSERT_EQUAL(0ul, this->GetNumberOfFrames(m_FirstWindow));
+  }
+
+  void RequestsAreCoalesced()
+  {
+    m_RenderingManager->SetFrameSchedulingEnabled(true);
+
+    for (int i = 0; i < 3; ++i)
+      m_RenderingManager->RequestUpdate(m_FirstWindow);
+
+    m_RenderingManager->ExecutePendingRequests();
+    m_RenderingManager->ExecutePendingRequests();
+    CPPUNIT_ASSERT_EQUAL(1ul, this->GetNumberOfFrames(m_FirstWindow));
+  }
+
+  void FocusedWindowIsPrioritized()
+  {
+    m_RenderingManager->SetFrameSchedulingEnabled(true);
+    m_RenderingManager->SetFrameTimeBudget(1e-9);
+    m_RenderingManager->SetRenderWindowFocus(m_SecondWindow);
+
+    m_RenderingManager->RequestUpdate(m_FirstWindow);
+    m_RenderingManager->RequestUpdate(m_SecondWindow);
+    m_RenderingManager->ExecutePendingRequests();
+
+    CPPUNIT_ASSERT_EQUAL(1ul, this->GetNumberOfFrames(m_SecondWindow));
+    CPPUNIT_ASSERT_EQUAL(0ul, this->GetNumberOfFrames(m_FirstWindow));
+    CPPUNIT_ASSERT_EQUAL(1ul, m_RenderingManager->GetRenderWindowStatistics(m_FirstWindow).numberOfDeferredRequests);
+
+    // the deferred request is still pending
+    m_RenderingManager->ExecutePendingRequests();
+    CPPUNIT_ASSERT_EQUAL(1ul, this->GetNumberOfFrames(m_FirstWindow));
+    CPPUNIT_ASSERT_EQUAL(1ul, this->GetNumberOfFrames(m_SecondWindow));
+  }
+
+  void DeferredWindowsDoNotStarve()
+  {
+    m_RenderingManager->SetFrameSchedulingEnabled(true);
+    m_RenderingManager->SetFrameTimeBudget(1e-9);
+    m_RenderingManager->SetRenderWindowFocus(m_SecondWindow);
+
+    // continuous interaction in the focused window
+    for (int i = 0; i < 3; ++i)
+    {
+      m_RenderingManager->RequestUpdate(m_FirstWindow);
+      m_RenderingManager->RequestUpdate(m_SecondWindow);
+      m_RenderingManager->ExecutePendingRequests();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(3ul, this->GetNumberOfFrames(m_SecondWindow));
+    CPPUNIT_ASSERT_EQUAL(1ul, this->GetNumberOfFrames(m_FirstWindow));
+  }
+
+  void ReducedQualityWhileOverBudget()
+  {
+    auto renderer = mitk::BaseRenderer::GetInstance(m_FirstWindow);
+
+    m_RenderingManager->SetFrameSchedulingEnabled(true);
+    m_RenderingManager->SetRenderWindowFrameTimeBudget(m_FirstWindow, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1e-9, m_RenderingManager->GetRenderWindowFrameTimeBudget(m_FirstWindow), 1e-12);
+    CPPUNIT_ASSERT(!m_RenderingManager->IsReducedQualityRendering(renderer));
+
+    this->RequestAndExecute(m_FirstWindow);
+    CPPUNIT_ASSERT(m_RenderingManager->IsReducedQualityRendering(renderer));
+
+    this->RequestAndExecute(m_FirstWindow);
+    CPPUNIT_ASSERT_EQUAL(1ul, m_RenderingManager->GetRenderWindowStatistics(m_FirstWindow).numberOfReducedQualityFrames);
+
+    // the end of the interaction restores the full quality, even if the restoring frame exceeds the budget
+    m_RenderingManager->ExecutePendingHighResRenderingRequest();
+    CPPUNIT_ASSERT(!m_RenderingManager->IsReducedQualityRendering(renderer));
+    m_RenderingManager->ExecutePendingRequests();
+    CPPUNIT_ASSERT_EQUAL(3ul, this->GetNumberOfFrames(m_FirstWindow));
+    CPPUNIT_ASSERT(!m_RenderingManager->IsReducedQualityRendering(renderer));
+
+    // reduced quality is only used while scheduling is enabled
+    this->RequestAndExecute(m_FirstWindow);
+    CPPUNIT_ASSERT(m_RenderingManager->IsReducedQualityRendering(renderer));
+    m_RenderingManager->SetFrameSchedulingEnabled(false);
+    CPPUNIT_ASSERT(!m_RenderingManager->IsReducedQualityRendering(renderer));
+
+    m_RenderingManager->SetRenderWindowFrameTimeBudget(m_FirstWindow, 0.0);
+  }
+
+  void DisabledSchedulingRendersAllWindows()
+  {
+    m_RenderingManager->SetFrameTimeBudget(1e-9);
+    m_RenderingManager->SetRenderWindowFocus(m_SecondWindow);
+
+    m_RenderingManager->RequestUpdate(m_FirstWindow);
+    m_RenderingManager->RequestUpdate(m_SecondWindow);
+    m_RenderingManager->ExecutePendingRequests();
+
+    CPPUNIT_ASSERT_EQUAL(1ul, this->GetNumberOfFrames(m_FirstWindow));
+    CPPUNIT_ASSERT_EQUAL(1ul, this->GetNumberOfFrames(m_SecondWindow));
+    CPPUNIT_ASSERT(!m_RenderingManager->IsReducedQualityRendering(mitk::BaseRenderer::GetInstance(m_FirstWindow)));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRenderingManagerFrameScheduling)
@@ -0,0 +1,212 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkNodePredicateAnd.h>
+#include <mitkNodePredicateDataType.h>
+#include <mitkNodePredicateDataUID.h>
+#include <mitkNodePredicateFunction.h>
+#include <mitkNodePredicateProperty.h>
+#include <mitkPointSet.h>
+#include <mitkStandaloneDataStorage.h>
+#include <mitkStringProperty.h>
+#include <mitkSurface.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkStandaloneDataStorageIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandaloneDataStorageIndexTestSuite);
+  MITK_TEST(DeclaredIndices);
+  MITK_TEST(NameIndex);
+  MITK_TEST(NameIndexFollowsRenaming);
+  MITK_TEST(DataTypeIndex);
+  MITK_TEST(DataUIDIndex);
+  MITK_TEST(IndexedSubsetEqualsScan);
+  MITK_TEST(RemovedNodesAreNotIndexed);
+  CPPUNIT_TEST_SUITE_END();
+
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+  mitk::DataNode::Pointer m_PointSetNode;
+  mitk::DataNode::Pointer m_SurfaceNode;
+  mitk::DataNode::Pointer m_OtherPointSetNode;
+
+  mitk::DataNode::Pointer CreateNode(const std::string &name, mitk::BaseData *data)
+  {
+    mitk::DataNode::Pointer node = mitk::DataNode::New();
+    node->SetName(name);
+    node->SetData(data);
+    return node;
+  }
+
+  /** Returns the nodes of the data storage that fulfill the predicate by checking every node.*/
+  std::vector<mitk::DataNode *> Scan(const mitk::NodePredicateBase *predicate) const
+  {
+    std::vector<mitk::DataNode *> result;
+    auto all = m_DataStorage->GetAll();
+    for (auto it = all->Begin(); it != all->End(); ++it)
+      if (predicate->CheckNode(it->Value()))
+        result.push_back(it->Value());
+    return result;
+  }
+
+  std::vector<mitk::DataNode *> Subset(const mitk::NodePredicateBase *predicate) const
+  {
+    std::vector<mitk::DataNode *> result;
+    auto subset = m_DataStorage->GetSubset(predicate);
+    for (auto it = subset->Begin(); it != subset->End(); ++it)
+      result.push_back(it->Value());
+    return result;
+  }
+
+public:
+  void setUp() override
+  {
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+
+    m_PointSetNode = this->CreateNode("points", mitk::PointSet::New());
+    m_SurfaceNode = this->CreateNode("surface", mitk::Surface::New());
+    m_OtherPointSetNode = this->CreateNode("points", mitk::PointSet::New());
+
+    m_DataStorage->Add(m_PointSetNode);
+    m_DataStorage->Add(m_SurfaceNode, m_PointSetNode);
+    m_DataStorage->Add(m_OtherPointSetNode);
+  }
+
+  void tearDown() override
+  {
+    m_DataStorage = nullptr;
+    m_PointSetNode = nullptr;
+    m_SurfaceNode = nullptr;
+    m_OtherPointSetNode = nullptr;
+  }
+
+  void DeclaredIndices()
+  {
+    auto namePredicate = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("points"));
+    CPPUNIT_ASSERT(mitk::NodePredicateBase::IndexType::Name == namePredicate->GetIndexType());
+    CPPUNIT_ASSERT_EQUAL(std::string("points"), namePredicate->GetIndexKey());
+
+    auto otherPropertyPredicate = mitk::NodePredicateProperty::New("color", mitk::StringProperty::New("points"));
+    CPPUNIT_ASSERT(mitk::NodePredicateBase::IndexType::None == otherPropertyPredicate->GetIndexType());
+
+    auto typePredicate = mitk::NodePredicateDataType::New("Surface");
+    CPPUNIT_ASSERT(mitk::NodePredicateBase::IndexType::DataType == typePredicate->GetIndexType());
+
+    auto functionPredicate = mitk::NodePredicateFunction::New([](const mitk::DataNode *) { return true; });
+    CPPUNIT_ASSERT(mitk::NodePredicateBase::IndexType::None == functionPredicate->GetIndexType());
+
+    auto andPredicate = mitk::NodePredicateAnd::New(functionPredicate, typePredicate);
+    CPPUNIT_ASSERT(mitk::NodePredicateBase::IndexType::DataType == andPredicate->GetIndexType());
+    CPPUNIT_ASSERT_EQUAL(std::string("Surface"), andPredicate->GetIndexKey());
+  }
+
+  void NameIndex()
+  {
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("surface") == m_SurfaceNode);
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("unknown") == nullptr);
+
+    auto namePredicate = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("points"));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), this->Subset(namePredicate).size());
+    CPPUNIT_ASSERT(this->Scan(namePredicate) == this->Subset(namePredicate));
+
+    auto derived = m_DataStorage->GetNamedDerivedNode("surface", m_PointSetNode);
+    CPPUNIT_ASSERT(derived == m_SurfaceNode);
+  }
+
+  void NameIndexFollowsRenaming()
+  {
+    m_SurfaceNode->SetName("renamed");
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("surface") == nullptr);
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("renamed") == m_SurfaceNode);
+
+    // changing the value of the property directly does not modify the node
+    auto nameProperty = dynamic_cast<mitk::StringProperty *>(m_SurfaceNode->GetProperty("name"));
+    CPPUNIT_ASSERT(nameProperty != nullptr);
+    nameProperty->SetValue("renamed again");
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("renamed") == nullptr);
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("renamed again") == m_SurfaceNode);
+
+    // replace the name property by a new one
+    m_SurfaceNode->GetPropertyList()->ReplaceProperty("name", mitk::StringProperty::New("replaced"));
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("renamed again") == nullptr);
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("replaced") == m_SurfaceNode);
+
+    // the old property is not observed anymore
+    nameProperty->SetValue("stale");
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("stale") == nullptr);
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("replaced") == m_SurfaceNode);
+  }
+
+  void DataTypeIndex()
+  {
+    auto surfacePredicate = mitk::NodePredicateDataType::New("Surface");
+    auto pointSetPredicate = mitk::NodePredicateDataType::New("PointSet");
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), this->Subset(surfacePredicate).size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), this->Subset(pointSetPredicate).size());
+
+    m_SurfaceNode->SetData(mitk::PointSet::New());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), this->Subset(surfacePredicate).size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), this->Subset(pointSetPredicate).size());
+    CPPUNIT_ASSERT(this->Scan(pointSetPredicate) == this->Subset(pointSetPredicate));
+  }
+
+  void DataUIDIndex()
+  {
+    auto uid = m_SurfaceNode->GetData()->GetUID();
+    auto uidPredicate = mitk::NodePredicateDataUID::New(uid);
+    CPPUNIT_ASSERT(m_DataStorage->GetNode(uidPredicate) == m_SurfaceNode);
+
+    // setting a UID emits no event; the query has to find the node nevertheless
+    m_SurfaceNode->GetData()->SetUID("changed");
+    auto changedPredicate = mitk::NodePredicateDataUID::New("changed");
+    CPPUNIT_ASSERT(m_DataStorage->GetNode(changedPredicate) == m_SurfaceNode);
+    CPPUNIT_ASSERT(m_DataStorage->GetNode(uidPredicate) == nullptr);
+  }
+
+  void IndexedSubsetEqualsScan()
+  {
+    for (int i = 0; i < 20; ++i)
+    {
+      mitk::DataNode::Pointer node = this->CreateNode(i % 2 ? "points" : "surface", mitk::PointSet::New());
+      node->SetIntProperty("index", i);
+      m_DataStorage->Add(node);
+    }
+
+    auto evenIndex = mitk::NodePredicateFunction::New([](const mitk::DataNode *node) {
+      int index = 1;
+      return node->GetIntProperty("index", index) && index % 4 == 0;
+    });
+    auto typePredicate = mitk::NodePredicateDataType::New("PointSet");
+    auto andPredicate = mitk::NodePredicateAnd::New(evenIndex, typePredicate);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), this->Subset(andPredicate).size());
+    CPPUNIT_ASSERT(this->Scan(andPredicate) == this->Subset(andPredicate));
+
+    auto namePredicate = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("surface"));
+    CPPUNIT_ASSERT(this->Scan(namePredicate) == this->Subset(namePredicate));
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("surface") == this->Scan(namePredicate).front());
+  }
+
+  void RemovedNodesAreNotIndexed()
+  {
+    m_DataStorage->Remove(m_SurfaceNode);
+    CPPUNIT_ASSERT(m_DataStorage->GetNamedNode("surface") == nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), this->Subset(mitk::NodePredicateDataType::New("Surface")).size());
+
+    // modifications of removed nodes do not affect the data storage
+    m_SurfaceNode->SetName("points");
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), this->Subset(mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("points"))).size());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandaloneDataStorageIndex)
@@ -0,0 +1,203 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// MITK
+#include <mitkPointSet.h>
+#include <mitkPointSetVtkMapper2D.h>
+#include <mitkProperties.h>
+#include <mitkRenderingTestHelper.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkVtkPropRenderer.h>
+
+#include <algorithm>
+
+class mitkVtkPropRendererMapperQueueTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkVtkPropRendererMapperQueueTestSuite);
+  MITK_TEST(QueueContainsAllNodes);
+  MITK_TEST(LayerChangeReordersQueue);
+  MITK_TEST(RemovedNodesLeaveQueue);
+  MITK_TEST(VisibilityChangeKeepsOrder);
+  MITK_TEST(ReplacedMapperEntersQueue);
+  MITK_TEST(RenderingDoesNotCreatePropertyLists);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /** Members used inside the different test methods. All members are initialized via setUp().*/
+  mitk::RenderingTestHelper m_RenderingTestHelper;
+  mitk::VtkPropRenderer *m_Renderer;
+  std::vector<mitk::DataNode::Pointer> m_Nodes;
+
+  static const unsigned int NumberOfNodes = 1200;
+
+  mitk::Mapper *GetMapper(const mitk::DataNode *node) const
+  {
+    return node->GetMapper(m_Renderer->GetMapperID());
+  }
+
+  mitk::Mapper *GetLastMapperOfQueue() const
+  {
+    auto mappers = m_Renderer->GetMappersMap();
+    return mappers.empty() ? nullptr : mappers.rbegin()->second;
+  }
+
+  /** Checks that the queue holds the mappers of all nodes in the order the nodes were added. */
+  void AssertQueueInInsertionOrder() const
+  {
+    auto mappers = m_Renderer->GetMappersMap();
+    CPPUNIT_ASSERT_EQUAL(m_Nodes.size(), mappers.size());
+
+    auto mapperIter = mappers.cbegin();
+    for (const auto &node : m_Nodes)
+    {
+      CPPUNIT_ASSERT(this->GetMapper(node) == mapperIter->second);
+      ++mapperIter;
+    }
+  }
+
+public:
+  /**
+   * @brief mitkVtkPropRendererMapperQueueTestSuite Because the RenderingTestHelper does not have an
+   * empty default constructor, we need this constructor to initialize the helper with a
+   * resolution.
+   */
+  mitkVtkPropRendererMapperQueueTestSuite() : m_RenderingTestHelper(300, 300), m_Renderer(nullptr) {}
+
+  void setUp() override
+  {
+    m_RenderingTestHelper = mitk::RenderingTestHelper(300, 300);
+    m_Renderer = dynamic_cast<mitk::VtkPropRenderer *>(
+      mitk::BaseRenderer::GetInstance(m_RenderingTestHelper.GetVtkRenderWindow()));
+    CPPUNIT_ASSERT(m_Renderer != nullptr);
+
+    for (unsigned int i = 0; i < NumberOfNodes; ++i)
+    {
+      mitk::PointSet::Pointer pointSet = mitk::PointSet::New();
+      mitk::Point3D point;
+      point.Fill(i);
+      pointSet->InsertPoint(0, point);
+
+      mitk::DataNode::Pointer node = mitk::DataNode::New();
+      node->SetData(pointSet);
+      m_Nodes.push_back(node);
+
+      // the last node also initializes the views to the bounds of all nodes
+      if (i + 1 < NumberOfNodes)
+        m_RenderingTestHelper.GetDataStorage()->Add(node);
+      else
+        m_RenderingTestHelper.AddNodeToStorage(node);
+    }
+    m_RenderingTestHelper.Render();
+  }
+
+  void tearDown() override
+  {
+    m_Nodes.clear();
+    m_Renderer = nullptr;
+  }
+
+  void QueueContainsAllNodes()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NumberOfNodes), m_Renderer->GetMappersMap().size());
+
+    // nodes of the same layer keep the order in which they were added
+    this->AssertQueueInInsertionOrder();
+
+    // also if the queue is rebuilt
+    m_RenderingTestHelper.SetMapperIDToRender3D();
+    m_RenderingTestHelper.Render();
+    m_RenderingTestHelper.SetMapperIDToRender2D();
+    m_RenderingTestHelper.Render();
+    this->AssertQueueInInsertionOrder();
+  }
+
+  void LayerChangeReordersQueue()
+  {
+    m_Nodes.front()->SetIntProperty("layer", 100);
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT(this->GetMapper(m_Nodes.front()) == this->GetLastMapperOfQueue());
+
+    // changing the value of the property does not modify the node but has to be recognized as well
+    auto layerProperty = dynamic_cast<mitk::IntProperty *>(m_Nodes.front()->GetProperty("layer"));
+    CPPUNIT_ASSERT(layerProperty != nullptr);
+    layerProperty->SetValue(-100);
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT(this->GetMapper(m_Nodes.front()) == m_Renderer->GetMappersMap().begin()->second);
+
+    // renderer-specific layers take precedence
+    m_Nodes[5]->SetIntProperty("layer", 200, m_Renderer);
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT(this->GetMapper(m_Nodes[5]) == this->GetLastMapperOfQueue());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NumberOfNodes), m_Renderer->GetMappersMap().size());
+  }
+
+  void RemovedNodesLeaveQueue()
+  {
+    // the removal is applied to the queue with the next frame
+    m_RenderingTestHelper.GetDataStorage()->Remove(m_Nodes.back());
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NumberOfNodes - 1), m_Renderer->GetMappersMap().size());
+
+    mitk::DataNode::Pointer node = mitk::DataNode::New();
+    node->SetData(mitk::PointSet::New());
+    m_RenderingTestHelper.GetDataStorage()->Add(node);
+    m_RenderingTestHelper.Render();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NumberOfNodes), m_Renderer->GetMappersMap().size());
+    CPPUNIT_ASSERT(this->GetMapper(node) == this->GetLastMapperOfQueue());
+  }
+
+  void VisibilityChangeKeepsOrder()
+  {
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+      // change one node per frame, like an interaction would do
+      m_Nodes[i]->SetVisibility(i % 2 == 0);
+      m_RenderingTestHelper.Render();
+    }
+    this->AssertQueueInInsertionOrder();
+  }
+
+  void ReplacedMapperEntersQueue()
+  {
+    auto node = m_Nodes[7];
+    auto oldMapper = this->GetMapper(node);
+    auto nodeMTime = node->GetMTime();
+
+    // setting a mapper does not modify the node but has to be recognized by the renderer
+    auto mapper = mitk::PointSetVtkMapper2D::New();
+    node->SetMapper(m_Renderer->GetMapperID(), mapper);
+    CPPUNIT_ASSERT_EQUAL(nodeMTime, node->GetMTime());
+
+    m_RenderingTestHelper.Render();
+
+    const auto &mappers = m_Renderer->GetMappersMap();
+    CPPUNIT_ASSERT(mappers.cend() == std::find_if(mappers.cbegin(), mappers.cend(), [oldMapper](const auto &entry) {
+                     return entry.second == oldMapper;
+                   }));
+    this->AssertQueueInInsertionOrder();
+    CPPUNIT_ASSERT(std::next(mappers.cbegin(), 7)->second == mapper.GetPointer());
+  }
+
+  void RenderingDoesNotCreatePropertyLists()
+  {
+    const std::string rendererName = m_Renderer->GetName();
+    for (const auto &node : m_Nodes)
+    {
+      const auto propertyListNames = node->GetPropertyListNames();
+      CPPUNIT_ASSERT(propertyListNames.cend() ==
+                     std::find(propertyListNames.cbegin(), propertyListNames.cend(), rendererName));
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkVtkPropRendererMapperQueue)
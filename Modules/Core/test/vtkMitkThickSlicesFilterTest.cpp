@@ -14,12 +14,18 @@ found in the LICENSE file.
 
 #include <vtkMitkThickSlicesFilter.h>
 
+#include "mitkExtractSliceFilter.h"
 #include "mitkImage.h"
 #include "mitkImageWriteAccessor.h"
+#include "mitkPlaneGeometry.h"
 
 #include <vtkDataArray.h>
 #include <vtkImageData.h>
 #include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cmath>
 
 class vtkMitkThickSlicesFilterTestHelper
 {
@@ -44,6 +50,24 @@ public:
     return testImage;
   }
 
+  /** Creates an image of 10x10x(max + 1 - min) float pixels, whose slices have the value 0.7 * z. */
+  static mitk::Image::Pointer CreateFloatTestImage(int min, int max)
+  {
+    mitk::PixelType pixelType(mitk::MakeScalarPixelType<float>());
+    mitk::Image::Pointer testImage = mitk::Image::New();
+    unsigned int dim[3] = {10, 10, static_cast<unsigned int>(max + 1 - min)};
+    testImage->Initialize(pixelType, 3, dim);
+
+    for (int i = min; i <= max; ++i)
+    {
+      mitk::ImageWriteAccessor writeAccess(testImage, testImage->GetSliceData(i - min));
+      auto *data = static_cast<float *>(writeAccess.GetData());
+      std::fill(data, data + dim[0] * dim[1], 0.7f * i);
+    }
+
+    return testImage;
+  }
+
   static void EvaluateResult(unsigned char expectedValue, vtkImageData *image, const char *projection)
   {
     MITK_TEST_CONDITION_REQUIRED(
@@ -56,6 +80,56 @@ public:
     MITK_INFO << "actual value: " << static_cast<double>(value[0]);
     MITK_TEST_CONDITION_REQUIRED(value[0] == expectedValue, "Resulting image has correct pixel-value");
   }
+
+  static vtkSmartPointer<vtkImageData> ResliceThickSlice(mitk::Image *image, int thickSliceMode, int slabMode, bool fused)
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(image->GetGeometry(), mitk::PlaneGeometry::Axial, 4, true, false);
+
+    auto reslicer = mitk::ExtractSliceFilter::New();
+    reslicer->SetInput(image);
+    reslicer->SetWorldGeometry(plane);
+    reslicer->SetVtkOutputRequest(true);
+    reslicer->SetOutputSpacingZDirection(1.0);
+
+    if (fused)
+    {
+      reslicer->SetSlabMode(slabMode);
+      reslicer->SetSlabNumberOfSlices(5);
+      reslicer->Update();
+      return reslicer->GetVtkOutput();
+    }
+
+    reslicer->SetOutputDimensionality(3);
+    reslicer->SetOutputExtentZDirection(-2, 2);
+    reslicer->Update();
+
+    auto thickSliceFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
+    thickSliceFilter->SetThickSliceMode(thickSliceMode);
+    thickSliceFilter->SetInputData(reslicer->GetVtkOutput());
+    thickSliceFilter->Update();
+    return thickSliceFilter->GetOutput();
+  }
+
+  template <typename TPixel>
+  static void CompareFusedSlabProjection(
+    mitk::Image *image, int thickSliceMode, int slabMode, const char *projection, double tolerance = 0.0)
+  {
+    auto twoStage = ResliceThickSlice(image, thickSliceMode, slabMode, false);
+    auto fused = ResliceThickSlice(image, thickSliceMode, slabMode, true);
+
+    MITK_TEST_CONDITION_REQUIRED(twoStage->GetNumberOfPoints() == fused->GetNumberOfPoints(),
+                                 "Fused slab projection has the same size (" << projection << ")");
+
+    auto *twoStageValues = static_cast<TPixel *>(twoStage->GetScalarPointer());
+    auto *fusedValues = static_cast<TPixel *>(fused->GetScalarPointer());
+
+    bool equal = true;
+    for (vtkIdType i = 0; i < fused->GetNumberOfPoints(); ++i)
+      equal = equal && std::abs(static_cast<double>(twoStageValues[i]) - fusedValues[i]) <= tolerance;
+
+    MITK_TEST_CONDITION(equal, "Fused slab projection equals projection of the resliced slab (" << projection << ")");
+  }
 };
 
 /**
@@ -151,5 +225,20 @@ int vtkMitkThickSlicesFilterTest(int, char *[])
 
   thickSliceFilter->Delete();
 
+  //////////////////////////////////////////////////////////////////////////
+  // Projection while reslicing
+  mitk::Image::Pointer testImage3 = vtkMitkThickSlicesFilterTestHelper::CreateTestImage(0, 8);
+  vtkMitkThickSlicesFilterTestHelper::CompareFusedSlabProjection<unsigned char>(
+    testImage3, vtkMitkThickSlicesFilter::MIP, VTK_IMAGE_SLAB_MAX, "MaxIP");
+  vtkMitkThickSlicesFilterTestHelper::CompareFusedSlabProjection<unsigned char>(
+    testImage3, vtkMitkThickSlicesFilter::MINIP, VTK_IMAGE_SLAB_MIN, "MinIP");
+
+  // the average is only projected while reslicing for floating point images, whose average is not truncated
+  mitk::Image::Pointer testImage4 = vtkMitkThickSlicesFilterTestHelper::CreateFloatTestImage(0, 8);
+  vtkMitkThickSlicesFilterTestHelper::CompareFusedSlabProjection<float>(
+    testImage4, vtkMitkThickSlicesFilter::SUM, VTK_IMAGE_SLAB_MEAN, "Sum", 1e-5);
+  vtkMitkThickSlicesFilterTestHelper::CompareFusedSlabProjection<float>(
+    testImage4, vtkMitkThickSlicesFilter::MIP, VTK_IMAGE_SLAB_MAX, "MaxIP of float image");
+
   MITK_TEST_END()
 }
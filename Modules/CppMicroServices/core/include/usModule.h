@@ -152,6 +152,25 @@ public:
    */
   static const std::string& PROP_AUTOLOADED_MODULES();
 
+  /**
+   * Returns the property key with a value of \c module.autoload_provides for
+   * looking up what an auto-load module provides.
+   * The property value is a map from service property keys, like
+   * ServiceConstants::OBJECTCLASS(), to the values of the services registered by
+   * this module. Values are either a \c std::string or a \c std::vector<Any>
+   * of strings; the value \c "*" matches any value.
+   *
+   * If lazy auto-loading is enabled, an auto-load module declaring this property
+   * in its <code>manifest.json</code> file is only loaded when a matching service
+   * is looked up.
+   *
+   * @return The auto-load provides property key.
+   *
+   * @see ModuleSettings::IsLazyAutoLoadingEnabled()
+   * @see ModuleRegistry::LoadDeferredModules()
+   */
+  static const std::string& PROP_AUTOLOAD_PROVIDES();
+
   ~Module();
 
   /**
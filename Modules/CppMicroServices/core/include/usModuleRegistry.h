@@ -74,6 +74,30 @@ public:
    */
   static std::vector<Module*> GetLoadedModules();
 
+  /**
+   * Get the locations of all auto-load modules whose loading is deferred.
+   *
+   * @return The file system locations of the deferred modules.
+   *
+   * @see ModuleSettings::IsLazyAutoLoadingEnabled()
+   */
+  static std::vector<std::string> GetDeferredModules();
+
+  /**
+   * Load the deferred auto-load modules which declare a value for a key in
+   * their Module::PROP_AUTOLOAD_PROVIDES() manifest property.
+   *
+   * Deferred modules are loaded automatically when a matching service is
+   * looked up. This method allows to load modules for other keys, e.g.
+   * the file extensions a module can handle.
+   *
+   * @param key The key to look for, keys are compared case-insensitively.
+   * @param value The value to look for. An empty value matches any value.
+   * @return The file system locations of the loaded modules.
+   */
+  static std::vector<std::string> LoadDeferredModules(const std::string& key,
+                                                      const std::string& value = std::string());
+
   static void Register(ModuleInfo* info);
 
   static void UnRegister(const ModuleInfo* info);
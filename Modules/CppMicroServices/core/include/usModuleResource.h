@@ -279,6 +279,7 @@ private:
   ModuleResource(const std::string& file, const ModuleResourceContainer& resourceContainer);
   ModuleResource(int index, const ModuleResourceContainer& resourceContainer);
 
+  friend class DeferredModules;
   friend class Module;
   friend class ModulePrivate;
   friend class ModuleResourceContainer;
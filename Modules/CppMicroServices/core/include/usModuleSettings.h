@@ -39,6 +39,8 @@ US_BEGIN_NAMESPACE
  * of the CppMicroServices library:
  *
  * - \e US_DISABLE_AUTOLOADING If set, auto-loading of modules is disabled.
+ * - \e US_ENABLE_LAZY_AUTOLOADING If set, lazy auto-loading is enabled, see
+ *   IsLazyAutoLoadingEnabled().
  * - \e US_AUTOLOAD_PATHS A ':' (Unix) or ';' (Windows) separated list of paths
  *   from which modules should be auto-loaded.
  *
@@ -97,6 +99,34 @@ public:
    */
   static void SetAutoLoadingEnabled(bool enable);
 
+  /**
+   * \return \c true if lazy auto-loading is enabled, \c false otherwise.
+   *
+   * If lazy auto-loading is enabled, auto-load modules which declare the
+   * services they provide by the Module::PROP_AUTOLOAD_PROVIDES() property in
+   * their manifest are not loaded together with the module triggering the
+   * auto-loading. They are loaded as soon as a matching service is looked up,
+   * a service listener for one of their service interfaces is added, or by
+   * ModuleRegistry::LoadDeferredModules(). The module is loaded in the thread
+   * of the look-up, which is blocked until the module is loaded. Modules
+   * without this property are always auto-loaded immediately.
+   *
+   * Lazy auto-loading is disabled by default. It is enabled by defining the
+   * US_ENABLE_LAZY_AUTOLOADING environment variable or by
+   * SetLazyAutoLoadingEnabled().
+   */
+  static bool IsLazyAutoLoadingEnabled();
+
+  /**
+   * Enable or disable lazy auto-loading. It is disabled by default.
+   *
+   * \param enable If \c true, enable lazy auto-loading, disable it otherwise.
+   *
+   * \remarks Calling this method only affects modules which are auto-loaded
+   * afterwards. Modules which are already deferred stay deferred.
+   */
+  static void SetLazyAutoLoadingEnabled(bool enable);
+
   /**
    * \return A list of paths in the file-system from which modules will be
    * auto-loaded.
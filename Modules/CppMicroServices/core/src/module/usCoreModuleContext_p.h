@@ -23,6 +23,7 @@
 #ifndef USCOREMODULECONTEXT_H
 #define USCOREMODULECONTEXT_H
 
+#include "usDeferredModules_p.h"
 #include "usServiceListeners_p.h"
 #include "usServiceRegistry_p.h"
 #include "usModuleHooks_p.h"
@@ -57,6 +58,11 @@ public:
    */
   ModuleHooks moduleHooks;
 
+  /**
+   * All auto-load modules whose loading is deferred.
+   */
+  DeferredModules deferredModules;
+
   /**
    * Contruct a core context
    *
@@ -0,0 +1,295 @@
+/*============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) German Cancer Research Center (DKFZ)
+  All rights reserved.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+============================================================================*/
+
+#include "usDeferredModules_p.h"
+
+#include "usLog_p.h"
+#include "usModule.h"
+#include "usModuleInfo.h"
+#include "usModuleManifest_p.h"
+#include "usModuleResource.h"
+#include "usModuleResourceContainer_p.h"
+#include "usModuleResourceStream.h"
+#include "usServiceProperties.h"
+#include "usSharedLibrary.h"
+#include "usUtils_p.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+
+US_BEGIN_NAMESPACE
+
+namespace {
+
+  const std::string MATCH_ANY = "*";
+
+  std::string ToLower(const std::string& str)
+  {
+    std::string lowerStr(str);
+    std::transform(lowerStr.begin(), lowerStr.end(), lowerStr.begin(), ::tolower);
+    return lowerStr;
+  }
+
+  // The embedded resources are stored below the module name, which is
+  // assumed to be the library name without platform prefix and suffix
+  std::string GetModuleName(const std::string& location)
+  {
+    const std::string prefix = SharedLibrary().GetPrefix();
+    std::string name = location.substr(location.find_last_of("/\\") + 1);
+    if (!prefix.empty() && name.compare(0, prefix.size(), prefix) == 0)
+    {
+      name.erase(0, prefix.size());
+    }
+    const std::size_t suffixPos = name.find('.');
+    if (suffixPos != std::string::npos)
+    {
+      name.erase(suffixPos);
+    }
+    return name;
+  }
+
+}
+
+DeferredModules::DeferredModules()
+{
+}
+
+bool DeferredModules::Add(const std::string& location)
+{
+  ModuleInfo info(GetModuleName(location));
+  info.location = location;
+  ModuleResourceContainer resourceContainer(&info);
+  if (!resourceContainer.IsValid())
+  {
+    return false;
+  }
+
+  ModuleResource manifestRes("/manifest.json", resourceContainer);
+  if (!manifestRes)
+  {
+    return false;
+  }
+
+  ModuleManifest manifest;
+  try
+  {
+    ModuleResourceStream manifestStream(manifestRes);
+    manifest.Parse(manifestStream);
+  }
+  catch (const std::exception& e)
+  {
+    US_WARN << "Parsing of manifest.json for module " << location << " failed: " << e.what();
+    return false;
+  }
+
+  const Any provides = manifest.GetValue(Module::PROP_AUTOLOAD_PROVIDES());
+  if (provides.Empty())
+  {
+    return false;
+  }
+
+  typedef std::map<std::string, Any> AnyMap;
+  typedef std::vector<Any> AnyVector;
+
+  if (provides.Type() != typeid(AnyMap))
+  {
+    US_WARN << "The " << Module::PROP_AUTOLOAD_PROVIDES() << " value of module " << location
+            << " must be an object, the module is not deferred.";
+    return false;
+  }
+
+  DeferredModule module;
+  module.location = location;
+
+  const AnyMap& keyValues = ref_any_cast<AnyMap>(provides);
+  for (AnyMap::const_iterator keyValue = keyValues.begin(); keyValue != keyValues.end(); ++keyValue)
+  {
+    US_UNORDERED_SET_TYPE<std::string>& values = module.provides[ToLower(keyValue->first)];
+    if (keyValue->second.Type() == typeid(std::string))
+    {
+      values.insert(ref_any_cast<std::string>(keyValue->second));
+    }
+    else if (keyValue->second.Type() == typeid(AnyVector))
+    {
+      const AnyVector& anyValues = ref_any_cast<AnyVector>(keyValue->second);
+      for (AnyVector::const_iterator value = anyValues.begin(); value != anyValues.end(); ++value)
+      {
+        if (value->Type() != typeid(std::string))
+        {
+          US_WARN << "The " << Module::PROP_AUTOLOAD_PROVIDES() << " values of module " << location
+                  << " must be strings, the module is not deferred.";
+          return false;
+        }
+        values.insert(ref_any_cast<std::string>(*value));
+      }
+    }
+    else
+    {
+      US_WARN << "The " << Module::PROP_AUTOLOAD_PROVIDES() << " values of module " << location
+              << " must be strings, the module is not deferred.";
+      return false;
+    }
+  }
+
+  if (module.provides.empty())
+  {
+    return false;
+  }
+
+  US_DEBUG << "Deferring auto-loading of module " << location;
+
+  MutexLock lock(mutex);
+  for (DeferredModuleList::const_iterator iter = modules.begin(); iter != modules.end(); ++iter)
+  {
+    if (iter->location == location) return true;
+  }
+  modules.push_back(module);
+  return true;
+}
+
+bool DeferredModules::IsEmpty() const
+{
+  MutexLock lock(mutex);
+  return modules.empty();
+}
+
+std::vector<std::string> DeferredModules::GetLocations() const
+{
+  MutexLock lock(mutex);
+  std::vector<std::string> locations;
+  for (DeferredModuleList::const_iterator module = modules.begin(); module != modules.end(); ++module)
+  {
+    locations.push_back(module->location);
+  }
+  return locations;
+}
+
+std::vector<std::string> DeferredModules::Load(const LDAPExpr::ObjectClassSet* classes,
+                                               const LDAPExpr::AttributeValueList& equalities)
+{
+  std::vector<std::string> locations;
+  {
+    MutexLock lock(mutex);
+    for (DeferredModuleList::const_iterator module = modules.begin(); module != modules.end(); ++module)
+    {
+      if (Matches(*module, classes, equalities))
+      {
+        locations.push_back(module->location);
+      }
+    }
+  }
+  return Load(locations);
+}
+
+std::vector<std::string> DeferredModules::Load(const std::string& key, const std::string& value)
+{
+  const std::string lowerKey = ToLower(key);
+  std::vector<std::string> locations;
+  {
+    MutexLock lock(mutex);
+    for (DeferredModuleList::const_iterator module = modules.begin(); module != modules.end(); ++module)
+    {
+      if (Provides(*module, lowerKey, value, false))
+      {
+        locations.push_back(module->location);
+      }
+    }
+  }
+  return Load(locations);
+}
+
+std::vector<std::string> DeferredModules::Load(const std::vector<std::string>& locations)
+{
+  // The libraries are loaded without holding the lock, because loading
+  // a module may trigger further look-ups. A module which is concurrently
+  // being loaded by another thread is still deferred and loaded again, the
+  // dynamic loader then waits until its initialization has finished.
+  std::vector<std::string> loadedModules;
+  for (std::vector<std::string>::const_iterator location = locations.begin();
+       location != locations.end(); ++location)
+  {
+    if (AutoLoadModule(*location))
+    {
+      loadedModules.push_back(*location);
+    }
+  }
+
+  MutexLock lock(mutex);
+  for (DeferredModuleList::iterator module = modules.begin(); module != modules.end(); )
+  {
+    if (std::find(locations.begin(), locations.end(), module->location) != locations.end())
+    {
+      modules.erase(module++);
+    }
+    else
+    {
+      ++module;
+    }
+  }
+  return loadedModules;
+}
+
+bool DeferredModules::Provides(const DeferredModule& module, const std::string& key,
+                               const std::string& value, bool undeclaredMatches)
+{
+  MapKeyValues::const_iterator values = module.provides.find(key);
+  if (values == module.provides.end())
+  {
+    return undeclaredMatches;
+  }
+  return value.empty() || values->second.count(value) != 0 || values->second.count(MATCH_ANY) != 0;
+}
+
+bool DeferredModules::Matches(const DeferredModule& module, const LDAPExpr::ObjectClassSet* classes,
+                              const LDAPExpr::AttributeValueList& equalities)
+{
+  // Only modules declaring their service interfaces are loaded by service look-ups
+  const std::string objectClassKey = ToLower(ServiceConstants::OBJECTCLASS());
+  if (classes == nullptr)
+  {
+    if (!Provides(module, objectClassKey, std::string(), false)) return false;
+  }
+  else
+  {
+    bool providesClass = false;
+    for (LDAPExpr::ObjectClassSet::const_iterator clazz = classes->begin();
+         !providesClass && clazz != classes->end(); ++clazz)
+    {
+      providesClass = Provides(module, objectClassKey, *clazz, false);
+    }
+    if (!providesClass) return false;
+  }
+
+  // Other properties only restrict the match if the module declares them
+  for (LDAPExpr::AttributeValueList::const_iterator equality = equalities.begin();
+       equality != equalities.end(); ++equality)
+  {
+    const std::string key = ToLower(equality->first);
+    if (key != objectClassKey && !Provides(module, key, equality->second, true))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+US_END_NAMESPACE
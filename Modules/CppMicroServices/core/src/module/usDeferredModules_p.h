@@ -0,0 +1,122 @@
+/*============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) German Cancer Research Center (DKFZ)
+  All rights reserved.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+============================================================================*/
+
+
+#ifndef USDEFERREDMODULES_P_H
+#define USDEFERREDMODULES_P_H
+
+#include "usLDAPExpr_p.h"
+#include "usThreads_p.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+US_BEGIN_NAMESPACE
+
+/**
+ * This class is not part of the public API.
+ *
+ * Auto-load modules whose loading is deferred until something they provide
+ * is requested, see Module::PROP_AUTOLOAD_PROVIDES().
+ *
+ * The manifest of a module library is read from its embedded resources,
+ * without loading the library. The module name is assumed to match the
+ * library name, otherwise the module is not deferred.
+ */
+class DeferredModules
+{
+
+public:
+
+  DeferredModules();
+
+  /**
+   * Defer the loading of a module library if its manifest declares
+   * what the module provides.
+   *
+   * @param location The file system location of the module library.
+   * @return <code>true</code> if the module is deferred, <code>false</code>
+   *         if it has to be loaded immediately.
+   */
+  bool Add(const std::string& location);
+
+  bool IsEmpty() const;
+
+  std::vector<std::string> GetLocations() const;
+
+  /**
+   * Load the deferred modules which provide services matching a service look-up.
+   *
+   * @param classes The looked-up object classes, or <code>nullptr</code> if
+   *        services of any class are looked up.
+   * @param equalities The equality terms required by the look-up filter.
+   * @return The locations of the loaded modules.
+   */
+  std::vector<std::string> Load(const LDAPExpr::ObjectClassSet* classes,
+                                const LDAPExpr::AttributeValueList& equalities);
+
+  /**
+   * Load the deferred modules which declare a value for a key.
+   *
+   * @param key The key to look for.
+   * @param value The value to look for, an empty value matches any value.
+   * @return The locations of the loaded modules.
+   */
+  std::vector<std::string> Load(const std::string& key, const std::string& value);
+
+private:
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, US_UNORDERED_SET_TYPE<std::string> > MapKeyValues;
+
+  struct DeferredModule
+  {
+    std::string location;
+
+    /** The declared values by lower case key. */
+    MapKeyValues provides;
+  };
+
+  typedef std::list<DeferredModule> DeferredModuleList;
+
+  static bool Provides(const DeferredModule& module, const std::string& key,
+                       const std::string& value, bool undeclaredMatches);
+
+  static bool Matches(const DeferredModule& module, const LDAPExpr::ObjectClassSet* classes,
+                      const LDAPExpr::AttributeValueList& equalities);
+
+  /**
+   * Load the given modules and remove them from the deferred modules.
+   */
+  std::vector<std::string> Load(const std::vector<std::string>& locations);
+
+  mutable Mutex mutex;
+  DeferredModuleList modules;
+
+  // purposely not implemented
+  DeferredModules(const DeferredModules&);
+  DeferredModules& operator=(const DeferredModules&);
+
+};
+
+US_END_NAMESPACE
+
+#endif // USDEFERREDMODULES_P_H
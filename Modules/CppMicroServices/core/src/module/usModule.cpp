@@ -78,6 +78,12 @@ const std::string&Module::PROP_AUTOLOADED_MODULES()
   return s;
 }
 
+const std::string&Module::PROP_AUTOLOAD_PROVIDES()
+{
+  static const std::string s("module.autoload_provides");
+  return s;
+}
+
 Module::Module()
 : d(nullptr)
 {
@@ -159,7 +165,7 @@ void Module::Start()
 #ifdef US_ENABLE_AUTOLOADING_SUPPORT
   if (ModuleSettings::IsAutoLoadingEnabled())
   {
-    const std::vector<std::string> loadedPaths = AutoLoadModules(d->info);
+    const std::vector<std::string> loadedPaths = AutoLoadModules(d->info, &d->coreCtx->deferredModules);
     if (!loadedPaths.empty())
     {
       d->moduleManifest.SetValue(PROP_AUTOLOADED_MODULES(), Any(loadedPaths));
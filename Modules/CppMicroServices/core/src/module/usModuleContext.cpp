@@ -128,6 +128,8 @@ void ModuleContext::AddServiceListener(const ServiceListener& delegate,
                                        const std::string& filter)
 {
   d->module->coreCtx->listeners.AddServiceListener(this, delegate, nullptr, filter);
+  // the listener is added first, so that it is notified about the services of the loaded modules
+  d->module->coreCtx->services.LoadDeferredModulesForListener(filter);
 }
 
 void ModuleContext::RemoveServiceListener(const ServiceListener& delegate)
@@ -149,6 +151,8 @@ void ModuleContext::AddServiceListener(const ServiceListener& delegate, void* da
                                        const std::string &filter)
 {
   d->module->coreCtx->listeners.AddServiceListener(this, delegate, data, filter);
+  // the listener is added first, so that it is notified about the services of the loaded modules
+  d->module->coreCtx->services.LoadDeferredModulesForListener(filter);
 }
 
 void ModuleContext::RemoveServiceListener(const ServiceListener& delegate, void* data)
@@ -202,6 +202,16 @@ std::vector<Module*> ModuleRegistry::GetLoadedModules()
   return result;
 }
 
+std::vector<std::string> ModuleRegistry::GetDeferredModules()
+{
+  return coreModuleContext()->deferredModules.GetLocations();
+}
+
+std::vector<std::string> ModuleRegistry::LoadDeferredModules(const std::string& key, const std::string& value)
+{
+  return coreModuleContext()->deferredModules.Load(key, value);
+}
+
 // Control the static initialization order for several core objects
 struct StaticInitializationOrder
 {
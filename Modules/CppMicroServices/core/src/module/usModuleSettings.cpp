@@ -67,6 +67,7 @@ struct ModuleSettingsPrivate : public MultiThreaded<>
     , autoLoadingEnabled(false)
   #endif
     , autoLoadingDisabled(false)
+    , lazyAutoLoadingEnabled(false)
     , logLevel(DebugMsg)
   {
     autoLoadPaths.insert(ModuleSettings::CURRENT_MODULE_PATH());
@@ -95,12 +96,18 @@ struct ModuleSettingsPrivate : public MultiThreaded<>
     {
       autoLoadingDisabled = true;
     }
+
+    if (getenv("US_ENABLE_LAZY_AUTOLOADING"))
+    {
+      lazyAutoLoadingEnabled = true;
+    }
   }
 
   std::set<std::string> autoLoadPaths;
   std::set<std::string> extraPaths;
   bool autoLoadingEnabled;
   bool autoLoadingDisabled;
+  bool lazyAutoLoadingEnabled;
   std::string storagePath;
   MsgType logLevel;
 };
@@ -133,6 +140,18 @@ void ModuleSettings::SetAutoLoadingEnabled(bool enable)
   moduleSettingsPrivate()->autoLoadingEnabled = enable;
 }
 
+bool ModuleSettings::IsLazyAutoLoadingEnabled()
+{
+  US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
+  return moduleSettingsPrivate()->lazyAutoLoadingEnabled;
+}
+
+void ModuleSettings::SetLazyAutoLoadingEnabled(bool enable)
+{
+  US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
+  moduleSettingsPrivate()->lazyAutoLoadingEnabled = enable;
+}
+
 ModuleSettings::PathList ModuleSettings::GetAutoLoadPaths()
 {
   US_UNUSED(ModuleSettingsPrivate::Lock(moduleSettingsPrivate()));
@@ -199,27 +199,19 @@ bool LDAPExpr::GetMatchedObjectClasses(ObjectClassSet& objClasses) const
         {
           // if AND op and classes in several operands,
           // then only the intersection is possible.
-          LDAPExpr::ObjectClassSet::iterator it1 = objClasses.begin();
-          LDAPExpr::ObjectClassSet::iterator it2 = r.begin();
-          while ( (it1 != objClasses.end()) && (it2 != r.end()) )
+          // The sets are not ordered, so look up every class.
+          for (LDAPExpr::ObjectClassSet::iterator it = objClasses.begin();
+               it != objClasses.end(); )
           {
-            if (*it1 < *it2)
+            if (r.count(*it) == 0)
             {
-              objClasses.erase(it1++);
-            }
-            else if (*it2 < *it1)
-            {
-              ++it2;
+              objClasses.erase(it++);
             }
             else
-            { // *it1 == *it2
-              ++it1;
-              ++it2;
+            {
+              ++it;
             }
           }
-          // Anything left in set_1 from here on did not appear in set_2,
-          // so we remove it.
-          objClasses.erase(it1, objClasses.end());
         }
       }
     }
@@ -245,6 +237,32 @@ bool LDAPExpr::GetMatchedObjectClasses(ObjectClassSet& objClasses) const
   return false;
 }
 
+bool LDAPExpr::GetRequiredEqualities(AttributeValueList& equalities) const
+{
+  if (d->m_operator == EQ)
+  {
+    if (d->m_attrValue.find(LDAPExprConstants::WILDCARD()) == std::string::npos)
+    {
+      equalities.push_back(std::make_pair(d->m_attrName, d->m_attrValue));
+      return true;
+    }
+    return false;
+  }
+  else if (d->m_operator == AND)
+  {
+    bool result = false;
+    for (std::size_t i = 0; i < d->m_args.size(); i++)
+    {
+      if (d->m_args[i].GetRequiredEqualities(equalities))
+      {
+        result = true;
+      }
+    }
+    return result;
+  }
+  return false;
+}
+
 std::string LDAPExpr::ToLower(const std::string& str)
 {
   std::string lowerStr(str);
@@ -0,0 +1,92 @@
+/*============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) German Cancer Research Center (DKFZ)
+  All rights reserved.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+============================================================================*/
+
+#include "usLDAPExprCache_p.h"
+
+#include "usServiceProperties.h"
+
+#include <algorithm>
+#include <cctype>
+
+US_BEGIN_NAMESPACE
+
+LDAPExprCache::CompiledExpr::CompiledExpr(const std::string& filter)
+  : ldapExpr(filter)
+  , hasObjectClasses(false)
+{
+  hasObjectClasses = ldapExpr.GetMatchedObjectClasses(objectClasses);
+
+  ldapExpr.GetRequiredEqualities(equalities);
+  for (LDAPExpr::AttributeValueList::const_iterator iter = equalities.begin();
+       iter != equalities.end(); ++iter)
+  {
+    std::string key = iter->first;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    if (key != ServiceConstants::OBJECTCLASS())
+    {
+      indexKey = iter->first;
+      indexValue = iter->second;
+      break;
+    }
+  }
+}
+
+LDAPExprCache::LDAPExprCache(std::size_t maxSize)
+  : maxSize(maxSize)
+{
+}
+
+LDAPExprCache::CompiledExprPointer LDAPExprCache::Get(const std::string& filter)
+{
+  {
+    MutexLock lock(mutex);
+    MapFilterExpr::const_iterator iter = cache.find(filter);
+    if (iter != cache.end())
+    {
+      return iter->second;
+    }
+  }
+
+  // Parse without holding the lock, invalid filters throw and are not cached
+  CompiledExprPointer expr(new CompiledExpr(filter));
+
+  MutexLock lock(mutex);
+  if (cache.size() >= maxSize)
+  {
+    cache.clear();
+  }
+  // Another thread may have inserted the filter in the meantime, keep the first one
+  return cache.insert(std::make_pair(filter, expr)).first->second;
+}
+
+void LDAPExprCache::Clear()
+{
+  MutexLock lock(mutex);
+  cache.clear();
+}
+
+std::size_t LDAPExprCache::Size() const
+{
+  MutexLock lock(mutex);
+  return cache.size();
+}
+
+US_END_NAMESPACE
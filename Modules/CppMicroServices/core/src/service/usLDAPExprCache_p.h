@@ -0,0 +1,112 @@
+/*============================================================================
+
+  Library: CppMicroServices
+
+  Copyright (c) German Cancer Research Center (DKFZ)
+  All rights reserved.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+============================================================================*/
+
+
+#ifndef USLDAPEXPRCACHE_H
+#define USLDAPEXPRCACHE_H
+
+#include "usLDAPExpr_p.h"
+
+#include "usThreads_p.h"
+
+#include <string>
+
+US_BEGIN_NAMESPACE
+
+/**
+ * This class is not part of the public API.
+ *
+ * A thread-safe cache of parsed LDAP filters, keyed by the filter string.
+ * Together with the expression, the parts of the filter which can be
+ * answered by a lookup are extracted once: the matched object classes and
+ * an equality term on another property.
+ *
+ * The number of cached filters is limited. If the limit is reached, the
+ * cache is cleared, so filters containing e.g. service ids do not let it grow
+ * without bounds.
+ */
+class LDAPExprCache
+{
+
+public:
+
+  class CompiledExpr : public SharedData
+  {
+  public:
+
+    CompiledExpr(const std::string& filter);
+
+    LDAPExpr ldapExpr;
+
+    /**
+     * <code>true</code> if the matched object classes can be determined,
+     * see LDAPExpr::GetMatchedObjectClasses.
+     */
+    bool hasObjectClasses;
+    LDAPExpr::ObjectClassSet objectClasses;
+
+    /**
+     * The equality terms required by the filter, see LDAPExpr::GetRequiredEqualities.
+     */
+    LDAPExpr::AttributeValueList equalities;
+
+    /**
+     * The first required equality term, which does not test the object class.
+     * indexKey is empty if there is no such term.
+     */
+    std::string indexKey;
+    std::string indexValue;
+  };
+
+  typedef ExplicitlySharedDataPointer<const CompiledExpr> CompiledExprPointer;
+
+  LDAPExprCache(std::size_t maxSize = 1024);
+
+  /**
+   * Get the compiled filter, parsing it if it is not cached yet.
+   *
+   * @param filter The LDAP filter string, must not be empty.
+   * @return The compiled filter, which must not be modified.
+   * @exception std::invalid_argument If the filter is not a correct LDAP expression.
+   */
+  CompiledExprPointer Get(const std::string& filter);
+
+  void Clear();
+
+  std::size_t Size() const;
+
+private:
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, CompiledExprPointer> MapFilterExpr;
+
+  mutable Mutex mutex;
+  MapFilterExpr cache;
+  std::size_t maxSize;
+
+  // purposely not implemented
+  LDAPExprCache(const LDAPExprCache&);
+  LDAPExprCache& operator=(const LDAPExprCache&);
+
+};
+
+US_END_NAMESPACE
+
+#endif // USLDAPEXPRCACHE_H
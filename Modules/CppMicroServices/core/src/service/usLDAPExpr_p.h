@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 
 US_BEGIN_NAMESPACE
 
@@ -57,6 +58,7 @@ public:
   typedef std::vector<std::string> StringList;
   typedef std::vector<StringList> LocalCache;
   typedef US_UNORDERED_SET_TYPE<std::string> ObjectClassSet;
+  typedef std::vector<std::pair<std::string, std::string> > AttributeValueList;
 
 
   /**
@@ -83,6 +85,16 @@ public:
    */
   bool GetMatchedObjectClasses(ObjectClassSet& objClasses) const;
 
+  /**
+   * Get the equality terms without wildcards, which every matching set of
+   * properties has to satisfy. These are the expression itself, if it is
+   * such a term, or the terms among the operands of an AND expression.
+   *
+   * \param equalities The attribute name and value pairs will be added to equalities.
+   * \return <code>true</code> if at least one term was found, <code>false</code> otherwise.
+   */
+  bool GetRequiredEqualities(AttributeValueList& equalities) const;
+
   /**
    * Checks if this LDAP expression is "simple". The definition of
    * a simple filter is:
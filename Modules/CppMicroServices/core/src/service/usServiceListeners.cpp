@@ -224,9 +224,28 @@ void ServiceListeners::GetMatchingServiceListeners(const ServiceEvent& evt, Serv
   //US_DEBUG << "Added " << set.size() << " out of " << n
   //         << " listeners with complicated filters";
 
-  // Check the cache
   const std::vector<std::string> c(any_cast<std::vector<std::string> >
                                  (evt.GetServiceReference().d->GetProperty(ServiceConstants::OBJECTCLASS(), lockProps)));
+
+  // Check complicated listener filters for the object classes of the service
+  for (std::vector<std::string>::const_iterator objClass = c.begin();
+       objClass != c.end(); ++objClass)
+  {
+    CacheType::const_iterator l = objectClassListeners.find(*objClass);
+    if (l == objectClassListeners.end()) continue;
+
+    for (std::list<ServiceListenerEntry>::const_iterator sse = l->second.begin();
+         sse != l->second.end(); ++sse)
+    {
+      if (receivers.count(*sse) == 0 || set.count(*sse) != 0) continue;
+      if (sse->GetLDAPExpr().Evaluate(evt.GetServiceReference().d->GetProperties(), false))
+      {
+        set.insert(*sse);
+      }
+    }
+  }
+
+  // Check the cache
   for (std::vector<std::string>::const_iterator objClass = c.begin();
        objClass != c.end(); ++objClass)
   {
@@ -274,10 +293,35 @@ void ServiceListeners::RemoveFromCache(const ServiceListenerEntry& sle)
   }
   else
   {
-    complicatedListeners.remove(sle);
+    LDAPExpr::ObjectClassSet objectClasses;
+    if (GetMatchedObjectClasses(sle, objectClasses))
+    {
+      for (LDAPExpr::ObjectClassSet::const_iterator objClass = objectClasses.begin();
+           objClass != objectClasses.end(); ++objClass)
+      {
+        CacheType::iterator l = objectClassListeners.find(*objClass);
+        if (l == objectClassListeners.end()) continue;
+
+        l->second.remove(sle);
+        if (l->second.empty())
+        {
+          objectClassListeners.erase(l);
+        }
+      }
+    }
+    else
+    {
+      complicatedListeners.remove(sle);
+    }
   }
 }
 
+bool ServiceListeners::GetMatchedObjectClasses(const ServiceListenerEntry& sle,
+                                               LDAPExpr::ObjectClassSet& objectClasses)
+{
+  return !sle.GetLDAPExpr().IsNull() && sle.GetLDAPExpr().GetMatchedObjectClasses(objectClasses);
+}
+
  void ServiceListeners::CheckSimple(const ServiceListenerEntry& sle) {
    if (sle.GetLDAPExpr().IsNull())
    {
@@ -302,7 +346,19 @@ void ServiceListeners::RemoveFromCache(const ServiceListenerEntry& sle)
      else
      {
        //US_DEBUG << "Too complicated filter: " << sle.GetFilter();
-       complicatedListeners.push_back(sle);
+       LDAPExpr::ObjectClassSet objectClasses;
+       if (GetMatchedObjectClasses(sle, objectClasses))
+       {
+         for (LDAPExpr::ObjectClassSet::const_iterator objClass = objectClasses.begin();
+              objClass != objectClasses.end(); ++objClass)
+         {
+           objectClassListeners[*objClass].push_back(sle);
+         }
+       }
+       else
+       {
+         complicatedListeners.push_back(sle);
+       }
      }
    }
  }
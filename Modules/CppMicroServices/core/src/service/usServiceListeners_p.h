@@ -62,6 +62,11 @@ private:
   /* Service listeners with complicated or empty filters */
   std::list<ServiceListenerEntry> complicatedListeners;
 
+  /* Service listeners with complicated filters, which determine the matched
+   * object classes, by object class. They are only evaluated for services
+   * of these classes. */
+  CacheType objectClassListeners;
+
   /* Service listeners with "simple" filters are cached. */
   CacheType cache[2];
 
@@ -174,6 +179,12 @@ private:
 
   void AddToSet(ServiceListenerEntries& set, const ServiceListenerEntries& receivers, int cache_ix, const std::string& val);
 
+  /**
+   * Get the object classes of a complicated listener filter,
+   * see LDAPExpr::GetMatchedObjectClasses.
+   */
+  static bool GetMatchedObjectClasses(const ServiceListenerEntry& sle, LDAPExpr::ObjectClassSet& objectClasses);
+
 };
 
 US_END_NAMESPACE
@@ -20,6 +20,7 @@
 ============================================================================*/
 
 #include <iterator>
+#include <list>
 #include <stdexcept>
 #include <cassert>
 
@@ -30,10 +31,21 @@
 #include "usServiceRegistrationBasePrivate.h"
 #include "usModulePrivate.h"
 #include "usCoreModuleContext_p.h"
+#include "usServicePropertiesImpl_p.h"
 
 
 US_BEGIN_NAMESPACE
 
+namespace {
+
+/**
+ * Filtered queries over at least this number of services of a class
+ * use a property index.
+ */
+const std::size_t MIN_INDEXED_SERVICES = 16;
+
+}
+
 ServicePropertiesImpl ServiceRegistry::CreateServiceProperties(const ServiceProperties& in,
                                                                const std::vector<std::string>& classes,
                                                                bool isFactory, bool isPrototypeFactory,
@@ -81,6 +93,8 @@ void ServiceRegistry::Clear()
   services.clear();
   serviceRegistrations.clear();
   classServices.clear();
+  propertyIndices.clear();
+  filterCache.Clear();
   core = nullptr;
 }
 
@@ -123,6 +137,7 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
           std::lower_bound(s.begin(), s.end(), res);
       s.insert(ip, res);
     }
+    InvalidatePropertyIndices_unlocked(classes);
   }
 
   ServiceReferenceBase r = res.GetReference(std::string());
@@ -145,6 +160,82 @@ void ServiceRegistry::UpdateServiceRegistrationOrder(const ServiceRegistrationBa
     s.erase(std::remove(s.begin(), s.end(), sr), s.end());
     s.insert(std::lower_bound(s.begin(), s.end(), sr), sr);
   }
+  InvalidatePropertyIndices_unlocked(classes);
+}
+
+void ServiceRegistry::InvalidatePropertyIndices(const std::vector<std::string>& classes)
+{
+  MutexLock lock(mutex);
+  InvalidatePropertyIndices_unlocked(classes);
+}
+
+void ServiceRegistry::InvalidatePropertyIndices_unlocked(const std::vector<std::string>& classes)
+{
+  if (propertyIndices.empty()) return;
+
+  // the index of all services, see Get_unlocked
+  propertyIndices.erase(std::string());
+  for (std::vector<std::string>::const_iterator i = classes.begin();
+       i != classes.end(); ++i)
+  {
+    propertyIndices.erase(*i);
+  }
+}
+
+const ServiceRegistry::PropertyIndex& ServiceRegistry::GetPropertyIndex_unlocked(
+    const std::string& clazz, const std::string& key,
+    const std::vector<ServiceRegistrationBase>& serviceRegs) const
+{
+  MapKeyIndex& indices = propertyIndices[clazz];
+  MapKeyIndex::const_iterator iter = indices.find(key);
+  if (iter != indices.end())
+  {
+    return iter->second;
+  }
+
+  PropertyIndex& index = indices[key];
+  for (std::size_t pos = 0; pos < serviceRegs.size(); ++pos)
+  {
+    // look up the key like LDAPExpr::Evaluate does
+    const ServicePropertiesImpl& props = serviceRegs[pos].d->properties;
+    int i = props.FindCaseSensitive(key);
+    if (i < 0) i = props.Find(key);
+    if (i < 0)
+    {
+      // the service cannot match an equality term on this key
+      continue;
+    }
+
+    const Any& value = props.Value(i);
+    if (value.Type() == typeid(std::string))
+    {
+      index.positions[ref_any_cast<std::string>(value)].push_back(pos);
+    }
+    else if (value.Type() == typeid(std::vector<std::string>))
+    {
+      const std::vector<std::string>& list = ref_any_cast<std::vector<std::string> >(value);
+      for (std::vector<std::string>::const_iterator it = list.begin(); it != list.end(); ++it)
+      {
+        std::vector<std::size_t>& positions = index.positions[*it];
+        if (positions.empty() || positions.back() != pos) positions.push_back(pos);
+      }
+    }
+    else if (value.Type() == typeid(std::list<std::string>))
+    {
+      const std::list<std::string>& list = ref_any_cast<std::list<std::string> >(value);
+      for (std::list<std::string>::const_iterator it = list.begin(); it != list.end(); ++it)
+      {
+        std::vector<std::size_t>& positions = index.positions[*it];
+        if (positions.empty() || positions.back() != pos) positions.push_back(pos);
+      }
+    }
+    else
+    {
+      // numbers etc. are compared by LDAPExpr after a conversion of the filter value
+      index.unindexed.push_back(pos);
+    }
+  }
+  return index;
 }
 
 void ServiceRegistry::Get(const std::string& clazz,
@@ -166,6 +257,8 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz,
 
 ServiceReferenceBase ServiceRegistry::Get(ModulePrivate* module, const std::string& clazz) const
 {
+  LoadDeferredModules(clazz, std::string());
+
   MutexLock lock(mutex);
   try
   {
@@ -188,55 +281,98 @@ ServiceReferenceBase ServiceRegistry::Get(ModulePrivate* module, const std::stri
 void ServiceRegistry::Get(const std::string& clazz, const std::string& filter,
                           ModulePrivate* module, std::vector<ServiceReferenceBase>& res) const
 {
+  LoadDeferredModules(clazz, filter);
+
   MutexLock lock(mutex);
   Get_unlocked(clazz, filter, module, res);
 }
 
+void ServiceRegistry::LoadDeferredModules(const std::string& clazz, const std::string& filter) const
+{
+  if (core->deferredModules.IsEmpty()) return;
+
+  LDAPExprCache::CompiledExprPointer compiled;
+  if (!filter.empty())
+  {
+    compiled = filterCache.Get(filter);
+  }
+
+  LDAPExpr::ObjectClassSet classes;
+  const LDAPExpr::ObjectClassSet* lookupClasses = &classes;
+  if (!clazz.empty())
+  {
+    classes.insert(clazz);
+  }
+  else if (compiled && compiled->hasObjectClasses)
+  {
+    lookupClasses = &compiled->objectClasses;
+  }
+  else
+  {
+    // services of any class are looked up
+    lookupClasses = nullptr;
+  }
+
+  core->deferredModules.Load(lookupClasses, compiled ? compiled->equalities : LDAPExpr::AttributeValueList());
+}
+
+void ServiceRegistry::LoadDeferredModulesForListener(const std::string& filter) const
+{
+  if (filter.empty() || core->deferredModules.IsEmpty()) return;
+
+  // listeners for services of any class must not load all deferred modules
+  LDAPExprCache::CompiledExprPointer compiled = filterCache.Get(filter);
+  if (!compiled || !compiled->hasObjectClasses) return;
+
+  core->deferredModules.Load(&compiled->objectClasses, compiled->equalities);
+}
+
 void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string& filter,
                           ModulePrivate* module, std::vector<ServiceReferenceBase>& res) const
 {
-  std::vector<ServiceRegistrationBase>::const_iterator s;
-  std::vector<ServiceRegistrationBase>::const_iterator send;
+  const std::vector<ServiceRegistrationBase>* candidates = &serviceRegistrations;
   std::vector<ServiceRegistrationBase> v;
-  LDAPExpr ldap;
+  // The class of the candidates, if they are the services of a single class,
+  // or the empty class name for all services
+  const std::string* candidateClass = &clazz;
+  LDAPExprCache::CompiledExprPointer compiled;
   if (clazz.empty())
   {
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
-      LDAPExpr::ObjectClassSet matched;
-      if (ldap.GetMatchedObjectClasses(matched))
+      compiled = filterCache.Get(filter);
+      if (compiled->hasObjectClasses)
       {
-        v.clear();
-        for(LDAPExpr::ObjectClassSet::const_iterator className = matched.begin();
-            className != matched.end(); ++className)
+        const LDAPExpr::ObjectClassSet& matched = compiled->objectClasses;
+        if (matched.size() == 1)
         {
-          MapClassServices::const_iterator i = classServices.find(*className);
-          if (i != classServices.end())
+          MapClassServices::const_iterator i = classServices.find(*matched.begin());
+          if (i == classServices.end())
           {
-            std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
+            return;
           }
-        }
-        if (!v.empty())
-        {
-          s = v.begin();
-          send = v.end();
+          candidates = &i->second;
+          candidateClass = &i->first;
         }
         else
         {
-          return;
+          for(LDAPExpr::ObjectClassSet::const_iterator className = matched.begin();
+              className != matched.end(); ++className)
+          {
+            MapClassServices::const_iterator i = classServices.find(*className);
+            if (i != classServices.end())
+            {
+              std::copy(i->second.begin(), i->second.end(), std::back_inserter(v));
+            }
+          }
+          if (v.empty())
+          {
+            return;
+          }
+          candidates = &v;
+          candidateClass = nullptr;
         }
       }
-      else
-      {
-        s = serviceRegistrations.begin();
-        send = serviceRegistrations.end();
-      }
-    }
-    else
-    {
-      s = serviceRegistrations.begin();
-      send = serviceRegistrations.end();
     }
   }
   else
@@ -244,8 +380,8 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     MapClassServices::const_iterator it = classServices.find(clazz);
     if (it != classServices.end())
     {
-      s = it->second.begin();
-      send = it->second.end();
+      candidates = &it->second;
+      candidateClass = &it->first;
     }
     else
     {
@@ -253,17 +389,59 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     }
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      compiled = filterCache.Get(filter);
     }
   }
 
-  for (; s != send; ++s)
+  if (!compiled)
   {
-    ServiceReferenceBase sri = s->GetReference(clazz);
+    for (std::vector<ServiceRegistrationBase>::const_iterator s = candidates->begin();
+         s != candidates->end(); ++s)
+    {
+      res.push_back(s->GetReference(clazz));
+    }
+  }
+  else if (candidateClass != nullptr && !compiled->indexKey.empty() &&
+           candidates->size() >= MIN_INDEXED_SERVICES)
+  {
+    // Only the services with the value of the equality term, or a value
+    // which cannot be indexed, have to be evaluated
+    const PropertyIndex& index = GetPropertyIndex_unlocked(*candidateClass, compiled->indexKey, *candidates);
+    PropertyIndex::MapValuePositions::const_iterator matched = index.positions.find(compiled->indexValue);
+
+    std::vector<std::size_t> positions;
+    if (matched != index.positions.end())
+    {
+      positions = matched->second;
+    }
+    if (!index.unindexed.empty())
+    {
+      // keep the ranking order of the candidates
+      std::vector<std::size_t> indexedPositions;
+      indexedPositions.swap(positions);
+      std::merge(indexedPositions.begin(), indexedPositions.end(),
+                 index.unindexed.begin(), index.unindexed.end(), std::back_inserter(positions));
+    }
 
-    if (filter.empty() || ldap.Evaluate(s->d->properties, false))
+    for (std::vector<std::size_t>::const_iterator pos = positions.begin();
+         pos != positions.end(); ++pos)
     {
-      res.push_back(sri);
+      const ServiceRegistrationBase& s = (*candidates)[*pos];
+      if (compiled->ldapExpr.Evaluate(s.d->properties, false))
+      {
+        res.push_back(s.GetReference(clazz));
+      }
+    }
+  }
+  else
+  {
+    for (std::vector<ServiceRegistrationBase>::const_iterator s = candidates->begin();
+         s != candidates->end(); ++s)
+    {
+      if (compiled->ldapExpr.Evaluate(s->d->properties, false))
+      {
+        res.push_back(s->GetReference(clazz));
+      }
     }
   }
 
@@ -290,6 +468,7 @@ void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& s
   services.erase(sr);
   serviceRegistrations.erase(std::remove(serviceRegistrations.begin(), serviceRegistrations.end(), sr),
                              serviceRegistrations.end());
+  InvalidatePropertyIndices_unlocked(classes);
   for (std::vector<std::string>::const_iterator i = classes.begin();
        i != classes.end(); ++i)
   {
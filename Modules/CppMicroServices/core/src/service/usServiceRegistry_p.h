@@ -26,6 +26,7 @@
 #include "usServiceInterface.h"
 #include "usServiceRegistration.h"
 
+#include "usLDAPExprCache_p.h"
 #include "usThreads_p.h"
 
 US_BEGIN_NAMESPACE
@@ -116,6 +117,14 @@ public:
   void UpdateServiceRegistrationOrder(const ServiceRegistrationBase& sr,
                                       const std::vector<std::string>& classes);
 
+  /**
+   * Service properties changed, discard the property indices
+   * of the classes of the service.
+   *
+   * @param classes The class names under which the service is registered.
+   */
+  void InvalidatePropertyIndices(const std::vector<std::string>& classes);
+
   /**
    * Get all services implementing a certain class.
    * Only used internally by the framework.
@@ -146,6 +155,15 @@ public:
   void Get(const std::string& clazz, const std::string& filter,
            ModulePrivate* module, std::vector<ServiceReferenceBase>& serviceRefs) const;
 
+  /**
+   * Load the deferred auto-load modules providing services of the object
+   * classes a service listener is registered for. Filters without an
+   * object class do not load any module.
+   *
+   * @param filter The filter of the service listener.
+   */
+  void LoadDeferredModulesForListener(const std::string& filter) const;
+
   /**
    * Remove a registered service.
    *
@@ -173,6 +191,52 @@ private:
 
   friend class ServiceHooks;
 
+  /**
+   * Index of the registered services of a class by the values of one
+   * property. Services are referred to by their position in the
+   * ranked list of the class in classServices, or in serviceRegistrations
+   * for the index of all services stored with an empty class name.
+   */
+  struct PropertyIndex
+  {
+    typedef US_UNORDERED_MAP_TYPE<std::string, std::vector<std::size_t> > MapValuePositions;
+
+    /** Positions of the services having a string value, or a list containing it. */
+    MapValuePositions positions;
+
+    /** Positions of the services having a value of another type, they are always evaluated. */
+    std::vector<std::size_t> unindexed;
+  };
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, PropertyIndex> MapKeyIndex;
+  typedef US_UNORDERED_MAP_TYPE<std::string, MapKeyIndex> MapClassIndices;
+
+  /**
+   * Parsed filters of former queries.
+   */
+  mutable LDAPExprCache filterCache;
+
+  /**
+   * Property indices by class name and property key. They are built on
+   * demand by filtered queries and discarded on any change to the
+   * services of the class.
+   */
+  mutable MapClassIndices propertyIndices;
+
+  const PropertyIndex& GetPropertyIndex_unlocked(const std::string& clazz, const std::string& key,
+                                                 const std::vector<ServiceRegistrationBase>& serviceRegs) const;
+
+  void InvalidatePropertyIndices_unlocked(const std::vector<std::string>& classes);
+
+  /**
+   * Load the deferred auto-load modules providing services for a look-up.
+   * Must not be called while holding the registry lock, because the loaded
+   * modules register their services.
+   *
+   * @exception std::invalid_argument If the filter is not a correct LDAP expression.
+   */
+  void LoadDeferredModules(const std::string& clazz, const std::string& filter) const;
+
   void Get_unlocked(const std::string& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
   void Get_unlocked(const std::string& clazz, const std::string& filter,
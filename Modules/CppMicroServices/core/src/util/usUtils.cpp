@@ -21,6 +21,7 @@
 
 #include "usUtils_p.h"
 
+#include "usDeferredModules_p.h"
 #include "usLog_p.h"
 #include "usModuleInfo.h"
 #include "usModuleSettings.h"
@@ -106,7 +107,20 @@ bool load_impl(const std::string&) { return false; }
 
 US_BEGIN_NAMESPACE
 
-std::vector<std::string> AutoLoadModulesFromPath(const std::string& absoluteBasePath, const std::string& subDir)
+bool AutoLoadModule(const std::string& modulePath)
+{
+  US_DEBUG << "Auto-loading module " << modulePath;
+
+  if (!load_impl(modulePath))
+  {
+    US_WARN << "Auto-loading of module " << modulePath << " failed.";
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> AutoLoadModulesFromPath(const std::string& absoluteBasePath, const std::string& subDir,
+                                                 DeferredModules* deferredModules)
 {
   std::vector<std::string> loadedModules;
 
@@ -169,13 +183,13 @@ std::vector<std::string> AutoLoadModulesFromPath(const std::string& absoluteBase
         libPath += DIR_SEP;
       }
       libPath += entryFileName;
-      US_DEBUG << "Auto-loading module " << libPath;
 
-      if (!load_impl(libPath))
+      if (deferredModules != nullptr && deferredModules->Add(libPath))
       {
-        US_WARN << "Auto-loading of module " << libPath << " failed.";
+        continue;
       }
-      else
+
+      if (AutoLoadModule(libPath))
       {
         loadedModules.push_back(libPath);
       }
@@ -185,7 +199,7 @@ std::vector<std::string> AutoLoadModulesFromPath(const std::string& absoluteBase
   return loadedModules;
 }
 
-std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo)
+std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo, DeferredModules* deferredModules)
 {
   std::vector<std::string> loadedModules;
 
@@ -195,6 +209,10 @@ std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo)
   }
 
   ModuleSettings::PathList autoLoadPaths = ModuleSettings::GetAutoLoadPaths();
+  if (!ModuleSettings::IsLazyAutoLoadingEnabled())
+  {
+    deferredModules = nullptr;
+  }
 
   std::size_t indexOfLastSeparator = moduleInfo.location.find_last_of(DIR_SEP);
   std::string moduleBasePath = moduleInfo.location.substr(0, indexOfLastSeparator);
@@ -217,7 +235,7 @@ std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo)
        i != autoLoadPaths.end(); ++i)
   {
     if (i->empty()) continue;
-    std::vector<std::string> paths = AutoLoadModulesFromPath(*i, moduleInfo.autoLoadDir);
+    std::vector<std::string> paths = AutoLoadModulesFromPath(*i, moduleInfo.autoLoadDir, deferredModules);
     loadedModules.insert(loadedModules.end(), paths.begin(), paths.end());
   }
   return loadedModules;
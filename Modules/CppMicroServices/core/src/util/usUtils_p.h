@@ -35,8 +35,18 @@
 US_BEGIN_NAMESPACE
 
 struct ModuleInfo;
-
-std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo);
+class DeferredModules;
+
+/**
+ * Auto-load the modules of a module. If lazy auto-loading is enabled and
+ * <code>deferredModules</code> is not null, modules declaring what they
+ * provide are added to <code>deferredModules</code> instead.
+ *
+ * @return The locations of the loaded modules.
+ */
+std::vector<std::string> AutoLoadModules(const ModuleInfo& moduleInfo, DeferredModules* deferredModules);
+
+bool AutoLoadModule(const std::string& modulePath);
 
 US_END_NAMESPACE
 
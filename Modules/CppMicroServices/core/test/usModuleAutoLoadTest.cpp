@@ -156,6 +156,81 @@ void testCustomAutoLoadPath()
   mc->RemoveModuleListener(&listener, &TestModuleListener::ModuleChanged);
 }
 
+void testLazyAutoLoad()
+{
+  ModuleContext* mc = GetModuleContext();
+  assert(mc);
+
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetDeferredModules().empty(), "Test for no deferred modules")
+
+  // lazy auto-loading is opt-in
+  US_TEST_CONDITION_REQUIRED(!ModuleSettings::IsLazyAutoLoadingEnabled(), "Test for disabled lazy auto-loading")
+  ModuleSettings::SetLazyAutoLoadingEnabled(true);
+
+  SharedLibrary libAL3(LIB_PATH, "TestModuleAL3");
+
+  try
+  {
+    libAL3.Load();
+  }
+  catch (const std::exception& e)
+  {
+    US_TEST_FAILED_MSG(<< "Load module exception: " << e.what())
+  }
+
+  Module* moduleAL3 = ModuleRegistry::GetModule("TestModuleAL3");
+  US_TEST_CONDITION_REQUIRED(moduleAL3 != nullptr, "Test for existing module TestModuleAL3")
+  US_TEST_CONDITION(moduleAL3->GetProperty(Module::PROP_AUTOLOADED_MODULES()).Empty(), "Test for empty PROP_AUTOLOADED_MODULES property")
+
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetModule("TestModuleAL3_1") == nullptr, "Test for deferred module TestModuleAL3_1")
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetModule("TestModuleAL3_2") == nullptr, "Test for deferred module TestModuleAL3_2")
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetModule("TestModuleAL3_3") == nullptr, "Test for deferred module TestModuleAL3_3")
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetDeferredModules().size() == 3, "Test for deferred modules")
+
+  // look-ups for things the deferred modules do not provide
+  std::vector<ServiceReferenceU> refs = mc->GetServiceReferences("us::TestModuleAL3_1Service", "(test.extension=other)");
+  US_TEST_CONDITION(refs.empty(), "Test for no service references")
+  refs = mc->GetServiceReferences("", "(test.extension=al3_2)");
+  US_TEST_CONDITION(refs.empty(), "Test for no service references")
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetModule("TestModuleAL3_1") == nullptr, "Test for deferred module TestModuleAL3_1")
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetModule("TestModuleAL3_2") == nullptr, "Test for deferred module TestModuleAL3_2")
+
+  // a look-up for a provided service interface loads the module
+  ServiceReferenceU ref = mc->GetServiceReference("us::TestModuleAL3_1Service");
+  US_TEST_CONDITION_REQUIRED(ref, "Test for service reference from deferred module")
+  Module* moduleAL3_1 = ModuleRegistry::GetModule("TestModuleAL3_1");
+  US_TEST_CONDITION_REQUIRED(moduleAL3_1 != nullptr, "Test for loaded module TestModuleAL3_1")
+  US_TEST_CONDITION(ref.GetModule() == moduleAL3_1, "Test for service reference module")
+  US_TEST_CONDITION(ModuleRegistry::GetDeferredModules().size() == 2, "Test for deferred modules")
+
+  // listeners only load modules providing the object classes of their filter
+  TestModuleListener listener;
+  mc->AddServiceListener(&listener, &TestModuleListener::ServiceChanged, "(test.extension=al3_3)");
+  mc->RemoveServiceListener(&listener, &TestModuleListener::ServiceChanged);
+  US_TEST_CONDITION_REQUIRED(ModuleRegistry::GetModule("TestModuleAL3_3") == nullptr, "Test for deferred module TestModuleAL3_3")
+
+  // a listener for a provided service interface loads the module and is notified about its services
+  mc->AddServiceListener(&listener, &TestModuleListener::ServiceChanged, "(objectclass=us::TestModuleAL3_3Service)");
+  Module* moduleAL3_3 = ModuleRegistry::GetModule("TestModuleAL3_3");
+  US_TEST_CONDITION_REQUIRED(moduleAL3_3 != nullptr, "Test for loaded module TestModuleAL3_3")
+  US_TEST_CONDITION(listener.GetServiceEvent().GetType() == ServiceEvent::REGISTERED, "Test for service event of loaded module")
+  US_TEST_CONDITION(listener.GetServiceEvent().GetServiceReference().GetModule() == moduleAL3_3, "Test for service event module")
+  mc->RemoveServiceListener(&listener, &TestModuleListener::ServiceChanged);
+  US_TEST_CONDITION(ModuleRegistry::GetDeferredModules().size() == 1, "Test for deferred modules")
+
+  // modules not providing services are loaded by their declared values
+  US_TEST_CONDITION(ModuleRegistry::LoadDeferredModules("test.extension", "other").empty(), "Test for no loaded modules")
+  std::vector<std::string> loadedModules = ModuleRegistry::LoadDeferredModules("Test.Extension", "al3_2");
+  US_TEST_CONDITION_REQUIRED(loadedModules.size() == 1, "Test for loaded modules")
+  Module* moduleAL3_2 = ModuleRegistry::GetModule("TestModuleAL3_2");
+  US_TEST_CONDITION_REQUIRED(moduleAL3_2 != nullptr, "Test for loaded module TestModuleAL3_2")
+  US_TEST_CONDITION(loadedModules[0] == moduleAL3_2->GetLocation(), "Test for loaded module location")
+  US_TEST_CONDITION(ModuleRegistry::GetDeferredModules().empty(), "Test for no deferred modules")
+
+  libAL3.Unload();
+  ModuleSettings::SetLazyAutoLoadingEnabled(false);
+}
+
 } // end unnamed namespace
 
 
@@ -171,5 +246,7 @@ int usModuleAutoLoadTest(int /*argc*/, char* /*argv*/[])
 
   testCustomAutoLoadPath();
 
+  testLazyAutoLoad();
+
   US_TEST_END()
 }
@@ -203,6 +203,7 @@ public:
 
   void TestAddListeners();
   void TestRegisterServices();
+  void TestLookupServices();
 
   void TestModifyServices();
   void TestUnregisterServices();
@@ -216,6 +217,7 @@ private:
 
   void AddListeners(int n);
   void RegisterServices(int n);
+  std::size_t LookupServices(const std::string& clazz, const std::string& key, int n);
   void ModifyServices();
   void UnregisterServices();
 
@@ -358,6 +360,63 @@ void ServiceRegistryPerformanceTest::RegisterServices(int n)
   }
 }
 
+void ServiceRegistryPerformanceTest::TestLookupServices()
+{
+  const int nLookups = 10000;
+  const std::string clazz = us_service_interface_iid<IPerfTestService>();
+
+  Log() << "Look up services by a filter, and check that we get one service per lookup\n";
+
+  struct Lookup
+  {
+    const char* name;
+    std::string clazz;
+    const char* key;
+  };
+  const Lookup lookups[] = {
+    { "indexed string property", clazz, "service.pid" },
+    { "indexed string property without class", std::string(), "service.pid" },
+    { "non-indexed int property", clazz, "perf.service.value" }
+  };
+
+  for (std::size_t i = 0; i < sizeof(lookups) / sizeof(lookups[0]); ++i)
+  {
+    HighPrecisionTimer t;
+    t.Start();
+    std::size_t found = LookupServices(lookups[i].clazz, lookups[i].key, nLookups);
+    long long us = t.ElapsedMicro();
+    Log() << nLookups << " lookups by " << lookups[i].name << " took " << us / 1000 << "ms ("
+          << (us > 0 ? static_cast<long long>(nLookups * 1000000.0 / us) : 0) << " lookups/s)\n";
+    US_TEST_CONDITION_REQUIRED(found == static_cast<std::size_t>(nLookups),
+                               "# found services must be same as # of lookups");
+  }
+}
+
+std::size_t ServiceRegistryPerformanceTest::LookupServices(const std::string& clazz, const std::string& key, int n)
+{
+  std::string pid("my.service.");
+
+  std::size_t found = 0;
+  for(int i = 0; i < n; i++)
+  {
+    // services are registered with service.pid "my.service.<i>" and perf.service.value i+1
+    const int serviceIndex = i % nServices;
+    std::stringstream filter;
+    filter << "(" << key << "=";
+    if (key == "service.pid")
+    {
+      filter << pid << serviceIndex;
+    }
+    else
+    {
+      filter << serviceIndex + 1;
+    }
+    filter << ")";
+    found += mc->GetServiceReferences(clazz, filter.str()).size();
+  }
+  return found;
+}
+
 void ServiceRegistryPerformanceTest::TestModifyServices()
 {
   Log() << "Modify all services, and check that we get #of services ("
@@ -420,6 +479,7 @@ int usServiceRegistryPerformanceTest(int /*argc*/, char* /*argv*/[])
   perfTest.InitTestCase();
   perfTest.TestAddListeners();
   perfTest.TestRegisterServices();
+  perfTest.TestLookupServices();
   perfTest.TestModifyServices();
   perfTest.TestUnregisterServices();
   perfTest.CleanupTestCase();
@@ -27,6 +27,7 @@
 #include <usModuleContext.h>
 
 #include <stdexcept>
+#include <sstream>
 
 US_USE_NAMESPACE
 
@@ -35,6 +36,11 @@ struct ITestServiceA
   virtual ~ITestServiceA() {}
 };
 
+struct ITestServiceB
+{
+  virtual ~ITestServiceB() {}
+};
+
 
 void TestServiceInterfaceId()
 {
@@ -127,6 +133,193 @@ void TestServicePropertiesUpdate()
   US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>().empty(), "Testing service count")
 }
 
+// Compare the result of a filtered lookup with a linear evaluation of the filter,
+// including the ranking order of the references
+static bool CheckFilteredLookup(ModuleContext* context, const std::string& filter, std::size_t expectedCount)
+{
+  std::vector<ServiceReference<ITestServiceA> > allRefs = context->GetServiceReferences<ITestServiceA>();
+  std::vector<ServiceReference<ITestServiceA> > expected;
+  LDAPFilter ldapFilter(filter);
+  for (std::size_t i = 0; i < allRefs.size(); ++i)
+  {
+    ServiceProperties props;
+    std::vector<std::string> keys;
+    allRefs[i].GetPropertyKeys(keys);
+    for (std::size_t j = 0; j < keys.size(); ++j)
+    {
+      props[keys[j]] = allRefs[i].GetProperty(keys[j]);
+    }
+    if (ldapFilter.Match(props)) expected.push_back(allRefs[i]);
+  }
+
+  std::vector<ServiceReference<ITestServiceA> > refs = context->GetServiceReferences<ITestServiceA>(filter);
+  std::vector<ServiceReferenceU> refsNoClass = context->GetServiceReferences(std::string(),
+    "(&(" + ServiceConstants::OBJECTCLASS() + "=" + us_service_interface_iid<ITestServiceA>() + ")" + filter + ")");
+
+  if (refs.size() != expectedCount || refs != expected) return false;
+  if (refsNoClass.size() != refs.size()) return false;
+  for (std::size_t i = 0; i < refs.size(); ++i)
+  {
+    if (refsNoClass[i] != refs[i]) return false;
+  }
+  return true;
+}
+
+void TestFilteredServiceLookup()
+{
+  struct TestServiceA : public ITestServiceA
+  {
+  };
+  struct TestServiceB : public ITestServiceB
+  {
+  };
+
+  ModuleContext* context = GetModuleContext();
+
+  // Enough services to use the property index
+  const std::size_t count = 40;
+  std::vector<TestServiceA> services(count);
+  std::vector<ServiceRegistration<ITestServiceA> > regs;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ServiceProperties props;
+    if (i % 5 == 0)
+    {
+      // not a string, must not be missed by indexed lookups
+      props["name"] = 7;
+    }
+    else
+    {
+      std::stringstream name;
+      name << "svc" << (i % 4);
+      props["name"] = name.str();
+    }
+    std::vector<std::string> tags;
+    tags.push_back(i % 2 ? "odd" : "even");
+    tags.push_back("all");
+    props["tags"] = tags;
+    props[ServiceConstants::SERVICE_RANKING()] = static_cast<int>(i % 3);
+    regs.push_back(context->RegisterService<ITestServiceA>(&services[i], props));
+  }
+
+  TestServiceB serviceB;
+  ServiceProperties propsB;
+  propsB["name"] = std::string("svc1");
+  ServiceRegistration<ITestServiceB> regB = context->RegisterService<ITestServiceB>(&serviceB, propsB);
+
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=svc1)", 8), "Testing indexed string property lookup")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(NAME=svc2)", 8), "Testing indexed lookup with case-insensitive key")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=SVC2)", 0), "Testing indexed lookup with case-sensitive value")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=7)", 8), "Testing lookup of non-string property values")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(tags=odd)", 20), "Testing indexed string list property lookup")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(&(tags=all)(name=svc3))", 8), "Testing indexed conjunction lookup")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(&(name=svc1)(!(tags=odd)))", 0), "Testing indexed lookup with negation")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(|(name=svc1)(name=svc2))", 16), "Testing disjunction lookup")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=svc*)", 32), "Testing wildcard lookup")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(unknown=svc1)", 0), "Testing lookup of unknown property")
+
+  std::vector<ServiceReferenceU> refs = context->GetServiceReferences(std::string(), "(name=svc1)");
+  US_TEST_CONDITION(refs.size() == 9, "Testing lookup without class over all services")
+  refs = context->GetServiceReferences(std::string(), "(&(objectclass=" + std::string(us_service_interface_iid<ITestServiceB>()) + ")(name=svc1))");
+  US_TEST_CONDITION(refs.size() == 1 && refs.front() == regB.GetReference(), "Testing lookup with object class and property")
+
+  // Changing properties must update the index
+  ServiceProperties props;
+  props["name"] = std::string("changed");
+  props["tags"] = std::vector<std::string>(1, "odd");
+  regs[1].SetProperties(props);
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=svc1)", 7), "Testing lookup after property update")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=changed)", 1), "Testing lookup of updated property")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(tags=odd)", 20), "Testing lookup of updated list property")
+
+  // Changing the ranking must keep the order of indexed lookups
+  props[ServiceConstants::SERVICE_RANKING()] = 100;
+  props["name"] = std::string("svc3");
+  regs[count - 1].SetProperties(props);
+  refs = context->GetServiceReferences(us_service_interface_iid<ITestServiceA>(), "(name=svc3)");
+  US_TEST_CONDITION(!refs.empty() && refs.back() == regs[count - 1].GetReference(), "Testing ranking order of indexed lookup")
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=svc3)", 8), "Testing lookup after ranking update")
+
+  regs[2].Unregister();
+  US_TEST_CONDITION(CheckFilteredLookup(context, "(name=svc2)", 7), "Testing lookup after unregistration")
+
+  // Invalid filters must throw on every call
+  for (int i = 0; i < 2; ++i)
+  {
+    try
+    {
+      context->GetServiceReferences<ITestServiceA>("(name=svc1");
+      US_TEST_FAILED_MSG(<< "std::invalid_argument exception expected")
+    }
+    catch (const std::invalid_argument&)
+    {
+      // this is expected
+    }
+  }
+
+  regB.Unregister();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (i != 2) regs[i].Unregister();
+  }
+  US_TEST_CONDITION(context->GetServiceReferences<ITestServiceA>().empty(), "Testing service count")
+}
+
+struct TestFilteredServiceListener
+{
+  int count;
+
+  TestFilteredServiceListener() : count(0) {}
+
+  void ServiceChanged(const ServiceEvent)
+  {
+    ++count;
+  }
+};
+
+void TestFilteredServiceListeners()
+{
+  struct TestServiceA : public ITestServiceA
+  {
+  };
+  struct TestServiceB : public ITestServiceB
+  {
+  };
+
+  ModuleContext* context = GetModuleContext();
+
+  // Not a "simple" filter, but the object class can be determined
+  TestFilteredServiceListener listener;
+  context->AddServiceListener(&listener, &TestFilteredServiceListener::ServiceChanged,
+                              "(&(objectclass=" + std::string(us_service_interface_iid<ITestServiceA>()) + ")(name=listened))");
+
+  ServiceProperties props;
+  props["name"] = std::string("listened");
+
+  TestServiceB serviceB;
+  ServiceRegistration<ITestServiceB> regB = context->RegisterService<ITestServiceB>(&serviceB, props);
+  US_TEST_CONDITION(listener.count == 0, "Testing listener not called for other object class")
+
+  TestServiceA serviceA;
+  ServiceRegistration<ITestServiceA> regA = context->RegisterService<ITestServiceA>(&serviceA, props);
+  US_TEST_CONDITION(listener.count == 1, "Testing listener called for registration")
+
+  props["name"] = std::string("ignored");
+  regA.SetProperties(props);
+  US_TEST_CONDITION(listener.count == 2, "Testing listener called for end of match")
+
+  regA.Unregister();
+  US_TEST_CONDITION(listener.count == 2, "Testing listener not called for unmatched service")
+
+  context->RemoveServiceListener(&listener, &TestFilteredServiceListener::ServiceChanged);
+  props["name"] = std::string("listened");
+  regA = context->RegisterService<ITestServiceA>(&serviceA, props);
+  US_TEST_CONDITION(listener.count == 2, "Testing removed listener")
+
+  regA.Unregister();
+  regB.Unregister();
+}
+
 
 int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
 {
@@ -135,6 +328,8 @@ int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
   TestServiceInterfaceId();
   TestMultipleServiceRegistrations();
   TestServicePropertiesUpdate();
+  TestFilteredServiceLookup();
+  TestFilteredServiceListeners();
 
   US_TEST_END()
 }
@@ -1,9 +1,12 @@
 set(CPP_FILES
+  itkShortestPathIndexedHeap.cpp
   itkShortestPathNode.cpp
 )
 set(H_FILES
   itkShortestPathCostFunction.h
+  itkShortestPathBatchExtractor.h
   itkShortestPathCostFunctionTbss.h
+  itkShortestPathIndexedHeap.h
   itkShortestPathNode.h
   itkShortestPathImageFilter.h
   itkShortestPathCostFunctionLiveWire.h
@@ -0,0 +1,141 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __itkShortestPathBatchExtractor_h
+#define __itkShortestPathBatchExtractor_h
+
+#include "itkShortestPathImageFilter.h"
+
+#include <itkObject.h>
+
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+  /** \brief Extracts the shortest paths between many pairs of start and end indices in parallel.
+
+  All paths are computed on the same input image with the same cost function. The cost function is
+  initialized once for the first pair and then only read, so it must not depend on the start and end
+  index in GetCost (as ShortestPathCostFunctionLiveWire and ShortestPathCostFunctionTbss).
+
+  Requests with the same start index are grouped and answered by a single source search, that is only
+  continued until all of their end indices are closed. A start index with a single request is answered by an
+  A* search, as ShortestPathImageFilter does. The groups are distributed over a number of worker
+  threads. Each worker owns a ShortestPathImageFilter and thus its own node storage, which is reused for
+  all of its groups.
+
+  \code
+  auto extractor = itk::ShortestPathBatchExtractor<ImageType>::New();
+  extractor->SetInput(image);
+  extractor->SetCostFunction(costFunction);
+  extractor->AddPath(start, end);
+  ...
+  extractor->Compute();
+  auto path = extractor->GetPath(0);
+  \endcode
+  */
+  template <class TInputImageType>
+  class ShortestPathBatchExtractor : public Object
+  {
+  public:
+    typedef ShortestPathBatchExtractor Self;
+    typedef Object Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    itkFactorylessNewMacro(Self);
+
+    itkTypeMacro(ShortestPathBatchExtractor, Object);
+
+    typedef TInputImageType InputImageType;
+    typedef typename TInputImageType::IndexType IndexType;
+    typedef ShortestPathImageFilter<TInputImageType, TInputImageType> ShortestPathFilterType;
+    typedef typename ShortestPathFilterType::CostFunctionType CostFunctionType;
+    typedef std::vector<IndexType> PathType;
+
+    /** \brief Set the image, that all paths are extracted from.*/
+    itkSetConstObjectMacro(Input, InputImageType);
+    itkGetConstObjectMacro(Input, InputImageType);
+
+    /** \brief Set the cost function, its image has to be set already. It is initialized by Compute and shared by
+    all threads.*/
+    itkSetObjectMacro(CostFunction, CostFunctionType);
+    itkGetObjectMacro(CostFunction, CostFunctionType);
+
+    /** \brief (default=false), see ShortestPathImageFilter::SetGraph_fullNeighbors.*/
+    itkSetMacro(FullNeighbors, bool);
+    itkGetMacro(FullNeighbors, bool);
+    itkBooleanMacro(FullNeighbors);
+
+    /** \brief (default=0), number of worker threads. 0 uses one thread per hardware thread.*/
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetMacro(NumberOfThreads, unsigned int);
+
+    /** \brief Adds a request for the shortest path from start to end and returns its number.*/
+    std::size_t AddPath(const IndexType &start, const IndexType &end);
+
+    /** \brief Removes all requests and results.*/
+    void ClearPaths();
+
+    std::size_t GetNumberOfPaths() const { return m_Requests.size(); }
+
+    /** \brief Extracts the shortest paths of all requests.*/
+    void Compute();
+
+    /** \brief Returns the path of request i, from its start to its end index. The path is empty, if the end
+    index cannot be reached.*/
+    const PathType &GetPath(std::size_t i) const;
+
+    const std::vector<PathType> &GetPaths() const { return m_Paths; }
+
+    /** \brief Returns the costs of the path of request i, -1 if the end index cannot be reached.*/
+    double GetPathCost(std::size_t i) const;
+
+    /** \brief Wall clock time of the last Compute in seconds.*/
+    itkGetConstMacro(ComputationTime, double);
+
+    /** \brief Throughput of the last Compute.*/
+    double GetPathsPerSecond() const;
+
+  protected:
+    ShortestPathBatchExtractor();
+    ~ShortestPathBatchExtractor() override {}
+
+    void PrintSelf(std::ostream &os, Indent indent) const override;
+
+    /** \brief Extracts the paths of the requests order[begin] to order[end - 1], which share their start index,
+    with a single source search of filter, or with an A* search if there is only one request.*/
+    void ExtractGroup(ShortestPathFilterType *filter,
+                      const std::vector<std::size_t> &order,
+                      std::size_t begin,
+                      std::size_t end);
+
+    typename InputImageType::ConstPointer m_Input;
+    typename CostFunctionType::Pointer m_CostFunction;
+    bool m_FullNeighbors;
+    unsigned int m_NumberOfThreads;
+
+    std::vector<std::pair<IndexType, IndexType>> m_Requests;
+    std::vector<PathType> m_Paths;
+    std::vector<double> m_PathCosts;
+    double m_ComputationTime;
+
+  private:
+    ShortestPathBatchExtractor(const Self &); // purposely not implemented
+    void operator=(const Self &);             // purposely not implemented
+  };
+
+} // end namespace itk
+
+#include "itkShortestPathBatchExtractor.txx"
+
+#endif
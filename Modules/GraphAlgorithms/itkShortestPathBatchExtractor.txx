@@ -0,0 +1,248 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __itkShortestPathBatchExtractor_txx
+#define __itkShortestPathBatchExtractor_txx
+
+#include "itkShortestPathBatchExtractor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace itk
+{
+  template <class TInputImageType>
+  ShortestPathBatchExtractor<TInputImageType>::ShortestPathBatchExtractor()
+    : m_FullNeighbors(false), m_NumberOfThreads(0), m_ComputationTime(0.0)
+  {
+  }
+
+  template <class TInputImageType>
+  std::size_t ShortestPathBatchExtractor<TInputImageType>::AddPath(const IndexType &start, const IndexType &end)
+  {
+    m_Requests.push_back(std::make_pair(start, end));
+    this->Modified();
+    return m_Requests.size() - 1;
+  }
+
+  template <class TInputImageType>
+  void ShortestPathBatchExtractor<TInputImageType>::ClearPaths()
+  {
+    m_Requests.clear();
+    m_Paths.clear();
+    m_PathCosts.clear();
+    m_ComputationTime = 0.0;
+    this->Modified();
+  }
+
+  template <class TInputImageType>
+  void ShortestPathBatchExtractor<TInputImageType>::Compute()
+  {
+    if (m_Input.IsNull())
+      itkExceptionMacro(<< "Input image not set.");
+
+    if (m_CostFunction.IsNull())
+      itkExceptionMacro(<< "Cost function not set.");
+
+    const auto region = m_Input->GetRequestedRegion();
+    for (const auto &request : m_Requests)
+    {
+      if (!region.IsInside(request.first) || !region.IsInside(request.second))
+        itkExceptionMacro(<< "Path from " << request.first << " to " << request.second << " leaves the image.");
+    }
+
+    m_Paths.assign(m_Requests.size(), PathType());
+    m_PathCosts.assign(m_Requests.size(), -1.0);
+    m_ComputationTime = 0.0;
+
+    if (m_Requests.empty())
+      return;
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+
+    // The cost function is initialized only once, afterwards all threads just read it
+    m_CostFunction->SetStartIndex(m_Requests.front().first);
+    m_CostFunction->SetEndIndex(m_Requests.front().second);
+    m_CostFunction->Initialize();
+
+    // Group the requests by their start index, each group is answered by one search
+    std::vector<std::size_t> order(m_Requests.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+      const auto &startA = m_Requests[a].first;
+      const auto &startB = m_Requests[b].first;
+      for (unsigned int d = 0; d < TInputImageType::ImageDimension; ++d)
+      {
+        if (startA[d] != startB[d])
+          return startA[d] < startB[d];
+      }
+      return false;
+    });
+
+    std::vector<std::size_t> groupBegins;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+      if (i == 0 || m_Requests[order[i]].first != m_Requests[order[i - 1]].first)
+        groupBegins.push_back(i);
+    }
+    groupBegins.push_back(order.size());
+
+    const std::size_t numberOfGroups = groupBegins.size() - 1;
+
+    std::size_t numberOfThreads = m_NumberOfThreads;
+    if (numberOfThreads == 0)
+      numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+    numberOfThreads = std::min(numberOfThreads, numberOfGroups);
+
+    // Every thread owns a filter, thus the node storage is allocated once per thread and not per search
+    std::vector<typename ShortestPathFilterType::Pointer> filters;
+    for (std::size_t i = 0; i < numberOfThreads; ++i)
+    {
+      auto filter = ShortestPathFilterType::New();
+      filter->SetInput(m_Input);
+      filter->SetCostFunction(m_CostFunction);
+      filter->SetGraph_fullNeighbors(m_FullNeighbors);
+      filter->SetMakeOutputImage(false);
+      filter->SetInitializeCostFunction(false);
+      filters.push_back(filter);
+    }
+
+    std::atomic<std::size_t> nextGroup(0);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto work = [&](ShortestPathFilterType *filter) {
+      try
+      {
+        for (auto group = nextGroup++; group < numberOfGroups; group = nextGroup++)
+          this->ExtractGroup(filter, order, groupBegins[group], groupBegins[group + 1]);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+          exception = std::current_exception();
+
+        // let the other threads run out of groups
+        nextGroup = numberOfGroups;
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numberOfThreads; ++i)
+      threads.emplace_back(work, filters[i].GetPointer());
+
+    work(filters[0].GetPointer());
+
+    for (auto &thread : threads)
+      thread.join();
+
+    m_ComputationTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+
+  template <class TInputImageType>
+  void ShortestPathBatchExtractor<TInputImageType>::ExtractGroup(ShortestPathFilterType *filter,
+                                                                 const std::vector<std::size_t> &order,
+                                                                 std::size_t begin,
+                                                                 std::size_t end)
+  {
+    filter->SetStartIndex(m_Requests[order[begin]].first);
+
+    // A single end index is searched with the A* estimate, as a separate ShortestPathImageFilter would do
+    if (end - begin == 1)
+    {
+      const auto request = order[begin];
+      const auto &endIndex = m_Requests[request].second;
+
+      filter->SetEndIndex(endIndex);
+      filter->SearchShortestPath();
+
+      if (filter->IsClosed(endIndex))
+      {
+        m_Paths[request] = filter->GetPathTo(endIndex);
+        m_PathCosts[request] = filter->GetDistance(endIndex);
+      }
+      return;
+    }
+
+    // Closes some nodes at a time until the end index is closed, the following ends of the group
+    // continue the same search
+    const NodeNumType numberOfNodesPerStep = 256;
+
+    filter->InitializeSingleSourceSearch();
+
+    bool complete = false;
+    for (auto i = begin; i < end; ++i)
+    {
+      const auto request = order[i];
+      const auto &endIndex = m_Requests[request].second;
+
+      while (!complete && !filter->IsClosed(endIndex))
+        complete = filter->ContinueSingleSourceSearch(numberOfNodesPerStep);
+
+      if (filter->IsClosed(endIndex))
+      {
+        m_Paths[request] = filter->GetPathTo(endIndex);
+        m_PathCosts[request] = filter->GetDistance(endIndex);
+      }
+    }
+  }
+
+  template <class TInputImageType>
+  const typename ShortestPathBatchExtractor<TInputImageType>::PathType &
+    ShortestPathBatchExtractor<TInputImageType>::GetPath(std::size_t i) const
+  {
+    if (i >= m_Paths.size())
+      itkExceptionMacro(<< "No path with number " << i << ", call Compute first.");
+
+    return m_Paths[i];
+  }
+
+  template <class TInputImageType>
+  double ShortestPathBatchExtractor<TInputImageType>::GetPathCost(std::size_t i) const
+  {
+    if (i >= m_PathCosts.size())
+      itkExceptionMacro(<< "No path with number " << i << ", call Compute first.");
+
+    return m_PathCosts[i];
+  }
+
+  template <class TInputImageType>
+  double ShortestPathBatchExtractor<TInputImageType>::GetPathsPerSecond() const
+  {
+    if (m_ComputationTime <= 0.0)
+      return 0.0;
+
+    return m_Paths.size() / m_ComputationTime;
+  }
+
+  template <class TInputImageType>
+  void ShortestPathBatchExtractor<TInputImageType>::PrintSelf(std::ostream &os, Indent indent) const
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "FullNeighbors: " << m_FullNeighbors << std::endl;
+    os << indent << "NumberOfThreads: " << m_NumberOfThreads << std::endl;
+    os << indent << "NumberOfPaths: " << m_Requests.size() << std::endl;
+    os << indent << "ComputationTime: " << m_ComputationTime << std::endl;
+  }
+
+} // end namespace itk
+
+#endif // __itkShortestPathBatchExtractor_txx
@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include "itkImageToImageFilter.h"
 #include "itkShortestPathCostFunction.h"
+#include "itkShortestPathIndexedHeap.h"
 #include "itkShortestPathNode.h"
 #include <itkImageRegionIteratorWithIndex.h>
 
@@ -43,8 +44,22 @@ found in the LICENSE file.
 // GetDistanceImage // Returns the distance image
 // GetVectorOrderIMage // Returns the Vector Order image
 //
+/// SINGLE SOURCE SEARCH
+// Instead of Update(), a search over the whole image can be run in steps, e.g. in a background thread, while paths
+// to the already closed pixels are queried:
+// void InitializeSingleSourceSearch() // Starts a new search from the start index
+// bool ContinueSingleSourceSearch(NodeNumType) // Closes further pixels, returns true if the search is complete
+// bool IsClosed(const IndexType &) // The shortest path to a closed pixel is known
+// std::vector< itk::Index<3> > GetPathTo(const IndexType &) // Traces the path back from a pixel to the start index
+// The filter does not synchronize these calls, this is up to the caller.
+//
 // EXAMPLE USE
 // pleae see qmitkmitralvalvesegmentation4dtee bundle
+//
+// IMPLEMENTATION
+// The open list is an indexed binary heap (ShortestPathIndexedHeap) over the flat node array m_Nodes. The node
+// array and the heap are only reallocated if the size of the graph changes. Neighbors are visited through a table
+// of index and node number offsets, that is built once per graph, so an expansion does not allocate.
 
 namespace itk
 {
@@ -68,6 +83,7 @@ namespace itk
     typedef typename TInputImageType::PixelType InputImagePixelType;
     typedef typename TInputImageType::SizeType InputImageSizeType;
     typedef typename TInputImageType::IndexType IndexType;
+    typedef typename TInputImageType::OffsetType OffsetType;
     typedef typename itk::ImageRegionIteratorWithIndex<InputImageType> InputImageIteratorType;
 
     typedef TOutputImageType OutputImageType;
@@ -130,6 +146,11 @@ namespace itk
     itkSetMacro(ActivateTimeOut, bool);
     itkGetMacro(ActivateTimeOut, bool);
 
+    // \brief (default=true), Initialize the cost function before each search. Disable it, if filters in several
+    // threads share a cost function, that was initialized before.
+    itkSetMacro(InitializeCostFunction, bool);
+    itkGetMacro(InitializeCostFunction, bool);
+
     // \brief returns shortest Path as vector
     std::vector<IndexType> GetVectorPath();
 
@@ -145,6 +166,30 @@ namespace itk
     // have m_CalcAllDistances=true
     OutputImagePointer GetDistanceImage();
 
+    // \brief Searches the shortest path from the start to the end index like GenerateData, but does not run the
+    // pipeline and makes no outputs. Thus several filters can search on the same input in parallel. The results are
+    // available via IsClosed, GetDistance and GetPathTo.
+    void SearchShortestPath();
+
+    // \brief Prepares a single source search from the start index over the whole image. End indices and the A*
+    // estimate are not used.
+    void InitializeSingleSourceSearch();
+
+    // \brief Closes up to maximumNumberOfNodes further nodes of the single source search. Returns true, if the search
+    // is complete.
+    bool ContinueSingleSourceSearch(NodeNumType maximumNumberOfNodes);
+
+    // \brief returns true, if the shortest path to index is known
+    bool IsClosed(const IndexType &index);
+
+    // \brief returns the costs of the shortest path known so far from the start index to index, -1 if index was
+    // not reached yet
+    DistanceType GetDistance(const IndexType &index);
+
+    // \brief returns the shortest path from the start index to index. The path is only guaranteed to be the
+    // shortest one, if index is closed. If index was not reached yet, the path is empty.
+    std::vector<IndexType> GetPathTo(const IndexType &index);
+
     // \brief Fill m_VectorPath
     void MakeShortestPathVector();
 
@@ -160,12 +205,17 @@ namespace itk
       m_endPoints; // if you fill this vector, the algo will not rest until all endPoints have been reached
     std::vector<IndexType> m_endPointsClosed;
 
-    ShortestPathNode *m_Nodes; // main list that contains all nodes
+    std::vector<ShortestPathNode> m_Nodes; // main list that contains all nodes
+    ShortestPathIndexedHeap m_OpenList;    // discovered nodes, that are not closed yet
     NodeNumType m_Graph_NumberOfNodes;
+    InputImageSizeType m_Graph_Size;
+    std::vector<OffsetType> m_NeighborOffsets;          // index offsets of the neighbors, see InitNeighborhood
+    std::vector<OffsetValueType> m_NeighborNodeOffsets; // corresponding offsets of the node numbers
+    unsigned int m_NumberOfFaceNeighbors;               // the first neighbors are the N4 (2D) or N6 (3D) neighbors
     NodeNumType m_Graph_StartNode;
     NodeNumType m_Graph_EndNode;
     bool m_Graph_fullNeighbors;
-    std::vector<ShortestPathNode *> m_Graph_DiscoveredNodeList;
+    std::vector<ShortestPathNode *> m_Graph_DiscoveredNodeList; // nodes with a distance, reset by the next InitGraph
     ShortestPathImageFilter(Self &); // intentionally not implemented
     void operator=(const Self &);    // intentionally not implemented
     const static int BACKGROUND = 0;
@@ -183,6 +233,10 @@ namespace itk
 
     bool m_Initialized;
 
+    bool m_InitializeCostFunction;
+
+    bool m_SingleSourceSearch; // no target, thus no A* estimate
+
     CostFunctionTypePointer m_CostFunction;
     IndexType m_StartIndex, m_EndIndex;
     std::vector<IndexType> m_VectorPath;
@@ -217,11 +271,20 @@ namespace itk
     // \brief Check if coords are in bounds of image
     bool CoordIsInBounds(IndexType);
 
+    // \brief Check if coords are in bounds of the initialized graph, faster version of CoordIsInBounds
+    bool CoordIsInGraph(const IndexType &coord) const;
+
+    // \brief Fills the neighbor offset tables for the current graph size
+    void InitNeighborhood();
+
     // \brief Initializes the graph
     void InitGraph();
 
     // \brief Start ShortestPathSearch
     void StartShortestPathSearch();
+
+    // \brief Closes the node with the lowest score, updates its neighbors and returns it
+    NodeNumType CloseNextNode();
   };
 
 } // end of namespace itk
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkMemoryUtilities.h"
 #include <ctime>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -25,8 +26,8 @@ namespace itk
   // Constructor  (initialize standard values)
   template <class TInputImageType, class TOutputImageType>
   ShortestPathImageFilter<TInputImageType, TOutputImageType>::ShortestPathImageFilter()
-    : m_Nodes(nullptr),
-      m_Graph_NumberOfNodes(0),
+    : m_Graph_NumberOfNodes(0),
+      m_NumberOfFaceNeighbors(0),
       m_Graph_fullNeighbors(false),
       m_FullNeighborsMode(false),
       m_MakeOutputImage(true),
@@ -34,10 +35,13 @@ namespace itk
       m_CalcAllDistances(false),
       multipleEndPoints(false),
       m_ActivateTimeOut(false),
-      m_Initialized(false)
+      m_Initialized(false),
+      m_InitializeCostFunction(true),
+      m_SingleSourceSearch(false)
   {
     m_endPoints.clear();
     m_endPointsClosed.clear();
+    m_Graph_Size.Fill(0);
 
     if (m_MakeOutputImage)
     {
@@ -49,7 +53,6 @@ namespace itk
   template <class TInputImageType, class TOutputImageType>
   ShortestPathImageFilter<TInputImageType, TOutputImageType>::~ShortestPathImageFilter()
   {
-    delete[] m_Nodes;
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -139,233 +142,88 @@ namespace itk
   }
 
   template <class TInputImageType, class TOutputImageType>
-  inline std::vector<ShortestPathNode *> ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetNeighbors(
-    unsigned int nodeNum, bool FullNeighbors)
+  inline bool ShortestPathImageFilter<TInputImageType, TOutputImageType>::CoordIsInGraph(const IndexType &coord) const
   {
-    // returns a vector of nodepointers.. these nodes are the neighbors
-    int dim = InputImageType::ImageDimension;
-    IndexType Coord = NodeToCoord(nodeNum);
-    IndexType NeighborCoord;
-    std::vector<ShortestPathNode *> nodeList;
-
-    int neighborDistance = 1; // if i increase that, i might not hit the endnote
-
-    // maybe use itkNeighborhoodIterator here, might be faster
+    for (unsigned int i = 0; i < TInputImageType::ImageDimension; ++i)
+    {
+      if ((coord[i] < 0) || ((unsigned long)coord[i] >= m_Graph_Size[i]))
+        return false;
+    }
+    return true;
+  }
 
+  template <class TInputImageType, class TOutputImageType>
+  void ShortestPathImageFilter<TInputImageType, TOutputImageType>::InitNeighborhood()
+  {
+    // The neighbors are listed in the order of the former GetNeighbors implementation, thus paths of equal
+    // costs are resolved the same way as before. The face neighbors (N4 / N6) come first.
+    static const int neighbors2D[8][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}, {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+
+    static const int neighbors3D[26][3] = {// N6
+                                           {0, -1, 0}, {1, 0, 0}, {0, 1, 0}, {-1, 0, 0}, {0, 0, 1}, {0, 0, -1},
+                                           // Middle Slice
+                                           {-1, -1, 0}, {1, -1, 0}, {-1, 1, 0}, {1, 1, 0},
+                                           // BackSlice (Diagonal)
+                                           {-1, -1, -1}, {1, -1, -1}, {-1, 1, -1}, {1, 1, -1},
+                                           // BackSlice (Non-Diag)
+                                           {0, -1, -1}, {1, 0, -1}, {0, 1, -1}, {-1, 0, -1},
+                                           // FrontSlice (Diagonal)
+                                           {-1, -1, 1}, {1, -1, 1}, {-1, 1, 1}, {1, 1, 1},
+                                           // FrontSlice(Non-Diag)
+                                           {0, -1, 1}, {1, 0, 1}, {0, 1, 1}, {-1, 0, 1}};
+
+    const unsigned int dim = InputImageType::ImageDimension;
+
+    m_NeighborOffsets.clear();
+    m_NeighborNodeOffsets.clear();
+    m_NumberOfFaceNeighbors = 0;
+
+    unsigned int numberOfNeighbors = 0;
     if (dim == 2)
     {
-      // N4
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] - neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0] + neighborDistance;
-      NeighborCoord[1] = Coord[1];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] + neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0] - neighborDistance;
-      NeighborCoord[1] = Coord[1];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      if (FullNeighbors)
-      {
-        // N8
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-      }
+      numberOfNeighbors = 8;
+      m_NumberOfFaceNeighbors = 4;
     }
     if (dim == 3)
     {
-      // N6
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] - neighborDistance;
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0] + neighborDistance;
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1] + neighborDistance;
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0] - neighborDistance;
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2];
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2] + neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      NeighborCoord[0] = Coord[0];
-      NeighborCoord[1] = Coord[1];
-      NeighborCoord[2] = Coord[2] - neighborDistance;
-      if (CoordIsInBounds(NeighborCoord))
-        nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-      if (FullNeighbors)
+      numberOfNeighbors = 26;
+      m_NumberOfFaceNeighbors = 6;
+    }
+
+    for (unsigned int i = 0; i < numberOfNeighbors; ++i)
+    {
+      const int *neighbor = dim == 2 ? neighbors2D[i] : neighbors3D[i];
+
+      OffsetType offset;
+      OffsetValueType nodeOffset = 0;
+      OffsetValueType stride = 1;
+      for (unsigned int j = 0; j < dim; ++j)
       {
-        // N26
-        // Middle Slice
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2];
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // BackSlice (Diagonal)
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // BackSlice (Non-Diag)
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] - neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // FrontSlice (Diagonal)
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        // FrontSlice(Non-Diag)
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] - neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] + neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0];
-        NeighborCoord[1] = Coord[1] + neighborDistance;
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
-
-        NeighborCoord[0] = Coord[0] - neighborDistance;
-        NeighborCoord[1] = Coord[1];
-        NeighborCoord[2] = Coord[2] + neighborDistance;
-        if (CoordIsInBounds(NeighborCoord))
-          nodeList.push_back(&m_Nodes[CoordToNode(NeighborCoord)]);
+        offset[j] = neighbor[j];
+        nodeOffset += neighbor[j] * stride;
+        stride *= static_cast<OffsetValueType>(m_Graph_Size[j]);
       }
+
+      m_NeighborOffsets.push_back(offset);
+      m_NeighborNodeOffsets.push_back(nodeOffset);
+    }
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  inline std::vector<ShortestPathNode *> ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetNeighbors(
+    unsigned int nodeNum, bool FullNeighbors)
+  {
+    // returns a vector of nodepointers.. these nodes are the neighbors
+    // StartShortestPathSearch iterates the neighbor tables directly, to avoid the allocation of this vector
+    const IndexType Coord = NodeToCoord(nodeNum);
+    const auto numberOfNeighbors =
+      FullNeighbors ? static_cast<unsigned int>(m_NeighborOffsets.size()) : m_NumberOfFaceNeighbors;
+
+    std::vector<ShortestPathNode *> nodeList;
+    for (unsigned int i = 0; i < numberOfNeighbors; ++i)
+    {
+      if (CoordIsInGraph(Coord + m_NeighborOffsets[i]))
+        nodeList.push_back(&m_Nodes[nodeNum + m_NeighborNodeOffsets[i]]);
     }
     return nodeList;
   }
@@ -416,12 +274,18 @@ namespace itk
     const typename TInputImageType::IndexType &a)
   {
     // Returns the minimal possible costs for a path from "a" to targetnode.
-    itk::Vector<float, 3> v;
-    v[0] = m_EndIndex[0] - a[0];
-    v[1] = m_EndIndex[1] - a[1];
-    v[2] = m_EndIndex[2] - a[2];
+    // A single source search has no target, it is a plain Dijkstra search.
+    if (m_SingleSourceSearch)
+      return 0.0;
 
-    return m_CostFunction->GetMinCost() * v.GetNorm();
+    double squaredDistance = 0.0;
+    for (unsigned int i = 0; i < TInputImageType::ImageDimension; ++i)
+    {
+      const double difference = m_EndIndex[i] - a[i];
+      squaredDistance += difference * difference;
+    }
+
+    return m_CostFunction->GetMinCost() * std::sqrt(squaredDistance);
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -429,234 +293,144 @@ namespace itk
   {
     if (!m_Initialized)
     {
-      // Clean up previous stuff
-      CleanUp();
+      // Clean up previous stuff, the node list is reused
+      m_VectorOrder.clear();
+      m_VectorPath.clear();
 
       // Calc Number of nodes
       auto imageDimensions = TInputImageType::ImageDimension;
-      const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
+      m_Graph_Size = this->GetInput()->GetRequestedRegion().GetSize();
       m_Graph_NumberOfNodes = 1;
       for (NodeNumType i = 0; i < imageDimensions; ++i)
-        m_Graph_NumberOfNodes = m_Graph_NumberOfNodes * size[i];
+        m_Graph_NumberOfNodes = m_Graph_NumberOfNodes * m_Graph_Size[i];
 
-      // Initialize mainNodeList with that number
-      m_Nodes = new ShortestPathNode[m_Graph_NumberOfNodes];
+      InitNeighborhood();
 
-      // Initialize each node in nodelist
-      for (NodeNumType i = 0; i < m_Graph_NumberOfNodes; i++)
+      if (m_Nodes.size() == m_Graph_NumberOfNodes)
       {
-        m_Nodes[i].distAndEst = -1;
-        m_Nodes[i].distance = -1;
-        m_Nodes[i].prevNode = -1;
-        m_Nodes[i].mainListIndex = i;
-        m_Nodes[i].closed = false;
+        // Reuse the nodelist, only the nodes discovered by the previous search have to be reset
+        for (auto node : m_Graph_DiscoveredNodeList)
+        {
+          node->distAndEst = -1;
+          node->distance = -1;
+          node->prevNode = -1;
+          node->closed = false;
+        }
       }
+      else
+      {
+        // Initialize mainNodeList with that number
+        m_Nodes.resize(m_Graph_NumberOfNodes);
+
+        // Initialize each node in nodelist
+        for (NodeNumType i = 0; i < m_Graph_NumberOfNodes; i++)
+        {
+          m_Nodes[i].distAndEst = -1;
+          m_Nodes[i].distance = -1;
+          m_Nodes[i].prevNode = -1;
+          m_Nodes[i].mainListIndex = i;
+          m_Nodes[i].closed = false;
+        }
+      }
+      m_Graph_DiscoveredNodeList.clear();
+
+      m_OpenList.Initialize(m_Graph_NumberOfNodes);
 
       m_Initialized = true;
     }
 
     // In the beginning, the Startnode needs a distance of 0
+    if (m_Nodes[m_Graph_StartNode].distance == -1)
+      m_Graph_DiscoveredNodeList.push_back(&m_Nodes[m_Graph_StartNode]);
     m_Nodes[m_Graph_StartNode].distance = 0;
     m_Nodes[m_Graph_StartNode].distAndEst = 0;
 
     // initalize cost function
-    m_CostFunction->Initialize();
+    if (m_InitializeCostFunction)
+      m_CostFunction->Initialize();
   }
 
   template <class TInputImageType, class TOutputImageType>
-  void ShortestPathImageFilter<TInputImageType, TOutputImageType>::StartShortestPathSearch()
+  NodeNumType ShortestPathImageFilter<TInputImageType, TOutputImageType>::CloseNextNode()
   {
-    // Setup Timer
-    clock_t startAll = clock();
-    clock_t stopAll = clock();
+    const auto numberOfNeighbors =
+      m_Graph_fullNeighbors ? static_cast<unsigned int>(m_NeighborOffsets.size()) : m_NumberOfFaceNeighbors;
 
-    // init variables
-    double durationAll = 0;
-    bool timeout = false;
-    NodeNumType mainNodeListIndex = 0;
-    DistanceType curNodeDistance = 0;
-    NodeNumType numberOfNodesChecked = 0;
+    // Kicks out element with lowest score and closes it
+    const NodeNumType mainNodeListIndex = m_OpenList.Pop();
+    const DistanceType curNodeDistance = m_Nodes[mainNodeListIndex].distance;
+    m_Nodes[mainNodeListIndex].closed = true;
 
-    // Create Multimap (tree structure for fast searching)
-    std::multimap<double, ShortestPathNode *> myMap;
-    std::pair<std::multimap<double, ShortestPathNode *>::iterator, std::multimap<double, ShortestPathNode *>::iterator>
-      ret;
-    std::multimap<double, ShortestPathNode *>::iterator it;
-
-    // At first, only startNote is discovered.
-    myMap.insert(
-      std::pair<double, ShortestPathNode *>(m_Nodes[m_Graph_StartNode].distAndEst, &m_Nodes[m_Graph_StartNode]));
+    // if wanted, store vector order
+    if (m_StoreVectorOrder)
+    {
+      m_VectorOrder.push_back(mainNodeListIndex);
+    }
 
-    // While there are discovered Nodes, pick the one with lowest distance,
-    // update its neighbors and eventually delete it from the discovered Nodes list.
-    while (!myMap.empty())
+    // Check neighbors
+    const IndexType coordCurNode = NodeToCoord(mainNodeListIndex);
+    for (unsigned int i = 0; i < numberOfNeighbors; ++i)
     {
-      numberOfNodesChecked++;
-      /*if ( (numberOfNodesChecked % (m_Graph_NumberOfNodes/100)) == 0)
-      {
-        MITK_INFO << "Checked " << ( numberOfNodesChecked / (m_Graph_NumberOfNodes/100) ) << "% List: " << myMap.size()
-      << "\n";
-      }*/
-
-      // Get element with lowest score
-      mainNodeListIndex = myMap.begin()->second->mainListIndex;
-      curNodeDistance = myMap.begin()->second->distance;
-      myMap.begin()->second->closed = true; // close it
-
-      // Debug:
-      // MITK_INFO << "INFO: size " << myMap.size();
-      /*
-      for (it = myMap.begin(); it != myMap.end(); ++it)
-      {
-      MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-      }
-      */
+      const IndexType coordNeighborNode = coordCurNode + m_NeighborOffsets[i];
+      if (!CoordIsInGraph(coordNeighborNode))
+        continue;
 
-      // Kicks out element with lowest score
-      myMap.erase(myMap.begin());
+      const auto neighborNodeIndex = static_cast<NodeNumType>(mainNodeListIndex + m_NeighborNodeOffsets[i]);
+      ShortestPathNode &neighborNode = m_Nodes[neighborNodeIndex];
+      if (neighborNode.closed)
+        continue; // this nodes is already closed, go to next neighbor
 
-      // if wanted, store vector order
-      if (m_StoreVectorOrder)
-      {
-        m_VectorOrder.push_back(mainNodeListIndex);
-      }
+      // calculate the new Distance to the current neighbor
+      double newDistance = curNodeDistance + (m_CostFunction->GetCost(coordCurNode, coordNeighborNode));
 
-      // Check neighbors
-      std::vector<ShortestPathNode *> neighborNodes = GetNeighbors(mainNodeListIndex, m_Graph_fullNeighbors);
-      for (NodeNumType i = 0; i < neighborNodes.size(); i++)
+      // if it is shorter than any yet known path to this neighbor, than the current path is better. Save that!
+      if ((newDistance < neighborNode.distance) || (neighborNode.distance == -1))
       {
-        if (neighborNodes[i]->closed)
-          continue; // this nodes is already closed, go to next neighbor
+        if (neighborNode.distance == -1)
+          m_Graph_DiscoveredNodeList.push_back(&neighborNode);
 
-        IndexType coordCurNode = NodeToCoord(mainNodeListIndex);
-        IndexType coordNeighborNode = NodeToCoord(neighborNodes[i]->mainListIndex);
+        neighborNode.distance = newDistance;
+        neighborNode.distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
+        neighborNode.prevNode = mainNodeListIndex;
 
-        // calculate the new Distance to the current neighbor
-        double newDistance = curNodeDistance + (m_CostFunction->GetCost(coordCurNode, coordNeighborNode));
-
-        // if it is shorter than any yet known path to this neighbor, than the current path is better. Save that!
-        if ((newDistance < neighborNodes[i]->distance) || (neighborNodes[i]->distance == -1))
+        // if that neighbornode is not in discoverednodeList yet, Push it there, otherwise update its position
+        if (m_OpenList.Contains(neighborNodeIndex))
         {
-          // if that neighbornode is not in discoverednodeList yet, Push it there and update
-          if (neighborNodes[i]->distance == -1)
-          {
-            neighborNodes[i]->distance = newDistance;
-            neighborNodes[i]->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
-            neighborNodes[i]->prevNode = mainNodeListIndex;
-            myMap.insert(std::pair<double, ShortestPathNode *>(m_Nodes[neighborNodes[i]->mainListIndex].distAndEst,
-                                                               &m_Nodes[neighborNodes[i]->mainListIndex]));
-            /*
-            MITK_INFO << "Inserted: " << m_Nodes[neighborNodes[i]->mainListIndex].distAndEst << "|" <<
-            m_Nodes[neighborNodes[i]->mainListIndex].mainListIndex;
-            MITK_INFO << "INFO: size " << myMap.size();
-            for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-            }
-            */
-          }
-          // or if is already in discoverednodelist, update
-          else
-          {
-            /*
-            it = myMap.find(neighborNodes[i]->distAndEst);
-            if (it == myMap.end() )
-            {
-            MITK_INFO << "Nothing!";
-            // look further
-            for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            if ((*it).second->mainListIndex == lookForId)
-            {
-            MITK_INFO << "But it is there!!!";
-            MITK_INFO << "Searched for: " << lookFor << "   but had: " << (*it).second->distAndEst;
-            }
+          m_OpenList.UpdateKey(neighborNodeIndex, neighborNode.distAndEst);
+        }
+        else
+        {
+          m_OpenList.Push(neighborNodeIndex, neighborNode.distAndEst);
+        }
+      }
+    }
+    // finished with checking all neighbors.
 
-            }
-            }
-            */
+    return mainNodeListIndex;
+  }
 
-            // 1st : find and delete old element
-            bool found = false;
-            ret = myMap.equal_range(neighborNodes[i]->distAndEst);
+  template <class TInputImageType, class TOutputImageType>
+  void ShortestPathImageFilter<TInputImageType, TOutputImageType>::StartShortestPathSearch()
+  {
+    // Setup Timer
+    clock_t startAll = clock();
+    clock_t stopAll = clock();
 
-            if ((ret.first == ret.second))
-            {
-              /*+++++++++++++ no exact match +++++++++++++*/
-              // MITK_INFO << "No exact match!"; // if this happens, you are screwed
-              /*
-              MITK_INFO << "Was looking for: " << lookFor << "  ID: " << lookForId;
-              if (ret.first != myMap.end() )
-              {
-              it = ret.first;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              ++it;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              --it;
-              --it;
-              MITK_INFO << "Found: " << it->first << "  ID: " << it->second->mainListIndex;
-              }
-
-              // look if that ID is found in the map
-              for (it = myMap.begin(); it != myMap.end(); ++it)
-              {
-              if ((*it).second->mainListIndex == lookForId)
-              {
-              MITK_INFO << "But it is there!!!";
-              MITK_INFO << "Searched dist: " << lookFor << "  found dist: " << (*it).second->distAndEst;
-              }
-
-              }
-              */
-            }
-            else
-            {
-              for (it = ret.first; it != ret.second; ++it)
-              {
-                if (it->second->mainListIndex == neighborNodes[i]->mainListIndex)
-                {
-                  found = true;
-                  myMap.erase(it);
-                  /*
-                  MITK_INFO << "INFO: size " << myMap.size();
-                  MITK_INFO << "Erase: " << it->first << "|" << it->second->mainListIndex;
-
-                  MITK_INFO << "INFO: size " << myMap.size();
-                  for (it = myMap.begin(); it != myMap.end(); ++it)
-                  {
-                  MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-                  }
-                  */
-                  break;
-                }
-              }
-            }
+    // init variables
+    double durationAll = 0;
+    bool timeout = false;
+    NodeNumType mainNodeListIndex = 0;
+    m_SingleSourceSearch = false;
 
-            if (!found)
-            {
-              // MITK_INFO << "Could not find it! :(";
-              continue;
-            }
+    // At first, only startNote is discovered.
+    m_OpenList.Clear();
+    m_OpenList.Push(m_Graph_StartNode, m_Nodes[m_Graph_StartNode].distAndEst);
 
-            // 2nd: update and insert new element
-            neighborNodes[i]->distance = newDistance;
-            neighborNodes[i]->distAndEst = newDistance + getEstimatedCostsToTarget(coordNeighborNode);
-            neighborNodes[i]->prevNode = mainNodeListIndex;
-            // myMap.insert( std::pair<double,ShortestPathNode*> (neighborNodes[i]->distAndEst, neighborNodes[i]));
-            myMap.insert(std::pair<double, ShortestPathNode *>(m_Nodes[neighborNodes[i]->mainListIndex].distAndEst,
-                                                               &m_Nodes[neighborNodes[i]->mainListIndex]));
-
-            // MITK_INFO << "Re-Inserted: " << m_Nodes[neighborNodes[i]->mainListIndex].distAndEst << "|" <<
-            // m_Nodes[neighborNodes[i]->mainListIndex].mainListIndex;
-            // MITK_INFO << "INFO: size " << myMap.size();
-            /*for (it = myMap.begin(); it != myMap.end(); ++it)
-            {
-            MITK_INFO << "(1) " << it->first << "|" << it->second->distAndEst << "|"<<it->second->mainListIndex;
-            }*/
-          }
-        }
-      }
-      // finished with checking all neighbors.
+    // While there are discovered Nodes, pick the one with lowest distance,
+    // update its neighbors and eventually delete it from the discovered Nodes list.
+    while (!m_OpenList.IsEmpty())
+    {
+      mainNodeListIndex = CloseNextNode();
 
       // Check Timeout, if activated
       if (m_ActivateTimeOut)
@@ -791,6 +565,7 @@ namespace itk
       double newVal = m_Nodes[myNodeNum].distance;
       distanceImageIt.Set(newVal);
     }
+    return image;
   }
 
   template <class TInputImageType, class TOutputImageType>
@@ -807,6 +582,75 @@ namespace itk
     return m_MultipleVectorPaths;
   }
 
+  template <class TInputImageType, class TOutputImageType>
+  void ShortestPathImageFilter<TInputImageType, TOutputImageType>::SearchShortestPath()
+  {
+    InitGraph();
+    StartShortestPathSearch();
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  void ShortestPathImageFilter<TInputImageType, TOutputImageType>::InitializeSingleSourceSearch()
+  {
+    // always start with a fresh graph, the nodes of a former search are not reused
+    m_Initialized = false;
+    InitGraph();
+
+    m_SingleSourceSearch = true;
+    m_OpenList.Clear();
+    m_OpenList.Push(m_Graph_StartNode, m_Nodes[m_Graph_StartNode].distAndEst);
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  bool ShortestPathImageFilter<TInputImageType, TOutputImageType>::ContinueSingleSourceSearch(
+    NodeNumType maximumNumberOfNodes)
+  {
+    for (NodeNumType i = 0; i < maximumNumberOfNodes && !m_OpenList.IsEmpty(); ++i)
+      CloseNextNode();
+
+    return m_OpenList.IsEmpty();
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  bool ShortestPathImageFilter<TInputImageType, TOutputImageType>::IsClosed(const IndexType &index)
+  {
+    return m_Initialized && CoordIsInGraph(index) && m_Nodes[CoordToNode(index)].closed;
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  DistanceType ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetDistance(const IndexType &index)
+  {
+    if (!m_Initialized || !CoordIsInGraph(index))
+      return -1;
+
+    return m_Nodes[CoordToNode(index)].distance;
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  std::vector<typename ShortestPathImageFilter<TInputImageType, TOutputImageType>::IndexType>
+    ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetPathTo(const IndexType &index)
+  {
+    std::vector<IndexType> path;
+    if (!m_Initialized || !CoordIsInGraph(index))
+      return path;
+
+    // Go backwards from the node to startnode, the node has to be discovered
+    NodeNumType prevNode = CoordToNode(index);
+    if (m_Nodes[prevNode].distance == -1)
+      return path;
+
+    while (prevNode != m_Graph_StartNode)
+    {
+      path.push_back(NodeToCoord(prevNode));
+      prevNode = m_Nodes[prevNode].prevNode;
+    }
+    path.push_back(NodeToCoord(prevNode));
+
+    // reverse it
+    std::reverse(path.begin(), path.end());
+    return path;
+  }
+
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::MakeShortestPathVector()
   {
@@ -859,8 +703,11 @@ namespace itk
     m_VectorPath.clear();
     // TODO: if multiple Path, clear all multiple Paths
 
-    if (m_Nodes)
-      delete[] m_Nodes;
+    // release the node list, the next search has to initialize the graph again
+    std::vector<ShortestPathNode>().swap(m_Nodes);
+    std::vector<ShortestPathNode *>().swap(m_Graph_DiscoveredNodeList);
+    m_Graph_NumberOfNodes = 0;
+    m_Initialized = false;
   }
 
   template <class TInputImageType, class TOutputImageType>
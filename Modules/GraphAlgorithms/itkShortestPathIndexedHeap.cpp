@@ -0,0 +1,134 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include "itkShortestPathIndexedHeap.h"
+
+namespace itk
+{
+  const NodeNumType ShortestPathIndexedHeap::InvalidPosition;
+
+  ShortestPathIndexedHeap::ShortestPathIndexedHeap() : m_NextOrder(0)
+  {
+  }
+
+  void ShortestPathIndexedHeap::Initialize(NodeNumType numberOfNodes)
+  {
+    if (m_Positions.size() != numberOfNodes)
+    {
+      m_Entries.clear();
+      m_Positions.assign(numberOfNodes, InvalidPosition);
+    }
+    else
+    {
+      this->Clear();
+    }
+    m_NextOrder = 0;
+  }
+
+  void ShortestPathIndexedHeap::Clear()
+  {
+    for (const auto &entry : m_Entries)
+      m_Positions[entry.node] = InvalidPosition;
+
+    m_Entries.clear();
+  }
+
+  void ShortestPathIndexedHeap::Push(NodeNumType node, DistanceType key)
+  {
+    Entry entry;
+    entry.key = key;
+    entry.order = m_NextOrder++;
+    entry.node = node;
+
+    m_Entries.push_back(entry);
+    m_Positions[node] = static_cast<NodeNumType>(m_Entries.size() - 1);
+    this->SiftUp(m_Positions[node]);
+  }
+
+  void ShortestPathIndexedHeap::UpdateKey(NodeNumType node, DistanceType key)
+  {
+    auto position = m_Positions[node];
+    bool decreased = key < m_Entries[position].key;
+
+    m_Entries[position].key = key;
+    m_Entries[position].order = m_NextOrder++;
+
+    if (decreased)
+      this->SiftUp(position);
+    else
+      this->SiftDown(position);
+  }
+
+  NodeNumType ShortestPathIndexedHeap::Pop()
+  {
+    auto top = m_Entries.front().node;
+    m_Positions[top] = InvalidPosition;
+
+    if (m_Entries.size() > 1)
+    {
+      m_Entries.front() = m_Entries.back();
+      m_Positions[m_Entries.front().node] = 0;
+      m_Entries.pop_back();
+      this->SiftDown(0);
+    }
+    else
+    {
+      m_Entries.pop_back();
+    }
+
+    return top;
+  }
+
+  void ShortestPathIndexedHeap::SiftUp(NodeNumType position)
+  {
+    auto entry = m_Entries[position];
+
+    while (position > 0)
+    {
+      auto parent = (position - 1) / 2;
+      if (!IsLess(entry, m_Entries[parent]))
+        break;
+
+      m_Entries[position] = m_Entries[parent];
+      m_Positions[m_Entries[position].node] = position;
+      position = parent;
+    }
+
+    m_Entries[position] = entry;
+    m_Positions[entry.node] = position;
+  }
+
+  void ShortestPathIndexedHeap::SiftDown(NodeNumType position)
+  {
+    auto entry = m_Entries[position];
+    const auto size = static_cast<NodeNumType>(m_Entries.size());
+
+    while (true)
+    {
+      auto child = 2 * position + 1;
+      if (child >= size)
+        break;
+
+      if (child + 1 < size && IsLess(m_Entries[child + 1], m_Entries[child]))
+        ++child;
+
+      if (!IsLess(m_Entries[child], entry))
+        break;
+
+      m_Entries[position] = m_Entries[child];
+      m_Positions[m_Entries[position].node] = position;
+      position = child;
+    }
+
+    m_Entries[position] = entry;
+    m_Positions[entry.node] = position;
+  }
+}
@@ -0,0 +1,86 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __itkShortestPathIndexedHeap_h_
+#define __itkShortestPathIndexedHeap_h_
+
+#include "MitkGraphAlgorithmsExports.h"
+#include "itkShortestPathNode.h"
+
+#include <vector>
+
+namespace itk
+{
+  /** \brief Indexed binary min-heap of node numbers, used as open list by ShortestPathImageFilter.
+
+  The heap stores the position of every node it contains in a flat table, thus Contains and
+  UpdateKey are O(1) and O(log n) instead of a search through the whole open list.
+  Nodes with equal keys are popped in the order they were pushed (or their key was updated),
+  which is the order of the std::multimap used before.
+
+  All storage is reused between searches. Clear only touches the nodes that are still contained.
+  */
+  class MITKGRAPHALGORITHMS_EXPORT ShortestPathIndexedHeap
+  {
+  public:
+    ShortestPathIndexedHeap();
+
+    /** \brief Prepares the heap for nodes with numbers in [0, numberOfNodes) and empties it.*/
+    void Initialize(NodeNumType numberOfNodes);
+
+    /** \brief Removes all nodes from the heap.*/
+    void Clear();
+
+    bool IsEmpty() const { return m_Entries.empty(); }
+
+    std::size_t GetSize() const { return m_Entries.size(); }
+
+    bool Contains(NodeNumType node) const { return m_Positions[node] != InvalidPosition; }
+
+    /** \brief Adds a node that is not yet contained in the heap.*/
+    void Push(NodeNumType node, DistanceType key);
+
+    /** \brief Changes the key of a contained node. Usually the key is lowered, but ShortestPathImageFilter
+    may also raise it, if the target and thus the estimated costs change during a search.*/
+    void UpdateKey(NodeNumType node, DistanceType key);
+
+    /** \brief Removes the node with the lowest key from the heap and returns it.*/
+    NodeNumType Pop();
+
+    NodeNumType GetTop() const { return m_Entries.front().node; }
+
+    DistanceType GetTopKey() const { return m_Entries.front().key; }
+
+  private:
+    struct Entry
+    {
+      DistanceType key;
+      unsigned long long order; // insertion order, breaks ties between equal keys
+      NodeNumType node;
+    };
+
+    static const NodeNumType InvalidPosition = static_cast<NodeNumType>(-1);
+
+    static bool IsLess(const Entry &a, const Entry &b)
+    {
+      return a.key < b.key || (a.key == b.key && a.order < b.order);
+    }
+
+    void SiftUp(NodeNumType position);
+    void SiftDown(NodeNumType position);
+
+    std::vector<Entry> m_Entries;
+    std::vector<NodeNumType> m_Positions; // position of each node in m_Entries, InvalidPosition if not contained
+    unsigned long long m_NextOrder;
+  };
+}
+
+#endif
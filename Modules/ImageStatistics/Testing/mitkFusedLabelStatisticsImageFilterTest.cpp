@@ -0,0 +1,208 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include <mitkExtendedLabelStatisticsImageFilter.h>
+#include <mitkFusedLabelStatisticsImageFilter.h>
+#include <mitkMinMaxLabelmageFilterWithIndex.h>
+#include <mitkNumericConstants.h>
+
+#include <itkImageRegionIterator.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <map>
+#include <random>
+
+class mitkFusedLabelStatisticsImageFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkFusedLabelStatisticsImageFilterTestSuite);
+  MITK_TEST(CompareWithSeparateFiltersShort);
+  MITK_TEST(CompareWithSeparateFiltersFloat);
+  MITK_TEST(CompareWithSeparateFiltersBinSize);
+  MITK_TEST(WideValueRangeFallsBackToHistogramPass);
+  MITK_TEST(ExhaustedCountBudgetFallsBackToHistogramPass);
+  MITK_TEST(NoLabelImage);
+  CPPUNIT_TEST_SUITE_END();
+
+  typedef itk::Image<unsigned short, 3> LabelImageType;
+
+  template <typename TImage>
+  typename TImage::Pointer CreateImage(double minValue, double maxValue, unsigned int seed)
+  {
+    typename TImage::Pointer image = TImage::New();
+    typename TImage::SizeType size;
+    size.Fill(40);
+    image->SetRegions(typename TImage::RegionType(size));
+    image->Allocate();
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(minValue, maxValue);
+    for (itk::ImageRegionIterator<TImage> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<typename TImage::PixelType>(distribution(generator)));
+    }
+    return image;
+  }
+
+  LabelImageType::Pointer CreateLabelImage()
+  {
+    // blocks of labels with different sizes, including the background label 0
+    LabelImageType::Pointer labels = LabelImageType::New();
+    LabelImageType::SizeType size;
+    size.Fill(40);
+    labels->SetRegions(LabelImageType::RegionType(size));
+    labels->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<LabelImageType> it(labels, labels->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      auto index = it.GetIndex();
+      it.Set(static_cast<unsigned short>((index[0] / 10) + 4 * (index[2] / 20)));
+    }
+    return labels;
+  }
+
+  template <typename TImage>
+  void CompareWithSeparateFilters(typename TImage::Pointer image, bool useBinSize, itk::SizeValueType maximumNumberOfCountedValues = 0)
+  {
+    typedef itk::FusedLabelStatisticsImageFilter<TImage, LabelImageType> FusedFilterType;
+    typedef itk::ExtendedLabelStatisticsImageFilter<TImage, LabelImageType> StatisticsFilterType;
+    typedef itk::MinMaxLabelImageFilterWithIndex<TImage, LabelImageType> MinMaxFilterType;
+    typedef typename TImage::PixelType PixelType;
+
+    auto labels = CreateLabelImage();
+
+    typename FusedFilterType::Pointer fused = FusedFilterType::New();
+    fused->SetInput(image);
+    fused->SetLabelInput(labels);
+    if (maximumNumberOfCountedValues > 0)
+    {
+      fused->SetMaximumNumberOfCountedValues(maximumNumberOfCountedValues);
+    }
+    if (useBinSize)
+    {
+      fused->SetHistogramBinSize(3.);
+    }
+    else
+    {
+      fused->SetHistogramNumberOfBins(50);
+    }
+    fused->UpdateLargestPossibleRegion();
+
+    typename MinMaxFilterType::Pointer minMax = MinMaxFilterType::New();
+    minMax->SetInput(image);
+    minMax->SetLabelInput(labels);
+    minMax->UpdateLargestPossibleRegion();
+
+    std::map<unsigned short, unsigned int> nBins;
+    std::map<unsigned short, PixelType> minVals, maxVals;
+    for (auto label : minMax->GetRelevantLabels())
+    {
+      minVals[label] = minMax->GetMin(label);
+      maxVals[label] = minMax->GetMax(label);
+      nBins[label] = useBinSize ? std::max(static_cast<double>(std::ceil(maxVals[label] - minVals[label])) / 3., 10.) : 50;
+    }
+
+    typename StatisticsFilterType::Pointer statistics = StatisticsFilterType::New();
+    statistics->SetInput(image);
+    statistics->SetLabelInput(labels);
+    statistics->SetHistogramParametersForLabels(nBins, minVals, maxVals);
+    statistics->Update();
+
+    CPPUNIT_ASSERT_EQUAL(minMax->GetRelevantLabels().size(), fused->GetRelevantLabels().size());
+
+    for (auto label : fused->GetRelevantLabels())
+    {
+      const auto &result = fused->GetStatistics(label);
+      CPPUNIT_ASSERT_EQUAL(static_cast<double>(minMax->GetMin(label)), static_cast<double>(result.m_Min));
+      CPPUNIT_ASSERT_EQUAL(static_cast<double>(minMax->GetMax(label)), static_cast<double>(result.m_Max));
+      CPPUNIT_ASSERT_EQUAL(result.m_Min, image->GetPixel(result.m_MinIndex));
+      CPPUNIT_ASSERT_EQUAL(result.m_Max, image->GetPixel(result.m_MaxIndex));
+      CPPUNIT_ASSERT_EQUAL(label, labels->GetPixel(result.m_MinIndex));
+      CPPUNIT_ASSERT_EQUAL(label, labels->GetPixel(result.m_MaxIndex));
+
+      const double tolerance = 1e-6;
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetMean(label), result.m_Mean, tolerance * std::abs(result.m_Mean) + tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetSigma(label), result.m_Sigma, tolerance * result.m_Sigma + tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetVariance(label), result.m_Variance, tolerance * result.m_Variance + tolerance);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetSkewness(label), result.m_Skewness, 1e-4);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetKurtosis(label), result.m_Kurtosis, 1e-4);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetMPP(label), result.m_MPP, tolerance * std::abs(result.m_MPP) + tolerance);
+
+      // histograms have to match bin by bin, so the derived statistics are identical
+      auto expectedHistogram = statistics->GetHistogram(label);
+      CPPUNIT_ASSERT_EQUAL(expectedHistogram->GetSize(0), result.m_Histogram->GetSize(0));
+      for (unsigned int bin = 0; bin < expectedHistogram->GetSize(0); ++bin)
+      {
+        CPPUNIT_ASSERT_EQUAL(expectedHistogram->GetFrequency(bin), result.m_Histogram->GetFrequency(bin));
+      }
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetMedian(label), result.m_Median, mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetEntropy(label), result.m_Entropy, mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetUniformity(label), result.m_Uniformity, mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(statistics->GetUPP(label), result.m_UPP, mitk::eps);
+    }
+  }
+
+public:
+  void CompareWithSeparateFiltersShort()
+  {
+    CompareWithSeparateFilters<itk::Image<short, 3>>(CreateImage<itk::Image<short, 3>>(-200., 300., 1), false);
+  }
+
+  void CompareWithSeparateFiltersFloat()
+  {
+    CompareWithSeparateFilters<itk::Image<float, 3>>(CreateImage<itk::Image<float, 3>>(-2., 5., 2), false);
+  }
+
+  void CompareWithSeparateFiltersBinSize()
+  {
+    CompareWithSeparateFilters<itk::Image<short, 3>>(CreateImage<itk::Image<short, 3>>(-200., 300., 3), true);
+  }
+
+  void WideValueRangeFallsBackToHistogramPass()
+  {
+    // the value range of every label exceeds the counted range, so the histograms are filled in a second pass
+    CompareWithSeparateFilters<itk::Image<int, 3>>(CreateImage<itk::Image<int, 3>>(-1e6, 1e6, 4), false);
+  }
+
+  void ExhaustedCountBudgetFallsBackToHistogramPass()
+  {
+    // the budget only suffices for some of the labels and threads, the others are filled in a second pass
+    CompareWithSeparateFilters<itk::Image<short, 3>>(CreateImage<itk::Image<short, 3>>(-200., 300., 6), false, 1000);
+  }
+
+  void NoLabelImage()
+  {
+    typedef itk::Image<short, 3> ImageType;
+    typedef itk::FusedLabelStatisticsImageFilter<ImageType, LabelImageType> FusedFilterType;
+
+    auto image = CreateImage<ImageType>(-50., 50., 5);
+    image->SetPixel({{1, 2, 3}}, -100);
+    image->SetPixel({{4, 5, 6}}, 100);
+
+    FusedFilterType::Pointer fused = FusedFilterType::New();
+    fused->SetInput(image);
+    fused->UpdateLargestPossibleRegion();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), fused->GetRelevantLabels().size());
+    const auto &result = fused->GetStatistics(1);
+    CPPUNIT_ASSERT_EQUAL(image->GetLargestPossibleRegion().GetNumberOfPixels(), result.m_Count);
+    CPPUNIT_ASSERT_EQUAL(short(-100), result.m_Min);
+    CPPUNIT_ASSERT_EQUAL(short(100), result.m_Max);
+    CPPUNIT_ASSERT(result.m_MinIndex == ImageType::IndexType({{1, 2, 3}}));
+    CPPUNIT_ASSERT(result.m_MaxIndex == ImageType::IndexType({{4, 5, 6}}));
+    CPPUNIT_ASSERT_THROW(fused->GetStatistics(2), itk::ExceptionObject);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkFusedLabelStatisticsImageFilter)
@@ -0,0 +1,271 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include <mitkFusedLabelStatisticsImageFilter.h>
+#include <mitkIncrementalImageStatisticsCalculator.h>
+#include <mitkImageCast.h>
+#include <mitkImageMaskGenerator.h>
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkImageStatisticsConstants.h>
+#include <mitkITKImageImport.h>
+
+#include <itkImageRegionIterator.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <functional>
+#include <random>
+
+class mitkIncrementalImageStatisticsCalculatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIncrementalImageStatisticsCalculatorTestSuite);
+  MITK_TEST(UpdateRegionMatchesRecomputation);
+  MITK_TEST(UpdateRegionFloatImage);
+  MITK_TEST(UpdateRegionByGeometry);
+  MITK_TEST(RemovedLabelIsUnknown);
+  MITK_TEST(UnchangedLabelsAreNotRecomputed);
+  MITK_TEST(ImageStatisticsCalculatorUpdatesIncrementally);
+  CPPUNIT_TEST_SUITE_END();
+
+  typedef itk::Image<unsigned short, 3> LabelImageType;
+
+  LabelImageType::Pointer m_Labels;
+  mitk::Image::Pointer m_LabelImage;
+
+  template <typename TImage>
+  mitk::Image::Pointer CreateImage(double minValue, double maxValue)
+  {
+    typename TImage::Pointer image = TImage::New();
+    typename TImage::SizeType size;
+    size.Fill(30);
+    image->SetRegions(typename TImage::RegionType(size));
+    typename TImage::SpacingType spacing;
+    spacing.Fill(0.5);
+    image->SetSpacing(spacing);
+    image->Allocate();
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(minValue, maxValue);
+    for (itk::ImageRegionIterator<TImage> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<typename TImage::PixelType>(distribution(generator)));
+    }
+    return mitk::GrabItkImageMemory(image.GetPointer());
+  }
+
+  void PaintLabel(const LabelImageType::RegionType &region, unsigned short label)
+  {
+    for (itk::ImageRegionIterator<LabelImageType> it(m_Labels, region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(label);
+    }
+  }
+
+  /** The reference statistics are computed by the fused label statistics filter directly on the itk images, so a
+   *  bug in the incremental bookkeeping cannot hide in the reference as well.*/
+  template <typename TImage>
+  void AssertEqualToFusedLabelStatistics(const mitk::Image *image,
+                                         const std::function<mitk::ImageStatisticsContainer::Pointer(unsigned short)> &getStatistics)
+  {
+    typename TImage::Pointer itkImage;
+    mitk::CastToItkImage(image, itkImage);
+
+    auto filter = itk::FusedLabelStatisticsImageFilter<TImage, LabelImageType>::New();
+    filter->SetInput(itkImage);
+    filter->SetLabelInput(m_Labels);
+    filter->SetHistogramNumberOfBins(100);
+    filter->Update();
+
+    for (auto label : filter->GetRelevantLabels())
+    {
+      const auto &expected = filter->GetStatistics(label);
+      const auto &actualObj = getStatistics(label)->GetStatisticsForTimeStep(0);
+
+      CPPUNIT_ASSERT_EQUAL(static_cast<mitk::ImageStatisticsContainer::VoxelCountType>(expected.m_Count),
+                           actualObj.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+      const std::vector<std::pair<std::string, double>> expectedValues = {
+        { mitk::ImageStatisticsConstants::VOLUME(), expected.m_Count * 0.125 },
+        { mitk::ImageStatisticsConstants::MEAN(), expected.m_Mean },
+        { mitk::ImageStatisticsConstants::MINIMUM(), static_cast<double>(expected.m_Min) },
+        { mitk::ImageStatisticsConstants::MAXIMUM(), static_cast<double>(expected.m_Max) },
+        { mitk::ImageStatisticsConstants::STANDARDDEVIATION(), expected.m_Sigma },
+        { mitk::ImageStatisticsConstants::SKEWNESS(), expected.m_Skewness },
+        { mitk::ImageStatisticsConstants::KURTOSIS(), expected.m_Kurtosis },
+        { mitk::ImageStatisticsConstants::MPP(), expected.m_MPP },
+        { mitk::ImageStatisticsConstants::MEDIAN(), expected.m_Median },
+        { mitk::ImageStatisticsConstants::ENTROPY(), expected.m_Entropy },
+        { mitk::ImageStatisticsConstants::UNIFORMITY(), expected.m_Uniformity },
+        { mitk::ImageStatisticsConstants::UPP(), expected.m_UPP } };
+
+      for (const auto &expectedValue : expectedValues)
+      {
+        auto actualValue = actualObj.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(expectedValue.first);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(expectedValue.first, expectedValue.second, actualValue,
+                                             1e-6 * std::abs(expectedValue.second) + 1e-6);
+      }
+
+      // image and label image share an identity geometry, so itk indices are the reported positions
+      auto minPosition = actualObj.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MINIMUMPOSITION());
+      auto maxPosition = actualObj.GetValueConverted<mitk::ImageStatisticsContainer::IndexType>(mitk::ImageStatisticsConstants::MAXIMUMPOSITION());
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_MinIndex[i]), static_cast<int>(minPosition[i]));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(expected.m_MaxIndex[i]), static_cast<int>(maxPosition[i]));
+      }
+    }
+  }
+
+  template <typename TImage>
+  void CheckUpdates(mitk::Image::Pointer image)
+  {
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(image);
+    calculator->SetLabelImage(m_LabelImage);
+    calculator->Initialize();
+
+    // paint a few "slices" as segmentation tools would do and update only the changed regions
+    LabelImageType::RegionType slice({{0, 0, 12}}, {{30, 30, 1}});
+    LabelImageType::RegionType box({{5, 5, 5}}, {{10, 4, 3}});
+    PaintLabel(slice, 2);
+    calculator->UpdateRegion(slice, 0);
+    PaintLabel(box, 3);
+    calculator->UpdateRegion(box, 0);
+    PaintLabel(box, 1);
+    calculator->UpdateRegion(box, 0);
+
+    AssertEqualToFusedLabelStatistics<TImage>(image, [&calculator](unsigned short label) {
+      return calculator->GetStatistics(label);
+    });
+  }
+
+public:
+  void setUp() override
+  {
+    m_Labels = LabelImageType::New();
+    LabelImageType::SizeType size;
+    size.Fill(30);
+    m_Labels->SetRegions(LabelImageType::RegionType(size));
+    LabelImageType::SpacingType spacing;
+    spacing.Fill(0.5);
+    m_Labels->SetSpacing(spacing);
+    m_Labels->Allocate();
+    m_Labels->FillBuffer(0);
+    PaintLabel(LabelImageType::RegionType({{10, 10, 10}}, {{10, 10, 10}}), 1);
+    m_LabelImage = mitk::GrabItkImageMemory(m_Labels.GetPointer());
+  }
+
+  void tearDown() override
+  {
+    m_LabelImage = nullptr;
+    m_Labels = nullptr;
+  }
+
+  void UpdateRegionMatchesRecomputation()
+  {
+    CheckUpdates<itk::Image<short, 3>>(CreateImage<itk::Image<short, 3>>(-1000., 2000.));
+  }
+
+  void UpdateRegionFloatImage()
+  {
+    CheckUpdates<itk::Image<float, 3>>(CreateImage<itk::Image<float, 3>>(-1., 1.));
+  }
+
+  void UpdateRegionByGeometry()
+  {
+    auto image = CreateImage<itk::Image<short, 3>>(0., 100.);
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(image);
+    calculator->SetLabelImage(m_LabelImage);
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::VoxelCountType(1000),
+                         calculator->GetStatistics(1)->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+    PaintLabel(LabelImageType::RegionType({{0, 0, 0}}, {{30, 30, 30}}), 1);
+    calculator->UpdateRegion(m_LabelImage->GetGeometry(), 0);
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::VoxelCountType(27000),
+                         calculator->GetStatistics(1)->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(27000 * 0.125,
+                                 calculator->GetStatistics(1)->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::VOLUME()),
+                                 mitk::eps);
+  }
+
+  void RemovedLabelIsUnknown()
+  {
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(CreateImage<itk::Image<short, 3>>(0., 100.));
+    calculator->SetLabelImage(m_LabelImage);
+    CPPUNIT_ASSERT_NO_THROW(calculator->GetStatistics(1));
+
+    LabelImageType::RegionType region({{10, 10, 10}}, {{10, 10, 10}});
+    PaintLabel(region, 0);
+    calculator->UpdateRegion(region, 0);
+    CPPUNIT_ASSERT_THROW(calculator->GetStatistics(1), mitk::Exception);
+  }
+
+  void UnchangedLabelsAreNotRecomputed()
+  {
+    PaintLabel(LabelImageType::RegionType({{0, 0, 25}}, {{30, 30, 5}}), 2);
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(CreateImage<itk::Image<short, 3>>(0., 100.));
+    calculator->SetLabelImage(m_LabelImage);
+
+    mitk::ImageStatisticsContainer::Pointer label1 = calculator->GetStatistics(1);
+    mitk::ImageStatisticsContainer::Pointer label2 = calculator->GetStatistics(2);
+    auto label1Histogram = label1->GetStatisticsForTimeStep(0).m_Histogram;
+    auto label1MTime = label1->GetMTime();
+    auto label2Histogram = label2->GetStatisticsForTimeStep(0).m_Histogram;
+
+    // move some background voxels to label 2; label 1 is not touched
+    LabelImageType::RegionType region({{0, 0, 22}}, {{30, 30, 2}});
+    PaintLabel(region, 2);
+    calculator->UpdateRegion(region, 0);
+
+    CPPUNIT_ASSERT(label1 == calculator->GetStatistics(1));
+    CPPUNIT_ASSERT(label1Histogram == label1->GetStatisticsForTimeStep(0).m_Histogram);
+    CPPUNIT_ASSERT_EQUAL(label1MTime, label1->GetMTime());
+
+    CPPUNIT_ASSERT(label2Histogram != calculator->GetStatistics(2)->GetStatisticsForTimeStep(0).m_Histogram);
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageStatisticsContainer::VoxelCountType(30 * 30 * 7),
+                         calculator->GetStatistics(2)->GetStatisticsForTimeStep(0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+  }
+
+  void ImageStatisticsCalculatorUpdatesIncrementally()
+  {
+    PaintLabel(LabelImageType::RegionType({{0, 0, 25}}, {{30, 30, 5}}), 2);
+    auto image = CreateImage<itk::Image<short, 3>>(-1000., 2000.);
+
+    auto maskGenerator = mitk::ImageMaskGenerator::New();
+    maskGenerator->SetImageMask(m_LabelImage);
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(image);
+    calculator->SetMask(maskGenerator);
+
+    mitk::ImageStatisticsContainer::Pointer label1 = calculator->GetStatistics(1);
+    auto label1Histogram = label1->GetStatisticsForTimeStep(0).m_Histogram;
+
+    // a tool erases a part of label 2 and reports the modification of the mask
+    PaintLabel(LabelImageType::RegionType({{0, 0, 25}}, {{30, 15, 3}}), 0);
+    m_LabelImage->Modified();
+
+    CPPUNIT_ASSERT(label1 == calculator->GetStatistics(1));
+    CPPUNIT_ASSERT(label1Histogram == label1->GetStatisticsForTimeStep(0).m_Histogram);
+
+    AssertEqualToFusedLabelStatistics<itk::Image<short, 3>>(image, [&calculator](unsigned short label) {
+      return calculator->GetStatistics(label);
+    });
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIncrementalImageStatisticsCalculator)
@@ -1,5 +1,6 @@
 set(CPP_FILES
   mitkImageStatisticsCalculator.cpp
+  mitkIncrementalImageStatisticsCalculator.cpp
   mitkImageStatisticsContainer.cpp
   mitkPointSetStatisticsCalculator.cpp
   mitkPointSetDifferenceStatisticsCalculator.cpp
@@ -22,6 +23,7 @@ set(CPP_FILES
 
 set(H_FILES
   mitkImageStatisticsCalculator.h
+  mitkIncrementalImageStatisticsCalculator.h
   mitkImageStatisticsContainer.h
   mitkPointSetDifferenceStatisticsCalculator.h
   mitkPointSetStatisticsCalculator.h
@@ -38,6 +40,7 @@ set(H_FILES
   mitkIgnorePixelMaskGenerator.h
   mitkMinMaxImageFilterWithIndex.h
   mitkMinMaxLabelmageFilterWithIndex.h
+  mitkFusedLabelStatisticsImageFilter.h
   mitkImageStatisticsPredicateHelper.h
   mitkImageStatisticsContainerNodeHelper.h
   mitkImageStatisticsContainerManager.h
@@ -0,0 +1,218 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_FUSEDLABELSTATISTICSIMAGEFILTER_H
+#define MITK_FUSEDLABELSTATISTICSIMAGEFILTER_H
+
+#include <itkImage.h>
+#include <itkImageToImageFilter.h>
+#include <itkHistogram.h>
+#include "itksys/hash_map.hxx"
+
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FusedLabelStatisticsImageFilter
+ * \brief Computes all statistics of mitk::ImageStatisticsCalculator for every label of a label image in a single pass.
+ *
+ * Count, sum, sum of squares, cubes and quadruples, positive pixel sum/count as well as minimum and maximum with their
+ * indices are accumulated per label and per thread and merged after all threads are done. This replaces the combination of
+ * MinMaxLabelImageFilterWithIndex and ExtendedLabelStatisticsImageFilter (resp. MinMaxImageFilterWithIndex and
+ * ExtendedStatisticsImageFilter without a label image), which needed separate passes over the image.
+ *
+ * The histogram of a label covers the range [minimum, maximum] of that label, which is only known after the pass. For
+ * integral pixel types the filter therefore counts the occurrences of every value per label while iterating and builds the
+ * histograms from these counts afterwards, so no further pass is needed. For floating point pixel types (and labels with a
+ * value range too large to be counted) the histograms are filled in an additional pass over the image. The counts of all
+ * labels and threads share a common budget (see SetMaximumNumberOfCountedValues), so the memory needed does not grow with
+ * labels x threads x distinct values; labels which do not fit into the budget any more also fall back to the additional pass.
+ *
+ * If no label image is set, all pixels are treated as label 1.
+ */
+template <typename TInputImage, typename TLabelImage>
+class FusedLabelStatisticsImageFilter: public itk::ImageToImageFilter<TInputImage, TInputImage>
+{
+public:
+    /** Standard Self typedef */
+    typedef FusedLabelStatisticsImageFilter                Self;
+    typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
+    typedef SmartPointer< Self >                           Pointer;
+    typedef SmartPointer< const Self >                     ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkNewMacro(Self);
+
+    /** Runtime information support. */
+    itkTypeMacro(FusedLabelStatisticsImageFilter, ImageToImageFilter);
+
+    typedef typename TInputImage::RegionType RegionType;
+    typedef typename TInputImage::IndexType  IndexType;
+    typedef typename TInputImage::PixelType  PixelType;
+    typedef typename NumericTraits< PixelType >::RealType RealType;
+
+    typedef typename TLabelImage::PixelType  LabelPixelType;
+
+    typedef itk::Statistics::Histogram<double> HistogramType;
+
+    /** Maximum number of distinct values counted per label and thread before falling back to a separate histogram pass. */
+    static const SizeValueType MaximumCountedValueRange = 1 << 16;
+
+    /**
+     * @brief Accumulated and derived statistics of a single label
+     */
+    class LabelStatistics
+    {
+    public:
+        LabelStatistics():
+            m_Count(0),
+            m_PositivePixelCount(0),
+            m_Sum(0), m_SumOfSquares(0), m_SumOfCubes(0), m_SumOfQuadruples(0), m_SumOfPositivePixels(0),
+            m_Min(NumericTraits<PixelType>::max()),
+            m_Max(NumericTraits<PixelType>::NonpositiveMin()),
+            m_Mean(0), m_MPP(0), m_Variance(0), m_Sigma(0), m_Skewness(0), m_Kurtosis(0),
+            m_Median(0), m_Entropy(0), m_Uniformity(0), m_UPP(0),
+            m_ValueCountsValid(std::numeric_limits<PixelType>::is_integer && sizeof(PixelType) < sizeof(long long)),
+            m_ValueOffset(0)
+        {
+            m_MinIndex.Fill(0);
+            m_MaxIndex.Fill(0);
+        }
+
+        SizeValueType m_Count;
+        SizeValueType m_PositivePixelCount;
+        RealType m_Sum, m_SumOfSquares, m_SumOfCubes, m_SumOfQuadruples, m_SumOfPositivePixels;
+        PixelType m_Min, m_Max;
+        IndexType m_MinIndex, m_MaxIndex;
+
+        RealType m_Mean, m_MPP, m_Variance, m_Sigma, m_Skewness, m_Kurtosis;
+        RealType m_Median, m_Entropy, m_Uniformity, m_UPP;
+        HistogramType::Pointer m_Histogram;
+
+        /** occurrences of the values [m_ValueOffset, m_ValueOffset + m_ValueCounts.size()), only used for integral pixel types */
+        bool m_ValueCountsValid;
+        long long m_ValueOffset;
+        std::vector<SizeValueType> m_ValueCounts;
+    };
+
+    typedef typename itksys::hash_map<LabelPixelType, LabelStatistics> StatisticsMapType;
+
+    /** Set the label image */
+    void SetLabelInput(const TLabelImage *input)
+    {
+      // Process object is not const-correct so the const casting is required.
+      this->SetNthInput( 1, const_cast< TLabelImage * >( input ) );
+    }
+
+    /** Get the label image */
+    const TLabelImage * GetLabelInput() const
+    {
+      return itkDynamicCastInDebugMode< TLabelImage * >( const_cast< DataObject * >( this->ProcessObject::GetInput(1) ) );
+    }
+
+    /** Use a fixed number of bins for the histogram of every label. */
+    void SetHistogramNumberOfBins(unsigned int nBins)
+    {
+      m_NumberOfBins = nBins;
+      m_UseBinSize = false;
+      this->Modified();
+    }
+
+    /** Derive the number of bins of each histogram from the value range of the label; at least 10 bins are used. */
+    void SetHistogramBinSize(double binSize)
+    {
+      m_BinSize = binSize;
+      m_UseBinSize = true;
+      this->Modified();
+    }
+
+    /** Maximum number of value counts kept for all labels and threads together, the default is 2^23 (64 MB). */
+    itkSetMacro(MaximumNumberOfCountedValues, SizeValueType);
+    itkGetConstMacro(MaximumNumberOfCountedValues, SizeValueType);
+
+    /** Returns all labels found in the label image, in ascending order. */
+    std::vector<LabelPixelType> GetRelevantLabels() const
+    {
+      return m_RelevantLabels;
+    }
+
+    bool HasLabel(LabelPixelType label) const
+    {
+      return m_LabelStatistics.find(label) != m_LabelStatistics.end();
+    }
+
+    /** Returns the statistics of the given label; throws if the label does not exist. */
+    const LabelStatistics& GetStatistics(LabelPixelType label) const
+    {
+      auto it = m_LabelStatistics.find(label);
+      if (it == m_LabelStatistics.end())
+      {
+        itkExceptionMacro(<< "invalid label " << label);
+      }
+      return it->second;
+    }
+
+protected:
+    FusedLabelStatisticsImageFilter():
+        m_NumberOfBins(100),
+        m_BinSize(10),
+        m_UseBinSize(false),
+        m_MaximumNumberOfCountedValues(1 << 23),
+        m_NumberOfCountedValues(0)
+    {
+      this->SetNumberOfRequiredInputs(1);
+    }
+
+    ~FusedLabelStatisticsImageFilter() override {}
+
+    void AllocateOutputs() override;
+
+    void ThreadedGenerateData(const RegionType &
+                                          outputRegionForThread,
+                                          ThreadIdType threadId) override;
+
+    void BeforeThreadedGenerateData() override;
+
+    void AfterThreadedGenerateData() override;
+
+private:
+    void AddValueCount(LabelStatistics& statistics, PixelType value);
+    static void MergeValueCounts(LabelStatistics& statistics, LabelStatistics& threadStatistics);
+
+    /** Drops the value counts of the label, its histogram is then filled in the additional pass. */
+    void DiscardValueCounts(LabelStatistics& statistics);
+
+    void InitializeHistogram(LabelStatistics& statistics) const;
+    void FillHistogramsFromImage();
+
+    std::vector<StatisticsMapType> m_ThreadStatistics;
+
+    StatisticsMapType m_LabelStatistics;
+    std::vector<LabelPixelType> m_RelevantLabels;
+
+    unsigned int m_NumberOfBins;
+    double m_BinSize;
+    bool m_UseBinSize;
+
+    SizeValueType m_MaximumNumberOfCountedValues;
+    /** value counts currently allocated by all threads */
+    std::atomic<SizeValueType> m_NumberOfCountedValues;
+};
+}
+
+#include "mitkFusedLabelStatisticsImageFilter.hxx"
+
+
+#endif
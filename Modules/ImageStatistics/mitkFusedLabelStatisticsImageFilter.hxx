@@ -0,0 +1,414 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_FusedLabelStatisticsImageFilter_HXX
+#define MITK_FusedLabelStatisticsImageFilter_HXX
+
+#include <mitkFusedLabelStatisticsImageFilter.h>
+#include <mitkHistogramStatisticsCalculator.h>
+
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace itk
+{
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::AllocateOutputs()
+{
+  // Pass the input through as the output
+  typename TInputImage::Pointer image =
+    const_cast< TInputImage * >( this->GetInput() );
+
+  this->GraftOutput(image);
+
+  // Nothing that needs to be allocated for the remaining outputs
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::DiscardValueCounts(LabelStatistics& statistics)
+{
+  m_NumberOfCountedValues -= statistics.m_ValueCounts.size();
+  statistics.m_ValueCountsValid = false;
+  statistics.m_ValueCounts.clear();
+  statistics.m_ValueCounts.shrink_to_fit();
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::AddValueCount(LabelStatistics& statistics, PixelType value)
+{
+  if (!statistics.m_ValueCountsValid)
+    return;
+
+  const long long v = static_cast<long long>(value);
+  const long long end = statistics.m_ValueOffset + static_cast<long long>(statistics.m_ValueCounts.size());
+
+  if (statistics.m_ValueCounts.empty() || v < statistics.m_ValueOffset || v >= end)
+  {
+    long long newBegin = v;
+    long long newEnd = v + 1;
+    if (!statistics.m_ValueCounts.empty())
+    {
+      newBegin = std::min(statistics.m_ValueOffset, v);
+      newEnd = std::max(end, v + 1);
+      if (static_cast<unsigned long long>(newEnd - newBegin) > MaximumCountedValueRange)
+      {
+        // too many distinct values, the histogram of this label is filled in a separate pass
+        DiscardValueCounts(statistics);
+        return;
+      }
+
+      // grow by half of the current range into the direction of the new value to amortize the copies
+      const long long slack = (newEnd - newBegin) / 2;
+      if (v < statistics.m_ValueOffset)
+        newBegin = std::max(newBegin - slack, static_cast<long long>(NumericTraits<PixelType>::NonpositiveMin()));
+      else
+        newEnd = std::min(newEnd + slack, static_cast<long long>(NumericTraits<PixelType>::max()) + 1);
+    }
+
+    // the counts of all labels and threads share one budget, labels exceeding it are filled in a separate pass
+    const SizeValueType added = static_cast<SizeValueType>(newEnd - newBegin) - statistics.m_ValueCounts.size();
+    if (m_NumberOfCountedValues.fetch_add(added) + added > m_MaximumNumberOfCountedValues)
+    {
+      m_NumberOfCountedValues -= added;
+      DiscardValueCounts(statistics);
+      return;
+    }
+
+    std::vector<SizeValueType> counts(newEnd - newBegin, 0);
+    if (!statistics.m_ValueCounts.empty())
+    {
+      std::copy(statistics.m_ValueCounts.begin(), statistics.m_ValueCounts.end(), counts.begin() + (statistics.m_ValueOffset - newBegin));
+    }
+    statistics.m_ValueCounts.swap(counts);
+    statistics.m_ValueOffset = newBegin;
+  }
+
+  ++statistics.m_ValueCounts[v - statistics.m_ValueOffset];
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::MergeValueCounts(LabelStatistics& statistics, LabelStatistics& threadStatistics)
+{
+  // the partial counts are released as soon as they are merged, so the merged counts do not add to the peak memory
+  std::vector<SizeValueType> partialCounts;
+  partialCounts.swap(threadStatistics.m_ValueCounts);
+
+  if (!statistics.m_ValueCountsValid || !threadStatistics.m_ValueCountsValid)
+  {
+    statistics.m_ValueCountsValid = false;
+    statistics.m_ValueCounts.clear();
+    statistics.m_ValueCounts.shrink_to_fit();
+    return;
+  }
+
+  if (partialCounts.empty())
+    return;
+
+  if (statistics.m_ValueCounts.empty())
+  {
+    statistics.m_ValueOffset = threadStatistics.m_ValueOffset;
+    statistics.m_ValueCounts.swap(partialCounts);
+    return;
+  }
+
+  const long long begin = std::min(statistics.m_ValueOffset, threadStatistics.m_ValueOffset);
+  const long long end = std::max(statistics.m_ValueOffset + static_cast<long long>(statistics.m_ValueCounts.size()),
+                                 threadStatistics.m_ValueOffset + static_cast<long long>(partialCounts.size()));
+
+  if (begin != statistics.m_ValueOffset || end != statistics.m_ValueOffset + static_cast<long long>(statistics.m_ValueCounts.size()))
+  {
+    std::vector<SizeValueType> counts(end - begin, 0);
+    std::copy(statistics.m_ValueCounts.begin(), statistics.m_ValueCounts.end(), counts.begin() + (statistics.m_ValueOffset - begin));
+    statistics.m_ValueCounts.swap(counts);
+    statistics.m_ValueOffset = begin;
+  }
+
+  const long long shift = threadStatistics.m_ValueOffset - statistics.m_ValueOffset;
+  for (std::size_t i = 0; i < partialCounts.size(); ++i)
+  {
+    statistics.m_ValueCounts[i + shift] += partialCounts[i];
+  }
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::ThreadedGenerateData(const RegionType &
+                                      outputRegionForThread,
+                                      ThreadIdType threadId)
+{
+  const SizeValueType size0 = outputRegionForThread.GetSize(0);
+  if( size0 == 0)
+    {
+    return;
+    }
+
+  StatisticsMapType& threadStatistics = m_ThreadStatistics[threadId];
+
+  const TLabelImage* labelImage = this->GetLabelInput();
+
+  ImageRegionConstIteratorWithIndex< TInputImage > it (this->GetInput(), outputRegionForThread);
+  ImageRegionConstIterator< TLabelImage > labelIt;
+  if (labelImage != nullptr)
+  {
+    labelIt = ImageRegionConstIterator< TLabelImage >(labelImage, outputRegionForThread);
+  }
+
+  // neighboring pixels mostly share their label, so the map is only searched if the label changes
+  LabelPixelType currentLabel = labelImage != nullptr ? labelIt.Get() : 1;
+  LabelStatistics* current = &threadStatistics[currentLabel];
+
+  // do the work
+  while ( !it.IsAtEnd() )
+  {
+    const PixelType value = it.Get();
+
+    if (labelImage != nullptr)
+    {
+      const LabelPixelType label = labelIt.Get();
+      if (label != currentLabel)
+      {
+        currentLabel = label;
+        current = &threadStatistics[currentLabel];
+      }
+      ++labelIt;
+    }
+
+    LabelStatistics& statistics = *current;
+    const RealType realValue = static_cast< RealType >( value );
+    const RealType square = realValue * realValue;
+
+    ++statistics.m_Count;
+    statistics.m_Sum += realValue;
+    statistics.m_SumOfSquares += square;
+    statistics.m_SumOfCubes += square * realValue;
+    statistics.m_SumOfQuadruples += square * square;
+
+    if (value > 0)
+    {
+      ++statistics.m_PositivePixelCount;
+      statistics.m_SumOfPositivePixels += realValue;
+    }
+
+    if (value < statistics.m_Min)
+    {
+      statistics.m_Min = value;
+      statistics.m_MinIndex = it.GetIndex();
+    }
+    if (value > statistics.m_Max)
+    {
+      statistics.m_Max = value;
+      statistics.m_MaxIndex = it.GetIndex();
+    }
+
+    AddValueCount(statistics, value);
+
+    ++it;
+  }
+
+  // the first label was inserted before looking at any pixel; drop it if it was never hit
+  for (auto mapIt = threadStatistics.begin(); mapIt != threadStatistics.end();)
+  {
+    if (mapIt->second.m_Count == 0)
+      threadStatistics.erase(mapIt++);
+    else
+      ++mapIt;
+  }
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::BeforeThreadedGenerateData()
+{
+  ThreadIdType numberOfThreads = this->GetNumberOfThreads();
+  m_ThreadStatistics.resize(numberOfThreads);
+
+  for (unsigned int i =0; i < numberOfThreads; i++)
+  {
+    m_ThreadStatistics[i] = StatisticsMapType();
+  }
+
+  m_LabelStatistics.clear();
+  m_RelevantLabels.clear();
+  m_NumberOfCountedValues = 0;
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::InitializeHistogram(LabelStatistics& statistics) const
+{
+  unsigned int nBins = m_NumberOfBins;
+  if (m_UseBinSize)
+  {
+    nBins = std::max(static_cast<double>(std::ceil(statistics.m_Max - statistics.m_Min)) / m_BinSize, 10.); // do not allow less than 10 bins
+  }
+
+  statistics.m_Histogram = HistogramType::New();
+  typename HistogramType::SizeType hsize;
+  typename HistogramType::MeasurementVectorType lb;
+  typename HistogramType::MeasurementVectorType ub;
+  hsize.SetSize(1);
+  lb.SetSize(1);
+  ub.SetSize(1);
+  statistics.m_Histogram->SetMeasurementVectorSize(1);
+  hsize[0] = nBins;
+  lb[0] = statistics.m_Min;
+  ub[0] = statistics.m_Max;
+  statistics.m_Histogram->Initialize(hsize, lb, ub);
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::FillHistogramsFromImage()
+{
+  typename HistogramType::IndexType histogramIndex(1);
+  typename HistogramType::MeasurementVectorType histogramMeasurement(1);
+
+  const TLabelImage* labelImage = this->GetLabelInput();
+  const RegionType region = this->GetOutput()->GetRequestedRegion();
+
+  ImageRegionConstIterator< TInputImage > it (this->GetInput(), region);
+  ImageRegionConstIterator< TLabelImage > labelIt;
+  if (labelImage != nullptr)
+  {
+    labelIt = ImageRegionConstIterator< TLabelImage >(labelImage, region);
+  }
+
+  for (; !it.IsAtEnd(); ++it)
+  {
+    LabelPixelType label = 1;
+    if (labelImage != nullptr)
+    {
+      label = labelIt.Get();
+      ++labelIt;
+    }
+
+    LabelStatistics& statistics = m_LabelStatistics[label];
+    if (statistics.m_ValueCountsValid)
+      continue;
+
+    histogramMeasurement[0] = it.Get();
+    statistics.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+    statistics.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+  }
+}
+
+template< typename TInputImage, typename TLabelImage >
+void FusedLabelStatisticsImageFilter< TInputImage, TLabelImage >::AfterThreadedGenerateData()
+{
+  // merge the partial results of all threads
+  for (auto& threadStatistics : m_ThreadStatistics)
+  {
+    for (auto& threadIt : threadStatistics)
+    {
+      auto mapIt = m_LabelStatistics.find(threadIt.first);
+      if (mapIt == m_LabelStatistics.end())
+      {
+        m_LabelStatistics[threadIt.first] = std::move(threadIt.second);
+        continue;
+      }
+
+      LabelStatistics& statistics = mapIt->second;
+      LabelStatistics& partial = threadIt.second;
+
+      statistics.m_Count += partial.m_Count;
+      statistics.m_PositivePixelCount += partial.m_PositivePixelCount;
+      statistics.m_Sum += partial.m_Sum;
+      statistics.m_SumOfSquares += partial.m_SumOfSquares;
+      statistics.m_SumOfCubes += partial.m_SumOfCubes;
+      statistics.m_SumOfQuadruples += partial.m_SumOfQuadruples;
+      statistics.m_SumOfPositivePixels += partial.m_SumOfPositivePixels;
+
+      if (partial.m_Min < statistics.m_Min)
+      {
+        statistics.m_Min = partial.m_Min;
+        statistics.m_MinIndex = partial.m_MinIndex;
+      }
+      if (partial.m_Max > statistics.m_Max)
+      {
+        statistics.m_Max = partial.m_Max;
+        statistics.m_MaxIndex = partial.m_MaxIndex;
+      }
+
+      MergeValueCounts(statistics, partial);
+    }
+  }
+  m_ThreadStatistics.clear();
+
+  bool histogramPassRequired = false;
+
+  typename HistogramType::IndexType histogramIndex(1);
+  typename HistogramType::MeasurementVectorType histogramMeasurement(1);
+
+  for (auto& mapIt : m_LabelStatistics)
+  {
+    m_RelevantLabels.push_back(mapIt.first);
+    LabelStatistics& ls = mapIt.second;
+
+    const RealType count = static_cast< RealType >( ls.m_Count );
+
+    ls.m_Mean = ls.m_Sum / count;
+    ls.m_MPP = ls.m_SumOfPositivePixels / static_cast< RealType >( ls.m_PositivePixelCount );
+    ls.m_Variance = ( ls.m_SumOfSquares - ls.m_Sum * ls.m_Sum / count ) / count;
+    ls.m_Sigma = std::sqrt( ls.m_Variance );
+
+    RealType secondMoment = ls.m_SumOfSquares / count;
+    RealType thirdMoment = ls.m_SumOfCubes / count;
+    RealType fourthMoment = ls.m_SumOfQuadruples / count;
+
+    ls.m_Skewness = (thirdMoment - 3. * secondMoment * ls.m_Mean + 2. * std::pow(ls.m_Mean, 3.)) / std::pow(secondMoment - std::pow(ls.m_Mean, 2.), 1.5); // see http://www.boost.org/doc/libs/1_51_0/doc/html/boost/accumulators/impl/skewness_impl.html
+    ls.m_Kurtosis = (fourthMoment - 4. * thirdMoment * ls.m_Mean + 6. * secondMoment * std::pow(ls.m_Mean, 2.) - 3. * std::pow(ls.m_Mean, 4.)) / std::pow(secondMoment - std::pow(ls.m_Mean, 2.), 2.); // see http://www.boost.org/doc/libs/1_51_0/doc/html/boost/accumulators/impl/kurtosis_impl.html, dropped -3
+
+    InitializeHistogram(ls);
+
+    if (ls.m_ValueCountsValid)
+    {
+      // every counted value goes into the bin the value itself would have been sorted into
+      for (std::size_t i = 0; i < ls.m_ValueCounts.size(); ++i)
+      {
+        if (ls.m_ValueCounts[i] == 0)
+          continue;
+
+        histogramMeasurement[0] = static_cast<PixelType>(ls.m_ValueOffset + static_cast<long long>(i));
+        ls.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+        ls.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, ls.m_ValueCounts[i]);
+      }
+      ls.m_ValueCounts.clear();
+      ls.m_ValueCounts.shrink_to_fit();
+    }
+    else
+    {
+      histogramPassRequired = true;
+    }
+  }
+
+  std::sort(m_RelevantLabels.begin(), m_RelevantLabels.end());
+
+  if (histogramPassRequired)
+  {
+    this->FillHistogramsFromImage();
+  }
+
+  for (auto& mapIt : m_LabelStatistics)
+  {
+    LabelStatistics& ls = mapIt.second;
+    mitk::HistogramStatisticsCalculator histStatCalc;
+    histStatCalc.SetHistogram(ls.m_Histogram);
+    histStatCalc.CalculateStatistics();
+    ls.m_Median = histStatCalc.GetMedian();
+    ls.m_Entropy = histStatCalc.GetEntropy();
+    ls.m_Uniformity = histStatCalc.GetUniformity();
+    ls.m_UPP = histStatCalc.GetUPP();
+  }
+}
+}
+#endif
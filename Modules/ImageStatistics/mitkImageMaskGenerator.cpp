@@ -25,6 +25,11 @@ void ImageMaskGenerator::SetImageMask(Image::Pointer maskImage)
     }
 }
 
+mitk::Image::ConstPointer ImageMaskGenerator::GetImageMask() const
+{
+    return m_internalMaskImage.GetPointer();
+}
+
 void ImageMaskGenerator::SetTimeStep(unsigned int timeStep)
 {
     if (timeStep != m_TimeStep)
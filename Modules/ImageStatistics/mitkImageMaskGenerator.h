@@ -40,6 +40,9 @@ public:
 
     void SetImageMask(mitk::Image::Pointer maskImage);
 
+    /** @brief Returns the mask image with all time steps, as set by SetImageMask */
+    mitk::Image::ConstPointer GetImageMask() const;
+
 protected:
     ImageMaskGenerator():Superclass(){
         m_InternalMaskUpdateTime = 0;
@@ -11,17 +11,15 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkImageStatisticsCalculator.h"
-#include <mitkExtendedLabelStatisticsImageFilter.h>
-#include <mitkExtendedStatisticsImageFilter.h>
+#include <mitkFusedLabelStatisticsImageFilter.h>
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkImageMaskGenerator.h>
 #include <mitkImageStatisticsConstants.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkImageToItk.h>
 #include <mitkMaskUtilities.h>
-#include <mitkMinMaxImageFilterWithIndex.h>
-#include <mitkMinMaxLabelmageFilterWithIndex.h>
 #include <mitkitkMaskImageFilter.h>
 
 namespace mitk
@@ -102,6 +100,32 @@ namespace mitk
       mitkThrow() << "Image not initialized!";
     }
 
+    auto labelImage = this->GetIncrementalLabelImage();
+    if (labelImage.IsNotNull())
+    {
+      if (this->IsIncrementalUpdateRequired(labelImage))
+      {
+        if (m_IncrementalCalculator.IsNull())
+        {
+          m_IncrementalCalculator = IncrementalImageStatisticsCalculator::New();
+        }
+        m_IncrementalCalculator->SetInputImage(m_Image);
+        m_IncrementalCalculator->SetLabelImage(labelImage);
+        if (m_UseBinSizeOverNBins)
+        {
+          m_IncrementalCalculator->SetBinSizeForHistogramStatistics(m_binSizeForHistogramStatistics);
+        }
+        else
+        {
+          m_IncrementalCalculator->SetNBinsForHistogramStatistics(m_nBinsForHistogramStatistics);
+        }
+        // starts from scratch for new inputs; otherwise only the changed voxels and labels are processed
+        m_IncrementalCalculator->UpdateAllRegions();
+        m_IncrementalUpdateTime.Modified();
+      }
+      return m_IncrementalCalculator->GetStatistics(label);
+    }
+
     if (IsUpdateRequired(label))
     {
       auto timeGeometry = m_Image->GetTimeGeometry();
@@ -172,8 +196,8 @@ namespace mitk
     typename itk::Image<TPixel, VImageDimension> *image, const TimeGeometry *timeGeometry, TimeStepType timeStep)
   {
     typedef typename itk::Image<TPixel, VImageDimension> ImageType;
-    typedef typename itk::ExtendedStatisticsImageFilter<ImageType> ImageStatisticsFilterType;
-    typedef typename itk::MinMaxImageFilterWithIndex<ImageType> MinMaxFilterType;
+    typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
+    typedef typename itk::FusedLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
 
     // reset statistics container if exists
     ImageStatisticsContainer::Pointer statisticContainerForImage;
@@ -192,28 +216,35 @@ namespace mitk
 
     auto statObj = ImageStatisticsContainer::ImageStatisticsObject();
 
+    // moments, min/max with index and the histogram are computed in a single multithreaded pass
     typename ImageStatisticsFilterType::Pointer statisticsFilter = ImageStatisticsFilterType::New();
     statisticsFilter->SetInput(image);
     statisticsFilter->SetCoordinateTolerance(0.001);
     statisticsFilter->SetDirectionTolerance(0.001);
 
-    // TODO: this is single threaded. Implement our own image filter that does this multi threaded
-    //        typename itk::MinimumMaximumImageCalculator<ImageType>::Pointer imgMinMaxFilter =
-    //        itk::MinimumMaximumImageCalculator<ImageType>::New(); imgMinMaxFilter->SetImage(image);
-    //        imgMinMaxFilter->Compute();
-    vnl_vector<int> minIndex, maxIndex;
+    if (m_UseBinSizeOverNBins)
+    {
+      statisticsFilter->SetHistogramBinSize(m_binSizeForHistogramStatistics);
+    }
+    else
+    {
+      statisticsFilter->SetHistogramNumberOfBins(m_nBinsForHistogramStatistics);
+    }
 
-    typename MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
-    minMaxFilter->SetInput(image);
-    minMaxFilter->UpdateLargestPossibleRegion();
-    typename ImageType::PixelType minval = minMaxFilter->GetMin();
-    typename ImageType::PixelType maxval = minMaxFilter->GetMax();
+    try
+    {
+      statisticsFilter->UpdateLargestPossibleRegion();
+    }
+    catch (const itk::ExceptionObject &e)
+    {
+      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
+    }
 
-    typename ImageType::IndexType tmpMinIndex = minMaxFilter->GetMinIndex();
-    typename ImageType::IndexType tmpMaxIndex = minMaxFilter->GetMaxIndex();
+    const auto &labelStatistics = statisticsFilter->GetStatistics(labelNoMask);
 
-    //        typename ImageType::IndexType tmpMinIndex = imgMinMaxFilter->GetIndexOfMinimum();
-    //        typename ImageType::IndexType tmpMaxIndex = imgMinMaxFilter->GetIndexOfMaximum();
+    vnl_vector<int> minIndex, maxIndex;
+    typename ImageType::IndexType tmpMinIndex = labelStatistics.m_MinIndex;
+    typename ImageType::IndexType tmpMaxIndex = labelStatistics.m_MaxIndex;
 
     minIndex.set_size(tmpMaxIndex.GetIndexDimension());
     maxIndex.set_size(tmpMaxIndex.GetIndexDimension());
@@ -227,56 +258,32 @@ namespace mitk
     statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
     statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
 
-    // convert m_binSize in m_nBins if necessary
-    unsigned int nBinsForHistogram;
-    if (m_UseBinSizeOverNBins)
-    {
-      nBinsForHistogram = std::max(static_cast<double>(std::ceil(maxval - minval)) / m_binSizeForHistogramStatistics,
-                                   10.); // do not allow less than 10 bins
-    }
-    else
-    {
-      nBinsForHistogram = m_nBinsForHistogramStatistics;
-    }
-
-    statisticsFilter->SetHistogramParameters(nBinsForHistogram, minval, maxval);
-
-    try
-    {
-      statisticsFilter->Update();
-    }
-    catch (const itk::ExceptionObject &e)
-    {
-      mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
-    }
-
     auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
 
     auto numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
     auto volume = static_cast<double>(numberOfPixels) * voxelVolume;
-    auto variance = statisticsFilter->GetSigma() * statisticsFilter->GetSigma();
-    auto rms =
-      std::sqrt(std::pow(statisticsFilter->GetMean(), 2.) + statisticsFilter->GetVariance()); // variance = sigma^2
+    auto variance = labelStatistics.m_Sigma * labelStatistics.m_Sigma;
+    auto rms = std::sqrt(std::pow(labelStatistics.m_Mean, 2.) + labelStatistics.m_Variance); // variance = sigma^2
 
     statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(),
                          static_cast<ImageStatisticsContainer::VoxelCountType>(numberOfPixels));
     statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), statisticsFilter->GetMean());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), labelStatistics.m_Mean);
     statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
-                         static_cast<ImageStatisticsContainer::RealType>(statisticsFilter->GetMinimum()));
+                         static_cast<ImageStatisticsContainer::RealType>(labelStatistics.m_Min));
     statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
-                         static_cast<ImageStatisticsContainer::RealType>(statisticsFilter->GetMaximum()));
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), statisticsFilter->GetSigma());
+                         static_cast<ImageStatisticsContainer::RealType>(labelStatistics.m_Max));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), labelStatistics.m_Sigma);
     statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), statisticsFilter->GetSkewness());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), statisticsFilter->GetKurtosis());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), labelStatistics.m_Skewness);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), labelStatistics.m_Kurtosis);
     statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), statisticsFilter->GetMPP());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), statisticsFilter->GetEntropy());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), statisticsFilter->GetMedian());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), statisticsFilter->GetUniformity());
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), statisticsFilter->GetUPP());
-    statObj.m_Histogram = statisticsFilter->GetHistogram().GetPointer();
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), labelStatistics.m_MPP);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), labelStatistics.m_Entropy);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), labelStatistics.m_Median);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), labelStatistics.m_Uniformity);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), labelStatistics.m_UPP);
+    statObj.m_Histogram = labelStatistics.m_Histogram.GetPointer();
     statisticContainerForImage->SetStatisticsForTimeStep(timeStep, statObj);
   }
 
@@ -300,10 +307,8 @@ namespace mitk
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
     typedef typename MaskType::PixelType LabelPixelType;
-    typedef itk::ExtendedLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
+    typedef itk::FusedLabelStatisticsImageFilter<ImageType, MaskType> ImageStatisticsFilterType;
     typedef MaskUtilities<TPixel, VImageDimension> MaskUtilType;
-    typedef typename itk::MinMaxLabelImageFilterWithIndex<ImageType, MaskType> MinMaxLabelFilterType;
-    typedef typename ImageType::PixelType InputImgPixelType;
 
     // workaround: if m_SecondaryMaskGenerator ist not null but m_MaskGenerator is! (this is the case if we request a
     // 'ignore zuero valued pixels' mask in the gui but do not define a primary mask)
@@ -373,51 +378,26 @@ namespace mitk
 
     adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
 
-    // find min, max, minindex and maxindex
-    typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
-    minMaxFilter->SetInput(adaptedImage);
-    minMaxFilter->SetLabelInput(maskImage);
-    minMaxFilter->UpdateLargestPossibleRegion();
-
-    // set histogram parameters for each label individually (min/max may be different for each label)
-    typedef typename std::map<LabelPixelType, InputImgPixelType> MapType;
-    typedef typename std::pair<LabelPixelType, InputImgPixelType> PairType;
-
-    std::vector<LabelPixelType> relevantLabels = minMaxFilter->GetRelevantLabels();
-    MapType minVals;
-    MapType maxVals;
-    std::map<LabelPixelType, unsigned int> nBins;
-
-    for (LabelPixelType label : relevantLabels)
-    {
-      minVals.insert(PairType(label, minMaxFilter->GetMin(label)));
-      maxVals.insert(PairType(label, minMaxFilter->GetMax(label)));
-
-      unsigned int nBinsForHistogram;
-      if (m_UseBinSizeOverNBins)
-      {
-        nBinsForHistogram =
-          std::max(static_cast<double>(std::ceil(minMaxFilter->GetMax(label) - minMaxFilter->GetMin(label))) /
-                     m_binSizeForHistogramStatistics,
-                   10.); // do not allow less than 10 bins
-      }
-      else
-      {
-        nBinsForHistogram = m_nBinsForHistogramStatistics;
-      }
-
-      nBins.insert(typename std::pair<LabelPixelType, unsigned int>(label, nBinsForHistogram));
-    }
-
+    // moments, min/max with index and the histograms of all labels are computed in a single multithreaded pass.
+    // The histogram of each label covers the value range of that label (min/max may be different for each label)
     typename ImageStatisticsFilterType::Pointer imageStatisticsFilter = ImageStatisticsFilterType::New();
     imageStatisticsFilter->SetDirectionTolerance(0.001);
     imageStatisticsFilter->SetCoordinateTolerance(0.001);
     imageStatisticsFilter->SetInput(adaptedImage);
     imageStatisticsFilter->SetLabelInput(maskImage);
-    imageStatisticsFilter->SetHistogramParametersForLabels(nBins, minVals, maxVals);
-    imageStatisticsFilter->Update();
 
-    std::list<int> labels = imageStatisticsFilter->GetRelevantLabels();
+    if (m_UseBinSizeOverNBins)
+    {
+      imageStatisticsFilter->SetHistogramBinSize(m_binSizeForHistogramStatistics);
+    }
+    else
+    {
+      imageStatisticsFilter->SetHistogramNumberOfBins(m_nBinsForHistogramStatistics);
+    }
+
+    imageStatisticsFilter->UpdateLargestPossibleRegion();
+
+    std::vector<LabelPixelType> labels = imageStatisticsFilter->GetRelevantLabels();
     auto it = labels.begin();
 
     while (it != labels.end())
@@ -439,17 +419,17 @@ namespace mitk
       }
 
       ImageStatisticsContainer::ImageStatisticsObject statObj;
+      const auto &labelStatistics = imageStatisticsFilter->GetStatistics(*it);
 
-      // find min, max, minindex and maxindex
-      // make sure to only look in the masked region, use a masker for this
+      // the min/max positions were found in the masked region only
 
       vnl_vector<int> minIndex, maxIndex;
       mitk::Point3D worldCoordinateMin;
       mitk::Point3D worldCoordinateMax;
       mitk::Point3D indexCoordinateMin;
       mitk::Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(*it), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(*it), worldCoordinateMax);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(labelStatistics.m_MinIndex, worldCoordinateMin);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(labelStatistics.m_MaxIndex, worldCoordinateMax);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
 
@@ -466,33 +446,30 @@ namespace mitk
       statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
 
-      assert(std::abs(minMaxFilter->GetMax(*it) - imageStatisticsFilter->GetMaximum(*it)) < mitk::eps);
-      assert(std::abs(minMaxFilter->GetMin(*it) - imageStatisticsFilter->GetMinimum(*it)) < mitk::eps);
-
       auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
-      auto numberOfVoxels =
-        static_cast<unsigned long>(imageStatisticsFilter->GetSum(*it) / (double)imageStatisticsFilter->GetMean(*it));
+      auto numberOfVoxels = static_cast<unsigned long>(labelStatistics.m_Count);
       auto volume = static_cast<double>(numberOfVoxels) * voxelVolume;
-      auto rms = std::sqrt(std::pow(imageStatisticsFilter->GetMean(*it), 2.) +
-                           imageStatisticsFilter->GetVariance(*it)); // variance = sigma^2
-      auto variance = imageStatisticsFilter->GetSigma(*it) * imageStatisticsFilter->GetSigma(*it);
+      auto rms = std::sqrt(std::pow(labelStatistics.m_Mean, 2.) + labelStatistics.m_Variance); // variance = sigma^2
+      auto variance = labelStatistics.m_Sigma * labelStatistics.m_Sigma;
 
       statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), volume);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), imageStatisticsFilter->GetMean(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), imageStatisticsFilter->GetMinimum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), imageStatisticsFilter->GetMaximum(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), imageStatisticsFilter->GetSigma(*it));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), labelStatistics.m_Mean);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(),
+                           static_cast<ImageStatisticsContainer::RealType>(labelStatistics.m_Min));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(),
+                           static_cast<ImageStatisticsContainer::RealType>(labelStatistics.m_Max));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), labelStatistics.m_Sigma);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), imageStatisticsFilter->GetSkewness(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), imageStatisticsFilter->GetKurtosis(*it));
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), labelStatistics.m_Skewness);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), labelStatistics.m_Kurtosis);
       statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), imageStatisticsFilter->GetMPP(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), imageStatisticsFilter->GetEntropy(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), imageStatisticsFilter->GetMedian(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), imageStatisticsFilter->GetUniformity(*it));
-      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), imageStatisticsFilter->GetUPP(*it));
-      statObj.m_Histogram = imageStatisticsFilter->GetHistogram(*it).GetPointer();
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), labelStatistics.m_MPP);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), labelStatistics.m_Entropy);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), labelStatistics.m_Median);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), labelStatistics.m_Uniformity);
+      statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), labelStatistics.m_UPP);
+      statObj.m_Histogram = labelStatistics.m_Histogram.GetPointer();
 
       statisticContainerForLabelImage->SetStatisticsForTimeStep(timeStep, statObj);
       ++it;
@@ -506,6 +483,56 @@ namespace mitk
     }
   }
 
+  mitk::Image::ConstPointer ImageStatisticsCalculator::GetIncrementalLabelImage() const
+  {
+    auto imageMaskGenerator = dynamic_cast<ImageMaskGenerator *>(m_MaskGenerator.GetPointer());
+    if (imageMaskGenerator == nullptr || m_SecondaryMaskGenerator.IsNotNull())
+    {
+      return nullptr;
+    }
+
+    auto referenceImage = imageMaskGenerator->GetReferenceImage();
+    if (referenceImage.IsNotNull() && referenceImage != m_Image)
+    {
+      return nullptr;
+    }
+
+    auto labelImage = imageMaskGenerator->GetImageMask();
+    if (labelImage.IsNull() || !labelImage->IsInitialized() || m_Image->GetDimension() > 4 ||
+        labelImage->GetDimension() != m_Image->GetDimension())
+    {
+      return nullptr;
+    }
+
+    for (unsigned int i = 0; i < std::min(m_Image->GetDimension(), 3u); ++i)
+    {
+      if (labelImage->GetDimension(i) != m_Image->GetDimension(i))
+      {
+        return nullptr;
+      }
+    }
+
+    if (!mitk::Equal(*(labelImage->GetGeometry()), *(m_Image->GetGeometry()), 0.001, false))
+    {
+      return nullptr;
+    }
+
+    return labelImage;
+  }
+
+  bool ImageStatisticsCalculator::IsIncrementalUpdateRequired(const mitk::Image *labelImage) const
+  {
+    if (m_IncrementalCalculator.IsNull())
+    {
+      return true;
+    }
+
+    const auto updateTime = m_IncrementalUpdateTime.GetMTime();
+
+    return this->GetMTime() > updateTime || m_Image->GetMTime() > updateTime ||
+           m_MaskGenerator->GetMTime() > updateTime || labelImage->GetMTime() > updateTime;
+  }
+
   bool ImageStatisticsCalculator::IsUpdateRequired(LabelIndex label) const
   {
     unsigned long thisClassTimeStamp = this->GetMTime();
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkMaskGenerator.h>
 #include <mitkImageStatisticsContainer.h>
+#include <mitkIncrementalImageStatisticsCalculator.h>
 
 namespace mitk
 {
@@ -73,6 +74,9 @@ namespace mitk
         /**Documentation
         @brief Returns the statistics for label @a label. If these requested statistics are not computed yet the computation is done as well.
         For performance reasons, statistics for all labels in the image are computed at once.
+        If the mask is an image mask (ImageMaskGenerator) with the geometry of the image and no secondary mask is set, the
+        statistics are kept by an IncrementalImageStatisticsCalculator: after the mask has been edited, only the changed
+        voxels are processed and only the statistics of the changed labels are recomputed.
          */
         ImageStatisticsContainer* GetStatistics(LabelIndex label=1);
 
@@ -98,6 +102,10 @@ namespace mitk
 
         bool IsUpdateRequired(LabelIndex label) const;
 
+        /** Returns the label image for the incremental calculation, or nullptr if the masks do not allow it */
+        mitk::Image::ConstPointer GetIncrementalLabelImage() const;
+        bool IsIncrementalUpdateRequired(const mitk::Image* labelImage) const;
+
         mitk::Image::ConstPointer m_Image;
         mitk::Image::Pointer m_ImageTimeSlice;
         mitk::Image::ConstPointer m_InternalImageForStatistics;
@@ -113,6 +121,9 @@ namespace mitk
         bool m_UseBinSizeOverNBins;
 
         std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
+
+        IncrementalImageStatisticsCalculator::Pointer m_IncrementalCalculator;
+        itk::TimeStamp m_IncrementalUpdateTime;
     };
 
 }
@@ -132,7 +132,7 @@ namespace mitk
     const ImageStatisticsObject& GetStatisticsForTimeStep(TimeStepType timeStep) const;
 
     /**
-    @brief Sets the statisticObject for the given Timestep
+    @brief Sets the statisticObject for the given Timestep, replacing a previously set one
     @pre timeStep must be valid
     */
     void SetStatisticsForTimeStep(TimeStepType timeStep, ImageStatisticsObject statistics);
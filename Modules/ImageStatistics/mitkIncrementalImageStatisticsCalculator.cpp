@@ -0,0 +1,774 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkIncrementalImageStatisticsCalculator.h"
+#include <mitkHistogramStatisticsCalculator.h>
+#include <mitkImageAccessByItk.h>
+#include <mitkImageStatisticsConstants.h>
+#include <mitkImageTimeSelector.h>
+
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  /** Maximum range of integral values counted in a dense array per label before switching to a map. */
+  const long long MaximumDenseValueRange = 1 << 16;
+
+  template <unsigned int VImageDimension>
+  itk::ImageRegion<VImageDimension> ConvertRegion(const mitk::IncrementalImageStatisticsCalculator::RegionType &region)
+  {
+    itk::ImageRegion<VImageDimension> result;
+    for (unsigned int i = 0; i < VImageDimension; ++i)
+    {
+      result.SetIndex(i, region.GetIndex(i));
+      result.SetSize(i, region.GetSize(i));
+    }
+    return result;
+  }
+
+  mitk::Image::Pointer SelectTimeStep(const mitk::Image *image, mitk::TimeStepType timeStep)
+  {
+    mitk::ImageTimeSelector::Pointer imgTimeSel = mitk::ImageTimeSelector::New();
+    imgTimeSel->SetInput(image);
+    imgTimeSel->SetTimeNr(std::min<mitk::TimeStepType>(timeStep, image->GetTimeSteps() - 1));
+    imgTimeSel->UpdateLargestPossibleRegion();
+    return imgTimeSel->GetOutput();
+  }
+}
+
+namespace mitk
+{
+  IncrementalImageStatisticsCalculator::LabelAccumulator::LabelAccumulator()
+    : m_Count(0),
+      m_PositivePixelCount(0),
+      m_Sum(0),
+      m_SumOfSquares(0),
+      m_SumOfCubes(0),
+      m_SumOfQuadruples(0),
+      m_SumOfPositivePixels(0),
+      m_MinPositionValid(false),
+      m_MaxPositionValid(false),
+      m_MinOffset(0),
+      m_MaxOffset(0),
+      m_MinPositionValue(0),
+      m_MaxPositionValue(0),
+      m_UseDenseCounts(true),
+      m_DenseOffset(0)
+  {
+  }
+
+  void IncrementalImageStatisticsCalculator::LabelAccumulator::Add(double value, itk::SizeValueType offset, bool countDense)
+  {
+    // keep the first voxel (in buffer order) of the extreme values, like ImageStatisticsCalculator does
+    if (m_Count == 0)
+    {
+      m_MinPositionValid = m_MaxPositionValid = true;
+      m_MinOffset = m_MaxOffset = offset;
+      m_MinPositionValue = m_MaxPositionValue = value;
+    }
+    else
+    {
+      if (m_MinPositionValid && (value < m_MinPositionValue || (value == m_MinPositionValue && offset < m_MinOffset)))
+      {
+        m_MinOffset = offset;
+        m_MinPositionValue = value;
+      }
+      if (m_MaxPositionValid && (value > m_MaxPositionValue || (value == m_MaxPositionValue && offset < m_MaxOffset)))
+      {
+        m_MaxOffset = offset;
+        m_MaxPositionValue = value;
+      }
+    }
+
+    const double square = value * value;
+    ++m_Count;
+    m_Sum += value;
+    m_SumOfSquares += square;
+    m_SumOfCubes += square * value;
+    m_SumOfQuadruples += square * square;
+    if (value > 0)
+    {
+      ++m_PositivePixelCount;
+      m_SumOfPositivePixels += value;
+    }
+
+    if (m_UseDenseCounts && !countDense)
+    {
+      this->SwitchToSparseCounts();
+    }
+
+    if (!m_UseDenseCounts)
+    {
+      ++m_SparseCounts[value];
+      return;
+    }
+
+    const auto v = static_cast<long long>(value);
+    const long long end = m_DenseOffset + static_cast<long long>(m_DenseCounts.size());
+    if (m_DenseCounts.empty())
+    {
+      m_DenseOffset = v;
+      m_DenseCounts.assign(1, 0);
+    }
+    else if (v < m_DenseOffset || v >= end)
+    {
+      long long newBegin = std::min(m_DenseOffset, v);
+      long long newEnd = std::max(end, v + 1);
+      if (newEnd - newBegin > MaximumDenseValueRange)
+      {
+        this->SwitchToSparseCounts();
+        ++m_SparseCounts[value];
+        return;
+      }
+
+      // grow by half of the current range into the direction of the new value to amortize the copies
+      const long long slack = (newEnd - newBegin) / 2;
+      if (v < m_DenseOffset)
+        newBegin -= slack;
+      else
+        newEnd += slack;
+
+      std::vector<itk::SizeValueType> counts(newEnd - newBegin, 0);
+      std::copy(m_DenseCounts.begin(), m_DenseCounts.end(), counts.begin() + (m_DenseOffset - newBegin));
+      m_DenseCounts.swap(counts);
+      m_DenseOffset = newBegin;
+    }
+    ++m_DenseCounts[v - m_DenseOffset];
+  }
+
+  void IncrementalImageStatisticsCalculator::LabelAccumulator::Remove(double value, itk::SizeValueType offset)
+  {
+    // another voxel may hold the extreme value, it is searched when the statistics are requested
+    if (offset == m_MinOffset)
+      m_MinPositionValid = false;
+    if (offset == m_MaxOffset)
+      m_MaxPositionValid = false;
+
+    const double square = value * value;
+    --m_Count;
+    m_Sum -= value;
+    m_SumOfSquares -= square;
+    m_SumOfCubes -= square * value;
+    m_SumOfQuadruples -= square * square;
+    if (value > 0)
+    {
+      --m_PositivePixelCount;
+      m_SumOfPositivePixels -= value;
+    }
+
+    if (m_UseDenseCounts)
+    {
+      --m_DenseCounts[static_cast<long long>(value) - m_DenseOffset];
+    }
+    else
+    {
+      auto it = m_SparseCounts.find(value);
+      if (--(it->second) == 0)
+      {
+        m_SparseCounts.erase(it);
+      }
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::LabelAccumulator::SwitchToSparseCounts()
+  {
+    for (std::size_t i = 0; i < m_DenseCounts.size(); ++i)
+    {
+      if (m_DenseCounts[i] > 0)
+      {
+        m_SparseCounts[static_cast<double>(m_DenseOffset + static_cast<long long>(i))] = m_DenseCounts[i];
+      }
+    }
+    m_DenseCounts.clear();
+    m_DenseCounts.shrink_to_fit();
+    m_UseDenseCounts = false;
+  }
+
+  template <typename TFunction>
+  void IncrementalImageStatisticsCalculator::LabelAccumulator::ForEachValue(TFunction function) const
+  {
+    if (m_UseDenseCounts)
+    {
+      for (std::size_t i = 0; i < m_DenseCounts.size(); ++i)
+      {
+        if (m_DenseCounts[i] > 0)
+        {
+          function(static_cast<double>(m_DenseOffset + static_cast<long long>(i)), m_DenseCounts[i]);
+        }
+      }
+    }
+    else
+    {
+      for (const auto &count : m_SparseCounts)
+      {
+        function(count.first, count.second);
+      }
+    }
+  }
+
+  double IncrementalImageStatisticsCalculator::LabelAccumulator::GetMinimum() const
+  {
+    if (!m_UseDenseCounts)
+    {
+      return m_SparseCounts.begin()->first;
+    }
+    auto it = std::find_if(m_DenseCounts.begin(), m_DenseCounts.end(), [](itk::SizeValueType c) { return c > 0; });
+    return static_cast<double>(m_DenseOffset + (it - m_DenseCounts.begin()));
+  }
+
+  double IncrementalImageStatisticsCalculator::LabelAccumulator::GetMaximum() const
+  {
+    if (!m_UseDenseCounts)
+    {
+      return m_SparseCounts.rbegin()->first;
+    }
+    auto it = std::find_if(m_DenseCounts.rbegin(), m_DenseCounts.rend(), [](itk::SizeValueType c) { return c > 0; });
+    return static_cast<double>(m_DenseOffset + static_cast<long long>(m_DenseCounts.size()) - 1 - (it - m_DenseCounts.rbegin()));
+  }
+
+  IncrementalImageStatisticsCalculator::IncrementalImageStatisticsCalculator()
+    : m_nBinsForHistogramStatistics(100),
+      m_binSizeForHistogramStatistics(10),
+      m_UseBinSizeOverNBins(false),
+      m_Initialized(false),
+      m_StatisticsOutdated(true),
+      m_ImageMTime(0)
+  {
+  }
+
+  IncrementalImageStatisticsCalculator::~IncrementalImageStatisticsCalculator() {}
+
+  void IncrementalImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
+  {
+    if (image != m_Image)
+    {
+      m_Image = image;
+      m_Initialized = false;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::SetLabelImage(const mitk::Image *labelImage)
+  {
+    if (labelImage != m_LabelImage)
+    {
+      m_LabelImage = labelImage;
+      m_Initialized = false;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::SetNBinsForHistogramStatistics(unsigned int nBins)
+  {
+    if (nBins != m_nBinsForHistogramStatistics || m_UseBinSizeOverNBins)
+    {
+      m_nBinsForHistogramStatistics = nBins;
+      m_UseBinSizeOverNBins = false;
+      m_StatisticsOutdated = true;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::SetBinSizeForHistogramStatistics(double binSize)
+  {
+    if (binSize != m_binSizeForHistogramStatistics || !m_UseBinSizeOverNBins)
+    {
+      m_binSizeForHistogramStatistics = binSize;
+      m_UseBinSizeOverNBins = true;
+      m_StatisticsOutdated = true;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::Initialize()
+  {
+    if (m_Image.IsNull() || m_LabelImage.IsNull())
+    {
+      mitkThrow() << "no image or no label image";
+    }
+
+    if (!m_Image->IsInitialized() || !m_LabelImage->IsInitialized())
+    {
+      mitkThrow() << "Image not initialized!";
+    }
+
+    if (m_Image->GetDimension() > 4)
+    {
+      mitkThrow() << "Only images with up to three dimensions plus time are supported.";
+    }
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (m_Image->GetDimension(i) != m_LabelImage->GetDimension(i))
+      {
+        mitkThrow() << "Image and label image must have the same dimensions.";
+      }
+      m_LargestPossibleRegion.SetIndex(i, 0);
+      m_LargestPossibleRegion.SetSize(i, m_Image->GetDimension(i));
+    }
+
+    const TimeStepType timeSteps = m_Image->GetTimeSteps();
+    m_Labels.assign(timeSteps, std::vector<MaskPixelType>());
+    m_Accumulators.assign(timeSteps, AccumulatorMapType());
+    m_DirtyLabels.assign(timeSteps, std::set<LabelIndex>());
+    m_ImageMTime = m_Image->GetMTime();
+
+    for (TimeStepType timeStep = 0; timeStep < timeSteps; ++timeStep)
+    {
+      this->ApplyRegion(m_LargestPossibleRegion, timeStep, true);
+    }
+
+    m_Initialized = true;
+    m_StatisticsOutdated = true;
+  }
+
+  void IncrementalImageStatisticsCalculator::UpdateRegion(const RegionType &region, TimeStepType timeStep)
+  {
+    if (!m_Initialized || m_Image->GetMTime() != m_ImageMTime)
+    {
+      // the values of the input image may have changed anywhere
+      this->Initialize();
+      return;
+    }
+
+    if (timeStep >= m_Accumulators.size())
+    {
+      mitkThrow() << "Time step " << timeStep << " exceeds the time steps of the image.";
+    }
+
+    RegionType croppedRegion = region;
+    if (!croppedRegion.Crop(m_LargestPossibleRegion) || croppedRegion.GetNumberOfPixels() == 0)
+    {
+      return;
+    }
+
+    this->ApplyRegion(croppedRegion, timeStep, false);
+  }
+
+  void IncrementalImageStatisticsCalculator::UpdateRegion(const BaseGeometry *changedGeometry, TimeStepType timeStep)
+  {
+    if (changedGeometry == nullptr)
+    {
+      mitkThrow() << "no geometry";
+    }
+
+    if (m_LabelImage.IsNull())
+    {
+      mitkThrow() << "no label image";
+    }
+
+    const BaseGeometry *labelGeometry = m_LabelImage->GetTimeGeometry()->GetGeometryForTimeStep(
+      std::min<TimeStepType>(timeStep, m_LabelImage->GetTimeSteps() - 1));
+
+    // index bounding box of all corners of the changed geometry, extended to whole voxels
+    double lower[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    double upper[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      Point3D index;
+      labelGeometry->WorldToIndex(changedGeometry->GetCornerPoint(corner), index);
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        lower[i] = std::min(lower[i], index[i]);
+        upper[i] = std::max(upper[i], index[i]);
+      }
+    }
+
+    RegionType region;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const auto begin = static_cast<itk::IndexValueType>(std::floor(lower[i]));
+      const auto end = static_cast<itk::IndexValueType>(std::ceil(upper[i]));
+      region.SetIndex(i, begin);
+      region.SetSize(i, static_cast<itk::SizeValueType>(end - begin + 1));
+    }
+
+    this->UpdateRegion(region, timeStep);
+  }
+
+  void IncrementalImageStatisticsCalculator::UpdateAllRegions()
+  {
+    if (!m_Initialized || m_Image->GetMTime() != m_ImageMTime)
+    {
+      this->Initialize();
+      return;
+    }
+
+    for (TimeStepType timeStep = 0; timeStep < m_Accumulators.size(); ++timeStep)
+    {
+      this->ApplyRegion(m_LargestPossibleRegion, timeStep, false);
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::ApplyRegion(const RegionType &region, TimeStepType timeStep, bool initial)
+  {
+    std::vector<MaskPixelType> labels;
+    labels.reserve(region.GetNumberOfPixels());
+
+    mitk::Image::Pointer labelTimeSlice = SelectTimeStep(m_LabelImage, timeStep);
+    AccessByItk_2(labelTimeSlice, InternalReadLabels, region, &labels);
+
+    mitk::Image::Pointer imageTimeSlice = SelectTimeStep(m_Image, timeStep);
+    AccessByItk_n(imageTimeSlice, InternalApplyLabels, (region, &labels, timeStep, initial));
+
+    if (initial)
+    {
+      // the region covers the whole image, so the labels are the complete state in buffer order
+      m_Labels[timeStep].swap(labels);
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void IncrementalImageStatisticsCalculator::InternalReadLabels(const itk::Image<TPixel, VImageDimension> *labelImage,
+                                                                const RegionType &region,
+                                                                std::vector<MaskPixelType> *labels) const
+  {
+    itk::ImageRegionConstIterator<itk::Image<TPixel, VImageDimension>> it(labelImage,
+                                                                           ConvertRegion<VImageDimension>(region));
+    for (; !it.IsAtEnd(); ++it)
+    {
+      labels->push_back(static_cast<MaskPixelType>(it.Get()));
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void IncrementalImageStatisticsCalculator::InternalApplyLabels(const itk::Image<TPixel, VImageDimension> *image,
+                                                                 const RegionType &region,
+                                                                 const std::vector<MaskPixelType> *labels,
+                                                                 TimeStepType timeStep,
+                                                                 bool initial)
+  {
+    const bool countDense = std::numeric_limits<TPixel>::is_integer;
+    AccumulatorMapType &accumulators = m_Accumulators[timeStep];
+    std::vector<MaskPixelType> &knownLabels = m_Labels[timeStep];
+    std::set<LabelIndex> &dirtyLabels = m_DirtyLabels[timeStep];
+
+    const itk::SizeValueType sizeX = m_LargestPossibleRegion.GetSize(0);
+    const itk::SizeValueType sizeXY = sizeX * m_LargestPossibleRegion.GetSize(1);
+
+    itk::ImageRegionConstIteratorWithIndex<itk::Image<TPixel, VImageDimension>> it(image,
+                                                                                    ConvertRegion<VImageDimension>(region));
+    auto labelIt = labels->begin();
+
+    // neighboring voxels mostly share their label, so the map is only searched if the label changes
+    LabelIndex currentLabel = 0;
+    LabelAccumulator *current = nullptr;
+
+    for (; !it.IsAtEnd(); ++it, ++labelIt)
+    {
+      const MaskPixelType newLabel = *labelIt;
+      const double value = static_cast<double>(it.Get());
+
+      const auto &index = it.GetIndex();
+      itk::SizeValueType offset = index[0];
+      if (VImageDimension > 1)
+        offset += index[1] * sizeX;
+      if (VImageDimension > 2)
+        offset += index[2] * sizeXY;
+
+      if (!initial)
+      {
+        MaskPixelType &knownLabel = knownLabels[offset];
+        if (knownLabel == newLabel)
+        {
+          continue;
+        }
+
+        dirtyLabels.insert(knownLabel);
+        dirtyLabels.insert(newLabel);
+
+        auto oldIt = accumulators.find(knownLabel);
+        oldIt->second.Remove(value, offset);
+        if (oldIt->second.IsEmpty())
+        {
+          // start from exact zeros if the label shows up again
+          if (current == &oldIt->second)
+            current = nullptr;
+          accumulators.erase(oldIt);
+        }
+        knownLabel = newLabel;
+      }
+
+      if (current == nullptr || currentLabel != newLabel)
+      {
+        currentLabel = newLabel;
+        current = &accumulators[currentLabel];
+      }
+      current->Add(value, offset, countDense);
+    }
+
+    if (initial)
+    {
+      m_StatisticsOutdated = true;
+    }
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void IncrementalImageStatisticsCalculator::InternalFindPositions(const itk::Image<TPixel, VImageDimension> *image,
+                                                                   TimeStepType timeStep,
+                                                                   const std::vector<LabelIndex> *labels)
+  {
+    AccumulatorMapType &accumulators = m_Accumulators[timeStep];
+    const std::vector<MaskPixelType> &knownLabels = m_Labels[timeStep];
+
+    std::map<LabelIndex, std::pair<double, double>> searchedValues;
+    for (auto label : *labels)
+    {
+      const LabelAccumulator &accumulator = accumulators[label];
+      searchedValues[label] = std::make_pair(accumulator.GetMinimum(), accumulator.GetMaximum());
+    }
+
+    // the first voxel in buffer order with the extreme value, like during the initial pass
+    itk::ImageRegionConstIterator<itk::Image<TPixel, VImageDimension>> it(image, image->GetLargestPossibleRegion());
+    for (itk::SizeValueType offset = 0; !it.IsAtEnd() && !searchedValues.empty(); ++it, ++offset)
+    {
+      auto searchedIt = searchedValues.find(knownLabels[offset]);
+      if (searchedIt == searchedValues.end())
+      {
+        continue;
+      }
+
+      const double value = static_cast<double>(it.Get());
+      LabelAccumulator &accumulator = accumulators[searchedIt->first];
+      if (!accumulator.m_MinPositionValid && value == searchedIt->second.first)
+      {
+        accumulator.m_MinPositionValid = true;
+        accumulator.m_MinOffset = offset;
+        accumulator.m_MinPositionValue = value;
+      }
+      if (!accumulator.m_MaxPositionValid && value == searchedIt->second.second)
+      {
+        accumulator.m_MaxPositionValid = true;
+        accumulator.m_MaxOffset = offset;
+        accumulator.m_MaxPositionValue = value;
+      }
+      if (accumulator.m_MinPositionValid && accumulator.m_MaxPositionValid)
+      {
+        searchedValues.erase(searchedIt);
+      }
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::FindPositions(TimeStepType timeStep, const std::vector<LabelIndex> &labels)
+  {
+    std::vector<LabelIndex> unknownPositions;
+    for (auto label : labels)
+    {
+      auto it = m_Accumulators[timeStep].find(label);
+      if (it != m_Accumulators[timeStep].end() && (!it->second.m_MinPositionValid || !it->second.m_MaxPositionValid))
+      {
+        unknownPositions.push_back(label);
+      }
+    }
+
+    if (unknownPositions.empty())
+    {
+      return;
+    }
+
+    mitk::Image::Pointer imageTimeSlice = SelectTimeStep(m_Image, timeStep);
+    AccessByItk_n(imageTimeSlice, InternalFindPositions, (timeStep, &unknownPositions));
+  }
+
+  ImageStatisticsContainer::ImageStatisticsObject IncrementalImageStatisticsCalculator::CalculateStatisticsObject(
+    const LabelAccumulator &accumulator) const
+  {
+    ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+    const double count = static_cast<double>(accumulator.m_Count);
+    const double minimum = accumulator.GetMinimum();
+    const double maximum = accumulator.GetMaximum();
+
+    const double mean = accumulator.m_Sum / count;
+    const double mpp = accumulator.m_SumOfPositivePixels / static_cast<double>(accumulator.m_PositivePixelCount);
+    // clamp to zero, removed voxels may leave a tiny negative rounding error
+    const double variance = std::max((accumulator.m_SumOfSquares - accumulator.m_Sum * accumulator.m_Sum / count) / count, 0.);
+    const double sigma = std::sqrt(variance);
+
+    const double secondMoment = accumulator.m_SumOfSquares / count;
+    const double thirdMoment = accumulator.m_SumOfCubes / count;
+    const double fourthMoment = accumulator.m_SumOfQuadruples / count;
+    const double skewness = (thirdMoment - 3. * secondMoment * mean + 2. * std::pow(mean, 3.)) / std::pow(secondMoment - std::pow(mean, 2.), 1.5);
+    const double kurtosis = (fourthMoment - 4. * thirdMoment * mean + 6. * secondMoment * std::pow(mean, 2.) - 3. * std::pow(mean, 4.)) / std::pow(secondMoment - std::pow(mean, 2.), 2.);
+    const double rms = std::sqrt(std::pow(mean, 2.) + variance); // variance = sigma^2
+
+    unsigned int nBinsForHistogram;
+    if (m_UseBinSizeOverNBins)
+    {
+      nBinsForHistogram = std::max(static_cast<double>(std::ceil(maximum - minimum)) / m_binSizeForHistogramStatistics,
+                                   10.); // do not allow less than 10 bins
+    }
+    else
+    {
+      nBinsForHistogram = m_nBinsForHistogramStatistics;
+    }
+
+    HistogramType::Pointer histogram = HistogramType::New();
+    HistogramType::SizeType hsize(1);
+    HistogramType::MeasurementVectorType lb(1);
+    HistogramType::MeasurementVectorType ub(1);
+    histogram->SetMeasurementVectorSize(1);
+    hsize[0] = nBinsForHistogram;
+    lb[0] = minimum;
+    ub[0] = maximum;
+    histogram->Initialize(hsize, lb, ub);
+
+    HistogramType::IndexType histogramIndex(1);
+    HistogramType::MeasurementVectorType histogramMeasurement(1);
+    accumulator.ForEachValue([&](double value, itk::SizeValueType valueCount) {
+      histogramMeasurement[0] = value;
+      histogram->GetIndex(histogramMeasurement, histogramIndex);
+      histogram->IncreaseFrequencyOfIndex(histogramIndex, valueCount);
+    });
+
+    HistogramStatisticsCalculator histStatCalc;
+    histStatCalc.SetHistogram(histogram);
+    histStatCalc.CalculateStatistics();
+
+    double voxelVolume = 1.;
+    auto spacing = m_Image->GetGeometry()->GetSpacing();
+    for (unsigned int i = 0; i < std::min(m_Image->GetDimension(), 3u); i++)
+    {
+      voxelVolume *= spacing[i];
+    }
+
+    auto numberOfVoxels = static_cast<ImageStatisticsContainer::VoxelCountType>(accumulator.m_Count);
+
+    const itk::SizeValueType sizeX = m_LargestPossibleRegion.GetSize(0);
+    const itk::SizeValueType sizeXY = sizeX * m_LargestPossibleRegion.GetSize(1);
+    vnl_vector<int> minIndex(3), maxIndex(3);
+    minIndex[0] = accumulator.m_MinOffset % sizeX;
+    minIndex[1] = (accumulator.m_MinOffset % sizeXY) / sizeX;
+    minIndex[2] = accumulator.m_MinOffset / sizeXY;
+    maxIndex[0] = accumulator.m_MaxOffset % sizeX;
+    maxIndex[1] = (accumulator.m_MaxOffset % sizeXY) / sizeX;
+    maxIndex[2] = accumulator.m_MaxOffset / sizeXY;
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(), numberOfVoxels);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), static_cast<double>(numberOfVoxels) * voxelVolume);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), mean);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), minimum);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), maximum);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), sigma);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), skewness);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), kurtosis);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), mpp);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), histStatCalc.GetEntropy());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), histStatCalc.GetMedian());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), histStatCalc.GetUniformity());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), histStatCalc.GetUPP());
+    statObj.m_Histogram = histogram;
+
+    return statObj;
+  }
+
+  void IncrementalImageStatisticsCalculator::UpdateStatisticContainer(LabelIndex label, TimeStepType timeStep)
+  {
+    auto accumulatorIt = m_Accumulators[timeStep].find(label);
+    auto containerIt = m_StatisticContainers.find(label);
+
+    if (accumulatorIt != m_Accumulators[timeStep].end())
+    {
+      if (containerIt == m_StatisticContainers.end())
+      {
+        auto container = ImageStatisticsContainer::New();
+        container->SetTimeGeometry(const_cast<mitk::TimeGeometry *>(m_Image->GetTimeGeometry()));
+        containerIt = m_StatisticContainers.emplace(label, container).first;
+      }
+      containerIt->second->SetStatisticsForTimeStep(timeStep, this->CalculateStatisticsObject(accumulatorIt->second));
+    }
+    else if (containerIt != m_StatisticContainers.end() && containerIt->second->TimeStepExists(timeStep))
+    {
+      // the label vanished from this time step; containers cannot drop a time step, so the label gets a new one
+      auto container = ImageStatisticsContainer::New();
+      container->SetTimeGeometry(const_cast<mitk::TimeGeometry *>(m_Image->GetTimeGeometry()));
+      bool hasTimeSteps = false;
+      for (TimeStepType otherTimeStep = 0; otherTimeStep < m_Accumulators.size(); ++otherTimeStep)
+      {
+        if (otherTimeStep != timeStep && containerIt->second->TimeStepExists(otherTimeStep))
+        {
+          container->SetStatisticsForTimeStep(otherTimeStep, containerIt->second->GetStatisticsForTimeStep(otherTimeStep));
+          hasTimeSteps = true;
+        }
+      }
+
+      if (!hasTimeSteps)
+      {
+        m_StatisticContainers.erase(containerIt);
+      }
+      else
+      {
+        containerIt->second = container;
+      }
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::UpdateStatisticContainers()
+  {
+    if (m_StatisticsOutdated)
+    {
+      m_StatisticContainers.clear();
+    }
+
+    for (TimeStepType timeStep = 0; timeStep < m_Accumulators.size(); ++timeStep)
+    {
+      std::vector<LabelIndex> labels;
+      if (m_StatisticsOutdated)
+      {
+        for (const auto &accumulator : m_Accumulators[timeStep])
+        {
+          labels.push_back(accumulator.first);
+        }
+      }
+      else
+      {
+        // only the labels changed by the updates, the statistics objects of all other labels are kept
+        labels.assign(m_DirtyLabels[timeStep].begin(), m_DirtyLabels[timeStep].end());
+      }
+      m_DirtyLabels[timeStep].clear();
+
+      this->FindPositions(timeStep, labels);
+      for (auto label : labels)
+      {
+        this->UpdateStatisticContainer(label, timeStep);
+      }
+    }
+
+    m_StatisticsOutdated = false;
+  }
+
+  ImageStatisticsContainer *IncrementalImageStatisticsCalculator::GetStatistics(LabelIndex label)
+  {
+    if (!m_Initialized)
+    {
+      this->Initialize();
+    }
+
+    this->UpdateStatisticContainers();
+
+    auto it = m_StatisticContainers.find(label);
+    if (it == m_StatisticContainers.end())
+    {
+      mitkThrow() << "unknown label";
+    }
+    return it->second.GetPointer();
+  }
+}
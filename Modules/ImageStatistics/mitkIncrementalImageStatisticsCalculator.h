@@ -0,0 +1,209 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITKINCREMENTALIMAGESTATISTICSCALCULATOR
+#define MITKINCREMENTALIMAGESTATISTICSCALCULATOR
+
+#include <MitkImageStatisticsExports.h>
+#include <mitkImage.h>
+#include <mitkImageStatisticsContainer.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace mitk
+{
+    /**
+    \brief Keeps the statistics of all labels of a label image up to date while the label image is edited.
+
+    In contrast to ImageStatisticsCalculator, which computes everything from scratch whenever the mask changes, this class
+    keeps moment accumulators and the occurrences of every pixel value per label and time step. After an edit only the
+    voxels of the changed region have to be visited: every voxel whose label differs from the last known state is
+    removed from the statistics of its old label and added to the statistics of its new label. The cost of an update is
+    therefore proportional to the size of the changed region (e.g. the slice written back by a segmentation tool) and not
+    to the size of the image. Only the statistics objects of labels touched by an update are recomputed; the containers
+    of all other labels are left untouched.
+
+    Usage:
+    \code
+    calculator->SetInputImage(image);
+    calculator->SetLabelImage(segmentation);
+    calculator->Initialize(); // one full pass
+
+    // after a segmentation tool wrote a slice (see mitk::DiffSliceOperation::GetSliceGeometry)
+    calculator->UpdateRegion(sliceGeometry, timeStep);
+    auto statistics = calculator->GetStatistics(label);
+    \endcode
+
+    The label image must have the same dimensions as the input image; labels are all values of the label image (including
+    0). The provided statistics are the same as those of ImageStatisticsCalculator. The minimum and maximum positions are
+    maintained while voxels are added; only if the voxel at such a position leaves its label, the position is searched
+    again in the image.
+
+    Changes of the input image itself cannot be tracked per region; if its modification time changed since the last
+    update, the next update starts from scratch.
+
+    ImageStatisticsCalculator uses this class for image masks, so repeated calculations after editing the mask only
+    recompute the changed labels.
+    */
+    class MITKIMAGESTATISTICS_EXPORT IncrementalImageStatisticsCalculator: public itk::Object
+    {
+    public:
+        /** Standard Self typedef */
+        typedef IncrementalImageStatisticsCalculator  Self;
+        typedef itk::Object                           Superclass;
+        typedef itk::SmartPointer< Self >             Pointer;
+        typedef itk::SmartPointer< const Self >       ConstPointer;
+
+        /** Method for creation through the object factory. */
+        itkNewMacro(Self); /** Runtime information support. */
+        itkTypeMacro(IncrementalImageStatisticsCalculator, itk::Object);
+
+        typedef itk::Statistics::Histogram<double> HistogramType;
+        typedef unsigned short MaskPixelType;
+        using LabelIndex = ImageStatisticsContainer::LabelIndex;
+        typedef itk::ImageRegion<3> RegionType;
+
+        /**Documentation
+        @brief Set the image for which the statistics are to be computed.*/
+        void SetInputImage(const mitk::Image* image);
+
+        /**Documentation
+        @brief Set the label image. Each voxel contributes to the statistics of its label.*/
+        void SetLabelImage(const mitk::Image* labelImage);
+
+        /**Documentation
+        @brief Set number of bins to be used for histogram statistics. If Bin size is set after number of bins, bin size will be used instead!*/
+        void SetNBinsForHistogramStatistics(unsigned int nBins);
+
+        /**Documentation
+        @brief Set bin size to be used for histogram statistics. If nbins is set after bin size, nbins will be used instead!*/
+        void SetBinSizeForHistogramStatistics(double binSize);
+
+        /**Documentation
+        @brief Computes the accumulators of all labels and time steps with one pass over input and label image.
+        Has to be called after setting new inputs and may be called at any time to start from scratch again.*/
+        void Initialize();
+
+        /**Documentation
+        @brief Applies all label changes within @a region (in index coordinates of the label image) of time step
+        @a timeStep since the last update. Voxels outside of @a region are not visited.*/
+        void UpdateRegion(const RegionType& region, TimeStepType timeStep);
+
+        /**Documentation
+        @brief Applies all label changes within the bounding box of @a changedGeometry (e.g. the geometry of a slice
+        that has been written into the label image) of time step @a timeStep since the last update.*/
+        void UpdateRegion(const BaseGeometry* changedGeometry, TimeStepType timeStep);
+
+        /**Documentation
+        @brief Applies all label changes of all time steps since the last update. This compares the whole label image
+        with the last known state, but only the changed voxels and labels are processed.*/
+        void UpdateAllRegions();
+
+        /**Documentation
+        @brief Returns the statistics for label @a label. Only labels that are currently present in the label image
+        are available, otherwise an exception is thrown.*/
+        ImageStatisticsContainer* GetStatistics(LabelIndex label=1);
+
+    protected:
+        IncrementalImageStatisticsCalculator();
+        ~IncrementalImageStatisticsCalculator() override;
+
+    private:
+        /** Accumulated moments and occurrences of all values of a label */
+        class LabelAccumulator
+        {
+        public:
+            LabelAccumulator();
+
+            void Add(double value, itk::SizeValueType offset, bool countDense);
+            void Remove(double value, itk::SizeValueType offset);
+
+            bool IsEmpty() const { return m_Count == 0; }
+            double GetMinimum() const;
+            double GetMaximum() const;
+
+            /** Calls @a function(value, count) for every value of the label in ascending order */
+            template <typename TFunction> void ForEachValue(TFunction function) const;
+
+            itk::SizeValueType m_Count;
+            itk::SizeValueType m_PositivePixelCount;
+            double m_Sum, m_SumOfSquares, m_SumOfCubes, m_SumOfQuadruples, m_SumOfPositivePixels;
+
+            /** buffer offsets of the first voxel with the minimum / maximum value, if still known */
+            bool m_MinPositionValid, m_MaxPositionValid;
+            itk::SizeValueType m_MinOffset, m_MaxOffset;
+            double m_MinPositionValue, m_MaxPositionValue;
+
+        private:
+            void SwitchToSparseCounts();
+
+            /** occurrences of the integral values [m_DenseOffset, m_DenseOffset + m_DenseCounts.size()) */
+            bool m_UseDenseCounts;
+            long long m_DenseOffset;
+            std::vector<itk::SizeValueType> m_DenseCounts;
+            /** occurrences of all values, if they are not integral or spread over a too large range */
+            std::map<double, itk::SizeValueType> m_SparseCounts;
+        };
+
+        typedef std::map<LabelIndex, LabelAccumulator> AccumulatorMapType;
+
+        template < typename TPixel, unsigned int VImageDimension > void InternalReadLabels(
+                const itk::Image< TPixel, VImageDimension >* labelImage, const RegionType& region,
+                std::vector<MaskPixelType>* labels) const;
+
+        template < typename TPixel, unsigned int VImageDimension > void InternalApplyLabels(
+                const itk::Image< TPixel, VImageDimension >* image, const RegionType& region,
+                const std::vector<MaskPixelType>* labels, TimeStepType timeStep, bool initial);
+
+        template < typename TPixel, unsigned int VImageDimension > void InternalFindPositions(
+                const itk::Image< TPixel, VImageDimension >* image, TimeStepType timeStep,
+                const std::vector<LabelIndex>* labels);
+
+        void ApplyRegion(const RegionType& region, TimeStepType timeStep, bool initial);
+
+        /** Searches the minimum / maximum positions of the given labels which are not known any more */
+        void FindPositions(TimeStepType timeStep, const std::vector<LabelIndex>& labels);
+
+        ImageStatisticsContainer::ImageStatisticsObject CalculateStatisticsObject(const LabelAccumulator& accumulator) const;
+
+        /** Recomputes the statistics object of @a label in time step @a timeStep and stores it in the label's container */
+        void UpdateStatisticContainer(LabelIndex label, TimeStepType timeStep);
+
+        void UpdateStatisticContainers();
+
+        mitk::Image::ConstPointer m_Image;
+        mitk::Image::ConstPointer m_LabelImage;
+
+        unsigned int m_nBinsForHistogramStatistics;
+        double m_binSizeForHistogramStatistics;
+        bool m_UseBinSizeOverNBins;
+
+        /** dimensions of a single time step of the images */
+        RegionType m_LargestPossibleRegion;
+
+        /** last known label of every voxel, per time step */
+        std::vector<std::vector<MaskPixelType>> m_Labels;
+        std::vector<AccumulatorMapType> m_Accumulators;
+        /** labels per time step whose statistics objects have to be recomputed */
+        std::vector<std::set<LabelIndex>> m_DirtyLabels;
+        bool m_Initialized;
+        /** all statistics objects have to be recomputed, e.g. after changing the histogram settings */
+        bool m_StatisticsOutdated;
+        itk::ModifiedTimeType m_ImageMTime;
+
+        std::map<LabelIndex,ImageStatisticsContainer::Pointer> m_StatisticContainers;
+    };
+
+}
+#endif // MITKINCREMENTALIMAGESTATISTICSCALCULATOR
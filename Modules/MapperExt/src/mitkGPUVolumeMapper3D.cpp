@@ -288,7 +288,8 @@ void mitk::GPUVolumeMapper3D::GenerateDataCPU(mitk::BaseRenderer *renderer)
 
   int nextLod = mitk::RenderingManager::GetInstance()->GetNextLOD(renderer);
 
-  if (IsLODEnabled(renderer) && nextLod == 0)
+  if ((IsLODEnabled(renderer) && nextLod == 0) ||
+      mitk::RenderingManager::GetInstance()->IsReducedQualityRendering(renderer))
   {
     ls->m_MapperCPU->SetImageSampleDistance(3.5);
     ls->m_MapperCPU->SetSampleDistance(1.25);
@@ -553,7 +554,8 @@ void mitk::GPUVolumeMapper3D::GenerateDataRAY(mitk::BaseRenderer *renderer)
 {
   LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
 
-  if (IsLODEnabled(renderer) && mitk::RenderingManager::GetInstance()->GetNextLOD(renderer) == 0)
+  if ((IsLODEnabled(renderer) && mitk::RenderingManager::GetInstance()->GetNextLOD(renderer) == 0) ||
+      mitk::RenderingManager::GetInstance()->IsReducedQualityRendering(renderer))
     ls->m_MapperRAY->SetImageSampleDistance(4.0);
   else
     ls->m_MapperRAY->SetImageSampleDistance(1.0);
@@ -0,0 +1,147 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkBatchedModelSignalImageFilter_h
+#define __itkBatchedModelSignalImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include "mitkModelBase.h"
+#include "mitkModelParameterizerBase.h"
+
+namespace itk
+{
+/** \class BatchedModelSignalImageFilter
+ * \brief Generates the signal of a model for every voxel given one input image per model parameter.
+ *
+ * Input i of the filter is the image of parameter i of the model. The filter produces one output
+ * image per time point of the model time grid. In contrast to using the itk::MultiOutputNaryFunctorImageFilter
+ * with a mitk::ModelDataGenerationFunctor, the voxels are not evaluated one by one. Each thread gathers the
+ * parameters of up to BatchSize voxels into a structure of arrays buffer and evaluates them with one call of
+ * mitk::ModelBase::GetSignalBatch(). Parameter and signal buffers are allocated once per thread.
+ * Voxels outside of the (optional) mask are set to 0.
+ * If a model parameterizer is set and it defines local static parameters (e.g. the S0 of the Brix model taken
+ * from a base image), the shared model cannot be used. Then each thread generates its own model and updates its
+ * local static parameters for every voxel before computing its signal.
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ */
+
+template< class TInputImage, class TOutputImage, class TMaskImage = ::itk::Image<unsigned char, TOutputImage::ImageDimension> >
+class ITK_EXPORT BatchedModelSignalImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+
+{
+public:
+  /** Standard class typedefs. */
+  typedef BatchedModelSignalImageFilter                   Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BatchedModelSignalImageFilter, ImageToImageFilter);
+
+  /** Some typedefs. */
+  typedef TInputImage                          InputImageType;
+  typedef typename InputImageType::Pointer     InputImagePointer;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename OutputImageType::Pointer    OutputImagePointer;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+  typedef typename OutputImageType::PixelType  OutputImagePixelType;
+  typedef TMaskImage MaskImageType;
+  typedef typename MaskImageType::Pointer     MaskImagePointer;
+
+  typedef mitk::ModelBase ModelType;
+  typedef ModelType::ConstPointer ModelConstPointer;
+  typedef mitk::ModelParameterizerBase ParameterizerType;
+  typedef ParameterizerType::ConstPointer ParameterizerConstPointer;
+
+  /** Sets the model used to compute the signals. The filter generates one output per time point
+   * of the time grid of the model.*/
+  void SetModel(const ModelType* model)
+  {
+    if (m_Model != model)
+    {
+      m_Model = model;
+      this->ActualizeOutputs();
+      this->Modified();
+    }
+  }
+  itkGetConstObjectMacro(Model, ModelType);
+
+  /** Optional parameterizer of the model. It is used to generate models with the local static
+   * parameters of each voxel, if it defines any. The model (SetModel()) is still required, it defines
+   * the time grid and is used for all voxels if there are no local static parameters.*/
+  itkSetConstObjectMacro(ModelParameterizer, ParameterizerType);
+  itkGetConstObjectMacro(ModelParameterizer, ParameterizerType);
+
+  itkSetObjectMacro(Mask, MaskImageType);
+  itkGetConstObjectMacro(Mask, MaskImageType);
+
+  /** Maximum number of voxels that are evaluated with one call of the model. Default is 256.*/
+  itkSetMacro(BatchSize, unsigned int);
+  itkGetConstMacro(BatchSize, unsigned int);
+
+  /** ImageDimension constants */
+  itkStaticConstMacro(
+    InputImageDimension, unsigned int, TInputImage::ImageDimension);
+  itkStaticConstMacro(
+    OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( SameDimensionCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension > ) );
+  itkConceptMacro( OutputHasZeroCheck,
+                   ( Concept::HasZero< OutputImagePixelType > ) );
+  /** End concept checking */
+#endif
+protected:
+  BatchedModelSignalImageFilter();
+  ~BatchedModelSignalImageFilter() override {}
+
+  /** Checks that the model is set and that the number of inputs matches its number of parameters.*/
+  void BeforeThreadedGenerateData() override;
+
+  /** \sa ImageToImageFilter::ThreadedGenerateData(),
+   *     ImageToImageFilter::GenerateData()  */
+  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                            ThreadIdType threadId) override;
+
+  /** Methods actualize the output settings of the filter according to the current model*/
+  void ActualizeOutputs();
+
+  /** Computes the signals voxel by voxel with models that are updated with the local static
+   * parameters of each voxel.*/
+  void GenerateDataWithLocalStaticParameters(const OutputImageRegionType & outputRegionForThread,
+                                             ThreadIdType threadId);
+
+private:
+  BatchedModelSignalImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);         //purposely not implemented
+
+  ModelConstPointer m_Model;
+  ParameterizerConstPointer m_ModelParameterizer;
+  bool m_UseLocalStaticParameters;
+  MaskImagePointer m_Mask;
+  unsigned int m_BatchSize;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBatchedModelSignalImageFilter.tpp"
+#endif
+
+#endif
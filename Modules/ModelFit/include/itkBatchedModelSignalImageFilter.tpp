@@ -0,0 +1,328 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkBatchedModelSignalImageFilter_hxx
+#define __itkBatchedModelSignalImageFilter_hxx
+
+#include "itkBatchedModelSignalImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+
+namespace itk
+{
+  /**
+  * Constructor
+  */
+  template< class TInputImage, class TOutputImage, class TMaskImage >
+  BatchedModelSignalImageFilter< TInputImage, TOutputImage, TMaskImage >
+    ::BatchedModelSignalImageFilter() : m_UseLocalStaticParameters(false), m_BatchSize(256)
+  {
+    this->SetNumberOfRequiredInputs(1);
+
+    this->ActualizeOutputs();
+  }
+
+  template< class TInputImage, class TOutputImage, class TMaskImage >
+  void
+    BatchedModelSignalImageFilter< TInputImage, TOutputImage, TMaskImage >
+    ::ActualizeOutputs()
+  {
+    const unsigned int numberOfOutputs = m_Model.IsNotNull() ? m_Model->GetTimeGrid().GetSize() : 0;
+
+    this->SetNumberOfRequiredOutputs(numberOfOutputs);
+
+    for (typename Superclass::DataObjectPointerArraySizeType i = this->GetNumberOfIndexedOutputs(); i < numberOfOutputs; ++i)
+    {
+      this->SetNthOutput( i, this->MakeOutput(i) );
+    }
+
+    while(this->GetNumberOfIndexedOutputs() > numberOfOutputs)
+    {
+      this->RemoveOutput(this->GetNumberOfIndexedOutputs()-1);
+    }
+  };
+
+  template< class TInputImage, class TOutputImage, class TMaskImage >
+  void
+    BatchedModelSignalImageFilter< TInputImage, TOutputImage, TMaskImage >
+    ::BeforeThreadedGenerateData()
+  {
+    if (m_Model.IsNull())
+    {
+      itkExceptionMacro("Error. Cannot generate signals. Model is not set.");
+    }
+
+    if (this->GetNumberOfIndexedInputs() != m_Model->GetNumberOfParameters())
+    {
+      itkExceptionMacro("Error. Number of input images does not equal the number of model parameters. Number of inputs: "
+        << this->GetNumberOfIndexedInputs() << "; number of parameters: " << m_Model->GetNumberOfParameters());
+    }
+
+    if (m_BatchSize == 0)
+    {
+      itkExceptionMacro("Error. Batch size must be greater than 0.");
+    }
+
+    //the shared model only holds the global static parameters
+    m_UseLocalStaticParameters = false;
+    if (m_ModelParameterizer.IsNotNull())
+    {
+      const typename OutputImageType::IndexType index = this->GetOutput(0)->GetRequestedRegion().GetIndex();
+      ParameterizerType::IndexType parameterizerIndex;
+      parameterizerIndex.Fill(0);
+      for (unsigned int i = 0; i < std::min<unsigned int>(OutputImageDimension, ParameterizerType::IndexType::Dimension); ++i)
+      {
+        parameterizerIndex[i] = index[i];
+      }
+      m_UseLocalStaticParameters = !m_ModelParameterizer->GetLocalStaticParameters(parameterizerIndex).empty();
+    }
+  }
+
+  template< class TInputImage, class TOutputImage, class TMaskImage >
+  void
+    BatchedModelSignalImageFilter< TInputImage, TOutputImage, TMaskImage >
+    ::GenerateDataWithLocalStaticParameters(const OutputImageRegionType & outputRegionForThread,
+    ThreadIdType threadId)
+  {
+    ProgressReporter progress( this, threadId,
+      outputRegionForThread.GetNumberOfPixels() );
+
+    const unsigned int numberOfParameters = m_Model->GetNumberOfParameters();
+    const unsigned int numberOfOutputImages =
+      static_cast< unsigned int >( this->GetNumberOfIndexedOutputs() );
+
+    typedef ImageRegionConstIterator< TInputImage > InputImageRegionIteratorType;
+    std::vector< InputImageRegionIteratorType > inputItrVector;
+    inputItrVector.reserve(numberOfParameters);
+
+    for ( unsigned int i = 0; i < numberOfParameters; ++i )
+    {
+      inputItrVector.push_back( InputImageRegionIteratorType(this->GetInput(i), outputRegionForThread) );
+    }
+
+    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
+    MaskImageRegionIteratorType maskIterator;
+    const bool hasMask = m_Mask.IsNotNull();
+
+    if (hasMask)
+    {
+      if (!m_Mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
+      {
+        itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
+      }
+      maskIterator = MaskImageRegionIteratorType(m_Mask, outputRegionForThread);
+    }
+
+    //one model per thread, only its local static parameters change from voxel to voxel
+    ParameterizerType::IndexType parameterizerIndex;
+    parameterizerIndex.Fill(0);
+    ModelType::Pointer model;
+    ModelType::ParametersType parameters(numberOfParameters);
+
+    while ( !inputItrVector.front().IsAtEnd() )
+    {
+      bool isValid = true;
+
+      if (hasMask)
+      {
+        isValid = maskIterator.Get() > 0;
+        ++maskIterator;
+      }
+
+      const typename OutputImageType::IndexType index = inputItrVector.front().GetIndex();
+
+      if (isValid)
+      {
+        for (unsigned int i = 0; i < std::min<unsigned int>(OutputImageDimension, ParameterizerType::IndexType::Dimension); ++i)
+        {
+          parameterizerIndex[i] = index[i];
+        }
+
+        if (model.IsNull())
+        {
+          model = m_ModelParameterizer->GenerateParameterizedModel(parameterizerIndex);
+        }
+        else
+        {
+          model->SetStaticParameters(m_ModelParameterizer->GetLocalStaticParameters(parameterizerIndex), false);
+        }
+
+        for (unsigned int i = 0; i < numberOfParameters; ++i)
+        {
+          parameters[i] = inputItrVector[i].Get();
+        }
+
+        const ModelType::ModelResultType signal = model->GetSignal(parameters);
+        for (unsigned int j = 0; j < numberOfOutputImages; ++j)
+        {
+          this->GetOutput(j)->SetPixel(index, static_cast< OutputImagePixelType >( signal[j] ));
+        }
+      }
+      else
+      {
+        for (unsigned int j = 0; j < numberOfOutputImages; ++j)
+        {
+          this->GetOutput(j)->SetPixel(index, NumericTraits< OutputImagePixelType >::ZeroValue());
+        }
+      }
+
+      for (auto& inputIterator : inputItrVector)
+      {
+        ++inputIterator;
+      }
+
+      progress.CompletedPixel();
+    }
+  }
+
+  /**
+  * ThreadedGenerateData gathers the parameters of the voxels batch wise and computes their signals
+  */
+  template< class TInputImage, class TOutputImage, class TMaskImage >
+  void
+    BatchedModelSignalImageFilter< TInputImage, TOutputImage, TMaskImage >
+    ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+    ThreadIdType threadId)
+  {
+    if (m_UseLocalStaticParameters)
+    {
+      this->GenerateDataWithLocalStaticParameters(outputRegionForThread, threadId);
+      return;
+    }
+
+    ProgressReporter progress( this, threadId,
+      outputRegionForThread.GetNumberOfPixels() );
+
+    const unsigned int numberOfParameters = m_Model->GetNumberOfParameters();
+    const unsigned int numberOfOutputImages =
+      static_cast< unsigned int >( this->GetNumberOfIndexedOutputs() );
+
+    if (numberOfOutputImages == 0)
+    {
+      return;
+    }
+
+    typedef ImageRegionConstIterator< TInputImage > InputImageRegionIteratorType;
+    std::vector< InputImageRegionIteratorType > inputItrVector;
+    inputItrVector.reserve(numberOfParameters);
+
+    for ( unsigned int i = 0; i < numberOfParameters; ++i )
+    {
+      inputItrVector.push_back( InputImageRegionIteratorType(this->GetInput(i), outputRegionForThread) );
+    }
+
+    //all outputs share the same buffered region, thus one buffer offset addresses the voxel in all outputs
+    std::vector< OutputImagePixelType* > outputBuffers(numberOfOutputImages);
+    for ( unsigned int i = 0; i < numberOfOutputImages; ++i )
+    {
+      outputBuffers[i] = this->GetOutput(i)->GetBufferPointer();
+    }
+    const OutputImagePointer referenceOutput = this->GetOutput(0);
+
+    //check if mask image is set and generate iterator if mask is valid
+    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
+    MaskImageRegionIteratorType maskIterator;
+    const bool hasMask = m_Mask.IsNotNull();
+
+    if (hasMask)
+    {
+      if (!m_Mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
+      {
+        itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
+      }
+      maskIterator = MaskImageRegionIteratorType(m_Mask, outputRegionForThread);
+    }
+
+    //buffers are allocated once per thread and reused for every batch
+    ModelType::ParameterBatchType parameterBatch(numberOfParameters, m_BatchSize);
+    ModelType::SignalBatchType signalBatch(numberOfOutputImages, m_BatchSize);
+    std::vector< OffsetValueType > batchOffsets;
+    batchOffsets.reserve(m_BatchSize);
+
+    auto processBatch = [&]()
+    {
+      const unsigned int batchCount = batchOffsets.size();
+
+      //pad an incomplete batch with the first voxel, so the buffers keep their size
+      for (unsigned int i = 0; i < numberOfParameters; ++i)
+      {
+        std::fill(parameterBatch[i] + batchCount, parameterBatch[i] + m_BatchSize, parameterBatch[i][0]);
+      }
+
+      m_Model->GetSignalBatch(parameterBatch, signalBatch);
+
+      for (unsigned int j = 0; j < numberOfOutputImages; ++j)
+      {
+        const double* signal = signalBatch[j];
+        OutputImagePixelType* outputBuffer = outputBuffers[j];
+
+        for (unsigned int v = 0; v < batchCount; ++v)
+        {
+          outputBuffer[batchOffsets[v]] = static_cast< OutputImagePixelType >( signal[v] );
+        }
+      }
+
+      batchOffsets.clear();
+    };
+
+    while ( !inputItrVector.front().IsAtEnd() )
+    {
+      bool isValid = true;
+
+      if (hasMask)
+      {
+        isValid = maskIterator.Get() > 0;
+        ++maskIterator;
+      }
+
+      const OffsetValueType offset = referenceOutput->ComputeOffset(inputItrVector.front().GetIndex());
+
+      if (isValid)
+      {
+        const unsigned int column = batchOffsets.size();
+        for (unsigned int i = 0; i < numberOfParameters; ++i)
+        {
+          parameterBatch[i][column] = inputItrVector[i].Get();
+        }
+        batchOffsets.push_back(offset);
+
+        if (batchOffsets.size() == m_BatchSize)
+        {
+          processBatch();
+        }
+      }
+      else
+      {
+        for (auto outputBuffer : outputBuffers)
+        {
+          outputBuffer[offset] = NumericTraits< OutputImagePixelType >::ZeroValue();
+        }
+      }
+
+      for (auto& inputIterator : inputItrVector)
+      {
+        ++inputIterator;
+      }
+
+      progress.CompletedPixel();
+    }
+
+    if (!batchOffsets.empty())
+    {
+      processBatch();
+    }
+  }
+} // end namespace itk
+
+#endif
@@ -0,0 +1,146 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputTimeCurveFunctorImageFilter_h
+#define __itkMultiOutputTimeCurveFunctorImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+/** \class MultiOutputTimeCurveFunctorImageFilter
+ * \brief Perform a generic voxel-wise operation on the time curves of a dynamic image and produces m output images.
+ *
+ * This is the counterpart of the itk::MultiOutputNaryFunctorImageFilter for a single dynamic input image.
+ * Instead of one input image per time frame, the filter takes an image whose last dimension is the time
+ * (e.g. a 4D image for 3D outputs). For every voxel the functor gets the time curve of the voxel and its
+ * (spatial) index and returns a vector of m values, therefore the filter generates m output images.\n
+ * The time curves are gathered directly from the buffer of the input image (strided by the number of
+ * voxels per frame), so no frame has to be extracted or copied before the operation starts.\n
+ * The outputs have the spatial geometry of the input (the time axis is dropped).
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ * \ingroup ITKImageIntensity
+ */
+
+template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage = ::itk::Image<unsigned char, TOutputImage::ImageDimension> >
+class ITK_EXPORT MultiOutputTimeCurveFunctorImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiOutputTimeCurveFunctorImageFilter          Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MultiOutputTimeCurveFunctorImageFilter, ImageToImageFilter);
+
+  /** Some typedefs. */
+  typedef TFunction                            FunctorType;
+  typedef TInputImage                          InputImageType;
+  typedef typename InputImageType::ConstPointer InputImageConstPointer;
+  typedef typename InputImageType::RegionType  InputImageRegionType;
+  typedef typename InputImageType::PixelType   InputImagePixelType;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename OutputImageType::Pointer    OutputImagePointer;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+  typedef typename OutputImageType::PixelType  OutputImagePixelType;
+  typedef typename FunctorType::InputPixelArrayType     TimeCurveArrayType;
+  typedef typename FunctorType::OutputPixelArrayType    OutputArrayType;
+  typedef TMaskImage MaskImageType;
+  typedef typename MaskImageType::Pointer     MaskImagePointer;
+  typedef typename MaskImageType::RegionType  MaskImageRegionType;
+
+  /** Get the functor object.  The functor is returned by reference.
+   * (Functors do not have to derive from itk::LightObject, so they do
+   * not necessarily have a reference count. So we cannot return a
+   * SmartPointer). */
+  FunctorType & GetFunctor() { return m_Functor; }
+
+  /** Set the functor object.  This replaces the current Functor with a
+   * copy of the specified Functor. This allows the user to specify a
+   * functor that has ivars set differently than the default functor.
+   * This method requires an operator!=() be defined on the functor
+   * (or the compiler's default implementation of operator!=() being
+   * appropriate). */
+  void SetFunctor(FunctorType & functor)
+  {
+    if ( m_Functor != functor )
+      {
+      m_Functor = functor;
+      this->ActualizeOutputs();
+      this->Modified();
+      }
+  }
+
+  itkSetObjectMacro(Mask, MaskImageType);
+  itkGetConstObjectMacro(Mask, MaskImageType);
+
+  /** ImageDimension constants */
+  itkStaticConstMacro(
+    InputImageDimension, unsigned int, TInputImage::ImageDimension);
+  itkStaticConstMacro(
+    OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( TimeDimensionCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension + 1 > ) );
+  itkConceptMacro( OutputHasZeroCheck,
+                   ( Concept::HasZero< OutputImagePixelType > ) );
+  /** End concept checking */
+#endif
+protected:
+  MultiOutputTimeCurveFunctorImageFilter();
+  ~MultiOutputTimeCurveFunctorImageFilter() override {}
+
+  /** The outputs get the spatial geometry of the input; the time axis is dropped.*/
+  void GenerateOutputInformation() override;
+
+  /** The input is requested for the spatial region of the output and all time steps.*/
+  void GenerateInputRequestedRegion() override;
+
+  /** MultiOutputTimeCurveFunctorImageFilter can be implemented as a multi threaded filter.
+   * Therefore, this implementation provides a ThreadedGenerateData() routine
+   * which is called for each processing thread. The output image data is
+   * allocated automatically by the superclass prior to calling
+   * ThreadedGenerateData().  ThreadedGenerateData can only write to the
+   * portion of the output image specified by the parameter
+   * "outputRegionForThread"
+   *
+   * \sa ImageToImageFilter::ThreadedGenerateData(),
+   *     ImageToImageFilter::GenerateData()  */
+  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                            ThreadIdType threadId) override;
+
+  /** Methods actualize the output settings of the filter according to the current functor*/
+  void ActualizeOutputs();
+
+private:
+  MultiOutputTimeCurveFunctorImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);         //purposely not implemented
+
+  FunctorType m_Functor;
+  MaskImagePointer m_Mask;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMultiOutputTimeCurveFunctorImageFilter.tpp"
+#endif
+
+#endif
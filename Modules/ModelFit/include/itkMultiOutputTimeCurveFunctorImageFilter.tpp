@@ -0,0 +1,247 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkMultiOutputTimeCurveFunctorImageFilter_hxx
+#define __itkMultiOutputTimeCurveFunctorImageFilter_hxx
+
+#include "itkMultiOutputTimeCurveFunctorImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+  /**
+  * Constructor
+  */
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::MultiOutputTimeCurveFunctorImageFilter()
+  {
+    this->SetNumberOfRequiredInputs(1);
+
+    this->ActualizeOutputs();
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ActualizeOutputs()
+  {
+    this->SetNumberOfRequiredOutputs(m_Functor.GetNumberOfOutputs());
+
+    for (typename Superclass::DataObjectPointerArraySizeType i = this->GetNumberOfIndexedOutputs(); i< m_Functor.GetNumberOfOutputs(); ++i)
+    {
+      this->SetNthOutput( i, this->MakeOutput(i) );
+    }
+
+    while(this->GetNumberOfIndexedOutputs() > m_Functor.GetNumberOfOutputs())
+    {
+      this->RemoveOutput(this->GetNumberOfIndexedOutputs()-1);
+    }
+  };
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::GenerateOutputInformation()
+  {
+    // The superclass would copy the information of the input, which is not possible
+    // because input and outputs differ in dimension.
+    InputImageConstPointer input = this->GetInput();
+
+    if (input.IsNull())
+    {
+      return;
+    }
+
+    const InputImageRegionType& inputRegion = input->GetLargestPossibleRegion();
+
+    OutputImageRegionType outputRegion;
+    typename OutputImageType::SpacingType spacing;
+    typename OutputImageType::PointType origin;
+    typename OutputImageType::DirectionType direction;
+
+    for (unsigned int i = 0; i < OutputImageDimension; ++i)
+    {
+      outputRegion.SetIndex(i, inputRegion.GetIndex(i));
+      outputRegion.SetSize(i, inputRegion.GetSize(i));
+      spacing[i] = input->GetSpacing()[i];
+      origin[i] = input->GetOrigin()[i];
+
+      for (unsigned int j = 0; j < OutputImageDimension; ++j)
+      {
+        direction[i][j] = input->GetDirection()[i][j];
+      }
+    }
+
+    for (unsigned int i = 0; i < this->GetNumberOfIndexedOutputs(); ++i)
+    {
+      OutputImagePointer outputPtr = this->GetOutput(i);
+
+      if (outputPtr)
+      {
+        outputPtr->SetLargestPossibleRegion(outputRegion);
+        outputPtr->SetSpacing(spacing);
+        outputPtr->SetOrigin(origin);
+        outputPtr->SetDirection(direction);
+      }
+    }
+  }
+
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::GenerateInputRequestedRegion()
+  {
+    auto* input = const_cast< InputImageType * >( this->GetInput() );
+    OutputImagePointer output = this->GetOutput();
+
+    if (!input || output.IsNull())
+    {
+      return;
+    }
+
+    // spatial region of the output, but always all time steps
+    const OutputImageRegionType& outputRequestedRegion = output->GetRequestedRegion();
+    InputImageRegionType inputRequestedRegion = input->GetLargestPossibleRegion();
+
+    for (unsigned int i = 0; i < OutputImageDimension; ++i)
+    {
+      inputRequestedRegion.SetIndex(i, outputRequestedRegion.GetIndex(i));
+      inputRequestedRegion.SetSize(i, outputRequestedRegion.GetSize(i));
+    }
+
+    input->SetRequestedRegion(inputRequestedRegion);
+  }
+
+  /**
+  * ThreadedGenerateData Performs the voxel-wise operation on the time curves
+  */
+  template< class TInputImage, class TOutputImage, class TFunction, class TMaskImage >
+  void
+    MultiOutputTimeCurveFunctorImageFilter< TInputImage, TOutputImage, TFunction, TMaskImage >
+    ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+    ThreadIdType threadId)
+  {
+    ProgressReporter progress( this, threadId,
+      outputRegionForThread.GetNumberOfPixels() );
+
+    const unsigned int numberOfOutputImages =
+      static_cast< unsigned int >( this->GetNumberOfIndexedOutputs() );
+
+    InputImageConstPointer input = this->GetInput();
+    const InputImageRegionType& bufferedRegion = input->GetBufferedRegion();
+
+    //the region of the first frame that corresponds to the thread region. Its iterator points to the
+    //start of the time curve of each voxel; the further time steps follow with the stride of one frame.
+    InputImageRegionType firstFrameRegion = bufferedRegion;
+    for (unsigned int i = 0; i < OutputImageDimension; ++i)
+    {
+      firstFrameRegion.SetIndex(i, outputRegionForThread.GetIndex(i));
+      firstFrameRegion.SetSize(i, outputRegionForThread.GetSize(i));
+    }
+    firstFrameRegion.SetSize(OutputImageDimension, 1);
+
+    if (!bufferedRegion.IsInside(firstFrameRegion))
+    {
+      itkExceptionMacro("Buffered region of the input does not cover region of thread. Buffered region: " << bufferedRegion << "Thread region: " << outputRegionForThread)
+    }
+
+    const SizeValueType numberOfTimeSteps = bufferedRegion.GetSize(OutputImageDimension);
+    const OffsetValueType timeStride = input->GetOffsetTable()[OutputImageDimension];
+
+    typedef ImageRegionConstIterator< TInputImage > InputImageRegionIteratorType;
+    InputImageRegionIteratorType inputIterator(input, firstFrameRegion);
+
+    typedef ImageRegionIterator< TOutputImage > OutputImageRegionIteratorType;
+    std::vector< OutputImageRegionIteratorType > outputItrVector;
+    outputItrVector.reserve(numberOfOutputImages);
+
+    for ( unsigned int i = 0; i < numberOfOutputImages; ++i )
+    {
+      OutputImagePointer outputPtr =
+        dynamic_cast< TOutputImage * >( ProcessObject::GetOutput(i) );
+
+      if ( outputPtr )
+      {
+        outputItrVector.push_back( OutputImageRegionIteratorType(outputPtr, outputRegionForThread) );
+      }
+    }
+
+    if (outputItrVector.empty())
+    {
+      return;
+    }
+
+    //check if mask image is set and generate iterator if mask is valid
+    typedef ImageRegionConstIterator< TMaskImage > MaskImageRegionIteratorType;
+    MaskImageRegionIteratorType maskIterator;
+    const bool hasMask = m_Mask.IsNotNull();
+
+    if (hasMask)
+    {
+      if (!m_Mask->GetLargestPossibleRegion().IsInside(outputRegionForThread))
+      {
+        itkExceptionMacro("Mask of filter is set but does not cover region of thread. Mask region: "<< m_Mask->GetLargestPossibleRegion() <<"Thread region: "<<outputRegionForThread)
+      }
+      maskIterator = MaskImageRegionIteratorType(m_Mask, outputRegionForThread);
+    }
+
+    //the time curve is reused for all voxels of the thread to avoid an allocation per voxel
+    TimeCurveArrayType timeCurve(numberOfTimeSteps);
+    OutputArrayType outputArray(outputItrVector.size());
+
+    while ( !inputIterator.IsAtEnd() )
+    {
+      bool isValid = true;
+
+      if (hasMask)
+      {
+        isValid = maskIterator.Get() > 0;
+        ++maskIterator;
+      }
+
+      if (isValid)
+      {
+        const InputImagePixelType* curveStart = &(inputIterator.Value());
+        for (SizeValueType t = 0; t < numberOfTimeSteps; ++t)
+        {
+          timeCurve[t] = static_cast< typename TimeCurveArrayType::value_type >( curveStart[t * timeStride] );
+        }
+
+        outputArray = m_Functor(timeCurve, outputItrVector.front().GetIndex());
+
+        if (outputItrVector.size() != outputArray.size())
+        {
+          itkExceptionMacro("Error. Number of valid output images do not equal number of outputs required by functor. Number of valid outputs: "<< outputItrVector.size() << "; needed output number:" << this->m_Functor.GetNumberOfOutputs());
+        }
+      }
+      else
+      {
+        std::fill(outputArray.begin(), outputArray.end(), 0.0);
+      }
+
+      typename OutputArrayType::const_iterator arrayOutIt = outputArray.begin();
+      for (auto& outputIterator : outputItrVector)
+      {
+        outputIterator.Set(*arrayOutIt++);
+        ++outputIterator;
+      }
+
+      ++inputIterator;
+      progress.CompletedPixel();
+    }
+  }
+} // end namespace itk
+
+#endif
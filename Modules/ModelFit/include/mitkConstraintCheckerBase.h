@@ -37,6 +37,8 @@ public:
     typedef itk::SmartPointer< Self >                            Pointer;
     typedef itk::SmartPointer< const Self >                      ConstPointer;
 
+    itkTypeMacro(ConstraintCheckerBase, itk::Object);
+
     typedef Superclass::PenaltyValueType PenaltyValueType;
     typedef Superclass::PenaltyArrayType PenaltyArrayType;
     typedef Superclass::SignalType SignalType;
@@ -44,6 +46,10 @@ public:
 
     PenaltyValueType GetPenaltySum(const ParametersType &parameters) const override;
 
+    /** Writes all settings of the checker that influence the penalties to the passed stream. Derived checkers
+     should override it to add their constraints.*/
+    virtual void PrintConstraintSettings(std::ostream& os) const;
+
 protected:
 
     ConstraintCheckerBase()
@@ -58,8 +58,17 @@ namespace mitk
     itkSetMacro(ActivateFailureThreshold, bool);
     itkGetConstMacro(ActivateFailureThreshold, bool);
 
+    /** If set to true (default) the optimizer uses the analytic derivative of the cost function, if the model and the
+     cost function support it (see MVModelFitCostFunction::HasAnalyticDerivative()). Otherwise the derivatives are
+     computed numerically.*/
+    itkSetMacro(UseAnalyticDerivative, bool);
+    itkGetConstMacro(UseAnalyticDerivative, bool);
+    itkBooleanMacro(UseAnalyticDerivative);
+
     ParameterNamesType GetCriterionNames() const override;
 
+    void PrintFitSettings(std::ostream& os) const override;
+
   protected:
 
     typedef Superclass::ParametersType ParametersType;
@@ -96,6 +105,8 @@ namespace mitk
     /**If set to true and an constraint checker is set. The cost function will allways fail if the penalty of the
      checker reaches the threshold. In this case no function evaluation will be done-*/
     bool m_ActivateFailureThreshold;
+
+    bool m_UseAnalyticDerivative;
   };
 
 }
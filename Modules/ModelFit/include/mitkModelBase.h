@@ -74,6 +74,19 @@ namespace mitk
     typedef double DerivedParameterValueType;
     typedef std::map<ParameterNameType, DerivedParameterValueType> DerivedParameterMapType;
 
+    /** Type of the Jacobian of the model signal. Element [i][j] is the partial derivative of the
+     * signal at time point j with respect to parameter i (same layout as the derivative of
+     * itk::MultipleValuedCostFunction).*/
+    typedef itk::Array2D<double> ModelJacobianType;
+
+    /** Type of a batch of parameter vectors in structure of arrays layout. Element [i][v] is the
+     * parameter i of voxel v; thus the values of one parameter are contiguous for all voxels of the batch.*/
+    typedef itk::Array2D<double> ParameterBatchType;
+
+    /** Type of the signals of a batch of voxels in structure of arrays layout. Element [j][v] is the
+     * signal of voxel v at time point j.*/
+    typedef itk::Array2D<double> SignalBatchType;
+
     /**Default implementation returns a scale of 1.0 for every defined parameter.*/
     ParamterScaleMapType GetParameterScales() const override;
 
@@ -168,10 +181,48 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Indicates if the model is able to compute the derivatives of its signal with respect to its
+     * parameters analytically (see GetSignalAndJacobian()). Fitting strategies can use this to avoid
+     * numerical differentiation.
+     * @remark Default implementation returns false.*/
+    virtual bool HasAnalyticJacobian() const;
+
+    /** Computes the signal and the Jacobian of the signal for the given parameters in one pass.
+     * @pre HasAnalyticJacobian() must return true.
+     * @param [out] signal The signal of the model (equals the return of GetSignal()).
+     * @param [out] jacobian The Jacobian of the signal. It has the size
+     * GetNumberOfParameters() x m_TimeGrid.GetSize().*/
+    void GetSignalAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                              ModelJacobianType& jacobian) const;
+
+    /** Indicates if the model has a dedicated implementation for the evaluation of batches of voxels
+     * (see GetSignalBatch()). Models without it are evaluated voxel by voxel.
+     * @remark Default implementation returns false.*/
+    virtual bool HasBatchedModelfunction() const;
+
+    /** Computes the signals of a batch of voxels in one call.
+     * @param parameters The parameters of the voxels. It has the size GetNumberOfParameters() x N (see ParameterBatchType).
+     * @param [out] signals The signals of the voxels. It is resized to m_TimeGrid.GetSize() x N if it has not
+     * already this size. Thus callers that evaluate several batches of the same size can reuse the buffer
+     * and avoid any allocation per call.*/
+    void GetSignalBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Helper function called by GetSignalAndJacobian(). Implement in derived classes that return true
+     * for HasAnalyticJacobian().
+     * @remark Default implementation throws an exception.*/
+    virtual void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                                 ModelJacobianType& jacobian) const;
+
+    /** Helper function called by GetSignalBatch(). The signals buffer has already the correct size.
+     * Reimplement in derived classes that return true for HasBatchedModelfunction(); implementations should
+     * iterate over the voxels of the batch in the innermost loop, so that it can be vectorized.
+     * @remark Default implementation calls ComputeModelfunction() for every voxel of the batch.*/
+    virtual void ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
@@ -80,6 +80,10 @@ namespace mitk
     itkSetMacro(DebugParameterMaps, bool);
     itkGetConstMacro(DebugParameterMaps, bool);
 
+    /** Writes all settings of the functor that influence the fit results to the passed stream (e.g. to check if
+     a stored fit was done with the same settings). Derived functors that add settings must extend it.*/
+    virtual void PrintFitSettings(std::ostream& os) const;
+
   protected:
 
     typedef ModelBase::ParametersType ParametersType;
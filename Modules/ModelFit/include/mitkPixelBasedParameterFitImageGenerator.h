@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define __MITK_PIXEL_BASED_PARAMETER_FIT_IMAGE_GENERATOR_H_
 
 #include <map>
+#include <string>
 
 #include <mitkImage.h>
 
@@ -36,6 +37,11 @@ namespace mitk
    * - criterion images: Images that encode the criterion value of the fitting strategy for the fitted parameters
    * - evaluation parameter images: Images that encode measures of additional evaluation cost functions defined by the user. (These were not part of the fitting strategy)
    * .
+   * Optionally the volume can be fitted in chunks of slices (see SlicesPerChunk). In this mode the fit pipeline
+   * only holds the results of the current chunk. If additionally a checkpoint directory is set, the results of
+   * every finished chunk are streamed as NRRD tiles into that directory and the chunk is recorded in a checkpoint
+   * file, so an interrupted fit can be resumed (see ResumeFromCheckpoint). The whole-volume result images are then
+   * only assembled from the tiles after the fit pipeline has been released.
    */
 class MITKMODELFIT_EXPORT PixelBasedParameterFitImageGenerator: public ParameterFitImageGeneratorBase
 {
@@ -71,6 +77,25 @@ public:
     itkGetMacro(TimeGridByParameterizer, bool);
     itkBooleanMacro(TimeGridByParameterizer);
 
+    /** Number of slices (along the last spatial dimension of the dynamic image) that are fitted as one chunk.
+     * 0 (default) fits the whole volume in one pass.*/
+    itkSetMacro(SlicesPerChunk, unsigned int);
+    itkGetConstMacro(SlicesPerChunk, unsigned int);
+
+    /** Directory used to checkpoint a chunked fit. If set and SlicesPerChunk > 0, the results of every finished
+     * chunk are stored as NRRD tiles in the directory (instead of being kept in memory) and the chunk is recorded
+     * in its checkpoint file. If empty (default), no checkpoints are written.*/
+    itkSetStringMacro(CheckpointDirectory);
+    itkGetStringMacro(CheckpointDirectory);
+
+    /** If true, chunks recorded in the checkpoint file of the checkpoint directory are restored from their tiles
+     * instead of being fitted again. The header of the checkpoint file holds a fingerprint of the fit (geometry
+     * of the dynamic image, time grid, model and its static parameters, fit functor, mask content, chunk size and
+     * result names). Resuming from a checkpoint with another fingerprint throws an mitk::Exception.*/
+    itkSetMacro(ResumeFromCheckpoint, bool);
+    itkGetConstMacro(ResumeFromCheckpoint, bool);
+    itkBooleanMacro(ResumeFromCheckpoint);
+
     double GetProgress() const override;
 
     ParameterNamesType GetParameterNames() const override;
@@ -82,7 +107,8 @@ public:
     ParameterNamesType GetEvaluationParameterNames() const override;
 
 protected:
-  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false)
+  PixelBasedParameterFitImageGenerator() : m_Progress(0), m_ProgressOffset(0), m_ProgressScale(1), m_TimeGridByParameterizer(false),
+    m_SlicesPerChunk(0), m_ResumeFromCheckpoint(false)
   {
     m_InternalMask = nullptr;
     m_Mask = nullptr;
@@ -120,9 +146,17 @@ private:
     ParameterImageMapType m_TempCriterionResultMap;
 
     double m_Progress;
+    /**Offset and scale that map the progress of the fit filter onto the overall progress
+    (needed if the volume is fitted in chunks).*/
+    double m_ProgressOffset;
+    double m_ProgressScale;
     /**Indicates if the time grid defined in the parameterizer should be used (True)
     or if the filter should extract the time grid from the input image (False).*/
     bool m_TimeGridByParameterizer;
+
+    unsigned int m_SlicesPerChunk;
+    std::string m_CheckpointDirectory;
+    bool m_ResumeFromCheckpoint;
 };
 
 }
@@ -50,10 +50,25 @@ public:
     itkSetMacro(DerivativeStepLength, double);
     itkGetConstMacro(DerivativeStepLength, double);
 
+    /** Returns true if GetDerivative() computes the derivative from the analytic Jacobian of the model.
+     * This is the case if the model supports it (ModelBase::HasAnalyticJacobian()) and the cost function
+     * implements CalcMeasureDerivative(). Otherwise the derivative is computed numerically.*/
+    bool HasAnalyticDerivative() const;
+
 protected:
 
     virtual MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const = 0;
 
+    /** Indicates if the cost function implements CalcMeasureDerivative().
+     * @remark Default implementation returns false.*/
+    virtual bool CanCalcMeasureDerivative() const;
+
+    /** Computes the derivative of the measure given the signal of the model and the Jacobian of the signal.
+     * Only called if CanCalcMeasureDerivative() returns true.
+     * @remark Default implementation throws an exception.*/
+    virtual void CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+                                       const ModelBase::ModelJacobianType& signalJacobian, DerivativeType& derivative) const;
+
     SVModelFitCostFunction(): m_DerivativeStepLength(1e-5)
 	{
     }
@@ -40,6 +40,11 @@ protected:
 
     MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const override;
 
+    bool CanCalcMeasureDerivative() const override;
+
+    void CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+                               const ModelBase::ModelJacobianType& signalJacobian, DerivativeType& derivative) const override;
+
     SumOfSquaredDifferencesFitCostFunction()
     {
     }
@@ -56,6 +56,8 @@ namespace mitk
 
     ParametersSizeType GetNumberOfStaticParameters() const override;
 
+    bool HasBatchedModelfunction() const override;
+
   protected:
     T2DecayModel() {};
     ~T2DecayModel() override {};
@@ -68,6 +70,8 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const override;
+
     void SetStaticParameter(const ParameterNameType& name,
                                     const StaticParameterValuesType& values) override;
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const override;
@@ -11,13 +11,11 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkModelSignalImageGenerator.h"
-#include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkBatchedModelSignalImageFilter.h"
 #include "mitkArbitraryTimeGeometry.h"
 #include "mitkImageCast.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkITKImageImport.h"
-#include "mitkModelDataGenerationFunctor.h"
-#include "mitkSimpleFunctorPolicy.h"
 
 
 void mitk::ModelSignalImageGenerator::SetParameterInputImage(const ParametersIndexType parameterIndex, ParameterImageType parameterImage)
@@ -92,7 +90,16 @@ void mitk::ModelSignalImageGenerator::Generate()
     typedef itk::Image<double, 3> InputFrameImageType;
     typedef itk::Image<double, 3> OutputImageType;
 
-    typedef itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, OutputImageType, SimpleFunctorPolicy, InternalMaskType> FilterType;
+    if (this->m_Parameterizer->GetDefaultTimeGrid().GetSize() == 0)
+    {
+      itkExceptionMacro("Error. Cannot generate signal image. No time grid is set in parameterizer!");
+    }
+
+    //the voxels are evaluated batch wise by one model instance, unless the parameterizer defines local static
+    //parameters (then the filter parameterizes the model per voxel)
+    ModelBase::Pointer model = this->m_Parameterizer->GenerateParameterizedModel();
+
+    typedef itk::BatchedModelSignalImageFilter<InputFrameImageType, OutputImageType, InternalMaskType> FilterType;
      FilterType::Pointer filter = FilterType::New();
 
     for(unsigned int i=0; i<this->m_ParameterInputMap.size(); ++i)
@@ -104,19 +111,17 @@ void mitk::ModelSignalImageGenerator::Generate()
         filter->SetInput(i,frameImage);
     }
 
-    ModelDataGenerationFunctor::Pointer generationFunctor = ModelDataGenerationFunctor::New();
-    generationFunctor->SetModelParameterizer(m_Parameterizer);
-
-    SimpleFunctorPolicy functor;
-    functor.SetFunctor(generationFunctor);
-    filter->SetFunctor(functor);
+    filter->SetModel(model);
+    filter->SetModelParameterizer(this->m_Parameterizer);
     if (this->m_InternalMask.IsNotNull())
     {
      filter->SetMask(this->m_InternalMask);
     }
     filter->Update();
 
-    if (filter->GetNumberOfOutputs() != generationFunctor->GetGrid().GetSize())
+    const GridType& grid = model->GetTimeGrid();
+
+    if (filter->GetNumberOfOutputs() != grid.GetSize())
     {
       itkExceptionMacro("Error. Number of computed output Images does not match Grid size!");
     }
@@ -174,7 +179,6 @@ void mitk::ModelSignalImageGenerator::Generate()
     timeGeometry->ClearAllGeometries();
 
     auto nrOfOutputs = filter->GetNumberOfOutputs();
-    auto grid = generationFunctor->GetGrid();
     for (unsigned int i = 0; i<nrOfOutputs; ++i)
     {
       mitk::Image::Pointer frame = mitk::ImportItkImage(filter->GetOutput(i))->Clone();
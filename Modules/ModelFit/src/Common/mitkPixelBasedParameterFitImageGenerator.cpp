@@ -10,17 +10,233 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
 #include "itkCommand.h"
-#include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkImageAlgorithm.h"
+#include "itkMultiOutputTimeCurveFunctorImageFilter.h"
+#include <itksys/SystemTools.hxx>
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
-#include "mitkImageTimeSelector.h"
 #include "mitkImageAccessByItk.h"
 #include "mitkImageCast.h"
+#include "mitkIOUtil.h"
 #include "mitkModelFitFunctorPolicy.h"
 
 #include "mitkExtractTimeGrid.h"
 
+namespace
+{
+  const char* const CHECKPOINT_FILE_NAME = "fitCheckpoint.txt";
+
+  std::string GetCheckpointFilePath(const std::string& directory)
+  {
+    return directory + "/" + CHECKPOINT_FILE_NAME;
+  }
+
+  std::string GetChunkTilePath(const std::string& directory, unsigned int chunk, unsigned int resultIndex)
+  {
+    std::ostringstream stream;
+    stream << directory << "/chunk_" << chunk << "_result_" << resultIndex << ".nrrd";
+    return stream.str();
+  }
+
+  /** FNV-1a hash of a memory block, used to fingerprint the content of the mask and of the local parameters.
+   Pass the result of a previous call as hash to continue hashing.*/
+  unsigned long long HashBuffer(const void* buffer, std::size_t size, unsigned long long hash = 14695981039346656037ULL)
+  {
+    const auto* bytes = static_cast<const unsigned char*>(buffer);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  /** Generates the first line of a checkpoint file. It fingerprints the inputs of the fit, a checkpoint can only
+   be resumed if this line matches.*/
+  template <typename TInputImage, typename TMaskImage>
+  std::string GenerateCheckpointHeader(const TInputImage* image,
+                                       const mitk::ModelBase::TimeGridType& timeGrid,
+                                       const mitk::ModelBase* model,
+                                       const mitk::ModelParameterizerBase* parameterizer,
+                                       const mitk::ModelFitFunctorBase* fitFunctor,
+                                       const TMaskImage* mask,
+                                       unsigned int slicesPerChunk,
+                                       const mitk::ModelFitFunctorBase::ParameterNamesType& resultNames)
+  {
+    std::ostringstream stream;
+    stream << std::setprecision(17);
+    stream << "MITK pixel based fit checkpoint; size:";
+    const auto& region = image->GetLargestPossibleRegion();
+    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    {
+      stream << " " << region.GetIndex(i) << "+" << region.GetSize(i);
+    }
+    stream << "; origin:";
+    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    {
+      stream << " " << image->GetOrigin()[i];
+    }
+    stream << "; spacing:";
+    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    {
+      stream << " " << image->GetSpacing()[i];
+    }
+    stream << "; direction:";
+    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    {
+      for (unsigned int j = 0; j < TInputImage::ImageDimension; ++j)
+      {
+        stream << " " << image->GetDirection()[i][j];
+      }
+    }
+    stream << "; time grid:";
+    for (const auto& time : timeGrid)
+    {
+      stream << " " << time;
+    }
+    stream << "; model: " << model->GetClassID() << "; static parameters:";
+    for (const auto& parameter : model->GetStaticParameters())
+    {
+      stream << " " << parameter.first << "=";
+      for (const auto& value : parameter.second)
+      {
+        stream << value << ",";
+      }
+    }
+    stream << "; initial parameters: " << parameterizer->GetInitialParameterization();
+
+    // initial parameters and static parameters may be defined per voxel (e.g. by images)
+    unsigned long long localParametersHash = 14695981039346656037ULL;
+    mitk::ModelParameterizerBase::IndexType index;
+    for (index[2] = region.GetIndex(2); index[2] < static_cast<itk::IndexValueType>(region.GetIndex(2) + region.GetSize(2)); ++index[2])
+    {
+      for (index[1] = region.GetIndex(1); index[1] < static_cast<itk::IndexValueType>(region.GetIndex(1) + region.GetSize(1)); ++index[1])
+      {
+        for (index[0] = region.GetIndex(0); index[0] < static_cast<itk::IndexValueType>(region.GetIndex(0) + region.GetSize(0)); ++index[0])
+        {
+          const auto initialParameters = parameterizer->GetInitialParameterization(index);
+          localParametersHash = HashBuffer(initialParameters.data_block(), initialParameters.Size() * sizeof(mitk::ModelBase::ParametersType::ValueType), localParametersHash);
+          for (const auto& parameter : parameterizer->GetLocalStaticParameters(index))
+          {
+            localParametersHash = HashBuffer(parameter.first.data(), parameter.first.size(), localParametersHash);
+            localParametersHash = HashBuffer(parameter.second.data(), parameter.second.size() * sizeof(mitk::ModelBase::StaticParameterValueType), localParametersHash);
+          }
+        }
+      }
+    }
+    stream << "; local parameters: " << localParametersHash;
+
+    stream << "; fit functor: ";
+    fitFunctor->PrintFitSettings(stream);
+    stream << "; mask:";
+    if (mask == nullptr)
+    {
+      stream << " none";
+    }
+    else
+    {
+      stream << " " << mask->GetLargestPossibleRegion().GetSize() << " "
+        << HashBuffer(mask->GetBufferPointer(), mask->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(typename TMaskImage::PixelType));
+    }
+    stream << "; slices per chunk: " << slicesPerChunk << "; results:";
+    for (const auto& name : resultNames)
+    {
+      stream << " " << name << "|";
+    }
+    return stream.str();
+  }
+
+  /** Returns the chunks recorded in the checkpoint file. If the file does not exist, the returned set is empty.
+   Throws if the header of the checkpoint file does not match the current fit.*/
+  std::set<unsigned int> ReadFinishedChunks(const std::string& checkpointPath, const std::string& header)
+  {
+    std::set<unsigned int> result;
+
+    std::ifstream stream(checkpointPath);
+    if (!stream.is_open())
+    {
+      return result;
+    }
+
+    std::string line;
+    if (!std::getline(stream, line) || line != header)
+    {
+      mitkThrow() << "Cannot resume fitting. The checkpoint was written for another fit (dynamic image, mask, model, fit functor or chunk size differ). Checkpoint file: " << checkpointPath;
+    }
+
+    while (std::getline(stream, line))
+    {
+      std::istringstream lineStream(line);
+      std::string tag;
+      unsigned int chunk = 0;
+      if (lineStream >> tag >> chunk && tag == "chunk")
+      {
+        result.insert(chunk);
+      }
+    }
+
+    return result;
+  }
+
+  /** Writes the chunk region of the passed image as NRRD tile. The tile starts at index 0 and its origin is moved to
+   the first voxel of the chunk.*/
+  template <typename TImage>
+  void SaveChunkTile(const TImage* image, const typename TImage::RegionType& chunkRegion, const std::string& path)
+  {
+    typename TImage::Pointer tile = TImage::New();
+    typename TImage::RegionType tileRegion;
+    tileRegion.SetSize(chunkRegion.GetSize());
+    tile->SetRegions(tileRegion);
+    tile->SetSpacing(image->GetSpacing());
+    tile->SetDirection(image->GetDirection());
+
+    typename TImage::PointType origin;
+    image->TransformIndexToPhysicalPoint(chunkRegion.GetIndex(), origin);
+    tile->SetOrigin(origin);
+    tile->Allocate();
+
+    itk::ImageAlgorithm::Copy(image, tile.GetPointer(), chunkRegion, tileRegion);
+
+    mitk::Image::Pointer mitkTile = mitk::Image::New();
+    mitk::CastToMitkImage(tile, mitkTile);
+    mitk::IOUtil::Save(mitkTile, path);
+  }
+
+  /** Copies the content of a tile written by SaveChunkTile into the chunk region of the passed image.
+   Returns false if the tile cannot be loaded or does not fit the chunk.*/
+  template <typename TImage>
+  bool LoadChunkTile(const std::string& path, const typename TImage::RegionType& chunkRegion, TImage* image)
+  {
+    try
+    {
+      mitk::Image::Pointer mitkTile = mitk::IOUtil::Load<mitk::Image>(path);
+      typename TImage::Pointer tile;
+      mitk::CastToItkImage(mitkTile, tile);
+
+      if (tile->GetLargestPossibleRegion().GetSize() != chunkRegion.GetSize())
+      {
+        MITK_WARN << "Parameter Fit Generator. Size of checkpoint tile does not match the chunk. Tile: " << path;
+        return false;
+      }
+
+      itk::ImageAlgorithm::Copy(tile.GetPointer(), image, tile->GetLargestPossibleRegion(), chunkRegion);
+    }
+    catch (const std::exception& e)
+    {
+      MITK_WARN << "Parameter Fit Generator. Cannot restore checkpoint tile " << path << ". Error: " << e.what();
+      return false;
+    }
+
+    return true;
+  }
+}
+
 void
   mitk::PixelBasedParameterFitImageGenerator::
   onFitProgressEvent(::itk::Object* caller, const ::itk::EventObject& /*eventObject*/)
@@ -30,7 +246,7 @@ void
   auto* process = dynamic_cast<itk::ProcessObject*>(caller);
   if (process)
   {
-    this->m_Progress = process->GetProgress();
+    this->m_Progress = this->m_ProgressOffset + process->GetProgress() * this->m_ProgressScale;
   }
 };
 
@@ -55,18 +271,18 @@ void
 }
 
 template<typename TImage>
-mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultImages( mitk::ModelFitFunctorBase::ParameterNamesType &paramNames, itk::ImageSource<TImage>* source, mitk::ModelFitFunctorBase::ParameterNamesType::size_type startPos, mitk::ModelFitFunctorBase::ParameterNamesType::size_type& endPos )
+mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultImages( mitk::ModelFitFunctorBase::ParameterNamesType &paramNames, const std::vector<typename TImage::Pointer>& sources, mitk::ModelFitFunctorBase::ParameterNamesType::size_type startPos, mitk::ModelFitFunctorBase::ParameterNamesType::size_type& endPos )
 {
   mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType result;
   for (mitk::ModelFitFunctorBase::ParameterNamesType::size_type j = 0; j < paramNames.size(); ++j)
   {
-    if (source->GetNumberOfOutputs() < startPos+j)
+    if (sources.size() <= startPos+j)
     {
-      mitkThrow() << "Error while generating fitted parameter images. Number of sources is too low and does not match expected parameter number. Output size: "<< source->GetNumberOfOutputs()<<"; number of param names: "<<paramNames.size()<<";source start pos: " << startPos;
+      mitkThrow() << "Error while generating fitted parameter images. Number of sources is too low and does not match expected parameter number. Output size: "<< sources.size()<<"; number of param names: "<<paramNames.size()<<";source start pos: " << startPos;
     }
 
     mitk::Image::Pointer paramImage = mitk::Image::New();
-    typename TImage::ConstPointer outputImg = source->GetOutput(startPos+j);
+    typename TImage::ConstPointer outputImg = sources[startPos+j].GetPointer();
     mitk::CastToMitkImage(outputImg, paramImage);
 
     result.insert(std::make_pair(paramNames[j],paramImage));
@@ -79,12 +295,12 @@ mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType StoreResultIma
 
 template <typename TPixel, unsigned int VDim>
 void
-  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* /*image*/)
+  mitk::PixelBasedParameterFitImageGenerator::DoParameterFit(itk::Image<TPixel, VDim>* image)
 {
-  using InputFrameImageType = itk::Image<TPixel, VDim-1>;
+  using InputImageType = itk::Image<TPixel, VDim>;
   using ParameterImageType = itk::Image<ScalarType, VDim-1>;
 
-  using FitFilterType = itk::MultiOutputNaryFunctorImageFilter<InputFrameImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
+  using FitFilterType = itk::MultiOutputTimeCurveFunctorImageFilter<InputImageType, ParameterImageType, ModelFitFunctorPolicy, InternalMaskType>;
 
   typename FitFilterType::Pointer fitFilter = FitFilterType::New();
 
@@ -92,21 +308,9 @@ void
   spProgressCommand->SetCallbackFunction(this, &Self::onFitProgressEvent);
   fitFilter->AddObserver(::itk::ProgressEvent(), spProgressCommand);
 
-  //add the time frames to the fit filter
-  mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-  imageTimeSelector->SetInput(this->m_DynamicImage);
-  std::vector<Image::Pointer> frameCache;
-  for (unsigned int i = 0; i < this->m_DynamicImage->GetTimeSteps(); ++i)
-  {
-    typename InputFrameImageType::Pointer frameImage;
-    imageTimeSelector->SetTimeNr(i);
-    imageTimeSelector->UpdateLargestPossibleRegion();
-
-    Image::Pointer frameMITKImage = imageTimeSelector->GetOutput();
-    frameCache.push_back(frameMITKImage);
-    mitk::CastToItkImage(frameMITKImage, frameImage);
-    fitFilter->SetInput(i,frameImage);
-  }
+  //the fit filter reads the time curves of the voxels directly from the buffer of the dynamic image,
+  //so no time frame has to be extracted and copied.
+  fitFilter->SetInput(image);
 
   ModelBaseType::TimeGridType timeGrid = ExtractTimeGrid(m_DynamicImage);
   if (m_TimeGridByParameterizer)
@@ -132,10 +336,6 @@ void
     fitFilter->SetMask(this->m_InternalMask);
   }
 
-  //generate the fits
-  fitFilter->Update();
-
-  //convert the outputs into mitk images and fill the parameter image map
   ModelBaseType::Pointer refModel = this->m_ModelParameterizer->GenerateParameterizedModel();
   ModelFitFunctorBase::ParameterNamesType paramNames = refModel->GetParameterNames();
   ModelFitFunctorBase::ParameterNamesType derivedParamNames = refModel->GetDerivedParameterNames();
@@ -143,18 +343,185 @@ void
   ModelFitFunctorBase::ParameterNamesType evaluationParamNames = this->m_FitFunctor->GetEvaluationParameterNames();
   ModelFitFunctorBase::ParameterNamesType debugParamNames = this->m_FitFunctor->GetDebugParameterNames();
 
-  if (fitFilter->GetNumberOfOutputs() != (paramNames.size() + derivedParamNames.size() + criterionNames.size() + evaluationParamNames.size() + debugParamNames.size()))
+  ModelFitFunctorBase::ParameterNamesType resultNames = paramNames;
+  resultNames.insert(resultNames.end(), derivedParamNames.begin(), derivedParamNames.end());
+  resultNames.insert(resultNames.end(), criterionNames.begin(), criterionNames.end());
+  resultNames.insert(resultNames.end(), evaluationParamNames.begin(), evaluationParamNames.end());
+  resultNames.insert(resultNames.end(), debugParamNames.begin(), debugParamNames.end());
+
+  fitFilter->UpdateOutputInformation();
+
+  if (fitFilter->GetNumberOfOutputs() != resultNames.size())
   {
     mitkThrow() << "Error while generating fitted parameter images. Fit filter output size does not match expected parameter number. Output size: "<< fitFilter->GetNumberOfOutputs();
   }
 
+  std::vector<typename ParameterImageType::Pointer> resultImages;
+
+  if (this->m_SlicesPerChunk == 0)
+  {
+    //generate the fits
+    fitFilter->Update();
+
+    for (unsigned int i = 0; i < resultNames.size(); ++i)
+    {
+      resultImages.push_back(fitFilter->GetOutput(i));
+    }
+  }
+  else
+  {
+    //generate the fits chunk by chunk; the fit filter only computes (and buffers) the requested chunk
+    //and the chunk results are copied into the result images.
+    const typename ParameterImageType::RegionType region = fitFilter->GetOutput()->GetLargestPossibleRegion();
+    const unsigned int chunkDimension = VDim - 2;
+    const itk::SizeValueType sliceCount = region.GetSize(chunkDimension);
+    const unsigned int chunkCount = static_cast<unsigned int>((sliceCount + this->m_SlicesPerChunk - 1) / this->m_SlicesPerChunk);
+
+    const bool useCheckpoint = !this->m_CheckpointDirectory.empty();
+
+    //without checkpoint the chunk results are collected in memory, otherwise they are streamed to tiles
+    //and the result images are assembled after the fit.
+    typename ParameterImageType::Pointer resultInformation = ParameterImageType::New();
+    resultInformation->CopyInformation(fitFilter->GetOutput());
+    if (!useCheckpoint)
+    {
+      for (unsigned int i = 0; i < resultNames.size(); ++i)
+      {
+        typename ParameterImageType::Pointer resultImage = ParameterImageType::New();
+        resultImage->CopyInformation(resultInformation);
+        resultImage->SetRegions(region);
+        resultImage->Allocate();
+        resultImage->FillBuffer(0);
+        resultImages.push_back(resultImage);
+      }
+    }
+
+    std::set<unsigned int> finishedChunks;
+    std::ofstream checkpointStream;
+
+    if (useCheckpoint)
+    {
+      if (!itksys::SystemTools::MakeDirectory(this->m_CheckpointDirectory))
+      {
+        mitkThrow() << "Cannot do fitting. Checkpoint directory cannot be created. Directory: " << this->m_CheckpointDirectory;
+      }
+
+      const std::string checkpointPath = GetCheckpointFilePath(this->m_CheckpointDirectory);
+      const std::string header = GenerateCheckpointHeader(image, this->m_ModelParameterizer->GetDefaultTimeGrid(), refModel.GetPointer(), this->m_ModelParameterizer.GetPointer(), this->m_FitFunctor.GetPointer(),
+        this->m_InternalMask.GetPointer(), this->m_SlicesPerChunk, resultNames);
+
+      if (this->m_ResumeFromCheckpoint)
+      {
+        finishedChunks = ReadFinishedChunks(checkpointPath, header);
+      }
+
+      if (finishedChunks.empty())
+      {
+        checkpointStream.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
+        checkpointStream << header << std::endl;
+      }
+      else
+      {
+        checkpointStream.open(checkpointPath, std::ios_base::out | std::ios_base::app);
+      }
+
+      if (!checkpointStream.is_open())
+      {
+        mitkThrow() << "Cannot do fitting. Checkpoint file cannot be written. File: " << checkpointPath;
+      }
+    }
+
+    std::vector<typename ParameterImageType::RegionType> chunkRegions;
+    for (unsigned int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+      const itk::SizeValueType firstSlice = static_cast<itk::SizeValueType>(chunk) * this->m_SlicesPerChunk;
+      typename ParameterImageType::RegionType chunkRegion = region;
+      chunkRegion.SetIndex(chunkDimension, region.GetIndex(chunkDimension) + firstSlice);
+      chunkRegion.SetSize(chunkDimension, std::min<itk::SizeValueType>(this->m_SlicesPerChunk, sliceCount - firstSlice));
+      chunkRegions.push_back(chunkRegion);
+
+      bool restored = false;
+      if (finishedChunks.find(chunk) != finishedChunks.end())
+      {
+        restored = true;
+        for (unsigned int i = 0; i < resultNames.size() && restored; ++i)
+        {
+          restored = itksys::SystemTools::FileExists(GetChunkTilePath(this->m_CheckpointDirectory, chunk, i));
+        }
+      }
+
+      if (restored)
+      {
+        MITK_INFO << "Parameter Fit Generator. Restored chunk " << chunk << " from checkpoint.";
+      }
+      else
+      {
+        this->m_ProgressOffset = static_cast<double>(chunk) / chunkCount;
+        this->m_ProgressScale = 1. / chunkCount;
+
+        fitFilter->GetOutput()->SetRequestedRegion(chunkRegion);
+        fitFilter->Update();
+
+        if (useCheckpoint)
+        {
+          for (unsigned int i = 0; i < resultNames.size(); ++i)
+          {
+            SaveChunkTile<ParameterImageType>(fitFilter->GetOutput(i), chunkRegion, GetChunkTilePath(this->m_CheckpointDirectory, chunk, i));
+          }
+          //the chunk is only recorded after all its tiles are written, so an interruption
+          //while writing leads to a refit of the chunk when resuming.
+          checkpointStream << "chunk " << chunk << std::endl;
+        }
+        else
+        {
+          for (unsigned int i = 0; i < resultImages.size(); ++i)
+          {
+            itk::ImageAlgorithm::Copy(fitFilter->GetOutput(i), resultImages[i].GetPointer(), chunkRegion, chunkRegion);
+          }
+        }
+      }
+
+      this->m_Progress = static_cast<double>(chunk + 1) / chunkCount;
+      this->InvokeEvent(::itk::ProgressEvent());
+    }
+
+    this->m_ProgressOffset = 0.;
+    this->m_ProgressScale = 1.;
+
+    if (useCheckpoint)
+    {
+      //release the buffers of the fit pipeline before the result images are assembled from the tiles
+      checkpointStream.close();
+      fitFilter = nullptr;
+
+      for (unsigned int i = 0; i < resultNames.size(); ++i)
+      {
+        typename ParameterImageType::Pointer resultImage = ParameterImageType::New();
+        resultImage->CopyInformation(resultInformation);
+        resultImage->SetRegions(region);
+        resultImage->Allocate();
+
+        for (unsigned int chunk = 0; chunk < chunkCount; ++chunk)
+        {
+          const std::string tilePath = GetChunkTilePath(this->m_CheckpointDirectory, chunk, i);
+          if (!LoadChunkTile<ParameterImageType>(tilePath, chunkRegions[chunk], resultImage))
+          {
+            mitkThrow() << "Error while generating fitted parameter images. Checkpoint tile cannot be loaded. Tile: " << tilePath;
+          }
+        }
+        resultImages.push_back(resultImage);
+      }
+    }
+  }
+
+  //convert the outputs into mitk images and fill the parameter image map
   ModelFitFunctorBase::ParameterNamesType::size_type resultPos = 0;
-  this->m_TempResultMap = StoreResultImages<ParameterImageType>(paramNames,fitFilter,resultPos, resultPos);
-  this->m_TempDerivedResultMap = StoreResultImages<ParameterImageType>(derivedParamNames,fitFilter,resultPos, resultPos);
-  this->m_TempCriterionResultMap = StoreResultImages<ParameterImageType>(criterionNames,fitFilter,resultPos, resultPos);
-  this->m_TempEvaluationResultMap = StoreResultImages<ParameterImageType>(evaluationParamNames,fitFilter,resultPos, resultPos);
+  this->m_TempResultMap = StoreResultImages<ParameterImageType>(paramNames,resultImages,resultPos, resultPos);
+  this->m_TempDerivedResultMap = StoreResultImages<ParameterImageType>(derivedParamNames,resultImages,resultPos, resultPos);
+  this->m_TempCriterionResultMap = StoreResultImages<ParameterImageType>(criterionNames,resultImages,resultPos, resultPos);
+  this->m_TempEvaluationResultMap = StoreResultImages<ParameterImageType>(evaluationParamNames,resultImages,resultPos, resultPos);
   //also add debug params (if generated) to the evaluation result map
-  mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType debugMap = StoreResultImages<ParameterImageType>(debugParamNames, fitFilter, resultPos, resultPos);
+  mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType debugMap = StoreResultImages<ParameterImageType>(debugParamNames, resultImages, resultPos, resultPos);
   this->m_TempEvaluationResultMap.insert(debugMap.begin(), debugMap.end());
 }
 
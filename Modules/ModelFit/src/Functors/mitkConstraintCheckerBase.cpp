@@ -26,3 +26,10 @@ mitk::ConstraintCheckerBase::PenaltyValueType
 
   return result;
 };
+
+void
+  mitk::ConstraintCheckerBase::PrintConstraintSettings(std::ostream& os) const
+{
+  os << this->GetNameOfClass() << " constraints: " << this->GetNumberOfConstraints()
+     << " failed constraint value: " << this->GetFailedConstraintValue();
+};
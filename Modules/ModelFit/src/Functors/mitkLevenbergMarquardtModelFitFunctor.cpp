@@ -20,7 +20,7 @@ found in the LICENSE file.
 mitk::LevenbergMarquardtModelFitFunctor::
 LevenbergMarquardtModelFitFunctor(): m_Epsilon(1e-5), m_GradientTolerance(1e-3),
   m_ValueTolerance(1e-5), m_Iterations(1000), m_DerivativeStepLength(1e-5),
-  m_ActivateFailureThreshold(true)
+  m_ActivateFailureThreshold(true), m_UseAnalyticDerivative(true)
 {};
 
 mitk::LevenbergMarquardtModelFitFunctor::
@@ -36,6 +36,28 @@ GetCriterionNames() const
   return names;
 };
 
+void
+mitk::LevenbergMarquardtModelFitFunctor::
+PrintFitSettings(std::ostream& os) const
+{
+  Superclass::PrintFitSettings(os);
+
+  os << " epsilon: " << m_Epsilon << " gradient tolerance: " << m_GradientTolerance
+     << " value tolerance: " << m_ValueTolerance << " iterations: " << m_Iterations
+     << " derivative step length: " << m_DerivativeStepLength << " scales: " << m_Scales
+     << " failure threshold: " << m_ActivateFailureThreshold << " analytic derivative: " << m_UseAnalyticDerivative
+     << " constraints: ";
+
+  if (m_ConstraintChecker.IsNull())
+  {
+    os << "none";
+  }
+  else
+  {
+    m_ConstraintChecker->PrintConstraintSettings(os);
+  }
+};
+
 mitk::LevenbergMarquardtModelFitFunctor::OutputPixelArrayType
 mitk::LevenbergMarquardtModelFitFunctor::
 GetCriteria(const ModelBase* model, const ParametersType& parameters,
@@ -128,6 +150,10 @@ DoModelFit(const SignalType& value, const ModelBase* model,
   ::itk::LevenbergMarquardtOptimizer::Pointer optimizer = ::itk::LevenbergMarquardtOptimizer::New();
 
   optimizer->SetCostFunction(metric);
+  if (m_UseAnalyticDerivative && metric->HasAnalyticDerivative())
+  {
+    optimizer->UseCostFunctionGradientOn();
+  }
   optimizer->SetEpsilonFunction(m_Epsilon);
   optimizer->SetGradientTolerance(m_GradientTolerance);
   optimizer->SetNumberOfIterations(m_Iterations);
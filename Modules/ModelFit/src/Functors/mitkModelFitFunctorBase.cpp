@@ -12,6 +12,8 @@ found in the LICENSE file.
 
 #include "mitkModelFitFunctorBase.h"
 
+#include <typeinfo>
+
 mitk::ModelFitFunctorBase::OutputPixelArrayType
 mitk::ModelFitFunctorBase::
 Compute(const InputPixelArrayType& value, const ModelBase* model,
@@ -186,6 +188,22 @@ mitk::ModelFitFunctorBase::GetDebugParameterNames() const
   return result;
 };
 
+void
+mitk::ModelFitFunctorBase::PrintFitSettings(std::ostream& os) const
+{
+  os << this->GetNameOfClass() << " debug parameters: " << this->m_DebugParameterMaps << " evaluation parameters:";
+
+  m_Mutex.Lock();
+
+  for (CostFunctionMapType::const_iterator pos = m_CostFunctionMap.begin();
+       pos != m_CostFunctionMap.end(); ++pos)
+  {
+    os << " " << pos->first << "=" << typeid(*(pos->second)).name();
+  }
+
+  m_Mutex.Unlock();
+};
+
 mitk::ModelFitFunctorBase::
 ModelFitFunctorBase() : m_DebugParameterMaps(false)
 {};
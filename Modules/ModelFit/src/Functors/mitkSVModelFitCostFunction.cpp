@@ -32,6 +32,19 @@ mitk::SVModelFitCostFunction::MeasureType mitk::SVModelFitCostFunction::GetValue
 
 void mitk::SVModelFitCostFunction::GetDerivative (const ParametersType &parameters, DerivativeType &derivative) const
 {
+  if (this->HasAnalyticDerivative())
+  {
+    SignalType signal;
+    ModelBase::ModelJacobianType signalJacobian;
+    m_Model->GetSignalAndJacobian(parameters, signal, signalJacobian);
+
+    if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+    if(signal.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
+
+    CalcMeasureDerivative(parameters, signal, signalJacobian, derivative);
+    return;
+  }
+
   ParametersType::SizeValueType paramCount = parameters.Size();
 
   derivative.SetSize(paramCount);
@@ -52,6 +65,22 @@ void mitk::SVModelFitCostFunction::GetDerivative (const ParametersType &paramete
   }
 };
 
+bool mitk::SVModelFitCostFunction::HasAnalyticDerivative() const
+{
+  return m_Model.IsNotNull() && m_Model->HasAnalyticJacobian() && this->CanCalcMeasureDerivative();
+}
+
+bool mitk::SVModelFitCostFunction::CanCalcMeasureDerivative() const
+{
+  return false;
+}
+
+void mitk::SVModelFitCostFunction::CalcMeasureDerivative(const ParametersType &/*parameters*/, const SignalType &/*signal*/,
+  const ModelBase::ModelJacobianType &/*signalJacobian*/, DerivativeType &/*derivative*/) const
+{
+  itkExceptionMacro("CalcMeasureDerivative is not implemented by this cost function.");
+}
+
 unsigned int mitk::SVModelFitCostFunction::GetNumberOfParameters() const
 {
   return m_Model->GetNumberOfParameters();
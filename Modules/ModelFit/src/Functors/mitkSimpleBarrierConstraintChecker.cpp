@@ -43,6 +43,21 @@ mitk::SimpleBarrierConstraintChecker::GetFailedConstraintValue() const
   return m_MaxConstraintPenalty;
 };
 
+void mitk::SimpleBarrierConstraintChecker::PrintConstraintSettings(std::ostream& os) const
+{
+  Superclass::PrintConstraintSettings(os);
+
+  for (const auto& constraint : m_Constraints)
+  {
+    os << " (";
+    for (const auto& parameterID : constraint.parameters)
+    {
+      os << parameterID << ",";
+    }
+    os << (constraint.upperBarrier ? " <= " : " >= ") << constraint.barrier << " width " << constraint.width << ")";
+  }
+};
+
 void mitk::SimpleBarrierConstraintChecker::SetLowerBarrier(ParameterIndexType parameterID,
     BarrierValueType barrier, BarrierWidthType width)
 {
@@ -24,3 +24,23 @@ mitk::SumOfSquaredDifferencesFitCostFunction::MeasureType mitk::SumOfSquaredDiff
 
   return measure;
 }
+
+bool mitk::SumOfSquaredDifferencesFitCostFunction::CanCalcMeasureDerivative() const
+{
+  return true;
+}
+
+void mitk::SumOfSquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType &/*parameters*/, const SignalType &signal,
+  const ModelBase::ModelJacobianType &signalJacobian, DerivativeType &derivative) const
+{
+  derivative.SetSize(signalJacobian.rows());
+  derivative.Fill(0.0);
+
+  for (unsigned int i = 0; i < signalJacobian.rows(); ++i)
+  {
+    for (SignalType::size_type j = 0; j < signal.GetSize(); ++j)
+    {
+      derivative[i] -= 2. * (m_Sample[j] - signal[j]) * signalJacobian[i][j];
+    }
+  }
+}
@@ -146,6 +146,91 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+bool mitk::ModelBase::HasAnalyticJacobian() const
+{
+  return false;
+};
+
+void mitk::ModelBase::GetSignalAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                           ModelJacobianType& jacobian) const
+{
+  if (!this->HasAnalyticJacobian())
+  {
+    itkExceptionMacro("Model does not support the analytic computation of its Jacobian. Use GetSignal() and numerical differentiation instead.");
+  }
+
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot evaluate model. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signal. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  ComputeModelfunctionAndJacobian(parameters, signal, jacobian);
+}
+
+void mitk::ModelBase::ComputeModelfunctionAndJacobian(const ParametersType& /*parameters*/, ModelResultType& /*signal*/,
+                                                      ModelJacobianType& /*jacobian*/) const
+{
+  itkExceptionMacro("ComputeModelfunctionAndJacobian is not implemented by the model " << this->GetClassID() << ".");
+};
+
+bool mitk::ModelBase::HasBatchedModelfunction() const
+{
+  return false;
+};
+
+void mitk::ModelBase::GetSignalBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const
+{
+  if (parameters.rows() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter batch has wrong number of parameters for model. Cannot evaluate model. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters.rows());
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signal. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  if (signals.rows() != m_TimeGrid.GetSize() || signals.cols() != parameters.cols())
+  {
+    signals.SetSize(m_TimeGrid.GetSize(), parameters.cols());
+  }
+
+  ComputeModelfunctionBatch(parameters, signals);
+}
+
+void mitk::ModelBase::ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const
+{
+  ParametersType voxelParameters(parameters.rows());
+
+  for (unsigned int v = 0; v < parameters.cols(); ++v)
+  {
+    for (unsigned int i = 0; i < parameters.rows(); ++i)
+    {
+      voxelParameters[i] = parameters[i][v];
+    }
+
+    const ModelResultType signal = ComputeModelfunction(voxelParameters);
+
+    for (unsigned int j = 0; j < signals.rows(); ++j)
+    {
+      signals[j][v] = signal[j];
+    }
+  }
+};
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
@@ -57,11 +57,35 @@ mitk::T2DecayModel::ComputeModelfunction(const ParametersType& parameters) const
   for (const auto& gridPos : m_TimeGrid)
   {
     *signalPos = parameters[0] * exp(-1.0 * gridPos/ parameters[1]);
+    ++signalPos;
   }
 
   return signal;
 };
 
+bool mitk::T2DecayModel::HasBatchedModelfunction() const
+{
+  return true;
+};
+
+void mitk::T2DecayModel::ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const
+{
+  const unsigned int numberOfVoxels = parameters.cols();
+  const double* m0 = parameters[0];
+  const double* t2 = parameters[1];
+
+  for (unsigned int j = 0; j < m_TimeGrid.GetSize(); ++j)
+  {
+    const double t = m_TimeGrid[j];
+    double* signal = signals[j];
+
+    for (unsigned int v = 0; v < numberOfVoxels; ++v)
+    {
+      signal[v] = m0[v] * exp(-1.0 * t / t2[v]);
+    }
+  }
+};
+
 mitk::T2DecayModel::ParameterNamesType mitk::T2DecayModel::GetStaticParameterNames() const
 {
   ParameterNamesType result;
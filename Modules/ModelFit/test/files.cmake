@@ -1,5 +1,7 @@
 SET(MODULE_TESTS
   itkMultiOutputNaryFunctorImageFilterTest.cpp
+  itkMultiOutputTimeCurveFunctorImageFilterTest.cpp
+  itkBatchedModelSignalImageFilterTest.cpp
   itkMaskedStatisticsImageFilterTest.cpp
   itkMaskedNaryStatisticsImageFilterTest.cpp
   mitkLevenbergMarquardtModelFitFunctorTest.cpp
@@ -0,0 +1,110 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkImage.h"
+
+#include "itkBatchedModelSignalImageFilter.h"
+
+#include "mitkLinearModel.h"
+#include "mitkTestingMacros.h"
+
+#include "mitkTestDynamicImageGenerator.h"
+
+int itkBatchedModelSignalImageFilterTest(int  /*argc*/, char*[] /*argv[]*/)
+{
+  // always start with this!
+  MITK_TEST_BEGIN("itkBatchedModelSignalImageFilter")
+
+  //Prepare test artifacts and helper
+
+  typedef itk::Image<double, 2> SignalImageType;
+
+  mitk::TestImageType::Pointer slopeImage = mitk::GenerateTestImage();
+  mitk::TestImageType::Pointer offsetImage = mitk::GenerateTestImage(10);
+
+  mitk::TestImageType::IndexType testIndex1;
+  testIndex1[0] =   0;
+  testIndex1[1] =   0;
+
+  mitk::TestImageType::IndexType testIndex2;
+  testIndex2[0] =   2;
+  testIndex2[1] =   0;
+
+  mitk::TestImageType::IndexType testIndex3;
+  testIndex3[0] =   0;
+  testIndex3[1] =   1;
+
+  mitk::TestImageType::IndexType testIndex4;
+  testIndex4[0] =   2;
+  testIndex4[1] =   2;
+
+  mitk::ModelBase::TimeGridType grid(3);
+  grid[0] = 0.;
+  grid[1] = 1.;
+  grid[2] = 2.;
+
+  mitk::LinearModel::Pointer model = mitk::LinearModel::New();
+  model->SetTimeGrid(grid);
+
+  //Test default usage of filter; the batch size is chosen to get an incomplete last batch
+  typedef itk::BatchedModelSignalImageFilter<mitk::TestImageType, SignalImageType, mitk::TestMaskType> FilterType;
+  FilterType::Pointer testFilter = FilterType::New();
+
+  testFilter->SetInput(0, slopeImage);
+  testFilter->SetInput(1, offsetImage);
+  testFilter->SetModel(model);
+  testFilter->SetBatchSize(2);
+  testFilter->SetNumberOfThreads(2);
+
+  testFilter->Update();
+
+  CPPUNIT_ASSERT_MESSAGE("Check number of outputs", 3 == testFilter->GetNumberOfIndexedOutputs());
+
+  SignalImageType::Pointer out1 = testFilter->GetOutput(0);
+  SignalImageType::Pointer out2 = testFilter->GetOutput(1);
+  SignalImageType::Pointer out3 = testFilter->GetOutput(2);
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #1", 10. == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #1", 11. == out2->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #1", 12. == out3->GetPixel(testIndex1));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #2", 30. == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #2", 36. == out3->GetPixel(testIndex2));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #3", 44. == out2->GetPixel(testIndex3));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #4", 90. == out1->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #4", 108. == out3->GetPixel(testIndex4));
+
+  //Test with mask set
+  mitk::TestMaskType::Pointer mask = mitk::GenerateTestMask();
+  testFilter->SetMask(mask);
+
+  testFilter->Update();
+
+  out1 = testFilter->GetOutput(0);
+  out3 = testFilter->GetOutput(2);
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #1", 0. == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #2", 30. == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #3 index #3", 48. == out3->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #3 index #4", 0. == out3->GetPixel(testIndex4));
+
+  //Test that the number of inputs has to match the model
+  FilterType::Pointer invalidFilter = FilterType::New();
+  invalidFilter->SetInput(0, slopeImage);
+  invalidFilter->SetModel(model);
+
+  CPPUNIT_ASSERT_THROW(invalidFilter->Update(), itk::ExceptionObject);
+
+  MITK_TEST_END()
+}
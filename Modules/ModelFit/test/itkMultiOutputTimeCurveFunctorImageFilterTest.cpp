@@ -0,0 +1,242 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include "itkMultiOutputTimeCurveFunctorImageFilter.h"
+
+#include "mitkTestingMacros.h"
+#include "mitkVector.h"
+
+#include "mitkTestDynamicImageGenerator.h"
+
+namespace
+{
+  typedef itk::Image<int, 3> DynamicTestImageType;
+
+  class TestFunctor
+  {
+  public:
+    typedef std::vector<int> InputPixelArrayType;
+    typedef std::vector<int> OutputPixelArrayType;
+    typedef itk::Index<2> IndexType;
+
+    TestFunctor()
+    {
+      secondOutputSelection = 0;
+    };
+
+    ~TestFunctor() {};
+
+    int secondOutputSelection;
+
+    unsigned int GetNumberOfOutputs() const
+    {
+      return 4;
+    }
+
+    bool operator!=( const TestFunctor & other) const
+    {
+      return !(*this == other);
+    }
+
+    bool operator==( const TestFunctor & other ) const
+    {
+      return secondOutputSelection == other.secondOutputSelection;
+    }
+
+    inline OutputPixelArrayType operator()( const InputPixelArrayType & value, const IndexType& currentIndex ) const
+    {
+      OutputPixelArrayType result;
+
+      int sum = 0;
+      for (InputPixelArrayType::const_iterator pos = value.begin(); pos != value.end(); ++pos)
+      {
+        sum += *pos;
+      }
+
+      result.push_back(sum);
+      result.push_back(value[secondOutputSelection]);
+      result.push_back(currentIndex[0]);
+      result.push_back(currentIndex[1]);
+
+      return result;
+    }
+  };
+
+  /** Generates a 3x3 image with 3 time steps. The time steps have the values of
+   mitk::GenerateTestImage() with the factors 1, 10 and 100.*/
+  DynamicTestImageType::Pointer GenerateDynamicTestImage()
+  {
+    DynamicTestImageType::Pointer image = DynamicTestImageType::New();
+
+    DynamicTestImageType::SizeType size;
+    size.Fill(3);
+
+    DynamicTestImageType::RegionType region;
+    region.SetSize(size);
+
+    DynamicTestImageType::SpacingType spacing;
+    spacing[0] = 2.;
+    spacing[1] = 3.;
+    spacing[2] = 1.;
+
+    DynamicTestImageType::PointType origin;
+    origin[0] = 10.;
+    origin[1] = 20.;
+    origin[2] = 0.;
+
+    image->SetRegions(region);
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    image->Allocate();
+
+    itk::ImageRegionIterator<DynamicTestImageType> it(image, region);
+
+    int factor = 1;
+    while (!it.IsAtEnd())
+    {
+      mitk::TestImageType::Pointer frame = mitk::GenerateTestImage(factor);
+      itk::ImageRegionConstIterator<mitk::TestImageType> frameIt(frame, frame->GetLargestPossibleRegion());
+
+      while (!frameIt.IsAtEnd())
+      {
+        it.Set(frameIt.Get());
+        ++it;
+        ++frameIt;
+      }
+
+      factor *= 10;
+    }
+
+    return image;
+  }
+}
+
+int itkMultiOutputTimeCurveFunctorImageFilterTest(int  /*argc*/, char*[] /*argv[]*/)
+{
+  // always start with this!
+  MITK_TEST_BEGIN("itkMultiOutputTimeCurveFunctorImageFilter")
+
+  //Prepare test artifacts and helper
+
+  DynamicTestImageType::Pointer dynamicImage = GenerateDynamicTestImage();
+
+  mitk::TestImageType::IndexType testIndex1;
+  testIndex1[0] =   0;
+  testIndex1[1] =   0;
+
+  mitk::TestImageType::IndexType testIndex2;
+  testIndex2[0] =   2;
+  testIndex2[1] =   0;
+
+  mitk::TestImageType::IndexType testIndex3;
+  testIndex3[0] =   0;
+  testIndex3[1] =   1;
+
+  mitk::TestImageType::IndexType testIndex4;
+  testIndex4[0] =   1;
+  testIndex4[1] =   1;
+
+  mitk::TestImageType::IndexType testIndex5;
+  testIndex5[0] =   2;
+  testIndex5[1] =   2;
+
+  //Test default usage of filter
+  typedef itk::MultiOutputTimeCurveFunctorImageFilter<DynamicTestImageType,mitk::TestImageType,TestFunctor> FilterType;
+  FilterType::Pointer testFilter = FilterType::New();
+
+  testFilter->SetInput(dynamicImage);
+
+  testFilter->SetNumberOfThreads(2);
+
+  testFilter->Update();
+
+  mitk::TestImageType::Pointer out1 = testFilter->GetOutput(0);
+  mitk::TestImageType::Pointer out2 = testFilter->GetOutput(1);
+  mitk::TestImageType::Pointer out3 = testFilter->GetOutput(2);
+  mitk::TestImageType::Pointer out4 = testFilter->GetOutput(3);
+
+  CPPUNIT_ASSERT_MESSAGE("Check size of output #1", 3 == out1->GetLargestPossibleRegion().GetSize(0) && 3 == out1->GetLargestPossibleRegion().GetSize(1));
+  CPPUNIT_ASSERT_MESSAGE("Check spacing of output #4", 2. == out4->GetSpacing()[0] && 3. == out4->GetSpacing()[1]);
+  CPPUNIT_ASSERT_MESSAGE("Check origin of output #4", 10. == out4->GetOrigin()[0] && 20. == out4->GetOrigin()[1]);
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #1 (functor #1)",111 == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #2 (functor #1)",333 == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #3 (functor #1)",444 == out1->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #4 (functor #1)",555 == out1->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #5 (functor #1)",999 == out1->GetPixel(testIndex5));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #1 (functor #1)",1 == out2->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #2 (functor #1)",3 == out2->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #3 (functor #1)",4 == out2->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #4 (functor #1)",5 == out2->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #5 (functor #1)",9 == out2->GetPixel(testIndex5));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #1 (functor #1)",0 == out3->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #2 (functor #1)",2 == out3->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #3 (functor #1)",0 == out3->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #4 (functor #1)",1 == out3->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #3 index #5 (functor #1)",2 == out3->GetPixel(testIndex5));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #4 index #1 (functor #1)",0 == out4->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #4 index #2 (functor #1)",0 == out4->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #4 index #3 (functor #1)",1 == out4->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #4 index #4 (functor #1)",1 == out4->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #4 index #5 (functor #1)",2 == out4->GetPixel(testIndex5));
+
+  //Test with functor set by user
+  TestFunctor funct2;
+  funct2.secondOutputSelection = 2;
+
+  testFilter->SetFunctor(funct2);
+
+  testFilter->Update();
+
+  out1 = testFilter->GetOutput(0);
+  out2 = testFilter->GetOutput(1);
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #1 (functor #2)",111 == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #1 index #5 (functor #2)",999 == out1->GetPixel(testIndex5));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #1 (functor #2)",100 == out2->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #2 (functor #2)",300 == out2->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #3 (functor #2)",400 == out2->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #4 (functor #2)",500 == out2->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of output #2 index #5 (functor #2)",900 == out2->GetPixel(testIndex5));
+
+  //Test with mask set
+  mitk::TestMaskType::Pointer mask = mitk::GenerateTestMask();
+  testFilter->SetMask(mask);
+
+  testFilter->Update();
+
+  out1 = testFilter->GetOutput(0);
+  out2 = testFilter->GetOutput(1);
+  out3 = testFilter->GetOutput(2);
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #1 (functor #2)",0 == out1->GetPixel(testIndex1));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #2 (functor #2)",333 == out1->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #3 (functor #2)",444 == out1->GetPixel(testIndex3));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #4 (functor #2)",0 == out1->GetPixel(testIndex4));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #1 index #5 (functor #2)",0 == out1->GetPixel(testIndex5));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #2 index #2 (functor #2)",300 == out2->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #2 index #4 (functor #2)",0 == out2->GetPixel(testIndex4));
+
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #3 index #2 (functor #2)",2 == out3->GetPixel(testIndex2));
+  CPPUNIT_ASSERT_MESSAGE("Check pixel of masked output #3 index #5 (functor #2)",0 == out3->GetPixel(testIndex5));
+
+  MITK_TEST_END()
+}
@@ -10,18 +10,23 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include <fstream>
 #include <iostream>
 
 #include "itkImageRegionIterator.h"
+#include <itksys/SystemTools.hxx>
 
 #include "mitkTestingMacros.h"
 #include "mitkImage.h"
 #include "mitkImagePixelReadAccessor.h"
+#include "mitkImagePixelWriteAccessor.h"
+#include "mitkIOUtil.h"
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
 #include "mitkLinearModelParameterizer.h"
 
 #include "mitkLevenbergMarquardtModelFitFunctor.h"
+#include "mitkValueBasedParameterizationDelegate.h"
 
 #include "mitkTestDynamicImageGenerator.h"
 
@@ -151,5 +156,131 @@ int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]
     testValue = offsetAccessor2.GetPixelByIndex(testIndex6);
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #6");
 
+    //Test chunked fit with checkpoints
+    const std::string checkpointDir = mitk::IOUtil::CreateTemporaryDirectory("mitkFitCheckpointTest_XXXXXX");
+
+    mitk::PixelBasedParameterFitImageGenerator::Pointer chunkedGenerator = mitk::PixelBasedParameterFitImageGenerator::New();
+    chunkedGenerator->SetDynamicImage(dynamicImage);
+    chunkedGenerator->SetModelParameterizer(parameterizer);
+    chunkedGenerator->SetFitFunctor(testFunctor);
+    chunkedGenerator->SetSlicesPerChunk(2);
+    chunkedGenerator->SetCheckpointDirectory(checkpointDir);
+
+    chunkedGenerator->Generate();
+
+    resultImages = chunkedGenerator->GetParameterImages();
+    derivedResultImages = chunkedGenerator->GetDerivedParameterImages();
+
+    CPPUNIT_ASSERT_MESSAGE("Check number of parameter images of chunked fit", 2 == resultImages.size());
+    CPPUNIT_ASSERT_MESSAGE("Check number of derived parameter images of chunked fit", 1 == derivedResultImages.size());
+    MITK_TEST_CONDITION(mitk::Equal(1., chunkedGenerator->GetProgress(), 1e-10, true), "Check progress of chunked fit.");
+
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor3(resultImages["slope"]);
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> offsetAccessor3(resultImages["offset"]);
+
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex2);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(2000,testValue, 1e-4, true)==true, "Check chunked param #1 (slope) at index #2");
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check chunked param #1 (slope) at index #3");
+    testValue = slopeAccessor3.GetPixelByIndex(testIndex4);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(8000,testValue, 1e-4, true)==true, "Check chunked param #1 (slope) at index #4");
+    testValue = offsetAccessor3.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(20,testValue, 1e-5, true)==true, "Check chunked param #2 (offset) at index #3");
+
+    //the test image has 3 slices -> 2 chunks
+    std::ifstream checkpointFile(checkpointDir + "/fitCheckpoint.txt");
+    MITK_TEST_CONDITION_REQUIRED(checkpointFile.is_open(), "Check that the checkpoint file was written.");
+    std::string line;
+    unsigned int lineCount = 0;
+    while (std::getline(checkpointFile, line))
+    {
+      ++lineCount;
+    }
+    checkpointFile.close();
+    CPPUNIT_ASSERT_MESSAGE("Check that the header and both chunks are recorded in the checkpoint.", 3 == lineCount);
+
+    //Mark a voxel in the tile of the second chunk to show that the recorded chunks are restored and not fitted again.
+    const std::string tilePath = checkpointDir + "/chunk_1_result_0.nrrd";
+    mitk::Image::Pointer tileImage = mitk::IOUtil::Load<mitk::Image>(tilePath);
+    itk::Index<3> tileIndex;
+    tileIndex[0] = testIndex3[0];
+    tileIndex[1] = testIndex3[1];
+    tileIndex[2] = 0;
+    {
+      mitk::ImagePixelWriteAccessor<mitk::ScalarType,3> tileAccessor(tileImage);
+      tileAccessor.SetPixelByIndex(tileIndex, 12345);
+    }
+    mitk::IOUtil::Save(tileImage, tilePath);
+
+    //Resume from the checkpoint
+    mitk::PixelBasedParameterFitImageGenerator::Pointer resumedGenerator = mitk::PixelBasedParameterFitImageGenerator::New();
+    resumedGenerator->SetDynamicImage(dynamicImage);
+    resumedGenerator->SetModelParameterizer(parameterizer);
+    resumedGenerator->SetFitFunctor(testFunctor);
+    resumedGenerator->SetSlicesPerChunk(2);
+    resumedGenerator->SetCheckpointDirectory(checkpointDir);
+    resumedGenerator->ResumeFromCheckpointOn();
+
+    resumedGenerator->Generate();
+
+    resultImages = resumedGenerator->GetParameterImages();
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor4(resultImages["slope"]);
+
+    testValue = slopeAccessor4.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(12345,testValue, 1e-4, true)==true, "Check restored param #1 (slope) at index #3");
+    testValue = slopeAccessor4.GetPixelByIndex(testIndex6);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(5000,testValue, 1e-4, true)==true, "Check restored param #1 (slope) at index #6");
+
+    //Resuming a checkpoint written for other inputs or another chunk size is rejected.
+    resumedGenerator->SetMask(maskImage);
+    MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::Exception)
+      resumedGenerator->Generate();
+    MITK_TEST_FOR_EXCEPTION_END(mitk::Exception)
+
+    resumedGenerator->SetMask(nullptr);
+    resumedGenerator->SetSlicesPerChunk(1);
+    MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::Exception)
+      resumedGenerator->Generate();
+    MITK_TEST_FOR_EXCEPTION_END(mitk::Exception)
+
+    //Resuming a checkpoint written with other fit settings or initial parameters is rejected as well.
+    resumedGenerator->SetSlicesPerChunk(2);
+    mitk::LevenbergMarquardtModelFitFunctor::Pointer otherFunctor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    otherFunctor->SetIterations(10);
+    resumedGenerator->SetFitFunctor(otherFunctor);
+    MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::Exception)
+      resumedGenerator->Generate();
+    MITK_TEST_FOR_EXCEPTION_END(mitk::Exception)
+
+    resumedGenerator->SetFitFunctor(testFunctor);
+    mitk::LinearModelParameterizer::Pointer otherParameterizer = mitk::LinearModelParameterizer::New();
+    mitk::ValueBasedParameterizationDelegate::Pointer initialParameters = mitk::ValueBasedParameterizationDelegate::New();
+    mitk::ModelBase::ParametersType otherInitialParameters(2);
+    otherInitialParameters[0] = 3.5;
+    otherInitialParameters[1] = -7.;
+    initialParameters->SetInitialParameterization(otherInitialParameters);
+    otherParameterizer->SetInitialParameterizationDelegate(initialParameters);
+    resumedGenerator->SetModelParameterizer(otherParameterizer);
+    MITK_TEST_FOR_EXCEPTION_BEGIN(mitk::Exception)
+      resumedGenerator->Generate();
+    MITK_TEST_FOR_EXCEPTION_END(mitk::Exception)
+
+    resumedGenerator->SetModelParameterizer(parameterizer);
+
+    //Without resuming the checkpoint is overwritten -> the masked fit is done.
+    resumedGenerator->SetMask(maskImage);
+    resumedGenerator->ResumeFromCheckpointOff();
+    resumedGenerator->Generate();
+
+    resultImages = resumedGenerator->GetParameterImages();
+    mitk::ImagePixelReadAccessor<mitk::ScalarType,3> slopeAccessor5(resultImages["slope"]);
+
+    testValue = slopeAccessor5.GetPixelByIndex(testIndex3);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check refitted param #1 (slope) at index #3");
+    testValue = slopeAccessor5.GetPixelByIndex(testIndex5);
+    MITK_TEST_CONDITION_REQUIRED(mitk::Equal(4000,testValue, 1e-4, true)==true, "Check refitted param #1 (slope) at index #5");
+
+    itksys::SystemTools::RemoveADirectory(checkpointDir);
+
   MITK_TEST_END()
 }
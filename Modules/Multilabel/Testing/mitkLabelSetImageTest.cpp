@@ -12,10 +12,13 @@ found in the LICENSE file.
 
 #include <mitkIOUtil.h>
 #include <mitkImageStatisticsHolder.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <chrono>
+
 class mitkLabelSetImageTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkLabelSetImageTestSuite);
@@ -34,6 +37,10 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestMergeLabel);
+  MITK_TEST(TestLayerCompression);
+  MITK_TEST(TestLayerCompressionMemoryAndSwitchTime);
+  MITK_TEST(TestLabelIndex);
+  MITK_TEST(TestLabelIndexIncrementalUpdate);
   // TODO check it these functionalities can be moved into a process object
   //  MITK_TEST(TestMergeLabels);
   //  MITK_TEST(TestConcatenate);
@@ -47,6 +54,33 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
 private:
   mitk::LabelSetImage::Pointer m_LabelSetImage;
 
+  // paints a block of voxels with the given value into the active layer
+  void Paint(mitk::LabelSetImage *image, std::size_t offset, std::size_t count, mitk::Label::PixelType value)
+  {
+    mitk::ImageWriteAccessor accessor(image);
+    auto data = static_cast<mitk::Label::PixelType *>(accessor.GetData());
+    std::fill_n(data + offset, count, value);
+  }
+
+  mitk::LabelSetImage::Pointer CreateMultiLayerImage(bool compression, unsigned int numberOfLayers)
+  {
+    auto labelSetImage = mitk::LabelSetImage::New();
+    mitk::Image::Pointer regularImage = mitk::Image::New();
+    unsigned int dimensions[3] = {128, 128, 64};
+    regularImage->Initialize(mitk::MakeScalarPixelType<int>(), 3, dimensions);
+    labelSetImage->Initialize(regularImage);
+    labelSetImage->SetLayerCompression(compression);
+
+    for (unsigned int layer = 0; layer < numberOfLayers; ++layer)
+    {
+      if (layer > 0)
+        labelSetImage->AddLayer();
+      Paint(labelSetImage, 128 * 128 * (10 + layer) + 100 * layer, 5000, layer + 1);
+      Paint(labelSetImage, 128 * 128 * 40, 128 * 128 * 2, layer + 2);
+    }
+    return labelSetImage;
+  }
+
 public:
   void setUp() override
   {
@@ -439,6 +473,155 @@ public:
     // Check if merge label has 507 + 823 = 1330 pixels
     CPPUNIT_ASSERT_MESSAGE("Label with value 7 was not remove from the image", m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 1330);
   }
+
+  void TestLayerCompression()
+  {
+    auto dense = CreateMultiLayerImage(false, 3);
+    auto compressed = CreateMultiLayerImage(true, 3);
+    CPPUNIT_ASSERT(compressed->GetLayerCompression());
+
+    for (unsigned int layer : {0, 2, 1, 0})
+    {
+      dense->SetActiveLayer(layer);
+      compressed->SetActiveLayer(layer);
+      MITK_ASSERT_EQUAL(dense, compressed, "Compressed layers differ from dense layers");
+    }
+
+    // modifications of decompressed layer images must not get lost
+    for (auto image : {dense, compressed})
+    {
+      mitk::ImageWriteAccessor accessor(image->GetLayerImage(2));
+      static_cast<mitk::Label::PixelType *>(accessor.GetData())[42] = 17;
+    }
+    dense->SetActiveLayer(2);
+    compressed->SetActiveLayer(2);
+    MITK_ASSERT_EQUAL(dense, compressed, "Modified layer image was not taken over");
+
+    // removing layers and switching back to dense storage
+    dense->RemoveLayer();
+    compressed->RemoveLayer();
+    MITK_ASSERT_EQUAL(dense, compressed, "Compressed layers differ after removing a layer");
+    compressed->SetLayerCompression(false);
+    CPPUNIT_ASSERT(!compressed->GetLayerCompression());
+    dense->SetActiveLayer(0);
+    compressed->SetActiveLayer(0);
+    MITK_ASSERT_EQUAL(dense, compressed, "Layers differ after disabling the compression");
+  }
+
+  void TestLayerCompressionMemoryAndSwitchTime()
+  {
+    const unsigned int numberOfLayers = 10;
+    auto dense = CreateMultiLayerImage(false, numberOfLayers);
+    auto compressed = CreateMultiLayerImage(true, numberOfLayers);
+
+    MITK_INFO << "Layer memory dense: " << dense->GetLayerMemorySize()
+              << " bytes, compressed: " << compressed->GetLayerMemorySize() << " bytes";
+    CPPUNIT_ASSERT_MESSAGE("Compressed layers are not considerably smaller than dense layers",
+                           compressed->GetLayerMemorySize() * 20 < dense->GetLayerMemorySize());
+
+    for (auto image : {dense, compressed})
+    {
+      auto start = std::chrono::steady_clock::now();
+      for (unsigned int layer = 0; layer < numberOfLayers; ++layer)
+        image->SetActiveLayer(layer);
+      std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+      MITK_INFO << (image->GetLayerCompression() ? "Compressed" : "Dense") << " layer switch: "
+                << duration.count() / numberOfLayers << " ms";
+    }
+  }
+
+  void TestLabelIndex()
+  {
+    const std::size_t sliceSize = 256 * 256;
+    // label 3: a line in slice 10 starting at x = 20, y = 5
+    Paint(m_LabelSetImage, sliceSize * 10 + 256 * 5 + 20, 10, 3);
+    // label 5: two rows in slice 50 and one voxel in slice 60
+    Paint(m_LabelSetImage, sliceSize * 50, 512, 5);
+    Paint(m_LabelSetImage, sliceSize * 60 + 256 * 7 + 9, 1, 5);
+    m_LabelSetImage->Modified();
+
+    auto entry = m_LabelSetImage->GetLabelIndexEntry(3);
+    CPPUNIT_ASSERT(entry != nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), entry->NumberOfVoxels);
+    itk::ImageRegion<3> expectedRegion({{20, 5, 10}}, {{10, 1, 1}});
+    CPPUNIT_ASSERT_EQUAL(expectedRegion, entry->GetBoundingRegion());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(24.5, entry->GetCentroidIndex()[0], mitk::eps);
+
+    entry = m_LabelSetImage->GetLabelIndexEntry(5);
+    CPPUNIT_ASSERT(entry != nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(513), entry->NumberOfVoxels);
+    expectedRegion = itk::ImageRegion<3>({{0, 0, 50}}, {{256, 8, 11}});
+    CPPUNIT_ASSERT_EQUAL(expectedRegion, entry->GetBoundingRegion());
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelIndexEntry(4) == nullptr);
+
+    // merging and erasing update the index without losing voxels
+    mitk::Label::Pointer label = mitk::Label::New();
+    label->SetValue(5);
+    m_LabelSetImage->GetActiveLabelSet()->AddLabel(label);
+    m_LabelSetImage->MergeLabel(5, 3);
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelIndexEntry(3) == nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(523), m_LabelSetImage->GetLabelIndexEntry(5)->NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(523., m_LabelSetImage->GetStatistics()->GetCountOfMaxValuedVoxels());
+
+    m_LabelSetImage->UpdateCenterOfMass(5);
+    mitk::Point3D centerOfMass = m_LabelSetImage->GetLabel(5)->GetCenterOfMassIndex();
+    // voxel 261 of 523 in scan order (after the ten former voxels of label 3) lies in the first row of slice 50
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(251., centerOfMass[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., centerOfMass[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(50., centerOfMass[2], mitk::eps);
+
+    auto mask = m_LabelSetImage->CreateLabelMask(5);
+    CPPUNIT_ASSERT_EQUAL(523., mask->GetStatistics()->GetCountOfMaxValuedVoxels());
+
+    m_LabelSetImage->EraseLabel(5);
+    CPPUNIT_ASSERT(m_LabelSetImage->GetLabelIndexEntry(5) == nullptr);
+    CPPUNIT_ASSERT_EQUAL(sliceSize * 312, m_LabelSetImage->GetLabelIndexEntry(0)->NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(0., m_LabelSetImage->GetStatistics()->GetScalarValueMax());
+  }
+
+  void TestLabelIndexIncrementalUpdate()
+  {
+    const std::size_t sliceSize = 256 * 256;
+    // label 3: a line in slice 10 starting at x = 20, y = 5
+    Paint(m_LabelSetImage, sliceSize * 10 + 256 * 5 + 20, 10, 3);
+    m_LabelSetImage->Modified();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), m_LabelSetImage->GetLabelIndexEntry(3)->NumberOfVoxels);
+
+    // changing the active label does not touch the voxels and must not invalidate the index
+    m_LabelSetImage->GetActiveLabelSet()->SetActiveLabel(0);
+
+    // overwrite the first four voxels of label 3 as a slice write-back would do
+    itk::ImageRegion<3> sliceRegion({{0, 0, 10}}, {{256, 256, 1}});
+    m_LabelSetImage->BeginLabelIndexUpdate(sliceRegion);
+    Paint(m_LabelSetImage, sliceSize * 10 + 256 * 5 + 20, 4, 7);
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->EndLabelIndexUpdate();
+
+    auto entry = m_LabelSetImage->GetLabelIndexEntry(3);
+    CPPUNIT_ASSERT(entry != nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), entry->NumberOfVoxels);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(26.5, entry->GetCentroidIndex()[0], mitk::eps);
+    CPPUNIT_ASSERT(entry->GetBoundingRegion().IsInside(itk::ImageRegion<3>({{24, 5, 10}}, {{6, 1, 1}})));
+
+    entry = m_LabelSetImage->GetLabelIndexEntry(7);
+    CPPUNIT_ASSERT(entry != nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), entry->NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(itk::ImageRegion<3>({{20, 5, 10}}, {{4, 1, 1}}), entry->GetBoundingRegion());
+    CPPUNIT_ASSERT_EQUAL(sliceSize * 312 - 10, m_LabelSetImage->GetLabelIndexEntry(0)->NumberOfVoxels);
+
+    // an index that has been outdated before the write is rebuilt instead of updated
+    Paint(m_LabelSetImage, sliceSize * 20, 5, 3);
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->BeginLabelIndexUpdate(sliceRegion);
+    Paint(m_LabelSetImage, sliceSize * 10 + 256 * 5 + 24, 6, 0);
+    m_LabelSetImage->Modified();
+    m_LabelSetImage->EndLabelIndexUpdate();
+
+    entry = m_LabelSetImage->GetLabelIndexEntry(3);
+    CPPUNIT_ASSERT(entry != nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), entry->NumberOfVoxels);
+    CPPUNIT_ASSERT_EQUAL(itk::ImageRegion<3>({{0, 0, 20}}, {{5, 1, 1}}), entry->GetBoundingRegion());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
@@ -1,6 +1,7 @@
 set(CPP_FILES
   mitkLabel.cpp
   mitkLabelSet.cpp
+  mitkCompressedLabelLayer.cpp
   mitkLabelSetImage.cpp
   mitkLabelSetImageConverter.cpp
   mitkLabelSetImageSource.cpp
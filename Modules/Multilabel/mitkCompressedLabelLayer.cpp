@@ -0,0 +1,126 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkCompressedLabelLayer.h"
+
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <algorithm>
+
+mitk::CompressedLabelLayer::CompressedLabelLayer() : m_SliceSize(0), m_NumberOfSlices(0)
+{
+}
+
+mitk::CompressedLabelLayer::~CompressedLabelLayer()
+{
+}
+
+void mitk::CompressedLabelLayer::InitializeDimensions(const mitk::Image *image)
+{
+  if (image == nullptr || !image->IsInitialized())
+    mitkThrow() << "Cannot compress an uninitialized layer image.";
+
+  if (image->GetPixelType() != mitk::MakeScalarPixelType<PixelType>())
+    mitkThrow() << "Only layer images of the label pixel type can be compressed.";
+
+  m_SliceSize = static_cast<std::size_t>(image->GetDimension(0)) * image->GetDimension(1);
+  m_NumberOfSlices = 1;
+  for (unsigned int dim = 2; dim < image->GetDimension(); ++dim)
+    m_NumberOfSlices *= image->GetDimension(dim);
+}
+
+void mitk::CompressedLabelLayer::InitializeEmpty(const mitk::Image *referenceImage)
+{
+  this->InitializeDimensions(referenceImage);
+
+  m_Runs.clear();
+  m_Runs.shrink_to_fit();
+  m_SliceOffsets.assign(m_NumberOfSlices + 1, 0);
+
+  this->Modified();
+}
+
+void mitk::CompressedLabelLayer::Compress(const mitk::Image *image)
+{
+  this->InitializeDimensions(image);
+
+  m_Runs.clear();
+  m_SliceOffsets.resize(m_NumberOfSlices + 1);
+
+  ImageReadAccessor accessor(image);
+  auto data = static_cast<const PixelType *>(accessor.GetData());
+
+  for (unsigned int slice = 0; slice < m_NumberOfSlices; ++slice)
+  {
+    m_SliceOffsets[slice] = m_Runs.size();
+
+    const PixelType *it = data + slice * m_SliceSize;
+    const PixelType *end = it + m_SliceSize;
+
+    // slices consisting of the exterior label only are stored without runs
+    if (std::all_of(it, end, [](PixelType value) { return value == 0; }))
+      continue;
+
+    while (it != end)
+    {
+      const PixelType value = *it;
+      const PixelType *runEnd = std::find_if(it, end, [value](PixelType other) { return other != value; });
+      m_Runs.push_back({value, static_cast<unsigned int>(runEnd - it)});
+      it = runEnd;
+    }
+  }
+  m_SliceOffsets[m_NumberOfSlices] = m_Runs.size();
+  m_Runs.shrink_to_fit();
+
+  this->Modified();
+}
+
+void mitk::CompressedLabelLayer::DecompressSlice(unsigned int slice, PixelType *buffer) const
+{
+  if (slice >= m_NumberOfSlices)
+    mitkThrow() << "Slice " << slice << " is out of range.";
+
+  auto runIter = m_Runs.begin() + m_SliceOffsets[slice];
+  const auto runEnd = m_Runs.begin() + m_SliceOffsets[slice + 1];
+
+  if (runIter == runEnd)
+  {
+    std::fill_n(buffer, m_SliceSize, PixelType(0));
+    return;
+  }
+
+  for (; runIter != runEnd; ++runIter)
+    buffer = std::fill_n(buffer, runIter->Length, runIter->Value);
+}
+
+void mitk::CompressedLabelLayer::Decompress(mitk::Image *target) const
+{
+  std::size_t numberOfVoxels = 1;
+  for (unsigned int dim = 0; dim < target->GetDimension(); ++dim)
+    numberOfVoxels *= target->GetDimension(dim);
+
+  if (target->GetPixelType() != mitk::MakeScalarPixelType<PixelType>() ||
+      numberOfVoxels != m_SliceSize * m_NumberOfSlices)
+    mitkThrow() << "Target image does not match the compressed layer.";
+
+  ImageWriteAccessor accessor(target);
+  auto data = static_cast<PixelType *>(accessor.GetData());
+
+  for (unsigned int slice = 0; slice < m_NumberOfSlices; ++slice)
+    this->DecompressSlice(slice, data + slice * m_SliceSize);
+}
+
+std::size_t mitk::CompressedLabelLayer::GetMemorySize() const
+{
+  return sizeof(Self) + m_Runs.capacity() * sizeof(Run) + m_SliceOffsets.capacity() * sizeof(std::size_t);
+}
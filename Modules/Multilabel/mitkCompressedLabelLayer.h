@@ -0,0 +1,96 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __mitkCompressedLabelLayer_H_
+#define __mitkCompressedLabelLayer_H_
+
+#include "MitkMultilabelExports.h"
+#include <mitkImage.h>
+#include <mitkLabel.h>
+
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+namespace mitk
+{
+  //##Documentation
+  //## @brief Run-length encoded copy of a single layer of a mitk::LabelSetImage.
+  //##
+  //## The layer is encoded slice by slice (x/y plane, all slices of all time steps in memory order), each slice as a
+  //## sequence of runs of equal label values. Slices that only contain the exterior label (0) are stored without any
+  //## run, so sparse segmentations need almost no memory. Single slices can be decompressed independently via
+  //## DecompressSlice().
+  //##
+  //## Only images with the pixel type mitk::Label::PixelType are supported.
+  //## @ingroup Data
+  class MITKMULTILABEL_EXPORT CompressedLabelLayer : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(CompressedLabelLayer, itk::Object);
+    itkNewMacro(Self);
+
+    typedef mitk::Label::PixelType PixelType;
+
+    /**
+     * @brief Encodes the complete content of @a image.
+     * @throw mitk::Exception if the pixel type of @a image is not mitk::Label::PixelType.
+     */
+    void Compress(const mitk::Image *image);
+
+    /**
+     * @brief Initializes an empty layer (all voxels 0) with the dimensions of @a referenceImage without reading its
+     * content.
+     */
+    void InitializeEmpty(const mitk::Image *referenceImage);
+
+    /**
+     * @brief Writes the complete layer into the buffer of @a target.
+     * @throw mitk::Exception if the number of voxels of @a target does not match the layer.
+     */
+    void Decompress(mitk::Image *target) const;
+
+    /**
+     * @brief Writes slice @a slice (counted over all time steps) into @a buffer, which has to hold GetSliceSize()
+     * values.
+     */
+    void DecompressSlice(unsigned int slice, PixelType *buffer) const;
+
+    std::size_t GetSliceSize() const { return m_SliceSize; }
+
+    unsigned int GetNumberOfSlices() const { return m_NumberOfSlices; }
+
+    /** @brief Returns the number of bytes occupied by the encoded data. */
+    std::size_t GetMemorySize() const;
+
+  protected:
+    CompressedLabelLayer();
+    ~CompressedLabelLayer() override;
+
+    void InitializeDimensions(const mitk::Image *image);
+
+    struct Run
+    {
+      PixelType Value;
+      unsigned int Length;
+    };
+
+    /** runs of all slices in memory order */
+    std::vector<Run> m_Runs;
+    /** index of the first run of every slice; m_SliceOffsets[slice + 1] is the end of the slice */
+    std::vector<std::size_t> m_SliceOffsets;
+
+    std::size_t m_SliceSize;
+    unsigned int m_NumberOfSlices;
+  };
+} // namespace mitk
+
+#endif // __mitkCompressedLabelLayer_H_
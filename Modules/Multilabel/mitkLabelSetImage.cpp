@@ -60,8 +60,123 @@ void CreateLabelMaskProcessing(mitk::Image *layerImage, mitk::Image *mask, mitk:
   }
 }
 
+template <typename TPixel, typename TFunctor>
+void ProcessLabelRegion(TPixel *data,
+                        const unsigned int *dimensions,
+                        const itk::ImageRegion<3> &region,
+                        TFunctor functor)
+{
+  const auto begin = region.GetIndex();
+  const auto end = region.GetUpperIndex();
+
+  for (auto z = begin[2]; z <= end[2]; ++z)
+  {
+    for (auto y = begin[1]; y <= end[1]; ++y)
+    {
+      TPixel *row = data + (static_cast<std::size_t>(z) * dimensions[1] + y) * dimensions[0];
+      for (auto x = begin[0]; x <= end[0]; ++x)
+        functor(row[x], x, y, z);
+    }
+  }
+}
+
+void CreateLabelMaskInRegionProcessing(mitk::Image *layerImage,
+                                       mitk::Image *mask,
+                                       mitk::LabelSet::PixelType index,
+                                       const itk::ImageRegion<3> &region)
+{
+  mitk::ImagePixelReadAccessor<mitk::LabelSet::PixelType, 3> readAccessor(layerImage);
+  mitk::ImagePixelWriteAccessor<mitk::LabelSet::PixelType, 3> writeAccessor(mask);
+
+  auto src = readAccessor.GetData();
+  auto dest = writeAccessor.GetData();
+
+  ProcessLabelRegion(src,
+                     layerImage->GetDimensions(),
+                     region,
+                     [&](const mitk::LabelSet::PixelType &value, itk::IndexValueType, itk::IndexValueType, itk::IndexValueType) {
+                       if (index == value)
+                         dest[&value - src] = 1;
+                     });
+}
+
+void mitk::LabelSetImage::LabelIndexEntry::AddRun(const itk::Index<3> &start, std::size_t length)
+{
+  itk::Index<3> end = start;
+  end[0] += static_cast<itk::IndexValueType>(length) - 1;
+
+  if (0 == NumberOfVoxels)
+  {
+    MinIndex = start;
+    MaxIndex = end;
+  }
+  else
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      MinIndex[dim] = std::min(MinIndex[dim], start[dim]);
+      MaxIndex[dim] = std::max(MaxIndex[dim], end[dim]);
+    }
+  }
+
+  NumberOfVoxels += length;
+  IndexSum[0] += static_cast<double>(length) * (start[0] + end[0]) / 2.0;
+  IndexSum[1] += static_cast<double>(length) * start[1];
+  IndexSum[2] += static_cast<double>(length) * start[2];
+}
+
+void mitk::LabelSetImage::LabelIndexEntry::RemoveRun(const itk::Index<3> &start, std::size_t length)
+{
+  // the bounding region is kept, it still contains all remaining voxels
+  NumberOfVoxels -= std::min(length, NumberOfVoxels);
+  IndexSum[0] -= static_cast<double>(length) * (2 * start[0] + static_cast<itk::IndexValueType>(length) - 1) / 2.0;
+  IndexSum[1] -= static_cast<double>(length) * start[1];
+  IndexSum[2] -= static_cast<double>(length) * start[2];
+}
+
+void mitk::LabelSetImage::LabelIndexEntry::Merge(const LabelIndexEntry &other)
+{
+  if (0 == other.NumberOfVoxels)
+    return;
+
+  if (0 == NumberOfVoxels)
+  {
+    *this = other;
+    return;
+  }
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    MinIndex[dim] = std::min(MinIndex[dim], other.MinIndex[dim]);
+    MaxIndex[dim] = std::max(MaxIndex[dim], other.MaxIndex[dim]);
+  }
+  NumberOfVoxels += other.NumberOfVoxels;
+  IndexSum += other.IndexSum;
+}
+
+itk::ImageRegion<3> mitk::LabelSetImage::LabelIndexEntry::GetBoundingRegion() const
+{
+  itk::ImageRegion<3> region;
+  region.SetIndex(MinIndex);
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    region.SetSize(dim, NumberOfVoxels > 0 ? MaxIndex[dim] - MinIndex[dim] + 1 : 0);
+  return region;
+}
+
+mitk::Point3D mitk::LabelSetImage::LabelIndexEntry::GetCentroidIndex() const
+{
+  mitk::Point3D centroid;
+  centroid.Fill(0.0);
+  if (NumberOfVoxels > 0)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      centroid[dim] = IndexSum[dim] / NumberOfVoxels;
+  }
+  return centroid;
+}
+
 mitk::LabelSetImage::LabelSetImage()
-  : mitk::Image(), m_ActiveLayer(0), m_activeLayerInvalid(false), m_ExteriorLabel(nullptr)
+  : mitk::Image(), m_LayerCompression(false), m_LabelIndexTime(0), m_LabelIndexValid(false), m_LabelIndexUpdatePending(false), m_ActiveLayer(0), m_activeLayerInvalid(false), m_ExteriorLabel(nullptr)
 {
   // Iniitlaize Background Label
   mitk::Color color;
@@ -79,6 +194,10 @@ mitk::LabelSetImage::LabelSetImage()
 
 mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
   : Image(other),
+    m_LayerCompression(other.GetLayerCompression()),
+    m_LabelIndexTime(0),
+    m_LabelIndexValid(false),
+    m_LabelIndexUpdatePending(false),
     m_ActiveLayer(other.GetActiveLayer()),
     m_activeLayerInvalid(false),
     m_ExteriorLabel(other.GetExteriorLabel()->Clone())
@@ -94,8 +213,20 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
     m_LabelSetContainer.push_back(lsClone);
 
     // clone layer Image data
-    mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
-    m_LayerContainer.push_back(liClone);
+    if (m_LayerCompression)
+    {
+      // take over a decompressed cache, it may contain modifications not yet compressed
+      mitk::Image::Pointer liClone = other.m_LayerContainer[i].IsNotNull() ? other.m_LayerContainer[i]->Clone() : nullptr;
+      m_LayerContainer.push_back(liClone);
+
+      // compressed layers are never modified once stored, so they can be shared
+      m_CompressedLayerContainer.push_back(other.m_CompressedLayerContainer[i]);
+    }
+    else
+    {
+      mitk::Image::Pointer liClone = other.GetLayerImage(i)->Clone();
+      m_LayerContainer.push_back(liClone);
+    }
   }
 
   // Add some DICOM Tags as properties to segmentation image
@@ -104,7 +235,11 @@ mitk::LabelSetImage::LabelSetImage(const mitk::LabelSetImage &other)
 
 void mitk::LabelSetImage::OnLabelSetModified()
 {
+  // changes of the label sets (e.g. of the active label) do not change the voxels, the label index stays valid
+  const bool labelIndexIsCurrent = m_LabelIndexValid && m_LabelIndexTime == this->GetMTime();
   Superclass::Modified();
+  if (labelIndexIsCurrent)
+    m_LabelIndexTime = this->GetMTime();
 }
 
 void mitk::LabelSetImage::SetExteriorLabel(mitk::Label *label)
@@ -124,6 +259,8 @@ const mitk::Label *mitk::LabelSetImage::GetExteriorLabel() const
 
 void mitk::LabelSetImage::Initialize(const mitk::Image *other)
 {
+  this->InvalidateLabelIndex();
+
   mitk::PixelType pixelType(mitk::MakeScalarPixelType<LabelSetImage::PixelType>());
   if (other->GetDimension() == 2)
   {
@@ -162,14 +299,92 @@ mitk::LabelSetImage::~LabelSetImage()
 
 mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer)
 {
+  if (m_LayerCompression && m_LayerContainer[layer].IsNull())
+    m_LayerContainer[layer] = this->DecompressLayer(layer);
+
   return m_LayerContainer[layer];
 }
 
 const mitk::Image *mitk::LabelSetImage::GetLayerImage(unsigned int layer) const
 {
+  if (m_LayerCompression && m_LayerContainer[layer].IsNull())
+    m_LayerContainer[layer] = this->DecompressLayer(layer);
+
   return m_LayerContainer[layer];
 }
 
+mitk::Image::Pointer mitk::LabelSetImage::DecompressLayer(unsigned int layer) const
+{
+  mitk::Image::Pointer layerImage = mitk::Image::New();
+  layerImage->Initialize(this->GetPixelType(),
+                         this->GetDimension(),
+                         this->GetDimensions(),
+                         this->GetImageDescriptor()->GetNumberOfChannels());
+  layerImage->SetTimeGeometry(this->GetTimeGeometry()->Clone());
+
+  m_CompressedLayerContainer[layer]->Decompress(layerImage);
+
+  return layerImage;
+}
+
+void mitk::LabelSetImage::SetLayerCompression(bool compression)
+{
+  if (compression == m_LayerCompression)
+    return;
+
+  if (compression)
+  {
+    if (this->GetPixelType() != mitk::MakeScalarPixelType<PixelType>())
+      mitkThrow() << "Layer compression requires the label pixel type.";
+
+    m_CompressedLayerContainer.clear();
+    for (auto &layerImage : m_LayerContainer)
+    {
+      mitk::CompressedLabelLayer::Pointer compressedLayer = mitk::CompressedLabelLayer::New();
+      compressedLayer->Compress(layerImage);
+      m_CompressedLayerContainer.push_back(compressedLayer);
+      layerImage = nullptr;
+    }
+  }
+  else
+  {
+    for (unsigned int layer = 0; layer < m_LayerContainer.size(); ++layer)
+    {
+      if (m_LayerContainer[layer].IsNull())
+        m_LayerContainer[layer] = this->DecompressLayer(layer);
+    }
+    m_CompressedLayerContainer.clear();
+  }
+
+  m_LayerCompression = compression;
+}
+
+bool mitk::LabelSetImage::GetLayerCompression() const
+{
+  return m_LayerCompression;
+}
+
+std::size_t mitk::LabelSetImage::GetLayerMemorySize() const
+{
+  std::size_t memorySize = 0;
+
+  for (const auto &layerImage : m_LayerContainer)
+  {
+    if (layerImage.IsNull())
+      continue;
+
+    std::size_t numberOfVoxels = 1;
+    for (unsigned int dim = 0; dim < layerImage->GetDimension(); ++dim)
+      numberOfVoxels *= layerImage->GetDimension(dim);
+    memorySize += numberOfVoxels * layerImage->GetPixelType().GetSize();
+  }
+
+  for (const auto &compressedLayer : m_CompressedLayerContainer)
+    memorySize += compressedLayer->GetMemorySize();
+
+  return memorySize;
+}
+
 unsigned int mitk::LabelSetImage::GetActiveLayer() const
 {
   return m_ActiveLayer;
@@ -200,6 +415,8 @@ void mitk::LabelSetImage::RemoveLayer()
   // remove labelset and image data
   m_LabelSetContainer.erase(m_LabelSetContainer.begin() + layerToDelete);
   m_LayerContainer.erase(m_LayerContainer.begin() + layerToDelete);
+  if (m_LayerCompression)
+    m_CompressedLayerContainer.erase(m_CompressedLayerContainer.begin() + layerToDelete);
 
   if (layerToDelete == 0)
   {
@@ -211,6 +428,14 @@ void mitk::LabelSetImage::RemoveLayer()
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
 {
+  if (m_LayerCompression)
+  {
+    // an empty layer does not need a dense image at all
+    mitk::CompressedLabelLayer::Pointer compressedLayer = mitk::CompressedLabelLayer::New();
+    compressedLayer->InitializeEmpty(this);
+    return this->InternalAddLayer(nullptr, compressedLayer, lset);
+  }
+
   mitk::Image::Pointer newImage = mitk::Image::New();
   newImage->Initialize(this->GetPixelType(),
                        this->GetDimension(),
@@ -233,6 +458,21 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::LabelSet::Pointer lset)
 }
 
 unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk::LabelSet::Pointer lset)
+{
+  mitk::CompressedLabelLayer::Pointer compressedLayer;
+  if (m_LayerCompression)
+  {
+    compressedLayer = mitk::CompressedLabelLayer::New();
+    compressedLayer->Compress(layerImage);
+    layerImage = nullptr;
+  }
+
+  return this->InternalAddLayer(layerImage, compressedLayer, lset);
+}
+
+unsigned int mitk::LabelSetImage::InternalAddLayer(mitk::Image::Pointer layerImage,
+                                                   mitk::CompressedLabelLayer::Pointer compressedLayer,
+                                                   mitk::LabelSet::Pointer lset)
 {
   unsigned int newLabelSetId = m_LayerContainer.size();
 
@@ -255,6 +495,8 @@ unsigned int mitk::LabelSetImage::AddLayer(mitk::Image::Pointer layerImage, mitk
 
   // push a new working image for the new layer
   m_LayerContainer.push_back(layerImage);
+  if (m_LayerCompression)
+    m_CompressedLayerContainer.push_back(compressedLayer);
 
   // push a new labelset for the new layer
   m_LabelSetContainer.push_back(ls);
@@ -299,7 +541,44 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
 {
   try
   {
-    if (4 == this->GetDimension())
+    if (m_LayerCompression)
+    {
+      if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
+      {
+        BeforeChangeLayerEvent.Send();
+
+        if (m_activeLayerInvalid)
+        {
+          // We should not write the invalid layer back to the vector
+          m_activeLayerInvalid = false;
+        }
+        else
+        {
+          // stored layers are replaced instead of modified, they may be shared with clones
+          mitk::CompressedLabelLayer::Pointer compressedLayer = mitk::CompressedLabelLayer::New();
+          compressedLayer->Compress(this);
+          m_CompressedLayerContainer[GetActiveLayer()] = compressedLayer;
+          m_LayerContainer[GetActiveLayer()] = nullptr;
+        }
+        m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
+
+        // a decompressed layer image may have been modified via GetLayerImage(), so it takes precedence
+        if (m_LayerContainer[layer].IsNotNull())
+        {
+          mitk::CompressedLabelLayer::Pointer compressedLayer = mitk::CompressedLabelLayer::New();
+          compressedLayer->Compress(m_LayerContainer[layer]);
+          m_CompressedLayerContainer[layer] = compressedLayer;
+          m_LayerContainer[layer] = nullptr;
+        }
+        m_CompressedLayerContainer[layer]->Decompress(this);
+
+        // the content of the image has been replaced by another layer
+        this->InvalidateLabelIndex();
+
+        AfterChangeLayerEvent.Send();
+      }
+    }
+    else if (4 == this->GetDimension())
     {
       if ((layer != GetActiveLayer() || m_activeLayerInvalid) && (layer < this->GetNumberOfLayers()))
       {
@@ -317,6 +596,9 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
         m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
         AccessFixedDimensionByItk_n(this, LayerContainerToImageProcessing, 4, (GetActiveLayer()));
 
+        // the content of the image has been replaced by another layer
+        this->InvalidateLabelIndex();
+
         AfterChangeLayerEvent.Send();
       }
     }
@@ -338,6 +620,9 @@ void mitk::LabelSetImage::SetActiveLayer(unsigned int layer)
         m_ActiveLayer = layer; // only at this place m_ActiveLayer should be manipulated!!! Use Getter and Setter
         AccessByItk_1(this, LayerContainerToImageProcessing, GetActiveLayer());
 
+        // the content of the image has been replaced by another layer
+        this->InvalidateLabelIndex();
+
         AfterChangeLayerEvent.Send();
       }
     }
@@ -379,6 +664,7 @@ void mitk::LabelSetImage::Concatenate(mitk::LabelSetImage *other)
   {
     mitkThrow() << e.GetDescription();
   }
+  this->InvalidateLabelIndex();
   this->Modified();
 }
 
@@ -387,6 +673,7 @@ void mitk::LabelSetImage::ClearBuffer()
   try
   {
     AccessByItk(this, ClearBufferProcessing);
+    this->InvalidateLabelIndex();
     this->Modified();
   }
   catch (itk::ExceptionObject &e)
@@ -416,9 +703,12 @@ bool mitk::LabelSetImage::ExistLabelSet(unsigned int layer) const
 
 void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixelValue, unsigned int layer)
 {
+  bool indexUpdated = false;
   try
   {
-    AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
+    indexUpdated = this->ReplaceLabelUsingIndex(sourcePixelValue, pixelValue);
+    if (!indexUpdated)
+      AccessByItk_2(this, MergeLabelProcessing, pixelValue, sourcePixelValue);
   }
   catch (itk::ExceptionObject &e)
   {
@@ -426,15 +716,22 @@ void mitk::LabelSetImage::MergeLabel(PixelType pixelValue, PixelType sourcePixel
   }
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
   Modified();
+  if (indexUpdated)
+    m_LabelIndexTime = this->GetMTime();
 }
 
 void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, std::vector<PixelType>& vectorOfSourcePixelValues, unsigned int layer)
 {
+  bool indexUpdated = true;
   try
   {
     for (unsigned int idx = 0; idx < vectorOfSourcePixelValues.size(); idx++)
     {
-      AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
+      if (!this->ReplaceLabelUsingIndex(vectorOfSourcePixelValues[idx], pixelValue))
+      {
+        indexUpdated = false;
+        AccessByItk_2(this, MergeLabelProcessing, pixelValue, vectorOfSourcePixelValues[idx]);
+      }
     }
   }
   catch (itk::ExceptionObject &e)
@@ -443,6 +740,8 @@ void mitk::LabelSetImage::MergeLabels(PixelType pixelValue, std::vector<PixelTyp
   }
   GetLabelSet(layer)->SetActiveLabel(pixelValue);
   Modified();
+  if (indexUpdated)
+    m_LabelIndexTime = this->GetMTime();
 }
 
 void mitk::LabelSetImage::RemoveLabels(std::vector<PixelType> &VectorOfLabelPixelValues, unsigned int layer)
@@ -464,15 +763,186 @@ void mitk::LabelSetImage::EraseLabels(std::vector<PixelType> &VectorOfLabelPixel
 
 void mitk::LabelSetImage::EraseLabel(PixelType pixelValue, unsigned int layer)
 {
+  bool indexUpdated = false;
   try
   {
-    AccessByItk_2(this, EraseLabelProcessing, pixelValue, layer);
+    indexUpdated = this->ReplaceLabelUsingIndex(pixelValue, 0);
+    if (!indexUpdated)
+      AccessByItk_2(this, EraseLabelProcessing, pixelValue, layer);
   }
   catch (itk::ExceptionObject &e)
   {
     mitkThrow() << e.GetDescription();
   }
   Modified();
+  if (indexUpdated)
+    m_LabelIndexTime = this->GetMTime();
+}
+
+bool mitk::LabelSetImage::UpdateLabelIndex()
+{
+  if (3 != this->GetDimension() || this->GetPixelType() != mitk::MakeScalarPixelType<PixelType>())
+    return false;
+
+  if (m_LabelIndexValid && m_LabelIndexTime == this->GetMTime())
+    return true;
+
+  m_LabelIndex.clear();
+  m_LabelIndexUpdatePending = false;
+  this->AddLabelRunsToIndex(this->GetLargestPossibleRegion(), true);
+
+  m_LabelIndexTime = this->GetMTime();
+  m_LabelIndexValid = true;
+  return true;
+}
+
+void mitk::LabelSetImage::AddLabelRunsToIndex(const itk::ImageRegion<3> &region, bool add)
+{
+  const unsigned int *dimensions = this->GetDimensions();
+  mitk::ImagePixelReadAccessor<PixelType, 3> accessor(this);
+  const PixelType *data = accessor.GetData();
+
+  const auto begin = region.GetIndex();
+  const auto end = region.GetUpperIndex();
+
+  // visit the region row by row and add (or remove) runs of equal labels at once
+  itk::Index<3> start;
+  for (start[2] = begin[2]; start[2] <= end[2]; ++start[2])
+  {
+    for (start[1] = begin[1]; start[1] <= end[1]; ++start[1])
+    {
+      const PixelType *row = data + (static_cast<std::size_t>(start[2]) * dimensions[1] + start[1]) * dimensions[0];
+      itk::IndexValueType x = begin[0];
+      while (x <= end[0])
+      {
+        const PixelType value = row[x];
+        itk::IndexValueType runEnd = x + 1;
+        while (runEnd <= end[0] && row[runEnd] == value)
+          ++runEnd;
+
+        start[0] = x;
+        if (add)
+        {
+          m_LabelIndex[value].AddRun(start, runEnd - x);
+        }
+        else
+        {
+          auto iter = m_LabelIndex.find(value);
+          if (iter != m_LabelIndex.end())
+          {
+            iter->second.RemoveRun(start, runEnd - x);
+            if (0 == iter->second.NumberOfVoxels)
+              m_LabelIndex.erase(iter);
+          }
+        }
+        x = runEnd;
+      }
+    }
+  }
+}
+
+void mitk::LabelSetImage::BeginLabelIndexUpdate(const itk::ImageRegion<3> &region)
+{
+  m_LabelIndexUpdatePending = false;
+
+  // only an index matching the image before the write can be updated
+  if (3 != this->GetDimension() || !m_LabelIndexValid || m_LabelIndexTime != this->GetMTime())
+    return;
+
+  m_LabelIndexUpdateRegion = region;
+  if (!m_LabelIndexUpdateRegion.Crop(this->GetLargestPossibleRegion()))
+    return;
+
+  this->AddLabelRunsToIndex(m_LabelIndexUpdateRegion, false);
+  m_LabelIndexUpdatePending = true;
+}
+
+void mitk::LabelSetImage::BeginLabelIndexUpdate(const PlaneGeometry *plane)
+{
+  if (nullptr == plane || 3 != this->GetDimension())
+  {
+    this->InvalidateLabelIndex();
+    return;
+  }
+
+  // the voxels touched by a (possibly oblique) slice lie within the index bounding box of the corners of the plane
+  const BaseGeometry *geometry = this->GetGeometry();
+  itk::Index<3> minIndex, maxIndex;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    mitk::Point3D index;
+    geometry->WorldToIndex(plane->GetCornerPoint(corner), index);
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      const auto lower = static_cast<itk::IndexValueType>(std::floor(index[dim])) - 1;
+      const auto upper = static_cast<itk::IndexValueType>(std::ceil(index[dim])) + 1;
+      minIndex[dim] = 0 == corner ? lower : std::min(minIndex[dim], lower);
+      maxIndex[dim] = 0 == corner ? upper : std::max(maxIndex[dim], upper);
+    }
+  }
+
+  itk::ImageRegion<3> region;
+  region.SetIndex(minIndex);
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    region.SetSize(dim, maxIndex[dim] - minIndex[dim] + 1);
+
+  this->BeginLabelIndexUpdate(region);
+}
+
+void mitk::LabelSetImage::EndLabelIndexUpdate()
+{
+  if (!m_LabelIndexUpdatePending)
+  {
+    // the index has not been updated with the voxels before the write, it has to be rebuilt on its next use
+    this->InvalidateLabelIndex();
+    return;
+  }
+
+  this->AddLabelRunsToIndex(m_LabelIndexUpdateRegion, true);
+  m_LabelIndexUpdatePending = false;
+  m_LabelIndexTime = this->GetMTime();
+}
+
+void mitk::LabelSetImage::InvalidateLabelIndex()
+{
+  m_LabelIndexValid = false;
+  m_LabelIndexUpdatePending = false;
+  m_LabelIndex.clear();
+}
+
+bool mitk::LabelSetImage::ReplaceLabelUsingIndex(PixelType oldValue, PixelType newValue)
+{
+  if (!this->UpdateLabelIndex())
+    return false;
+
+  auto iter = m_LabelIndex.find(oldValue);
+  if (iter == m_LabelIndex.end() || oldValue == newValue)
+    return true;
+
+  const LabelIndexEntry entry = iter->second;
+  {
+    mitk::ImagePixelWriteAccessor<PixelType, 3> accessor(this);
+    ProcessLabelRegion(accessor.GetData(),
+                       this->GetDimensions(),
+                       entry.GetBoundingRegion(),
+                       [oldValue, newValue](PixelType &value, itk::IndexValueType, itk::IndexValueType, itk::IndexValueType) {
+                         if (value == oldValue)
+                           value = newValue;
+                       });
+  }
+
+  m_LabelIndex.erase(iter);
+  m_LabelIndex[newValue].Merge(entry);
+  return true;
+}
+
+const mitk::LabelSetImage::LabelIndexEntry *mitk::LabelSetImage::GetLabelIndexEntry(PixelType pixelValue)
+{
+  if (!this->UpdateLabelIndex())
+    mitkThrow() << "A label index is only available for 3D label set images.";
+
+  auto iter = m_LabelIndex.find(pixelValue);
+  return iter != m_LabelIndex.end() ? &(iter->second) : nullptr;
 }
 
 mitk::Label *mitk::LabelSetImage::GetActiveLabel(unsigned int layer)
@@ -517,6 +987,40 @@ mitk::LabelSet *mitk::LabelSetImage::GetActiveLabelSet()
 
 void mitk::LabelSetImage::UpdateCenterOfMass(PixelType pixelValue, unsigned int layer)
 {
+  if (this->UpdateLabelIndex())
+  {
+    // as the full scan in CalculateCenterOfMassProcessing, retrieve the voxel in the middle, but only within the
+    // bounding region of the label
+    mitk::Point3D pos;
+    pos.Fill(0.0);
+
+    auto iter = m_LabelIndex.find(pixelValue);
+    if (iter != m_LabelIndex.end())
+    {
+      const std::size_t centerVoxel = iter->second.NumberOfVoxels / 2;
+      std::size_t voxelCount = 0;
+
+      mitk::ImagePixelReadAccessor<PixelType, 3> accessor(this);
+      ProcessLabelRegion(accessor.GetData(), this->GetDimensions(), iter->second.GetBoundingRegion(),
+        [&](const PixelType &value, itk::IndexValueType x, itk::IndexValueType y, itk::IndexValueType z) {
+          if (value == pixelValue && voxelCount++ == centerVoxel)
+          {
+            pos[0] = x;
+            pos[1] = y;
+            pos[2] = z;
+          }
+        });
+    }
+
+    GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassIndex(pos);
+    this->GetSlicedGeometry()->IndexToWorld(pos, pos); // TODO: TimeGeometry?
+    GetLabelSet(layer)->GetLabel(pixelValue)->SetCenterOfMassCoordinates(pos);
+
+    // the image data is unchanged
+    m_LabelIndexTime = this->GetMTime();
+    return;
+  }
+
   if (4 == this->GetDimension())
   {
     AccessFixedDimensionByItk_2(this, CalculateCenterOfMassProcessing, 4, pixelValue, layer);
@@ -593,6 +1097,12 @@ mitk::Image::Pointer mitk::LabelSetImage::CreateLabelMask(PixelType index, bool
     {
       ::CreateLabelMaskProcessing<4>(this, mask, index);
     }
+    else if (this->UpdateLabelIndex())
+    {
+      auto iter = m_LabelIndex.find(index);
+      if (iter != m_LabelIndex.end())
+        ::CreateLabelMaskInRegionProcessing(this, mask, index, iter->second.GetBoundingRegion());
+    }
     else if (3 == this->GetDimension())
     {
       ::CreateLabelMaskProcessing(this, mask, index);
@@ -655,6 +1165,7 @@ void mitk::LabelSetImage::InitializeByLabeledImage(mitk::Image::Pointer image)
   {
     mitkThrow() << "Could not intialize by provided labeled image.";
   }
+  this->InvalidateLabelIndex();
   this->Modified();
 }
 
@@ -737,6 +1248,7 @@ void mitk::LabelSetImage::MaskStampProcessing(ImageType *itkImage, mitk::Image *
     ++targetIter;
   }
 
+  this->InvalidateLabelIndex();
   this->Modified();
 }
 
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef __mitkLabelSetImage_H_
 #define __mitkLabelSetImage_H_
 
+#include <mitkCompressedLabelLayer.h>
 #include <mitkImage.h>
 #include <mitkLabelSet.h>
 
@@ -24,6 +25,11 @@ namespace mitk
   //## @brief LabelSetImage class for handling labels and layers in a segmentation session.
   //##
   //## Handles operations for adding, removing, erasing and editing labels and layers.
+  //##
+  //## The image data of the active layer is held by the LabelSetImage itself, all other layers are stored in a
+  //## layer container. By default these are dense copies of the image. With SetLayerCompression(true) they are kept
+  //## run-length encoded (see mitk::CompressedLabelLayer) instead and are only decompressed on demand, i.e. when a
+  //## layer becomes the active one or its image is requested via GetLayerImage().
   //## @ingroup Data
 
   class MITKMULTILABEL_EXPORT LabelSetImage : public Image
@@ -34,6 +40,27 @@ namespace mitk
 
       typedef mitk::Label::PixelType PixelType;
 
+    /**
+    * \brief Extent of a label within the active layer as kept by the label index.
+    * Indices are voxel indices of the (3D) image.
+    */
+    struct MITKMULTILABEL_EXPORT LabelIndexEntry
+    {
+      itk::Index<3> MinIndex;
+      itk::Index<3> MaxIndex;
+      std::size_t NumberOfVoxels = 0;
+      itk::Vector<double, 3> IndexSum = itk::Vector<double, 3>(0.0);
+
+      /** \brief Adds @a length voxels starting at @a start in x direction. */
+      void AddRun(const itk::Index<3> &start, std::size_t length);
+      /** \brief Removes @a length voxels starting at @a start in x direction; the bounding region is not shrunk. */
+      void RemoveRun(const itk::Index<3> &start, std::size_t length);
+      void Merge(const LabelIndexEntry &other);
+
+      itk::ImageRegion<3> GetBoundingRegion() const;
+      mitk::Point3D GetCentroidIndex() const;
+    };
+
     /**
     * \brief BeforeChangeLayerEvent (e.g. used for GUI integration)
     * As soon as active labelset should be changed, the signal emits.
@@ -247,6 +274,60 @@ namespace mitk
 
     const mitk::Image *GetLayerImage(unsigned int layer) const;
 
+    /**
+     * @brief Switches between dense and run-length encoded storage of the layers (default: dense).
+     * @throw mitk::Exception if the pixel type of the image is not mitk::Label::PixelType.
+     */
+    void SetLayerCompression(bool compression);
+
+    bool GetLayerCompression() const;
+
+    /**
+     * @brief Returns the number of bytes occupied by the layer container, i.e. by all layers
+     *        beside the image data of the LabelSetImage itself.
+     */
+    std::size_t GetLayerMemorySize() const;
+
+    /**
+     * @brief Returns the bounding region, voxel count and centroid of a label in the active layer.
+     *
+     * The label index is built with a single pass over the image if the image has been modified since it was built
+     * last. EraseLabel(), MergeLabel(), UpdateCenterOfMass() and CreateLabelMask() keep the index up to date and only
+     * visit the bounding region of the affected labels. Writes announced by BeginLabelIndexUpdate() and
+     * EndLabelIndexUpdate() only update the written region. After such updates the bounding region may be larger than
+     * necessary, but it always contains all voxels of the label.
+     * @return the entry of the label or nullptr, if the label does not occur in the active layer
+     * @throw mitk::Exception if the image is not a 3D image.
+     */
+    const LabelIndexEntry *GetLabelIndexEntry(PixelType pixelValue);
+
+    /**
+     * @brief Announces a write into @a region of the active layer, e.g. the write-back of an edited slice.
+     *
+     * The voxels of the region are removed from the label index. After the write (and Modified()),
+     * EndLabelIndexUpdate() adds the new voxels of the region, so that the index does not need a full pass.
+     * If the index is not up to date when the write is announced, it is rebuilt on its next use instead.
+     */
+    void BeginLabelIndexUpdate(const itk::ImageRegion<3> &region);
+
+    /**
+     * @brief Announces the write of a (possibly oblique) slice defined by @a plane into the active layer.
+     * @sa BeginLabelIndexUpdate(const itk::ImageRegion<3> &)
+     */
+    void BeginLabelIndexUpdate(const PlaneGeometry *plane);
+
+    /**
+     * @brief Completes the update of the label index announced by BeginLabelIndexUpdate().
+     * Has to be called after the write and after Modified() of the image.
+     */
+    void EndLabelIndexUpdate();
+
+    /**
+     * @brief Drops the label index, it is rebuilt with a full pass on its next use.
+     * Has to be called after writes to the image that do not modify the image (Modified()).
+     */
+    void InvalidateLabelIndex();
+
     void OnLabelSetModified();
 
     /**
@@ -270,6 +351,28 @@ namespace mitk
     LabelSetImage(const LabelSetImage &other);
     ~LabelSetImage() override;
 
+    unsigned int InternalAddLayer(mitk::Image::Pointer layerImage,
+                                  mitk::CompressedLabelLayer::Pointer compressedLayer,
+                                  mitk::LabelSet::Pointer lset);
+
+    /**
+     * \brief Rebuilds the label index of the active layer if necessary.
+     * \return false if no label index can be kept for this image (not a 3D image of the label pixel type)
+     */
+    bool UpdateLabelIndex();
+
+    /** \brief Adds (or removes) the voxels of @a region to (from) the label index. */
+    void AddLabelRunsToIndex(const itk::ImageRegion<3> &region, bool add);
+
+    /**
+     * \brief Replaces @a oldValue by @a newValue within the bounding region of @a oldValue and updates the index.
+     * \return false if no label index can be kept for this image and nothing has been done
+     */
+    bool ReplaceLabelUsingIndex(PixelType oldValue, PixelType newValue);
+
+    /** \brief Creates a new image with the geometry of this image and the content of the compressed layer. */
+    mitk::Image::Pointer DecompressLayer(unsigned int layer) const;
+
     template <typename ImageType1, typename ImageType2>
     void ChangeLayerProcessing(ImageType1 *source, ImageType2 *target);
 
@@ -304,7 +407,21 @@ namespace mitk
     void InitializeByLabeledImageProcessing(LabelSetImageType *input, ImageType *other);
 
     std::vector<LabelSet::Pointer> m_LabelSetContainer;
-    std::vector<Image::Pointer> m_LayerContainer;
+    /** dense layer images; with layer compression enabled these are only caches of decompressed layers */
+    mutable std::vector<Image::Pointer> m_LayerContainer;
+    /** run-length encoded layers, only used if layer compression is enabled */
+    std::vector<CompressedLabelLayer::Pointer> m_CompressedLayerContainer;
+
+    bool m_LayerCompression;
+
+    /** label index of the active layer, valid if m_LabelIndexValid is set and m_LabelIndexTime equals the
+        modification time of the image */
+    std::map<PixelType, LabelIndexEntry> m_LabelIndex;
+    itk::ModifiedTimeType m_LabelIndexTime;
+    bool m_LabelIndexValid;
+    /** region announced by BeginLabelIndexUpdate(), whose voxels have been removed from the index */
+    itk::ImageRegion<3> m_LabelIndexUpdateRegion;
+    bool m_LabelIndexUpdatePending;
 
     int m_ActiveLayer;
 
@@ -0,0 +1,289 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// std includes
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+
+// CTK includes
+#include "mitkCommandLineParser.h"
+
+// MITK includes
+#include <mitkExceptionMacro.h>
+#include <mitkLogMacros.h>
+#include <mitkLevenbergMarquardtModelFitFunctor.h>
+#include <mitkExtendedToftsModel.h>
+#include <mitkStandardToftsModel.h>
+#include <mitkTwoCompartmentExchangeModel.h>
+#include <mitkOneTissueCompartmentModel.h>
+
+const std::string MODEL_NAME_standardtofts = "standardtofts";
+const std::string MODEL_NAME_tofts = "tofts";
+const std::string MODEL_NAME_2CX = "2CX";
+const std::string MODEL_NAME_1TC = "1TC";
+
+std::string modelName;
+int voxelCount(0);
+int timeSteps(0);
+float noiseLevel(0);
+bool verbose(false);
+
+void setupParser(mitkCommandLineParser& parser)
+{
+    parser.setCategory("Dynamic Data Analysis Tools");
+    parser.setTitle("Perfusion Fit Benchmark");
+    parser.setDescription("MiniApp that fits a synthetic DCE phantom (random model parameters, population AIF and gaussian noise) with the Levenberg-Marquardt fit functor and reports the throughput in voxels per second, once with the analytic Jacobian of the model and once with numerical derivatives.");
+    parser.setContributor("DKFZ MIC");
+
+    parser.setArgumentPrefix("--", "-");
+    parser.beginGroup("Phantom parameters");
+    parser.addArgument(
+        "model", "l", mitkCommandLineParser::String, "Model function", "Model that should be used to generate and fit the phantom. Options are: \""+MODEL_NAME_standardtofts+"\" (standard tofts model), \""+MODEL_NAME_tofts+"\" (extended tofts model), \""+MODEL_NAME_2CX+"\" (two compartment exchange model) or \""+MODEL_NAME_1TC+"\" (one tissue compartment model).", us::Any(std::string(MODEL_NAME_tofts)));
+    parser.addArgument(
+        "voxels", "n", mitkCommandLineParser::Int, "Number of voxels", "Number of synthetic voxel curves that should be fitted.", us::Any(10000));
+    parser.addArgument(
+        "timesteps", "t", mitkCommandLineParser::Int, "Number of time steps", "Number of time steps of the synthetic curves (temporal resolution 3.5 s).", us::Any(60));
+    parser.addArgument(
+        "noise", "s", mitkCommandLineParser::Float, "Noise level", "Standard deviation of the gaussian noise added to the curves, relative to the maximum of the AIF.", us::Any(0.01f));
+    parser.endGroup();
+
+    parser.beginGroup("Optional parameters");
+    parser.addArgument(
+        "verbose", "v", mitkCommandLineParser::Bool, "Verbose Output", "Whether to produce verbose output");
+    parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
+    parser.endGroup();
+}
+
+bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
+{
+    modelName = MODEL_NAME_tofts;
+    if (parsedArgs.count("model"))
+    {
+      modelName = us::any_cast<std::string>(parsedArgs["model"]);
+    }
+
+    voxelCount = 10000;
+    if (parsedArgs.count("voxels"))
+    {
+      voxelCount = us::any_cast<int>(parsedArgs["voxels"]);
+    }
+
+    timeSteps = 60;
+    if (parsedArgs.count("timesteps"))
+    {
+      timeSteps = us::any_cast<int>(parsedArgs["timesteps"]);
+    }
+
+    noiseLevel = 0.01f;
+    if (parsedArgs.count("noise"))
+    {
+      noiseLevel = us::any_cast<float>(parsedArgs["noise"]);
+    }
+
+    verbose = false;
+    if (parsedArgs.count("verbose"))
+    {
+        verbose = us::any_cast<bool>(parsedArgs["verbose"]);
+    }
+
+    return voxelCount > 0 && timeSteps > 1;
+}
+
+/** Creates the model and the range of the random parameters of the phantom.*/
+mitk::AIFBasedModelBase::Pointer createModel(mitk::ModelBase::ParametersType& minParameters, mitk::ModelBase::ParametersType& maxParameters)
+{
+  mitk::AIFBasedModelBase::Pointer model;
+
+  if (modelName == MODEL_NAME_standardtofts)
+  {
+    model = mitk::StandardToftsModel::New().GetPointer();
+    minParameters = mitk::ModelBase::ParametersType(2);
+    maxParameters = mitk::ModelBase::ParametersType(2);
+    minParameters[0] = 5.; maxParameters[0] = 50.;
+    minParameters[1] = 0.1; maxParameters[1] = 0.6;
+  }
+  else if (modelName == MODEL_NAME_tofts)
+  {
+    model = mitk::ExtendedToftsModel::New().GetPointer();
+    minParameters = mitk::ModelBase::ParametersType(3);
+    maxParameters = mitk::ModelBase::ParametersType(3);
+    minParameters[0] = 5.; maxParameters[0] = 50.;
+    minParameters[1] = 0.1; maxParameters[1] = 0.6;
+    minParameters[2] = 0.01; maxParameters[2] = 0.1;
+  }
+  else if (modelName == MODEL_NAME_2CX)
+  {
+    model = mitk::TwoCompartmentExchangeModel::New().GetPointer();
+    minParameters = mitk::ModelBase::ParametersType(4);
+    maxParameters = mitk::ModelBase::ParametersType(4);
+    minParameters[0] = 20.; maxParameters[0] = 100.;
+    minParameters[1] = 5.; maxParameters[1] = 30.;
+    minParameters[2] = 0.1; maxParameters[2] = 0.5;
+    minParameters[3] = 0.02; maxParameters[3] = 0.1;
+  }
+  else if (modelName == MODEL_NAME_1TC)
+  {
+    model = mitk::OneTissueCompartmentModel::New().GetPointer();
+    minParameters = mitk::ModelBase::ParametersType(2);
+    maxParameters = mitk::ModelBase::ParametersType(2);
+    minParameters[0] = 0.1; maxParameters[0] = 1.;
+    minParameters[1] = 0.1; maxParameters[1] = 1.;
+  }
+  else
+  {
+    mitkThrow() << "Unknown model: " << modelName;
+  }
+
+  // time grid and population AIF (bi-exponential decay after a linear bolus rise)
+  mitk::ModelBase::TimeGridType timeGrid(timeSteps);
+  mitk::AIFBasedModelBase::AterialInputFunctionType aif(timeSteps);
+  for (int i = 0; i < timeSteps; ++i)
+  {
+    timeGrid[i] = 3.5 * i;
+    const double t = timeGrid[i] - 20.;
+    aif[i] = t <= 0. ? 0. : (t < 10. ? 0.6 * t : 6. * std::exp(-(t - 10.) / 12.) + 1.5 * std::exp(-(t - 10.) / 300.));
+  }
+
+  model->SetTimeGrid(timeGrid);
+  model->SetAterialInputFunctionValues(aif);
+
+  return model;
+}
+
+/** Fits all curves and returns the needed time in seconds. The mean relative parameter error is returned via meanError.*/
+double fitPhantom(const mitk::ModelBase* model, const std::vector<mitk::ModelBase::ModelResultType>& curves,
+  const std::vector<mitk::ModelBase::ParametersType>& truth, const mitk::ModelBase::ParametersType& initialParameters,
+  bool useAnalyticDerivative, double& meanError)
+{
+  mitk::LevenbergMarquardtModelFitFunctor::Pointer fitFunctor = mitk::LevenbergMarquardtModelFitFunctor::New();
+  fitFunctor->SetUseAnalyticDerivative(useAnalyticDerivative);
+
+  meanError = 0.;
+  const auto startTime = std::chrono::steady_clock::now();
+
+  for (std::size_t i = 0; i < curves.size(); ++i)
+  {
+    mitk::ModelFitFunctorBase::InputPixelArrayType value(curves[i].begin(), curves[i].end());
+    auto result = fitFunctor->Compute(value, model, initialParameters);
+
+    for (unsigned int p = 0; p < model->GetNumberOfParameters(); ++p)
+    {
+      meanError += std::abs(result[p] - truth[i][p]) / std::abs(truth[i][p]);
+    }
+  }
+
+  const auto stopTime = std::chrono::steady_clock::now();
+  meanError /= curves.size() * model->GetNumberOfParameters();
+
+  return std::chrono::duration<double>(stopTime - startTime).count();
+}
+
+int main(int argc, char* argv[])
+{
+    mitkCommandLineParser parser;
+    setupParser(parser);
+    const std::map<std::string, us::Any>& parsedArgs = parser.parseArguments(argc, argv);
+
+    // Show a help message
+    if (parsedArgs.count("help") || parsedArgs.count("h"))
+    {
+        std::cout << parser.helpText();
+        return EXIT_SUCCESS;
+    }
+
+    if (!configureApplicationSettings(parsedArgs))
+    {
+        return EXIT_FAILURE;
+    };
+
+    try
+    {
+      mitk::ModelBase::ParametersType minParameters, maxParameters;
+      mitk::AIFBasedModelBase::Pointer model = createModel(minParameters, maxParameters);
+
+      std::mt19937 generator(42);
+      std::normal_distribution<double> noise(0., noiseLevel * 7.5);
+
+      std::vector<mitk::ModelBase::ParametersType> truth;
+      std::vector<mitk::ModelBase::ModelResultType> curves;
+      truth.reserve(voxelCount);
+      curves.reserve(voxelCount);
+
+      for (int i = 0; i < voxelCount; ++i)
+      {
+        mitk::ModelBase::ParametersType parameters(minParameters.GetSize());
+        for (unsigned int p = 0; p < parameters.GetSize(); ++p)
+        {
+          std::uniform_real_distribution<double> range(minParameters[p], maxParameters[p]);
+          parameters[p] = range(generator);
+        }
+
+        mitk::ModelBase::ModelResultType curve = model->GetSignal(parameters);
+        for (auto& value : curve)
+        {
+          value += noise(generator);
+        }
+
+        truth.push_back(parameters);
+        curves.push_back(curve);
+      }
+
+      // start in the middle of the parameter ranges
+      mitk::ModelBase::ParametersType initialParameters(minParameters.GetSize());
+      for (unsigned int p = 0; p < initialParameters.GetSize(); ++p)
+      {
+        initialParameters[p] = 0.5 * (minParameters[p] + maxParameters[p]);
+      }
+
+      std::cout << "Model:      " << model->GetModelDisplayName() << std::endl;
+      std::cout << "Voxels:     " << voxelCount << " (" << timeSteps << " time steps)" << std::endl;
+
+      double analyticError = 0.;
+      const double analyticTime = fitPhantom(model, curves, truth, initialParameters, true, analyticError);
+      double numericError = 0.;
+      const double numericTime = fitPhantom(model, curves, truth, initialParameters, false, numericError);
+
+      std::cout << "Analytic Jacobian:   " << voxelCount / analyticTime << " voxels/s";
+      if (verbose)
+      {
+        std::cout << " (mean relative parameter error: " << analyticError << ")";
+      }
+      std::cout << std::endl;
+
+      std::cout << "Numeric derivatives: " << voxelCount / numericTime << " voxels/s";
+      if (verbose)
+      {
+        std::cout << " (mean relative parameter error: " << numericError << ")";
+      }
+      std::cout << std::endl;
+    }
+    catch (const itk::ExceptionObject& e)
+    {
+        MITK_ERROR << e.what();
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        MITK_ERROR << e.what();
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        MITK_ERROR << "Unexpected error encountered.";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -17,6 +17,10 @@ found in the LICENSE file.
 #include "mitkModelBase.h"
 #include "itkArray2D.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace mitk
 {
 
@@ -27,7 +31,9 @@ namespace mitk
    * It also provides a method for interpolation of the AIF source array to a specified Timegrid that differs from
    * AIFTimeGrid. The AIF must be set with an itk::Array. If no AIFTimeGrid is specified with the Setter, it is assumed
    * that the AIFTimeGrid is the same as the ModelTimegrid (e.g. AIF is derived from data set to be fitted). In this
-   * case, AIFvalues must have the same length as ModelTimeGrid, otherwise an exception is generated*/
+   * case, AIFvalues must have the same length as ModelTimeGrid, otherwise an exception is generated.
+   * The AIF resampled on the model time grid is precomputed once (see GetPrecomputedAterialInputFunction())
+   * and reused by all signal evaluations until the time grid or the AIF changes.*/
   class MITKPHARMACOKINETICS_EXPORT AIFBasedModelBase : public mitk::ModelBase
   {
   public:
@@ -54,8 +60,48 @@ namespace mitk
     itkGetConstReferenceMacro(AterialInputFunctionValues, AterialInputFunctionType);
     itkGetConstReferenceMacro(AterialInputFunctionTimeGrid, TimeGridType);
 
-    itkSetMacro(AterialInputFunctionValues, AterialInputFunctionType);
-    itkSetMacro(AterialInputFunctionTimeGrid, TimeGridType);
+    /** Setters invalidate the precomputed AIF if the value changes.*/
+    void SetAterialInputFunctionValues(const AterialInputFunctionType& values);
+    void SetAterialInputFunctionTimeGrid(const TimeGridType& grid);
+
+    /** Reimplementation that also invalidates the precomputed AIF.*/
+    void SetTimeGrid(const TimeGridType& grid) override;
+
+    /** AIF resampled on a time grid, together with the coefficients of its piecewise linear
+     * interpolation for each interval [t(i), t(i+1)] (length, slope and offset aif(i)-slope*t(i)).
+     * The recursive convolution with exponential residue functions (see mitkConvolutionHelper.h)
+     * only depends on these coefficients and the decay constant, thus they are computed once per
+     * time grid and not for every signal evaluation. Instances are immutable and can be shared
+     * read-only between models and threads.*/
+    struct PrecomputedAterialInputFunction
+    {
+      /** Settings the instance was computed from.*/
+      AterialInputFunctionType sourceValues;
+      TimeGridType sourceTimeGrid;
+
+      TimeGridType timeGrid;
+      AterialInputFunctionType values;
+      std::vector<double> intervalLengths;
+      std::vector<double> slopes;
+      std::vector<double> offsets;
+    };
+
+    typedef std::shared_ptr<const PrecomputedAterialInputFunction> PrecomputedAterialInputFunctionConstPointer;
+
+    /** Resamples aif (defined on aifTimeGrid) to timeGrid and computes the interval coefficients.
+     * If aifTimeGrid is empty, aif is assumed to be already defined on timeGrid.*/
+    static PrecomputedAterialInputFunctionConstPointer PrecomputeAterialInputFunction(const AterialInputFunctionType& aif,
+      const TimeGridType& aifTimeGrid, const TimeGridType& timeGrid);
+
+    /** Returns the AIF precomputed on the time grid of the model. It is generated on the first call
+     * after the time grid or the AIF has been changed. The method is thread safe.*/
+    PrecomputedAterialInputFunctionConstPointer GetPrecomputedAterialInputFunction() const;
+
+    /** Sets an AIF that was precomputed elsewhere (e.g. by a parameterizer that shares one instance with
+     * all models it generates). The instance is only used if it was computed from the current AIF settings and
+     * matches the time grid of the model; otherwise it is ignored and the model computes its own.
+     * @return Indicates if the passed instance is used.*/
+    bool SetPrecomputedAterialInputFunction(PrecomputedAterialInputFunctionConstPointer precomputed);
 
     std::string GetXAxisName() const override;
 
@@ -71,7 +117,8 @@ namespace mitk
 
     /** Returns the Aterial Input function matching currentTimeGrid
      *  The original values are interpolated to the passed TimeGrid
-     * if currentTimeGrid.Size() = 0 , the Original AIF will be returned*/
+     * if currentTimeGrid.Size() = 0 , the Original AIF will be returned.
+     * If currentTimeGrid equals the time grid of the model, the precomputed AIF is returned.*/
     const AterialInputFunctionType GetAterialInputFunction(TimeGridType currentTimeGrid) const;
 
     ParameterNamesType GetStaticParameterNames() const override;
@@ -100,6 +147,11 @@ namespace mitk
     TimeGridType m_AterialInputFunctionTimeGrid;
     AterialInputFunctionType m_AterialInputFunctionValues;
 
+    /** Checks if precomputed matches the current AIF settings and time grid of the model.*/
+    bool IsMatchingPrecomputedAterialInputFunction(const PrecomputedAterialInputFunction& precomputed) const;
+
+    mutable PrecomputedAterialInputFunctionConstPointer m_PrecomputedAterialInputFunction;
+    mutable std::mutex m_PrecomputedAterialInputFunctionMutex;
 
   private:
 
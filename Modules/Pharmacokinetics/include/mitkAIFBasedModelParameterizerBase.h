@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include "mitkAIFParametrizerHelper.h"
 #include "mitkAIFBasedModelBase.h"
 
+#include <mutex>
+
 namespace mitk
 {
   /** Base class for model parameterizers for Models using an Aterial Input Function
@@ -67,6 +69,21 @@ namespace mitk
       return result;
     };
 
+    using Superclass::GenerateParameterizedModel;
+
+    /** Reimplementation that passes the AIF precomputed on the default time grid to the generated model.
+     * It is computed once and shared read-only by all models generated by the parameterizer (e.g. by
+     * all voxels and threads of a pixel based fit), instead of being resampled by every model.*/
+    ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const override
+    {
+      ModelBasePointer newModel = Superclass::GenerateParameterizedModel(currentPosition);
+
+      auto* aifModel = static_cast<ModelType*>(newModel.GetPointer());
+      aifModel->SetPrecomputedAterialInputFunction(this->GetPrecomputedAterialInputFunction());
+
+      return newModel;
+    };
+
 
   protected:
 
@@ -80,8 +97,31 @@ namespace mitk
     mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
     mitk::ModelBase::TimeGridType m_AIFTimeGrid;
 
+    /** Returns the AIF precomputed on the default time grid. It is regenerated if the AIF or the default time grid
+     * has changed since the last call. Returns a null pointer if the AIF settings are not valid.*/
+    mitk::AIFBasedModelBase::PrecomputedAterialInputFunctionConstPointer GetPrecomputedAterialInputFunction() const
+    {
+      const mitk::ModelBase::TimeGridType& aifGrid = this->m_AIFTimeGrid.empty() ? this->m_DefaultTimeGrid : this->m_AIFTimeGrid;
+      if (aifGrid.GetSize() != this->m_AIF.GetSize() || this->m_DefaultTimeGrid.empty())
+      {
+        return nullptr;
+      }
+
+      std::lock_guard<std::mutex> lock(m_PrecomputedAIFMutex);
+
+      if (!m_PrecomputedAIF || m_PrecomputedAIF->timeGrid != this->m_DefaultTimeGrid
+          || m_PrecomputedAIF->sourceTimeGrid != this->m_AIFTimeGrid || m_PrecomputedAIF->sourceValues != this->m_AIF)
+      {
+        m_PrecomputedAIF = mitk::AIFBasedModelBase::PrecomputeAterialInputFunction(this->m_AIF, this->m_AIFTimeGrid, this->m_DefaultTimeGrid);
+      }
+
+      return m_PrecomputedAIF;
+    };
+
 
   private:
+    mutable mitk::AIFBasedModelBase::PrecomputedAterialInputFunctionConstPointer m_PrecomputedAIF;
+    mutable std::mutex m_PrecomputedAIFMutex;
 
     //No copy constructor allowed
     AIFBasedModelParameterizerBase(const Self& source);
@@ -127,6 +127,94 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
       return convolution;
   }
 
+  inline void convoluteAIFWithExponentialAndDerivative(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double lambda,
+                                                       itk::Array<double>& convolution, itk::Array<double>& derivative)
+  {
+      /** @brief Same iterative formula as convoluteAIFWithExponential, but also computes the derivative of the convolution with
+       * respect to lambda (by differentiating every step of the iteration). Used by models that offer an analytic Jacobian.
+       **/
+      convolution.SetSize(timeGrid.GetSize());
+      convolution.fill(0.0);
+      derivative.SetSize(timeGrid.GetSize());
+      derivative.fill(0.0);
+
+      for(unsigned int i = 0; i< (timeGrid.GetSize()-1); ++i)
+      {
+          double dt = timeGrid(i+1) - timeGrid(i);
+          double m = (aif(i+1) - aif(i))/dt;
+          double edt = exp(-lambda *dt);
+          double dedt = -dt * edt;
+
+          double offset = aif(i) - m*timeGrid(i);
+          double slopeTerm = (lambda * timeGrid(i+1) - 1) - edt*(lambda*timeGrid(i) -1);
+          double dSlopeTerm = timeGrid(i+1) - dedt*(lambda*timeGrid(i) -1) - edt*timeGrid(i);
+
+          convolution(i+1) = edt * convolution(i)
+                           + offset/lambda * (1 - edt )
+                           + m/(lambda * lambda) * slopeTerm;
+
+          derivative(i+1) = dedt * convolution(i) + edt * derivative(i)
+                          - offset * (dedt/lambda + (1 - edt)/(lambda * lambda))
+                          + m * (dSlopeTerm/(lambda * lambda) - 2 * slopeTerm/(lambda * lambda * lambda));
+      }
+  }
+
+
+  inline itk::Array<double> convoluteAIFWithExponential(const mitk::AIFBasedModelBase::PrecomputedAterialInputFunction& aif, double lambda)
+  {
+      /** @brief Same iterative formula as convoluteAIFWithExponential, but uses the interval coefficients of an
+       * AIF precomputed on the time grid (see AIFBasedModelBase::GetPrecomputedAterialInputFunction()).
+       **/
+      const mitk::ModelBase::TimeGridType& timeGrid = aif.timeGrid;
+      itk::Array<double> convolution(timeGrid.GetSize());
+      convolution.fill(0.0);
+
+      const double lambda2 = lambda * lambda;
+      for(unsigned int i = 0; i < aif.intervalLengths.size(); ++i)
+      {
+          double edt = exp(-lambda * aif.intervalLengths[i]);
+
+          convolution(i+1) = edt * convolution(i)
+                           + aif.offsets[i]/lambda * (1 - edt)
+                           + aif.slopes[i]/lambda2 * ((lambda * timeGrid(i+1) - 1) - edt*(lambda*timeGrid(i) -1));
+      }
+      return convolution;
+  }
+
+  inline void convoluteAIFWithExponentialAndDerivative(const mitk::AIFBasedModelBase::PrecomputedAterialInputFunction& aif, double lambda,
+                                                       itk::Array<double>& convolution, itk::Array<double>& derivative)
+  {
+      /** @brief Same as convoluteAIFWithExponentialAndDerivative, but uses the interval coefficients of an
+       * AIF precomputed on the time grid (see AIFBasedModelBase::GetPrecomputedAterialInputFunction()).
+       **/
+      const mitk::ModelBase::TimeGridType& timeGrid = aif.timeGrid;
+      convolution.SetSize(timeGrid.GetSize());
+      convolution.fill(0.0);
+      derivative.SetSize(timeGrid.GetSize());
+      derivative.fill(0.0);
+
+      const double lambda2 = lambda * lambda;
+      const double lambda3 = lambda2 * lambda;
+      for(unsigned int i = 0; i < aif.intervalLengths.size(); ++i)
+      {
+          double dt = aif.intervalLengths[i];
+          double m = aif.slopes[i];
+          double offset = aif.offsets[i];
+          double edt = exp(-lambda *dt);
+          double dedt = -dt * edt;
+
+          double slopeTerm = (lambda * timeGrid(i+1) - 1) - edt*(lambda*timeGrid(i) -1);
+          double dSlopeTerm = timeGrid(i+1) - dedt*(lambda*timeGrid(i) -1) - edt*timeGrid(i);
+
+          convolution(i+1) = edt * convolution(i)
+                           + offset/lambda * (1 - edt )
+                           + m/lambda2 * slopeTerm;
+
+          derivative(i+1) = dedt * convolution(i) + edt * derivative(i)
+                          - offset * (dedt/lambda + (1 - edt)/lambda2)
+                          + m * (dSlopeTerm/lambda2 - 2 * slopeTerm/lambda3);
+      }
+  }
 
   inline itk::Array<double> convoluteAIFWithConstant(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double constant)
   {
@@ -91,6 +91,9 @@ namespace mitk
     ParametersSizeType GetNumberOfStaticParameters() const override;
     ParamterUnitMapType GetStaticParameterUnits() const override;
 
+    /** The model has a vectorized implementation for batches of voxels.*/
+    bool HasBatchedModelfunction() const override;
+
   protected:
     DescriptivePharmacokineticBrixModel();
     ~DescriptivePharmacokineticBrixModel() override;
@@ -103,6 +106,8 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const override;
+
     void SetStaticParameter(const ParameterNameType& name,
                                     const StaticParameterValuesType& values) override;
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const
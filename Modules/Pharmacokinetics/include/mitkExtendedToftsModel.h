@@ -71,6 +71,11 @@ namespace mitk
     ParametersSizeType  GetNumberOfDerivedParameters() const override;
     ParamterUnitMapType GetDerivedParameterUnits() const override;
 
+    /** The model computes the derivatives of its signal analytically.*/
+    bool HasAnalyticJacobian() const override;
+
+    /** The model has a vectorized implementation for batches of voxels.*/
+    bool HasBatchedModelfunction() const override;
 
   protected:
     ExtendedToftsModel();
@@ -84,6 +89,11 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                         ModelJacobianType& jacobian) const override;
+
+    void ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const override;
+
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
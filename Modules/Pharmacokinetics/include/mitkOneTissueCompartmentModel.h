@@ -63,6 +63,8 @@ namespace mitk
 
     ParamterUnitMapType GetParameterUnits() const override;
 
+    /** The model computes the derivatives of its signal analytically.*/
+    bool HasAnalyticJacobian() const override;
 
   protected:
     OneTissueCompartmentModel();
@@ -76,6 +78,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                         ModelJacobianType& jacobian) const override;
+
     void PrintSelf(std::ostream& os, ::itk::Indent indent) const override;
 
   private:
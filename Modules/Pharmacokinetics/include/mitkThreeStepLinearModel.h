@@ -90,6 +90,8 @@ namespace mitk
 
     ParamterUnitMapType GetDerivedParameterUnits() const override;
 
+    /** The model has a vectorized implementation for batches of voxels.*/
+    bool HasBatchedModelfunction() const override;
 
   protected:
     ThreeStepLinearModel() {};
@@ -103,6 +105,8 @@ namespace mitk
     itk::LightObject::Pointer InternalClone() const override;
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
+
+    void ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const override;
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
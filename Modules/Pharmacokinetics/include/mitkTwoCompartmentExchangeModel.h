@@ -82,6 +82,8 @@ namespace mitk
 
     ParamterUnitMapType GetParameterUnits() const override;
 
+    /** The model computes the derivatives of its signal analytically.*/
+    bool HasAnalyticJacobian() const override;
 
   protected:
     TwoCompartmentExchangeModel();
@@ -95,6 +97,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctionAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                         ModelJacobianType& jacobian) const override;
+
     void PrintSelf(std::ostream& os, ::itk::Indent indent) const override;
 
   private:
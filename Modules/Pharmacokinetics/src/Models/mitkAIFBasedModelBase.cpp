@@ -74,6 +74,10 @@ mitk::AIFBasedModelBase::GetAterialInputFunction(TimeGridType CurrentTimeGrid) c
   {
     return this->m_AterialInputFunctionValues;
   }
+  else if (CurrentTimeGrid == this->m_TimeGrid)
+  {
+    return GetPrecomputedAterialInputFunction()->values;
+  }
   else
   {
     return mitk::InterpolateSignalToNewTimeGrid(m_AterialInputFunctionValues,
@@ -81,6 +85,99 @@ mitk::AIFBasedModelBase::GetAterialInputFunction(TimeGridType CurrentTimeGrid) c
   }
 }
 
+void mitk::AIFBasedModelBase::SetAterialInputFunctionValues(const AterialInputFunctionType& values)
+{
+  if (this->m_AterialInputFunctionValues != values)
+  {
+    this->m_AterialInputFunctionValues = values;
+    this->m_PrecomputedAterialInputFunction.reset();
+    this->Modified();
+  }
+}
+
+void mitk::AIFBasedModelBase::SetAterialInputFunctionTimeGrid(const TimeGridType& grid)
+{
+  if (this->m_AterialInputFunctionTimeGrid != grid)
+  {
+    this->m_AterialInputFunctionTimeGrid = grid;
+    this->m_PrecomputedAterialInputFunction.reset();
+    this->Modified();
+  }
+}
+
+void mitk::AIFBasedModelBase::SetTimeGrid(const TimeGridType& grid)
+{
+  if (this->m_TimeGrid != grid)
+  {
+    this->m_PrecomputedAterialInputFunction.reset();
+  }
+
+  Superclass::SetTimeGrid(grid);
+}
+
+mitk::AIFBasedModelBase::PrecomputedAterialInputFunctionConstPointer
+mitk::AIFBasedModelBase::PrecomputeAterialInputFunction(const AterialInputFunctionType& aif,
+  const TimeGridType& aifTimeGrid, const TimeGridType& timeGrid)
+{
+  auto precomputed = std::make_shared<PrecomputedAterialInputFunction>();
+  precomputed->sourceValues = aif;
+  precomputed->sourceTimeGrid = aifTimeGrid;
+  precomputed->timeGrid = timeGrid;
+
+  const TimeGridType& inputGrid = aifTimeGrid.empty() ? timeGrid : aifTimeGrid;
+  precomputed->values = mitk::InterpolateSignalToNewTimeGrid(aif, inputGrid, timeGrid);
+
+  const unsigned int numberOfIntervals = timeGrid.GetSize() > 0 ? timeGrid.GetSize() - 1 : 0;
+  precomputed->intervalLengths.resize(numberOfIntervals);
+  precomputed->slopes.resize(numberOfIntervals);
+  precomputed->offsets.resize(numberOfIntervals);
+
+  for (unsigned int i = 0; i < numberOfIntervals; ++i)
+  {
+    const double dt = timeGrid[i + 1] - timeGrid[i];
+    const double m = (precomputed->values[i + 1] - precomputed->values[i]) / dt;
+
+    precomputed->intervalLengths[i] = dt;
+    precomputed->slopes[i] = m;
+    precomputed->offsets[i] = precomputed->values[i] - m * timeGrid[i];
+  }
+
+  return precomputed;
+}
+
+mitk::AIFBasedModelBase::PrecomputedAterialInputFunctionConstPointer
+mitk::AIFBasedModelBase::GetPrecomputedAterialInputFunction() const
+{
+  std::lock_guard<std::mutex> lock(m_PrecomputedAterialInputFunctionMutex);
+
+  if (!m_PrecomputedAterialInputFunction)
+  {
+    m_PrecomputedAterialInputFunction = PrecomputeAterialInputFunction(m_AterialInputFunctionValues,
+      m_AterialInputFunctionTimeGrid, m_TimeGrid);
+  }
+
+  return m_PrecomputedAterialInputFunction;
+}
+
+bool mitk::AIFBasedModelBase::SetPrecomputedAterialInputFunction(PrecomputedAterialInputFunctionConstPointer precomputed)
+{
+  if (!precomputed || !IsMatchingPrecomputedAterialInputFunction(*precomputed))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_PrecomputedAterialInputFunctionMutex);
+  m_PrecomputedAterialInputFunction = precomputed;
+  return true;
+}
+
+bool mitk::AIFBasedModelBase::IsMatchingPrecomputedAterialInputFunction(const PrecomputedAterialInputFunction& precomputed) const
+{
+  return precomputed.timeGrid == m_TimeGrid
+    && precomputed.sourceTimeGrid == m_AterialInputFunctionTimeGrid
+    && precomputed.sourceValues == m_AterialInputFunctionValues;
+}
+
 mitk::AIFBasedModelBase::ParameterNamesType mitk::AIFBasedModelBase::GetStaticParameterNames() const
 {
   ParameterNamesType result;
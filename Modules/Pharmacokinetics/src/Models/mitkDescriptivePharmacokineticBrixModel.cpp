@@ -12,6 +12,8 @@ found in the LICENSE file.
 
 #include "mitkDescriptivePharmacokineticBrixModel.h"
 
+#include <algorithm>
+
 const std::string mitk::DescriptivePharmacokineticBrixModel::MODEL_DISPLAY_NAME =
   "Descriptive Pharmacokinetic Brix Model";
 
@@ -203,6 +205,49 @@ const
 
 }
 
+bool mitk::DescriptivePharmacokineticBrixModel::HasBatchedModelfunction() const
+{
+  return true;
+}
+
+void mitk::DescriptivePharmacokineticBrixModel::ComputeModelfunctionBatch(const ParameterBatchType& parameters,
+    SignalBatchType& signals) const
+{
+  if (m_Tau == 0)
+  {
+    itkExceptionMacro("Injection time is 0! Cannot Calculate Signal");
+  }
+
+  const unsigned int numberOfVoxels = parameters.cols();
+  const double* amplitude = parameters[POSITION_PARAMETER_A];
+  const double* kel = parameters[POSITION_PARAMETER_kel];
+  const double* kep = parameters[POSITION_PARAMETER_kep];
+  const double* tlag = parameters[POSITION_PARAMETER_tlag];
+
+  const double tau = m_Tau;
+  const double s0 = m_S0;
+
+  for (unsigned int j = 0; j < m_TimeGrid.GetSize(); ++j)
+  {
+    const double t = m_TimeGrid[j] / 60.0; //convert from [sec] to [min]
+    double* signal = signals[j];
+
+    for (unsigned int v = 0; v < numberOfVoxels; ++v)
+    {
+      const double tDiff = t - tlag[v];
+      const double tx = std::min(std::max(tDiff, 0.0), tau);
+      const double kDiff = kep[v] - kel[v];
+
+      const double expkel = kep[v] * exp(-kel[v] * tDiff);
+      const double expkeltx = exp(kel[v] * tx);
+      const double expkep = exp(-kep[v] * tDiff);
+      const double expkeptx = exp(kep[v] * tx);
+
+      signal[v] = s0 * (1 + (amplitude[v] / tau) * (((expkel / (kel[v] * kDiff)) * (expkeltx - 1)) - ((expkep / kDiff) * (expkeptx - 1))));
+    }
+  }
+}
+
 void mitk::DescriptivePharmacokineticBrixModel::SetStaticParameter(const ParameterNameType& name,
     const StaticParameterValuesType& values)
 {
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkExtendedToftsModel.h"
 #include "mitkConvolutionHelper.h"
 #include <vnl/algo/vnl_fft_1d.h>
+#include <algorithm>
 #include <fstream>
 
 const std::string mitk::ExtendedToftsModel::MODEL_DISPLAY_NAME = "Extended Tofts Model";
@@ -113,8 +114,8 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
 
 
 
@@ -128,8 +129,7 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
+  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(*precomputedAIF, lambda);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -139,7 +139,7 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
   mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
 
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
+  for (AterialInputFunctionType::const_iterator Cp = aterialInputFunction.begin();
        Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
   {
     *signalPos = (*Cp) * vp + ktrans * (*res);
@@ -150,6 +150,101 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
 }
 
 
+bool mitk::ExtendedToftsModel::HasAnalyticJacobian() const
+{
+  return true;
+}
+
+bool mitk::ExtendedToftsModel::HasBatchedModelfunction() const
+{
+  return true;
+}
+
+void mitk::ExtendedToftsModel::ComputeModelfunctionBatch(const ParameterBatchType& parameters,
+    SignalBatchType& signals) const
+{
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const TimeGridType& timeGrid = precomputedAIF->timeGrid;
+  const AterialInputFunctionType& aif = precomputedAIF->values;
+
+  const unsigned int numberOfVoxels = parameters.cols();
+  const double* ktrans = parameters[POSITION_PARAMETER_Ktrans];
+  const double* ve = parameters[POSITION_PARAMETER_ve];
+  const double* vp = parameters[POSITION_PARAMETER_vp];
+
+  //The tissue term ktrans*(aif*exp(-lambda*t)) obeys the same recursion as the convolution
+  //(see convoluteAIFWithExponential()), thus the signal is computed in place time step by time step.
+  //The plasma term of the previous time step is removed before it is used in the recursion.
+  double* first = signals[0];
+  for (unsigned int v = 0; v < numberOfVoxels; ++v)
+  {
+    first[v] = vp[v] * aif[0];
+  }
+
+  for (unsigned int j = 0; j < precomputedAIF->intervalLengths.size(); ++j)
+  {
+    const double dt = precomputedAIF->intervalLengths[j];
+    const double slope = precomputedAIF->slopes[j];
+    const double offset = precomputedAIF->offsets[j];
+    const double t0 = timeGrid[j];
+    const double t1 = timeGrid[j + 1];
+    const double aif0 = aif[j];
+    const double aif1 = aif[j + 1];
+
+    const double* previous = signals[j];
+    double* current = signals[j + 1];
+
+    for (unsigned int v = 0; v < numberOfVoxels; ++v)
+    {
+      const double k = ktrans[v] / 6000.0;
+      const double lambda = k / ve[v];
+      const double edt = exp(-lambda * dt);
+
+      current[v] = edt * (previous[v] - vp[v] * aif0)
+                   + k * (offset / lambda * (1 - edt) + slope / (lambda * lambda) * ((lambda * t1 - 1) - edt * (lambda * t0 - 1)))
+                   + vp[v] * aif1;
+    }
+  }
+}
+
+void mitk::ExtendedToftsModel::ComputeModelfunctionAndJacobian(const ParametersType& parameters,
+  ModelResultType& signal, ModelJacobianType& jacobian) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+  }
+
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
+
+  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  //Model Parameters
+  double ktrans = parameters[POSITION_PARAMETER_Ktrans] / 6000.0;
+  double     ve = parameters[POSITION_PARAMETER_ve];
+  double     vp = parameters[POSITION_PARAMETER_vp];
+
+  double lambda =  ktrans / ve;
+
+  mitk::ModelBase::ModelResultType convolution;
+  mitk::ModelBase::ModelResultType convolutionDerivative;
+  mitk::convoluteAIFWithExponentialAndDerivative(*precomputedAIF, lambda,
+    convolution, convolutionDerivative);
+
+  signal.SetSize(timeSteps);
+  jacobian.SetSize(NUMBER_OF_PARAMETERS, timeSteps);
+
+  // signal = vp * Cp + ktrans * conv(lambda) with lambda = ktrans/ve
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    signal[i] = aterialInputFunction[i] * vp + ktrans * convolution[i];
+    jacobian[POSITION_PARAMETER_Ktrans][i] = (convolution[i] + lambda * convolutionDerivative[i]) / 6000.0;
+    jacobian[POSITION_PARAMETER_ve][i] = -ktrans * lambda / ve * convolutionDerivative[i];
+    jacobian[POSITION_PARAMETER_vp][i] = aterialInputFunction[i];
+  }
+}
+
 mitk::ModelBase::DerivedParameterMapType mitk::ExtendedToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
 {
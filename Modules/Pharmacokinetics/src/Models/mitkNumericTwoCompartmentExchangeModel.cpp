@@ -171,8 +171,8 @@ const
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
@@ -84,8 +84,8 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
 
 
 
@@ -97,8 +97,7 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
 
 
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, k2);
+  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(*precomputedAIF, k2);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -120,6 +119,45 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
 
 
 
+bool mitk::OneTissueCompartmentModel::HasAnalyticJacobian() const
+{
+  return true;
+}
+
+void mitk::OneTissueCompartmentModel::ComputeModelfunctionAndJacobian(const ParametersType& parameters,
+  ModelResultType& signal, ModelJacobianType& jacobian) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+  }
+
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
+
+  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  //Model Parameters
+  double     K1 = (double) parameters[POSITION_PARAMETER_k1] / 60.0;
+  double     k2 = (double) parameters[POSITION_PARAMETER_k2] / 60.0;
+
+  mitk::ModelBase::ModelResultType convolution;
+  mitk::ModelBase::ModelResultType convolutionDerivative;
+  mitk::convoluteAIFWithExponentialAndDerivative(*precomputedAIF, k2,
+    convolution, convolutionDerivative);
+
+  signal.SetSize(timeSteps);
+  jacobian.SetSize(NUMBER_OF_PARAMETERS, timeSteps);
+
+  // signal = K1 * conv(k2)
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    signal[i] = K1 * convolution[i];
+    jacobian[POSITION_PARAMETER_k1][i] = convolution[i] / 60.0;
+    jacobian[POSITION_PARAMETER_k2][i] = K1 * convolutionDerivative[i] / 60.0;
+  }
+}
+
 itk::LightObject::Pointer mitk::OneTissueCompartmentModel::InternalClone() const
 {
   OneTissueCompartmentModel::Pointer newClone = OneTissueCompartmentModel::New();
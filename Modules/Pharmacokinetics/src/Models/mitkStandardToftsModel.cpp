@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkStandardToftsModel.h"
 #include "mitkConvolutionHelper.h"
 #include <vnl/algo/vnl_fft_1d.h>
+#include <algorithm>
 #include <fstream>
 
 const std::string mitk::StandardToftsModel::MODEL_DISPLAY_NAME = "Standard Tofts Model";
@@ -105,8 +106,8 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
 
 
 
@@ -119,8 +120,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
+  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(*precomputedAIF, lambda);
 
   //Signal that will be returned by ComputeModelFunction
   mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -130,7 +130,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
   mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
 
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
+  for (AterialInputFunctionType::const_iterator Cp = aterialInputFunction.begin();
        Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
   {
     *signalPos = ktrans * (*res);
@@ -141,6 +141,89 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
 }
 
 
+bool mitk::StandardToftsModel::HasAnalyticJacobian() const
+{
+  return true;
+}
+
+bool mitk::StandardToftsModel::HasBatchedModelfunction() const
+{
+  return true;
+}
+
+void mitk::StandardToftsModel::ComputeModelfunctionBatch(const ParameterBatchType& parameters,
+    SignalBatchType& signals) const
+{
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const TimeGridType& timeGrid = precomputedAIF->timeGrid;
+
+  const unsigned int numberOfVoxels = parameters.cols();
+  const double* ktrans = parameters[POSITION_PARAMETER_Ktrans];
+  const double* ve = parameters[POSITION_PARAMETER_ve];
+
+  //The signal ktrans*(aif*exp(-lambda*t)) obeys the same recursion as the convolution
+  //(see convoluteAIFWithExponential()), thus it is computed in place time step by time step.
+  std::fill(signals[0], signals[0] + numberOfVoxels, 0.0);
+
+  for (unsigned int j = 0; j < precomputedAIF->intervalLengths.size(); ++j)
+  {
+    const double dt = precomputedAIF->intervalLengths[j];
+    const double slope = precomputedAIF->slopes[j];
+    const double offset = precomputedAIF->offsets[j];
+    const double t0 = timeGrid[j];
+    const double t1 = timeGrid[j + 1];
+
+    const double* previous = signals[j];
+    double* current = signals[j + 1];
+
+    for (unsigned int v = 0; v < numberOfVoxels; ++v)
+    {
+      const double k = ktrans[v] / 6000.0;
+      const double lambda = k / ve[v];
+      const double edt = exp(-lambda * dt);
+
+      current[v] = edt * previous[v]
+                   + k * (offset / lambda * (1 - edt) + slope / (lambda * lambda) * ((lambda * t1 - 1) - edt * (lambda * t0 - 1)));
+    }
+  }
+}
+
+void mitk::StandardToftsModel::ComputeModelfunctionAndJacobian(const ParametersType& parameters,
+  ModelResultType& signal, ModelJacobianType& jacobian) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
+  {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+  }
+
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
+
+  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  //Model Parameters
+  double ktrans = parameters[POSITION_PARAMETER_Ktrans] / 6000.0;
+  double     ve = parameters[POSITION_PARAMETER_ve];
+
+  double lambda =  ktrans / ve;
+
+  mitk::ModelBase::ModelResultType convolution;
+  mitk::ModelBase::ModelResultType convolutionDerivative;
+  mitk::convoluteAIFWithExponentialAndDerivative(*precomputedAIF, lambda,
+    convolution, convolutionDerivative);
+
+  signal.SetSize(timeSteps);
+  jacobian.SetSize(NUMBER_OF_PARAMETERS, timeSteps);
+
+  // signal = ktrans * conv(lambda) with lambda = ktrans/ve
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    signal[i] = ktrans * convolution[i];
+    jacobian[POSITION_PARAMETER_Ktrans][i] = (convolution[i] + lambda * convolutionDerivative[i]) / 6000.0;
+    jacobian[POSITION_PARAMETER_ve][i] = -ktrans * lambda / ve * convolutionDerivative[i];
+  }
+}
+
 mitk::ModelBase::DerivedParameterMapType mitk::StandardToftsModel::ComputeDerivedParameters(
   const mitk::ModelBase::ParametersType& parameters) const
 {
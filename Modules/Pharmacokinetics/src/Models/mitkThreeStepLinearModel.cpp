@@ -164,6 +164,35 @@ mitk::ThreeStepLinearModel::ComputeModelfunction(const ParametersType& parameter
   return signal;
 };
 
+bool mitk::ThreeStepLinearModel::HasBatchedModelfunction() const
+{
+  return true;
+};
+
+void mitk::ThreeStepLinearModel::ComputeModelfunctionBatch(const ParameterBatchType& parameters, SignalBatchType& signals) const
+{
+  const unsigned int numberOfVoxels = parameters.cols();
+  const double* S0 = parameters[POSITION_PARAMETER_S0];
+  const double* t1 = parameters[POSITION_PARAMETER_t1];
+  const double* t2 = parameters[POSITION_PARAMETER_t2];
+  const double* a1 = parameters[POSITION_PARAMETER_a1];
+  const double* a2 = parameters[POSITION_PARAMETER_a2];
+
+  for (unsigned int j = 0; j < m_TimeGrid.GetSize(); ++j)
+  {
+    const double t = m_TimeGrid[j];
+    double* signal = signals[j];
+
+    for (unsigned int v = 0; v < numberOfVoxels; ++v)
+    {
+      const double b1 = S0[v] - a1[v] * t1[v];
+      const double b2 = (a1[v] * t2[v] + b1) - (a2[v] * t2[v]);
+
+      signal[v] = t < t1[v] ? S0[v] : (t <= t2[v] ? a1[v] * t + b1 : a2[v] * t + b2);
+    }
+  }
+};
+
 mitk::ThreeStepLinearModel::ParameterNamesType mitk::ThreeStepLinearModel::GetStaticParameterNames() const
 {
   ParameterNamesType result;
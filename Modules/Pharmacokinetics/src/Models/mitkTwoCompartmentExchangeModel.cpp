@@ -103,8 +103,8 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
     }
 
-    AterialInputFunctionType aterialInputFunction;
-    aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+    const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+    const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
 
     unsigned int timeSteps = this->m_TimeGrid.GetSize();
     mitk::ModelBase::ModelResultType signal(timeSteps);
@@ -129,8 +129,8 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
 
 
 
-        ConvolutionResultType expp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
-        ConvolutionResultType expm = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Km);
+        ConvolutionResultType expp = mitk::convoluteAIFWithExponential(*precomputedAIF, Kp);
+        ConvolutionResultType expm = mitk::convoluteAIFWithExponential(*precomputedAIF, Km);
 
         //Signal that will be returned by ComputeModelFunction
 
@@ -147,7 +147,7 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
     else
     {
         double Kp = F/vp;
-        ConvolutionResultType exp = mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction,Kp);
+        ConvolutionResultType exp = mitk::convoluteAIFWithExponential(*precomputedAIF, Kp);
         mitk::ModelBase::ModelResultType::const_iterator expPos = exp.begin();
 
         for( mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin(); signalPos!=signal.end(); ++expPos, ++signalPos)
@@ -161,6 +161,104 @@ mitk::TwoCompartmentExchangeModel::ComputeModelfunction(const ParametersType& pa
 }
 
 
+bool mitk::TwoCompartmentExchangeModel::HasAnalyticJacobian() const
+{
+  return true;
+}
+
+void mitk::TwoCompartmentExchangeModel::ComputeModelfunctionAndJacobian(const ParametersType& parameters,
+  ModelResultType& signal, ModelJacobianType& jacobian) const
+{
+    typedef mitk::ModelBase::ModelResultType ConvolutionResultType;
+
+    if (this->m_TimeGrid.GetSize() == 0)
+    {
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
+    }
+
+    const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+    const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
+
+    unsigned int timeSteps = this->m_TimeGrid.GetSize();
+    signal.SetSize(timeSteps);
+    jacobian.SetSize(NUMBER_OF_PARAMETERS, timeSteps);
+
+    //Model Parameters
+    double F = parameters[POSITION_PARAMETER_F] / 6000.0;
+    double PS  = parameters[POSITION_PARAMETER_PS] / 6000.0;
+    double ve = parameters[POSITION_PARAMETER_ve];
+    double vp = parameters[POSITION_PARAMETER_vp];
+
+    if(PS != 0)
+    {
+        // rates of the model: a = 1/Tp, b = 1/Te, c = 1/Tb
+        double a = (PS + F)/vp;
+        double b = PS/ve;
+        double c = F/vp;
+
+        double D = sqrt((a + b)*(a + b) - 4 * b*c);
+        double Kp = 0.5 *( a + b + D );
+        double Km = 0.5 *( a + b - D );
+
+        double E = ( Kp - c )/D;
+
+        ConvolutionResultType expp, exppDerivative;
+        ConvolutionResultType expm, expmDerivative;
+        mitk::convoluteAIFWithExponentialAndDerivative(*precomputedAIF, Kp, expp, exppDerivative);
+        mitk::convoluteAIFWithExponentialAndDerivative(*precomputedAIF, Km, expm, expmDerivative);
+
+        // partial derivatives of a, b, c and F with respect to the (unscaled) parameters F, PS, ve, vp
+        const double da[4] = { 1/(6000.0*vp), 1/(6000.0*vp), 0, -(PS + F)/(vp*vp) };
+        const double db[4] = { 0, 1/(6000.0*ve), -PS/(ve*ve), 0 };
+        const double dc[4] = { 1/(6000.0*vp), 0, 0, -F/(vp*vp) };
+        const double dF[4] = { 1/6000.0, 0, 0, 0 };
+
+        double dKp[4], dKm[4], dE[4];
+        for (unsigned int p = 0; p < NUMBER_OF_PARAMETERS; ++p)
+        {
+            double ds = da[p] + db[p];
+            double dD = ((a + b)*ds - 2 * (db[p]*c + b*dc[p]))/D;
+            dKp[p] = 0.5 * (ds + dD);
+            dKm[p] = 0.5 * (ds - dD);
+            dE[p] = ((dKp[p] - dc[p])*D - (Kp - c)*dD)/(D*D);
+        }
+
+        for (unsigned int i = 0; i < timeSteps; ++i)
+        {
+            double residue = expp[i] + E*(expm[i] - expp[i]);
+            signal[i] = F * residue;
+
+            for (unsigned int p = 0; p < NUMBER_OF_PARAMETERS; ++p)
+            {
+                jacobian[p][i] = dF[p] * residue
+                               + F * ( (1 - E)*exppDerivative[i]*dKp[p] + E*expmDerivative[i]*dKm[p] + dE[p]*(expm[i] - expp[i]) );
+            }
+        }
+    }
+    else
+    {
+        double Kp = F/vp;
+        ConvolutionResultType exp, expDerivative;
+        mitk::convoluteAIFWithExponentialAndDerivative(*precomputedAIF, Kp, exp, expDerivative);
+        // for PS -> 0 the exchange term converges to the integral of the (linearly interpolated) aif (Km -> 0)
+        ConvolutionResultType integral(timeSteps);
+        integral.fill(0.0);
+        for (unsigned int i = 0; i + 1 < timeSteps; ++i)
+        {
+            integral[i + 1] = integral[i] + 0.5 * (aterialInputFunction[i] + aterialInputFunction[i + 1]) * (this->m_TimeGrid[i + 1] - this->m_TimeGrid[i]);
+        }
+
+        for (unsigned int i = 0; i < timeSteps; ++i)
+        {
+            signal[i] = F * exp[i];
+            jacobian[POSITION_PARAMETER_F][i] = (exp[i] + Kp * expDerivative[i]) / 6000.0;
+            jacobian[POSITION_PARAMETER_PS][i] = (Kp * expDerivative[i] + integral[i] - exp[i]) / 6000.0;
+            jacobian[POSITION_PARAMETER_ve][i] = 0.0;
+            jacobian[POSITION_PARAMETER_vp][i] = -F * Kp / vp * expDerivative[i];
+        }
+    }
+}
+
 itk::LightObject::Pointer mitk::TwoCompartmentExchangeModel::InternalClone() const
 {
   TwoCompartmentExchangeModel::Pointer newClone = TwoCompartmentExchangeModel::New();
@@ -92,8 +92,8 @@ mitk::TwoTissueCompartmentFDGModel::ComputeModelfunction(const ParametersType& p
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
 
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
@@ -109,8 +109,7 @@ mitk::TwoTissueCompartmentFDGModel::ComputeModelfunction(const ParametersType& p
 
   double lambda = k2+k3;
   //double lambda2 = -alpha2;
-  mitk::ModelBase::ModelResultType exp = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, lambda);
+  mitk::ModelBase::ModelResultType exp = mitk::convoluteAIFWithExponential(*precomputedAIF, lambda);
   mitk::ModelBase::ModelResultType CA = mitk::convoluteAIFWithConstant(this->m_TimeGrid, aterialInputFunction, k3);
 
 
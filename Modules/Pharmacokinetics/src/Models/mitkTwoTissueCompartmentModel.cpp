@@ -103,8 +103,8 @@ mitk::TwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& para
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const PrecomputedAterialInputFunctionConstPointer precomputedAIF = GetPrecomputedAterialInputFunction();
+  const AterialInputFunctionType& aterialInputFunction = precomputedAIF->values;
 
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
@@ -123,10 +123,8 @@ mitk::TwoTissueCompartmentModel::ComputeModelfunction(const ParametersType& para
 
   //double lambda1 = -alpha1;
   //double lambda2 = -alpha2;
-  mitk::ModelBase::ModelResultType exp1 = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, alpha1);
-  mitk::ModelBase::ModelResultType exp2 = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-                                          aterialInputFunction, alpha2);
+  mitk::ModelBase::ModelResultType exp1 = mitk::convoluteAIFWithExponential(*precomputedAIF, alpha1);
+  mitk::ModelBase::ModelResultType exp2 = mitk::convoluteAIFWithExponential(*precomputedAIF, alpha2);
 
 
   //Signal that will be returned by ComputeModelFunction
@@ -1,4 +1,7 @@
 SET(MODULE_TESTS
   mitkDescriptivePharmacokineticBrixModelTest.cpp
+  mitkPharmacokineticModelJacobianTest.cpp
+  mitkPrecomputedAterialInputFunctionTest.cpp
+  mitkPharmacokineticModelBatchTest.cpp
   #ConvertToConcentrationTest.cpp
 )
@@ -0,0 +1,248 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkDescriptivePharmacokineticBrixModel.h>
+#include <mitkDescriptivePharmacokineticBrixModelParameterizer.h>
+#include <mitkExtendedToftsModel.h>
+#include <mitkITKImageImport.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkModelSignalImageGenerator.h>
+#include <mitkOneTissueCompartmentModel.h>
+#include <mitkStandardToftsModel.h>
+#include <mitkT2DecayModel.h>
+#include <mitkThreeStepLinearModel.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class mitkPharmacokineticModelBatchTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPharmacokineticModelBatchTestSuite);
+  MITK_TEST(StandardToftsBatch);
+  MITK_TEST(ExtendedToftsBatch);
+  MITK_TEST(BrixBatch);
+  MITK_TEST(ThreeStepLinearBatch);
+  MITK_TEST(T2DecayBatch);
+  MITK_TEST(DefaultBatch);
+  MITK_TEST(ReuseOfSignalBuffer);
+  MITK_TEST(SignalImageWithLocalStaticParameters);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ModelBase::TimeGridType m_TimeGrid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
+
+  typedef std::vector<mitk::ModelBase::ParametersType> ParameterListType;
+
+  mitk::ModelBase::ParametersType MakeParameters(std::initializer_list<double> values)
+  {
+    mitk::ModelBase::ParametersType parameters(values.size());
+    std::copy(values.begin(), values.end(), parameters.begin());
+    return parameters;
+  }
+
+  /** Checks that the batched signals equal the signals of GetSignal() for every voxel.*/
+  void CheckBatch(const mitk::ModelBase *model, const ParameterListType &voxels, bool expectBatched = true)
+  {
+    CPPUNIT_ASSERT_EQUAL(expectBatched, model->HasBatchedModelfunction());
+
+    mitk::ModelBase::ParameterBatchType parameters(model->GetNumberOfParameters(), voxels.size());
+    for (unsigned int v = 0; v < voxels.size(); ++v)
+    {
+      for (unsigned int i = 0; i < parameters.rows(); ++i)
+      {
+        parameters[i][v] = voxels[v][i];
+      }
+    }
+
+    mitk::ModelBase::SignalBatchType signals;
+    model->GetSignalBatch(parameters, signals);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(model->GetTimeGrid().GetSize()), signals.rows());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(voxels.size()), signals.cols());
+
+    for (unsigned int v = 0; v < voxels.size(); ++v)
+    {
+      const mitk::ModelBase::ModelResultType reference = model->GetSignal(voxels[v]);
+      for (unsigned int j = 0; j < reference.GetSize(); ++j)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(reference[j], signals[j][v], 1e-10 * (1. + std::abs(reference[j])));
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_TimeGrid.SetSize(40);
+    m_AIF.SetSize(40);
+
+    for (unsigned int i = 0; i < m_TimeGrid.GetSize(); ++i)
+    {
+      m_TimeGrid[i] = 3.5 * i;
+      m_AIF[i] = 5. * m_TimeGrid[i] * std::exp(-m_TimeGrid[i] / 20.);
+    }
+  }
+
+  void tearDown() override {}
+
+  void StandardToftsBatch()
+  {
+    mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+
+    CheckBatch(model, { MakeParameters({ 35., 0.4 }), MakeParameters({ 5., 0.1 }), MakeParameters({ 60., 0.7 }) });
+  }
+
+  void ExtendedToftsBatch()
+  {
+    mitk::ExtendedToftsModel::Pointer model = mitk::ExtendedToftsModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+
+    CheckBatch(model, { MakeParameters({ 35., 0.4, 0.05 }), MakeParameters({ 5., 0.1, 0.2 }), MakeParameters({ 60., 0.7, 0. }) });
+  }
+
+  void BrixBatch()
+  {
+    mitk::DescriptivePharmacokineticBrixModel::Pointer model = mitk::DescriptivePharmacokineticBrixModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetTau(0.5);
+    model->SetS0(100.);
+
+    // parameter order: A, kep, kel, tlag
+    CheckBatch(model, { MakeParameters({ 1., 3., 0.2, 0.5 }), MakeParameters({ 2., 1.5, 0.1, 0. }), MakeParameters({ 0.5, 4., 0.5, 1.2 }) });
+  }
+
+  void ThreeStepLinearBatch()
+  {
+    mitk::ThreeStepLinearModel::Pointer model = mitk::ThreeStepLinearModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+
+    // parameter order: S0, t1, t2, a1, a2
+    CheckBatch(model, { MakeParameters({ 10., 20., 60., 1.5, -0.2 }), MakeParameters({ 5., 3.5, 7., 2., 0. }), MakeParameters({ 0., 200., 300., 1., 1. }) });
+  }
+
+  void T2DecayBatch()
+  {
+    mitk::T2DecayModel::Pointer model = mitk::T2DecayModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+
+    CheckBatch(model, { MakeParameters({ 100., 30. }), MakeParameters({ 50., 80. }) });
+  }
+
+  void DefaultBatch()
+  {
+    // models without a dedicated implementation are evaluated voxel by voxel
+    mitk::OneTissueCompartmentModel::Pointer model = mitk::OneTissueCompartmentModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+
+    CheckBatch(model, { MakeParameters({ 0.5, 0.3 }), MakeParameters({ 0.1, 0.9 }) }, false);
+  }
+
+  void ReuseOfSignalBuffer()
+  {
+    mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+
+    mitk::ModelBase::ParameterBatchType parameters(2, 8);
+    parameters.fill(0.5);
+
+    mitk::ModelBase::SignalBatchType signals;
+    model->GetSignalBatch(parameters, signals);
+    const double *buffer = signals.data_block();
+
+    parameters.fill(0.3);
+    model->GetSignalBatch(parameters, signals);
+
+    CPPUNIT_ASSERT_MESSAGE("Check that the signal buffer is reused for batches of the same size.", buffer == signals.data_block());
+
+    mitk::ModelBase::ParameterBatchType wrongParameters(3, 8);
+    wrongParameters.fill(0.5);
+    CPPUNIT_ASSERT_THROW(model->GetSignalBatch(wrongParameters, signals), itk::ExceptionObject);
+  }
+
+  void SignalImageWithLocalStaticParameters()
+  {
+    typedef itk::Image<double, 3> ImageType;
+    ImageType::RegionType region;
+    region.SetSize(0, 4);
+    region.SetSize(1, 3);
+    region.SetSize(2, 2);
+
+    // the Brix parameterizer takes S0 from the base image, which differs for every voxel
+    ImageType::Pointer baseImage = ImageType::New();
+    baseImage->SetRegions(region);
+    baseImage->Allocate();
+    itk::ImageRegionIteratorWithIndex<ImageType> baseIter(baseImage, region);
+    for (double s0 = 50.; !baseIter.IsAtEnd(); ++baseIter, s0 += 10.)
+    {
+      baseIter.Set(s0);
+    }
+
+    mitk::DescriptivePharmacokineticBrixModelParameterizer::Pointer parameterizer =
+      mitk::DescriptivePharmacokineticBrixModelParameterizer::New();
+    parameterizer->SetBaseImage(baseImage);
+    parameterizer->SetTau(0.5);
+    parameterizer->SetDefaultTimeGrid(m_TimeGrid);
+
+    // parameter order: A, kep, kel, tlag
+    const mitk::ModelBase::ParametersType parameters = MakeParameters({ 1., 3., 0.2, 0.5 });
+
+    mitk::ModelSignalImageGenerator::Pointer generator = mitk::ModelSignalImageGenerator::New();
+    generator->SetParameterizer(parameterizer);
+    for (unsigned int i = 0; i < parameters.GetSize(); ++i)
+    {
+      ImageType::Pointer parameterImage = ImageType::New();
+      parameterImage->SetRegions(region);
+      parameterImage->Allocate();
+      parameterImage->FillBuffer(parameters[i]);
+      generator->SetParameterInputImage(i, mitk::ImportItkImage(parameterImage)->Clone());
+    }
+
+    mitk::Image::Pointer signalImage = generator->GetGeneratedImage();
+    mitk::ImagePixelReadAccessor<double, 4> accessor(signalImage);
+
+    for (baseIter.GoToBegin(); !baseIter.IsAtEnd(); ++baseIter)
+    {
+      const mitk::ModelBase::ModelResultType reference =
+        parameterizer->GenerateParameterizedModel(baseIter.GetIndex())->GetSignal(parameters);
+
+      itk::Index<4> index;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        index[i] = baseIter.GetIndex()[i];
+      }
+      for (unsigned int j = 0; j < reference.GetSize(); ++j)
+      {
+        index[3] = j;
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(reference[j], accessor.GetPixelByIndex(index), 1e-10 * (1. + std::abs(reference[j])));
+      }
+    }
+
+    itk::Index<4> firstVoxel = { { 0, 0, 0, 39 } };
+    itk::Index<4> lastVoxel = { { 3, 2, 1, 39 } };
+    CPPUNIT_ASSERT_MESSAGE("Check that the signals depend on the S0 of the voxels.",
+                           accessor.GetPixelByIndex(firstVoxel) != accessor.GetPixelByIndex(lastVoxel));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPharmacokineticModelBatch)
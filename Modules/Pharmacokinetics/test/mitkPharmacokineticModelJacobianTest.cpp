@@ -0,0 +1,225 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkExtendedToftsModel.h>
+#include <mitkOneTissueCompartmentModel.h>
+#include <mitkSquaredDifferencesFitCostFunction.h>
+#include <mitkStandardToftsModel.h>
+#include <mitkTwoCompartmentExchangeModel.h>
+
+#include <algorithm>
+#include <cmath>
+
+class mitkPharmacokineticModelJacobianTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPharmacokineticModelJacobianTestSuite);
+  MITK_TEST(StandardToftsJacobian);
+  MITK_TEST(ExtendedToftsJacobian);
+  MITK_TEST(OneTissueCompartmentJacobian);
+  MITK_TEST(TwoCompartmentExchangeJacobian);
+  MITK_TEST(TwoCompartmentExchangeJacobianWithoutExchange);
+  MITK_TEST(CostFunctionDerivative);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ModelBase::TimeGridType m_TimeGrid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
+
+  void InitModel(mitk::AIFBasedModelBase *model)
+  {
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+  }
+
+  /** Checks that the signal of GetSignalAndJacobian() equals GetSignal() and that the Jacobian equals the
+   central differences of the signal.*/
+  void CheckJacobian(const mitk::ModelBase *model, const mitk::ModelBase::ParametersType &parameters)
+  {
+    CPPUNIT_ASSERT_MESSAGE("Check that model offers an analytic Jacobian.", model->HasAnalyticJacobian());
+
+    mitk::ModelBase::ModelResultType signal;
+    mitk::ModelBase::ModelJacobianType jacobian;
+    model->GetSignalAndJacobian(parameters, signal, jacobian);
+
+    const mitk::ModelBase::ModelResultType referenceSignal = model->GetSignal(parameters);
+
+    CPPUNIT_ASSERT_EQUAL(referenceSignal.GetSize(), signal.GetSize());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(parameters.GetSize()), jacobian.rows());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(signal.GetSize()), jacobian.cols());
+
+    for (unsigned int j = 0; j < signal.GetSize(); ++j)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(referenceSignal[j], signal[j], 1e-10 * (1. + std::abs(referenceSignal[j])));
+    }
+
+    for (unsigned int i = 0; i < parameters.GetSize(); ++i)
+    {
+      const double step = 1e-6 * std::max(1., std::abs(parameters[i]));
+      mitk::ModelBase::ParametersType upper = parameters;
+      mitk::ModelBase::ParametersType lower = parameters;
+      upper[i] += step;
+      lower[i] -= step;
+
+      const mitk::ModelBase::ModelResultType upperSignal = model->GetSignal(upper);
+      const mitk::ModelBase::ModelResultType lowerSignal = model->GetSignal(lower);
+
+      for (unsigned int j = 0; j < signal.GetSize(); ++j)
+      {
+        const double numeric = (upperSignal[j] - lowerSignal[j]) / (2 * step);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(numeric, jacobian[i][j], 1e-5 * (1. + std::abs(numeric)));
+      }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_TimeGrid.SetSize(40);
+    m_AIF.SetSize(40);
+
+    for (unsigned int i = 0; i < m_TimeGrid.GetSize(); ++i)
+    {
+      m_TimeGrid[i] = 3.5 * i;
+      m_AIF[i] = 5. * m_TimeGrid[i] * std::exp(-m_TimeGrid[i] / 20.);
+    }
+  }
+
+  void tearDown() override {}
+
+  void StandardToftsJacobian()
+  {
+    mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+    InitModel(model);
+
+    mitk::ModelBase::ParametersType parameters(2);
+    parameters[mitk::StandardToftsModel::POSITION_PARAMETER_Ktrans] = 35.;
+    parameters[mitk::StandardToftsModel::POSITION_PARAMETER_ve] = 0.4;
+
+    CheckJacobian(model, parameters);
+  }
+
+  void ExtendedToftsJacobian()
+  {
+    mitk::ExtendedToftsModel::Pointer model = mitk::ExtendedToftsModel::New();
+    InitModel(model);
+
+    mitk::ModelBase::ParametersType parameters(3);
+    parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 35.;
+    parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_ve] = 0.4;
+    parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_vp] = 0.05;
+
+    CheckJacobian(model, parameters);
+  }
+
+  void OneTissueCompartmentJacobian()
+  {
+    mitk::OneTissueCompartmentModel::Pointer model = mitk::OneTissueCompartmentModel::New();
+    InitModel(model);
+
+    mitk::ModelBase::ParametersType parameters(2);
+    parameters[mitk::OneTissueCompartmentModel::POSITION_PARAMETER_k1] = 0.5;
+    parameters[mitk::OneTissueCompartmentModel::POSITION_PARAMETER_k2] = 0.3;
+
+    CheckJacobian(model, parameters);
+  }
+
+  void TwoCompartmentExchangeJacobian()
+  {
+    mitk::TwoCompartmentExchangeModel::Pointer model = mitk::TwoCompartmentExchangeModel::New();
+    InitModel(model);
+
+    mitk::ModelBase::ParametersType parameters(4);
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 60.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 20.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.3;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+
+    CheckJacobian(model, parameters);
+  }
+
+  void TwoCompartmentExchangeJacobianWithoutExchange()
+  {
+    mitk::TwoCompartmentExchangeModel::Pointer model = mitk::TwoCompartmentExchangeModel::New();
+    InitModel(model);
+
+    mitk::ModelBase::ParametersType parameters(4);
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 60.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 0.;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.3;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+
+    mitk::ModelBase::ModelResultType signal;
+    mitk::ModelBase::ModelJacobianType jacobian;
+    model->GetSignalAndJacobian(parameters, signal, jacobian);
+
+    // for PS = 0 the derivative with respect to PS has to equal the limit of the exchanging model
+    mitk::ModelBase::ModelResultType exchangeSignal;
+    mitk::ModelBase::ModelJacobianType exchangeJacobian;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 1e-3;
+    model->GetSignalAndJacobian(parameters, exchangeSignal, exchangeJacobian);
+
+    for (unsigned int j = 0; j < signal.GetSize(); ++j)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(exchangeSignal[j], signal[j], 1e-3 * (1. + std::abs(signal[j])));
+      for (unsigned int i = 0; i < jacobian.rows(); ++i)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(exchangeJacobian[i][j], jacobian[i][j], 1e-3 * (1. + std::abs(jacobian[i][j])));
+      }
+    }
+  }
+
+  void CostFunctionDerivative()
+  {
+    mitk::ExtendedToftsModel::Pointer model = mitk::ExtendedToftsModel::New();
+    InitModel(model);
+
+    mitk::ModelBase::ParametersType parameters(3);
+    parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 35.;
+    parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_ve] = 0.4;
+    parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_vp] = 0.05;
+
+    mitk::ModelBase::ParametersType sampleParameters = parameters;
+    sampleParameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 30.;
+
+    mitk::SquaredDifferencesFitCostFunction::Pointer costFunction = mitk::SquaredDifferencesFitCostFunction::New();
+    costFunction->SetModel(model);
+    costFunction->SetSample(model->GetSignal(sampleParameters));
+
+    CPPUNIT_ASSERT_MESSAGE("Check that cost function uses the analytic derivative.", costFunction->HasAnalyticDerivative());
+
+    mitk::SquaredDifferencesFitCostFunction::DerivativeType derivative;
+    costFunction->GetDerivative(parameters, derivative);
+
+    for (unsigned int i = 0; i < parameters.GetSize(); ++i)
+    {
+      const double step = 1e-6 * std::max(1., std::abs(parameters[i]));
+      mitk::ModelBase::ParametersType upper = parameters;
+      mitk::ModelBase::ParametersType lower = parameters;
+      upper[i] += step;
+      lower[i] -= step;
+
+      const auto upperMeasure = costFunction->GetValue(upper);
+      const auto lowerMeasure = costFunction->GetValue(lower);
+
+      for (unsigned int j = 0; j < upperMeasure.GetSize(); ++j)
+      {
+        const double numeric = (upperMeasure[j] - lowerMeasure[j]) / (2 * step);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(numeric, derivative[i][j], 1e-5 * (1. + std::abs(numeric)));
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPharmacokineticModelJacobian)
@@ -0,0 +1,187 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkConvolutionHelper.h>
+#include <mitkStandardToftsModel.h>
+#include <mitkStandardToftsModelParameterizer.h>
+#include <mitkTimeGridHelper.h>
+
+#include <cmath>
+
+class mitkPrecomputedAterialInputFunctionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPrecomputedAterialInputFunctionTestSuite);
+  MITK_TEST(PrecomputeOnModelGrid);
+  MITK_TEST(PrecomputeWithAIFTimeGrid);
+  MITK_TEST(InvalidationBySetters);
+  MITK_TEST(ConvolutionEqualsLegacyConvolution);
+  MITK_TEST(SharingByParameterizer);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ModelBase::TimeGridType m_TimeGrid;
+  mitk::ModelBase::TimeGridType m_AIFTimeGrid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_AIF;
+
+public:
+  void setUp() override
+  {
+    m_TimeGrid.SetSize(30);
+    for (unsigned int i = 0; i < m_TimeGrid.GetSize(); ++i)
+    {
+      m_TimeGrid[i] = 4. * i;
+    }
+
+    // the AIF is sampled with a finer time resolution than the model
+    m_AIFTimeGrid.SetSize(60);
+    m_AIF.SetSize(60);
+    for (unsigned int i = 0; i < m_AIFTimeGrid.GetSize(); ++i)
+    {
+      m_AIFTimeGrid[i] = 2. * i;
+      m_AIF[i] = 5. * m_AIFTimeGrid[i] * std::exp(-m_AIFTimeGrid[i] / 20.);
+    }
+  }
+
+  void tearDown() override {}
+
+  void PrecomputeOnModelGrid()
+  {
+    mitk::AIFBasedModelBase::AterialInputFunctionType aif(m_TimeGrid.GetSize());
+    for (unsigned int i = 0; i < aif.GetSize(); ++i)
+    {
+      aif[i] = std::sqrt(m_TimeGrid[i]);
+    }
+
+    auto precomputed = mitk::AIFBasedModelBase::PrecomputeAterialInputFunction(aif, mitk::ModelBase::TimeGridType(), m_TimeGrid);
+
+    CPPUNIT_ASSERT(precomputed->values == aif);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(m_TimeGrid.GetSize() - 1), precomputed->slopes.size());
+
+    for (unsigned int i = 0; i + 1 < m_TimeGrid.GetSize(); ++i)
+    {
+      const double dt = m_TimeGrid[i + 1] - m_TimeGrid[i];
+      const double slope = (aif[i + 1] - aif[i]) / dt;
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(dt, precomputed->intervalLengths[i], 1e-12);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(slope, precomputed->slopes[i], 1e-12);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(aif[i] - slope * m_TimeGrid[i], precomputed->offsets[i], 1e-12);
+    }
+  }
+
+  void PrecomputeWithAIFTimeGrid()
+  {
+    mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+    model->SetAterialInputFunctionTimeGrid(m_AIFTimeGrid);
+
+    const mitk::AIFBasedModelBase::AterialInputFunctionType reference =
+      mitk::InterpolateSignalToNewTimeGrid(m_AIF, m_AIFTimeGrid, m_TimeGrid);
+
+    auto precomputed = model->GetPrecomputedAterialInputFunction();
+    CPPUNIT_ASSERT(precomputed->values == reference);
+    CPPUNIT_ASSERT(model->GetAterialInputFunction(m_TimeGrid) == reference);
+    CPPUNIT_ASSERT_MESSAGE("Check that the precomputed AIF is reused.", precomputed == model->GetPrecomputedAterialInputFunction());
+  }
+
+  void InvalidationBySetters()
+  {
+    mitk::StandardToftsModel::Pointer model = mitk::StandardToftsModel::New();
+    model->SetTimeGrid(m_TimeGrid);
+    model->SetAterialInputFunctionValues(m_AIF);
+    model->SetAterialInputFunctionTimeGrid(m_AIFTimeGrid);
+
+    auto precomputed = model->GetPrecomputedAterialInputFunction();
+
+    model->SetTimeGrid(m_TimeGrid);
+    CPPUNIT_ASSERT_MESSAGE("Check that setting the same time grid keeps the precomputed AIF.", precomputed == model->GetPrecomputedAterialInputFunction());
+
+    mitk::ModelBase::TimeGridType shiftedGrid = m_TimeGrid;
+    for (auto& time : shiftedGrid)
+    {
+      time += 1.;
+    }
+    model->SetTimeGrid(shiftedGrid);
+    auto shifted = model->GetPrecomputedAterialInputFunction();
+    CPPUNIT_ASSERT(shifted != precomputed);
+    CPPUNIT_ASSERT(shifted->timeGrid == shiftedGrid);
+    CPPUNIT_ASSERT(shifted->values == mitk::InterpolateSignalToNewTimeGrid(m_AIF, m_AIFTimeGrid, shiftedGrid));
+
+    mitk::AIFBasedModelBase::AterialInputFunctionType scaledAIF = m_AIF;
+    scaledAIF *= 2.;
+    model->SetAterialInputFunctionValues(scaledAIF);
+    auto scaled = model->GetPrecomputedAterialInputFunction();
+    CPPUNIT_ASSERT(scaled != shifted);
+    CPPUNIT_ASSERT(scaled->values == mitk::InterpolateSignalToNewTimeGrid(scaledAIF, m_AIFTimeGrid, shiftedGrid));
+
+    CPPUNIT_ASSERT_MESSAGE("Check that a non matching precomputed AIF is rejected.", !model->SetPrecomputedAterialInputFunction(precomputed));
+    CPPUNIT_ASSERT(scaled == model->GetPrecomputedAterialInputFunction());
+  }
+
+  void ConvolutionEqualsLegacyConvolution()
+  {
+    auto precomputed = mitk::AIFBasedModelBase::PrecomputeAterialInputFunction(m_AIF, m_AIFTimeGrid, m_TimeGrid);
+
+    const double lambda = 0.07;
+    const itk::Array<double> reference = mitk::convoluteAIFWithExponential(m_TimeGrid, precomputed->values, lambda);
+    const itk::Array<double> convolution = mitk::convoluteAIFWithExponential(*precomputed, lambda);
+
+    itk::Array<double> referenceConvolution, referenceDerivative;
+    mitk::convoluteAIFWithExponentialAndDerivative(m_TimeGrid, precomputed->values, lambda, referenceConvolution, referenceDerivative);
+    itk::Array<double> derivativeConvolution, derivative;
+    mitk::convoluteAIFWithExponentialAndDerivative(*precomputed, lambda, derivativeConvolution, derivative);
+
+    for (unsigned int i = 0; i < m_TimeGrid.GetSize(); ++i)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(reference[i], convolution[i], 1e-10 * (1. + std::abs(reference[i])));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(referenceConvolution[i], derivativeConvolution[i], 1e-10 * (1. + std::abs(reference[i])));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(referenceDerivative[i], derivative[i], 1e-10 * (1. + std::abs(referenceDerivative[i])));
+    }
+  }
+
+  void SharingByParameterizer()
+  {
+    mitk::StandardToftsModelParameterizer::Pointer parameterizer = mitk::StandardToftsModelParameterizer::New();
+    parameterizer->SetDefaultTimeGrid(m_TimeGrid);
+    parameterizer->SetAIF(m_AIF);
+    parameterizer->SetAIFTimeGrid(m_AIFTimeGrid);
+
+    mitk::ModelParameterizerBase::IndexType index;
+    index.Fill(0);
+
+    mitk::ModelBase::Pointer generated1 = parameterizer->GenerateParameterizedModel(index);
+    index[0] = 1;
+    mitk::ModelBase::Pointer generated2 = parameterizer->GenerateParameterizedModel(index);
+
+    auto model1 = dynamic_cast<mitk::AIFBasedModelBase*>(generated1.GetPointer());
+    auto model2 = dynamic_cast<mitk::AIFBasedModelBase*>(generated2.GetPointer());
+
+    CPPUNIT_ASSERT(model1 != nullptr && model2 != nullptr);
+    CPPUNIT_ASSERT_MESSAGE("Check that all generated models share the precomputed AIF.",
+      model1->GetPrecomputedAterialInputFunction() == model2->GetPrecomputedAterialInputFunction());
+
+    mitk::ModelBase::ParametersType parameters(2);
+    parameters[0] = 35.;
+    parameters[1] = 0.4;
+
+    mitk::StandardToftsModel::Pointer reference = mitk::StandardToftsModel::New();
+    reference->SetTimeGrid(m_TimeGrid);
+    reference->SetAterialInputFunctionValues(m_AIF);
+    reference->SetAterialInputFunctionTimeGrid(m_AIFTimeGrid);
+
+    CPPUNIT_ASSERT(reference->GetSignal(parameters) == model1->GetSignal(parameters));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPrecomputedAterialInputFunction)
@@ -11,6 +11,8 @@ set(CPP_FILES
   source/OpenCLFilter/mitkPhotoacousticBModeFilter.cpp
   source/utils/mitkPhotoacousticFilterService.cpp
   source/utils/mitkBeamformingUtils.cpp
+  source/utils/mitkBeamformingThreadPool.cpp
+  source/utils/mitkBeamformingDelayTable.cpp
   source/mitkPhotoacousticMotionCorrectionFilter.cpp
 )
 
@@ -0,0 +1,111 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_BEAMFORMING_DELAY_TABLE
+#define MITK_BEAMFORMING_DELAY_TABLE
+
+#include <itkObject.h>
+#include <mitkCommon.h>
+#include <cstddef>
+#include <vector>
+
+#include "mitkBeamformingSettings.h"
+#include "MitkPhotoacousticsAlgorithmsExports.h"
+
+namespace mitk {
+  /*!
+  * \brief Precomputed delays, used lines and apodization weights for beamforming on CPU
+  *
+  *  This is the CPU equivalent of the buffers built by DelayCalculation.cl and UsedLinesCalculation.cl for the OpenCL path:
+  *  for every output pixel the table stores the input samples contributing to it (as offsets into one input slice) together
+  *  with their apodization weights. Samples outside of the input are already dropped. As the table only depends on
+  *  mitk::BeamformingSettings, it is built once and then used for every slice and frame, so beamforming a slice is reduced
+  *  to a gather-and-sum over the table.
+  *
+  *  The memory needed is 8 bytes per used input sample of every output pixel. Tables which would exceed
+  *  GetMaximumMemorySize() are not built, callers then have to calculate the delays per pixel.
+  */
+  class MITKPHOTOACOUSTICSALGORITHMS_EXPORT BeamformingDelayTable : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(BeamformingDelayTable, itk::Object);
+    mitkNewMacro1Param(Self, BeamformingSettings::Pointer);
+
+    /** \brief A single input sample contributing to an output pixel
+    */
+    struct Entry
+    {
+      /** \brief Offset of the delayed sample within an input slice (line + delay * input lines) */
+      unsigned int InputOffset;
+      /** \brief Apodization weight of the sample */
+      float Weight;
+    };
+
+    /** \brief Range of entries contributing to an output pixel
+    */
+    struct Pixel
+    {
+      /** \brief Index of the first entry of the pixel */
+      std::size_t Begin;
+      /** \brief Number of entries of the pixel, i.e. the number of used lines for DAS */
+      unsigned short ValidLines;
+      /** \brief Number of used lines for the normalization of DMAS and sDMAS */
+      unsigned short DMASUsedLines;
+    };
+
+    /** \brief Returns a table for the given settings
+    *
+    *  The most recently built table is kept and returned again as long as the settings relevant for it
+    *  (see mitk::BeamformingSettings::SettingsChangedCPU) stay the same, so continuous acquisitions with a fixed geometry
+    *  build the table only once.
+    *  Returns nullptr if the table would need more memory than GetMaximumMemorySize().
+    */
+    static Pointer GetTable(BeamformingSettings::Pointer config);
+
+    /** \brief Returns an upper bound of the memory in bytes a table for the given settings needs
+    */
+    static std::size_t EstimateMemorySize(BeamformingSettings::Pointer config);
+
+    /** \brief Sets the maximum memory in bytes a table may use, the default is 512 MB
+    */
+    static void SetMaximumMemorySize(std::size_t size);
+    static std::size_t GetMaximumMemorySize();
+
+    /** \brief The pixels of the table, in the same order as the pixels of an output slice (sample * output lines + line)
+    */
+    const Pixel* GetPixels() const { return m_Pixels.data(); }
+
+    /** \brief All entries of the table, referenced by the pixels
+    */
+    const Entry* GetEntries() const { return m_Entries.data(); }
+
+    itkGetConstMacro(OutputLines, unsigned int);
+    itkGetConstMacro(OutputSamples, unsigned int);
+
+  protected:
+    BeamformingDelayTable(BeamformingSettings::Pointer config);
+
+    ~BeamformingDelayTable() override;
+
+    unsigned int m_OutputLines;
+    unsigned int m_OutputSamples;
+
+    std::vector<Pixel> m_Pixels;
+    std::vector<Entry> m_Entries;
+
+    /** \brief The settings the table was built for
+    */
+    BeamformingSettings::Pointer m_Conf;
+  };
+} // namespace mitk
+
+#endif //MITK_BEAMFORMING_DELAY_TABLE
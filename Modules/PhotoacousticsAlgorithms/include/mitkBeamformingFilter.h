@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include "./OpenCLFilter/mitkPhotoacousticOCLBeamformingFilter.h"
 #include "mitkBeamformingSettings.h"
 #include "mitkBeamformingUtils.h"
+#include "mitkBeamformingThreadPool.h"
 #include "MitkPhotoacousticsAlgorithmsExports.h"
 
 namespace mitk {
@@ -55,6 +56,11 @@ namespace mitk {
 
     void GenerateData() override;
 
+    /** \brief Size of the tiles in which the output image is beamformed on the CPU; every tile is processed by one thread of mitk::BeamformingThreadPool
+    */
+    static const unsigned int LINES_PER_TILE = 8;
+    static const unsigned int SAMPLES_PER_TILE = 128;
+
     //##Description
     //## @brief Time when Header was last initialized
     itk::TimeStamp m_TimeOfHeaderInitialization;
@@ -80,6 +86,10 @@ namespace mitk {
     /** \brief Pointer to the GPU beamforming filter class; for performance reasons the filter is initialized within the constructor and kept for all later computations.
     */
     mitk::PhotoacousticOCLBeamformingFilter::Pointer m_BeamformingOclFilter;
+
+    /** \brief The CPU thread pool, acquired on the first CPU reconstruction and released with the filter.
+    */
+    std::shared_ptr<BeamformingThreadPool> m_ThreadPool;
   };
 } // namespace mitk
 
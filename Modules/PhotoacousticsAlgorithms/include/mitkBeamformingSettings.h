@@ -91,6 +91,17 @@ namespace mitk {
         (lhs->GetTransducerElements() == rhs->GetTransducerElements()));
     }
 
+    /** \brief function for mitk::BeamformingDelayTable to check whether a precomputed table can be reused for the given settings
+    * this method checks all parameters the delays, used lines and apodization weights of the CPU implementation depend on
+    */
+    static bool SettingsChangedCPU(const BeamformingSettings::Pointer lhs, const BeamformingSettings::Pointer rhs)
+    {
+      return SettingsChangedOpenCL(lhs, rhs) ||
+        (lhs->GetInputDim()[0] != rhs->GetInputDim()[0]) ||
+        (lhs->GetInputDim()[1] != rhs->GetInputDim()[1]) ||
+        (lhs->GetApodizationArraySize() != rhs->GetApodizationArraySize());
+    }
+
     static Pointer New(float pitchInMeters,
       float speedOfSound,
       float timeSpacing,
@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef MITK_BEAMFORMING_THREAD_POOL
+#define MITK_BEAMFORMING_THREAD_POOL
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MitkPhotoacousticsAlgorithmsExports.h"
+
+namespace mitk {
+  /*!
+  * \brief Persistent pool of worker threads used for beamforming on CPU
+  *
+  *  The pool is shared by all users and reused for all slices and frames beamformed by mitk::BeamformingFilter,
+  *  so no threads are created or joined while reconstructing. Its lifetime is owned by its users: mitk::BeamformingFilter
+  *  keeps a reference, and the workers are joined as soon as the last reference is released. The pool is thus never
+  *  joined during static destruction, where the order relative to other statics is undefined. Work is handed out as a number of independent tiles;
+  *  idle workers (and the calling thread) fetch the next unprocessed tile from a shared counter until all tiles are done,
+  *  which balances the uneven cost of tiles (e.g. deep samples using more transducer elements) automatically.
+  */
+  class MITKPHOTOACOUSTICSALGORITHMS_EXPORT BeamformingThreadPool final
+  {
+  public:
+    /** \brief Returns the shared pool, which is created with one worker per hardware thread if no reference to it is held.
+    *
+    *  The workers are stopped and joined when the last returned reference is released. Keep the reference for as long
+    *  as the pool is used repeatedly, to avoid recreating the workers.
+    */
+    static std::shared_ptr<BeamformingThreadPool> GetInstance();
+
+    /** \brief Number of threads processing tiles, including the calling thread.
+    */
+    unsigned int GetNumberOfThreads() const;
+
+    /** \brief Calls tileFunction(tile) for every tile in [0, numberOfTiles) on the pool and blocks until all tiles are processed.
+    *
+    *  Calls from different threads are serialized. If a tile function throws, the remaining tiles are skipped and the
+    *  first exception is rethrown in the calling thread.
+    */
+    void ParallelFor(unsigned int numberOfTiles, const std::function<void(unsigned int)>& tileFunction);
+
+    BeamformingThreadPool(const BeamformingThreadPool&) = delete;
+    BeamformingThreadPool& operator=(const BeamformingThreadPool&) = delete;
+
+  private:
+    struct Job;
+
+    explicit BeamformingThreadPool(unsigned int numberOfWorkers);
+    ~BeamformingThreadPool();
+
+    void WorkerLoop();
+    static void ProcessTiles(Job& job);
+
+    std::vector<std::thread> m_Workers;
+
+    std::mutex m_SubmitMutex;
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkAvailable;
+    std::condition_variable m_JobDone;
+
+    std::shared_ptr<Job> m_CurrentJob;
+    unsigned long m_JobGeneration;
+    bool m_Stop;
+  };
+} // namespace mitk
+
+#endif //MITK_BEAMFORMING_THREAD_POOL
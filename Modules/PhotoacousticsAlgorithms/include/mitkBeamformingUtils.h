@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <functional>
 #include "./OpenCLFilter/mitkPhotoacousticOCLBeamformingFilter.h"
 #include "mitkBeamformingSettings.h"
+#include "mitkBeamformingDelayTable.h"
 
 namespace mitk {
   /*!
@@ -27,6 +28,45 @@ namespace mitk {
   {
   public:
 
+    /** \brief Function to perform beamforming on CPU for a tile of the output image, using DAS and spherical delay
+    *
+    *  The tile covers the output lines [lineBegin, lineEnd) and the output samples [sampleBegin, sampleEnd); tiles do not
+    *  share any output pixels, so different tiles can be processed concurrently. config->GetMinMaxLines() must have been
+    *  called once before tiles are processed in parallel.
+    */
+    static void DASSphericalTile(const float* input, float* output, const float inputDim[2], const float outputDim[2],
+      unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd,
+      const mitk::BeamformingSettings::Pointer config);
+
+    /** \brief Function to perform beamforming on CPU for a tile of the output image, using DMAS and spherical delay
+    */
+    static void DMASSphericalTile(const float* input, float* output, const float inputDim[2], const float outputDim[2],
+      unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd,
+      const mitk::BeamformingSettings::Pointer config);
+
+    /** \brief Function to perform beamforming on CPU for a tile of the output image, using signed DMAS and spherical delay
+    */
+    static void sDMASSphericalTile(const float* input, float* output, const float inputDim[2], const float outputDim[2],
+      unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd,
+      const mitk::BeamformingSettings::Pointer config);
+
+    /** \brief Function to perform beamforming on CPU for a tile of the output image using DAS and a precomputed mitk::BeamformingDelayTable
+    *
+    *  The tile covers the output lines [lineBegin, lineEnd) and the output samples [sampleBegin, sampleEnd).
+    */
+    static void DASTableTile(const float* input, float* output, const mitk::BeamformingDelayTable* table,
+      unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd);
+
+    /** \brief Function to perform beamforming on CPU for a tile of the output image using DMAS and a precomputed mitk::BeamformingDelayTable
+    */
+    static void DMASTableTile(const float* input, float* output, const mitk::BeamformingDelayTable* table,
+      unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd);
+
+    /** \brief Function to perform beamforming on CPU for a tile of the output image using signed DMAS and a precomputed mitk::BeamformingDelayTable
+    */
+    static void sDMASTableTile(const float* input, float* output, const mitk::BeamformingDelayTable* table,
+      unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd);
+
     /** \brief Function to perform beamforming on CPU for a single line, using DAS and spherical delay
     */
     static void DASSphericalLine(float* input, float* output, float inputDim[2], float outputDim[2], const short& line, const mitk::BeamformingSettings::Pointer config);
@@ -54,6 +94,15 @@ namespace mitk {
     */
     static float* BoxFunction(int samples);
 
+    /** \brief Calculates the spherical delays of the elements [minLine, maxLine) for the output point (l_p, s_i)
+    * @param delays output array of size maxLine - minLine
+    * @param elementHeights heights of all transducer elements in input samples
+    * @param elementPositions horizontal positions of all transducer elements in input samples
+    * @param ultrasoundOffset additional delay for ultrasound images, 0 for photoacoustic images
+    */
+    static void CalculateSphericalDelays(int* delays, const float* elementHeights, const float* elementPositions,
+      float l_p, float s_i, int ultrasoundOffset, short minLine, short maxLine);
+
     /** \brief
     */
     static unsigned short* MinMaxLines(const mitk::BeamformingSettings::Pointer config);
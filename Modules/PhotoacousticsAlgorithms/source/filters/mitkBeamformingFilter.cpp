@@ -15,11 +15,11 @@ found in the LICENSE file.
 #include <algorithm>
 #include <itkImageIOBase.h>
 #include <chrono>
-#include <thread>
-#include <itkImageIOBase.h>
+#include <vector>
 #include "mitkImageCast.h"
 #include "mitkBeamformingFilter.h"
 #include "mitkBeamformingUtils.h"
+#include "mitkBeamformingThreadPool.h"
 
 mitk::BeamformingFilter::BeamformingFilter(mitk::BeamformingSettings::Pointer settings) :
   m_OutputData(nullptr),
@@ -110,67 +110,79 @@ void mitk::BeamformingFilter::GenerateData()
     int progInterval = output->GetDimension(2) / 20 > 1 ? output->GetDimension(2) / 20 : 1;
     // the interval at which we update the gui progress bar
 
+    const unsigned int outputL = output->GetDimension(0);
+    const unsigned int outputS = output->GetDimension(1);
+
+    // the output image is split into tiles of lines x samples which are processed by the persistent thread pool
+    const unsigned int lineTiles = (outputL + LINES_PER_TILE - 1) / LINES_PER_TILE;
+    const unsigned int sampleTiles = (outputS + SAMPLES_PER_TILE - 1) / SAMPLES_PER_TILE;
+
     float inputDim[2] = { (float)input->GetDimension(0), (float)input->GetDimension(1) };
     float outputDim[2] = { (float)output->GetDimension(0), (float)output->GetDimension(1) };
 
-    for (unsigned int i = 0; i < output->GetDimension(2); ++i) // seperate Slices should get Beamforming seperately applied
+    // the delays and weights only depend on the settings; they are reused for all slices and as long as the settings do not change.
+    // The table is built for the input dimensions of the settings, for other inputs and for tables exceeding
+    // BeamformingDelayTable::GetMaximumMemorySize the delays are calculated per pixel as before
+    mitk::BeamformingDelayTable::Pointer delayTable;
+    if (input->GetDimension(0) == m_Conf->GetInputDim()[0] && input->GetDimension(1) == m_Conf->GetInputDim()[1])
     {
-      mitk::ImageReadAccessor inputReadAccessor(input, input->GetSliceData(i));
-      m_InputData = (float*)inputReadAccessor.GetData();
+      delayTable = mitk::BeamformingDelayTable::GetTable(m_Conf);
+    }
+    else
+    {
+      MITK_WARN << "Input dimensions do not match the dimensions given in the beamforming settings, the delay table is not used.";
+    }
 
-      m_OutputData = new float[m_Conf->GetReconstructionLines()*m_Conf->GetSamplesPerLine()];
+    void(*beamformTableTile)(const float*, float*, const mitk::BeamformingDelayTable*, unsigned int, unsigned int, unsigned int, unsigned int)
+      = &BeamformingUtils::DASTableTile;
+    void(*beamformSphericalTile)(const float*, float*, const float*, const float*, unsigned int, unsigned int, unsigned int, unsigned int,
+      const mitk::BeamformingSettings::Pointer) = &BeamformingUtils::DASSphericalTile;
+    if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::DMAS)
+    {
+      beamformTableTile = &BeamformingUtils::DMASTableTile;
+      beamformSphericalTile = &BeamformingUtils::DMASSphericalTile;
+    }
+    else if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::sDMAS)
+    {
+      beamformTableTile = &BeamformingUtils::sDMASTableTile;
+      beamformSphericalTile = &BeamformingUtils::sDMASSphericalTile;
+    }
 
-      // fill the image with zeros
-      for (int l = 0; l < outputDim[0]; ++l)
-      {
-        for (int s = 0; s < outputDim[1]; ++s)
-        {
-          m_OutputData[l*(short)outputDim[1] + s] = 0;
-        }
-      }
+    // the min/max lines are calculated lazily; make sure this happens before the worker threads access them
+    m_Conf->GetMinMaxLines();
 
-      std::thread *threads = new std::thread[(short)outputDim[0]];
+    std::vector<float> outputSlice(outputL * outputS);
+    m_OutputData = outputSlice.data();
 
-      // every line will be beamformed in a seperate thread
-      if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::DAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::DASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      else if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::DMAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::DMASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      else if (m_Conf->GetAlgorithm() == BeamformingSettings::BeamformingAlgorithm::sDMAS)
-      {
-        for (short line = 0; line < outputDim[0]; ++line)
-        {
-          threads[line] = std::thread(&BeamformingUtils::sDMASSphericalLine, m_InputData,
-            m_OutputData, inputDim, outputDim, line, m_Conf);
-        }
-      }
-      // wait for all lines to finish
-      for (short line = 0; line < outputDim[0]; ++line)
+    // the filter keeps the pool alive, so its workers are reused for all updates of this filter
+    if (!m_ThreadPool)
+      m_ThreadPool = BeamformingThreadPool::GetInstance();
+
+    for (unsigned int i = 0; i < output->GetDimension(2); ++i) // seperate Slices should get Beamforming seperately applied
+    {
+      mitk::ImageReadAccessor inputReadAccessor(input, input->GetSliceData(i));
+      m_InputData = (float*)inputReadAccessor.GetData();
+
+      m_ThreadPool->ParallelFor(lineTiles * sampleTiles, [&](unsigned int tile)
       {
-        threads[line].join();
-      }
+        const unsigned int lineBegin = (tile % lineTiles) * LINES_PER_TILE;
+        const unsigned int sampleBegin = (tile / lineTiles) * SAMPLES_PER_TILE;
+        const unsigned int lineEnd = std::min(lineBegin + LINES_PER_TILE, outputL);
+        const unsigned int sampleEnd = std::min(sampleBegin + SAMPLES_PER_TILE, outputS);
+        if (delayTable.IsNotNull())
+          beamformTableTile(m_InputData, m_OutputData, delayTable.GetPointer(), lineBegin, lineEnd, sampleBegin, sampleEnd);
+        else
+          beamformSphericalTile(m_InputData, m_OutputData, inputDim, outputDim, lineBegin, lineEnd, sampleBegin, sampleEnd, m_Conf);
+      });
 
       output->SetSlice(m_OutputData, i);
 
       if (i % progInterval == 0)
         m_ProgressHandle((int)((i + 1) / (float)output->GetDimension(2) * 100), "performing reconstruction");
 
-      delete[] m_OutputData;
-      m_OutputData = nullptr;
       m_InputData = nullptr;
     }
+    m_OutputData = nullptr;
   }
 #if defined(PHOTOACOUSTICS_USE_GPU) || DOXYGEN
   else
@@ -0,0 +1,206 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBeamformingDelayTable.h"
+#include "mitkBeamformingThreadPool.h"
+#include "mitkBeamformingUtils.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace
+{
+  std::atomic<std::size_t> maximumMemorySize(512 * 1024 * 1024);
+}
+
+void mitk::BeamformingDelayTable::SetMaximumMemorySize(std::size_t size)
+{
+  maximumMemorySize = size;
+}
+
+std::size_t mitk::BeamformingDelayTable::GetMaximumMemorySize()
+{
+  return maximumMemorySize;
+}
+
+std::size_t mitk::BeamformingDelayTable::EstimateMemorySize(BeamformingSettings::Pointer config)
+{
+  const std::size_t numberOfPixels = (std::size_t)config->GetReconstructionLines() * config->GetSamplesPerLine();
+  const unsigned short* minMaxLines = config->GetMinMaxLines();
+
+  // every element between the min and max line of a pixel may contribute, samples outside of the input are dropped later
+  std::size_t numberOfEntries = 0;
+  for (std::size_t pixel = 0; pixel < numberOfPixels; ++pixel)
+  {
+    if (minMaxLines[2 * pixel + 1] > minMaxLines[2 * pixel])
+      numberOfEntries += minMaxLines[2 * pixel + 1] - minMaxLines[2 * pixel];
+  }
+
+  return numberOfPixels * sizeof(Pixel) + numberOfEntries * sizeof(Entry);
+}
+
+mitk::BeamformingDelayTable::Pointer mitk::BeamformingDelayTable::GetTable(BeamformingSettings::Pointer config)
+{
+  static std::mutex cacheMutex;
+  static BeamformingDelayTable::Pointer cachedTable;
+  static BeamformingSettings::Pointer rejectedConf;
+  static std::size_t rejectedLimit = 0;
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  if (cachedTable.IsNotNull() && !BeamformingSettings::SettingsChangedCPU(cachedTable->m_Conf, config))
+    return cachedTable;
+
+  // release the old table first, both may not fit into memory at the same time
+  cachedTable = nullptr;
+
+  // do not estimate and warn again for every slice of settings which were already rejected
+  const std::size_t limit = GetMaximumMemorySize();
+  if (rejectedConf.IsNotNull() && rejectedLimit == limit && !BeamformingSettings::SettingsChangedCPU(rejectedConf, config))
+    return nullptr;
+
+  const std::size_t memorySize = EstimateMemorySize(config);
+  if (memorySize > limit)
+  {
+    MITK_WARN << "The beamforming delay table would need up to " << memorySize / (1024 * 1024) << " MB, which exceeds the limit of "
+      << limit / (1024 * 1024) << " MB. The delays are calculated per pixel instead.";
+    rejectedConf = config;
+    rejectedLimit = limit;
+    return nullptr;
+  }
+
+  rejectedConf = nullptr;
+  cachedTable = BeamformingDelayTable::New(config);
+  return cachedTable;
+}
+
+mitk::BeamformingDelayTable::BeamformingDelayTable(BeamformingSettings::Pointer config) :
+  m_OutputLines(config->GetReconstructionLines()),
+  m_OutputSamples(config->GetSamplesPerLine()),
+  m_Conf(config)
+{
+  MITK_INFO << "Calculating beamforming delay table...";
+
+  const unsigned int inputL = config->GetInputDim()[0];
+  const float inputS = (float)config->GetInputDim()[1];
+  const unsigned int outputL = m_OutputLines;
+  const unsigned int outputS = m_OutputSamples;
+
+  const float* apodisation = config->GetApodizationFunction();
+  const short apodArraySize = config->GetApodizationArraySize();
+  // calculated lazily, make sure this happens before the threads access them
+  const unsigned short* minMaxLines = config->GetMinMaxLines();
+
+  const float samplesPerMeter = 1 / (config->GetSpeedOfSound() * config->GetTimeSpacing());
+  std::vector<float> elementHeights(inputL);
+  std::vector<float> elementPositions(inputL);
+  for (unsigned int l_s = 0; l_s < inputL; ++l_s)
+  {
+    elementHeights[l_s] = config->GetElementHeights()[l_s] * samplesPerMeter;
+    elementPositions[l_s] = config->GetElementPositions()[l_s] * samplesPerMeter;
+  }
+
+  float totalSamples_i = config->GetReconstructionDepth() * samplesPerMeter;
+  totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
+
+  m_Pixels.resize((std::size_t)outputL * outputS);
+
+  // visits the delays of all used elements of all pixels of an output sample row, in the order they are stored in the table
+  auto forEachDelay = [&](unsigned int sample, auto&& visit)
+  {
+    thread_local std::vector<int> delays;
+    if (delays.size() < inputL)
+      delays.resize(inputL);
+
+    const float s_i = (float)sample / outputS * totalSamples_i;
+    const int ultrasoundOffset = config->GetIsPhotoacousticImage() ? 0 : (int)s_i;
+
+    for (unsigned int line = 0; line < outputL; ++line)
+    {
+      const float l_p = (float)line / outputL * config->GetHorizontalExtent() * samplesPerMeter;
+      const short minLine = minMaxLines[2 * sample * outputL + 2 * line];
+      const short maxLine = minMaxLines[2 * sample * outputL + 2 * line + 1];
+
+      mitk::BeamformingUtils::CalculateSphericalDelays(delays.data(), elementHeights.data(), elementPositions.data(),
+        l_p, s_i, ultrasoundOffset, minLine, maxLine);
+
+      for (short l_s = minLine; l_s < maxLine; ++l_s)
+      {
+        const int delay = delays[l_s - minLine];
+        visit(line, minLine, l_s, delay, delay < inputS && delay >= 0);
+      }
+    }
+  };
+
+  auto threadPool = BeamformingThreadPool::GetInstance();
+
+  // first pass: count the valid delays of every pixel
+  threadPool->ParallelFor(outputS, [&](unsigned int sample)
+  {
+    for (unsigned int line = 0; line < outputL; ++line)
+    {
+      const short minLine = minMaxLines[2 * sample * outputL + 2 * line];
+      const short maxLine = minMaxLines[2 * sample * outputL + 2 * line + 1];
+      auto& pixel = m_Pixels[sample * outputL + line];
+      pixel.ValidLines = 0;
+      // DMAS does not count an invalid last line as unused, see BeamformingUtils::DMASSphericalTile
+      pixel.DMASUsedLines = maxLine > minLine ? 1 : 0;
+    }
+
+    forEachDelay(sample, [&](unsigned int line, short, short l_s, int, bool valid)
+    {
+      if (!valid)
+        return;
+
+      auto& pixel = m_Pixels[sample * outputL + line];
+      ++pixel.ValidLines;
+      if (l_s < minMaxLines[2 * sample * outputL + 2 * line + 1] - 1)
+        ++pixel.DMASUsedLines;
+    });
+  });
+
+  std::size_t numberOfEntries = 0;
+  for (auto& pixel : m_Pixels)
+  {
+    pixel.Begin = numberOfEntries;
+    numberOfEntries += pixel.ValidLines;
+  }
+  m_Entries.resize(numberOfEntries);
+
+  // second pass: store the input offsets and apodization weights
+  threadPool->ParallelFor(outputS, [&](unsigned int sample)
+  {
+    std::size_t next = 0;
+    float apod_mult = 1;
+
+    forEachDelay(sample, [&](unsigned int line, short minLine, short l_s, int delay, bool valid)
+    {
+      if (l_s == minLine) // first element of a new pixel
+      {
+        next = m_Pixels[sample * outputL + line].Begin;
+        apod_mult = (float)apodArraySize / (float)(minMaxLines[2 * sample * outputL + 2 * line + 1] - minLine);
+      }
+
+      if (!valid)
+        return;
+
+      m_Entries[next].InputOffset = l_s + delay * inputL;
+      m_Entries[next].Weight = apodisation[(short)((l_s - minLine) * apod_mult)];
+      ++next;
+    });
+  });
+
+  MITK_INFO << "Calculating beamforming delay table...[Done] (" << numberOfEntries * sizeof(Entry) / (1024 * 1024) << " MB)";
+}
+
+mitk::BeamformingDelayTable::~BeamformingDelayTable()
+{
+}
@@ -0,0 +1,167 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBeamformingThreadPool.h"
+
+#include <atomic>
+#include <exception>
+
+struct mitk::BeamformingThreadPool::Job
+{
+  Job(unsigned int numberOfTiles, const std::function<void(unsigned int)>& tileFunction)
+    : NumberOfTiles(numberOfTiles), TileFunction(tileFunction), NextTile(0), FinishedTiles(0)
+  {
+  }
+
+  const unsigned int NumberOfTiles;
+  const std::function<void(unsigned int)>& TileFunction;
+  std::atomic<unsigned int> NextTile;
+  std::atomic<unsigned int> FinishedTiles;
+
+  std::mutex ExceptionMutex;
+  std::exception_ptr Exception;
+};
+
+std::shared_ptr<mitk::BeamformingThreadPool> mitk::BeamformingThreadPool::GetInstance()
+{
+  // only a weak reference is kept here, so the pool is destroyed by its last user and not during static destruction
+  static std::mutex instanceMutex;
+  static std::weak_ptr<BeamformingThreadPool> instance;
+
+  std::lock_guard<std::mutex> lock(instanceMutex);
+  std::shared_ptr<BeamformingThreadPool> pool = instance.lock();
+  if (!pool)
+  {
+    const unsigned int numberOfWorkers = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0;
+    pool = std::shared_ptr<BeamformingThreadPool>(new BeamformingThreadPool(numberOfWorkers),
+      [](BeamformingThreadPool* threadPool) { delete threadPool; });
+    instance = pool;
+  }
+  return pool;
+}
+
+mitk::BeamformingThreadPool::BeamformingThreadPool(unsigned int numberOfWorkers)
+  : m_JobGeneration(0), m_Stop(false)
+{
+  m_Workers.reserve(numberOfWorkers);
+  for (unsigned int i = 0; i < numberOfWorkers; ++i)
+  {
+    m_Workers.emplace_back(&BeamformingThreadPool::WorkerLoop, this);
+  }
+}
+
+mitk::BeamformingThreadPool::~BeamformingThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_WorkAvailable.notify_all();
+
+  for (auto& worker : m_Workers)
+  {
+    worker.join();
+  }
+}
+
+unsigned int mitk::BeamformingThreadPool::GetNumberOfThreads() const
+{
+  return static_cast<unsigned int>(m_Workers.size()) + 1;
+}
+
+void mitk::BeamformingThreadPool::ParallelFor(unsigned int numberOfTiles, const std::function<void(unsigned int)>& tileFunction)
+{
+  if (numberOfTiles == 0)
+    return;
+
+  std::lock_guard<std::mutex> submitLock(m_SubmitMutex);
+
+  // every job gets its own state, so workers waking up late for an already finished job cannot pick up tiles of the next one
+  auto job = std::make_shared<Job>(numberOfTiles, tileFunction);
+
+  if (numberOfTiles > 1 && !m_Workers.empty())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_CurrentJob = job;
+      ++m_JobGeneration;
+    }
+    m_WorkAvailable.notify_all();
+  }
+
+  ProcessTiles(*job);
+
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_JobDone.wait(lock, [&job] { return job->FinishedTiles.load() == job->NumberOfTiles; });
+    m_CurrentJob = nullptr;
+  }
+
+  if (job->Exception)
+    std::rethrow_exception(job->Exception);
+}
+
+void mitk::BeamformingThreadPool::ProcessTiles(Job& job)
+{
+  for (unsigned int tile = job.NextTile++; tile < job.NumberOfTiles; tile = job.NextTile++)
+  {
+    try
+    {
+      job.TileFunction(tile);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(job.ExceptionMutex);
+      if (!job.Exception)
+        job.Exception = std::current_exception();
+
+      // skip all tiles not yet started, but count them as finished so the caller does not wait for them
+      unsigned int skippedFrom = job.NextTile.exchange(job.NumberOfTiles);
+      if (skippedFrom < job.NumberOfTiles)
+        job.FinishedTiles += job.NumberOfTiles - skippedFrom;
+    }
+
+    ++job.FinishedTiles;
+  }
+}
+
+void mitk::BeamformingThreadPool::WorkerLoop()
+{
+  unsigned long processedGeneration = 0;
+
+  while (true)
+  {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_WorkAvailable.wait(lock, [this, processedGeneration] { return m_Stop || m_JobGeneration != processedGeneration; });
+
+      if (m_Stop)
+        return;
+
+      processedGeneration = m_JobGeneration;
+      job = m_CurrentJob;
+    }
+
+    if (!job)
+      continue;
+
+    ProcessTiles(*job);
+
+    if (job->FinishedTiles.load() >= job->NumberOfTiles)
+    {
+      // take the lock so the notification cannot slip in between the predicate check and the wait of the caller
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_JobDone.notify_all();
+    }
+  }
+}
@@ -16,7 +16,7 @@ found in the LICENSE file.
 #include <itkImageIOBase.h>
 #include <chrono>
 #include <thread>
-#include <itkImageIOBase.h>
+#include <vector>
 #include "mitkImageCast.h"
 #include "mitkBeamformingUtils.h"
 
@@ -180,229 +180,302 @@ unsigned short* mitk::BeamformingUtils::MinMaxLines(const mitk::BeamformingSetti
   return dDest;
 }
 
-void mitk::BeamformingUtils::DASSphericalLine(
-  float* input, float* output, float inputDim[2], float outputDim[2],
-  const short& line, const mitk::BeamformingSettings::Pointer config)
+void mitk::BeamformingUtils::CalculateSphericalDelays(int* delays, const float* elementHeights, const float* elementPositions,
+  float l_p, float s_i, int ultrasoundOffset, short minLine, short maxLine)
 {
-  const float* apodisation = config->GetApodizationFunction();
-  const short apodArraySize = config->GetApodizationArraySize();
-
-  const float* elementHeights = config->GetElementHeights();
-  const float* elementPositions = config->GetElementPositions();
-
-  float& inputS = inputDim[1];
-  float& inputL = inputDim[0];
-
-  float& outputS = outputDim[1];
-  float& outputL = outputDim[0];
-
-  short AddSample = 0;
-  short maxLine = 0;
-  short minLine = 0;
-  float l_p = 0;
-  float s_i = 0;
-
-  float apod_mult = 1;
-
-  short usedLines = (maxLine - minLine);
-
-  float totalSamples_i = (float)(config->GetReconstructionDepth()) / (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
-  totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
+  elementHeights += minLine;
+  elementPositions += minLine;
+  const short usedLines = maxLine - minLine;
 
-  l_p = (float)line / outputL * config->GetHorizontalExtent();
-
-  for (short sample = 0; sample < outputS; ++sample)
+  // kept free of branches and data dependencies so the compiler is able to vectorize it
+  for (short l = 0; l < usedLines; ++l)
   {
-    s_i = (float)sample / outputS * totalSamples_i;
-
-    minLine = config->GetMinMaxLines()[2*sample*(short)outputL + 2*line];
-    maxLine = config->GetMinMaxLines()[2*sample*(short)outputL + 2*line + 1];
-    usedLines = (maxLine - minLine);
-
-    apod_mult = (float)apodArraySize / (float)usedLines;
-
-    for (short l_s = minLine; l_s < maxLine; ++l_s)
-    {
-      AddSample = (int)sqrt(
-        pow(s_i-elementHeights[l_s]/(config->GetSpeedOfSound()*config->GetTimeSpacing()), 2)
-        +
-        pow((1 / (config->GetTimeSpacing()*config->GetSpeedOfSound())) * (l_p - elementPositions[l_s]), 2)
-      ) + (1 - config->GetIsPhotoacousticImage())*s_i;
-      if (AddSample < inputS && AddSample >= 0)
-        output[sample*(short)outputL + line] += input[l_s + AddSample*(short)inputL] *
-        apodisation[(short)((l_s - minLine)*apod_mult)];
-      else
-        --usedLines;
-    }
-    output[sample*(short)outputL + line] = output[sample*(short)outputL + line] / usedLines;
+    const float dy = s_i - elementHeights[l];
+    const float dx = l_p - elementPositions[l];
+    delays[l] = (int)std::sqrt(dy * dy + dx * dx) + ultrasoundOffset;
   }
 }
 
-void mitk::BeamformingUtils::DMASSphericalLine(
-  float* input, float* output, float inputDim[2], float outputDim[2],
-  const short& line, const mitk::BeamformingSettings::Pointer config)
+namespace
 {
-  const float* apodisation = config->GetApodizationFunction();
-  const short apodArraySize = config->GetApodizationArraySize();
-
-  const float* elementHeights = config->GetElementHeights();
-  const float* elementPositions = config->GetElementPositions();
+  /** \brief Geometry of the transducer elements in units of input samples, shared by the spherical delay kernels of one tile
+  */
+  struct SphericalDelayGeometry
+  {
+    SphericalDelayGeometry(const mitk::BeamformingSettings::Pointer config, unsigned int inputL)
+      : ElementHeights(inputL), ElementPositions(inputL)
+    {
+      SamplesPerMeter = 1 / (config->GetSpeedOfSound() * config->GetTimeSpacing());
+      for (unsigned int l_s = 0; l_s < inputL; ++l_s)
+      {
+        ElementHeights[l_s] = config->GetElementHeights()[l_s] * SamplesPerMeter;
+        ElementPositions[l_s] = config->GetElementPositions()[l_s] * SamplesPerMeter;
+      }
+    }
 
-  float& inputS = inputDim[1];
-  float& inputL = inputDim[0];
+    float SamplesPerMeter;
+    std::vector<float> ElementHeights;
+    std::vector<float> ElementPositions;
+  };
 
-  float& outputS = outputDim[1];
-  float& outputL = outputDim[0];
+  /** \brief Scratch buffer for the delays of one output sample; kept per thread to avoid allocations in the inner loops
+  */
+  int* GetDelayBuffer(unsigned int size)
+  {
+    thread_local std::vector<int> buffer;
+    if (buffer.size() < size)
+      buffer.resize(size);
+    return buffer.data();
+  }
 
-  short maxLine = 0;
-  short minLine = 0;
-  float l_p = 0;
-  float s_i = 0;
+  float TotalInputSamples(const mitk::BeamformingSettings::Pointer config, float inputS)
+  {
+    float totalSamples_i = (float)(config->GetReconstructionDepth()) / (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
+    return totalSamples_i <= inputS ? totalSamples_i : inputS;
+  }
 
-  float apod_mult = 1;
+  /** \brief Shared implementation of DMAS and signed DMAS for one tile
+  *
+  *  The sum over all pairs of sign(w_1*w_2)*sqrt(|w_1*w_2|) of the apodized, delayed samples w equals
+  *  ((sum r)^2 - sum r^2) / 2 with r = sign(w)*sqrt(|w|), so every output sample costs O(used lines) instead of O(used lines^2).
+  */
+  void DMASSphericalTileImpl(const float* input, float* output, const float inputDim[2], const float outputDim[2],
+    unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd,
+    const mitk::BeamformingSettings::Pointer config, bool useSign)
+  {
+    const float* apodisation = config->GetApodizationFunction();
+    const short apodArraySize = config->GetApodizationArraySize();
+    const unsigned short* minMaxLines = config->GetMinMaxLines();
 
-  float mult = 0;
+    const float inputS = inputDim[1];
+    const int inputL = (int)inputDim[0];
 
-  short usedLines = (maxLine - minLine);
+    const float outputS = outputDim[1];
+    const int outputL = (int)outputDim[0];
 
-  float totalSamples_i = (float)(config->GetReconstructionDepth()) /
-    (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
-  totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
+    const SphericalDelayGeometry geometry(config, inputL);
+    const float totalSamples_i = TotalInputSamples(config, inputS);
+    int* delays = GetDelayBuffer(inputL);
 
-  l_p = (float)line / outputL * config->GetHorizontalExtent();
+    for (unsigned int line = lineBegin; line < lineEnd; ++line)
+    {
+      const float l_p = (float)line / outputL * config->GetHorizontalExtent() * geometry.SamplesPerMeter;
 
-  for (short sample = 0; sample < outputS; ++sample)
-  {
-    s_i = (float)sample / outputS * totalSamples_i;
+      for (unsigned int sample = sampleBegin; sample < sampleEnd; ++sample)
+      {
+        const float s_i = (float)sample / outputS * totalSamples_i;
+        const int ultrasoundOffset = config->GetIsPhotoacousticImage() ? 0 : (int)s_i;
 
-    minLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line];
-    maxLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line + 1];
-    usedLines = (maxLine - minLine);
+        const short minLine = minMaxLines[2 * sample * outputL + 2 * line];
+        const short maxLine = minMaxLines[2 * sample * outputL + 2 * line + 1];
+        short usedLines = (maxLine - minLine);
 
-    apod_mult = (float)apodArraySize / (float)usedLines;
+        const float apod_mult = (float)apodArraySize / (float)usedLines;
 
-    //calculate the AddSamples beforehand to save some time
-    short* AddSample = new short[maxLine - minLine];
-    for (short l_s = 0; l_s < maxLine - minLine; ++l_s)
-    {
-      AddSample[l_s] = (int)sqrt(
-        pow(s_i - elementHeights[l_s + minLine] / (config->GetSpeedOfSound()*config->GetTimeSpacing()), 2)
-        +
-        pow((1 / (config->GetTimeSpacing()*config->GetSpeedOfSound())) * (l_p - elementPositions[l_s + minLine]), 2)
-      ) + (1 - config->GetIsPhotoacousticImage())*s_i;
-    }
+        mitk::BeamformingUtils::CalculateSphericalDelays(delays, geometry.ElementHeights.data(), geometry.ElementPositions.data(),
+        l_p, s_i, ultrasoundOffset, minLine, maxLine);
 
-    float s_1 = 0;
-    float s_2 = 0;
+        double rootSum = 0;
+        double squareSum = 0;
+        float sign = 0;
 
-    for (short l_s1 = minLine; l_s1 < maxLine - 1; ++l_s1)
-    {
-      if (AddSample[l_s1 - minLine] < inputS && AddSample[l_s1 - minLine] >= 0)
-      {
-        for (short l_s2 = l_s1 + 1; l_s2 < maxLine; ++l_s2)
+        for (short l_s = minLine; l_s < maxLine; ++l_s)
         {
-          if (AddSample[l_s2 - minLine] < inputS && AddSample[l_s2 - minLine] >= 0)
+          const int delay = delays[l_s - minLine];
+          if (delay < inputS && delay >= 0)
           {
-            s_2 = input[l_s2 + AddSample[l_s2 - minLine] * (short)inputL];
-            s_1 = input[l_s1 + AddSample[l_s1 - minLine] * (short)inputL];
-
-            mult = s_2 * apodisation[(int)((l_s2 - minLine)*apod_mult)] * s_1 * apodisation[(int)((l_s1 - minLine)*apod_mult)];
-            output[sample*(short)outputL + line] += sqrt(fabs(mult)) * ((mult > 0) - (mult < 0));
+            const float s = input[l_s + delay * inputL];
+            const float weighted = s * apodisation[(int)((l_s - minLine) * apod_mult)];
+            const double root = std::sqrt(std::fabs(weighted)) * ((weighted > 0) - (weighted < 0));
+            rootSum += root;
+            squareSum += root * root;
+
+            if (l_s < maxLine - 1)
+              sign += s;
+          }
+          else if (l_s < maxLine - 1)
+          {
+            --usedLines;
           }
         }
-      }
-      else
-        --usedLines;
-    }
 
-    output[sample*(short)outputL + line] = output[sample*(short)outputL + line] / (float)(pow(usedLines, 2) - (usedLines - 1));
+        float value = (float)((rootSum * rootSum - squareSum) / 2) / (float)(pow(usedLines, 2) - (usedLines - 1));
+        if (useSign)
+          value *= ((sign > 0) - (sign < 0));
 
-    delete[] AddSample;
+        output[sample * outputL + line] = value;
+      }
+    }
   }
 }
 
-void mitk::BeamformingUtils::sDMASSphericalLine(
-  float* input, float* output, float inputDim[2], float outputDim[2],
-  const short& line, const mitk::BeamformingSettings::Pointer config)
+void mitk::BeamformingUtils::DASSphericalTile(
+  const float* input, float* output, const float inputDim[2], const float outputDim[2],
+  unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd,
+  const mitk::BeamformingSettings::Pointer config)
 {
   const float* apodisation = config->GetApodizationFunction();
   const short apodArraySize = config->GetApodizationArraySize();
+  const unsigned short* minMaxLines = config->GetMinMaxLines();
 
-  const float* elementHeights = config->GetElementHeights();
-  const float* elementPositions = config->GetElementPositions();
-
-  float& inputS = inputDim[1];
-  float& inputL = inputDim[0];
-
-  float& outputS = outputDim[1];
-  float& outputL = outputDim[0];
+  const float inputS = inputDim[1];
+  const int inputL = (int)inputDim[0];
 
-  short maxLine = 0;
-  short minLine = 0;
-  float l_p = 0;
-  float s_i = 0;
+  const float outputS = outputDim[1];
+  const int outputL = (int)outputDim[0];
 
-  float apod_mult = 1;
+  const SphericalDelayGeometry geometry(config, inputL);
+  const float totalSamples_i = TotalInputSamples(config, inputS);
+  int* delays = GetDelayBuffer(inputL);
 
-  float mult = 0;
+  for (unsigned int line = lineBegin; line < lineEnd; ++line)
+  {
+    const float l_p = (float)line / outputL * config->GetHorizontalExtent() * geometry.SamplesPerMeter;
 
-  short usedLines = (maxLine - minLine);
+    for (unsigned int sample = sampleBegin; sample < sampleEnd; ++sample)
+    {
+      const float s_i = (float)sample / outputS * totalSamples_i;
+      const int ultrasoundOffset = config->GetIsPhotoacousticImage() ? 0 : (int)s_i;
 
-  float totalSamples_i = (float)(config->GetReconstructionDepth()) /
-    (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
-  totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
+      const short minLine = minMaxLines[2 * sample * outputL + 2 * line];
+      const short maxLine = minMaxLines[2 * sample * outputL + 2 * line + 1];
+      short usedLines = (maxLine - minLine);
 
-  l_p = (float)line / outputL * config->GetHorizontalExtent();
+      const float apod_mult = (float)apodArraySize / (float)usedLines;
 
-  for (short sample = 0; sample < outputS; ++sample)
-  {
-    s_i = (float)sample / outputS * totalSamples_i;
+      mitk::BeamformingUtils::CalculateSphericalDelays(delays, geometry.ElementHeights.data(), geometry.ElementPositions.data(),
+        l_p, s_i, ultrasoundOffset, minLine, maxLine);
 
-    minLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line];
-    maxLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line + 1];
-    usedLines = (maxLine - minLine);
+      float sum = 0;
+      for (short l_s = minLine; l_s < maxLine; ++l_s)
+      {
+        const int delay = delays[l_s - minLine];
+        if (delay < inputS && delay >= 0)
+          sum += input[l_s + delay * inputL] * apodisation[(short)((l_s - minLine) * apod_mult)];
+        else
+          --usedLines;
+      }
+      output[sample * outputL + line] = sum / usedLines;
+    }
+  }
+}
 
-    apod_mult = (float)apodArraySize / (float)usedLines;
+void mitk::BeamformingUtils::DMASSphericalTile(
+  const float* input, float* output, const float inputDim[2], const float outputDim[2],
+  unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd,
+  const mitk::BeamformingSettings::Pointer config)
+{
+  DMASSphericalTileImpl(input, output, inputDim, outputDim, lineBegin, lineEnd, sampleBegin, sampleEnd, config, false);
+}
 
-    //calculate the AddSamples beforehand to save some time
-    short* AddSample = new short[maxLine - minLine];
-    for (short l_s = 0; l_s < maxLine - minLine; ++l_s)
-    {
-      AddSample[l_s] = (int)sqrt(
-        pow(s_i - elementHeights[l_s + minLine] / (config->GetSpeedOfSound()*config->GetTimeSpacing()), 2)
-        +
-        pow((1 / (config->GetTimeSpacing()*config->GetSpeedOfSound())) * (l_p - elementPositions[l_s + minLine]), 2)
-      ) + (1 - config->GetIsPhotoacousticImage())*s_i;
-    }
+void mitk::BeamformingUtils::sDMASSphericalTile(
+  const float* input, float* output, const float inputDim[2], const float outputDim[2],
+  unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd,
+  const mitk::BeamformingSettings::Pointer config)
+{
+  DMASSphericalTileImpl(input, output, inputDim, outputDim, lineBegin, lineEnd, sampleBegin, sampleEnd, config, true);
+}
 
-    float s_1 = 0;
-    float s_2 = 0;
-    float sign = 0;
+namespace
+{
+  /** \brief Shared implementation of DMAS and signed DMAS over a precomputed table, see DMASSphericalTileImpl
+  */
+  void DMASTableTileImpl(const float* input, float* output, const mitk::BeamformingDelayTable* table,
+    unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd, bool useSign)
+  {
+    const mitk::BeamformingDelayTable::Pixel* pixels = table->GetPixels();
+    const mitk::BeamformingDelayTable::Entry* entries = table->GetEntries();
+    const unsigned int outputL = table->GetOutputLines();
 
-    for (short l_s1 = minLine; l_s1 < maxLine - 1; ++l_s1)
+    for (unsigned int sample = sampleBegin; sample < sampleEnd; ++sample)
     {
-      if (AddSample[l_s1 - minLine] < inputS && AddSample[l_s1 - minLine] >= 0)
+      for (unsigned int line = lineBegin; line < lineEnd; ++line)
       {
-        s_1 = input[l_s1 + AddSample[l_s1 - minLine] * (short)inputL];
-        sign += s_1;
+        const auto& pixel = pixels[(std::size_t)sample * outputL + line];
+        const auto* pixelEntries = entries + pixel.Begin;
 
-        for (short l_s2 = l_s1 + 1; l_s2 < maxLine; ++l_s2)
+        double rootSum = 0;
+        double squareSum = 0;
+        for (unsigned short i = 0; i < pixel.ValidLines; ++i)
         {
-          if (AddSample[l_s2 - minLine] < inputS && AddSample[l_s2 - minLine] >= 0)
-          {
-            s_2 = input[l_s2 + AddSample[l_s2 - minLine] * (short)inputL];
+          const float weighted = input[pixelEntries[i].InputOffset] * pixelEntries[i].Weight;
+          const double root = std::sqrt(std::fabs(weighted)) * ((weighted > 0) - (weighted < 0));
+          rootSum += root;
+          squareSum += root * root;
+        }
 
-            mult = s_2 * apodisation[(int)((l_s2 - minLine)*apod_mult)] * s_1 * apodisation[(int)((l_s1 - minLine)*apod_mult)];
-            output[sample*(short)outputL + line] += sqrt(fabs(mult)) * ((mult > 0) - (mult < 0));
-          }
+        const short usedLines = pixel.DMASUsedLines;
+        float value = (float)((rootSum * rootSum - squareSum) / 2) / (float)(pow(usedLines, 2) - (usedLines - 1));
+
+        if (useSign)
+        {
+          // the last element of the pixel does not contribute to the sign; it is part of the entries if it is valid,
+          // which is exactly the case when the DMAS normalization does not count an additional invalid line
+          const unsigned short signLines = (pixel.ValidLines > 0 && pixel.ValidLines == pixel.DMASUsedLines) ? pixel.ValidLines - 1 : pixel.ValidLines;
+          float sign = 0;
+          for (unsigned short i = 0; i < signLines; ++i)
+            sign += input[pixelEntries[i].InputOffset];
+          value *= ((sign > 0) - (sign < 0));
         }
+
+        output[(std::size_t)sample * outputL + line] = value;
       }
-      else
-        --usedLines;
     }
+  }
+}
+
+void mitk::BeamformingUtils::DASTableTile(const float* input, float* output, const mitk::BeamformingDelayTable* table,
+  unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd)
+{
+  const mitk::BeamformingDelayTable::Pixel* pixels = table->GetPixels();
+  const mitk::BeamformingDelayTable::Entry* entries = table->GetEntries();
+  const unsigned int outputL = table->GetOutputLines();
+
+  for (unsigned int sample = sampleBegin; sample < sampleEnd; ++sample)
+  {
+    for (unsigned int line = lineBegin; line < lineEnd; ++line)
+    {
+      const auto& pixel = pixels[(std::size_t)sample * outputL + line];
+      const auto* pixelEntries = entries + pixel.Begin;
 
-    output[sample*(short)outputL + line] = output[sample*(short)outputL + line] / (float)(pow(usedLines, 2) - (usedLines - 1)) * ((sign > 0) - (sign < 0));
+      float sum = 0;
+      for (unsigned short i = 0; i < pixel.ValidLines; ++i)
+        sum += input[pixelEntries[i].InputOffset] * pixelEntries[i].Weight;
 
-    delete[] AddSample;
+      output[(std::size_t)sample * outputL + line] = sum / (short)pixel.ValidLines;
+    }
   }
 }
+
+void mitk::BeamformingUtils::DMASTableTile(const float* input, float* output, const mitk::BeamformingDelayTable* table,
+  unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd)
+{
+  DMASTableTileImpl(input, output, table, lineBegin, lineEnd, sampleBegin, sampleEnd, false);
+}
+
+void mitk::BeamformingUtils::sDMASTableTile(const float* input, float* output, const mitk::BeamformingDelayTable* table,
+  unsigned int lineBegin, unsigned int lineEnd, unsigned int sampleBegin, unsigned int sampleEnd)
+{
+  DMASTableTileImpl(input, output, table, lineBegin, lineEnd, sampleBegin, sampleEnd, true);
+}
+
+void mitk::BeamformingUtils::DASSphericalLine(
+  float* input, float* output, float inputDim[2], float outputDim[2],
+  const short& line, const mitk::BeamformingSettings::Pointer config)
+{
+  DASSphericalTile(input, output, inputDim, outputDim, line, line + 1, 0, (unsigned int)outputDim[1], config);
+}
+
+void mitk::BeamformingUtils::DMASSphericalLine(
+  float* input, float* output, float inputDim[2], float outputDim[2],
+  const short& line, const mitk::BeamformingSettings::Pointer config)
+{
+  DMASSphericalTile(input, output, inputDim, outputDim, line, line + 1, 0, (unsigned int)outputDim[1], config);
+}
+
+void mitk::BeamformingUtils::sDMASSphericalLine(
+  float* input, float* output, float inputDim[2], float outputDim[2],
+  const short& line, const mitk::BeamformingSettings::Pointer config)
+{
+  sDMASSphericalTile(input, output, inputDim, outputDim, line, line + 1, 0, (unsigned int)outputDim[1], config);
+}
@@ -17,5 +17,6 @@ set(MODULE_TESTS
   mitkPAFilterServiceTest.cpp
   mitkCastToFloatImageFilterTest.cpp
   mitkCropImageFilterTest.cpp
+  mitkBeamformingUtilsTest.cpp
   )
 set(RESOURCE_FILES)
@@ -0,0 +1,488 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+#include <mitkBeamformingUtils.h>
+#include <mitkBeamformingThreadPool.h>
+#include <mitkBeamformingDelayTable.h>
+#include <mitkBeamformingFilter.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class mitkBeamformingUtilsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBeamformingUtilsTestSuite);
+  MITK_TEST(testDMASTileMatchesPairwiseSum);
+  MITK_TEST(testTilesMatchLines);
+  MITK_TEST(testDelayTableMatchesSphericalDelays);
+  MITK_TEST(testDelayTableIsReused);
+  MITK_TEST(testDelayTableRespectsMemoryLimit);
+  MITK_TEST(testFilterToleratesMismatchingInputDim);
+  MITK_TEST(testThreadPoolProcessesAllTiles);
+  MITK_TEST(testThreadPoolIsReleasedByLastUser);
+  MITK_TEST(benchmarkThreadPoolAgainstThreadPerLine);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  const unsigned int SAMPLES = 1024;
+  const unsigned int ELEMENTS = 64;
+  const unsigned int RECONSTRUCTED_SAMPLES = 256;
+  const unsigned int RECONSTRUCTED_LINES = 64;
+  const float SPEED_OF_SOUND = 1540; // m/s
+  const float PITCH = 0.0003f; // m
+  const float TIME_SPACING = 0.00625f / 2 / 1000000; // s
+  const unsigned int BENCHMARK_FRAMES = 20;
+
+  unsigned int m_InputDim[3];
+  std::vector<float> m_Input;
+
+public:
+
+  void setUp() override
+  {
+    m_InputDim[0] = ELEMENTS;
+    m_InputDim[1] = SAMPLES;
+    m_InputDim[2] = 1;
+
+    std::default_random_engine randGen(42);
+    std::normal_distribution<float> randDistr(0.f, 100.f);
+    m_Input.resize(ELEMENTS * SAMPLES);
+    for (auto& value : m_Input)
+      value = randDistr(randGen);
+  }
+
+  void tearDown() override
+  {
+    m_Input.clear();
+  }
+
+  mitk::BeamformingSettings::Pointer createConfig(mitk::BeamformingSettings::BeamformingAlgorithm alg)
+  {
+    return mitk::BeamformingSettings::New(PITCH,
+      SPEED_OF_SOUND,
+      TIME_SPACING,
+      27.f,
+      true,
+      RECONSTRUCTED_SAMPLES,
+      RECONSTRUCTED_LINES,
+      m_InputDim,
+      SPEED_OF_SOUND * TIME_SPACING * SAMPLES,
+      false,
+      16,
+      mitk::BeamformingSettings::Apodization::Hann,
+      ELEMENTS * 2,
+      alg,
+      mitk::BeamformingSettings::ProbeGeometry::Linear,
+      0.f);
+  }
+
+  /** Straightforward O(lines^2) DMAS as it was implemented before the tiled kernels. */
+  std::vector<float> referenceDMAS(mitk::BeamformingSettings::Pointer config)
+  {
+    std::vector<float> output(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    const float samplesPerMeter = 1 / (SPEED_OF_SOUND * TIME_SPACING);
+    float totalSamples_i = config->GetReconstructionDepth() * samplesPerMeter;
+    totalSamples_i = totalSamples_i <= SAMPLES ? totalSamples_i : SAMPLES;
+
+    for (unsigned int line = 0; line < RECONSTRUCTED_LINES; ++line)
+    {
+      float l_p = (float)line / RECONSTRUCTED_LINES * config->GetHorizontalExtent() * samplesPerMeter;
+      for (unsigned int sample = 0; sample < RECONSTRUCTED_SAMPLES; ++sample)
+      {
+        float s_i = (float)sample / RECONSTRUCTED_SAMPLES * totalSamples_i;
+        short minLine = config->GetMinMaxLines()[2 * sample * RECONSTRUCTED_LINES + 2 * line];
+        short maxLine = config->GetMinMaxLines()[2 * sample * RECONSTRUCTED_LINES + 2 * line + 1];
+        short usedLines = maxLine - minLine;
+        float apod_mult = (float)config->GetApodizationArraySize() / (float)usedLines;
+
+        std::vector<int> delays(usedLines);
+        for (short l_s = minLine; l_s < maxLine; ++l_s)
+        {
+          float dy = s_i - config->GetElementHeights()[l_s] * samplesPerMeter;
+          float dx = l_p - config->GetElementPositions()[l_s] * samplesPerMeter;
+          delays[l_s - minLine] = (int)std::sqrt(dy * dy + dx * dx);
+        }
+
+        double sum = 0;
+        for (short l_s1 = minLine; l_s1 < maxLine - 1; ++l_s1)
+        {
+          int d1 = delays[l_s1 - minLine];
+          if (d1 < (int)SAMPLES && d1 >= 0)
+          {
+            for (short l_s2 = l_s1 + 1; l_s2 < maxLine; ++l_s2)
+            {
+              int d2 = delays[l_s2 - minLine];
+              if (d2 < (int)SAMPLES && d2 >= 0)
+              {
+                float mult = m_Input[l_s2 + d2 * ELEMENTS] * config->GetApodizationFunction()[(int)((l_s2 - minLine) * apod_mult)] *
+                  m_Input[l_s1 + d1 * ELEMENTS] * config->GetApodizationFunction()[(int)((l_s1 - minLine) * apod_mult)];
+                sum += std::sqrt(std::fabs(mult)) * ((mult > 0) - (mult < 0));
+              }
+            }
+          }
+          else
+            --usedLines;
+        }
+        output[sample * RECONSTRUCTED_LINES + line] = (float)(sum / (std::pow(usedLines, 2) - (usedLines - 1)));
+      }
+    }
+    return output;
+  }
+
+  /** The DMAS line kernel as it was implemented before the tiled kernels, used as the benchmark baseline. */
+  static void baselineDMASSphericalLine(float* input, float* output, float inputDim[2], float outputDim[2],
+    const short& line, const mitk::BeamformingSettings::Pointer config)
+  {
+    const float* apodisation = config->GetApodizationFunction();
+    const short apodArraySize = config->GetApodizationArraySize();
+
+    const float* elementHeights = config->GetElementHeights();
+    const float* elementPositions = config->GetElementPositions();
+
+    float& inputS = inputDim[1];
+    float& inputL = inputDim[0];
+
+    float& outputS = outputDim[1];
+    float& outputL = outputDim[0];
+
+    float totalSamples_i = (float)(config->GetReconstructionDepth()) /
+      (float)(config->GetSpeedOfSound() * config->GetTimeSpacing());
+    totalSamples_i = totalSamples_i <= inputS ? totalSamples_i : inputS;
+
+    float l_p = (float)line / outputL * config->GetHorizontalExtent();
+
+    for (short sample = 0; sample < outputS; ++sample)
+    {
+      float s_i = (float)sample / outputS * totalSamples_i;
+
+      short minLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line];
+      short maxLine = config->GetMinMaxLines()[2 * sample*(short)outputL + 2 * line + 1];
+      short usedLines = (maxLine - minLine);
+
+      float apod_mult = (float)apodArraySize / (float)usedLines;
+
+      short* AddSample = new short[maxLine - minLine];
+      for (short l_s = 0; l_s < maxLine - minLine; ++l_s)
+      {
+        AddSample[l_s] = (int)sqrt(
+          pow(s_i - elementHeights[l_s + minLine] / (config->GetSpeedOfSound()*config->GetTimeSpacing()), 2)
+          +
+          pow((1 / (config->GetTimeSpacing()*config->GetSpeedOfSound())) * (l_p - elementPositions[l_s + minLine]), 2)
+        ) + (1 - config->GetIsPhotoacousticImage())*s_i;
+      }
+
+      output[sample*(short)outputL + line] = 0;
+      for (short l_s1 = minLine; l_s1 < maxLine - 1; ++l_s1)
+      {
+        if (AddSample[l_s1 - minLine] < inputS && AddSample[l_s1 - minLine] >= 0)
+        {
+          for (short l_s2 = l_s1 + 1; l_s2 < maxLine; ++l_s2)
+          {
+            if (AddSample[l_s2 - minLine] < inputS && AddSample[l_s2 - minLine] >= 0)
+            {
+              float s_2 = input[l_s2 + AddSample[l_s2 - minLine] * (short)inputL];
+              float s_1 = input[l_s1 + AddSample[l_s1 - minLine] * (short)inputL];
+
+              float mult = s_2 * apodisation[(int)((l_s2 - minLine)*apod_mult)] * s_1 * apodisation[(int)((l_s1 - minLine)*apod_mult)];
+              output[sample*(short)outputL + line] += sqrt(fabs(mult)) * ((mult > 0) - (mult < 0));
+            }
+          }
+        }
+        else
+          --usedLines;
+      }
+
+      output[sample*(short)outputL + line] = output[sample*(short)outputL + line] / (float)(pow(usedLines, 2) - (usedLines - 1));
+
+      delete[] AddSample;
+    }
+  }
+
+  /** The reconstruction as it was done before the thread pool: the baseline kernel on one new thread per line. */
+  void beamformBaseline(mitk::BeamformingSettings::Pointer config, float* output)
+  {
+    float inputDim[2] = { (float)ELEMENTS, (float)SAMPLES };
+    float outputDim[2] = { (float)RECONSTRUCTED_LINES, (float)RECONSTRUCTED_SAMPLES };
+    config->GetMinMaxLines();
+
+    std::vector<std::thread> threads;
+    for (short line = 0; line < (short)RECONSTRUCTED_LINES; ++line)
+    {
+      threads.emplace_back(&baselineDMASSphericalLine, m_Input.data(), output, inputDim, outputDim, line, config);
+    }
+    for (auto& thread : threads)
+      thread.join();
+  }
+
+  void beamformWithThreadPool(mitk::BeamformingSettings::Pointer config, float* output)
+  {
+    float inputDim[2] = { (float)ELEMENTS, (float)SAMPLES };
+    float outputDim[2] = { (float)RECONSTRUCTED_LINES, (float)RECONSTRUCTED_SAMPLES };
+    config->GetMinMaxLines();
+
+    const unsigned int linesPerTile = 8;
+    const unsigned int lineTiles = RECONSTRUCTED_LINES / linesPerTile;
+    mitk::BeamformingThreadPool::GetInstance()->ParallelFor(lineTiles, [&](unsigned int tile)
+    {
+      mitk::BeamformingUtils::DMASSphericalTile(m_Input.data(), output, inputDim, outputDim,
+        tile * linesPerTile, (tile + 1) * linesPerTile, 0, RECONSTRUCTED_SAMPLES, config);
+    });
+  }
+
+  void beamformWithThreadPerLine(mitk::BeamformingSettings::Pointer config, float* output)
+  {
+    float inputDim[2] = { (float)ELEMENTS, (float)SAMPLES };
+    float outputDim[2] = { (float)RECONSTRUCTED_LINES, (float)RECONSTRUCTED_SAMPLES };
+    config->GetMinMaxLines();
+
+    std::vector<std::thread> threads;
+    for (short line = 0; line < (short)RECONSTRUCTED_LINES; ++line)
+    {
+      threads.emplace_back(&mitk::BeamformingUtils::DMASSphericalLine, m_Input.data(), output, inputDim, outputDim, line, config);
+    }
+    for (auto& thread : threads)
+      thread.join();
+  }
+
+  void testDMASTileMatchesPairwiseSum()
+  {
+    auto config = createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DMAS);
+    std::vector<float> reference = referenceDMAS(config);
+
+    std::vector<float> output(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    beamformWithThreadPool(config, output.data());
+
+    for (unsigned int i = 0; i < output.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("DMAS tile result differs from pairwise reference at pixel " + std::to_string(i),
+        std::fabs(output[i] - reference[i]) <= 1e-3f * (1.f + std::fabs(reference[i])));
+    }
+  }
+
+  void testTilesMatchLines()
+  {
+    float inputDim[2] = { (float)ELEMENTS, (float)SAMPLES };
+    float outputDim[2] = { (float)RECONSTRUCTED_LINES, (float)RECONSTRUCTED_SAMPLES };
+
+    auto config = createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DAS);
+    config->GetMinMaxLines();
+
+    std::vector<float> byLine(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    std::vector<float> byTile(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+
+    for (short line = 0; line < (short)RECONSTRUCTED_LINES; ++line)
+      mitk::BeamformingUtils::DASSphericalLine(m_Input.data(), byLine.data(), inputDim, outputDim, line, config);
+
+    // odd tile sizes to cover partial tiles at the image borders
+    for (unsigned int lineBegin = 0; lineBegin < RECONSTRUCTED_LINES; lineBegin += 7)
+    {
+      for (unsigned int sampleBegin = 0; sampleBegin < RECONSTRUCTED_SAMPLES; sampleBegin += 100)
+      {
+        mitk::BeamformingUtils::DASSphericalTile(m_Input.data(), byTile.data(), inputDim, outputDim,
+          lineBegin, std::min(lineBegin + 7, RECONSTRUCTED_LINES),
+          sampleBegin, std::min(sampleBegin + 100, RECONSTRUCTED_SAMPLES), config);
+      }
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("DAS tiles and lines differ", byLine == byTile);
+  }
+
+  void compareTableWithSpherical(mitk::BeamformingSettings::BeamformingAlgorithm alg)
+  {
+    float inputDim[2] = { (float)ELEMENTS, (float)SAMPLES };
+    float outputDim[2] = { (float)RECONSTRUCTED_LINES, (float)RECONSTRUCTED_SAMPLES };
+
+    auto config = createConfig(alg);
+    auto table = mitk::BeamformingDelayTable::GetTable(config);
+
+    std::vector<float> spherical(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    std::vector<float> tabled(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+
+    switch (alg)
+    {
+    case mitk::BeamformingSettings::BeamformingAlgorithm::DAS:
+      mitk::BeamformingUtils::DASSphericalTile(m_Input.data(), spherical.data(), inputDim, outputDim, 0, RECONSTRUCTED_LINES, 0, RECONSTRUCTED_SAMPLES, config);
+      mitk::BeamformingUtils::DASTableTile(m_Input.data(), tabled.data(), table, 0, RECONSTRUCTED_LINES, 0, RECONSTRUCTED_SAMPLES);
+      break;
+    case mitk::BeamformingSettings::BeamformingAlgorithm::DMAS:
+      mitk::BeamformingUtils::DMASSphericalTile(m_Input.data(), spherical.data(), inputDim, outputDim, 0, RECONSTRUCTED_LINES, 0, RECONSTRUCTED_SAMPLES, config);
+      mitk::BeamformingUtils::DMASTableTile(m_Input.data(), tabled.data(), table, 0, RECONSTRUCTED_LINES, 0, RECONSTRUCTED_SAMPLES);
+      break;
+    case mitk::BeamformingSettings::BeamformingAlgorithm::sDMAS:
+      mitk::BeamformingUtils::sDMASSphericalTile(m_Input.data(), spherical.data(), inputDim, outputDim, 0, RECONSTRUCTED_LINES, 0, RECONSTRUCTED_SAMPLES, config);
+      mitk::BeamformingUtils::sDMASTableTile(m_Input.data(), tabled.data(), table, 0, RECONSTRUCTED_LINES, 0, RECONSTRUCTED_SAMPLES);
+      break;
+    }
+
+    for (unsigned int i = 0; i < spherical.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Table based result differs from spherical delays at pixel " + std::to_string(i),
+        std::fabs(spherical[i] - tabled[i]) <= 1e-4f * (1.f + std::fabs(spherical[i])));
+    }
+  }
+
+  void testDelayTableMatchesSphericalDelays()
+  {
+    compareTableWithSpherical(mitk::BeamformingSettings::BeamformingAlgorithm::DAS);
+    compareTableWithSpherical(mitk::BeamformingSettings::BeamformingAlgorithm::DMAS);
+    compareTableWithSpherical(mitk::BeamformingSettings::BeamformingAlgorithm::sDMAS);
+  }
+
+  void testDelayTableIsReused()
+  {
+    auto table = mitk::BeamformingDelayTable::GetTable(createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DAS));
+    // a different algorithm does not change the delays
+    CPPUNIT_ASSERT(table == mitk::BeamformingDelayTable::GetTable(createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DMAS)));
+
+    m_InputDim[1] = SAMPLES / 2;
+    CPPUNIT_ASSERT(table != mitk::BeamformingDelayTable::GetTable(createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DAS)));
+  }
+
+  /** Runs the beamforming filter on the random input with the given settings. */
+  std::vector<float> beamformWithFilter(mitk::BeamformingSettings::Pointer config)
+  {
+    mitk::Image::Pointer inputImage = mitk::Image::New();
+    unsigned int dimension[3]{ ELEMENTS, SAMPLES, 1 };
+    inputImage->Initialize(mitk::MakeScalarPixelType<float>(), 3, dimension);
+    inputImage->SetImportVolume((const void*)m_Input.data(), mitk::Image::CopyMemory);
+
+    auto filter = mitk::BeamformingFilter::New(config);
+    filter->SetInput(inputImage);
+    filter->Update();
+
+    mitk::ImageReadAccessor readAccess(filter->GetOutput());
+    const float* outputData = (const float*)readAccess.GetData();
+    return std::vector<float>(outputData, outputData + RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES);
+  }
+
+  std::vector<float> beamformSpherical(mitk::BeamformingSettings::Pointer config)
+  {
+    float inputDim[2] = { (float)ELEMENTS, (float)SAMPLES };
+    float outputDim[2] = { (float)RECONSTRUCTED_LINES, (float)RECONSTRUCTED_SAMPLES };
+
+    std::vector<float> output(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    mitk::BeamformingUtils::DASSphericalTile(m_Input.data(), output.data(), inputDim, outputDim, 0, RECONSTRUCTED_LINES, 0, RECONSTRUCTED_SAMPLES, config);
+    return output;
+  }
+
+  void testDelayTableRespectsMemoryLimit()
+  {
+    auto config = createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DAS);
+    const std::size_t limit = mitk::BeamformingDelayTable::GetMaximumMemorySize();
+    const std::size_t estimate = mitk::BeamformingDelayTable::EstimateMemorySize(config);
+    CPPUNIT_ASSERT(estimate >= RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES * sizeof(mitk::BeamformingDelayTable::Pixel));
+
+    mitk::BeamformingDelayTable::SetMaximumMemorySize(estimate - 1);
+    CPPUNIT_ASSERT_MESSAGE("Table exceeding the memory limit was built", mitk::BeamformingDelayTable::GetTable(config).IsNull());
+    // the filter falls back to calculating the delays per pixel
+    CPPUNIT_ASSERT_MESSAGE("Fallback differs from spherical delays", beamformWithFilter(config) == beamformSpherical(config));
+
+    mitk::BeamformingDelayTable::SetMaximumMemorySize(estimate);
+    CPPUNIT_ASSERT_MESSAGE("Table within the memory limit was not built", mitk::BeamformingDelayTable::GetTable(config).IsNotNull());
+    mitk::BeamformingDelayTable::SetMaximumMemorySize(limit);
+  }
+
+  void testFilterToleratesMismatchingInputDim()
+  {
+    // settings which do not describe the input are tolerated as before the delay table, the actual input dimensions are used
+    m_InputDim[1] = SAMPLES * 2;
+    auto config = createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DAS);
+
+    std::vector<float> output;
+    CPPUNIT_ASSERT_NO_THROW(output = beamformWithFilter(config));
+    CPPUNIT_ASSERT_MESSAGE("Mismatching input differs from spherical delays", output == beamformSpherical(config));
+  }
+
+  void testThreadPoolProcessesAllTiles()
+  {
+    const unsigned int numberOfTiles = 1000;
+    std::vector<unsigned int> processed(numberOfTiles, 0);
+    auto threadPool = mitk::BeamformingThreadPool::GetInstance();
+
+    for (unsigned int run = 0; run < 10; ++run)
+    {
+      threadPool->ParallelFor(numberOfTiles, [&processed](unsigned int tile) { ++processed[tile]; });
+    }
+
+    for (unsigned int tile = 0; tile < numberOfTiles; ++tile)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Tile " + std::to_string(tile) + " not processed exactly once per run", 10u, processed[tile]);
+    }
+
+    CPPUNIT_ASSERT_THROW(threadPool->ParallelFor(numberOfTiles,
+      [](unsigned int tile) { if (tile == 500) throw std::runtime_error("tile failed"); }), std::runtime_error);
+  }
+
+  void testThreadPoolIsReleasedByLastUser()
+  {
+    std::weak_ptr<mitk::BeamformingThreadPool> released;
+    {
+      auto threadPool = mitk::BeamformingThreadPool::GetInstance();
+      CPPUNIT_ASSERT_MESSAGE("Users do not share the pool", threadPool == mitk::BeamformingThreadPool::GetInstance());
+      threadPool->ParallelFor(100, [](unsigned int) {});
+      released = threadPool;
+    }
+    CPPUNIT_ASSERT_MESSAGE("Pool not destroyed by its last user", released.expired());
+
+    auto threadPool = mitk::BeamformingThreadPool::GetInstance();
+    std::vector<unsigned int> processed(100, 0);
+    threadPool->ParallelFor(100, [&processed](unsigned int tile) { ++processed[tile]; });
+    CPPUNIT_ASSERT_MESSAGE("Recreated pool does not process all tiles", processed == std::vector<unsigned int>(100, 1));
+  }
+
+  void benchmarkThreadPoolAgainstThreadPerLine()
+  {
+    auto config = createConfig(mitk::BeamformingSettings::BeamformingAlgorithm::DMAS);
+    std::vector<float> baselineOutput(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    std::vector<float> output(RECONSTRUCTED_LINES * RECONSTRUCTED_SAMPLES, 0.f);
+    auto threadPool = mitk::BeamformingThreadPool::GetInstance();
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (unsigned int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+      beamformBaseline(config, baselineOutput.data());
+    auto baseline = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    begin = std::chrono::high_resolution_clock::now();
+    for (unsigned int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+      beamformWithThreadPerLine(config, output.data());
+    auto threadPerLine = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    begin = std::chrono::high_resolution_clock::now();
+    for (unsigned int frame = 0; frame < BENCHMARK_FRAMES; ++frame)
+      beamformWithThreadPool(config, output.data());
+    auto pool = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    // the compared implementations have to compute the same image
+    for (unsigned int i = 0; i < output.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Tiled DMAS differs from the baseline at pixel " + std::to_string(i),
+        std::fabs(output[i] - baselineOutput[i]) <= 1e-3f * (1.f + std::fabs(baselineOutput[i])));
+    }
+
+    MITK_INFO << "DMAS " << RECONSTRUCTED_LINES << "x" << RECONSTRUCTED_SAMPLES << ": baseline (pairwise kernel, one thread per line) "
+      << BENCHMARK_FRAMES / baseline << " frames/s, tiled kernel with one thread per line "
+      << BENCHMARK_FRAMES / threadPerLine << " frames/s, tiled kernel on thread pool with "
+      << threadPool->GetNumberOfThreads() << " threads " << BENCHMARK_FRAMES / pool << " frames/s, speedup "
+      << baseline / pool;
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBeamformingUtils)
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperationApplier.h"
 
 #include "mitkDiffSliceOperation.h"
+#include "mitkLabelSetImage.h"
 #include "mitkRenderingManager.h"
 #include "mitkSegTool2D.h"
 #include <mitkExtractSliceFilter.h>
@@ -40,6 +41,11 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
   // chak if the operation is valid
   if (imageOperation->IsValid())
   {
+    // only the voxels of the written slice have to be updated in the label index
+    auto *labelSetImage = dynamic_cast<LabelSetImage *>(imageOperation->GetImage());
+    if (labelSetImage != nullptr)
+      labelSetImage->BeginLabelIndexUpdate(dynamic_cast<PlaneGeometry *>(imageOperation->GetWorldGeometry()));
+
     // the actual overwrite filter (vtk)
     vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
@@ -66,6 +72,9 @@ void mitk::DiffSliceOperationApplier::ExecuteOperation(Operation *operation)
     RenderingManager::GetInstance()->RequestUpdateAll();
     imageOperation->GetImage()->Modified();
 
+    if (labelSetImage != nullptr)
+      labelSetImage->EndLabelIndexUpdate();
+
     mitk::ExtractSliceFilter::Pointer extractor2 = mitk::ExtractSliceFilter::New();
     extractor2->SetInput(imageOperation->GetImage());
     extractor2->SetTimeStep(imageOperation->GetTimeStep());
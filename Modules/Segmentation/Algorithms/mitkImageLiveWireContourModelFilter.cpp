@@ -18,7 +18,17 @@ found in the LICENSE file.
 
 #include "mitkIOUtil.h"
 
+namespace
+{
+  // number of pixels closed by the distance map computation between two checks of the waiting updates
+  const itk::NodeNumType NumberOfNodesPerStep = 4096;
+}
+
 mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
+  : m_StopDistanceMapComputation(false),
+    m_DistanceMapValid(false),
+    m_DistanceMapComplete(false),
+    m_DistanceMapUsesDynamicCostMap(false)
 {
   OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
   this->SetNumberOfRequiredInputs(1);
@@ -29,10 +39,18 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   m_ShortestPathFilter->SetCostFunction(m_CostFunction);
   m_UseDynamicCostMap = false;
   m_TimeStep = 0;
+
+  m_UseDistanceMap = false;
+  m_DistanceMapFilter = ShortestPathImageFilterType::New();
+  m_DistanceMapFilter->SetCostFunction(m_CostFunction);
+  m_DistanceMapFilter->SetFullNeighborsMode(true);
+  m_DistanceMapFilter->SetMakeOutputImage(false);
+  m_DistanceMapStartIndex.Fill(0);
 }
 
 mitk::ImageLiveWireContourModelFilter::~ImageLiveWireContourModelFilter()
 {
+  this->StopDistanceMapComputation();
 }
 
 mitk::ImageLiveWireContourModelFilter::OutputType *mitk::ImageLiveWireContourModelFilter::GetOutput()
@@ -54,6 +72,8 @@ void mitk::ImageLiveWireContourModelFilter::SetInput(unsigned int idx,
   }
   if (input != static_cast<InputType *>(this->ProcessObject::GetInput(idx)))
   {
+    this->StopDistanceMapComputation();
+
     this->ProcessObject::SetNthInput(idx, const_cast<InputType *>(input));
     this->Modified();
 
@@ -126,15 +146,18 @@ void mitk::ImageLiveWireContourModelFilter::ItkPreProcessImage(const itk::Image<
   m_InternalImage = castFilter->GetOutput();
   m_CostFunction->SetImage(m_InternalImage);
   m_ShortestPathFilter->SetInput(m_InternalImage);
+  m_DistanceMapFilter->SetInput(m_InternalImage);
 }
 
 void mitk::ImageLiveWireContourModelFilter::ClearRepulsivePoints()
 {
+  this->StopDistanceMapComputation();
   m_CostFunction->ClearRepulsivePoints();
 }
 
 void mitk::ImageLiveWireContourModelFilter::AddRepulsivePoint(const itk::Index<2> &idx)
 {
+  this->StopDistanceMapComputation();
   m_CostFunction->AddRepulsivePoint(idx);
 }
 
@@ -148,11 +171,13 @@ void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
 
 void mitk::ImageLiveWireContourModelFilter::RemoveRepulsivePoint(const itk::Index<2> &idx)
 {
+  this->StopDistanceMapComputation();
   m_CostFunction->RemoveRepulsivePoint(idx);
 }
 
 void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPathType &points)
 {
+  this->StopDistanceMapComputation();
   m_CostFunction->ClearRepulsivePoints();
 
   auto iter = points.begin();
@@ -164,7 +189,6 @@ void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPat
 
 void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
 {
-  // compute the requested region for itk filters
   InternalImageType::IndexType startPoint, endPoint;
 
   startPoint[0] = m_StartPointInIndex[0];
@@ -173,6 +197,58 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   endPoint[0] = m_EndPointInIndex[0];
   endPoint[1] = m_EndPointInIndex[1];
 
+  ShortestPathType shortestPath;
+
+  // a new start point starts a new distance map, a changed setting of the dynamic cost map does not
+  if (m_UseDistanceMap && (!m_DistanceMapValid || m_DistanceMapStartIndex != startPoint))
+    this->StartDistanceMapComputation();
+
+  if (m_UseDistanceMap && m_DistanceMapValid && m_DistanceMapStartIndex == startPoint &&
+      m_DistanceMapUsesDynamicCostMap == m_UseDynamicCostMap)
+  {
+    // wait until the computation has reached the end point, the path to a closed pixel is final
+    std::unique_lock<std::mutex> lock(m_DistanceMapMutex);
+    m_DistanceMapProgress.wait(
+      lock, [&]() { return m_DistanceMapComplete || m_DistanceMapFilter->IsClosed(endPoint); });
+
+    shortestPath = m_DistanceMapFilter->GetPathTo(endPoint);
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(m_DistanceMapMutex);
+    shortestPath = this->SearchShortestPath(startPoint, endPoint);
+  }
+
+  // fill the output contour with control points from the path
+  OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
+  this->SetNthOutput(0, output.GetPointer());
+
+  //  OutputType::Pointer output = dynamic_cast<OutputType*> ( this->GetOutput() );
+  output->Expand(m_TimeStep + 1);
+
+  //  output->Clear();
+
+  mitk::Image::ConstPointer input = dynamic_cast<const mitk::Image *>(this->GetInput());
+
+  ShortestPathType::const_iterator pathIterator = shortestPath.begin();
+
+  while (pathIterator != shortestPath.end())
+  {
+    mitk::Point3D currentPoint;
+    currentPoint[0] = static_cast<mitk::ScalarType>((*pathIterator)[0]);
+    currentPoint[1] = static_cast<mitk::ScalarType>((*pathIterator)[1]);
+    currentPoint[2] = 0.0;
+
+    input->GetGeometry()->IndexToWorld(currentPoint, currentPoint);
+    output->AddVertex(currentPoint, false, m_TimeStep);
+
+    pathIterator++;
+  }
+}
+
+mitk::ImageLiveWireContourModelFilter::ShortestPathType mitk::ImageLiveWireContourModelFilter::SearchShortestPath(
+  const InternalImageType::IndexType &startPoint, const InternalImageType::IndexType &endPoint)
+{
   // minimum value in each direction for startRegion
   InternalImageType::IndexType startRegion;
   startRegion[0] = startPoint[0] < endPoint[0] ? startPoint[0] : endPoint[0];
@@ -207,34 +283,103 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
 
   m_ShortestPathFilter->Update();
 
-  // construct contour from path image
   // get the shortest path as vector
-  ShortestPathType shortestPath = m_ShortestPathFilter->GetVectorPath();
+  return m_ShortestPathFilter->GetVectorPath();
+}
 
-  // fill the output contour with control points from the path
-  OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
-  this->SetNthOutput(0, output.GetPointer());
+bool mitk::ImageLiveWireContourModelFilter::GetStartIndex(InternalImageType::IndexType &startIndex)
+{
+  mitk::Image::ConstPointer input = dynamic_cast<const mitk::Image *>(this->GetInput());
 
-  //  OutputType::Pointer output = dynamic_cast<OutputType*> ( this->GetOutput() );
-  output->Expand(m_TimeStep + 1);
+  if (input.IsNull() || input->GetDimension() != 2 || m_InternalImage.IsNull())
+    return false;
 
-  //  output->Clear();
+  mitk::Point3D startPointInIndex;
+  input->GetGeometry()->WorldToIndex(m_StartPoint, startPointInIndex);
 
-  mitk::Image::ConstPointer input = dynamic_cast<const mitk::Image *>(this->GetInput());
+  if (!input->GetGeometry()->IsIndexInside(startPointInIndex))
+    return false;
 
-  ShortestPathType::const_iterator pathIterator = shortestPath.begin();
+  startIndex[0] = startPointInIndex[0];
+  startIndex[1] = startPointInIndex[1];
+  return true;
+}
 
-  while (pathIterator != shortestPath.end())
+void mitk::ImageLiveWireContourModelFilter::StartDistanceMapComputation()
+{
+  InternalImageType::IndexType startIndex;
+  if (!this->GetStartIndex(startIndex))
+    return;
+
+  if (m_DistanceMapValid && m_DistanceMapStartIndex == startIndex &&
+      m_DistanceMapUsesDynamicCostMap == m_UseDynamicCostMap)
+    return;
+
+  this->StopDistanceMapComputation();
+
+  m_DistanceMapStartIndex = startIndex;
+  m_DistanceMapUsesDynamicCostMap = m_UseDynamicCostMap;
+
+  // the search is initialized before the thread is started, thus waiting updates never see the former map
+  m_CostFunction->SetStartIndex(startIndex);
+  m_CostFunction->SetEndIndex(startIndex);
+  m_CostFunction->SetUseCostMap(m_DistanceMapUsesDynamicCostMap);
+  m_DistanceMapFilter->SetStartIndex(startIndex);
+  m_DistanceMapFilter->SetEndIndex(startIndex);
+  m_DistanceMapFilter->InitializeSingleSourceSearch();
+
+  m_DistanceMapComplete = false;
+  m_DistanceMapValid = true;
+  m_DistanceMapThread = std::thread(&ImageLiveWireContourModelFilter::ComputeDistanceMap, this);
+}
+
+void mitk::ImageLiveWireContourModelFilter::StopDistanceMapComputation()
+{
+  m_StopDistanceMapComputation = true;
+
+  if (m_DistanceMapThread.joinable())
+    m_DistanceMapThread.join();
+
+  m_StopDistanceMapComputation = false;
+  m_DistanceMapValid = false;
+  m_DistanceMapComplete = false;
+}
+
+bool mitk::ImageLiveWireContourModelFilter::WaitForDistanceMap()
+{
+  if (!m_DistanceMapValid)
+    return false;
+
+  std::unique_lock<std::mutex> lock(m_DistanceMapMutex);
+  m_DistanceMapProgress.wait(lock, [this]() { return m_DistanceMapComplete; });
+  return true;
+}
+
+bool mitk::ImageLiveWireContourModelFilter::IsDistanceMapComplete()
+{
+  if (!m_DistanceMapValid)
+    return false;
+
+  std::lock_guard<std::mutex> lock(m_DistanceMapMutex);
+  return m_DistanceMapComplete;
+}
+
+void mitk::ImageLiveWireContourModelFilter::ComputeDistanceMap()
+{
+  bool complete = false;
+
+  while (!complete && !m_StopDistanceMapComputation)
   {
-    mitk::Point3D currentPoint;
-    currentPoint[0] = static_cast<mitk::ScalarType>((*pathIterator)[0]);
-    currentPoint[1] = static_cast<mitk::ScalarType>((*pathIterator)[1]);
-    currentPoint[2] = 0.0;
+    {
+      std::lock_guard<std::mutex> lock(m_DistanceMapMutex);
 
-    input->GetGeometry()->IndexToWorld(currentPoint, currentPoint);
-    output->AddVertex(currentPoint, false, m_TimeStep);
+      // direct searches in between may have changed the cost function
+      m_CostFunction->SetUseCostMap(m_DistanceMapUsesDynamicCostMap);
+      complete = m_DistanceMapFilter->ContinueSingleSourceSearch(NumberOfNodesPerStep);
+      m_DistanceMapComplete = complete;
+    }
 
-    pathIterator++;
+    m_DistanceMapProgress.notify_all();
   }
 }
 
@@ -244,6 +389,9 @@ bool mitk::ImageLiveWireContourModelFilter::CreateDynamicCostMap(mitk::ContourMo
   if (!input)
     return false;
 
+  // the costs change, thus the distance map is outdated
+  this->StopDistanceMapComputation();
+
   try
   {
     AccessFixedDimensionByItk_1(input, CreateDynamicCostMapByITK, 2, path);
@@ -25,6 +25,11 @@ found in the LICENSE file.
 #include <itkShortestPathCostFunctionLiveWire.h>
 #include <itkShortestPathImageFilter.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace mitk
 {
   /**
@@ -43,6 +48,11 @@ namespace mitk
    contour
    at a specific timestep.
 
+   For interactive use with a fixed start point, the filter can compute a distance map of the start point
+   (see SetUseDistanceMap). The map holds the shortest paths from the start point to all pixels and is computed
+   once per start point in a background thread. An update then only waits until the computation has reached the
+   end point and traces the path back, instead of searching it again.
+
    \ingroup ContourModelFilters
    \ingroup Process
   */
@@ -82,6 +92,29 @@ namespace mitk
     itkSetMacro(TimeStep, unsigned int);
     itkGetMacro(TimeStep, unsigned int);
 
+    /** \brief Use a distance map of the start point to compute the LiveWire contour (default false).
+    The computation of the map starts with StartDistanceMapComputation() or with the first update for a new start
+    point. Changes of the costs (repulsive points, dynamic cost map) discard the map. As long as the setting of
+    UseDynamicCostMap differs from the one the map was started with, updates search the path directly.
+    */
+    itkSetMacro(UseDistanceMap, bool);
+    itkGetMacro(UseDistanceMap, bool);
+    itkBooleanMacro(UseDistanceMap);
+
+    /** \brief Starts the computation of the distance map for the current start point and costs in a background
+    thread. Nothing happens, if the map for these settings is already computed or in progress.
+    */
+    void StartDistanceMapComputation();
+
+    /** \brief Stops the computation of the distance map and discards the map.*/
+    void StopDistanceMapComputation();
+
+    /** \brief Blocks until the distance map is complete. Returns false, if there is no distance map.*/
+    bool WaitForDistanceMap();
+
+    /** \brief Returns true, if the distance map of the current start point is complete.*/
+    bool IsDistanceMapComplete();
+
     /** \brief Clear all repulsive points used in the cost function
     */
     void ClearRepulsivePoints();
@@ -148,6 +181,32 @@ namespace mitk
 
     unsigned int m_TimeStep;
 
+    bool m_UseDistanceMap;
+
+    /** \brief Search of the distance map, shares m_CostFunction with m_ShortestPathFilter*/
+    ShortestPathImageFilterType::Pointer m_DistanceMapFilter;
+
+    /** \brief Background computation of the distance map.
+    m_DistanceMapFilter and m_CostFunction may only be used while holding m_DistanceMapMutex, as long as
+    m_DistanceMapThread is running. The other members are only changed by the thread calling the filter.
+    */
+    void ComputeDistanceMap();
+
+    /** \brief Runs a direct start to end search with m_ShortestPathFilter*/
+    ShortestPathType SearchShortestPath(const InternalImageType::IndexType &startPoint,
+                                        const InternalImageType::IndexType &endPoint);
+
+    bool GetStartIndex(InternalImageType::IndexType &startIndex);
+
+    std::thread m_DistanceMapThread;
+    std::mutex m_DistanceMapMutex;
+    std::condition_variable m_DistanceMapProgress;
+    std::atomic<bool> m_StopDistanceMapComputation;
+    bool m_DistanceMapValid;
+    bool m_DistanceMapComplete; // guarded by m_DistanceMapMutex
+    bool m_DistanceMapUsesDynamicCostMap;
+    InternalImageType::IndexType m_DistanceMapStartIndex;
+
     template <typename TPixel, unsigned int VImageDimension>
     void ItkPreProcessImage(const itk::Image<TPixel, VImageDimension> *inputImage);
 
@@ -265,6 +265,7 @@ void mitk::LiveWireTool2D::OnInitLiveWire(StateMachineAction *, InteractionEvent
   m_WorkingSlice->GetSlicedGeometry()->SetOrigin(origin);
 
   m_LiveWireFilter = ImageLiveWireContourModelFilter::New();
+  m_LiveWireFilter->SetUseDistanceMap(true);
   m_LiveWireFilter->SetInput(m_WorkingSlice);
 
   // Map click to pixel coordinates
@@ -285,6 +286,9 @@ void mitk::LiveWireTool2D::OnInitLiveWire(StateMachineAction *, InteractionEvent
   m_Contour->AddVertex(click, true, t);
   m_LiveWireFilter->SetStartPoint(click);
 
+  // Compute the paths to all pixels in the background, mouse moves only have to trace them back
+  m_LiveWireFilter->StartDistanceMapComputation();
+
   // Remember PlaneGeometry to determine if events were triggered in the same plane
   m_PlaneGeometry = interactionEvent->GetSender()->GetCurrentWorldPlaneGeometry();
 
@@ -341,6 +345,8 @@ void mitk::LiveWireTool2D::OnAddPoint(StateMachineAction *, InteractionEvent *in
     m_LiveWireFilter->SetUseDynamicCostMap(true);
   }
 
+  m_LiveWireFilter->StartDistanceMapComputation();
+
   mitk::RenderingManager::GetInstance()->RequestUpdate(positionEvent->GetSender()->GetRenderWindow());
 }
 
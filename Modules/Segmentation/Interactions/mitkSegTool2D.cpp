@@ -379,6 +379,11 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
                            sliceInfo.plane);
   /*============= END undo/redo feature block ========================*/
 
+  // only the voxels of the written slice have to be updated in the label index
+  auto *labelSetImage = dynamic_cast<LabelSetImage *>(image);
+  if (labelSetImage != nullptr)
+    labelSetImage->BeginLabelIndexUpdate(sliceInfo.plane);
+
   // Make sure that for reslicing and overwriting the same alogrithm is used. We can specify the mode of the vtk
   // reslicer
   vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
@@ -404,6 +409,9 @@ void mitk::SegTool2D::WriteSliceToVolume(const mitk::SegTool2D::SliceInformation
   image->Modified();
   image->GetVtkImageData()->Modified();
 
+  if (labelSetImage != nullptr)
+    labelSetImage->EndLabelIndexUpdate();
+
   /*============= BEGIN undo/redo feature block ========================*/
   // specify the undo operation with the edited slice
   auto *doOperation =
@@ -0,0 +1,557 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkITKImageImport.h>
+#include <mitkImageLiveWireContourModelFilter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageRegionIteratorWithIndex.h>
+#include <itkShortestPathBatchExtractor.h>
+#include <itkShortestPathCostFunctionLiveWire.h>
+#include <itkShortestPathImageFilter.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  typedef itk::Image<float, 2> FloatImageType;
+
+  /** Costs are the length of the step, thus the shortest paths are known analytically.*/
+  class StepLengthCostFunction : public itk::ShortestPathCostFunction<FloatImageType>
+  {
+  public:
+    typedef StepLengthCostFunction Self;
+    typedef itk::ShortestPathCostFunction<FloatImageType> Superclass;
+    typedef itk::SmartPointer<Self> Pointer;
+
+    itkFactorylessNewMacro(Self);
+    itkTypeMacro(StepLengthCostFunction, ShortestPathCostFunction);
+
+    double GetCost(IndexType p1, IndexType p2) override
+    {
+      const double dx = p2[0] - p1[0];
+      const double dy = p2[1] - p1[1];
+      return std::sqrt(dx * dx + dy * dy);
+    }
+    double GetMinCost() override { return 1.0; }
+    void Initialize() override {}
+
+  protected:
+    StepLengthCostFunction() {}
+  };
+}
+
+class mitkImageLiveWireContourModelFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageLiveWireContourModelFilterTestSuite);
+  MITK_TEST(ShortestPathFaceNeighbors);
+  MITK_TEST(ShortestPathFullNeighbors);
+  MITK_TEST(DistanceImage);
+  MITK_TEST(LiveWireOnCTSlice);
+  MITK_TEST(DistanceMapMatchesSearch);
+  MITK_TEST(DistanceMapIsDiscardedOnCostChange);
+  MITK_TEST(ShortestPathMatchesReferenceSearch);
+  MITK_TEST(BatchExtraction);
+  MITK_TEST(BatchExtractionIsDeterministic);
+  CPPUNIT_TEST_SUITE_END();
+
+  typedef itk::ShortestPathImageFilter<FloatImageType, FloatImageType> ShortestPathImageFilterType;
+  typedef itk::ShortestPathBatchExtractor<FloatImageType> BatchExtractorType;
+  typedef itk::ShortestPathCostFunctionLiveWire<FloatImageType> LiveWireCostFunctionType;
+
+  FloatImageType::Pointer m_ConstantImage;
+  FloatImageType::Pointer m_CTImage;
+  mitk::Image::Pointer m_CTSlice;
+
+  static FloatImageType::Pointer CreateImage(unsigned int sizeX, unsigned int sizeY)
+  {
+    FloatImageType::RegionType region;
+    region.SetSize(0, sizeX);
+    region.SetSize(1, sizeY);
+
+    auto image = FloatImageType::New();
+    image->SetRegions(region);
+    image->Allocate();
+    image->FillBuffer(0.0f);
+    return image;
+  }
+
+  /** Synthetic 512x512 CT slice: air, an elliptic body of soft tissue with a bone ring and some noise (HU).*/
+  static FloatImageType::Pointer CreateCTImage()
+  {
+    auto image = CreateImage(512, 512);
+    std::mt19937 generator(42);
+    std::normal_distribution<float> noise(0.0f, 10.0f);
+
+    itk::ImageRegionIteratorWithIndex<FloatImageType> it(image, image->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      const double x = (index[0] - 256.0) / 220.0;
+      const double y = (index[1] - 256.0) / 160.0;
+      const double r = x * x + y * y;
+
+      float value = -1000.0f;
+      if (r < 1.0)
+        value = 40.0f;
+      if (r > 0.55 && r < 0.65)
+        value = 800.0f;
+
+      it.Set(value + noise(generator));
+    }
+
+    return image;
+  }
+
+  LiveWireCostFunctionType::Pointer CreateLiveWireCostFunction()
+  {
+    auto costFunction = LiveWireCostFunctionType::New();
+    costFunction->SetImage(m_CTImage);
+    costFunction->SetRequestedRegion(m_CTImage->GetLargestPossibleRegion());
+    return costFunction;
+  }
+
+  /** Requests from a few seeds on the bone ring to random end points inside the body.*/
+  static std::vector<std::pair<FloatImageType::IndexType, FloatImageType::IndexType>> CreatePathRequests(
+    unsigned int numberOfSeeds, unsigned int numberOfPathsPerSeed)
+  {
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<itk::IndexValueType> x(100, 412);
+    std::uniform_int_distribution<itk::IndexValueType> y(150, 362);
+
+    std::vector<std::pair<FloatImageType::IndexType, FloatImageType::IndexType>> requests;
+    for (unsigned int i = 0; i < numberOfPathsPerSeed; ++i)
+    {
+      for (unsigned int seed = 0; seed < numberOfSeeds; ++seed)
+      {
+        const double angle = 2.0 * 3.14159265358979 * seed / numberOfSeeds;
+        FloatImageType::IndexType start = {
+          {static_cast<itk::IndexValueType>(256.0 + 170.0 * std::cos(angle)),
+           static_cast<itk::IndexValueType>(256.0 + 124.0 * std::sin(angle))}};
+        FloatImageType::IndexType end = {{x(generator), y(generator)}};
+        requests.push_back(std::make_pair(start, end));
+      }
+    }
+    return requests;
+  }
+
+  mitk::ImageLiveWireContourModelFilter::Pointer CreateLiveWireFilter(const mitk::Point3D &startPoint,
+                                                                      bool useDistanceMap)
+  {
+    auto filter = mitk::ImageLiveWireContourModelFilter::New();
+    filter->SetUseDistanceMap(useDistanceMap);
+    filter->SetInput(m_CTSlice);
+    filter->SetStartPoint(startPoint);
+    return filter;
+  }
+
+  static mitk::ContourModel::Pointer UpdateLiveWire(mitk::ImageLiveWireContourModelFilter *filter,
+                                                    const mitk::Point3D &endPoint)
+  {
+    filter->SetEndPoint(endPoint);
+    filter->Update();
+    return filter->GetOutput();
+  }
+
+  ShortestPathImageFilterType::Pointer CreateShortestPathFilter()
+  {
+    auto filter = ShortestPathImageFilterType::New();
+    filter->SetInput(m_ConstantImage);
+    filter->SetCostFunction(StepLengthCostFunction::New());
+    filter->SetMakeOutputImage(false);
+    return filter;
+  }
+
+  /** Costs of the shortest paths from start to all pixels, computed by a plain Dijkstra search over all 8 neighbors.*/
+  std::vector<double> ComputeReferenceDistances(LiveWireCostFunctionType *costFunction,
+                                                const FloatImageType::IndexType &start) const
+  {
+    const auto size = m_CTImage->GetLargestPossibleRegion().GetSize();
+    const auto width = static_cast<itk::IndexValueType>(size[0]);
+    const auto height = static_cast<itk::IndexValueType>(size[1]);
+
+    std::vector<double> distances(size[0] * size[1], std::numeric_limits<double>::infinity());
+    typedef std::pair<double, itk::IndexValueType> QueueEntryType;
+    std::priority_queue<QueueEntryType, std::vector<QueueEntryType>, std::greater<QueueEntryType>> queue;
+
+    distances[start[1] * width + start[0]] = 0.0;
+    queue.push(std::make_pair(0.0, start[1] * width + start[0]));
+
+    while (!queue.empty())
+    {
+      const auto entry = queue.top();
+      queue.pop();
+      if (entry.first > distances[entry.second])
+        continue;
+
+      const FloatImageType::IndexType index = {{entry.second % width, entry.second / width}};
+      for (itk::IndexValueType dy = -1; dy <= 1; ++dy)
+      {
+        for (itk::IndexValueType dx = -1; dx <= 1; ++dx)
+        {
+          const FloatImageType::IndexType neighbor = {{index[0] + dx, index[1] + dy}};
+          if ((dx == 0 && dy == 0) || neighbor[0] < 0 || neighbor[0] >= width || neighbor[1] < 0 ||
+              neighbor[1] >= height)
+            continue;
+
+          const double distance = entry.first + costFunction->GetCost(index, neighbor);
+          auto &neighborDistance = distances[neighbor[1] * width + neighbor[0]];
+          if (distance < neighborDistance)
+          {
+            neighborDistance = distance;
+            queue.push(std::make_pair(distance, neighbor[1] * width + neighbor[0]));
+          }
+        }
+      }
+    }
+
+    return distances;
+  }
+
+  static void CheckPath(const std::vector<FloatImageType::IndexType> &path,
+                        const FloatImageType::IndexType &start,
+                        const FloatImageType::IndexType &end,
+                        bool fullNeighbors)
+  {
+    CPPUNIT_ASSERT(!path.empty());
+    CPPUNIT_ASSERT_EQUAL(start, path.front());
+    CPPUNIT_ASSERT_EQUAL(end, path.back());
+
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+      const auto dx = std::abs(path[i][0] - path[i - 1][0]);
+      const auto dy = std::abs(path[i][1] - path[i - 1][1]);
+      CPPUNIT_ASSERT(dx <= 1 && dy <= 1 && dx + dy > 0);
+      CPPUNIT_ASSERT(fullNeighbors || dx + dy == 1);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_ConstantImage = CreateImage(40, 30);
+    m_CTImage = CreateCTImage();
+    m_CTSlice = mitk::GrabItkImageMemory(CreateCTImage());
+  }
+
+  void tearDown() override
+  {
+    m_ConstantImage = nullptr;
+    m_CTImage = nullptr;
+    m_CTSlice = nullptr;
+  }
+
+  void ShortestPathFaceNeighbors()
+  {
+    FloatImageType::IndexType start = {{3, 25}};
+    FloatImageType::IndexType end = {{31, 4}};
+
+    auto filter = this->CreateShortestPathFilter();
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Update();
+
+    auto path = filter->GetVectorPath();
+    CheckPath(path, start, end, false);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(28 + 21 + 1), path.size());
+
+    // a second search reuses the graph of the filter
+    filter->SetStartIndex(end);
+    filter->SetEndIndex(start);
+    filter->Update();
+    CheckPath(filter->GetVectorPath(), end, start, false);
+  }
+
+  void ShortestPathFullNeighbors()
+  {
+    FloatImageType::IndexType start = {{3, 25}};
+    FloatImageType::IndexType end = {{31, 4}};
+
+    auto filter = this->CreateShortestPathFilter();
+    filter->SetGraph_fullNeighbors(true);
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Update();
+
+    // 21 diagonal and 7 straight steps
+    auto path = filter->GetVectorPath();
+    CheckPath(path, start, end, true);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(28 + 1), path.size());
+  }
+
+  void DistanceImage()
+  {
+    FloatImageType::IndexType start = {{17, 9}};
+    FloatImageType::IndexType end = {{0, 0}};
+
+    auto filter = this->CreateShortestPathFilter();
+    filter->SetCalcAllDistances(true);
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Update();
+
+    auto distanceImage = filter->GetDistanceImage();
+    itk::ImageRegionIteratorWithIndex<FloatImageType> it(distanceImage, distanceImage->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      const auto expected = std::abs(index[0] - start[0]) + std::abs(index[1] - start[1]);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(expected), it.Get(), 1e-6);
+    }
+  }
+
+  void LiveWireOnCTSlice()
+  {
+    mitk::Point3D startPoint;
+    mitk::FillVector3D(startPoint, 256.0, 80.0, 0.0);
+    mitk::Point3D endPoint;
+    mitk::FillVector3D(endPoint, 420.0, 300.0, 0.0);
+
+    auto filter = mitk::ImageLiveWireContourModelFilter::New();
+    filter->SetInput(m_CTSlice);
+    filter->SetStartPoint(startPoint);
+    filter->SetEndPoint(endPoint);
+    filter->Update();
+
+    auto contour = filter->GetOutput();
+    CPPUNIT_ASSERT(contour->GetNumberOfVertices() > 1);
+    CPPUNIT_ASSERT(mitk::Equal(startPoint, contour->GetVertexAt(0)->Coordinates));
+    CPPUNIT_ASSERT(mitk::Equal(endPoint, contour->GetVertexAt(contour->GetNumberOfVertices() - 1)->Coordinates));
+  }
+
+  void DistanceMapMatchesSearch()
+  {
+    mitk::Point3D startPoint;
+    mitk::FillVector3D(startPoint, 256.0, 160.0, 0.0);
+
+    auto searchFilter = this->CreateLiveWireFilter(startPoint, false);
+    auto distanceMapFilter = this->CreateLiveWireFilter(startPoint, true);
+    distanceMapFilter->StartDistanceMapComputation();
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> x(20.0, 492.0);
+    std::uniform_real_distribution<double> y(20.0, 492.0);
+
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      mitk::Point3D endPoint;
+      mitk::FillVector3D(endPoint, x(generator), y(generator), 0.0);
+
+      auto expected = UpdateLiveWire(searchFilter, endPoint);
+      auto contour = UpdateLiveWire(distanceMapFilter, endPoint);
+
+      CPPUNIT_ASSERT_EQUAL(expected->GetNumberOfVertices(), contour->GetNumberOfVertices());
+      for (int j = 0; j < contour->GetNumberOfVertices(); ++j)
+        CPPUNIT_ASSERT(mitk::Equal(expected->GetVertexAt(j)->Coordinates, contour->GetVertexAt(j)->Coordinates));
+    }
+
+    CPPUNIT_ASSERT(distanceMapFilter->WaitForDistanceMap());
+    CPPUNIT_ASSERT(distanceMapFilter->IsDistanceMapComplete());
+
+    // a different setting of the dynamic cost map falls back to a direct search and keeps the map
+    distanceMapFilter->SetUseDynamicCostMap(true);
+    searchFilter->SetUseDynamicCostMap(true);
+    mitk::Point3D endPoint;
+    mitk::FillVector3D(endPoint, 400.0, 300.0, 0.0);
+    CPPUNIT_ASSERT_EQUAL(UpdateLiveWire(searchFilter, endPoint)->GetNumberOfVertices(),
+                         UpdateLiveWire(distanceMapFilter, endPoint)->GetNumberOfVertices());
+    CPPUNIT_ASSERT(distanceMapFilter->IsDistanceMapComplete());
+  }
+
+  void DistanceMapIsDiscardedOnCostChange()
+  {
+    mitk::Point3D startPoint;
+    mitk::FillVector3D(startPoint, 256.0, 160.0, 0.0);
+
+    auto filter = this->CreateLiveWireFilter(startPoint, true);
+    CPPUNIT_ASSERT(!filter->WaitForDistanceMap());
+
+    filter->StartDistanceMapComputation();
+    CPPUNIT_ASSERT(filter->WaitForDistanceMap());
+
+    itk::Index<2> repulsivePoint = {{300, 200}};
+    filter->AddRepulsivePoint(repulsivePoint);
+    CPPUNIT_ASSERT(!filter->IsDistanceMapComplete());
+
+    // the next update computes a new map, that avoids the repulsive point
+    mitk::Point3D endPoint;
+    mitk::FillVector3D(endPoint, 340.0, 240.0, 0.0);
+    auto contour = UpdateLiveWire(filter, endPoint);
+    CPPUNIT_ASSERT(contour->GetNumberOfVertices() > 1);
+    CPPUNIT_ASSERT(filter->WaitForDistanceMap());
+
+    // stopping a running computation discards the map
+    filter->SetStartPoint(endPoint);
+    filter->StartDistanceMapComputation();
+    filter->StopDistanceMapComputation();
+    CPPUNIT_ASSERT(!filter->IsDistanceMapComplete());
+  }
+
+  void ShortestPathMatchesReferenceSearch()
+  {
+    // the end points of the mouse moves of the LiveWire tool: fixed seed, changing end points inside the body
+    const FloatImageType::IndexType start = {{256, 160}};
+    const auto width = static_cast<itk::IndexValueType>(m_CTImage->GetLargestPossibleRegion().GetSize(0));
+
+    auto costFunction = this->CreateLiveWireCostFunction();
+    auto filter = ShortestPathImageFilterType::New();
+    filter->SetInput(m_CTImage);
+    filter->SetCostFunction(costFunction);
+    filter->SetGraph_fullNeighbors(true);
+    filter->SetMakeOutputImage(false);
+    filter->SetStartIndex(start);
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<itk::IndexValueType> x(100, 412);
+    std::uniform_int_distribution<itk::IndexValueType> y(150, 362);
+
+    std::vector<double> referenceDistances;
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+      const FloatImageType::IndexType end = {{x(generator), y(generator)}};
+      filter->SetEndIndex(end);
+      filter->Update();
+
+      // the cost function is initialized by the first search
+      if (referenceDistances.empty())
+        referenceDistances = this->ComputeReferenceDistances(costFunction, start);
+
+      const auto path = filter->GetVectorPath();
+      CheckPath(path, start, end, true);
+
+      double pathCost = 0.0;
+      for (std::size_t j = 1; j < path.size(); ++j)
+        pathCost += costFunction->GetCost(path[j - 1], path[j]);
+
+      const double expectedCost = referenceDistances[end[1] * width + end[0]];
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedCost, pathCost, 1e-9 * expectedCost);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedCost, filter->GetDistance(end), 1e-9 * expectedCost);
+    }
+  }
+
+  void BatchExtraction()
+  {
+    auto requests = CreatePathRequests(4, 5);
+
+    // a further start with two requests, one of them ends at its start
+    FloatImageType::IndexType start = {{60, 256}};
+    requests.push_back(std::make_pair(start, requests.front().second));
+    requests.push_back(std::make_pair(start, start));
+
+    auto extractor = BatchExtractorType::New();
+    extractor->SetInput(m_CTImage);
+    extractor->SetCostFunction(this->CreateLiveWireCostFunction());
+    extractor->FullNeighborsOn();
+    extractor->SetNumberOfThreads(4);
+    for (const auto &request : requests)
+      extractor->AddPath(request.first, request.second);
+
+    extractor->Compute();
+    CPPUNIT_ASSERT_EQUAL(requests.size(), extractor->GetNumberOfPaths());
+    CPPUNIT_ASSERT(extractor->GetPathsPerSecond() > 0.0);
+
+    // the paths of the batch are the ones of a separate search per request
+    auto filter = ShortestPathImageFilterType::New();
+    filter->SetInput(m_CTImage);
+    filter->SetCostFunction(this->CreateLiveWireCostFunction());
+    filter->SetGraph_fullNeighbors(true);
+    filter->SetMakeOutputImage(false);
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+      filter->SetStartIndex(requests[i].first);
+      filter->SetEndIndex(requests[i].second);
+      filter->Update();
+
+      const auto &path = extractor->GetPath(i);
+      CheckPath(path, requests[i].first, requests[i].second, true);
+      CPPUNIT_ASSERT(filter->GetVectorPath() == path);
+      CPPUNIT_ASSERT(extractor->GetPathCost(i) >= 0.0);
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, extractor->GetPathCost(requests.size() - 1), 1e-12);
+
+    // requests outside of the image are rejected
+    FloatImageType::IndexType outside = {{512, 0}};
+    extractor->AddPath(start, outside);
+    CPPUNIT_ASSERT_THROW(extractor->Compute(), itk::ExceptionObject);
+
+    extractor->ClearPaths();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), extractor->GetNumberOfPaths());
+  }
+
+  void BatchExtractionIsDeterministic()
+  {
+    // starts with a single request are answered by an A* search, the others by a single source search
+    auto requests = CreatePathRequests(16, 1);
+    const auto groupedRequests = CreatePathRequests(3, 4);
+    requests.insert(requests.end(), groupedRequests.begin(), groupedRequests.end());
+
+    std::vector<BatchExtractorType::PathType> expectedPaths;
+    std::vector<double> expectedCosts;
+
+    for (auto threads : {1u, 4u})
+    {
+      auto extractor = BatchExtractorType::New();
+      extractor->SetInput(m_CTImage);
+      extractor->SetCostFunction(this->CreateLiveWireCostFunction());
+      extractor->FullNeighborsOn();
+      extractor->SetNumberOfThreads(threads);
+      for (const auto &request : requests)
+        extractor->AddPath(request.first, request.second);
+
+      extractor->Compute();
+
+      std::vector<double> costs;
+      for (std::size_t i = 0; i < requests.size(); ++i)
+        costs.push_back(extractor->GetPathCost(i));
+
+      if (expectedPaths.empty())
+      {
+        expectedPaths = extractor->GetPaths();
+        expectedCosts = costs;
+      }
+      else
+      {
+        CPPUNIT_ASSERT(expectedPaths == extractor->GetPaths());
+        CPPUNIT_ASSERT(expectedCosts == costs);
+      }
+    }
+
+    // the paths and costs of the batch are the ones of a separate search per request
+    auto filter = ShortestPathImageFilterType::New();
+    filter->SetInput(m_CTImage);
+    filter->SetCostFunction(this->CreateLiveWireCostFunction());
+    filter->SetGraph_fullNeighbors(true);
+    filter->SetMakeOutputImage(false);
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+      filter->SetStartIndex(requests[i].first);
+      filter->SetEndIndex(requests[i].second);
+      filter->Update();
+
+      CheckPath(expectedPaths[i], requests[i].first, requests[i].second, true);
+      CPPUNIT_ASSERT(filter->GetVectorPath() == expectedPaths[i]);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(filter->GetDistance(requests[i].second), expectedCosts[i], 1e-9);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageLiveWireContourModelFilter)
@@ -1211,8 +1211,12 @@ void QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged(const itk::Event
 {
   if (m_3DInterpolationEnabled)
   {
+    // The running interpolation is outdated, cancel it instead of waiting for its result
     if (m_Watcher.isRunning())
+    {
+      m_SurfaceInterpolator->CancelInterpolation();
       m_Watcher.waitForFinished();
+    }
     m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
     m_Watcher.setFuture(m_Future);
   }
@@ -3,6 +3,8 @@ set(MODULE_TESTS
   mitkCreateDistanceImageFromSurfaceFilterTest.cpp
   mitkImageToPointCloudFilterTest.cpp
   mitkPointCloudScoringFilterTest
+  mitkRadialBasisFunctionOctreeTest.cpp
+  mitkRadialBasisFunctionSystemTest.cpp
   mitkReduceContourSetFilterTest.cpp
   mitkSurfaceInterpolationControllerTest.cpp
 )
@@ -0,0 +1,117 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkRadialBasisFunctionOctree.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <random>
+
+class mitkRadialBasisFunctionOctreeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRadialBasisFunctionOctreeTestSuite);
+  MITK_TEST(TestExactEvaluation);
+  MITK_TEST(TestApproximationStaysWithinMaximumError);
+  MITK_TEST(TestIdenticalCenters);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::RadialBasisFunctionOctree::PointType PointType;
+
+  std::vector<PointType> m_Centers;
+  Eigen::VectorXd m_Weights;
+  std::mt19937 m_Generator;
+
+  double EvaluateBruteForce(const PointType &p) const
+  {
+    double value = 0.0;
+    for (std::size_t i = 0; i < m_Centers.size(); ++i)
+      value += (p - m_Centers[i]).two_norm() * m_Weights[i];
+    return value;
+  }
+
+  PointType RandomPoint(double min, double max)
+  {
+    std::uniform_real_distribution<double> distribution(min, max);
+    PointType p;
+    p[0] = distribution(m_Generator);
+    p[1] = distribution(m_Generator);
+    p[2] = distribution(m_Generator);
+    return p;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Generator.seed(42);
+    std::uniform_real_distribution<double> weightDistribution(-1.0, 1.0);
+
+    // contour like clusters of centers in several slices
+    for (unsigned int slice = 0; slice < 20; ++slice)
+    {
+      for (unsigned int i = 0; i < 150; ++i)
+      {
+        const double angle = 2.0 * 3.14159265358979 * i / 150;
+        PointType center;
+        center[0] = 30.0 * std::cos(angle);
+        center[1] = 20.0 * std::sin(angle);
+        center[2] = 5.0 * slice;
+        m_Centers.push_back(center);
+      }
+    }
+
+    m_Weights.resize(m_Centers.size());
+    for (std::size_t i = 0; i < m_Centers.size(); ++i)
+      m_Weights[i] = weightDistribution(m_Generator);
+  }
+
+  void tearDown() override
+  {
+    m_Centers.clear();
+  }
+
+  void TestExactEvaluation()
+  {
+    mitk::RadialBasisFunctionOctree octree(m_Centers, m_Weights, 0.0);
+    CPPUNIT_ASSERT_EQUAL(1u, octree.GetNumberOfNodes());
+
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+      PointType p = RandomPoint(-50.0, 120.0);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(EvaluateBruteForce(p), octree.Evaluate(p), 1e-9);
+    }
+  }
+
+  void TestApproximationStaysWithinMaximumError()
+  {
+    const double maximumError = 0.01;
+    mitk::RadialBasisFunctionOctree octree(m_Centers, m_Weights, maximumError, 16);
+    CPPUNIT_ASSERT(octree.GetNumberOfNodes() > 1);
+
+    for (unsigned int i = 0; i < 500; ++i)
+    {
+      PointType p = RandomPoint(-200.0, 300.0);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(EvaluateBruteForce(p), octree.Evaluate(p), maximumError);
+    }
+  }
+
+  void TestIdenticalCenters()
+  {
+    m_Centers.assign(m_Centers.size(), m_Centers.front());
+    mitk::RadialBasisFunctionOctree octree(m_Centers, m_Weights, 0.01, 16);
+
+    PointType p = RandomPoint(-50.0, 50.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(EvaluateBruteForce(p), octree.Evaluate(p), 0.01);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRadialBasisFunctionOctree)
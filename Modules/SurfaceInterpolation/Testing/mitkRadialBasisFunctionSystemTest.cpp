@@ -0,0 +1,122 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExceptionMacro.h>
+#include <mitkRadialBasisFunctionSystem.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <random>
+
+class mitkRadialBasisFunctionSystemTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRadialBasisFunctionSystemTestSuite);
+  MITK_TEST(TestFactorize);
+  MITK_TEST(TestAppend);
+  MITK_TEST(TestFactorizeDiscardsAppendedLevels);
+  MITK_TEST(TestAppendWithWrongDimensions);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  Eigen::MatrixXd m_Centers;
+  Eigen::VectorXd m_FunctionValues;
+
+  // basis function values Phi(r) = r between the centers [firstRow, firstRow + rows) and [firstCol, firstCol + cols)
+  Eigen::MatrixXd CreateMatrix(Eigen::Index firstRow, Eigen::Index rows, Eigen::Index firstCol, Eigen::Index cols)
+  {
+    Eigen::MatrixXd matrix(rows, cols);
+    for (Eigen::Index i = 0; i < rows; ++i)
+      for (Eigen::Index j = 0; j < cols; ++j)
+        matrix(i, j) = (m_Centers.row(firstRow + i) - m_Centers.row(firstCol + j)).norm();
+    return matrix;
+  }
+
+  void AssertEqual(const Eigen::VectorXd &expected, const Eigen::VectorXd &actual)
+  {
+    CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+    for (Eigen::Index i = 0; i < expected.size(); ++i)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], actual[i], 1e-8);
+  }
+
+public:
+  void setUp() override
+  {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+
+    m_Centers.resize(120, 3);
+    m_FunctionValues.resize(120);
+    for (Eigen::Index i = 0; i < m_Centers.rows(); ++i)
+    {
+      for (Eigen::Index dim = 0; dim < 3; ++dim)
+        m_Centers(i, dim) = distribution(generator);
+      m_FunctionValues[i] = distribution(generator);
+    }
+  }
+
+  void tearDown() override {}
+
+  void TestFactorize()
+  {
+    const Eigen::MatrixXd matrix = CreateMatrix(0, 120, 0, 120);
+
+    mitk::RadialBasisFunctionSystem system;
+    system.Factorize(matrix);
+
+    CPPUNIT_ASSERT_EQUAL(Eigen::Index(120), system.GetSize());
+    CPPUNIT_ASSERT_EQUAL(0u, system.GetNumberOfLevels());
+    AssertEqual(matrix.partialPivLu().solve(m_FunctionValues), system.Solve(m_FunctionValues));
+  }
+
+  void TestAppend()
+  {
+    mitk::RadialBasisFunctionSystem system;
+    system.Factorize(CreateMatrix(0, 80, 0, 80));
+    system.Append(CreateMatrix(0, 80, 80, 30), CreateMatrix(80, 30, 80, 30));
+    system.Append(CreateMatrix(0, 110, 110, 10), CreateMatrix(110, 10, 110, 10));
+
+    CPPUNIT_ASSERT_EQUAL(Eigen::Index(120), system.GetSize());
+    CPPUNIT_ASSERT_EQUAL(Eigen::Index(80), system.GetFactorizedSize());
+    CPPUNIT_ASSERT_EQUAL(2u, system.GetNumberOfLevels());
+
+    const Eigen::MatrixXd matrix = CreateMatrix(0, 120, 0, 120);
+    const Eigen::VectorXd weights = system.Solve(m_FunctionValues);
+    AssertEqual(matrix.partialPivLu().solve(m_FunctionValues), weights);
+    AssertEqual(m_FunctionValues, matrix * weights);
+  }
+
+  void TestFactorizeDiscardsAppendedLevels()
+  {
+    mitk::RadialBasisFunctionSystem system;
+    system.Factorize(CreateMatrix(0, 80, 0, 80));
+    system.Append(CreateMatrix(0, 80, 80, 40), CreateMatrix(80, 40, 80, 40));
+
+    const Eigen::MatrixXd matrix = CreateMatrix(0, 100, 0, 100);
+    system.Factorize(matrix);
+
+    CPPUNIT_ASSERT_EQUAL(Eigen::Index(100), system.GetSize());
+    CPPUNIT_ASSERT_EQUAL(0u, system.GetNumberOfLevels());
+
+    const Eigen::VectorXd functionValues = m_FunctionValues.head(100);
+    AssertEqual(matrix.partialPivLu().solve(functionValues), system.Solve(functionValues));
+  }
+
+  void TestAppendWithWrongDimensions()
+  {
+    mitk::RadialBasisFunctionSystem system;
+    system.Factorize(CreateMatrix(0, 80, 0, 80));
+    CPPUNIT_ASSERT_THROW(system.Append(CreateMatrix(0, 70, 80, 10), CreateMatrix(80, 10, 80, 10)), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(system.Solve(m_FunctionValues), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRadialBasisFunctionSystem)
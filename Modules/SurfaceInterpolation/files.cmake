@@ -4,6 +4,8 @@ set(CPP_FILES
   mitkImageToPointCloudFilter.cpp
   mitkPlaneProposer.cpp
   mitkPointCloudScoringFilter.cpp
+  mitkRadialBasisFunctionOctree.cpp
+  mitkRadialBasisFunctionSystem.cpp
   mitkReduceContourSetFilter.cpp
   mitkSurfaceInterpolationController.cpp
   mitkSurfaceBasedInterpolationController.cpp
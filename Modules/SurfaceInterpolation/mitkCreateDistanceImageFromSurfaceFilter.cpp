@@ -20,9 +20,11 @@ found in the LICENSE file.
 #include "vtkSmartPointer.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkNeighborhoodIterator.h"
 
-#include <queue>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,8 +107,14 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_EquationSystemSpacing(0.0),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0),
+    m_MaximumInterpolationError(0.0),
+    m_ReuseFactorization(false)
 {
+  // the threads are reused for all fronts of the narrow band
+  m_MultiThreader = itk::MultiThreader::New();
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
   this->m_ProgressStepSize = 5;
@@ -126,11 +134,21 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   // First of all we have to build the equation-system from the existing contour-edge-points
   this->CreateSolutionMatrixAndFunctionValues();
+  this->ThrowIfAborted();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  m_Weights = m_EquationSystem.Solve(m_FunctionValues);
+  if (!m_ReuseFactorization)
+  {
+    m_EquationSystem = RadialBasisFunctionSystem();
+    m_EquationSystemCenters.clear();
+  }
+
+  m_DistanceFunction.reset(
+    new RadialBasisFunctionOctree(m_Centers, m_Weights, m_MaximumInterpolationError * m_DistanceImageSpacing));
+  this->ThrowIfAborted();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
@@ -143,6 +161,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 
   m_Centers.clear();
   m_Normals.clear();
+  m_DistanceFunction.reset();
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -261,29 +280,120 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
     m_FunctionValues[numberOfCenters * 2 + i] = m_DistanceImageSpacing;
   }
 
-  // Now we have created all centers and all function values. Next step is to create the solution matrix
+  // Now we have created all centers and all function values. If only centers were added since the last update the
+  // factorization of the last update can be extended, otherwise the solution matrix is created and factorized
+  if (m_ReuseFactorization && this->ExtendEquationSystem())
+    return;
+
   numberOfCenters = m_Centers.size();
 
   m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
 
   m_Weights.resize(numberOfCenters);
 
-  PointType p1;
-  PointType p2;
-  double norm;
-
   for (unsigned int i = 0; i < numberOfCenters; i++)
   {
     for (unsigned int j = 0; j < numberOfCenters; j++)
     {
-      // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidian distance between two points
-      p1 = m_Centers.at(i);
-      p2 = m_Centers.at(j);
-      p1 = p1 - p2;
-      norm = p1.two_norm();
-      m_SolutionMatrix(i, j) = norm;
+      m_SolutionMatrix(i, j) = this->CalculateBasisFunctionValue(m_Centers[i], m_Centers[j]);
     }
   }
+
+  m_EquationSystem.Factorize(m_SolutionMatrix);
+  m_EquationSystemCenters = m_Centers;
+  m_EquationSystemSpacing = m_DistanceImageSpacing;
+}
+
+bool mitk::CreateDistanceImageFromSurfaceFilter::ExtendEquationSystem()
+{
+  const std::size_t numberOfPreviousCenters = m_EquationSystemCenters.size();
+  if (numberOfPreviousCenters == 0 || m_Centers.size() < numberOfPreviousCenters ||
+      m_EquationSystemSpacing != m_DistanceImageSpacing)
+    return false;
+
+  // Appending k centers to a system of n centers costs about 2 * n^2 * k operations compared to n^3 / 3 for a new
+  // factorization. Additionally the appended levels slow down every solve, so they are limited to half of the
+  // factorized centers.
+  const std::size_t numberOfNewCenters = m_Centers.size() - numberOfPreviousCenters;
+  const auto numberOfAppendedCenters =
+    static_cast<std::size_t>(m_EquationSystem.GetSize() - m_EquationSystem.GetFactorizedSize()) + numberOfNewCenters;
+  if (6 * numberOfNewCenters > m_Centers.size() ||
+      2 * numberOfAppendedCenters > static_cast<std::size_t>(m_EquationSystem.GetFactorizedSize()))
+    return false;
+
+  // The centers of the last update have to come first in their previous order, followed by the new centers.
+  // Unchanged contours yield exactly the same centers, so they can be matched by their coordinates.
+  typedef std::array<double, 3> CoordinatesType;
+  auto coordinates = [](const PointType &p) { return CoordinatesType{{p[0], p[1], p[2]}}; };
+
+  std::map<CoordinatesType, std::size_t> unmatchedCenters;
+  for (std::size_t i = 0; i < m_Centers.size(); ++i)
+    unmatchedCenters.insert(std::make_pair(coordinates(m_Centers[i]), i));
+
+  std::vector<std::size_t> order;
+  order.reserve(m_Centers.size());
+  for (const auto &previousCenter : m_EquationSystemCenters)
+  {
+    auto match = unmatchedCenters.find(coordinates(previousCenter));
+    if (match == unmatchedCenters.end())
+      return false;
+
+    order.push_back(match->second);
+    unmatchedCenters.erase(match);
+  }
+
+  for (const auto &newCenter : unmatchedCenters)
+    order.push_back(newCenter.second);
+
+  CenterList centers;
+  centers.reserve(order.size());
+  Eigen::VectorXd functionValues(order.size());
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    centers.push_back(m_Centers[order[i]]);
+    functionValues[i] = m_FunctionValues[order[i]];
+  }
+  m_Centers.swap(centers);
+  m_FunctionValues.swap(functionValues);
+
+  Eigen::MatrixXd border(numberOfPreviousCenters, numberOfNewCenters);
+  Eigen::MatrixXd corner(numberOfNewCenters, numberOfNewCenters);
+  for (std::size_t j = 0; j < numberOfNewCenters; ++j)
+  {
+    const PointType &newCenter = m_Centers[numberOfPreviousCenters + j];
+    for (std::size_t i = 0; i < numberOfPreviousCenters; ++i)
+      border(i, j) = this->CalculateBasisFunctionValue(m_Centers[i], newCenter);
+    for (std::size_t i = 0; i < numberOfNewCenters; ++i)
+      corner(i, j) = this->CalculateBasisFunctionValue(m_Centers[numberOfPreviousCenters + i], newCenter);
+  }
+
+  m_EquationSystem.Append(border, corner);
+  m_EquationSystemCenters = m_Centers;
+
+  // the solution matrix is not assembled anymore
+  m_SolutionMatrix.resize(0, 0);
+  return true;
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateBasisFunctionValue(const PointType &p1,
+                                                                              const PointType &p2) const
+{
+  // Currently using Phi(r) = r with r is the euclidian distance between two points
+  return (p1 - p2).two_norm();
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::ThrowIfAborted()
+{
+  if (!this->GetAbortGenerateData())
+    return;
+
+  m_Centers.clear();
+  m_Normals.clear();
+  m_DistanceFunction.reset();
+
+  itk::ProcessAborted exception(__FILE__, __LINE__);
+  exception.SetDescription("Creation of the distance image aborted.");
+  throw exception;
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
@@ -300,9 +410,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   */
 
   typedef itk::ImageRegionIteratorWithIndex<DistanceImageType> ImageIterator;
-  typedef itk::NeighborhoodIterator<DistanceImageType> NeighborhoodImageIterator;
 
-  std::queue<DistanceImageType::IndexType> narrowbandPoints;
   PointType currentPoint = m_Centers.at(0);
   double distance = this->CalculateDistanceValue(currentPoint);
 
@@ -319,49 +427,64 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   assert(
     m_DistanceImageITK->GetLargestPossibleRegion().IsInside(currentIndex)); // we are quite certain this should hold
 
-  narrowbandPoints.push(currentIndex);
   m_DistanceImageITK->SetPixel(currentIndex, distance);
 
-  NeighborhoodImageIterator::RadiusType radius;
-  radius.Fill(1);
-  NeighborhoodImageIterator nIt(radius, m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
-  unsigned int relativeNbIdx[] = {4, 10, 12, 14, 16, 22};
+  // The narrowband is grown front by front. The neighbors of the current front are collected first and marked as
+  // pending, so that the expensive distance calculation of a whole front can be done in parallel. Pixels outside the
+  // narrowband are marked as rejected so that they are not calculated again for each of their neighbors, and are reset
+  // to the default value at the end.
+  const double pendingValue = std::numeric_limits<double>::max();
+  const double rejectedValue = std::numeric_limits<double>::lowest();
+  const DistanceImageType::RegionType region = m_DistanceImageITK->GetLargestPossibleRegion();
 
-  bool isInBounds = false;
-  while (!narrowbandPoints.empty())
-  {
-    nIt.SetLocation(narrowbandPoints.front());
-    narrowbandPoints.pop();
+  std::vector<DistanceImageType::IndexType> narrowbandFront(1, currentIndex);
+  std::vector<DistanceImageType::IndexType> candidates;
+  std::vector<DistanceImageType::IndexType> rejectedPoints;
+  std::vector<double> distances;
 
-    unsigned int *relativeNb = &relativeNbIdx[0];
-    for (int i = 0; i < 6; i++)
+  while (!narrowbandFront.empty())
+  {
+    candidates.clear();
+    for (const auto &frontIndex : narrowbandFront)
     {
-      nIt.GetPixel(*relativeNb, isInBounds);
-      if (isInBounds && nIt.GetPixel(*relativeNb) == m_DistanceImageDefaultBufferValue)
+      for (unsigned int dim = 0; dim < 3; ++dim)
       {
-        currentIndex = nIt.GetIndex(*relativeNb);
-
-        // Transform the currently checked point from index-coordinates to
-        // world-coordinates
-        m_DistanceImageITK->TransformIndexToPhysicalPoint(currentIndex, currentPointAsPoint);
-
-        // create a vnl_vector
-        currentPoint[0] = currentPointAsPoint[0];
-        currentPoint[1] = currentPointAsPoint[1];
-        currentPoint[2] = currentPointAsPoint[2];
-
-        // and check the distance
-        distance = this->CalculateDistanceValue(currentPoint);
-        if (std::fabs(distance) <= m_DistanceImageSpacing * 2)
+        for (int offset : {-1, 1})
         {
-          nIt.SetPixel(*relativeNb, distance);
-          narrowbandPoints.push(currentIndex);
+          currentIndex = frontIndex;
+          currentIndex[dim] += offset;
+          if (region.IsInside(currentIndex) &&
+              m_DistanceImageITK->GetPixel(currentIndex) == m_DistanceImageDefaultBufferValue)
+          {
+            m_DistanceImageITK->SetPixel(currentIndex, pendingValue);
+            candidates.push_back(currentIndex);
+          }
         }
       }
-      relativeNb++;
+    }
+
+    this->ThrowIfAborted();
+    this->CalculateDistanceValues(candidates, distances);
+
+    narrowbandFront.clear();
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+      if (std::fabs(distances[i]) <= m_DistanceImageSpacing * 2)
+      {
+        m_DistanceImageITK->SetPixel(candidates[i], distances[i]);
+        narrowbandFront.push_back(candidates[i]);
+      }
+      else
+      {
+        m_DistanceImageITK->SetPixel(candidates[i], rejectedValue);
+        rejectedPoints.push_back(candidates[i]);
+      }
     }
   }
 
+  for (const auto &rejectedIndex : rejectedPoints)
+    m_DistanceImageITK->SetPixel(rejectedIndex, m_DistanceImageDefaultBufferValue);
+
   ImageIterator imgRegionIterator(m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
   imgRegionIterator.GoToBegin();
 
@@ -419,25 +542,73 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
-double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(const PointType &p) const
 {
-  double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
+  return m_DistanceFunction->Evaluate(p);
+}
 
-  CenterList::iterator centerIter;
+namespace
+{
+  struct DistanceValuesThreadData
+  {
+    const mitk::CreateDistanceImageFromSurfaceFilter *Filter;
+    const std::vector<mitk::CreateDistanceImageFromSurfaceFilter::IndexType> *Indices;
+    std::vector<double> *Distances;
+  };
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValues(const std::vector<IndexType> &indices,
+                                                                         std::vector<double> &distances)
+{
+  distances.resize(indices.size());
+
+  // small fronts are not worth distributing to several threads
+  const std::size_t minimumNumberOfPointsPerThread = 64;
+  const std::size_t numberOfThreads =
+    std::min<std::size_t>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads(),
+                          indices.size() / minimumNumberOfPointsPerThread);
+
+  DistanceValuesThreadData data = {this, &indices, &distances};
+
+  if (numberOfThreads <= 1)
+  {
+    itk::MultiThreader::ThreadInfoStruct info;
+    info.ThreadID = 0;
+    info.NumberOfThreads = 1;
+    info.UserData = &data;
+    CalculateDistanceValuesCallback(&info);
+    return;
+  }
+
+  m_MultiThreader->SetNumberOfThreads(static_cast<itk::ThreadIdType>(numberOfThreads));
+  m_MultiThreader->SetSingleMethod(CalculateDistanceValuesCallback, &data);
+  m_MultiThreader->SingleMethodExecute();
+}
+
+ITK_THREAD_RETURN_TYPE mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValuesCallback(void *arg)
+{
+  auto *info = static_cast<itk::MultiThreader::ThreadInfoStruct *>(arg);
+  auto *data = static_cast<DistanceValuesThreadData *>(info->UserData);
+
+  const std::vector<IndexType> &indices = *data->Indices;
+  std::vector<double> &distances = *data->Distances;
 
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
+  const std::size_t chunkSize = (indices.size() + info->NumberOfThreads - 1) / info->NumberOfThreads;
+  const std::size_t begin = std::min(indices.size(), info->ThreadID * chunkSize);
+  const std::size_t end = std::min(indices.size(), begin + chunkSize);
+
+  DistanceImageType::PointType pointAsPoint;
+  PointType point;
+  for (std::size_t i = begin; i < end; ++i)
   {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
+    data->Filter->m_DistanceImageITK->TransformIndexToPhysicalPoint(indices[i], pointAsPoint);
+    point[0] = pointAsPoint[0];
+    point[1] = pointAsPoint[1];
+    point[2] = pointAsPoint[2];
+    distances[i] = data->Filter->CalculateDistanceValue(point);
   }
-  return distanceValue;
+
+  return ITK_THREAD_RETURN_VALUE;
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
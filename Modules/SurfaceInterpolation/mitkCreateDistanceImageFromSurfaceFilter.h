@@ -17,14 +17,19 @@ found in the LICENSE file.
 
 #include "mitkImageSource.h"
 #include "mitkProgressBar.h"
+#include "mitkRadialBasisFunctionOctree.h"
+#include "mitkRadialBasisFunctionSystem.h"
 #include "mitkSurface.h"
 
 #include "vnl/vnl_vector_fixed.h"
 
 #include "itkImageBase.h"
+#include "itkMultiThreader.h"
 
 #include <Eigen/Dense>
 
+#include <memory>
+
 namespace mitk
 {
   /**
@@ -99,6 +104,26 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the maximum error of the interpolated distance function relative to the spacing of the distance image.
+           With a value > 0 the contributions of distant clusters of contour points are approximated
+           (see mitk::RadialBasisFunctionOctree), which considerably speeds up the interpolation of many contours.
+           If non is set, the distance function is evaluated exactly (value 0).
+    */
+    itkSetMacro(MaximumInterpolationError, double);
+    itkGetMacro(MaximumInterpolationError, double);
+
+    /**
+    \brief Set whether the factorized equation system is kept for the next update.
+           If the next update only adds contour points while the spacing of the distance image stays the same, the
+           kept factorization is extended by the new points (see mitk::RadialBasisFunctionSystem) instead of
+           factorizing the complete equation system again.
+           If non is set, the equation system is factorized on every update (value false).
+    */
+    itkSetMacro(ReuseFactorization, bool);
+    itkGetMacro(ReuseFactorization, bool);
+    itkBooleanMacro(ReuseFactorization);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -128,7 +153,33 @@ namespace mitk
 
   private:
     void CreateSolutionMatrixAndFunctionValues();
-    double CalculateDistanceValue(PointType p);
+
+    /**
+    * \brief Appends the new centers to the factorization of the last update.
+    *
+    * Reorders m_Centers and m_FunctionValues so that the centers of the last update come first.
+    * \return false if the factorization cannot be extended, e.g. because centers were removed or the
+    * spacing of the distance image changed.
+    */
+    bool ExtendEquationSystem();
+
+    double CalculateBasisFunctionValue(const PointType &p1, const PointType &p2) const;
+
+    /**
+    * \brief Throws an itk::ProcessAborted exception if AbortGenerateData was set while the filter is running.
+    */
+    void ThrowIfAborted();
+    double CalculateDistanceValue(const PointType &p) const;
+
+    /**
+    * \brief Calculates the distance values of all given indices of the distance image using multiple threads.
+    *
+    * The threads are provided by m_MultiThreader (and thereby by the ITK thread pool, if enabled); their number is
+    * limited by the global default number of threads of ITK.
+    */
+    void CalculateDistanceValues(const std::vector<IndexType> &indices, std::vector<double> &distances);
+
+    static ITK_THREAD_RETURN_TYPE CalculateDistanceValuesCallback(void *arg);
 
     void FillDistanceImage();
 
@@ -161,13 +212,22 @@ namespace mitk
     Eigen::MatrixXd m_SolutionMatrix;
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
+    RadialBasisFunctionSystem m_EquationSystem;
+    // centers and distance image spacing the equation system was set up for
+    CenterList m_EquationSystemCenters;
+    double m_EquationSystemSpacing;
+    std::unique_ptr<RadialBasisFunctionOctree> m_DistanceFunction;
 
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
+    itk::MultiThreader::Pointer m_MultiThreader;
+
     double m_DistanceImageSpacing;
     double m_DistanceImageDefaultBufferValue;
     unsigned int m_DistanceImageVolume;
+    double m_MaximumInterpolationError;
+    bool m_ReuseFactorization;
 
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
@@ -0,0 +1,223 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRadialBasisFunctionOctree.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+  const unsigned int MaximumDepth = 20;
+}
+
+mitk::RadialBasisFunctionOctree::RadialBasisFunctionOctree(const std::vector<PointType> &centers,
+                                                           const Eigen::VectorXd &weights,
+                                                           double maximumError,
+                                                           unsigned int maximumNumberOfCentersPerLeaf)
+  : m_MaximumNumberOfCentersPerLeaf(std::max(1u, maximumNumberOfCentersPerLeaf)), m_ApproximationThreshold(0.0)
+{
+  const std::size_t numberOfCenters = centers.size();
+
+  // The error of approximating a node is bounded by sum_i |w_i| * Radius^3 / (2 * (distance - Radius)^2). Requiring
+  // Radius^3 / (distance - Radius)^2 <= maximumError / sum_i |w_i| for every approximated node bounds the error of
+  // the complete sum by maximumError.
+  double absoluteWeightSum = 0.0;
+  for (std::size_t i = 0; i < numberOfCenters; ++i)
+    absoluteWeightSum += std::abs(weights[i]);
+
+  if (maximumError > 0.0 && absoluteWeightSum > 0.0)
+    m_ApproximationThreshold = maximumError / absoluteWeightSum;
+
+  std::vector<std::size_t> order(numberOfCenters);
+  std::iota(order.begin(), order.end(), 0);
+
+  if (m_ApproximationThreshold > 0.0)
+  {
+    this->BuildNode(centers, weights, order, 0, numberOfCenters, 0);
+  }
+  else
+  {
+    // exact evaluation: a single leaf keeping the original order of the centers
+    Node root;
+    std::fill_n(root.Center, 3, 0.0);
+    root.Radius = 0.0;
+    root.WeightSum = 0.0;
+    std::fill_n(root.Dipole, 3, 0.0);
+    std::fill_n(root.Quadrupole, 6, 0.0);
+    root.Trace = 0.0;
+    root.Begin = 0;
+    root.End = numberOfCenters;
+    m_Nodes.push_back(root);
+  }
+
+  m_X.resize(numberOfCenters);
+  m_Y.resize(numberOfCenters);
+  m_Z.resize(numberOfCenters);
+  m_W.resize(numberOfCenters);
+  for (std::size_t i = 0; i < numberOfCenters; ++i)
+  {
+    m_X[i] = centers[order[i]][0];
+    m_Y[i] = centers[order[i]][1];
+    m_Z[i] = centers[order[i]][2];
+    m_W[i] = weights[order[i]];
+  }
+}
+
+unsigned int mitk::RadialBasisFunctionOctree::BuildNode(const std::vector<PointType> &centers,
+                                                        const Eigen::VectorXd &weights,
+                                                        std::vector<std::size_t> &order,
+                                                        std::size_t begin,
+                                                        std::size_t end,
+                                                        unsigned int depth)
+{
+  Node node;
+  node.Begin = begin;
+  node.End = end;
+
+  // expansion point and bounding box
+  PointType minimum = centers[order[begin]];
+  PointType maximum = minimum;
+  PointType mean(0.0);
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    const PointType &center = centers[order[i]];
+    mean += center;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      minimum[dim] = std::min(minimum[dim], center[dim]);
+      maximum[dim] = std::max(maximum[dim], center[dim]);
+    }
+  }
+  mean /= static_cast<double>(end - begin);
+  std::copy(mean.begin(), mean.end(), node.Center);
+
+  // moments relative to the expansion point
+  node.Radius = 0.0;
+  node.WeightSum = 0.0;
+  node.Trace = 0.0;
+  std::fill_n(node.Dipole, 3, 0.0);
+  std::fill_n(node.Quadrupole, 6, 0.0);
+  for (std::size_t i = begin; i < end; ++i)
+  {
+    const PointType d = centers[order[i]] - mean;
+    const double w = weights[order[i]];
+
+    node.Radius = std::max(node.Radius, d.two_norm());
+    node.WeightSum += w;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      node.Dipole[dim] += w * d[dim];
+    node.Quadrupole[0] += w * d[0] * d[0];
+    node.Quadrupole[1] += w * d[0] * d[1];
+    node.Quadrupole[2] += w * d[0] * d[2];
+    node.Quadrupole[3] += w * d[1] * d[1];
+    node.Quadrupole[4] += w * d[1] * d[2];
+    node.Quadrupole[5] += w * d[2] * d[2];
+  }
+  node.Trace = node.Quadrupole[0] + node.Quadrupole[3] + node.Quadrupole[5];
+
+  const auto nodeIndex = static_cast<unsigned int>(m_Nodes.size());
+  m_Nodes.push_back(node);
+
+  if (end - begin <= m_MaximumNumberOfCentersPerLeaf || node.Radius == 0.0 || depth >= MaximumDepth)
+    return nodeIndex;
+
+  // split the centers into the octants of the bounding box
+  const PointType split = (minimum + maximum) * 0.5;
+  auto octant = [&centers, &split](std::size_t index) {
+    const PointType &center = centers[index];
+    return (center[0] > split[0] ? 1 : 0) | (center[1] > split[1] ? 2 : 0) | (center[2] > split[2] ? 4 : 0);
+  };
+  std::sort(order.begin() + begin, order.begin() + end, [&octant](std::size_t a, std::size_t b) {
+    return octant(a) < octant(b);
+  });
+
+  std::vector<unsigned int> children;
+  std::size_t childBegin = begin;
+  while (childBegin < end)
+  {
+    const int currentOctant = octant(order[childBegin]);
+    std::size_t childEnd = childBegin + 1;
+    while (childEnd < end && octant(order[childEnd]) == currentOctant)
+      ++childEnd;
+
+    children.push_back(this->BuildNode(centers, weights, order, childBegin, childEnd, depth + 1));
+    childBegin = childEnd;
+  }
+  m_Nodes[nodeIndex].Children = children;
+
+  return nodeIndex;
+}
+
+double mitk::RadialBasisFunctionOctree::EvaluateExact(const Node &node, const PointType &p) const
+{
+  double value = 0.0;
+  for (std::size_t i = node.Begin; i < node.End; ++i)
+  {
+    const double dx = p[0] - m_X[i];
+    const double dy = p[1] - m_Y[i];
+    const double dz = p[2] - m_Z[i];
+    value = value + std::sqrt(dx * dx + dy * dy + dz * dz) * m_W[i];
+  }
+  return value;
+}
+
+double mitk::RadialBasisFunctionOctree::Evaluate(const PointType &p) const
+{
+  if (m_ApproximationThreshold <= 0.0)
+    return this->EvaluateExact(m_Nodes.front(), p);
+
+  double value = 0.0;
+
+  std::array<unsigned int, 8 * (MaximumDepth + 1)> stack;
+  std::size_t stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0)
+  {
+    const Node &node = m_Nodes[stack[--stackSize]];
+
+    const double rx = p[0] - node.Center[0];
+    const double ry = p[1] - node.Center[1];
+    const double rz = p[2] - node.Center[2];
+    const double r = std::sqrt(rx * rx + ry * ry + rz * rz);
+    const double gap = r - node.Radius;
+
+    if (r > 2.0 * node.Radius &&
+        node.Radius * node.Radius * node.Radius <= m_ApproximationThreshold * gap * gap)
+    {
+      // |p - c| = r - u.d + (|d|^2 - (u.d)^2) / (2r) + O(|d|^3 / r^2) with u = (p - Center) / r, d = c - Center
+      const double ux = rx / r;
+      const double uy = ry / r;
+      const double uz = rz / r;
+      const double *q = node.Quadrupole;
+      const double uQu = q[0] * ux * ux + q[3] * uy * uy + q[5] * uz * uz +
+                         2.0 * (q[1] * ux * uy + q[2] * ux * uz + q[4] * uy * uz);
+
+      value += node.WeightSum * r - (ux * node.Dipole[0] + uy * node.Dipole[1] + uz * node.Dipole[2]) +
+               (node.Trace - uQu) / (2.0 * r);
+    }
+    else if (node.Children.empty())
+    {
+      value += this->EvaluateExact(node, p);
+    }
+    else
+    {
+      for (unsigned int child : node.Children)
+        stack[stackSize++] = child;
+    }
+  }
+
+  return value;
+}
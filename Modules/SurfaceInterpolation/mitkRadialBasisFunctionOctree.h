@@ -0,0 +1,105 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkRadialBasisFunctionOctree_h_Included
+#define mitkRadialBasisFunctionOctree_h_Included
+
+#include <MitkSurfaceInterpolationExports.h>
+
+#include "vnl/vnl_vector_fixed.h"
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Evaluates the radial basis function f(p) = sum_i w_i * |p - c_i| used by
+           mitk::CreateDistanceImageFromSurfaceFilter.
+
+    The centers are clustered in an octree. For each octree node the weight sum and the first and second moments of
+    the weighted centers are stored, which allows to approximate the contribution of all centers of a node by a second
+    order multipole expansion. A node is approximated instead of visiting its centers if the remainder of the expansion
+    guarantees that the error of the complete sum stays below the given maximum error. Hence the cost of an evaluation
+    decreases from O(centers) to roughly O(log(centers)) for points that are far away from most of the centers.
+
+    With a maximum error of 0 no approximation is done and all centers are summed up in their original order.
+
+    Evaluate() does not modify the octree and may be called from several threads at once.
+
+    \ingroup Process
+  */
+  class MITKSURFACEINTERPOLATION_EXPORT RadialBasisFunctionOctree
+  {
+  public:
+    typedef vnl_vector_fixed<double, 3> PointType;
+
+    /**
+      \param centers the centers c_i of the radial basis function
+      \param weights the weights w_i, one per center
+      \param maximumError the maximum absolute error of Evaluate(), 0 for an exact evaluation
+      \param maximumNumberOfCentersPerLeaf nodes with more centers are split further
+    */
+    RadialBasisFunctionOctree(const std::vector<PointType> &centers,
+                              const Eigen::VectorXd &weights,
+                              double maximumError,
+                              unsigned int maximumNumberOfCentersPerLeaf = 32);
+
+    double Evaluate(const PointType &p) const;
+
+    unsigned int GetNumberOfNodes() const { return static_cast<unsigned int>(m_Nodes.size()); }
+
+  private:
+    struct Node
+    {
+      // expansion point (mean of the centers) and radius of the sphere around it containing all centers
+      double Center[3];
+      double Radius;
+
+      // moments of the weighted centers relative to Center
+      double WeightSum;
+      double Dipole[3];
+      double Quadrupole[6]; // xx, xy, xz, yy, yz, zz
+      double Trace;
+
+      // range of the centers of this node in the sorted center arrays
+      std::size_t Begin;
+      std::size_t End;
+
+      std::vector<unsigned int> Children;
+    };
+
+    unsigned int BuildNode(const std::vector<PointType> &centers,
+                           const Eigen::VectorXd &weights,
+                           std::vector<std::size_t> &order,
+                           std::size_t begin,
+                           std::size_t end,
+                           unsigned int depth);
+
+    double EvaluateExact(const Node &node, const PointType &p) const;
+
+    std::vector<Node> m_Nodes;
+
+    // centers and weights in octree order
+    std::vector<double> m_X;
+    std::vector<double> m_Y;
+    std::vector<double> m_Z;
+    std::vector<double> m_W;
+
+    unsigned int m_MaximumNumberOfCentersPerLeaf;
+    // a node may be approximated if Radius^3 <= m_ApproximationThreshold * (distance - Radius)^2
+    double m_ApproximationThreshold;
+  };
+} // namespace mitk
+
+#endif
@@ -0,0 +1,76 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkRadialBasisFunctionSystem.h"
+
+#include <mitkExceptionMacro.h>
+
+void mitk::RadialBasisFunctionSystem::Factorize(const Eigen::MatrixXd &matrix)
+{
+  m_Levels.clear();
+  m_Factorization.compute(matrix);
+}
+
+void mitk::RadialBasisFunctionSystem::Append(const Eigen::MatrixXd &border, const Eigen::MatrixXd &corner)
+{
+  if (this->GetFactorizedSize() == 0)
+    mitkThrow() << "The equation system has to be factorized before centers can be appended.";
+
+  if (border.rows() != this->GetSize() || border.cols() != corner.rows() || corner.rows() != corner.cols())
+    mitkThrow() << "The appended blocks do not match the equation system of size " << this->GetSize() << ".";
+
+  if (corner.rows() == 0)
+    return;
+
+  Level level;
+  level.Border = border;
+  level.Correction = this->Solve(border, m_Levels.size());
+  level.SchurComplement.compute(corner - border.transpose() * level.Correction);
+
+  m_Levels.push_back(std::move(level));
+}
+
+Eigen::VectorXd mitk::RadialBasisFunctionSystem::Solve(const Eigen::VectorXd &rhs) const
+{
+  if (rhs.rows() != this->GetSize())
+    mitkThrow() << "The right hand side does not match the equation system of size " << this->GetSize() << ".";
+
+  return this->Solve(Eigen::MatrixXd(rhs), m_Levels.size());
+}
+
+Eigen::MatrixXd mitk::RadialBasisFunctionSystem::Solve(const Eigen::MatrixXd &rhs, std::size_t numberOfLevels) const
+{
+  if (numberOfLevels == 0)
+    return m_Factorization.solve(rhs);
+
+  // | A    B | |x1|   |r1|
+  // | B^T  C | |x2| = |r2|   =>   x2 = S^-1 (r2 - B^T A^-1 r1),   x1 = A^-1 r1 - A^-1 B x2
+  const Level &level = m_Levels[numberOfLevels - 1];
+  const Eigen::Index previousSize = level.Border.rows();
+  const Eigen::Index appendedSize = level.Border.cols();
+
+  Eigen::MatrixXd result(rhs.rows(), rhs.cols());
+  const Eigen::MatrixXd previousSolution = this->Solve(rhs.topRows(previousSize), numberOfLevels - 1);
+  result.bottomRows(appendedSize) =
+    level.SchurComplement.solve(rhs.bottomRows(appendedSize) - level.Border.transpose() * previousSolution);
+  result.topRows(previousSize) = previousSolution - level.Correction * result.bottomRows(appendedSize);
+
+  return result;
+}
+
+Eigen::Index mitk::RadialBasisFunctionSystem::GetSize() const
+{
+  Eigen::Index size = m_Factorization.rows();
+  for (const auto &level : m_Levels)
+    size += level.Border.cols();
+  return size;
+}
@@ -0,0 +1,85 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkRadialBasisFunctionSystem_h_Included
+#define mitkRadialBasisFunctionSystem_h_Included
+
+#include <MitkSurfaceInterpolationExports.h>
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Solves the symmetric equation system of a radial basis function interpolation and allows to append
+           centers without factorizing the complete system matrix again.
+
+    The system matrix A of the centers known so far is factorized once by Factorize(). If further centers are
+    appended, the system grows to
+
+        | A    B |
+        | B^T  C |
+
+    where B holds the basis function values between the known and the new centers and C those between the new
+    centers. Append() only factorizes the Schur complement S = C - B^T A^-1 B of the new block, which costs
+    O(n^2 k) for n known and k new centers instead of O(n^3) for a new factorization of the grown matrix.
+
+    Each Append() adds a level that has to be visited by Solve(). Callers should therefore call Factorize() again
+    once the appended centers make up a considerable part of the system.
+
+    \ingroup Process
+  */
+  class MITKSURFACEINTERPOLATION_EXPORT RadialBasisFunctionSystem
+  {
+  public:
+    /**
+      \brief Factorizes the complete system matrix and discards all appended levels.
+    */
+    void Factorize(const Eigen::MatrixXd &matrix);
+
+    /**
+      \brief Appends new centers to the system.
+      \param border the basis function values between the GetSize() known centers (rows) and the new centers (columns)
+      \param corner the basis function values between the new centers
+      \throw mitk::Exception if the dimensions do not match the current system
+    */
+    void Append(const Eigen::MatrixXd &border, const Eigen::MatrixXd &corner);
+
+    Eigen::VectorXd Solve(const Eigen::VectorXd &rhs) const;
+
+    /** \brief Number of centers of the complete system including all appended levels. */
+    Eigen::Index GetSize() const;
+
+    /** \brief Number of centers covered by the last call to Factorize(). */
+    Eigen::Index GetFactorizedSize() const { return m_Factorization.rows(); }
+
+    unsigned int GetNumberOfLevels() const { return static_cast<unsigned int>(m_Levels.size()); }
+
+  private:
+    struct Level
+    {
+      Eigen::MatrixXd Border;
+      // A^-1 B, with A being the system of all previous levels
+      Eigen::MatrixXd Correction;
+      Eigen::PartialPivLU<Eigen::MatrixXd> SchurComplement;
+    };
+
+    Eigen::MatrixXd Solve(const Eigen::MatrixXd &rhs, std::size_t numberOfLevels) const;
+
+    Eigen::PartialPivLU<Eigen::MatrixXd> m_Factorization;
+    std::vector<Level> m_Levels;
+  };
+} // namespace mitk
+
+#endif
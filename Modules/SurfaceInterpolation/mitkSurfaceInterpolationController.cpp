@@ -19,6 +19,16 @@ found in the LICENSE file.
 //#include "vtkXMLPolyDataWriter.h"
 #include "vtkPolyDataWriter.h"
 
+// Check whether the normals of the given contours are parallel but not necessarily of the same orientation
+bool ContoursParallel(mitk::SurfaceInterpolationController::ContourPositionInformation leftHandSide,
+                      mitk::SurfaceInterpolationController::ContourPositionInformation rightHandSide)
+{
+  double lengthLHS = leftHandSide.contourNormal.GetNorm();
+  double lengthRHS = rightHandSide.contourNormal.GetNorm();
+  double dot = vtkMath::Dot(leftHandSide.contourNormal.GetDataPointer(), rightHandSide.contourNormal.GetDataPointer());
+  return mitk::Equal(fabs(lengthLHS * lengthRHS), fabs(dot), 0.001);
+}
+
 // Check whether the given contours are coplanar
 bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInformation leftHandSide,
                       mitk::SurfaceInterpolationController::ContourPositionInformation rightHandSide)
@@ -42,18 +52,8 @@ bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInfor
   n[2] = rightHandSide.contourNormal[2];
   double dot = vtkMath::Dot(n, vec);
 
-  double n2[3];
-  n2[0] = leftHandSide.contourNormal[0];
-  n2[1] = leftHandSide.contourNormal[1];
-  n2[2] = leftHandSide.contourNormal[2];
-
   // The normals of both contours have to be parallel but not of the same orientation
-  double lengthLHS = leftHandSide.contourNormal.GetNorm();
-  double lengthRHS = rightHandSide.contourNormal.GetNorm();
-  double dot2 = vtkMath::Dot(n, n2);
-  bool contoursParallel = mitk::Equal(fabs(lengthLHS * lengthRHS), fabs(dot2), 0.001);
-
-  if (mitk::Equal(dot, 0.0, 0.001) && contoursParallel)
+  if (mitk::Equal(dot, 0.0, 0.001) && ContoursParallel(leftHandSide, rightHandSide))
     return true;
   else
     return false;
@@ -74,20 +74,26 @@ mitk::SurfaceInterpolationController::ContourPositionInformation CreateContourPo
 }
 
 mitk::SurfaceInterpolationController::SurfaceInterpolationController()
-  : m_SelectedSegmentation(nullptr), m_CurrentTimeStep(0)
+  : m_InterpolationRequest(0),
+    m_MinSpacing(-1),
+    m_MaxSpacing(-1),
+    m_SelectedSegmentation(nullptr),
+    m_CurrentTimeStep(0)
 {
   m_DistanceImageSpacing = 0.0;
   m_ReduceFilter = ReduceContourSetFilter::New();
-  m_NormalsFilter = ComputeContourSetNormalsFilter::New();
   m_InterpolateSurfaceFilter = CreateDistanceImageFromSurfaceFilter::New();
   // m_TimeSelector = ImageTimeSelector::New();
 
   m_ReduceFilter->SetUseProgressBar(false);
   //  m_ReduceFilter->SetProgressStepSize(1);
-  m_NormalsFilter->SetUseProgressBar(true);
-  m_NormalsFilter->SetProgressStepSize(1);
   m_InterpolateSurfaceFilter->SetUseProgressBar(true);
   m_InterpolateSurfaceFilter->SetProgressStepSize(7);
+  // an error of a hundredth of a voxel is not visible in the interpolated surface, but keeps the interpolation of
+  // many contours interactive
+  m_InterpolateSurfaceFilter->SetMaximumInterpolationError(0.01);
+  // adding a contour within the bounds of the others only appends its points to the equation system
+  m_InterpolateSurfaceFilter->ReuseFactorizationOn();
 
   m_Contours = Surface::New();
 
@@ -174,15 +180,20 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
     }
   }
 
+  // The result of a running interpolation is outdated by the new contour
+  this->CancelInterpolation();
+
   // Don't save a new empty contour
   if (pos == -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
+    std::lock_guard<std::mutex> lock(m_ContourMutex);
     m_ReduceFilter->SetInput(m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].size(),
                              newContour);
     m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].push_back(contourInfo);
   }
   else if (pos != -1 && newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
   {
+    std::lock_guard<std::mutex> lock(m_ContourMutex);
     m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].at(pos) = contourInfo;
     m_ReduceFilter->SetInput(pos, newContour);
   }
@@ -211,7 +222,11 @@ bool mitk::SurfaceInterpolationController::RemoveContour(ContourPositionInformat
     ContourPositionInformation currentContour = (*it);
     if (ContoursCoplanar(currentContour, contourInfo))
     {
-      m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].erase(it);
+      this->CancelInterpolation();
+      {
+        std::lock_guard<std::mutex> lock(m_ContourMutex);
+        m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].erase(it);
+      }
       this->ReinitializeInterpolation();
       return true;
     }
@@ -261,34 +276,44 @@ unsigned int mitk::SurfaceInterpolationController::GetNumberOfContours()
 
 void mitk::SurfaceInterpolationController::Interpolate()
 {
-  m_ReduceFilter->Update();
+  const unsigned int interpolationRequest = ++m_InterpolationRequest;
+
+  // A previous interpolation stops at its next check, wait until it does not use the filters anymore
+  std::lock_guard<std::mutex> interpolationLock(m_InterpolationMutex);
+  if (this->IsInterpolationCancelled(interpolationRequest))
+    return;
 
-  m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-  if (m_CurrentNumberOfReducedContours == 1)
+  // Work on a copy of the contours and settings, so that they can be changed while the interpolation is running
+  ContourPositionInformationList contours;
+  mitk::Image::Pointer segmentation;
+  unsigned int timeStep;
+  double minSpacing;
+  double maxSpacing;
   {
-    vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-    if (tmp == nullptr)
-    {
-      m_CurrentNumberOfReducedContours = 0;
-    }
+    std::lock_guard<std::mutex> lock(m_ContourMutex);
+    if (!m_SelectedSegmentation || m_CurrentTimeStep >= m_SelectedSegmentation->GetTimeSteps())
+      return;
+
+    segmentation = m_SelectedSegmentation;
+    timeStep = m_CurrentTimeStep;
+    contours = m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep];
+    minSpacing = m_MinSpacing;
+    maxSpacing = m_MaxSpacing;
   }
 
   mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(m_CurrentTimeStep);
+  timeSelector->SetInput(segmentation);
+  timeSelector->SetTimeNr(timeStep);
   timeSelector->SetChannelNr(0);
   timeSelector->Update();
   mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
 
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-  for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
-  {
-    mitk::Surface::Pointer reducedContour = m_ReduceFilter->GetOutput(i);
-    reducedContour->DisconnectPipeline();
-    m_NormalsFilter->SetInput(i, reducedContour);
-    m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
-  }
+  std::vector<Surface::Pointer> reducedContours =
+    this->ReduceContours(contours, refSegImage, minSpacing, maxSpacing, interpolationRequest);
+  if (this->IsInterpolationCancelled(interpolationRequest))
+    return;
 
+  m_CurrentNumberOfReducedContours = reducedContours.size();
   if (m_CurrentNumberOfReducedContours < 2)
   {
     // If no interpolation is possible reset the interpolation result
@@ -296,6 +321,12 @@ void mitk::SurfaceInterpolationController::Interpolate()
     return;
   }
 
+  m_InterpolateSurfaceFilter->Reset();
+  for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
+  {
+    m_InterpolateSurfaceFilter->SetInput(i, reducedContours[i]);
+  }
+
   // Setting up progress bar
   mitk::ProgressBar::GetInstance()->AddStepsToDo(10);
 
@@ -305,19 +336,32 @@ void mitk::SurfaceInterpolationController::Interpolate()
   imageToSurfaceFilter->SetThreshold(0);
   imageToSurfaceFilter->SetSmooth(true);
   imageToSurfaceFilter->SetSmoothIteration(20);
-  imageToSurfaceFilter->Update();
+
+  try
+  {
+    imageToSurfaceFilter->Update();
+  }
+  catch (const itk::ProcessAborted &)
+  {
+    // The previous interpolation result is kept, a new interpolation has been or will be requested
+  }
+
+  if (this->IsInterpolationCancelled(interpolationRequest))
+  {
+    mitk::ProgressBar::GetInstance()->Progress(20);
+    return;
+  }
 
   mitk::Surface::Pointer interpolationResult = mitk::Surface::New();
-  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), m_CurrentTimeStep);
+  interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), timeStep);
   m_InterpolationResult = interpolationResult;
 
   m_DistanceImageSpacing = m_InterpolateSurfaceFilter->GetDistanceImageSpacing();
 
   vtkSmartPointer<vtkAppendPolyData> polyDataAppender = vtkSmartPointer<vtkAppendPolyData>::New();
-  for (unsigned int i = 0; i < m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].size(); i++)
+  for (unsigned int i = 0; i < contours.size(); i++)
   {
-    polyDataAppender->AddInputData(
-      m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep].at(i).contour->GetVtkPolyData());
+    polyDataAppender->AddInputData(contours.at(i).contour->GetVtkPolyData());
   }
   polyDataAppender->Update();
   m_Contours->SetVtkPolyData(polyDataAppender->GetOutput());
@@ -328,6 +372,158 @@ void mitk::SurfaceInterpolationController::Interpolate()
   m_InterpolationResult->DisconnectPipeline();
 }
 
+void mitk::SurfaceInterpolationController::CancelInterpolation()
+{
+  ++m_InterpolationRequest;
+  m_InterpolateSurfaceFilter->AbortGenerateDataOn();
+}
+
+bool mitk::SurfaceInterpolationController::IsInterpolationCancelled(unsigned int interpolationRequest) const
+{
+  return m_InterpolationRequest != interpolationRequest;
+}
+
+std::vector<mitk::Surface::Pointer> mitk::SurfaceInterpolationController::ReduceContours(
+  const ContourPositionInformationList &contours,
+  mitk::Image *segmentationImage,
+  double minSpacing,
+  double maxSpacing,
+  unsigned int interpolationRequest)
+{
+  std::vector<Surface::Pointer> reducedContours;
+
+  auto createReduceFilter = [minSpacing, maxSpacing]() {
+    ReduceContourSetFilter::Pointer reduceFilter = ReduceContourSetFilter::New();
+    reduceFilter->SetMinSpacing(minSpacing);
+    reduceFilter->SetMaxSpacing(maxSpacing);
+    return reduceFilter;
+  };
+
+  auto createNormalsFilter = [maxSpacing, segmentationImage]() {
+    ComputeContourSetNormalsFilter::Pointer normalsFilter = ComputeContourSetNormalsFilter::New();
+    normalsFilter->SetSegmentationBinaryImage(segmentationImage);
+    // the normals filter keeps its default until the spacing of the segmentation is known
+    if (maxSpacing > 0)
+      normalsFilter->SetMaxSpacing(maxSpacing);
+    return normalsFilter;
+  };
+
+  bool contoursParallel = true;
+  for (const auto &contour : contours)
+  {
+    if (!ContoursParallel(contours.front(), contour))
+    {
+      contoursParallel = false;
+      break;
+    }
+  }
+
+  if (!contoursParallel)
+  {
+    // Contours of different orientations may intersect each other, which has to be considered when reducing them.
+    // Hence all contours are reduced together and the results cannot be cached per contour.
+    {
+      std::lock_guard<std::mutex> lock(m_ContourMutex);
+      m_ReducedContours.clear();
+    }
+
+    ReduceContourSetFilter::Pointer reduceFilter = createReduceFilter();
+    for (unsigned int i = 0; i < contours.size(); i++)
+    {
+      reduceFilter->SetInput(i, contours[i].contour);
+    }
+    reduceFilter->Update();
+
+    if (this->IsInterpolationCancelled(interpolationRequest))
+      return reducedContours;
+
+    ComputeContourSetNormalsFilter::Pointer normalsFilter = createNormalsFilter();
+    unsigned int numberOfReducedContours = 0;
+    for (unsigned int i = 0; i < reduceFilter->GetNumberOfOutputs(); i++)
+    {
+      mitk::Surface::Pointer reducedContour = reduceFilter->GetOutput(i);
+      if (reducedContour->GetVtkPolyData()->GetNumberOfPolys() == 0)
+        continue;
+
+      reducedContour->DisconnectPipeline();
+      normalsFilter->SetInput(numberOfReducedContours++, reducedContour);
+    }
+
+    if (numberOfReducedContours == 0)
+      return reducedContours;
+
+    normalsFilter->Update();
+    for (unsigned int i = 0; i < numberOfReducedContours; i++)
+    {
+      mitk::Surface::Pointer contourWithNormals = normalsFilter->GetOutput(i);
+      contourWithNormals->DisconnectPipeline();
+      reducedContours.push_back(contourWithNormals);
+    }
+    return reducedContours;
+  }
+
+  // Parallel contours do not intersect each other, so each contour can be reduced on its own and only contours that
+  // were added or changed since the last interpolation have to be processed
+  ReducedContourMap usedContours;
+  for (const auto &contourInfo : contours)
+  {
+    if (this->IsInterpolationCancelled(interpolationRequest))
+      return std::vector<Surface::Pointer>();
+
+    const Surface *contour = contourInfo.contour;
+    ReducedContour reducedContour;
+
+    bool isCached = false;
+    {
+      std::lock_guard<std::mutex> lock(m_ContourMutex);
+      auto cacheIter = m_ReducedContours.find(contour);
+      if (cacheIter != m_ReducedContours.end())
+      {
+        reducedContour = cacheIter->second;
+        isCached = true;
+      }
+    }
+
+    if (!isCached)
+    {
+      reducedContour.Contour = contour;
+
+      ReduceContourSetFilter::Pointer reduceFilter = createReduceFilter();
+      reduceFilter->SetInput(0, contour);
+      reduceFilter->Update();
+
+      mitk::Surface::Pointer reducedSurface = reduceFilter->GetOutput(0);
+      if (reducedSurface->GetVtkPolyData()->GetNumberOfPolys() != 0)
+      {
+        reducedSurface->DisconnectPipeline();
+
+        ComputeContourSetNormalsFilter::Pointer normalsFilter = createNormalsFilter();
+        normalsFilter->SetInput(0, reducedSurface);
+        normalsFilter->Update();
+
+        reducedContour.ContourWithNormals = normalsFilter->GetOutput(0);
+        reducedContour.ContourWithNormals->DisconnectPipeline();
+      }
+
+      // Publish the result right away, so that it is kept even if this interpolation is cancelled
+      std::lock_guard<std::mutex> lock(m_ContourMutex);
+      m_ReducedContours[contour] = reducedContour;
+    }
+
+    usedContours[contour] = reducedContour;
+    if (reducedContour.ContourWithNormals.IsNotNull())
+      reducedContours.push_back(reducedContour.ContourWithNormals);
+  }
+
+  // Forget the contours that are not part of the interpolation anymore
+  {
+    std::lock_guard<std::mutex> lock(m_ContourMutex);
+    m_ReducedContours.swap(usedContours);
+  }
+
+  return reducedContours;
+}
+
 mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetInterpolationResult()
 {
   return m_InterpolationResult;
@@ -346,16 +542,35 @@ void mitk::SurfaceInterpolationController::SetDataStorage(DataStorage::Pointer d
 void mitk::SurfaceInterpolationController::SetMinSpacing(double minSpacing)
 {
   m_ReduceFilter->SetMinSpacing(minSpacing);
+
+  std::lock_guard<std::mutex> lock(m_ContourMutex);
+  if (m_MinSpacing != minSpacing)
+  {
+    // The reduced contours depend on the spacing
+    this->CancelInterpolation();
+    m_MinSpacing = minSpacing;
+    m_ReducedContours.clear();
+  }
 }
 
 void mitk::SurfaceInterpolationController::SetMaxSpacing(double maxSpacing)
 {
   m_ReduceFilter->SetMaxSpacing(maxSpacing);
-  m_NormalsFilter->SetMaxSpacing(maxSpacing);
+
+  std::lock_guard<std::mutex> lock(m_ContourMutex);
+  if (m_MaxSpacing != maxSpacing)
+  {
+    // The reduced contours and their normals depend on the spacing
+    this->CancelInterpolation();
+    m_MaxSpacing = maxSpacing;
+    m_ReducedContours.clear();
+  }
 }
 
 void mitk::SurfaceInterpolationController::SetDistanceImageVolume(unsigned int distImgVolume)
 {
+  this->CancelInterpolation();
+  std::lock_guard<std::mutex> interpolationLock(m_InterpolationMutex);
   m_InterpolateSurfaceFilter->SetDistanceImageVolume(distImgVolume);
 }
 
@@ -371,6 +586,7 @@ mitk::Image *mitk::SurfaceInterpolationController::GetImage()
 
 double mitk::SurfaceInterpolationController::EstimatePortionOfNeededMemory()
 {
+  m_ReduceFilter->Update();
   double numberOfPointsAfterReduction = m_ReduceFilter->GetNumberOfPointsAfterReduction() * 3;
   double sizeOfPoints = pow(numberOfPointsAfterReduction, 2) * sizeof(double);
   double totalMem = mitk::MemoryUtilities::GetTotalSizeOfPhysicalRam();
@@ -400,6 +616,9 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
   if (currentSegmentationImage.GetPointer() == m_SelectedSegmentation)
     return;
 
+  this->CancelInterpolation();
+  std::unique_lock<std::mutex> lock(m_ContourMutex);
+
   if (currentSegmentationImage.IsNull())
   {
     m_SelectedSegmentation = nullptr;
@@ -426,6 +645,7 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
       m_SelectedSegmentation, m_SelectedSegmentation->AddObserver(itk::DeleteEvent(), command)));
   }
 
+  lock.unlock();
   this->ReinitializeInterpolation();
 }
 
@@ -446,26 +666,23 @@ bool mitk::SurfaceInterpolationController::ReplaceInterpolationSession(mitk::Ima
   if (it == m_ListOfInterpolationSessions.end())
     return false;
 
-  ContourPositionInformationVec2D oldList = (*it).second;
-  m_ListOfInterpolationSessions.insert(
-    std::pair<mitk::Image *, ContourPositionInformationVec2D>(newSession.GetPointer(), oldList));
+  this->CancelInterpolation();
+  {
+    std::lock_guard<std::mutex> lock(m_ContourMutex);
+    ContourPositionInformationVec2D oldList = (*it).second;
+    m_ListOfInterpolationSessions.insert(
+      std::pair<mitk::Image *, ContourPositionInformationVec2D>(newSession.GetPointer(), oldList));
+
+    if (m_SelectedSegmentation == oldSession)
+      m_SelectedSegmentation = newSession;
+  }
+
   itk::MemberCommand<SurfaceInterpolationController>::Pointer command =
     itk::MemberCommand<SurfaceInterpolationController>::New();
   command->SetCallbackFunction(this, &SurfaceInterpolationController::OnSegmentationDeleted);
   m_SegmentationObserverTags.insert(
     std::pair<mitk::Image *, unsigned long>(newSession, newSession->AddObserver(itk::DeleteEvent(), command)));
 
-  if (m_SelectedSegmentation == oldSession)
-    m_SelectedSegmentation = newSession;
-
-  mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
-  timeSelector->SetInput(m_SelectedSegmentation);
-  timeSelector->SetTimeNr(m_CurrentTimeStep);
-  timeSelector->SetChannelNr(0);
-  timeSelector->Update();
-  mitk::Image::Pointer refSegImage = timeSelector->GetOutput();
-  m_NormalsFilter->SetSegmentationBinaryImage(refSegImage);
-
   this->RemoveInterpolationSession(oldSession);
   return true;
 }
@@ -479,9 +696,10 @@ void mitk::SurfaceInterpolationController::RemoveInterpolationSession(mitk::Imag
 {
   if (segmentationImage)
   {
+    std::lock_guard<std::mutex> lock(m_ContourMutex);
     if (m_SelectedSegmentation == segmentationImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
+      this->CancelInterpolation();
       m_SelectedSegmentation = nullptr;
     }
     m_ListOfInterpolationSessions.erase(segmentationImage);
@@ -507,8 +725,12 @@ void mitk::SurfaceInterpolationController::RemoveAllInterpolationSessions()
   }
 
   m_SegmentationObserverTags.clear();
+
+  this->CancelInterpolation();
+  std::lock_guard<std::mutex> lock(m_ContourMutex);
   m_SelectedSegmentation = nullptr;
   m_ListOfInterpolationSessions.clear();
+  m_ReducedContours.clear();
 }
 
 void mitk::SurfaceInterpolationController::ReinitializeInterpolation(mitk::Surface::Pointer contours)
@@ -625,9 +847,10 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
   auto *tempImage = dynamic_cast<mitk::Image *>(const_cast<itk::Object *>(caller));
   if (tempImage)
   {
+    std::lock_guard<std::mutex> lock(m_ContourMutex);
     if (m_SelectedSegmentation == tempImage)
     {
-      m_NormalsFilter->SetSegmentationBinaryImage(nullptr);
+      this->CancelInterpolation();
       m_SelectedSegmentation = nullptr;
     }
     m_SegmentationObserverTags.erase(tempImage);
@@ -637,9 +860,11 @@ void mitk::SurfaceInterpolationController::OnSegmentationDeleted(const itk::Obje
 
 void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
 {
-  // If session has changed reset the pipeline
+  // If session has changed reset the pipeline. A running interpolation is cancelled and has to stop using the filters
+  // before they can be reset.
+  this->CancelInterpolation();
+  std::unique_lock<std::mutex> interpolationLock(m_InterpolationMutex);
   m_ReduceFilter->Reset();
-  m_NormalsFilter->Reset();
   m_InterpolateSurfaceFilter->Reset();
 
   itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
@@ -659,6 +884,7 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
     unsigned int size = m_ListOfInterpolationSessions[m_SelectedSegmentation].size();
     if (size != numTimeSteps)
     {
+      std::lock_guard<std::mutex> lock(m_ContourMutex);
       m_ListOfInterpolationSessions[m_SelectedSegmentation].resize(numTimeSteps);
     }
 
@@ -670,26 +896,12 @@ void mitk::SurfaceInterpolationController::ReinitializeInterpolation()
         m_ReduceFilter->SetInput(c,
                                  m_ListOfInterpolationSessions[m_SelectedSegmentation][m_CurrentTimeStep][c].contour);
       }
-
-      m_ReduceFilter->Update();
-
-      m_CurrentNumberOfReducedContours = m_ReduceFilter->GetNumberOfOutputs();
-      if (m_CurrentNumberOfReducedContours == 1)
-      {
-        vtkPolyData *tmp = m_ReduceFilter->GetOutput(0)->GetVtkPolyData();
-        if (tmp == nullptr)
-        {
-          m_CurrentNumberOfReducedContours = 0;
-        }
-      }
-
-      for (unsigned int i = 0; i < m_CurrentNumberOfReducedContours; i++)
-      {
-        m_NormalsFilter->SetInput(i, m_ReduceFilter->GetOutput(i));
-        m_InterpolateSurfaceFilter->SetInput(i, m_NormalsFilter->GetOutput(i));
-      }
+      // The reduced contours are computed by Interpolate(), m_ReduceFilter is only updated to estimate the memory
+      // needed for the interpolation
     }
 
+    // observers may start a new interpolation
+    interpolationLock.unlock();
     Modified();
   }
 }
@@ -43,6 +43,9 @@ found in the LICENSE file.
 
 #include "mitkProgressBar.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace mitk
 {
   class MITKSURFACEINTERPOLATION_EXPORT SurfaceInterpolationController : public itk::Object
@@ -117,9 +120,23 @@ namespace mitk
 
     /**
      * Interpolates the 3D surface from the given extracted contours
+     *
+     * The reduced contours and their normals are cached, so only contours that were added or changed since the last
+     * interpolation are processed again. If the new contours lie within the bounds of the others, the equation system
+     * of the last interpolation is extended by their points instead of being set up from scratch.
+     *
+     * Interpolate() may be called from a worker thread. It works on a copy of the contours of the current session and
+     * only replaces the interpolation result when it has finished. Changing the contours or calling
+     * CancelInterpolation() cancels a running interpolation, in which case the previous result is kept.
      */
     void Interpolate();
 
+    /**
+     * @brief Cancels a running interpolation. The reduced contours computed so far are kept for the next
+     * interpolation. Can be called from any thread.
+     */
+    void CancelInterpolation();
+
     mitk::Surface::Pointer GetInterpolationResult();
 
     /**
@@ -222,10 +239,46 @@ namespace mitk
 
     void AddToInterpolationPipeline(ContourPositionInformation contourInfo);
 
+    struct ReducedContour
+    {
+      // the extracted contour, referenced to keep the key of the cache entry valid
+      Surface::ConstPointer Contour;
+      // the reduced contour with its normals, nullptr if the reduction eliminated the complete contour
+      Surface::Pointer ContourWithNormals;
+    };
+
+    typedef std::map<const Surface *, ReducedContour> ReducedContourMap;
+
+    /**
+     * Reduces the given contours and computes their normals. Cached results are reused if all contours are parallel,
+     * otherwise the contours may intersect each other and are reduced together.
+     * @return the reduced contours with normals or an empty list if the interpolation was cancelled
+     */
+    std::vector<Surface::Pointer> ReduceContours(const ContourPositionInformationList &contours,
+                                                 Image *segmentationImage,
+                                                 double minSpacing,
+                                                 double maxSpacing,
+                                                 unsigned int interpolationRequest);
+
+    bool IsInterpolationCancelled(unsigned int interpolationRequest) const;
+
     ReduceContourSetFilter::Pointer m_ReduceFilter;
-    ComputeContourSetNormalsFilter::Pointer m_NormalsFilter;
     CreateDistanceImageFromSurfaceFilter::Pointer m_InterpolateSurfaceFilter;
 
+    ReducedContourMap m_ReducedContours;
+
+    // guards the contour lists, the spacings and m_ReducedContours against a concurrently running interpolation
+    std::mutex m_ContourMutex;
+
+    // held by a running interpolation while it uses the filters, so that they are not reset underneath it
+    std::mutex m_InterpolationMutex;
+
+    // incremented for every interpolation and cancellation, a running interpolation stops if it changes
+    std::atomic<unsigned int> m_InterpolationRequest;
+
+    double m_MinSpacing;
+    double m_MaxSpacing;
+
     Surface::Pointer m_Contours;
 
     double m_DistanceImageSpacing;